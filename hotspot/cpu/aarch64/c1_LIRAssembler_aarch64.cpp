@@ -1530,16 +1530,25 @@ void LIR_Assembler::emit_opTypeCheck(LIR_OpTypeCheck* op) {
   }
 }
 
+// CASAL, SWPAL and LDADDAL are single-copy atomic with both acquire and
+// release semantics, which is already a full fence for the purposes of
+// the Java memory model. Only the LL/SC sequences need a trailing DMB.
+void LIR_Assembler::trailing_atomic_membar() {
+  if (!UseLSE) {
+    __ membar(__ AnyAny);
+  }
+}
+
 void LIR_Assembler::casw(Register addr, Register newval, Register cmpval) {
   __ cmpxchg(addr, cmpval, newval, Assembler::word, /* acquire*/ true, /* release*/ true, /* weak*/ false, rscratch1);
   __ cset(rscratch1, Assembler::NE);
-  __ membar(__ AnyAny);
+  trailing_atomic_membar();
 }
 
 void LIR_Assembler::casl(Register addr, Register newval, Register cmpval) {
   __ cmpxchg(addr, cmpval, newval, Assembler::xword, /* acquire*/ true, /* release*/ true, /* weak*/ false, rscratch1);
   __ cset(rscratch1, Assembler::NE);
-  __ membar(__ AnyAny);
+  trailing_atomic_membar();
 }
 
 
@@ -3221,7 +3230,7 @@ void LIR_Assembler::atomic_op(LIR_Code code, LIR_Opr src, LIR_Opr data, LIR_Opr
   default:
     ShouldNotReachHere();
   }
-  __ membar(__ AnyAny);
+  trailing_atomic_membar();
 }
 
 #undef __
@@ -57,6 +57,7 @@ friend class ArrayCopyStub;
 
   void casw(Register addr, Register newval, Register cmpval);
   void casl(Register addr, Register newval, Register cmpval);
+  void trailing_atomic_membar();
 
   void poll_for_safepoint(relocInfo::relocType rtype, CodeEmitInfo* info = NULL);
 
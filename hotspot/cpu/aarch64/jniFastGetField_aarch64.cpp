@@ -177,3 +177,7 @@ address JNI_FastGetField::generate_fast_get_float_field() {
 address JNI_FastGetField::generate_fast_get_double_field() {
   return generate_fast_get_int_field0(T_DOUBLE);
 }
+
+address JNI_FastGetField::generate_fast_get_array_length() {
+  return (address) -1;
+}
@@ -3626,6 +3626,67 @@ void MacroAssembler::kernel_crc32c_using_crc32c(Register crc, Register buf,
   BIND(L_exit);
 }
 
+/**
+ * Consume the input in blocks of three 256 byte chunks while at least one
+ * full block remains. The chunks are processed as three independent crc32cx
+ * streams so that the latency of the CRC instruction is hidden, and the
+ * partial CRCs are then combined by multiplying the first two by
+ * x^(8*512) and x^(8*256) mod P with pmull and reducing the sum with a
+ * single crc32cx. On exit len holds the number of bytes left unprocessed.
+ *
+ * The combining constants are x^(8*n-33) mod P, bit-reflected, where the
+ * extra x^-33 accounts for the x^32 factor of crc32cx and the one-bit
+ * offset of the reflected 64-bit product.
+ */
+void MacroAssembler::kernel_crc32c_by3_using_pmull(Register crc, Register buf,
+        Register len, Register tmp0, Register tmp1, Register tmp2,
+        Register crc1, Register crc2, Register cnt) {
+    const int CHUNK = 256;
+    Label L_block_loop, L_chunk_loop, L_exit;
+    assert_different_registers(crc, buf, len, tmp0, tmp1, tmp2, crc1, crc2, cnt);
+
+    subs(len, len, 3*CHUNK);
+    br(Assembler::LT, L_exit);
+
+    movw(tmp0, 0xdd7e3b0c);   // x^(8*512-33) mod P
+    fmovs(v2, tmp0);
+    movw(tmp0, 0xb9e02b86);   // x^(8*256-33) mod P
+    fmovs(v3, tmp0);
+
+  BIND(L_block_loop);
+    movw(crc1, zr);
+    movw(crc2, zr);
+    movw(cnt, CHUNK/8);
+
+  BIND(L_chunk_loop);
+    ldr(tmp0, Address(post(buf, 8)));
+    ldr(tmp1, Address(buf, CHUNK-8));
+    ldr(tmp2, Address(buf, 2*CHUNK-8));
+    subs(cnt, cnt, 1);
+    crc32cx(crc, crc, tmp0);
+    crc32cx(crc1, crc1, tmp1);
+    crc32cx(crc2, crc2, tmp2);
+    br(Assembler::GT, L_chunk_loop);
+
+    add(buf, buf, 2*CHUNK);
+
+    // crc = (crc * x^(8*512) + crc1 * x^(8*256)) mod P + crc2
+    fmovs(v0, crc);
+    fmovs(v1, crc1);
+    pmull(v0, T1Q, v0, v2, T1D);
+    pmull(v1, T1Q, v1, v3, T1D);
+    eor(v0, T16B, v0, v1);
+    fmovd(tmp0, v0);
+    movw(crc, zr);
+    crc32cx(crc, crc, tmp0);
+    eorw(crc, crc, crc2);
+
+    subs(len, len, 3*CHUNK);
+    br(Assembler::GE, L_block_loop);
+  BIND(L_exit);
+    add(len, len, 3*CHUNK);
+}
+
 /**
  * @param crc   register containing existing CRC (32-bit)
  * @param buf   register pointing to input byte buffer (byte*)
@@ -3636,6 +3697,10 @@ void MacroAssembler::kernel_crc32c_using_crc32c(Register crc, Register buf,
 void MacroAssembler::kernel_crc32c(Register crc, Register buf, Register len,
         Register table0, Register table1, Register table2, Register table3,
         Register tmp, Register tmp2, Register tmp3) {
+  if (VM_Version::features() & VM_Version::CPU_PMULL) {
+    kernel_crc32c_by3_using_pmull(crc, buf, len, table0, table1, table2,
+                                  table3, tmp, tmp2);
+  }
   kernel_crc32c_using_crc32c(crc, buf, len, table0, table1, table2, table3);
 }
 
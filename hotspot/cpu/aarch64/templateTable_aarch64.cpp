@@ -957,6 +957,18 @@ void TemplateTable::aload_0_internal(RewriteControl rc) {
     __ movw(bc, Bytecodes::_fast_faccess_0);
     __ br(Assembler::EQ, rewrite);
 
+    // if _aload_1 then rewrite to _fast_aload_0_aload_1
+    assert(Bytecodes::java_code(Bytecodes::_fast_aload_0_aload_1) == Bytecodes::_aload_0, "fix bytecode definition");
+    __ cmpw(r1, Bytecodes::_aload_1);
+    __ movw(bc, Bytecodes::_fast_aload_0_aload_1);
+    __ br(Assembler::EQ, rewrite);
+
+    // if _iload_1 then rewrite to _fast_aload_0_iload_1
+    assert(Bytecodes::java_code(Bytecodes::_fast_aload_0_iload_1) == Bytecodes::_aload_0, "fix bytecode definition");
+    __ cmpw(r1, Bytecodes::_iload_1);
+    __ movw(bc, Bytecodes::_fast_aload_0_iload_1);
+    __ br(Assembler::EQ, rewrite);
+
     // else rewrite to _fast_aload0
     assert(Bytecodes::java_code(Bytecodes::_fast_aload_0) == Bytecodes::_aload_0, "fix bytecode definition");
     __ movw(bc, Bytecodes::Bytecodes::_fast_aload_0);
@@ -973,6 +985,23 @@ void TemplateTable::aload_0_internal(RewriteControl rc) {
   aload(0);
 }
 
+// The next bytecode is never rewritten, it is only skipped over.
+void TemplateTable::fast_aload_0_aload_1()
+{
+  transition(vtos, atos);
+  __ ldr(r0, aaddress(0));
+  __ push(atos);
+  __ ldr(r0, aaddress(1));
+}
+
+void TemplateTable::fast_aload_0_iload_1()
+{
+  transition(vtos, itos);
+  __ ldr(r0, aaddress(0));
+  __ push(atos);
+  __ ldr(r0, iaddress(1));
+}
+
 void TemplateTable::istore()
 {
   transition(itos, vtos);
@@ -460,6 +460,4 @@ void VM_Version::initialize() {
                                    g.generate_getPsrInfo());
 
   get_processor_features();
-
-  UNSUPPORTED_OPTION(CriticalJNINatives);
 }
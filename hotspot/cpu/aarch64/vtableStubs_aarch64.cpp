@@ -177,7 +177,7 @@ VtableStub* VtableStubs::create_itable_stub(int itable_index) {
   const Register temp_reg           = r11;
   const Register icholder_reg       = rscratch2;
 
-  Label L_no_such_interface;
+  Label L_no_such_interface, L_resolved_is_holder;
 
   __ ldr(resolved_klass_reg, Address(icholder_reg, CompiledICHolder::holder_klass_offset()));
   __ ldr(holder_klass_reg,   Address(icholder_reg, CompiledICHolder::holder_metadata_offset()));
@@ -188,6 +188,12 @@ VtableStub* VtableStubs::create_itable_stub(int itable_index) {
   address npe_addr = __ pc();
   __ load_klass(recv_klass_reg, j_rarg0);
 
+  // Most interface calls are to a method declared in the interface the call
+  // site refers to. The method lookup below then does the subtype check as
+  // well, and the receiver's itable is only scanned once.
+  __ cmp(resolved_klass_reg, holder_klass_reg);
+  __ br(Assembler::EQ, L_resolved_is_holder);
+
   // Receiver subtype check against REFC.
   // Destroys recv_klass_reg value.
   __ lookup_interface_method(// inputs: rec. class, interface
@@ -202,6 +208,7 @@ VtableStub* VtableStubs::create_itable_stub(int itable_index) {
 
   // Get selected method from declaring class and itable index
   __ load_klass(recv_klass_reg, j_rarg0);   // restore recv_klass_reg
+  __ bind(L_resolved_is_holder);
   __ lookup_interface_method(// inputs: rec. class, interface, itable index
                              recv_klass_reg, holder_klass_reg, itable_index,
                              // outputs: method, scan temp. reg
@@ -211,7 +218,7 @@ VtableStub* VtableStubs::create_itable_stub(int itable_index) {
   const ptrdiff_t lookupSize = __ pc() - start_pc;
 
   // Reduce "estimate" such that "padding" does not drop below 8.
-  const ptrdiff_t estimate = 152;
+  const ptrdiff_t estimate = 160;
   const ptrdiff_t codesize = typecheckSize + lookupSize;
   slop_delta  = (int)(estimate - codesize);
   slop_bytes += slop_delta;
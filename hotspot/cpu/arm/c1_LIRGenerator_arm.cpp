@@ -1221,10 +1221,9 @@ void LIRGenerator::do_soft_float_compare(If* x) {
   }
   // Call float compare function, returns (1,0) if true or false.
   LIR_Opr result = call_runtime(x->x(), x->y(), runtime_func, intType, NULL);
-  __ cmp(lir_cond_equal, result,
-         compare_to_zero ?
-           LIR_OprFact::intConst(0) : LIR_OprFact::intConst(1));
-  profile_branch(x, cond);
+  LIR_Opr expected = compare_to_zero ? LIR_OprFact::intConst(0) : LIR_OprFact::intConst(1);
+  profile_branch(x, lir_cond_equal, result, expected);
+  __ cmp(lir_cond_equal, result, expected);
   move_to_phi(x->state());
   __ branch(lir_cond_equal, T_INT, x->tsux());
 }
@@ -1280,8 +1279,8 @@ void LIRGenerator::do_If(If* x) {
     __ safepoint(LIR_OprFact::illegalOpr, state_for(x, x->state_before()));
   }
 
+  profile_branch(x, lir_cond(cond), left, right);
   __ cmp(lir_cond(cond), left, right);
-  profile_branch(x, cond);
   move_to_phi(x->state());
   if (x->x()->type()->is_float_kind()) {
     __ branch(lir_cond(cond), right->type(), x->tsux(), x->usux());
@@ -1046,6 +1046,21 @@ void TemplateTable::aload_0_internal(RewriteControl rc) {
   aload(0);
 }
 
+// Only rewritten to on x86 and aarch64; the next bytecode is skipped over.
+void TemplateTable::fast_aload_0_aload_1() {
+  transition(vtos, atos);
+  __ ldr(R0_tos, aaddress(0));
+  __ push(atos);
+  __ ldr(R0_tos, aaddress(1));
+}
+
+void TemplateTable::fast_aload_0_iload_1() {
+  transition(vtos, itos);
+  __ ldr(R0_tos, aaddress(0));
+  __ push(atos);
+  __ ldr_s32(R0_tos, iaddress(1));
+}
+
 void TemplateTable::istore() {
   transition(itos, vtos);
   const Register Rlocal_index = R2_tmp;
@@ -1165,9 +1165,9 @@ void LIRGenerator::do_If(If* x) {
     __ safepoint(safepoint_poll_register(), state_for(x, x->state_before()));
   }
 
+  // Generate branch profiling. Profiling code does its own compare.
+  profile_branch(x, lir_cond(cond), left, right);
   __ cmp(lir_cond(cond), left, right);
-  // Generate branch profiling. Profiling code doesn't kill flags.
-  profile_branch(x, cond);
   move_to_phi(x->state());
   if (x->x()->type()->is_float_kind()) {
     __ branch(lir_cond(cond), right->type(), x->tsux(), x->usux());
@@ -837,6 +837,23 @@ void TemplateTable::aload_0_internal(RewriteControl rc) {
   aload(0);
 }
 
+// Only rewritten to on x86 and aarch64; the next bytecode is skipped over.
+void TemplateTable::fast_aload_0_aload_1() {
+  transition(vtos, atos);
+
+  __ ld(R17_tos, Interpreter::local_offset_in_bytes(0), R18_locals);
+  __ push(atos);
+  __ ld(R17_tos, Interpreter::local_offset_in_bytes(1), R18_locals);
+}
+
+void TemplateTable::fast_aload_0_iload_1() {
+  transition(vtos, itos);
+
+  __ ld(R17_tos, Interpreter::local_offset_in_bytes(0), R18_locals);
+  __ push(atos);
+  __ lwz(R17_tos, Interpreter::local_offset_in_bytes(1), R18_locals);
+}
+
 void TemplateTable::istore() {
   transition(itos, vtos);
 
@@ -1027,6 +1027,21 @@ void TemplateTable::aload_0_internal(RewriteControl rc) {
   __ bind(done);
 }
 
+// Only rewritten to on x86 and aarch64; the next bytecode is skipped over.
+void TemplateTable::fast_aload_0_aload_1() {
+  transition(vtos, atos);
+  __ mem2reg_opt(Z_tos, aaddress(0));
+  __ push(atos);
+  __ mem2reg_opt(Z_tos, aaddress(1));
+}
+
+void TemplateTable::fast_aload_0_iload_1() {
+  transition(vtos, itos);
+  __ mem2reg_opt(Z_tos, aaddress(0));
+  __ push(atos);
+  __ z_ly(Z_tos, iaddress(1));
+}
+
 void TemplateTable::istore() {
   transition(itos, vtos);
   locals_index(Z_R1_scratch);
@@ -34,6 +34,10 @@ void BarrierSetNMethod::disarm(nmethod* nm) {
   ShouldNotReachHere();
 }
 
+void BarrierSetNMethod::arm(nmethod* nm) {
+  ShouldNotReachHere();
+}
+
 bool BarrierSetNMethod::is_armed(nmethod* nm) {
   ShouldNotReachHere();
   return false;
@@ -835,6 +835,21 @@ void TemplateTable::aload_0_internal(RewriteControl rc) {
   aload(0);
 }
 
+// Only rewritten to on x86 and aarch64; the next bytecode is skipped over.
+void TemplateTable::fast_aload_0_aload_1() {
+  transition(vtos, atos);
+  __ ld_ptr( Llocals, Interpreter::local_offset_in_bytes(0), Otos_i );
+  __ push(atos);
+  __ ld_ptr( Llocals, Interpreter::local_offset_in_bytes(1), Otos_i );
+}
+
+void TemplateTable::fast_aload_0_iload_1() {
+  transition(vtos, itos);
+  __ ld_ptr( Llocals, Interpreter::local_offset_in_bytes(0), Otos_i );
+  __ push(atos);
+  __ ld( Llocals, Interpreter::local_offset_in_bytes(1), Otos_i );
+}
+
 void TemplateTable::istore() {
   transition(itos, vtos);
   locals_index(G3_scratch);
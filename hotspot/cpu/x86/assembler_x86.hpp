@@ -1401,6 +1401,7 @@ private:
   }
 
   void mfence();
+  void sfence();
 
   // Moves
 
@@ -1495,6 +1496,9 @@ private:
   void movq(Register dst, Register src);
   void movq(Register dst, Address src);
   void movq(Address  dst, Register src);
+
+  // Store quadword with a non-temporal hint
+  void movnti(Address dst, Register src);
 #endif
 
   void movq(Address     dst, MMXRegister src );
@@ -1640,6 +1644,7 @@ private:
   void vpcmpeqw(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
   void evpcmpeqw(KRegister kdst, XMMRegister nds, XMMRegister src, int vector_len);
   void evpcmpeqw(KRegister kdst, XMMRegister nds, Address src, int vector_len);
+  void evpcmpeqw(KRegister kdst, KRegister mask, XMMRegister nds, Address src, int vector_len);
 
   void pcmpeqd(XMMRegister dst, XMMRegister src);
   void vpcmpeqd(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
@@ -1686,12 +1691,21 @@ private:
   void evpmovwb(Address dst, KRegister mask, XMMRegister src, int vector_len);
 
   void vpmovzxwd(XMMRegister dst, XMMRegister src, int vector_len);
+  void vpmovzxwd(XMMRegister dst, Address src, int vector_len);
+  void vpmovzxbd(XMMRegister dst, XMMRegister src, int vector_len);
+  void vpmovzxbd(XMMRegister dst, Address src, int vector_len);
 
+  void evpmovdb(XMMRegister dst, XMMRegister src, int vector_len);
   void evpmovdb(Address dst, XMMRegister src, int vector_len);
+  void evpmovdw(XMMRegister dst, XMMRegister src, int vector_len);
 
   // Sign extend moves
   void pmovsxbw(XMMRegister dst, XMMRegister src);
   void vpmovsxbw(XMMRegister dst, XMMRegister src, int vector_len);
+  void vpmovsxbd(XMMRegister dst, XMMRegister src, int vector_len);
+  void vpmovsxbd(XMMRegister dst, Address src, int vector_len);
+  void vpmovsxwd(XMMRegister dst, XMMRegister src, int vector_len);
+  void vpmovsxwd(XMMRegister dst, Address src, int vector_len);
 
   // Multiply add
   void pmaddwd(XMMRegister dst, XMMRegister src);
@@ -145,6 +145,17 @@ void BarrierSetNMethod::disarm(nmethod* nm) {
   cmp->set_immediate(disarmed_value());
 }
 
+void BarrierSetNMethod::arm(nmethod* nm) {
+  if (!supports_entry_barrier(nm)) {
+    return;
+  }
+
+  // The disarmed values of ZGC have only a few bits set, and the sweeper
+  // barriers are disarmed with 0, so the complement is never disarmed.
+  NativeNMethodCmpBarrier* cmp = native_nmethod_barrier(nm);
+  cmp->set_immediate(~disarmed_value());
+}
+
 bool BarrierSetNMethod::is_armed(nmethod* nm) {
   if (!supports_entry_barrier(nm)) {
     return false;
@@ -153,6 +153,12 @@ define_pd_global(bool, ThreadLocalHandshakes, false);
   product(bool, UseFastStosb, false,                                        \
           "Use fast-string operation for zeroing: rep stosb")               \
                                                                             \
+  product(size_t, ArrayCopyNonTemporalThreshold, 0,                         \
+          "Copy and fill arrays of at least this many bytes with "          \
+          "non-temporal stores. 0 disables. Defaults to the size of the "   \
+          "last level cache, if known")                                     \
+          range(0, max_jint)                                                \
+                                                                            \
   /* Use Restricted Transactional Memory for lock eliding */                \
   product(bool, UseRTMLocking, false,                                       \
           "Enable RTM lock eliding for inflated locks in compiled code")    \
@@ -27,6 +27,7 @@
 #include "gc/shared/barrierSet.hpp"
 #include "gc/shared/barrierSetAssembler.hpp"
 #include "memory/resourceArea.hpp"
+#include "oops/arrayOop.hpp"
 #include "prims/jniFastGetField.hpp"
 #include "prims/jvm_misc.hpp"
 #include "runtime/safepoint.hpp"
@@ -207,3 +208,42 @@ address JNI_FastGetField::generate_fast_get_float_field() {
 address JNI_FastGetField::generate_fast_get_double_field() {
   return generate_fast_get_float_field0(T_DOUBLE);
 }
+
+address JNI_FastGetField::generate_fast_get_array_length() {
+  ResourceMark rm;
+  BufferBlob* blob = BufferBlob::create("jni_fast_GetArrayLength", BUFFER_SIZE);
+  CodeBuffer cbuf(blob);
+  MacroAssembler* masm = new MacroAssembler(&cbuf);
+  address fast_entry = __ pc();
+
+  Label slow;
+
+  ExternalAddress counter(SafepointSynchronize::safepoint_counter_addr());
+  __ mov32 (rcounter, counter);
+  __ mov   (robj, c_rarg1);
+  __ testb (rcounter, 1);
+  __ jcc (Assembler::notZero, slow);
+
+  // Both robj and rtmp are clobbered by try_resolve_jobject_in_native.
+  BarrierSetAssembler* bs = BarrierSet::barrier_set()->barrier_set_assembler();
+  bs->try_resolve_jobject_in_native(masm, /* jni_env */ c_rarg0, robj, rtmp, slow);
+  DEBUG_ONLY(__ movl(rtmp, 0xDEADC0DE);)
+
+  assert(count < LIST_CAPACITY, "LIST_CAPACITY too small");
+  speculative_load_pclist[count] = __ pc();
+  __ movl  (rax, Address(robj, arrayOopDesc::length_offset_in_bytes()));
+
+  __ cmp32 (rcounter, counter);
+  __ jcc (Assembler::notEqual, slow);
+
+  __ ret (0);
+
+  slowcase_entry_pclist[count++] = __ pc();
+  __ bind (slow);
+  // tail call
+  __ jump (ExternalAddress(jni_GetArrayLength_addr()));
+
+  __ flush ();
+
+  return fast_entry;
+}
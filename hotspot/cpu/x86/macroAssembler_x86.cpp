@@ -6350,6 +6350,47 @@ void MacroAssembler::string_indexof_char(Register str1, Register cnt1, Register
         FOUND_SEQ_CHAR, DONE_LABEL;
 
   movptr(result, str1);
+#ifdef _LP64
+  if ((UseAVX > 2) && // AVX512
+      VM_Version::supports_avx512vlbw() &&
+      VM_Version::supports_bmi2()) {
+    Label SCAN_TO_32_CHAR_LOOP, SCAN_TAIL_AVX3, FOUND_CHAR_AVX3;
+
+    evpbroadcastw(vec1, ch, Assembler::AVX_512bit);
+    movl(tmp, cnt1);
+    andl(tmp, 0xFFFFFFE0);  //vector count (in chars)
+    andl(cnt1,0x0000001F);  //tail count (in chars)
+    testl(tmp, tmp);
+    jcc(Assembler::zero, SCAN_TAIL_AVX3);
+
+    bind(SCAN_TO_32_CHAR_LOOP);
+    evpcmpeqw(k2, vec1, Address(result, 0), Assembler::AVX_512bit);
+    kortestdl(k2, k2);
+    jcc(Assembler::notZero, FOUND_CHAR_AVX3);
+    addptr(result, 64);
+    subl(tmp, 32);
+    jcc(Assembler::notZero, SCAN_TO_32_CHAR_LOOP);
+
+    bind(SCAN_TAIL_AVX3);
+    testl(cnt1, cnt1);
+    jcc(Assembler::zero, RET_NOT_FOUND);
+    // ~(~0 << cnt1), one mask bit per remaining char. Masked out
+    // elements are not loaded, so this does not read past the array.
+    movl(tmp, 0xFFFFFFFF);
+    shlxl(tmp, tmp, cnt1);
+    notl(tmp);
+    kmovdl(k3, tmp);
+    evpcmpeqw(k2, k3, vec1, Address(result, 0), Assembler::AVX_512bit);
+    kortestdl(k2, k2);
+    jcc(Assembler::zero, RET_NOT_FOUND);
+
+    bind(FOUND_CHAR_AVX3);
+    kmovdl(tmp, k2);
+    bsfl(ch, tmp);
+    lea(result, Address(result, ch, Address::times_2));
+    jmp(FOUND_SEQ_CHAR);
+  }
+#endif // _LP64
   if (UseAVX >= 2) {
     cmpl(cnt1, stride);
     jcc(Assembler::less, SCAN_TO_CHAR_LOOP);
@@ -6432,6 +6473,140 @@ void MacroAssembler::string_indexof_char(Register str1, Register cnt1, Register
   bind(DONE_LABEL);
 } // string_indexof_char
 
+void MacroAssembler::stringL_indexof_char(Register str1, Register cnt1, Register ch, Register result,
+                                          XMMRegister vec1, XMMRegister vec2, XMMRegister vec3, Register tmp) {
+  ShortBranchVerifier sbv(this);
+  assert(UseSSE42Intrinsics, "SSE4.2 intrinsics are required");
+
+  int stride = 16;
+
+  Label FOUND_CHAR, SCAN_TO_CHAR_INIT, SCAN_TO_CHAR_LOOP,
+        SCAN_TO_16_CHAR, SCAN_TO_16_CHAR_LOOP, SCAN_TO_32_CHAR_LOOP,
+        RET_NOT_FOUND, SCAN_TO_16_CHAR_INIT,
+        FOUND_SEQ_CHAR, DONE_LABEL;
+
+  movptr(result, str1);
+#ifdef _LP64
+  if ((UseAVX > 2) && // AVX512
+      VM_Version::supports_avx512vlbw() &&
+      VM_Version::supports_bmi2()) {
+    Label SCAN_TO_64_CHAR_LOOP, SCAN_TAIL_AVX3, FOUND_CHAR_AVX3;
+
+    evpbroadcastb(vec1, ch, Assembler::AVX_512bit);
+    movl(tmp, cnt1);
+    andl(tmp, 0xFFFFFFC0);  //vector count (in chars)
+    andl(cnt1,0x0000003F);  //tail count (in chars)
+    testl(tmp, tmp);
+    jcc(Assembler::zero, SCAN_TAIL_AVX3);
+
+    bind(SCAN_TO_64_CHAR_LOOP);
+    evpcmpeqb(k2, vec1, Address(result, 0), Assembler::AVX_512bit);
+    kortestql(k2, k2);
+    jcc(Assembler::notZero, FOUND_CHAR_AVX3);
+    addptr(result, 64);
+    subl(tmp, 64);
+    jcc(Assembler::notZero, SCAN_TO_64_CHAR_LOOP);
+
+    bind(SCAN_TAIL_AVX3);
+    testl(cnt1, cnt1);
+    jcc(Assembler::zero, RET_NOT_FOUND);
+    // ~(~0 << cnt1), one mask bit per remaining char. Masked out
+    // elements are not loaded, so this does not read past the array.
+    mov64(tmp, -1);
+    shlxq(tmp, tmp, cnt1);
+    notq(tmp);
+    kmovql(k3, tmp);
+    evpcmpeqb(k2, k3, vec1, Address(result, 0), Assembler::AVX_512bit);
+    kortestql(k2, k2);
+    jcc(Assembler::zero, RET_NOT_FOUND);
+
+    bind(FOUND_CHAR_AVX3);
+    kmovql(tmp, k2);
+    bsfq(ch, tmp);
+    addptr(result, ch);
+    jmp(FOUND_SEQ_CHAR);
+  }
+#endif // _LP64
+  if (UseAVX >= 2) {
+    cmpl(cnt1, stride);
+    jcc(Assembler::less, SCAN_TO_CHAR_INIT);
+    cmpl(cnt1, 2*stride);
+    jcc(Assembler::less, SCAN_TO_16_CHAR_INIT);
+    movdl(vec1, ch);
+    vpbroadcastb(vec1, vec1, Assembler::AVX_256bit);
+    vpxor(vec2, vec2);
+    movl(tmp, cnt1);
+    andl(tmp, 0xFFFFFFE0);  //vector count (in chars)
+    andl(cnt1,0x0000001F);  //tail count (in chars)
+
+    bind(SCAN_TO_32_CHAR_LOOP);
+    vmovdqu(vec3, Address(result, 0));
+    vpcmpeqb(vec3, vec3, vec1, Assembler::AVX_256bit);
+    vptest(vec2, vec3);
+    jcc(Assembler::carryClear, FOUND_CHAR);
+    addptr(result, 32);
+    subl(tmp, 2*stride);
+    jcc(Assembler::notZero, SCAN_TO_32_CHAR_LOOP);
+    jmp(SCAN_TO_16_CHAR);
+
+    bind(SCAN_TO_16_CHAR_INIT);
+    movdl(vec1, ch);
+    pxor(vec2, vec2);
+    pshufb(vec1, vec2);
+  }
+
+  bind(SCAN_TO_16_CHAR);
+  cmpl(cnt1, stride);
+  jcc(Assembler::less, SCAN_TO_CHAR_INIT); // less than 16 entries left
+  if (UseAVX < 2) {
+    movdl(vec1, ch);
+    pxor(vec2, vec2);
+    pshufb(vec1, vec2);
+  }
+  movl(tmp, cnt1);
+  andl(tmp, 0xFFFFFFF0);  //vector count (in bytes)
+  andl(cnt1,0x0000000F);  //tail count (in bytes)
+
+  bind(SCAN_TO_16_CHAR_LOOP);
+  movdqu(vec3, Address(result, 0));
+  pcmpeqb(vec3, vec1);
+  ptest(vec2, vec3);
+  jcc(Assembler::carryClear, FOUND_CHAR);
+  addptr(result, 16);
+  subl(tmp, stride);
+  jcc(Assembler::notZero, SCAN_TO_16_CHAR_LOOP);
+
+  bind(SCAN_TO_CHAR_INIT);
+  testl(cnt1, cnt1);
+  jcc(Assembler::zero, RET_NOT_FOUND);
+  bind(SCAN_TO_CHAR_LOOP);
+  load_unsigned_byte(tmp, Address(result, 0));
+  cmpl(ch, tmp);
+  jccb(Assembler::equal, FOUND_SEQ_CHAR);
+  addptr(result, 1);
+  subl(cnt1, 1);
+  jccb(Assembler::zero, RET_NOT_FOUND);
+  jmp(SCAN_TO_CHAR_LOOP);
+
+  bind(RET_NOT_FOUND);
+  movl(result, -1);
+  jmpb(DONE_LABEL);
+
+  bind(FOUND_CHAR);
+  if (UseAVX >= 2) {
+    vpmovmskb(tmp, vec3);
+  } else {
+    pmovmskb(tmp, vec3);
+  }
+  bsfl(ch, tmp);
+  addptr(result, ch);
+
+  bind(FOUND_SEQ_CHAR);
+  subptr(result, str1);
+
+  bind(DONE_LABEL);
+} // stringL_indexof_char
+
 // helper function for string_compare
 void MacroAssembler::load_next_elements(Register elem1, Register elem2, Register str1, Register str2,
                                         Address::ScaleFactor scale, Address::ScaleFactor scale1,
@@ -7366,6 +7541,32 @@ void MacroAssembler::generate_fill(BasicType t, bool aligned,
     {
       assert( UseSSE >= 2, "supported cpu only" );
       Label L_fill_32_bytes_loop, L_check_fill_8_bytes, L_fill_8_bytes_loop, L_fill_8_bytes;
+#ifdef _LP64
+      if (ArrayCopyNonTemporalThreshold > 0) {
+        // Fill 64-byte chunks of large arrays with non-temporal stores
+        Label L_fill_cached, L_stream_loop;
+        int stream_count = MAX2((int)(ArrayCopyNonTemporalThreshold >> (2 - shift)), 16 << shift);
+        cmpl(count, stream_count);
+        jcc(Assembler::below, L_fill_cached);
+        movl(value, value);  // zero extend
+        movq(rtmp, value);
+        shlq(rtmp, 32);
+        orq(rtmp, value);
+        align(16);
+
+        BIND(L_stream_loop);
+        for (int i = 0; i < 64; i += 8) {
+          movnti(Address(to, i), rtmp);
+        }
+        addptr(to, 64);
+        subl(count, 16 << shift);
+        cmpl(count, 16 << shift);
+        jcc(Assembler::aboveEqual, L_stream_loop);
+        sfence();
+
+        BIND(L_fill_cached);
+      }
+#endif
       movdl(xtmp, value);
       if (UseAVX > 2 && UseUnalignedLoadStores) {
         // Fill 64-byte chunks
@@ -8310,6 +8511,97 @@ void MacroAssembler::vectorized_mismatch(Register obja, Register objb, Register
   bind(DONE);
 }
 
+// Computes result = 31^cnt * result + sum(ary[i] * 31^(cnt - 1 - i)) for the
+// cnt elements of type eltype at ary, i.e. the hash code of the elements as
+// computed by Arrays.hashCode() scaled by the initial value in result.
+//
+// 32 elements are processed per iteration in four vectors of eight ints. Each
+// lane accumulates every 32nd element, multiplying the previous sum by 31^32,
+// and the lanes are weighted with 31^31 .. 31^0 from the powers table and
+// summed up into result at the end. The remaining elements are hashed one by
+// one. powers holds 31^31, 31^30, .. 31^0 followed by 31^32.
+void MacroAssembler::arrays_hashcode(Register ary, Register cnt, Register result, Register tmp,
+                                     AddressLiteral powers, BasicType eltype,
+                                     XMMRegister vacc0, XMMRegister vacc1, XMMRegister vacc2, XMMRegister vacc3,
+                                     XMMRegister vtmp, XMMRegister vpow) {
+  assert(UseAVX >= 2, "AVX2 must be enabled.");
+  Label VECTOR32_LOOP, SCALAR_LOOP, DONE;
+  const int elsize = type2aelembytes(eltype == T_BOOLEAN ? T_BYTE : eltype);
+  const XMMRegister vacc[] = { vacc0, vacc1, vacc2, vacc3 };
+
+  juint pow32 = 1;
+  for (int i = 0; i < 32; i++) {
+    pow32 *= 31;
+  }
+
+  cmpl(cnt, 32);
+  jcc(Assembler::less, SCALAR_LOOP);
+
+  lea(tmp, powers);
+  vpbroadcastd(vpow, Address(tmp, 32 * 4), Assembler::AVX_256bit);
+  for (int i = 0; i < 4; i++) {
+    vpxor(vacc[i], vacc[i], vacc[i], Assembler::AVX_256bit);
+  }
+
+  bind(VECTOR32_LOOP);
+  imull(result, result, (int)pow32);
+  for (int i = 0; i < 4; i++) {
+    Address src(ary, i * 8 * elsize);
+    switch (eltype) {
+    case T_BOOLEAN: vpmovzxbd(vtmp, src, Assembler::AVX_256bit); break;
+    case T_BYTE:    vpmovsxbd(vtmp, src, Assembler::AVX_256bit); break;
+    case T_CHAR:    vpmovzxwd(vtmp, src, Assembler::AVX_256bit); break;
+    case T_SHORT:   vpmovsxwd(vtmp, src, Assembler::AVX_256bit); break;
+    case T_INT:     vmovdqu(vtmp, src);                          break;
+    default:        ShouldNotReachHere();
+    }
+    vpmulld(vacc[i], vacc[i], vpow, Assembler::AVX_256bit);
+    vpaddd(vacc[i], vacc[i], vtmp, Assembler::AVX_256bit);
+  }
+  addptr(ary, 32 * elsize);
+  subl(cnt, 32);
+  cmpl(cnt, 32);
+  jcc(Assembler::greaterEqual, VECTOR32_LOOP);
+
+  // Weigh the lanes and add them up.
+  for (int i = 0; i < 4; i++) {
+    vpmulld(vacc[i], vacc[i], Address(tmp, i * 8 * 4), Assembler::AVX_256bit);
+  }
+  vpaddd(vacc0, vacc0, vacc1, Assembler::AVX_256bit);
+  vpaddd(vacc2, vacc2, vacc3, Assembler::AVX_256bit);
+  vpaddd(vacc0, vacc0, vacc2, Assembler::AVX_256bit);
+  vextracti128_high(vtmp, vacc0);
+  vpaddd(vacc0, vacc0, vtmp, Assembler::AVX_128bit);
+  pshufd(vtmp, vacc0, 0x4E);
+  vpaddd(vacc0, vacc0, vtmp, Assembler::AVX_128bit);
+  pshufd(vtmp, vacc0, 0xB1);
+  vpaddd(vacc0, vacc0, vtmp, Assembler::AVX_128bit);
+  movdl(tmp, vacc0);
+  addl(result, tmp);
+
+  bind(SCALAR_LOOP);
+  testl(cnt, cnt);
+  jccb(Assembler::zero, DONE);
+  // result = 31 * result + element
+  movl(tmp, result);
+  shll(result, 5);
+  subl(result, tmp);
+  switch (eltype) {
+  case T_BOOLEAN: movzbl(tmp, Address(ary, 0)); break;
+  case T_BYTE:    movsbl(tmp, Address(ary, 0)); break;
+  case T_CHAR:    movzwl(tmp, Address(ary, 0)); break;
+  case T_SHORT:   movswl(tmp, Address(ary, 0)); break;
+  case T_INT:     movl(tmp, Address(ary, 0));   break;
+  default:        ShouldNotReachHere();
+  }
+  addl(result, tmp);
+  addptr(ary, elsize);
+  decrementl(cnt);
+  jmpb(SCALAR_LOOP);
+
+  bind(DONE);
+}
+
 //Helper functions for square_to_len()
 
 /**
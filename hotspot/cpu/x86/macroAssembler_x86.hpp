@@ -1644,6 +1644,9 @@ public:
   void string_indexof_char(Register str1, Register cnt1, Register ch, Register result,
                            XMMRegister vec1, XMMRegister vec2, XMMRegister vec3, Register tmp);
 
+  void stringL_indexof_char(Register str1, Register cnt1, Register ch, Register result,
+                            XMMRegister vec1, XMMRegister vec2, XMMRegister vec3, Register tmp);
+
   // IndexOf strings.
   // Small strings are loaded through stack if they cross page boundary.
   void string_indexof(Register str1, Register str2,
@@ -1735,6 +1738,10 @@ public:
   void vectorized_mismatch(Register obja, Register objb, Register length, Register log2_array_indxscale,
                            Register result, Register tmp1, Register tmp2,
                            XMMRegister vec1, XMMRegister vec2, XMMRegister vec3);
+  void arrays_hashcode(Register ary, Register cnt, Register result, Register tmp,
+                       AddressLiteral powers, BasicType eltype,
+                       XMMRegister vacc0, XMMRegister vacc1, XMMRegister vacc2, XMMRegister vacc3,
+                       XMMRegister vtmp, XMMRegister vpow);
 #endif
 
   // CRC32 code for java.util.zip.CRC32::updateBytes() intrinsic.
@@ -1274,6 +1274,9 @@ class StubGenerator: public StubCodeGenerator {
 
   // Copy big chunks forward
   //
+  // Copies of at least ArrayCopyNonTemporalThreshold bytes are streamed
+  // with non-temporal stores so that they do not evict the caches.
+  //
   // Inputs:
   //   end_from     - source arrays end address
   //   end_to       - destination array end address
@@ -1286,7 +1289,29 @@ class StubGenerator: public StubCodeGenerator {
                              Register qword_count, Register to,
                              Label& L_copy_bytes, Label& L_copy_8_bytes) {
     DEBUG_ONLY(__ stop("enter at entry label, not here"));
-    Label L_loop;
+    Label L_loop, L_copy_cached;
+    const bool stream = ArrayCopyNonTemporalThreshold > 0;
+    if (stream) {
+      Label L_stream_loop, L_stream_next;
+      __ BIND(L_copy_bytes);
+      __ cmpptr(qword_count, -(int32_t)(ArrayCopyNonTemporalThreshold / BytesPerLong));
+      __ jcc(Assembler::greater, L_copy_cached);
+      __ jmp(L_stream_next);
+      // Stream 64-bytes per iteration
+      __ align(OptoLoopAlignment);
+      __ BIND(L_stream_loop);
+      for (int offset = -56; offset <= 0; offset += 8) {
+        __ movq(to, Address(end_from, qword_count, Address::times_8, offset));
+        __ movnti(Address(end_to, qword_count, Address::times_8, offset), to);
+      }
+      __ BIND(L_stream_next);
+      __ addptr(qword_count, 8);
+      __ jcc(Assembler::lessEqual, L_stream_loop);
+      __ subptr(qword_count, 8);
+      // Order the streaming stores before any store that publishes the array.
+      __ sfence();
+      __ jmp(L_copy_cached);
+    }
     __ align(OptoLoopAlignment);
     if (UseUnalignedLoadStores) {
       Label L_end;
@@ -1310,7 +1335,10 @@ class StubGenerator: public StubCodeGenerator {
         __ movdqu(xmm3, Address(end_from, qword_count, Address::times_8, - 8));
         __ movdqu(Address(end_to, qword_count, Address::times_8, - 8), xmm3);
       }
-      __ BIND(L_copy_bytes);
+      __ BIND(L_copy_cached);
+      if (!stream) {
+        __ BIND(L_copy_bytes);
+      }
       __ addptr(qword_count, 8);
       __ jcc(Assembler::lessEqual, L_loop);
       __ subptr(qword_count, 4);  // sub(8) and add(4)
@@ -1344,7 +1372,10 @@ class StubGenerator: public StubCodeGenerator {
       __ movq(to, Address(end_from, qword_count, Address::times_8, - 0));
       __ movq(Address(end_to, qword_count, Address::times_8, - 0), to);
 
-      __ BIND(L_copy_bytes);
+      __ BIND(L_copy_cached);
+      if (!stream) {
+        __ BIND(L_copy_bytes);
+      }
       __ addptr(qword_count, 4);
       __ jcc(Assembler::lessEqual, L_loop);
     }
@@ -5223,6 +5254,62 @@ address generate_avx_ghash_processBlocks() {
     return start;
   }
 
+  // Powers of 31 for arrays_hashcode: 31^31 down to 31^0, then 31^32.
+  address generate_hashcode_powers_of_31() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "hashcode_powers_of_31");
+    address start = __ pc();
+
+    juint powers[33];
+    juint p = 1;
+    for (int i = 31; i >= 0; i--) {
+      powers[i] = p;
+      p *= 31;
+    }
+    powers[32] = p;
+    for (int i = 0; i < 33; i++) {
+      __ emit_data((jint)powers[i], relocInfo::none, 0);
+    }
+
+    return start;
+  }
+
+  /**
+   *  Arguments:
+   *
+   *  Input:
+   *    c_rarg0   - address of the first element
+   *    c_rarg1   - number of elements
+   *    c_rarg2   - initial hash value
+   *
+   *  Output:
+   *        rax   - hash code
+   */
+  address generate_vectorizedHashCode(const char* name, BasicType eltype, address powers) {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", name);
+    address start = __ pc();
+
+    BLOCK_COMMENT("Entry:");
+    __ enter();
+
+    const Register ary = c_rarg0;
+    const Register cnt = c_rarg1;
+    const Register result = rax;
+    const Register tmp = r10;
+
+    __ movl(result, c_rarg2);
+    // xmm0 - xmm5 are volatile on Windows as well.
+    __ arrays_hashcode(ary, cnt, result, tmp, ExternalAddress(powers), eltype,
+                       xmm0, xmm1, xmm2, xmm3, xmm4, xmm5);
+
+    __ vzeroupper();
+    __ leave();
+    __ ret(0);
+
+    return start;
+  }
+
 /**
    *  Arguments:
    *
@@ -6024,6 +6111,15 @@ address generate_avx_ghash_processBlocks() {
     if (UseVectorizedMismatchIntrinsic) {
       StubRoutines::_vectorizedMismatch = generate_vectorizedMismatch();
     }
+
+    if (UseVectorizedHashCodeIntrinsic) {
+      address powers = generate_hashcode_powers_of_31();
+      StubRoutines::_vectorizedHashCode_boolean = generate_vectorizedHashCode("vectorizedHashCode_boolean", T_BOOLEAN, powers);
+      StubRoutines::_vectorizedHashCode_byte    = generate_vectorizedHashCode("vectorizedHashCode_byte", T_BYTE, powers);
+      StubRoutines::_vectorizedHashCode_char    = generate_vectorizedHashCode("vectorizedHashCode_char", T_CHAR, powers);
+      StubRoutines::_vectorizedHashCode_short   = generate_vectorizedHashCode("vectorizedHashCode_short", T_SHORT, powers);
+      StubRoutines::_vectorizedHashCode_int     = generate_vectorizedHashCode("vectorizedHashCode_int", T_INT, powers);
+    }
   }
 
  public:
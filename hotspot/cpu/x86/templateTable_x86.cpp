@@ -964,6 +964,18 @@ void TemplateTable::aload_0_internal(RewriteControl rc) {
     __ movl(bc, Bytecodes::_fast_faccess_0);
     __ jccb(Assembler::equal, rewrite);
 
+    // if _aload_1 then rewrite to _fast_aload_0_aload_1
+    assert(Bytecodes::java_code(Bytecodes::_fast_aload_0_aload_1) == Bytecodes::_aload_0, "fix bytecode definition");
+    __ cmpl(rbx, Bytecodes::_aload_1);
+    __ movl(bc, Bytecodes::_fast_aload_0_aload_1);
+    __ jccb(Assembler::equal, rewrite);
+
+    // if _iload_1 then rewrite to _fast_aload_0_iload_1
+    assert(Bytecodes::java_code(Bytecodes::_fast_aload_0_iload_1) == Bytecodes::_aload_0, "fix bytecode definition");
+    __ cmpl(rbx, Bytecodes::_iload_1);
+    __ movl(bc, Bytecodes::_fast_aload_0_iload_1);
+    __ jccb(Assembler::equal, rewrite);
+
     // else rewrite to _fast_aload0
     assert(Bytecodes::java_code(Bytecodes::_fast_aload_0) == Bytecodes::_aload_0, "fix bytecode definition");
     __ movl(bc, Bytecodes::_fast_aload_0);
@@ -980,6 +992,21 @@ void TemplateTable::aload_0_internal(RewriteControl rc) {
   aload(0);
 }
 
+// The next bytecode is never rewritten, it is only skipped over.
+void TemplateTable::fast_aload_0_aload_1() {
+  transition(vtos, atos);
+  __ movptr(rax, aaddress(0));
+  __ push(atos);
+  __ movptr(rax, aaddress(1));
+}
+
+void TemplateTable::fast_aload_0_iload_1() {
+  transition(vtos, itos);
+  __ movptr(rax, aaddress(0));
+  __ push(atos);
+  __ movl(rax, iaddress(1));
+}
+
 void TemplateTable::istore() {
   transition(itos, vtos);
   locals_index(rbx);
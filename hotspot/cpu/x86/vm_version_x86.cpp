@@ -216,6 +216,14 @@ class VM_Version_StubGenerator: public StubCodeGenerator {
     __ movl(Address(rsi, 8), rcx);
     __ movl(Address(rsi,12), rdx);
 
+    __ movl(rax, 4);
+    __ movl(rcx, 3);     // L3 cache
+    __ cpuid();
+    __ lea(rsi, Address(rbp, in_bytes(VM_Version::dcp_cpuid4_llc_offset())));
+    __ movl(Address(rsi, 0), rax);
+    __ movl(Address(rsi, 4), rbx);
+    __ movl(Address(rsi, 8), rcx);
+
     //
     // Standard cpuid(0x1)
     //
@@ -1349,6 +1357,25 @@ void VM_Version::get_processor_features() {
   }
 #endif // _LP64
 
+#ifdef _LP64
+  if (UseAVX >= 2) {
+    if (FLAG_IS_DEFAULT(UseVectorizedHashCodeIntrinsic)) {
+      UseVectorizedHashCodeIntrinsic = true;
+    }
+  } else if (UseVectorizedHashCodeIntrinsic) {
+    if (!FLAG_IS_DEFAULT(UseVectorizedHashCodeIntrinsic))
+      warning("vectorizedHashCode intrinsics are not available on this CPU");
+    FLAG_SET_DEFAULT(UseVectorizedHashCodeIntrinsic, false);
+  }
+#else
+  if (UseVectorizedHashCodeIntrinsic) {
+    if (!FLAG_IS_DEFAULT(UseVectorizedHashCodeIntrinsic)) {
+      warning("vectorizedHashCode intrinsic is not available in 32-bit VM");
+    }
+    FLAG_SET_DEFAULT(UseVectorizedHashCodeIntrinsic, false);
+  }
+#endif // _LP64
+
   // Use count leading zeros count instruction if available.
   if (supports_lzcnt()) {
     if (FLAG_IS_DEFAULT(UseCountLeadingZerosInstruction)) {
@@ -1502,6 +1529,11 @@ void VM_Version::get_processor_features() {
   if (FLAG_IS_DEFAULT(PrefetchFieldsAhead)) {
     FLAG_SET_DEFAULT(PrefetchFieldsAhead, 1);
   }
+
+  // Copies larger than the last level cache would only evict its contents.
+  if (FLAG_IS_DEFAULT(ArrayCopyNonTemporalThreshold)) {
+    FLAG_SET_DEFAULT(ArrayCopyNonTemporalThreshold, MIN2(LLC_size(), (size_t)max_jint));
+  }
 #endif
 
   if (FLAG_IS_DEFAULT(ContendedPaddingWidth) &&
@@ -386,6 +386,11 @@ protected:
     uint32_t     dcp_cpuid4_ecx; // unused currently
     uint32_t     dcp_cpuid4_edx; // unused currently
 
+    // cpuid function 4, subleaf 3 (last level cache parameters)
+    DcpCpuid4Eax dcp_cpuid4_llc_eax;
+    DcpCpuid4Ebx dcp_cpuid4_llc_ebx;
+    uint32_t     dcp_cpuid4_llc_ecx; // number of sets - 1
+
     // cpuid function 7 (structured extended features)
     SefCpuid7Eax sef_cpuid7_eax;
     SefCpuid7Ebx sef_cpuid7_ebx;
@@ -655,6 +660,7 @@ public:
   static ByteSize std_cpuid0_offset() { return byte_offset_of(CpuidInfo, std_max_function); }
   static ByteSize std_cpuid1_offset() { return byte_offset_of(CpuidInfo, std_cpuid1_eax); }
   static ByteSize dcp_cpuid4_offset() { return byte_offset_of(CpuidInfo, dcp_cpuid4_eax); }
+  static ByteSize dcp_cpuid4_llc_offset() { return byte_offset_of(CpuidInfo, dcp_cpuid4_llc_eax); }
   static ByteSize sef_cpuid7_offset() { return byte_offset_of(CpuidInfo, sef_cpuid7_eax); }
   static ByteSize ext_cpuid1_offset() { return byte_offset_of(CpuidInfo, ext_cpuid1_eax); }
   static ByteSize ext_cpuid5_offset() { return byte_offset_of(CpuidInfo, ext_cpuid5_eax); }
@@ -785,6 +791,16 @@ public:
     return result;
   }
 
+  // Size in bytes of the last level cache, or 0 if unknown.
+  static size_t LLC_size() {
+    if (is_intel() && _cpuid_info.dcp_cpuid4_llc_eax.bits.cache_type != 0) {
+      DcpCpuid4Ebx ebx = _cpuid_info.dcp_cpuid4_llc_ebx;
+      return (size_t)(ebx.bits.associativity + 1) * (ebx.bits.partitions + 1) *
+             (ebx.bits.L1_line_size + 1) * (_cpuid_info.dcp_cpuid4_llc_ecx + 1);
+    }
+    return 0;
+  }
+
   static intx prefetch_data_size()  {
     return L1_line_size();
   }
@@ -190,7 +190,7 @@ VtableStub* VtableStubs::create_itable_stub(int itable_index) {
   __ movptr(resolved_klass_reg, Address(icholder_reg, CompiledICHolder::holder_klass_offset()));
   __ movptr(holder_klass_reg,   Address(icholder_reg, CompiledICHolder::holder_metadata_offset()));
 
-  Label L_no_such_interface;
+  Label L_no_such_interface, L_resolved_is_holder;
 
   // get receiver klass (also an implicit null-check)
   assert(VtableStub::receiver_location() ==  rcx->as_VMReg(), "receiver expected in  rcx");
@@ -199,6 +199,12 @@ VtableStub* VtableStubs::create_itable_stub(int itable_index) {
 
   start_pc = __ pc();
 
+  // Most interface calls are to a method declared in the interface the call
+  // site refers to. The method lookup below then does the subtype check as
+  // well, and the receiver's itable is only scanned once.
+  __ cmpptr(resolved_klass_reg, holder_klass_reg);
+  __ jcc(Assembler::equal, L_resolved_is_holder);
+
   // Receiver subtype check against REFC.
   // Destroys recv_klass_reg value.
   __ lookup_interface_method(// inputs: rec. class, interface
@@ -214,6 +220,7 @@ VtableStub* VtableStubs::create_itable_stub(int itable_index) {
   // Get selected method from declaring class and itable index
   const Register method = rbx;
   __ load_klass(recv_klass_reg, rcx); // restore recv_klass_reg
+  __ bind(L_resolved_is_holder);
   __ lookup_interface_method(// inputs: rec. class, interface, itable index
                              recv_klass_reg, holder_klass_reg, itable_index,
                              // outputs: method, scan temp. reg
@@ -224,8 +231,8 @@ VtableStub* VtableStubs::create_itable_stub(int itable_index) {
 
   // We expect we need index_dependent_slop extra bytes. Reason:
   // The emitted code in lookup_interface_method changes when itable_index exceeds 31.
-  // For windows, a narrow estimate was found to be 104. Other OSes not tested.
-  const ptrdiff_t estimate = 104;
+  // For windows, a narrow estimate was found to be 112. Other OSes not tested.
+  const ptrdiff_t estimate = 112;
   const ptrdiff_t codesize = typecheckSize + lookupSize + index_dependent_slop;
   slop_delta  = (int)(estimate - codesize);
   slop_bytes += slop_delta;
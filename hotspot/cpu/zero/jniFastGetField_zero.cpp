@@ -61,3 +61,7 @@ address JNI_FastGetField::generate_fast_get_float_field() {
 address JNI_FastGetField::generate_fast_get_double_field() {
   return (address) -1;
 }
+
+address JNI_FastGetField::generate_fast_get_array_length() {
+  return (address) -1;
+}
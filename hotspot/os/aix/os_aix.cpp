@@ -1367,6 +1367,11 @@ void os::get_summary_os_info(char* buf, size_t buflen) {
   snprintf(buf, buflen, "%s %s", name.release, name.version);
 }
 
+bool os::get_memory_mappings_info(os::MemoryMappingsCallbackFunc callback, void *param) {
+  // Not yet implemented.
+  return false;
+}
+
 int os::get_loaded_modules_info(os::LoadedModulesCallbackFunc callback, void *param) {
   // Not yet implemented.
   return 0;
@@ -1502,6 +1502,11 @@ void os::print_dll_info(outputStream *st) {
   }
 }
 
+bool os::get_memory_mappings_info(os::MemoryMappingsCallbackFunc callback, void *param) {
+  // Not yet implemented.
+  return false;
+}
+
 int os::get_loaded_modules_info(os::LoadedModulesCallbackFunc callback, void *param) {
 #ifdef RTLD_DI_LINKMAP
   Dl_info dli;
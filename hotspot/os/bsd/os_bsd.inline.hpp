@@ -82,6 +82,8 @@ inline int os::fsync(int fd) {
   return ::fsync(fd);
 }
 
+inline void os::drop_file_cache(int fd, jlong offset, jlong length) {}
+
 inline int os::ftruncate(int fd, jlong length) {
   return ::ftruncate(fd, length);
 }
@@ -674,3 +674,20 @@ int OSContainer::cpu_shares() {
   return shares;
 }
 
+/* cpu_throttled_time
+ *
+ * Return the total time the tasks of the container were throttled
+ * because they had used up their CPU quota
+ *
+ * return:
+ *    throttled time in nanoseconds
+ *    OSCONTAINER_ERROR for not supported
+ */
+jlong OSContainer::cpu_throttled_time() {
+  const char* matchline = "throttled_time";
+  const char* format = "%s " JULONG_FORMAT;
+  GET_CONTAINER_INFO_LINE(julong, cpu, "/cpu.stat", matchline,
+                          "CPU Throttled Time is: " JULONG_FORMAT, format, throttled);
+  return (jlong)throttled;
+}
+
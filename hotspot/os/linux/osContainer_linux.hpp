@@ -59,6 +59,8 @@ class OSContainer: AllStatic {
 
   static int cpu_shares();
 
+  static jlong cpu_throttled_time();
+
 };
 
 inline bool OSContainer::is_containerized() {
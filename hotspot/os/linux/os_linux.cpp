@@ -2004,6 +2004,46 @@ int os::get_loaded_modules_info(os::LoadedModulesCallbackFunc callback, void *pa
   return 0;
 }
 
+bool os::get_memory_mappings_info(os::MemoryMappingsCallbackFunc callback, void *param) {
+  FILE* smapsFile = fopen("/proc/self/smaps", "r");
+  if (smapsFile == NULL) {
+    return false;
+  }
+  // Allocate PATH_MAX for file name plus a reasonable size for other fields.
+  char line[PATH_MAX + 100];
+  bool in_mapping = false;
+  u8 base = 0;
+  u8 top = 0;
+  u8 inode = 0;
+  size_t rss_kb = 0;
+
+  // Each mapping starts with a line like in /proc/self/maps, followed by
+  // "Key: value kB" lines with its statistics.
+  while (fgets(line, sizeof(line), smapsFile) != NULL) {
+    u8 new_base, new_top, offset, new_inode;
+    char permissions[5];
+    char device[16];
+    if (sscanf(line, UINT64_FORMAT_X "-" UINT64_FORMAT_X " %4s " UINT64_FORMAT_X " %15s " UINT64_FORMAT,
+               &new_base, &new_top, permissions, &offset, device, &new_inode) == 6) {
+      if (in_mapping) {
+        callback((address)base, (address)top, rss_kb * K, inode != 0, param);
+      }
+      in_mapping = true;
+      base = new_base;
+      top = new_top;
+      inode = new_inode;
+      rss_kb = 0;
+    } else if (in_mapping) {
+      sscanf(line, "Rss: " SIZE_FORMAT " kB", &rss_kb);
+    }
+  }
+  if (in_mapping) {
+    callback((address)base, (address)top, rss_kb * K, inode != 0, param);
+  }
+  fclose(smapsFile);
+  return true;
+}
+
 void os::print_os_info_brief(outputStream* st) {
   os::Linux::print_distro_info(st);
 
@@ -2860,7 +2900,11 @@ void os::pd_commit_memory_or_exit(char* addr, size_t size,
 }
 
 void os::pd_realign_memory(char *addr, size_t bytes, size_t alignment_hint) {
-  if (UseTransparentHugePages && alignment_hint > (size_t)vm_page_size()) {
+  // With UseHugeTLBFS, memory that is committed with a large page hint did
+  // not get hugetlbfs pages, because they ran out or the reservation was not
+  // large enough. Fall back to transparent huge pages instead, which the
+  // kernel provides in its "madvise" mode as well.
+  if ((UseTransparentHugePages || UseHugeTLBFS) && alignment_hint > (size_t)vm_page_size()) {
     // We don't check the return value: madvise(MADV_HUGEPAGE) may not
     // be supported or the memory may already be backed by huge pages.
     ::madvise(addr, bytes, MADV_HUGEPAGE);
@@ -3494,9 +3538,48 @@ bool os::unguard_memory(char* addr, size_t size) {
   return linux_mprotect(addr, size, PROT_READ|PROT_WRITE);
 }
 
+// Returns the kernel's transparent huge page mode ("always", "madvise" or
+// "never") in buf, or false if it cannot be determined.
+static bool transparent_huge_pages_mode(char* buf, size_t buflen) {
+  FILE* fp = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+  if (fp == NULL) {
+    return false;
+  }
+  char line[128];
+  bool found = false;
+  if (fgets(line, sizeof(line), fp) != NULL) {
+    // The selected mode is enclosed in brackets, e.g. "always [madvise] never".
+    char* start = strchr(line, '[');
+    char* end = start != NULL ? strchr(start, ']') : NULL;
+    if (end != NULL && (size_t)(end - start) <= buflen) {
+      size_t len = end - start - 1;
+      strncpy(buf, start + 1, len);
+      buf[len] = '\0';
+      found = true;
+    }
+  }
+  fclose(fp);
+  return found;
+}
+
 bool os::Linux::transparent_huge_pages_sanity_check(bool warn,
                                                     size_t page_size) {
   bool result = false;
+
+  // We only madvise() the ranges that should get huge pages, which works in
+  // the kernel's "madvise" mode as well as in "always", but not in "never".
+  char mode[16];
+  if (transparent_huge_pages_mode(mode, sizeof(mode))) {
+    log_info(pagesize)("Transparent huge pages mode: %s", mode);
+    if (strcmp(mode, "never") == 0) {
+      if (warn) {
+        warning("TransparentHugePages is disabled by the operating system "
+                "(/sys/kernel/mm/transparent_hugepage/enabled is never).");
+      }
+      return false;
+    }
+  }
+
   void *p = mmap(NULL, page_size * 2, PROT_READ|PROT_WRITE,
                  MAP_ANONYMOUS|MAP_PRIVATE,
                  -1, 0);
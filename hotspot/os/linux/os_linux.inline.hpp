@@ -30,6 +30,7 @@
 
 // System includes
 
+#include <fcntl.h>
 #include <unistd.h>
 #include <sys/socket.h>
 #include <poll.h>
@@ -74,6 +75,10 @@ inline int os::fsync(int fd) {
   return ::fsync(fd);
 }
 
+inline void os::drop_file_cache(int fd, jlong offset, jlong length) {
+  ::posix_fadvise64(fd, (off64_t)offset, (off64_t)length, POSIX_FADV_DONTNEED);
+}
+
 inline int os::ftruncate(int fd, jlong length) {
   return ::ftruncate64(fd, length);
 }
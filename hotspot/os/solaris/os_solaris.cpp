@@ -944,6 +944,9 @@ bool os::create_thread(Thread* thread, ThreadType thr_type,
     case watcher_thread:
       thrtyp = (char *)"watcher";
       break;
+    case asynclog_thread:
+      thrtyp = (char *)"asynclog";
+      break;
     default:
       thrtyp = (char *)"unknown";
       break;
@@ -1470,6 +1473,11 @@ bool os::dll_address_to_library_name(address addr, char* buf,
   return false;
 }
 
+bool os::get_memory_mappings_info(os::MemoryMappingsCallbackFunc callback, void *param) {
+  // Not yet implemented.
+  return false;
+}
+
 int os::get_loaded_modules_info(os::LoadedModulesCallbackFunc callback, void *param) {
   Dl_info dli;
   // Sanity check?
@@ -4318,6 +4326,8 @@ int os::fsync(int fd)  {
   RESTARTABLE_RETURN_INT(::fsync(fd));
 }
 
+void os::drop_file_cache(int fd, jlong offset, jlong length) {}
+
 int os::available(int fd, jlong *bytes) {
   assert(((JavaThread*)Thread::current())->thread_state() == _thread_in_native,
          "Assumed _thread_in_native");
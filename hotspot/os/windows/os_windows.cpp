@@ -628,6 +628,7 @@ bool os::create_thread(Thread* thread, ThreadType thr_type,
     case os::pgc_thread:
     case os::cgc_thread:
     case os::watcher_thread:
+    case os::asynclog_thread:
       if (VMThreadStackSize > 0) stack_size = (size_t)(VMThreadStackSize * K);
       break;
     }
@@ -1481,6 +1482,11 @@ void os::print_dll_info(outputStream *st) {
   get_loaded_modules_info(_print_module, (void *)st);
 }
 
+bool os::get_memory_mappings_info(os::MemoryMappingsCallbackFunc callback, void *param) {
+  // Not yet implemented.
+  return false;
+}
+
 int os::get_loaded_modules_info(os::LoadedModulesCallbackFunc callback, void *param) {
   HANDLE   hProcess;
 
@@ -4739,6 +4745,8 @@ int os::fsync(int fd) {
   return 0;
 }
 
+void os::drop_file_cache(int fd, jlong offset, jlong length) {}
+
 static int nonSeekAvailable(int, long *);
 static int stdinAvailable(int, long *);
 
@@ -31,6 +31,7 @@
 #include "gc/z/zNUMA.hpp"
 #include "gc/z/zPhysicalMemory.inline.hpp"
 #include "gc/z/zPhysicalMemoryBacking_linux_x86.hpp"
+#include "gc/z/zStat.hpp"
 #include "logging/log.hpp"
 #include "runtime/init.hpp"
 #include "runtime/os.hpp"
@@ -53,6 +54,9 @@
 // Proc file entry for max map mount
 #define ZFILENAME_PROC_MAX_MAP_COUNT         "/proc/sys/vm/max_map_count"
 
+static const ZStatCounter ZCounterMapSegments("Memory", "Map Segments", ZStatUnitOpsPerSecond);
+static const ZStatCounter ZCounterUnmapViews("Memory", "Unmap Views", ZStatUnitOpsPerSecond);
+
 bool ZPhysicalMemoryBacking::is_initialized() const {
   return _file.is_initialized();
 }
@@ -266,6 +270,10 @@ void ZPhysicalMemoryBacking::map_view(const ZPhysicalMemory& pmem, uintptr_t add
     size += segment.size();
   }
 
+  // Each segment is a separate mapping per view, and hence a separate
+  // set of page table entries and TLB entries to keep warm.
+  ZStatInc(ZCounterMapSegments, nsegments);
+
   // Advise on use of transparent huge pages before touching it
   if (ZLargePages::is_transparent()) {
     advise_view(addr, size, MADV_HUGEPAGE);
@@ -289,6 +297,8 @@ void ZPhysicalMemoryBacking::unmap_view(const ZPhysicalMemory& pmem, uintptr_t a
     ZErrno err;
     map_failed(err);
   }
+
+  ZStatInc(ZCounterUnmapViews);
 }
 
 uintptr_t ZPhysicalMemoryBacking::nmt_address(uintptr_t offset) const {
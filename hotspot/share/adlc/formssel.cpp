@@ -4200,6 +4200,7 @@ bool MatchRule::is_vector() const {
     "ReplicateB","ReplicateS","ReplicateI","ReplicateL","ReplicateF","ReplicateD",
     "LoadVector","StoreVector",
     "FmaVD", "FmaVF","PopCountVI",
+    "VectorCastB2X","VectorUCastB2X","VectorCastS2X","VectorUCastS2X","VectorCastI2X",
     // Next are not supported currently.
     "PackB","PackS","PackI","PackL","PackF","PackD","Pack2L","Pack2D",
     "ExtractB","ExtractUB","ExtractC","ExtractS","ExtractI","ExtractL","ExtractF","ExtractD"
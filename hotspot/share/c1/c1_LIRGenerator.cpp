@@ -929,7 +929,27 @@ LIR_Opr LIRGenerator::force_to_spill(LIR_Opr value, BasicType t) {
   return tmp;
 }
 
-void LIRGenerator::profile_branch(If* if_instr, If::Condition cond) {
+// With C1ProfileSampleShift, the MDO counters are only updated on one in
+// 2^C1ProfileSampleShift executions on average, by 2^C1ProfileSampleShift,
+// so that threads running the same hot method write its MDO less often.
+// Sampling uses a per-thread linear congruential generator rather than a
+// counter, so that the profiling sites of a loop do not fall into lockstep.
+void LIRGenerator::profile_sample(LabelObj* skip) {
+  assert(C1ProfileSampleShift > 0, "sampling is off");
+  LIR_Address* seed_addr = new LIR_Address(getThreadPointer(), in_bytes(JavaThread::profile_sample_seed_offset()), T_INT);
+  LIR_Opr seed = new_register(T_INT);
+  __ load(seed_addr, seed);
+  __ mul(seed, load_immediate(1664525, T_INT), seed);
+  __ add(seed, load_immediate(1013904223, T_INT), seed);
+  __ store(seed, seed_addr);
+  // The high bits are the most random ones
+  LIR_Opr mask = load_immediate(~right_n_bits(BitsPerInt - C1ProfileSampleShift), T_INT);
+  __ logical_and(seed, mask, seed);
+  __ cmp(lir_cond_notEqual, seed, LIR_OprFact::intConst(0));
+  __ branch(lir_cond_notEqual, T_INT, skip->label());
+}
+
+void LIRGenerator::profile_branch(If* if_instr, LIR_Condition cond, LIR_Opr left, LIR_Opr right) {
   if (if_instr->should_profile()) {
     ciMethod* method = if_instr->profiled_method();
     assert(method != NULL, "method should be set if branch is profiled");
@@ -946,23 +966,41 @@ void LIRGenerator::profile_branch(If* if_instr, If::Condition cond) {
       not_taken_count_offset = t;
     }
 
+    LabelObj* skip = NULL;
+    if (C1ProfileSampleShift > 0) {
+      skip = new LabelObj();
+      profile_sample(skip);
+    }
+
     LIR_Opr md_reg = new_register(T_METADATA);
     __ metadata2reg(md->constant_encoding(), md_reg);
 
+#if defined(X86) && !defined(_LP64)
+    // BEWARE! On 32-bit x86 cmp clobbers its left argument so we need a temp copy.
+    LIR_Opr left_copy = new_register(left->type());
+    __ move(left, left_copy);
+    __ cmp(cond, left_copy, right);
+#else
+    __ cmp(cond, left, right);
+#endif
     LIR_Opr data_offset_reg = new_pointer_register();
-    __ cmove(lir_cond(cond),
+    __ cmove(cond,
              LIR_OprFact::intptrConst(taken_count_offset),
              LIR_OprFact::intptrConst(not_taken_count_offset),
-             data_offset_reg, as_BasicType(if_instr->x()->type()));
+             data_offset_reg, left->type());
 
     // MDO cells are intptr_t, so the data_reg width is arch-dependent.
     LIR_Opr data_reg = new_pointer_register();
     LIR_Address* data_addr = new LIR_Address(md_reg, data_offset_reg, data_reg->type());
     __ move(data_addr, data_reg);
     // Use leal instead of add to avoid destroying condition codes on x86
-    LIR_Address* fake_incr_value = new LIR_Address(data_reg, DataLayout::counter_increment, T_INT);
+    LIR_Address* fake_incr_value = new LIR_Address(data_reg, DataLayout::counter_increment << C1ProfileSampleShift, T_INT);
     __ leal(LIR_OprFact::address(fake_incr_value), data_reg);
     __ move(data_reg, data_addr);
+
+    if (skip != NULL) {
+      __ branch_destination(skip->label());
+    }
   }
 }
 
@@ -3367,6 +3405,21 @@ void LIRGenerator::increment_event_counter_impl(CodeEmitInfo* info,
   } else {
     ShouldNotReachHere();
   }
+  // Sample the counters of the MDO only, and only as long as the samples are
+  // not sparser than the overflow notifications.
+  LabelObj* skip = NULL;
+  if (C1ProfileSampleShift > 0 && level == CompLevel_full_profile &&
+      (frequency == 0 || frequency >= right_n_bits(C1ProfileSampleShift))) {
+    skip = new LabelObj();
+    profile_sample(skip);
+    if (step->is_constant()) {
+      step = LIR_OprFact::intConst(step->as_jint() << C1ProfileSampleShift);
+    } else {
+      LIR_Opr scaled_step = new_register(T_INT);
+      __ shift_left(step, C1ProfileSampleShift, scaled_step);
+      step = scaled_step;
+    }
+  }
   LIR_Address* counter = new LIR_Address(counter_holder, offset, T_INT);
   LIR_Opr result = new_register(T_INT);
   __ load(counter, result);
@@ -3397,6 +3450,9 @@ void LIRGenerator::increment_event_counter_impl(CodeEmitInfo* info,
     }
     __ branch_destination(overflow->continuation());
   }
+  if (skip != NULL) {
+    __ branch_destination(skip->label());
+  }
 }
 
 void LIRGenerator::do_RuntimeCall(RuntimeCall* x) {
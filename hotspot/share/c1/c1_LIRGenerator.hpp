@@ -394,7 +394,11 @@ class LIRGenerator: public InstructionVisitor, public BlockClosure {
 
   LIR_Opr safepoint_poll_register();
 
-  void profile_branch(If* if_instr, If::Condition cond);
+  // Emitted before the compare of the branch itself, since it does its own
+  // compare and, with C1ProfileSampleShift, branches.
+  void profile_branch(If* if_instr, LIR_Condition cond, LIR_Opr left, LIR_Opr right);
+  // Branches to skip unless this execution is sampled.
+  void profile_sample(LabelObj* skip);
   void increment_event_counter_impl(CodeEmitInfo* info,
                                     ciMethod *method, LIR_Opr step, int frequency,
                                     int bci, bool backedge, bool notify);
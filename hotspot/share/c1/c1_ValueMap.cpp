@@ -44,6 +44,33 @@
 #endif
 
 
+// Simple alias analysis for array elements: arrays with different element
+// types are different arrays, and so are the results of two different
+// allocations. Mismatched accesses may touch any array.
+static BasicType alias_elt_type(AccessIndexed* x) {
+  switch (x->elt_type()) {
+    case T_BOOLEAN: return T_BYTE;   // baload and bastore are shared with byte arrays
+    case T_ARRAY:   return T_OBJECT;
+    default:        return x->elt_type();
+  }
+}
+
+static bool may_alias(StoreIndexed* store, LoadIndexed* load) {
+  if (store->mismatched() || load->mismatched()) {
+    return true;
+  }
+  if (alias_elt_type(store) != alias_elt_type(load)) {
+    return false;
+  }
+  Value store_array = store->array()->subst();
+  Value load_array = load->array()->subst();
+  if (store_array != load_array && store_array->as_NewArray() != NULL && load_array->as_NewArray() != NULL) {
+    return false;
+  }
+  return true;
+}
+
+
 ValueMap::ValueMap()
   : _nesting(0)
   , _entries(ValueMapInitialSize, ValueMapInitialSize, NULL)
@@ -182,8 +209,8 @@ Value ValueMap::find_insert(Value x) {
   bool must_kill = value->as_LoadField() != NULL || value->as_LoadIndexed() != NULL;
 
 #define MUST_KILL_ARRAY(must_kill, entry, value)                                         \
-  bool must_kill = value->as_LoadIndexed() != NULL                                       \
-                   && value->type()->tag() == type->tag();
+  LoadIndexed* li = value->as_LoadIndexed();                                             \
+  bool must_kill = li != NULL && may_alias(store, li);
 
 #define MUST_KILL_FIELD(must_kill, entry, value)                                         \
   /* ciField's are not unique; must compare their contents */                            \
@@ -197,7 +224,7 @@ void ValueMap::kill_memory() {
   GENERIC_KILL_VALUE(MUST_KILL_MEMORY);
 }
 
-void ValueMap::kill_array(ValueType* type) {
+void ValueMap::kill_array(StoreIndexed* store) {
   GENERIC_KILL_VALUE(MUST_KILL_ARRAY);
 }
 
@@ -265,8 +292,9 @@ class ShortLoopOptimizer : public ValueNumberingVisitor {
   GlobalValueNumbering* _gvn;
   BlockList             _loop_blocks;
   bool                  _too_complicated_loop;
-  bool                  _has_field_store[T_ARRAY + 1];
-  bool                  _has_indexed_store[T_ARRAY + 1];
+  bool                  _has_field_store[T_ARRAY + 1];   // stores to unresolved fields, by type
+  GrowableArray<ciField*>      _field_stores;
+  GrowableArray<StoreIndexed*> _indexed_stores;
 
   // simplified access to methods of GlobalValueNumbering
   ValueMap* current_map()                        { return _gvn->current_map(); }
@@ -276,13 +304,25 @@ class ShortLoopOptimizer : public ValueNumberingVisitor {
   void      kill_memory()                                 { _too_complicated_loop = true; }
   void      kill_field(ciField* field, bool all_offsets)  {
     current_map()->kill_field(field, all_offsets);
-    assert(field->type()->basic_type() >= 0 && field->type()->basic_type() <= T_ARRAY, "Invalid type");
-    _has_field_store[field->type()->basic_type()] = true;
+    if (all_offsets) {
+      // the holder of an unresolved field is not reliable, go by the type only
+      assert(field->type()->basic_type() >= 0 && field->type()->basic_type() <= T_ARRAY, "Invalid type");
+      _has_field_store[field->type()->basic_type()] = true;
+    } else {
+      _field_stores.append(field);
+    }
   }
-  void      kill_array(ValueType* type)                   {
-    current_map()->kill_array(type);
-    BasicType basic_type = as_BasicType(type); assert(basic_type >= 0 && basic_type <= T_ARRAY, "Invalid type");
-    _has_indexed_store[basic_type] = true;
+  void      kill_array(StoreIndexed* store)               {
+    current_map()->kill_array(store);
+    _indexed_stores.append(store);
+  }
+
+  void      reset_stores() {
+    for (int i = 0; i <= T_ARRAY; i++) {
+      _has_field_store[i] = false;
+    }
+    _field_stores.clear();
+    _indexed_stores.clear();
   }
 
  public:
@@ -291,20 +331,32 @@ class ShortLoopOptimizer : public ValueNumberingVisitor {
     , _loop_blocks(ValueMapMaxLoopSize)
     , _too_complicated_loop(false)
   {
-    for (int i=0; i<= T_ARRAY; i++){
-      _has_field_store[i] = false;
-      _has_indexed_store[i] = false;
-    }
+    reset_stores();
   }
 
-  bool has_field_store(BasicType type) {
+  bool has_field_store(ciField* field) {
+    BasicType type = field->type()->basic_type();
     assert(type >= 0 && type <= T_ARRAY, "Invalid type");
-    return _has_field_store[type];
+    if (_has_field_store[type]) {
+      return true;
+    }
+    // ciField's are not unique; must compare their contents
+    for (int i = 0; i < _field_stores.length(); i++) {
+      ciField* store = _field_stores.at(i);
+      if (store->holder() == field->holder() && store->offset() == field->offset()) {
+        return true;
+      }
+    }
+    return false;
   }
 
-  bool has_indexed_store(BasicType type) {
-    assert(type >= 0 && type <= T_ARRAY, "Invalid type");
-    return _has_indexed_store[type];
+  bool has_indexed_store(LoadIndexed* load) {
+    for (int i = 0; i < _indexed_stores.length(); i++) {
+      if (may_alias(_indexed_stores.at(i), load)) {
+        return true;
+      }
+    }
+    return false;
   }
 
   bool process(BlockBegin* loop_header);
@@ -378,16 +430,20 @@ void LoopInvariantCodeMotion::process_block(BlockBegin* block) {
       assert(cur->as_Op2() != NULL, "must be Op2");
       Op2* op2 = (Op2*)cur;
       cur_invariant = !op2->can_trap() && is_invariant(op2->x()) && is_invariant(op2->y());
+    } else if (cur->as_NegateOp() != NULL) {
+      cur_invariant = is_invariant(cur->as_NegateOp()->x());
+    } else if (cur->as_Convert() != NULL) {
+      cur_invariant = is_invariant(cur->as_Convert()->value());
     } else if (cur->as_LoadField() != NULL) {
       LoadField* lf = (LoadField*)cur;
       // deoptimizes on NullPointerException
-      cur_invariant = !lf->needs_patching() && !lf->field()->is_volatile() && !_short_loop_optimizer->has_field_store(lf->field()->type()->basic_type()) && is_invariant(lf->obj()) && _insert_is_pred;
+      cur_invariant = !lf->needs_patching() && !lf->field()->is_volatile() && !_short_loop_optimizer->has_field_store(lf->field()) && is_invariant(lf->obj()) && _insert_is_pred;
     } else if (cur->as_ArrayLength() != NULL) {
       ArrayLength *length = cur->as_ArrayLength();
       cur_invariant = is_invariant(length->array());
     } else if (cur->as_LoadIndexed() != NULL) {
       LoadIndexed *li = (LoadIndexed *)cur->as_LoadIndexed();
-      cur_invariant = !_short_loop_optimizer->has_indexed_store(as_BasicType(cur->type())) && is_invariant(li->array()) && is_invariant(li->index()) && _insert_is_pred;
+      cur_invariant = !_short_loop_optimizer->has_indexed_store(li) && is_invariant(li->array()) && is_invariant(li->index()) && _insert_is_pred;
     }
 
     if (cur_invariant) {
@@ -435,6 +491,8 @@ bool ShortLoopOptimizer::process(BlockBegin* loop_header) {
   _too_complicated_loop = false;
   _loop_blocks.clear();
   _loop_blocks.append(loop_header);
+  // only the stores of this loop prevent code motion
+  reset_stores();
 
   for (int i = 0; i < _loop_blocks.length(); i++) {
     BlockBegin* block = _loop_blocks.at(i);
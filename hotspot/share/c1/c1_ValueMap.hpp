@@ -115,7 +115,7 @@ class ValueMap: public CompilationResourceObj {
 
   void kill_memory();
   void kill_field(ciField* field, bool all_offsets);
-  void kill_array(ValueType* type);
+  void kill_array(StoreIndexed* store);
   void kill_exception();
   void kill_map(ValueMap* map);
   void kill_all();
@@ -136,7 +136,7 @@ class ValueNumberingVisitor: public InstructionVisitor {
   // called by visitor functions for instructions that kill values
   virtual void kill_memory() = 0;
   virtual void kill_field(ciField* field, bool all_offsets) = 0;
-  virtual void kill_array(ValueType* type) = 0;
+  virtual void kill_array(StoreIndexed* store) = 0;
 
   // visitor functions
   void do_StoreField     (StoreField*      x) {
@@ -150,7 +150,7 @@ class ValueNumberingVisitor: public InstructionVisitor {
       kill_field(x->field(), x->needs_patching());
     }
   }
-  void do_StoreIndexed   (StoreIndexed*    x) { kill_array(x->type()); }
+  void do_StoreIndexed   (StoreIndexed*    x) { kill_array(x); }
   void do_MonitorEnter   (MonitorEnter*    x) { kill_memory(); }
   void do_MonitorExit    (MonitorExit*     x) { kill_memory(); }
   void do_Invoke         (Invoke*          x) { kill_memory(); }
@@ -223,7 +223,7 @@ class ValueNumberingEffects: public ValueNumberingVisitor {
   // implementation for abstract methods of ValueNumberingVisitor
   void          kill_memory()                                 { _map->kill_memory(); }
   void          kill_field(ciField* field, bool all_offsets)  { _map->kill_field(field, all_offsets); }
-  void          kill_array(ValueType* type)                   { _map->kill_array(type); }
+  void          kill_array(StoreIndexed* store)               { _map->kill_array(store); }
 
   ValueNumberingEffects(ValueMap* map): _map(map) {}
 };
@@ -250,7 +250,7 @@ class GlobalValueNumbering: public ValueNumberingVisitor {
   // implementation for abstract methods of ValueNumberingVisitor
   void          kill_memory()                                 { current_map()->kill_memory(); }
   void          kill_field(ciField* field, bool all_offsets)  { current_map()->kill_field(field, all_offsets); }
-  void          kill_array(ValueType* type)                   { current_map()->kill_array(type); }
+  void          kill_array(StoreIndexed* store)               { current_map()->kill_array(store); }
 
   // main entry point that performs global value numbering
   GlobalValueNumbering(IR* ir);
@@ -321,6 +321,12 @@
   product(bool, C1UpdateMethodData, trueInTiered,                           \
           "Update MethodData*s in Tier1-generated code")                    \
                                                                             \
+  product(intx, C1ProfileSampleShift, 0,                                    \
+          "Update the branch profiles and the invocation and backedge "     \
+          "counters in the MDOs of tier 3 code only on a random one in "    \
+          "2^n executions, by 2^n. 0 updates them every time")              \
+          range(0, 8)                                                       \
+                                                                            \
   develop(bool, PrintCFGToFile, false,                                      \
           "print control flow graph to a separate file during compilation") \
                                                                             \
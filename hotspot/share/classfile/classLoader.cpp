@@ -29,6 +29,7 @@
 #include "classfile/classLoader.inline.hpp"
 #include "classfile/classLoaderData.inline.hpp"
 #include "classfile/classLoaderExt.hpp"
+#include "classfile/classPrefetcher.hpp"
 #include "classfile/javaClasses.hpp"
 #include "classfile/moduleEntry.hpp"
 #include "classfile/modules.hpp"
@@ -101,6 +102,10 @@ static JImageOpen_t                    JImageOpen             = NULL;
 static JImageClose_t                   JImageClose            = NULL;
 static JImagePackageToModule_t         JImagePackageToModule  = NULL;
 static JImageFindResource_t            JImageFindResource     = NULL;
+static JImageFindResources_t           JImageFindResources    = NULL;
+static JImagePrefaultIndex_t           JImagePrefaultIndex    = NULL;
+static JImageSetResourceCacheSize_t    JImageSetResourceCacheSize = NULL;
+static JImagePrefetchResource_t        JImagePrefetchResource = NULL;
 static JImageGetResource_t             JImageGetResource      = NULL;
 static JImageResourceIterator_t        JImageResourceIterator = NULL;
 
@@ -454,6 +459,16 @@ ClassFileStream* ClassPathImageEntry::open_stream_for_loader(const char* name, C
   return NULL;
 }
 
+int ClassLoader::jimage_find_resources(JImageFile* jf,
+                                       const char* module_name,
+                                       const char** file_names,
+                                       int count,
+                                       JImageLocationRef* locations,
+                                       jlong* sizes) {
+  return (*JImageFindResources)(jf, module_name, get_jimage_version_string(),
+                                file_names, count, locations, sizes);
+}
+
 JImageLocationRef ClassLoader::jimage_find_resource(JImageFile* jf,
                                                     const char* module_name,
                                                     const char* file_name,
@@ -461,6 +476,14 @@ JImageLocationRef ClassLoader::jimage_find_resource(JImageFile* jf,
   return ((*JImageFindResource)(jf, module_name, get_jimage_version_string(), file_name, &size));
 }
 
+const char* ClassLoader::jimage_package_to_module(JImageFile* jf, const char* package_name) {
+  return (*JImagePackageToModule)(jf, package_name);
+}
+
+void ClassLoader::jimage_prefetch_resource(JImageFile* jf, JImageLocationRef location) {
+  (*JImagePrefetchResource)(jf, location);
+}
+
 bool ClassPathImageEntry::is_modules_image() const {
   assert(this == _singleton, "VM supports a single jimage");
   assert(this == (ClassPathImageEntry*)ClassLoader::get_jrt_entry(), "must be used for jrt entry");
@@ -821,6 +844,9 @@ ClassPathEntry* ClassLoader::create_class_path_entry(const char *path, const str
     jint error;
     JImageFile* jimage =(*JImageOpen)(canonical_path, &error);
     if (jimage != NULL) {
+      if (PrefaultJImageIndex) {
+        (*JImagePrefaultIndex)(jimage);
+      }
       new_entry = new ClassPathImageEntry(jimage, canonical_path);
     } else {
       char* error_msg = NULL;
@@ -1095,10 +1121,22 @@ void ClassLoader::load_jimage_library() {
   guarantee(JImagePackageToModule != NULL, "function JIMAGE_PackageToModule not found");
   JImageFindResource = CAST_TO_FN_PTR(JImageFindResource_t, os::dll_lookup(handle, "JIMAGE_FindResource"));
   guarantee(JImageFindResource != NULL, "function JIMAGE_FindResource not found");
+  JImageFindResources = CAST_TO_FN_PTR(JImageFindResources_t, os::dll_lookup(handle, "JIMAGE_FindResources"));
+  guarantee(JImageFindResources != NULL, "function JIMAGE_FindResources not found");
+  JImagePrefaultIndex = CAST_TO_FN_PTR(JImagePrefaultIndex_t, os::dll_lookup(handle, "JIMAGE_PrefaultIndex"));
+  guarantee(JImagePrefaultIndex != NULL, "function JIMAGE_PrefaultIndex not found");
+  JImageSetResourceCacheSize = CAST_TO_FN_PTR(JImageSetResourceCacheSize_t, os::dll_lookup(handle, "JIMAGE_SetResourceCacheSize"));
+  guarantee(JImageSetResourceCacheSize != NULL, "function JIMAGE_SetResourceCacheSize not found");
+  JImagePrefetchResource = CAST_TO_FN_PTR(JImagePrefetchResource_t, os::dll_lookup(handle, "JIMAGE_PrefetchResource"));
+  guarantee(JImagePrefetchResource != NULL, "function JIMAGE_PrefetchResource not found");
   JImageGetResource = CAST_TO_FN_PTR(JImageGetResource_t, os::dll_lookup(handle, "JIMAGE_GetResource"));
   guarantee(JImageGetResource != NULL, "function JIMAGE_GetResource not found");
   JImageResourceIterator = CAST_TO_FN_PTR(JImageResourceIterator_t, os::dll_lookup(handle, "JIMAGE_ResourceIterator"));
   guarantee(JImageResourceIterator != NULL, "function JIMAGE_ResourceIterator not found");
+
+  if (JImageResourceCacheSize > 0) {
+    (*JImageSetResourceCacheSize)((jlong)JImageResourceCacheSize);
+  }
 }
 
 jboolean ClassLoader::decompress(void *in, u8 inSize, void *out, u8 outSize, char **pmsg) {
@@ -1291,26 +1329,13 @@ ClassFileStream* ClassLoader::search_module_entries(const GrowableArray<ModuleCl
   return NULL;
 }
 
-// Called by the boot classloader to load classes
-InstanceKlass* ClassLoader::load_class(Symbol* name, bool search_append_only, TRAPS) {
-  assert(name != NULL, "invariant");
-  assert(THREAD->is_Java_thread(), "must be a JavaThread");
-
-  ResourceMark rm(THREAD);
-  HandleMark hm(THREAD);
-
-  const char* const class_name = name->as_C_string();
-
-  EventMark m("loading class %s", class_name);
-
-  const char* const file_name = file_name_for_class_name(class_name,
-                                                         name->utf8_length());
-  assert(file_name != NULL, "invariant");
-
-  // Lookup stream for parsing .class file
+ClassFileStream* ClassLoader::search_class_file(const char* const class_name,
+                                                const char* const file_name,
+                                                bool search_append_only,
+                                                s2* classpath_index, TRAPS) {
   ClassFileStream* stream = NULL;
-  s2 classpath_index = 0;
   ClassPathEntry* e = NULL;
+  *classpath_index = 0;
 
   // If search_append_only is true, boot loader visibility boundaries are
   // set to be _first_append_entry to the end. This includes:
@@ -1361,8 +1386,8 @@ InstanceKlass* ClassLoader::load_class(Symbol* name, bool search_append_only, TR
     // For the boot loader append path search, the starting classpath_index
     // for the appended piece is always 1 to account for either the
     // _jrt_entry or the _exploded_entries.
-    assert(classpath_index == 0, "The classpath_index has been incremented incorrectly");
-    classpath_index = 1;
+    assert(*classpath_index == 0, "The classpath_index has been incremented incorrectly");
+    *classpath_index = 1;
 
     e = _first_append_entry;
     while (e != NULL) {
@@ -1371,10 +1396,38 @@ InstanceKlass* ClassLoader::load_class(Symbol* name, bool search_append_only, TR
         break;
       }
       e = e->next();
-      ++classpath_index;
+      ++(*classpath_index);
     }
   }
 
+  return stream;
+}
+
+// Called by the boot classloader to load classes
+InstanceKlass* ClassLoader::load_class(Symbol* name, bool search_append_only, TRAPS) {
+  assert(name != NULL, "invariant");
+  assert(THREAD->is_Java_thread(), "must be a JavaThread");
+
+  ResourceMark rm(THREAD);
+  HandleMark hm(THREAD);
+
+  const char* const class_name = name->as_C_string();
+
+  EventMark m("loading class %s", class_name);
+
+  const char* const file_name = file_name_for_class_name(class_name,
+                                                         name->utf8_length());
+  assert(file_name != NULL, "invariant");
+
+  // Lookup stream for parsing .class file. Classes named in PrefetchClassList
+  // may already have been read by the prefetch threads.
+  s2 classpath_index = 0;
+  ClassFileStream* stream = ClassPrefetcher::take(name, search_append_only, &classpath_index);
+  if (NULL == stream) {
+    stream = search_class_file(class_name, file_name, search_append_only,
+                               &classpath_index, CHECK_NULL);
+  }
+
   if (NULL == stream) {
     return NULL;
   }
@@ -1437,6 +1490,16 @@ void ClassLoader::record_result(InstanceKlass* ik, const ClassFileStream* stream
   }
 
   oop loader = ik->class_loader();
+  if (DynamicDumpSharedSpaces && loader != NULL &&
+      !SystemDictionary::is_system_class_loader(loader) &&
+      !SystemDictionary::is_platform_class_loader(loader)) {
+    // Classes of custom loaders are matched by their contents at runtime,
+    // whether or not they have a source.
+    ik->set_shared_classpath_index(UNREGISTERED_INDEX);
+    SystemDictionaryShared::set_shared_class_misc_info(ik, (ClassFileStream*)stream);
+    return;
+  }
+
   char* src = (char*)stream->source();
   if (src == NULL) {
     if (loader == NULL) {
@@ -1796,6 +1859,16 @@ PerfClassTraceTime::~PerfClassTraceTime() {
   // add all class loading related event selftime to the accumulated time counter
   ClassLoader::perf_accumulated_time()->inc(selftime);
 
+  if (_loader_data != NULL) {
+    switch (_event_type) {
+      case PARSE_CLASS:  _loader_data->add_loading_ticks(ClassLoaderData::parse_phase, selftime);  break;
+      case CLASS_VERIFY: _loader_data->add_loading_ticks(ClassLoaderData::verify_phase, selftime); break;
+      case CLASS_LINK:   _loader_data->add_loading_ticks(ClassLoaderData::link_phase, selftime);   break;
+      case CLASS_CLINIT: _loader_data->add_loading_ticks(ClassLoaderData::init_phase, selftime);   break;
+      default:           break;
+    }
+  }
+
   // reset the timer
   _timers[_event_type].reset();
 }
@@ -353,6 +353,13 @@ class ClassLoader: AllStatic {
                                                 const char* const class_name,
                                                 const char* const file_name, TRAPS);
 
+  // Locate the .class file of a class on the boot loader's search path.
+  // Returns a resource allocated stream, or NULL if there is no such file.
+  static ClassFileStream* search_class_file(const char* const class_name,
+                                            const char* const file_name,
+                                            bool search_append_only,
+                                            s2* classpath_index, TRAPS);
+
   // Load individual .class file
   static InstanceKlass* load_class(Symbol* class_name, bool search_append_only, TRAPS);
 
@@ -418,6 +425,14 @@ class ClassLoader: AllStatic {
 #endif
   static JImageLocationRef jimage_find_resource(JImageFile* jf, const char* module_name,
                                                 const char* file_name, jlong &size);
+  // Looks up count resources of one module at once. Returns the number found.
+  static int jimage_find_resources(JImageFile* jf, const char* module_name,
+                                   const char** file_names, int count,
+                                   JImageLocationRef* locations, jlong* sizes);
+  // Returns the module of a package in the image, or NULL.
+  static const char* jimage_package_to_module(JImageFile* jf, const char* package_name);
+  // Decompresses a resource into the jimage resource cache, see JImageResourceCacheSize.
+  static void jimage_prefetch_resource(JImageFile* jf, JImageLocationRef location);
 
   static void  trace_class_path(const char* msg, const char* name = NULL);
 
@@ -484,6 +499,9 @@ class PerfClassTraceTime {
   elapsedTimer*    _timers;
   int              _event_type;
   int              _prev_active_event;
+  // Class loader to which the self time of parsing, verifying, linking or
+  // initializing is also attributed, or NULL.
+  ClassLoaderData* _loader_data;
 
  public:
 
@@ -492,15 +510,18 @@ class PerfClassTraceTime {
                             PerfLongCounter* eventp,    /* event counter */
                             int* recursion_counters,    /* thread-local recursion counter array */
                             elapsedTimer* timers,       /* thread-local timer array */
-                            int type                    /* event type */ ) :
-      _timep(timep), _selftimep(selftimep), _eventp(eventp), _recursion_counters(recursion_counters), _timers(timers), _event_type(type) {
+                            int type,                   /* event type */
+                            ClassLoaderData* loader_data = NULL /* loader of the class */ ) :
+      _timep(timep), _selftimep(selftimep), _eventp(eventp), _recursion_counters(recursion_counters), _timers(timers), _event_type(type),
+      _loader_data(loader_data) {
     initialize();
   }
 
   inline PerfClassTraceTime(PerfLongCounter* timep,     /* counter incremented with inclusive time */
                             elapsedTimer* timers,       /* thread-local timer array */
                             int type                    /* event type */ ) :
-      _timep(timep), _selftimep(NULL), _eventp(NULL), _recursion_counters(NULL), _timers(timers), _event_type(type) {
+      _timep(timep), _selftimep(NULL), _eventp(NULL), _recursion_counters(NULL), _timers(timers), _event_type(type),
+      _loader_data(NULL) {
     initialize();
   }
 
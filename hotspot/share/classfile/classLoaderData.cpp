@@ -172,6 +172,10 @@ ClassLoaderData::ClassLoaderData(Handle h_class_loader, bool is_unsafe_anonymous
 
   NOT_PRODUCT(_dependency_count = 0); // number of class loader dependencies
 
+  for (int i = 0; i < number_of_loading_phases; i++) {
+    _loading_ticks[i] = 0;
+  }
+
   JFR_ONLY(INIT_ID(this);)
 }
 
@@ -967,6 +971,15 @@ void ClassLoaderData::verify() {
   }
 }
 
+void ClassLoaderData::add_loading_ticks(LoadingPhase phase, jlong ticks) {
+  // Classes of the same loader may be loaded by several threads at once.
+  volatile jlong* dest = &_loading_ticks[phase];
+  jlong old_value;
+  do {
+    old_value = Atomic::load(dest);
+  } while (Atomic::cmpxchg(old_value + ticks, dest, old_value) != old_value);
+}
+
 bool ClassLoaderData::contains_klass(Klass* klass) {
   // Lock-free access requires load_acquire
   for (Klass* k = OrderAccess::load_acquire(&_klasses); k != NULL; k = k->next_link()) {
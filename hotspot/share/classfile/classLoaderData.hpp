@@ -159,6 +159,20 @@ class ClassLoaderData : public CHeapObj<mtClass> {
   Symbol* _name_and_id;
   JFR_ONLY(DEFINE_TRACE_ID_FIELD;)
 
+ public:
+  // The phases of loading a class that are timed per class loader, see
+  // PerfClassTraceTime.
+  enum LoadingPhase {
+    parse_phase,
+    verify_phase,
+    link_phase,
+    init_phase,
+    number_of_loading_phases
+  };
+
+ private:
+  volatile jlong _loading_ticks[number_of_loading_phases]; // Self time of each phase
+
   void set_next(ClassLoaderData* next) { _next = next; }
   ClassLoaderData* next() const        { return Atomic::load(&_next); }
 
@@ -330,6 +344,11 @@ class ClassLoaderData : public CHeapObj<mtClass> {
   const char* loader_name_and_id() const;
   Symbol* name_and_id() const { return _name_and_id; }
 
+  // Time spent in a phase of loading the classes of this class loader,
+  // exclusive of the other phases, in elapsed counter ticks.
+  void add_loading_ticks(LoadingPhase phase, jlong ticks);
+  jlong loading_ticks(LoadingPhase phase) const { return Atomic::load(&_loading_ticks[phase]); }
+
   JFR_ONLY(DEFINE_TRACE_ID_METHODS;)
 };
 
@@ -127,8 +127,6 @@ class ClassLoaderDataGraph : public AllStatic {
     return res;
   }
 
-  static int resize_dictionaries();
-
   static bool has_metaspace_oom()           { return _metaspace_oom; }
   static void set_metaspace_oom(bool value) { _metaspace_oom = value; }
 
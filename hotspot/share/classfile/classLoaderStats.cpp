@@ -27,6 +27,7 @@
 #include "classfile/classLoaderDataGraph.hpp"
 #include "classfile/classLoaderStats.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/timer.hpp"
 #include "utilities/globalDefinitions.hpp"
 
 
@@ -90,6 +91,11 @@ void ClassLoaderStatsClosure::do_cld(ClassLoaderData* cld) {
     _total_chunk_sz += ms->allocated_chunks_bytes();
     _total_block_sz += ms->allocated_blocks_bytes();
   }
+
+  // Unsafe anonymous classes are timed together with the others
+  for (int i = 0; i < ClassLoaderData::number_of_loading_phases; i++) {
+    cls->_loading_ticks[i] += cld->loading_ticks((ClassLoaderData::LoadingPhase)i);
+  }
 }
 
 
@@ -121,6 +127,16 @@ bool ClassLoaderStatsClosure::do_entry(oop const& key, ClassLoaderStats* const&
         cls->_anon_classes_count,
         cls->_anon_chunk_sz, cls->_anon_block_sz);
   }
+  jlong* ticks = cls->_loading_ticks;
+  if (ticks[ClassLoaderData::parse_phase] != 0 || ticks[ClassLoaderData::verify_phase] != 0 ||
+      ticks[ClassLoaderData::link_phase] != 0 || ticks[ClassLoaderData::init_phase] != 0) {
+    _out->print_cr(SPACE SPACE SPACE "    parse %.3fms, verify %.3fms, link %.3fms, init %.3fms",
+        "", "", "",
+        TimeHelper::counter_to_millis(ticks[ClassLoaderData::parse_phase]),
+        TimeHelper::counter_to_millis(ticks[ClassLoaderData::verify_phase]),
+        TimeHelper::counter_to_millis(ticks[ClassLoaderData::link_phase]),
+        TimeHelper::counter_to_millis(ticks[ClassLoaderData::init_phase]));
+  }
   return true;
 }
 
@@ -136,6 +152,7 @@ void ClassLoaderStatsClosure::print() {
       _total_block_sz);
   _out->print_cr("ChunkSz: Total size of all allocated metaspace chunks");
   _out->print_cr("BlockSz: Total size of all allocated metaspace blocks (each chunk has several blocks)");
+  _out->print_cr("parse, verify, link, init: Self time of the phases of loading the classes");
 }
 
 
@@ -81,6 +81,9 @@ public:
   size_t            _anon_block_sz;
   uintx             _anon_classes_count;
 
+  // Self time of loading the classes, see ClassLoaderData::LoadingPhase
+  jlong             _loading_ticks[ClassLoaderData::number_of_loading_phases];
+
   ClassLoaderStats() :
     _cld(0),
     _class_loader(0),
@@ -91,6 +94,9 @@ public:
     _anon_chunk_sz(0),
     _anon_block_sz(0),
     _anon_classes_count(0) {
+    for (int i = 0; i < ClassLoaderData::number_of_loading_phases; i++) {
+      _loading_ticks[i] = 0;
+    }
   }
 };
 
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#include "precompiled.hpp"
+#include "classfile/classFileStream.hpp"
+#include "classfile/classLoader.hpp"
+#include "classfile/classPrefetcher.hpp"
+#include "classfile/javaClasses.hpp"
+#include "classfile/symbolTable.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "classfile/vmSymbols.hpp"
+#include "logging/log.hpp"
+#include "memory/allocation.inline.hpp"
+#include "memory/resourceArea.hpp"
+#include "memory/universe.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/javaCalls.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.inline.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/resourceHash.hpp"
+#if INCLUDE_CDS
+#include "classfile/systemDictionaryShared.hpp"
+#endif
+
+// A class file read by one of the prefetch threads, and where on the boot
+// class path it was found.
+class PrefetchedClass : public CHeapObj<mtClass> {
+ public:
+  u1*   _buffer;
+  int   _length;
+  char* _source;
+  bool  _from_boot_loader_modules_image;
+  bool  _search_append_only;
+  s2    _classpath_index;
+
+  PrefetchedClass(const ClassFileStream* stream, bool search_append_only, s2 classpath_index) :
+    _length(stream->length()),
+    _source(stream->source() != NULL ? os::strdup_check_oom(stream->source(), mtClass) : NULL),
+    _from_boot_loader_modules_image(stream->from_boot_loader_modules_image()),
+    _search_append_only(search_append_only),
+    _classpath_index(classpath_index) {
+    _buffer = NEW_C_HEAP_ARRAY(u1, _length, mtClass);
+    memcpy(_buffer, stream->buffer(), _length);
+  }
+
+  ~PrefetchedClass() {
+    FREE_C_HEAP_ARRAY(u1, _buffer);
+    os::free(_source);
+  }
+};
+
+// Keyed by the class name. The table holds a reference to each name.
+typedef ResourceHashtable<Symbol*, PrefetchedClass*,
+                          primitive_hash<Symbol*>, primitive_equals<Symbol*>,
+                          1031, ResourceObj::C_HEAP, mtClass> PrefetchedClassTable;
+
+// _table is published once the class list has been read, and never freed.
+static PrefetchedClassTable* _table = NULL;
+static Mutex* _table_lock = NULL;
+
+// The class names from PrefetchClassList. The threads claim them in order.
+static char** _names = NULL;
+static int _name_count = 0;
+static volatile int _next_name = 0;
+
+static volatile int _prefetched_count = 0;
+static volatile int _taken_count = 0;
+
+static bool is_boot_shared_class(Symbol* name) {
+#if INCLUDE_CDS
+  if (UseSharedSpaces) {
+    InstanceKlass* ik = SystemDictionaryShared::find_builtin_class(name);
+    return ik != NULL && ik->is_shared_boot_class();
+  }
+#endif
+  return false;
+}
+
+static void prefetch_class(const char* class_name, TRAPS) {
+  ResourceMark rm(THREAD);
+  Symbol* name = SymbolTable::new_symbol(class_name);
+
+  // Already loaded, or loaded from the CDS archive instead of the class file.
+  if (SystemDictionary::find(name, Handle(), Handle(), THREAD) != NULL || is_boot_shared_class(name)) {
+    name->decrement_refcount();
+    return;
+  }
+
+  const char* const file_name = ClassLoader::file_name_for_class_name(class_name,
+                                                                      name->utf8_length());
+  bool search_append_only = false;
+  s2 classpath_index = 0;
+  ClassFileStream* stream = ClassLoader::search_class_file(class_name, file_name, search_append_only,
+                                                           &classpath_index, THREAD);
+  if (!HAS_PENDING_EXCEPTION && stream == NULL) {
+    search_append_only = true;
+    stream = ClassLoader::search_class_file(class_name, file_name, search_append_only,
+                                            &classpath_index, THREAD);
+  }
+  if (HAS_PENDING_EXCEPTION) {
+    // Leave it to the loading thread to report.
+    CLEAR_PENDING_EXCEPTION;
+    stream = NULL;
+  }
+  if (stream == NULL) {
+    log_debug(class, load)("Prefetch: %s not found on the boot class path", class_name);
+    name->decrement_refcount();
+    return;
+  }
+
+  PrefetchedClass* pc = new PrefetchedClass(stream, search_append_only, classpath_index);
+  bool added;
+  {
+    MutexLocker ml(_table_lock, Mutex::_no_safepoint_check_flag);
+    added = !_table->contains(name) && _table->put(name, pc);
+  }
+  if (!added) {
+    // Named more than once in the list.
+    delete pc;
+    name->decrement_refcount();
+    return;
+  }
+  Atomic::inc(&_prefetched_count);
+}
+
+static void prefetch_thread_entry(JavaThread* thread, TRAPS) {
+  while (true) {
+    int i = Atomic::add(1, &_next_name) - 1;
+    if (i >= _name_count) {
+      break;
+    }
+    prefetch_class(_names[i], THREAD);
+  }
+  log_info(class, load)("Prefetch: %s done, %d of %d class files read",
+                        thread->get_thread_name(), _prefetched_count, _name_count);
+}
+
+class ClassPrefetchThread : public JavaThread {
+ public:
+  ClassPrefetchThread() : JavaThread(&prefetch_thread_entry) {}
+
+  // Hide this thread from external view.
+  bool is_hidden_from_external_view() const { return true; }
+};
+
+static bool read_class_list(const char* path) {
+  FILE* file = fopen(path, "r");
+  if (file == NULL) {
+    warning("Could not open class list %s for prefetching", path);
+    return false;
+  }
+
+  GrowableArray<char*>* names = new GrowableArray<char*>(1024, true, mtClass);
+  char line[1024];
+  while (fgets(line, sizeof(line), file) != NULL) {
+    // Same format as SharedClassListFile: the class name comes first,
+    // comments and other directives are skipped.
+    if (line[0] == '#' || line[0] == '@') {
+      continue;
+    }
+    char name[1024];
+    if (sscanf(line, "%1023s", name) != 1) {
+      continue;
+    }
+    names->append(os::strdup_check_oom(name, mtClass));
+  }
+  fclose(file);
+
+  _name_count = names->length();
+  _names = NEW_C_HEAP_ARRAY(char*, MAX2(_name_count, 1), mtClass);
+  for (int i = 0; i < _name_count; i++) {
+    _names[i] = names->at(i);
+  }
+  delete names;
+  return _name_count > 0;
+}
+
+void ClassPrefetcher::initialize(TRAPS) {
+  if (PrefetchClassList == NULL || DumpSharedSpaces || DynamicDumpSharedSpaces) {
+    return;
+  }
+  if (!read_class_list(PrefetchClassList)) {
+    return;
+  }
+
+  _table_lock = new Mutex(Mutex::leaf, "ClassPrefetch_lock", true, Mutex::_safepoint_check_never);
+  OrderAccess::release_store(&_table, new (ResourceObj::C_HEAP, mtClass) PrefetchedClassTable());
+
+  int thread_count = (int)MIN2(PrefetchClassThreads, (uintx)_name_count);
+  int started = 0;
+  for (int i = 0; i < thread_count; i++) {
+    char name[64];
+    jio_snprintf(name, sizeof(name), "Class Prefetch Thread#%d", i);
+    Handle string = java_lang_String::create_from_str(name, CHECK);
+
+    // Initialize thread_oop to put it into the system threadGroup
+    Handle thread_group(THREAD, Universe::system_thread_group());
+    Handle thread_oop = JavaCalls::construct_new_instance(
+                            SystemDictionary::Thread_klass(),
+                            vmSymbols::threadgroup_string_void_signature(),
+                            thread_group,
+                            string,
+                            CHECK);
+
+    MutexLocker mu(Threads_lock);
+    ClassPrefetchThread* thread = new ClassPrefetchThread();
+    if (thread == NULL || thread->osthread() == NULL) {
+      // Not fatal, the classes are read when they are loaded.
+      if (thread != NULL) {
+        thread->smr_delete();
+      }
+      log_warning(class, load)("Prefetch: could not create %s", name);
+      break;
+    }
+
+    java_lang_Thread::set_thread(thread_oop(), thread);
+    java_lang_Thread::set_priority(thread_oop(), NormPriority);
+    java_lang_Thread::set_daemon(thread_oop());
+    thread->set_threadObj(thread_oop());
+
+    Threads::add(thread);
+    Thread::start(thread);
+    started++;
+  }
+  log_info(class, load)("Prefetch: reading %d classes from %s on %d threads",
+                        _name_count, PrefetchClassList, started);
+}
+
+ClassFileStream* ClassPrefetcher::take(Symbol* name, bool search_append_only, s2* classpath_index) {
+  PrefetchedClassTable* table = OrderAccess::load_acquire(&_table);
+  if (table == NULL) {
+    return NULL;
+  }
+
+  PrefetchedClass* pc;
+  {
+    MutexLocker ml(_table_lock, Mutex::_no_safepoint_check_flag);
+    PrefetchedClass** entry = table->get(name);
+    if (entry == NULL || (*entry)->_search_append_only != search_append_only) {
+      return NULL;
+    }
+    pc = *entry;
+    table->remove(name);
+  }
+  // Drop the reference the table held.
+  name->decrement_refcount();
+
+  u1* buffer = NEW_RESOURCE_ARRAY(u1, pc->_length);
+  memcpy(buffer, pc->_buffer, pc->_length);
+  const char* source = NULL;
+  if (pc->_source != NULL) {
+    char* copy = NEW_RESOURCE_ARRAY(char, strlen(pc->_source) + 1);
+    strcpy(copy, pc->_source);
+    source = copy;
+  }
+  ClassFileStream* stream = new ClassFileStream(buffer, pc->_length, source,
+                                                ClassFileStream::verify,
+                                                pc->_from_boot_loader_modules_image);
+  *classpath_index = pc->_classpath_index;
+  delete pc;
+
+  int taken = Atomic::add(1, &_taken_count);
+  log_trace(class, load)("Prefetch: took %s, %d used so far", name->as_C_string(), taken);
+  return stream;
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_CLASSFILE_CLASSPREFETCHER_HPP
+#define SHARE_CLASSFILE_CLASSPREFETCHER_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/exceptions.hpp"
+
+class ClassFileStream;
+class Symbol;
+
+// Reads the class files of the boot classes named in PrefetchClassList on
+// PrefetchClassThreads background threads, so that the jimage and jar
+// lookups, the reads and the inflation of those classes overlap with the
+// rest of startup instead of being done one class at a time on the thread
+// that needs the class.
+//
+// Only the bytes are read ahead. Parsing, verification and linking still
+// happen on the loading thread, in the usual order, as they create
+// metadata and may load and initialize other classes.
+//
+// ClassLoader::load_class() takes the bytes of a class, if they have been
+// read, instead of searching the boot class path again. Each class file is
+// used at most once; a class that is never loaded keeps its bytes until
+// the VM exits.
+class ClassPrefetcher : AllStatic {
+ public:
+  // Starts the threads if PrefetchClassList is set. Must be called after
+  // the module system is initialized.
+  static void initialize(TRAPS);
+
+  // Returns a resource allocated stream for the class file of name, and
+  // sets classpath_index to where it was found on the boot class path.
+  // Returns NULL if the class file has not been read, or was read from a
+  // different part of the boot class path than search_append_only selects.
+  static ClassFileStream* take(Symbol* name, bool search_append_only, s2* classpath_index);
+};
+
+#endif // SHARE_CLASSFILE_CLASSPREFETCHER_HPP
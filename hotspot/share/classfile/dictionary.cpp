@@ -36,121 +36,128 @@
 #include "runtime/atomic.hpp"
 #include "runtime/orderAccess.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/safepoint.hpp"
 #include "runtime/safepointVerifiers.hpp"
+#include "utilities/concurrentHashTable.inline.hpp"
+#include "utilities/growableArray.hpp"
 #include "utilities/hashtable.inline.hpp"
 
-// Optimization: if any dictionary needs resizing, we set this flag,
-// so that we dont't have to walk all dictionaries to check if any actually
-// needs resizing, which is costly to do at Safepoint.
-bool Dictionary::_some_dictionary_needs_resizing = false;
-
-Dictionary::Dictionary(ClassLoaderData* loader_data, int table_size, bool resizable)
-  : Hashtable<InstanceKlass*, mtClass>(table_size, (int)sizeof(DictionaryEntry)),
-    _resizable(resizable), _needs_resizing(false), _loader_data(loader_data) {
+class DictionaryConfig : public DictionaryTable::BaseConfig {
+ public:
+  static uintx get_hash(DictionaryEntry* const& value, bool* is_dead) {
+    *is_dead = false;
+    return value->instance_klass()->name()->identity_hash();
+  }
+  static void free_node(void* memory, DictionaryEntry* const& value) {
+    delete value;
+    DictionaryTable::BaseConfig::free_node(memory, value);
+  }
 };
 
-
-Dictionary::Dictionary(ClassLoaderData* loader_data,
-                       int table_size, HashtableBucket<mtClass>* t,
-                       int number_of_entries, bool resizable)
-  : Hashtable<InstanceKlass*, mtClass>(table_size, (int)sizeof(DictionaryEntry), t, number_of_entries),
-    _resizable(resizable), _needs_resizing(false), _loader_data(loader_data) {
+class DictionaryLookup : StackObj {
+ private:
+  Symbol* _name;
+  uintx _hash;
+ public:
+  DictionaryLookup(Symbol* name, unsigned int hash) : _name(name), _hash(hash) {}
+  uintx get_hash() const {
+    return _hash;
+  }
+  bool equals(DictionaryEntry** value, bool* is_dead) {
+    *is_dead = false;
+    return (*value)->equals(_name);
+  }
 };
 
-Dictionary::~Dictionary() {
-  DictionaryEntry* probe = NULL;
-  for (int index = 0; index < table_size(); index++) {
-    for (DictionaryEntry** p = bucket_addr(index); *p != NULL; ) {
-      probe = *p;
-      *p = probe->next();
-      free_entry(probe);
-    }
+class DictionaryGet : StackObj {
+ private:
+  DictionaryEntry* _entry;
+ public:
+  DictionaryGet() : _entry(NULL) {}
+  void operator()(DictionaryEntry** value) {
+    _entry = *value;
   }
-  assert(number_of_entries() == 0, "should have removed all entries");
-  assert(new_entry_free_list() == NULL, "entry present on Dictionary's free list");
-}
+  DictionaryEntry* entry() const {
+    return _entry;
+  }
+};
+
+const int _resize_load_trigger = 5;       // load factor that will trigger the resize
+const size_t _max_table_size_log2 = 21;   // the max dictionary size allowed
+const size_t _grow_hint = 4;              // chain length, lookups don't ask for it
 
-DictionaryEntry* Dictionary::new_entry(unsigned int hash, InstanceKlass* klass) {
-  DictionaryEntry* entry = (DictionaryEntry*)Hashtable<InstanceKlass*, mtClass>::allocate_new_entry(hash, klass);
-  entry->set_pd_set(NULL);
-  assert(klass->is_instance_klass(), "Must be");
-  return entry;
+static size_t ceil_log2(size_t value) {
+  size_t ret;
+  for (ret = 1; ((size_t)1 << ret) < value; ++ret);
+  return ret;
 }
 
+Dictionary::Dictionary(ClassLoaderData* loader_data, int table_size, bool resizable)
+  : _number_of_entries(0), _resizable(resizable), _loader_data(loader_data) {
+  size_t start_size_log2 = MIN2(ceil_log2((size_t)table_size), _max_table_size_log2);
+  // The resize lock is taken by walks and growth of the table, which
+  // happen with the SystemDictionary_lock held.
+  _table = new DictionaryTable(start_size_log2, _max_table_size_log2, _grow_hint, Mutex::leaf - 1);
+};
+
+Dictionary::~Dictionary() {
+  // Frees the entries, and with them their protection domain sets. This
+  // doesn't require a lock because nothing is reading the dictionary
+  // anymore. The ClassLoader is dead.
+  delete _table;
+}
 
-void Dictionary::free_entry(DictionaryEntry* entry) {
+DictionaryEntry::~DictionaryEntry() {
   // avoid recursion when deleting linked list
   // pd_set is accessed during a safepoint.
-  // This doesn't require a lock because nothing is reading this
-  // entry anymore.  The ClassLoader is dead.
-  while (entry->pd_set() != NULL) {
-    ProtectionDomainEntry* to_delete = entry->pd_set();
-    entry->set_pd_set(to_delete->next());
+  while (pd_set() != NULL) {
+    ProtectionDomainEntry* to_delete = pd_set();
+    set_pd_set(to_delete->next());
     delete to_delete;
   }
-  // Unlink from the Hashtable prior to freeing
-  unlink_entry(entry);
-  FREE_C_HEAP_ARRAY(char, entry);
-}
-
-const int _resize_load_trigger = 5;       // load factor that will trigger the resize
-const double _resize_factor    = 2.0;     // by how much we will resize using current number of entries
-const int _resize_max_size     = 40423;   // the max dictionary size allowed
-const int _primelist[] = {107, 1009, 2017, 4049, 5051, 10103, 20201, _resize_max_size};
-const int _prime_array_size = sizeof(_primelist)/sizeof(int);
-
-// Calculate next "good" dictionary size based on requested count
-static int calculate_dictionary_size(int requested) {
-  int newsize = _primelist[0];
-  int index = 0;
-  for (newsize = _primelist[index]; index < (_prime_array_size - 1);
-       newsize = _primelist[++index]) {
-    if (requested <= newsize) {
-      break;
-    }
-  }
-  return newsize;
 }
 
-bool Dictionary::does_any_dictionary_needs_resizing() {
-  return Dictionary::_some_dictionary_needs_resizing;
+int Dictionary::table_size() const {
+  return 1 << _table->get_size_log2(Thread::current());
 }
 
 void Dictionary::check_if_needs_resize() {
-  if (_resizable == true) {
-    if (number_of_entries() > (_resize_load_trigger*table_size())) {
-      _needs_resizing = true;
-      Dictionary::_some_dictionary_needs_resizing = true;
+  if (_resizable && !_table->is_max_size_reached() &&
+      _number_of_entries > (_resize_load_trigger * table_size())) {
+    // Lookups go on concurrently; other class definitions into this
+    // dictionary wait for the SystemDictionary_lock.
+    if (!_table->grow(Thread::current())) {
+      log_debug(class, loader, data)("Could not grow the dictionary of %s", loader_data()->loader_name_and_id());
     }
   }
 }
 
-bool Dictionary::resize_if_needed() {
-  int desired_size = 0;
-  if (_needs_resizing == true) {
-    desired_size = calculate_dictionary_size((int)(_resize_factor*number_of_entries()));
-    if (desired_size >= _resize_max_size) {
-      desired_size = _resize_max_size;
-      // We have reached the limit, turn resizing off
-      _resizable = false;
-    }
-    if ((desired_size != 0) && (desired_size != table_size())) {
-      if (!resize(desired_size)) {
-        // Something went wrong, turn resizing off
-        _resizable = false;
-      }
-    }
+class DictionaryCollectEntries : StackObj {
+ private:
+  GrowableArray<DictionaryEntry*>* _entries;
+ public:
+  DictionaryCollectEntries(GrowableArray<DictionaryEntry*>* entries) : _entries(entries) {}
+  bool operator()(DictionaryEntry** value) {
+    _entries->append(*value);
+    return true;
   }
+};
 
-  _needs_resizing = false;
-  Dictionary::_some_dictionary_needs_resizing = false;
-
-  return (desired_size != 0);
+// Entries stay valid until the dictionary is deleted, so they are visited
+// after the walk of the table. The callers can then take locks, and
+// safepoint, without holding the resize lock of the table.
+void Dictionary::collect_entries(GrowableArray<DictionaryEntry*>* entries) {
+  DictionaryCollectEntries collect(entries);
+  if (SafepointSynchronize::is_at_safepoint()) {
+    _table->do_safepoint_scan(collect);
+  } else {
+    _table->do_scan(Thread::current(), collect);
+  }
 }
 
 bool DictionaryEntry::contains_protection_domain(oop protection_domain) const {
-  // Lock the pd_set list.  This lock cannot safepoint since the caller holds
-  // a Dictionary entry, which can be moved if the Dictionary is resized.
+  // Lock the pd_set list.  This lock cannot safepoint since the caller may
+  // be in the middle of a lookup that must not safepoint.
   MutexLocker ml(ProtectionDomainSet_lock, Mutex::_no_safepoint_check_flag);
 #ifdef ASSERT
   if (oopDesc::equals(protection_domain, instance_klass()->protection_domain())) {
@@ -205,14 +212,13 @@ void DictionaryEntry::add_protection_domain(Dictionary* dict, Handle protection_
 
 //   Just the classes from defining class loaders
 void Dictionary::classes_do(void f(InstanceKlass*)) {
-  for (int index = 0; index < table_size(); index++) {
-    for (DictionaryEntry* probe = bucket(index);
-                          probe != NULL;
-                          probe = probe->next()) {
-      InstanceKlass* k = probe->instance_klass();
-      if (loader_data() == k->class_loader_data()) {
-        f(k);
-      }
+  ResourceMark rm;
+  GrowableArray<DictionaryEntry*> entries(number_of_entries());
+  collect_entries(&entries);
+  for (int i = 0; i < entries.length(); i++) {
+    InstanceKlass* k = entries.at(i)->instance_klass();
+    if (loader_data() == k->class_loader_data()) {
+      f(k);
     }
   }
 }
@@ -220,82 +226,76 @@ void Dictionary::classes_do(void f(InstanceKlass*)) {
 // Added for initialize_itable_for_klass to handle exceptions
 //   Just the classes from defining class loaders
 void Dictionary::classes_do(void f(InstanceKlass*, TRAPS), TRAPS) {
-  for (int index = 0; index < table_size(); index++) {
-    for (DictionaryEntry* probe = bucket(index);
-                          probe != NULL;
-                          probe = probe->next()) {
-      InstanceKlass* k = probe->instance_klass();
-      if (loader_data() == k->class_loader_data()) {
-        f(k, CHECK);
-      }
+  ResourceMark rm(THREAD);
+  GrowableArray<DictionaryEntry*> entries(number_of_entries());
+  collect_entries(&entries);
+  for (int i = 0; i < entries.length(); i++) {
+    InstanceKlass* k = entries.at(i)->instance_klass();
+    if (loader_data() == k->class_loader_data()) {
+      f(k, CHECK);
     }
   }
 }
 
 // All classes, and their class loaders, including initiating class loaders
 void Dictionary::all_entries_do(KlassClosure* closure) {
-  for (int index = 0; index < table_size(); index++) {
-    for (DictionaryEntry* probe = bucket(index);
-                          probe != NULL;
-                          probe = probe->next()) {
-      InstanceKlass* k = probe->instance_klass();
-      closure->do_klass(k);
-    }
+  ResourceMark rm;
+  GrowableArray<DictionaryEntry*> entries(number_of_entries());
+  collect_entries(&entries);
+  for (int i = 0; i < entries.length(); i++) {
+    closure->do_klass(entries.at(i)->instance_klass());
   }
 }
 
 // Used to scan and relocate the classes during CDS archive dump.
 void Dictionary::classes_do(MetaspaceClosure* it) {
   assert(DumpSharedSpaces || DynamicDumpSharedSpaces, "dump-time only");
-  for (int index = 0; index < table_size(); index++) {
-    for (DictionaryEntry* probe = bucket(index);
-                          probe != NULL;
-                          probe = probe->next()) {
-      it->push(probe->klass_addr());
-    }
+  ResourceMark rm;
+  GrowableArray<DictionaryEntry*> entries(number_of_entries());
+  collect_entries(&entries);
+  for (int i = 0; i < entries.length(); i++) {
+    it->push(entries.at(i)->klass_addr());
   }
 }
 
 
 
 // Add a loaded class to the dictionary.
-// Readers of the SystemDictionary aren't always locked, so _buckets
-// is volatile. The store of the next field in the constructor is
-// also cast to volatile;  we do this to ensure store order is maintained
-// by the compilers.
+// Readers of the SystemDictionary aren't locked, the table publishes
+// the new entry to them.
 
 void Dictionary::add_klass(unsigned int hash, Symbol* class_name,
                            InstanceKlass* obj) {
   assert_locked_or_safepoint(SystemDictionary_lock);
   assert(obj != NULL, "adding NULL obj");
   assert(obj->name() == class_name, "sanity check on name");
-
-  DictionaryEntry* entry = new_entry(hash, obj);
-  int index = hash_to_index(hash);
-  add_entry(index, entry);
+  assert(obj->is_instance_klass(), "Must be");
+
+  DictionaryEntry* entry = new DictionaryEntry(obj);
+  DictionaryLookup lookup(class_name, hash);
+  bool inserted = _table->insert(Thread::current(), lookup, entry);
+  assert(inserted, "caller must have checked for an existing entry");
+  if (!inserted) {
+    delete entry;
+    return;
+  }
+  _number_of_entries++;
   check_if_needs_resize();
 }
 
 
 // This routine does not lock the dictionary.
 //
-// Since readers don't hold a lock, we must make sure that system
-// dictionary entries are only removed at a safepoint (when only one
-// thread is running), and are added to in a safe way (all links must
-// be updated in an MT-safe manner).
+// Entries are only removed when the whole dictionary is deleted, and the
+// table publishes added entries in an MT-safe manner.
 //
 // Callers should be aware that an entry could be added just after
-// _buckets[index] is read here, so the caller will not see the new entry.
-DictionaryEntry* Dictionary::get_entry(int index, unsigned int hash,
-                                       Symbol* class_name) {
-  for (DictionaryEntry* entry = bucket(index);
-                        entry != NULL;
-                        entry = entry->next()) {
-    if (entry->hash() == hash && entry->equals(class_name)) {
-      return entry;
-    }
-  }
-  return NULL;
+// the lookup here, so the caller will not see the new entry.
+DictionaryEntry* Dictionary::get_entry(unsigned int hash, Symbol* class_name) {
+  DictionaryLookup lookup(class_name, hash);
+  DictionaryGet get;
+  _table->get(Thread::current(), lookup, get);
+  return get.entry();
 }
 
 
@@ -303,8 +303,7 @@ InstanceKlass* Dictionary::find(unsigned int hash, Symbol* name,
                                 Handle protection_domain) {
   NoSafepointVerifier nsv;
 
-  int index = hash_to_index(hash);
-  DictionaryEntry* entry = get_entry(index, hash, name);
+  DictionaryEntry* entry = get_entry(hash, name);
   if (entry != NULL && entry->is_valid_protection_domain(protection_domain)) {
     return entry->instance_klass();
   } else {
@@ -312,22 +311,21 @@ InstanceKlass* Dictionary::find(unsigned int hash, Symbol* name,
   }
 }
 
-InstanceKlass* Dictionary::find_class(int index, unsigned int hash,
-                                      Symbol* name) {
+InstanceKlass* Dictionary::find_class(unsigned int hash, Symbol* name) {
   assert_locked_or_safepoint(SystemDictionary_lock);
-  assert (index == index_for(name), "incorrect index?");
+  assert (hash == compute_hash(name), "incorrect hash?");
 
-  DictionaryEntry* entry = get_entry(index, hash, name);
+  DictionaryEntry* entry = get_entry(hash, name);
   return (entry != NULL) ? entry->instance_klass() : NULL;
 }
 
 
-void Dictionary::add_protection_domain(int index, unsigned int hash,
+void Dictionary::add_protection_domain(unsigned int hash,
                                        InstanceKlass* klass,
                                        Handle protection_domain,
                                        TRAPS) {
   Symbol*  klass_name = klass->name();
-  DictionaryEntry* entry = get_entry(index, hash, klass_name);
+  DictionaryEntry* entry = get_entry(hash, klass_name);
 
   assert(entry != NULL,"entry must be present, we just created it");
   assert(protection_domain() != NULL,
@@ -347,8 +345,7 @@ void Dictionary::add_protection_domain(int index, unsigned int hash,
 bool Dictionary::is_valid_protection_domain(unsigned int hash,
                                             Symbol* name,
                                             Handle protection_domain) {
-  int index = hash_to_index(hash);
-  DictionaryEntry* entry = get_entry(index, hash, name);
+  DictionaryEntry* entry = get_entry(hash, name);
   return entry->is_valid_protection_domain(protection_domain);
 }
 
@@ -362,40 +359,39 @@ void Dictionary::clean_cached_protection_domains() {
     return;
   }
 
-  for (int index = 0; index < table_size(); index++) {
-    for (DictionaryEntry* probe = bucket(index);
-                          probe != NULL;
-                          probe = probe->next()) {
-      Klass* e = probe->instance_klass();
-
-      MutexLocker ml(ProtectionDomainSet_lock, Mutex::_no_safepoint_check_flag);
-      ProtectionDomainEntry* current = probe->pd_set();
-      ProtectionDomainEntry* prev = NULL;
-      while (current != NULL) {
-        if (current->object_no_keepalive() == NULL) {
-          LogTarget(Debug, protectiondomain) lt;
-          if (lt.is_enabled()) {
-            ResourceMark rm;
-            // Print out trace information
-            LogStream ls(lt);
-            ls.print_cr("PD in set is not alive:");
-            ls.print("class loader: "); loader_data()->class_loader()->print_value_on(&ls);
-            ls.print(" loading: "); probe->instance_klass()->print_value_on(&ls);
-            ls.cr();
-          }
-          if (probe->pd_set() == current) {
-            probe->set_pd_set(current->next());
-          } else {
-            assert(prev != NULL, "should be set by alive entry");
-            prev->set_next(current->next());
-          }
-          ProtectionDomainEntry* to_delete = current;
-          current = current->next();
-          delete to_delete;
+  ResourceMark rm;
+  GrowableArray<DictionaryEntry*> entries(number_of_entries());
+  collect_entries(&entries);
+  for (int i = 0; i < entries.length(); i++) {
+    DictionaryEntry* probe = entries.at(i);
+
+    MutexLocker ml(ProtectionDomainSet_lock, Mutex::_no_safepoint_check_flag);
+    ProtectionDomainEntry* current = probe->pd_set();
+    ProtectionDomainEntry* prev = NULL;
+    while (current != NULL) {
+      if (current->object_no_keepalive() == NULL) {
+        LogTarget(Debug, protectiondomain) lt;
+        if (lt.is_enabled()) {
+          ResourceMark rm;
+          // Print out trace information
+          LogStream ls(lt);
+          ls.print_cr("PD in set is not alive:");
+          ls.print("class loader: "); loader_data()->class_loader()->print_value_on(&ls);
+          ls.print(" loading: "); probe->instance_klass()->print_value_on(&ls);
+          ls.cr();
+        }
+        if (probe->pd_set() == current) {
+          probe->set_pd_set(current->next());
         } else {
-          prev = current;
-          current = current->next();
+          assert(prev != NULL, "should be set by alive entry");
+          prev->set_next(current->next());
         }
+        ProtectionDomainEntry* to_delete = current;
+        current = current->next();
+        delete to_delete;
+      } else {
+        prev = current;
+        current = current->next();
       }
     }
   }
@@ -480,7 +476,7 @@ void DictionaryEntry::print_count(outputStream *st) {
 
 // ----------------------------------------------------------------------------
 
-void Dictionary::print_on(outputStream* st) const {
+void Dictionary::print_on(outputStream* st) {
   ResourceMark rm;
 
   assert(loader_data() != NULL, "loader data should not be null");
@@ -488,27 +484,37 @@ void Dictionary::print_on(outputStream* st) const {
                table_size(), number_of_entries(), BOOL_TO_STR(_resizable));
   st->print_cr("^ indicates that initiating loader is different from defining loader");
 
-  for (int index = 0; index < table_size(); index++) {
-    for (DictionaryEntry* probe = bucket(index);
-                          probe != NULL;
-                          probe = probe->next()) {
-      Klass* e = probe->instance_klass();
-      bool is_defining_class =
-         (loader_data() == e->class_loader_data());
-      st->print("%4d: %s%s", index, is_defining_class ? " " : "^", e->external_name());
-      ClassLoaderData* cld = e->class_loader_data();
-      if (!loader_data()->is_the_null_class_loader_data()) {
-        // Class loader output for the dictionary for the null class loader data is
-        // redundant and obvious.
-        st->print(", ");
-        cld->print_value_on(st);
-      }
-      st->cr();
+  GrowableArray<DictionaryEntry*> entries(number_of_entries());
+  collect_entries(&entries);
+  for (int i = 0; i < entries.length(); i++) {
+    Klass* e = entries.at(i)->instance_klass();
+    bool is_defining_class =
+       (loader_data() == e->class_loader_data());
+    st->print("%4d: %s%s", i, is_defining_class ? " " : "^", e->external_name());
+    ClassLoaderData* cld = e->class_loader_data();
+    if (!loader_data()->is_the_null_class_loader_data()) {
+      // Class loader output for the dictionary for the null class loader data is
+      // redundant and obvious.
+      st->print(", ");
+      cld->print_value_on(st);
     }
+    st->cr();
   }
   tty->cr();
 }
 
+class DictionaryEntrySize : StackObj {
+ public:
+  size_t operator()(DictionaryEntry** value) {
+    return sizeof(DictionaryEntry);
+  }
+};
+
+void Dictionary::print_table_statistics(outputStream* st, const char* table_name) {
+  DictionaryEntrySize size;
+  _table->statistics_to(Thread::current(), size, st, table_name);
+}
+
 void DictionaryEntry::verify() {
   Klass* e = instance_klass();
   guarantee(e->is_instance_klass(),
@@ -529,7 +535,12 @@ void Dictionary::verify() {
             "checking type of class_loader");
 
   ResourceMark rm;
-  stringStream tempst;
-  tempst.print("System Dictionary for %s class loader", cld->loader_name_and_id());
-  verify_table<DictionaryEntry>(tempst.as_string());
+  GrowableArray<DictionaryEntry*> entries(number_of_entries());
+  collect_entries(&entries);
+  for (int i = 0; i < entries.length(); i++) {
+    entries.at(i)->verify();
+  }
+  guarantee(entries.length() == number_of_entries(),
+            "Verify of System Dictionary for %s class loader failed: %d entries, expected %d",
+            cld->loader_name_and_id(), entries.length(), number_of_entries());
 }
@@ -29,39 +29,53 @@
 #include "classfile/systemDictionary.hpp"
 #include "oops/instanceKlass.hpp"
 #include "oops/oop.hpp"
+#include "utilities/concurrentHashTable.hpp"
 #include "utilities/hashtable.hpp"
 #include "utilities/ostream.hpp"
 
 class DictionaryEntry;
+class DictionaryConfig;
 class BoolObjectClosure;
+template<class E> class GrowableArray;
+
+typedef ConcurrentHashTable<DictionaryEntry*, DictionaryConfig, mtClass> DictionaryTable;
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // The data structure for the class loader data dictionaries.
+//
+// Lookups are lock-free. Entries are added under the SystemDictionary_lock
+// and only removed when the dictionary is deleted with its class loader,
+// so they stay valid while the dictionary is reachable. The table grows
+// concurrently with lookups when it gets too full.
 
-class Dictionary : public Hashtable<InstanceKlass*, mtClass> {
+class Dictionary : public CHeapObj<mtClass> {
   friend class VMStructs;
 
-  static bool _some_dictionary_needs_resizing;
+  DictionaryTable* _table;
+  int _number_of_entries;
   bool _resizable;
-  bool _needs_resizing;
   void check_if_needs_resize();
 
   ClassLoaderData* _loader_data;  // backpointer to owning loader
   ClassLoaderData* loader_data() const { return _loader_data; }
 
-  DictionaryEntry* get_entry(int index, unsigned int hash, Symbol* name);
+  DictionaryEntry* get_entry(unsigned int hash, Symbol* name);
+  void collect_entries(GrowableArray<DictionaryEntry*>* entries);
 
 public:
   Dictionary(ClassLoaderData* loader_data, int table_size, bool resizable = false);
-  Dictionary(ClassLoaderData* loader_data, int table_size, HashtableBucket<mtClass>* t, int number_of_entries, bool resizable = false);
   ~Dictionary();
 
-  static bool does_any_dictionary_needs_resizing();
-  bool resize_if_needed();
+  unsigned int compute_hash(const Symbol* name) const {
+    return (unsigned int) name->identity_hash();
+  }
+
+  int table_size() const;
+  int number_of_entries() const { return _number_of_entries; }
 
   void add_klass(unsigned int hash, Symbol* class_name, InstanceKlass* obj);
 
-  InstanceKlass* find_class(int index, unsigned int hash, Symbol* name);
+  InstanceKlass* find_class(unsigned int hash, Symbol* name);
 
   void classes_do(void f(InstanceKlass*));
   void classes_do(void f(InstanceKlass*, TRAPS), TRAPS);
@@ -75,42 +89,23 @@ public:
   bool is_valid_protection_domain(unsigned int hash,
                                   Symbol* name,
                                   Handle protection_domain);
-  void add_protection_domain(int index, unsigned int hash,
+  void add_protection_domain(unsigned int hash,
                              InstanceKlass* klass,
                              Handle protection_domain, TRAPS);
 
-  void print_on(outputStream* st) const;
+  void print_on(outputStream* st);
+  void print_table_statistics(outputStream* st, const char* table_name);
   void verify();
-
- private:
-  DictionaryEntry* new_entry(unsigned int hash, InstanceKlass* klass);
-
-  DictionaryEntry* bucket(int i) const {
-    return (DictionaryEntry*)Hashtable<InstanceKlass*, mtClass>::bucket(i);
-  }
-
-  // The following method is not MT-safe and must be done under lock.
-  DictionaryEntry** bucket_addr(int i) {
-    return (DictionaryEntry**)Hashtable<InstanceKlass*, mtClass>::bucket_addr(i);
-  }
-
-  void add_entry(int index, DictionaryEntry* new_entry) {
-    Hashtable<InstanceKlass*, mtClass>::add_entry(index, (HashtableEntry<InstanceKlass*, mtClass>*)new_entry);
-  }
-
-  void unlink_entry(DictionaryEntry* entry) {
-    Hashtable<InstanceKlass*, mtClass>::unlink_entry((HashtableEntry<InstanceKlass*, mtClass>*)entry);
-  }
-
-  void free_entry(DictionaryEntry* entry);
 };
 
 // An entry in the class loader data dictionaries, this describes a class as
 // { InstanceKlass*, protection_domain }.
 
-class DictionaryEntry : public HashtableEntry<InstanceKlass*, mtClass> {
+class DictionaryEntry : public CHeapObj<mtClass> {
   friend class VMStructs;
  private:
+  InstanceKlass* _instance_klass;
+
   // Contains the set of approved protection domains that can access
   // this dictionary entry.
   //
@@ -134,21 +129,16 @@ class DictionaryEntry : public HashtableEntry<InstanceKlass*, mtClass> {
   ProtectionDomainEntry* volatile _pd_set;
 
  public:
+  DictionaryEntry(InstanceKlass* klass) : _instance_klass(klass), _pd_set(NULL) {}
+  ~DictionaryEntry();
+
   // Tells whether a protection is in the approved set.
   bool contains_protection_domain(oop protection_domain) const;
   // Adds a protection domain to the approved set.
   void add_protection_domain(Dictionary* dict, Handle protection_domain);
 
-  InstanceKlass* instance_klass() const { return literal(); }
-  InstanceKlass** klass_addr() { return (InstanceKlass**)literal_addr(); }
-
-  DictionaryEntry* next() const {
-    return (DictionaryEntry*)HashtableEntry<InstanceKlass*, mtClass>::next();
-  }
-
-  DictionaryEntry** next_addr() {
-    return (DictionaryEntry**)HashtableEntry<InstanceKlass*, mtClass>::next_addr();
-  }
+  InstanceKlass* instance_klass() const { return _instance_klass; }
+  InstanceKlass** klass_addr() { return &_instance_klass; }
 
   ProtectionDomainEntry* pd_set() const            { return _pd_set; }
   void set_pd_set(ProtectionDomainEntry* new_head) {  _pd_set = new_head; }
@@ -166,8 +156,7 @@ class DictionaryEntry : public HashtableEntry<InstanceKlass*, mtClass> {
   void verify_protection_domain_set();
 
   bool equals(const Symbol* class_name) const {
-    InstanceKlass* klass = (InstanceKlass*)literal();
-    return (klass->name() == class_name);
+    return (_instance_klass->name() == class_name);
   }
 
   void print_count(outputStream *st);
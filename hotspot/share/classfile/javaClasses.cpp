@@ -2668,6 +2668,17 @@ void java_lang_StackFrameInfo::set_method_and_bci(Handle stackFrame, const metho
   java_lang_StackFrameInfo::set_version(stackFrame(), (short)version);
 }
 
+void java_lang_StackFrameInfo::set_method_and_bci_from(Handle stackFrame, Handle filled_frame, int bci) {
+  oop mname = stackFrame->obj_field(_memberName_offset);
+  oop filled_mname = filled_frame->obj_field(_memberName_offset);
+  java_lang_invoke_MemberName::set_flags  (mname, java_lang_invoke_MemberName::flags(filled_mname));
+  java_lang_invoke_MemberName::set_method (mname, filled_mname->obj_field(java_lang_invoke_MemberName::method_offset_in_bytes()));
+  java_lang_invoke_MemberName::set_vmindex(mname, java_lang_invoke_MemberName::vmindex(filled_mname));
+  java_lang_invoke_MemberName::set_clazz  (mname, java_lang_invoke_MemberName::clazz(filled_mname));
+  java_lang_StackFrameInfo::set_bci(stackFrame(), bci);
+  java_lang_StackFrameInfo::set_version(stackFrame(), filled_frame->short_field(_version_offset));
+}
+
 void java_lang_StackFrameInfo::to_stack_trace_element(Handle stackFrame, Handle stack_trace_element, TRAPS) {
   ResourceMark rm(THREAD);
   HandleMark hm(THREAD);
@@ -1410,10 +1410,15 @@ private:
 public:
   // Setters
   static void set_method_and_bci(Handle stackFrame, const methodHandle& method, int bci, TRAPS);
+  // Same as set_method_and_bci, for a method that filled_frame was already
+  // filled in with. Shares its resolved method instead of looking it up again.
+  static void set_method_and_bci_from(Handle stackFrame, Handle filled_frame, int bci);
   static void set_bci(oop info, int value);
 
   static void set_version(oop info, short value);
 
+  static int memberName_offset_in_bytes() { return _memberName_offset; }
+
   static void compute_offsets();
   static void serialize_offsets(SerializeClosure* f) NOT_CDS_RETURN;
 
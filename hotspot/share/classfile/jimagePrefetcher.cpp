@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#include "precompiled.hpp"
+#include "classfile/classLoader.hpp"
+#include "classfile/jimagePrefetcher.hpp"
+#include "classfile/symbolTable.hpp"
+#include "logging/log.hpp"
+#include "memory/resourceArea.hpp"
+#include "runtime/arguments.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.hpp"
+#if INCLUDE_CDS
+#include "classfile/systemDictionaryShared.hpp"
+#endif
+
+void jimagePrefetcher_init() {
+  JImagePrefetcher::initialize();
+}
+
+class JImagePrefetchThread : public NamedThread {
+ private:
+  JImageFile* _jimage;
+  char _class_list[JVM_MAXPATHLEN];
+  int _prefetched;
+
+  // The archived version of a boot class is used instead of the image.
+  static bool is_boot_shared_class(const char* class_name) {
+#if INCLUDE_CDS
+    if (UseSharedSpaces) {
+      // Names of archived classes are in the shared symbol table.
+      TempNewSymbol name = SymbolTable::probe(class_name, (int)strlen(class_name));
+      if (name != NULL) {
+        InstanceKlass* ik = SystemDictionaryShared::find_builtin_class(name);
+        return ik != NULL && ik->is_shared_boot_class();
+      }
+    }
+#endif
+    return false;
+  }
+
+  void prefetch_class(const char* class_name) {
+    if (is_boot_shared_class(class_name)) {
+      return;
+    }
+    ResourceMark rm(this);
+    const char* package_name = ClassLoader::package_from_name(class_name);
+    if (package_name == NULL) {
+      return;
+    }
+    const char* module_name = ClassLoader::jimage_package_to_module(_jimage, package_name);
+    if (module_name == NULL) {
+      return; // not in the image
+    }
+    const char* file_name = ClassLoader::file_name_for_class_name(class_name, (int)strlen(class_name));
+    jlong size;
+    JImageLocationRef location = ClassLoader::jimage_find_resource(_jimage, module_name, file_name, size);
+    if (location != 0) {
+      ClassLoader::jimage_prefetch_resource(_jimage, location);
+      _prefetched++;
+    }
+  }
+
+ public:
+  JImagePrefetchThread(JImageFile* jimage, const char* class_list) : _jimage(jimage), _prefetched(0) {
+    set_name("JImage Prefetch Thread");
+    strncpy(_class_list, class_list, sizeof(_class_list) - 1);
+    _class_list[sizeof(_class_list) - 1] = '\0';
+  }
+
+  void run() {
+    FILE* file = fopen(_class_list, "r");
+    if (file == NULL) {
+      log_info(class, load)("JImage prefetch: could not open class list %s", _class_list);
+      return;
+    }
+    char line[1024];
+    while (fgets(line, sizeof(line), file) != NULL) {
+      // Same format as SharedClassListFile: the class name comes first,
+      // comments and other directives are skipped.
+      if (line[0] == '#' || line[0] == '@') {
+        continue;
+      }
+      char name[1024];
+      if (sscanf(line, "%1023s", name) == 1) {
+        prefetch_class(name);
+      }
+    }
+    fclose(file);
+    log_info(class, load)("JImage prefetch: %d classes of %s decompressed", _prefetched, _class_list);
+  }
+};
+
+void JImagePrefetcher::initialize() {
+  if (!PrefetchJImageResources || DumpSharedSpaces || DynamicDumpSharedSpaces) {
+    return;
+  }
+  if (JImageResourceCacheSize == 0) {
+    log_warning(class, load)("PrefetchJImageResources is ignored without JImageResourceCacheSize");
+    return;
+  }
+  ClassPathEntry* jrt_entry = ClassLoader::get_jrt_entry();
+  if (jrt_entry == NULL || jrt_entry->jimage() == NULL) {
+    return; // exploded build
+  }
+
+  char class_list[JVM_MAXPATHLEN];
+  if (SharedClassListFile != NULL) {
+    jio_snprintf(class_list, sizeof(class_list), "%s", SharedClassListFile);
+  } else {
+    jio_snprintf(class_list, sizeof(class_list), "%s%slib%sclasslist",
+                 Arguments::get_java_home(), os::file_separator(), os::file_separator());
+  }
+
+  JImagePrefetchThread* thread = new JImagePrefetchThread(jrt_entry->jimage(), class_list);
+  if (!os::create_thread(thread, os::os_thread)) {
+    // Not fatal, the classes are decompressed when they are loaded.
+    log_warning(class, load)("JImage prefetch: could not create thread");
+    delete thread;
+    return;
+  }
+  os::start_thread(thread);
+}
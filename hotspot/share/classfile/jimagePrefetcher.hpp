@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_CLASSFILE_JIMAGEPREFETCHER_HPP
+#define SHARE_CLASSFILE_JIMAGEPREFETCHER_HPP
+
+#include "memory/allocation.hpp"
+
+// Decompresses the classes named in the CDS class list, in the order of the
+// list, into the jimage resource cache on a background thread, so that the
+// loading thread of a class in a compressed modules image only has to copy
+// it. Enabled with PrefetchJImageResources and a JImageResourceCacheSize
+// large enough to hold the classes loaded ahead of the loading thread.
+//
+// The class list is SharedClassListFile, or the default list of the JDK.
+// Classes loaded from the CDS archive instead of the image are skipped.
+class JImagePrefetcher : AllStatic {
+ public:
+  // Starts the thread. Must be called after the CDS archive is mapped.
+  static void initialize();
+};
+
+#endif // SHARE_CLASSFILE_JIMAGEPREFETCHER_HPP
@@ -35,6 +35,8 @@
 #include "prims/jvmtiEnvBase.hpp"
 #include "prims/jvmtiRedefineClasses.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/thread.hpp"
+#include "services/threadService.hpp"
 #include "utilities/macros.hpp"
 #if INCLUDE_JFR
 #include "jfr/support/jfrKlassExtension.hpp"
@@ -194,6 +196,17 @@ InstanceKlass* KlassFactory::create_from_stream(ClassFileStream* stream,
                                         CHECK_NULL);
   }
 
+  // Timer includes loading of super classes and interfaces, but not their
+  // parsing, which is timed by their own recursive calls.
+  JavaThread* jt = (JavaThread*)THREAD;
+  PerfClassTraceTime timer(ClassLoader::perf_class_parse_time(),
+                           ClassLoader::perf_class_parse_selftime(),
+                           NULL,
+                           jt->get_thread_stat()->perf_recursion_counts_addr(),
+                           jt->get_thread_stat()->perf_timers_addr(),
+                           PerfClassTraceTime::PARSE_CLASS,
+                           loader_data);
+
   ClassFileParser parser(stream,
                          name,
                          loader_data,
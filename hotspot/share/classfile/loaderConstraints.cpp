@@ -441,8 +441,7 @@ void LoaderConstraintTable::verify(PlaceholderTable* placeholders) {
         ClassLoaderData* loader_data = ik->class_loader_data();
         Dictionary* dictionary = loader_data->dictionary();
         unsigned int d_hash = dictionary->compute_hash(name);
-        int d_index = dictionary->hash_to_index(d_hash);
-        InstanceKlass* k = dictionary->find_class(d_index, d_hash, name);
+        InstanceKlass* k = dictionary->find_class(d_hash, name);
         if (k != NULL) {
           // We found the class in the dictionary, so we should
           // make sure that the Klass* matches what we already have.
@@ -46,6 +46,7 @@
 #include "runtime/handles.inline.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/safepointVerifiers.hpp"
+#include "runtime/serviceThread.hpp"
 #include "runtime/timerTrace.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
 #include "services/diagnosticCommand.hpp"
@@ -394,20 +395,35 @@ void StringTable::oops_do(OopClosure* f) {
 }
 
 // Concurrent work
+struct StringTableGrowWorker : StackObj {
+  bool do_task(Thread* thread, StringTableHash::GrowTask* gt) {
+    return gt->do_task(thread);
+  }
+  void done() {}
+};
+
 void StringTable::grow(JavaThread* jt) {
-  StringTableHash::GrowTask gt(_local_table);
+  WorkGang* workers = ServiceThread::table_workers(_current_size);
+  StringTableHash::GrowTask gt(_local_table, workers != NULL);
   if (!gt.prepare(jt)) {
     return;
   }
   log_trace(stringtable)("Started to grow");
   {
     TraceTime timer("Grow", TRACETIME_LOG(Debug, stringtable, perf));
-    while (gt.do_task(jt)) {
-      gt.pause(jt);
-      {
-        ThreadBlockInVM tbivm(jt);
+    if (workers != NULL) {
+      StringTableGrowWorker prototype;
+      ConcurrentHashTableGangTask<StringTableHash::GrowTask, StringTableGrowWorker>
+        task("StringTable Grow", &gt, prototype);
+      task.run(jt, workers);
+    } else {
+      while (gt.do_task(jt)) {
+        gt.pause(jt);
+        {
+          ThreadBlockInVM tbivm(jt);
+        }
+        gt.cont(jt);
       }
-      gt.cont(jt);
     }
   }
   gt.done(jt);
@@ -437,26 +453,50 @@ struct StringTableDeleteCheck : StackObj {
   }
 };
 
+struct StringTableDeleteWorker : StackObj {
+  StringTableDeleteCheck _stdc;
+  StringTableDoDelete _stdd;
+  long* _count;
+  long* _item;
+  StringTableDeleteWorker(long* count, long* item) : _count(count), _item(item) {}
+  bool do_task(Thread* thread, StringTableHash::BulkDeleteTask* bdt) {
+    return bdt->do_task(thread, _stdc, _stdd);
+  }
+  void done() {
+    Atomic::add(_stdc._count, _count);
+    Atomic::add(_stdc._item, _item);
+  }
+};
+
 void StringTable::clean_dead_entries(JavaThread* jt) {
-  StringTableHash::BulkDeleteTask bdt(_local_table);
+  WorkGang* workers = ServiceThread::table_workers(_current_size);
+  StringTableHash::BulkDeleteTask bdt(_local_table, workers != NULL);
   if (!bdt.prepare(jt)) {
     return;
   }
 
-  StringTableDeleteCheck stdc;
-  StringTableDoDelete stdd;
+  long count = 0;
+  long item = 0;
+  StringTableDeleteWorker stdw(&count, &item);
   {
     TraceTime timer("Clean", TRACETIME_LOG(Debug, stringtable, perf));
-    while(bdt.do_task(jt, stdc, stdd)) {
-      bdt.pause(jt);
-      {
-        ThreadBlockInVM tbivm(jt);
+    if (workers != NULL) {
+      ConcurrentHashTableGangTask<StringTableHash::BulkDeleteTask, StringTableDeleteWorker>
+        task("StringTable Clean", &bdt, stdw);
+      task.run(jt, workers);
+    } else {
+      while(stdw.do_task(jt, &bdt)) {
+        bdt.pause(jt);
+        {
+          ThreadBlockInVM tbivm(jt);
+        }
+        bdt.cont(jt);
       }
-      bdt.cont(jt);
+      stdw.done();
     }
     bdt.done(jt);
   }
-  log_debug(stringtable)("Cleaned %ld of %ld", stdc._count, stdc._item);
+  log_debug(stringtable)("Cleaned %ld of %ld", count, item);
 }
 
 void StringTable::check_concurrent_work() {
@@ -488,6 +528,18 @@ void StringTable::do_concurrent_work(JavaThread* jt) {
   } else {
     clean_dead_entries(jt);
   }
+  log_chain_statistics();
+}
+
+void StringTable::log_chain_statistics() {
+  LogTarget(Debug, stringtable, perf) lt;
+  if (lt.is_enabled()) {
+    TableStatistics ts = get_table_statistics();
+    lt.print("Chain length: max " SIZE_FORMAT ", average %.3f, stddev %.3f "
+             "(" SIZE_FORMAT " entries in " SIZE_FORMAT " buckets)",
+             ts._maximum_bucket_size, ts._average_bucket_size, ts._stddev_of_bucket_size,
+             ts._number_of_entries, ts._number_of_buckets);
+  }
 }
 
 // Rehash
@@ -536,6 +588,7 @@ void StringTable::rehash_table() {
 
   murmur_seed = AltHashing::compute_seed();
   {
+    TraceTime timer("Rehash", TRACETIME_LOG(Debug, stringtable, perf));
     if (do_rehash()) {
       rehashed = true;
     } else {
@@ -545,6 +598,22 @@ void StringTable::rehash_table() {
   _needs_rehashing = false;
 }
 
+// A lookup walked a chain longer than REHASH_LEN. If the table is due to grow
+// anyway, let the service thread do that concurrently, since growing spreads
+// out the chains as well. Only ask for a rehash, which needs a safepoint, if
+// growing would not help.
+void StringTable::request_rehash() {
+  if (get_load_factor() > PREF_AVG_LIST_LEN &&
+      !_local_table->is_max_size_reached()) {
+    if (!_has_work) {
+      log_debug(stringtable)("Long chain found, growing instead of rehashing.");
+      trigger_concurrent_work();
+    }
+    return;
+  }
+  _needs_rehashing = true;
+}
+
 // Statistics
 static int literal_size(oop obj) {
   // NOTE: this would over-count if (pre-JDK8)
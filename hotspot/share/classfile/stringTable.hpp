@@ -73,6 +73,7 @@ class StringTable : public CHeapObj<mtSymbol>{
   static void print_table_statistics(outputStream* st, const char* table_name);
 
   static bool do_rehash();
+  static void log_chain_statistics();
 
  public:
   static size_t table_size();
@@ -115,9 +116,10 @@ class StringTable : public CHeapObj<mtSymbol>{
   // Rehash the string table if it gets out of balance
   static void rehash_table();
   static bool needs_rehashing() { return _needs_rehashing; }
+  static void request_rehash();
   static inline void update_needs_rehash(bool rehash) {
     if (rehash) {
-      _needs_rehashing = true;
+      request_rehash();
     }
   }
 
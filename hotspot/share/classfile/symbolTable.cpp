@@ -35,6 +35,7 @@
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
+#include "runtime/serviceThread.hpp"
 #include "runtime/timerTrace.hpp"
 #include "services/diagnosticCommand.hpp"
 #include "utilities/concurrentHashTable.inline.hpp"
@@ -460,19 +461,34 @@ Symbol* SymbolTable::lookup_only_unicode(const jchar* name, int utf16_length,
 void SymbolTable::new_symbols(ClassLoaderData* loader_data, const constantPoolHandle& cp,
                               int names_count, const char** names, int* lengths,
                               int* cp_indices, unsigned int* hashValues) {
+  assert(names_count <= symbol_alloc_batch_size, "batch too large");
   bool c_heap = !loader_data->is_the_null_class_loader_data();
+  if (DumpSharedSpaces || DynamicDumpSharedSpaces) {
+    c_heap = false;
+  }
+  // Symbols of the boot loader live in the symbol arena. Allocate the whole
+  // batch with one acquisition of the arena lock, instead of one per symbol.
+  Symbol* allocated[symbol_alloc_batch_size];
+  if (!c_heap) {
+    MutexLocker ml(SymbolArena_lock, Mutex::_no_safepoint_check_flag); // Protect arena
+    for (int i = 0; i < names_count; i++) {
+      assert(lengths[i] <= Symbol::max_length(), "should be checked by caller");
+      allocated[i] = new (lengths[i], arena()) Symbol((const u1*)names[i], lengths[i], PERM_REFCOUNT);
+    }
+  }
   for (int i = 0; i < names_count; i++) {
     const char *name = names[i];
     int len = lengths[i];
     unsigned int hash = hashValues[i];
     assert(lookup_shared(name, len, hash) == NULL, "must have checked already");
-    Symbol* sym = do_add_if_needed(name, len, hash, c_heap);
+    Symbol* sym = do_add_if_needed(name, len, hash, c_heap, c_heap ? NULL : allocated[i]);
     assert(sym->refcount() != 0, "lookup should have incremented the count");
     cp->symbol_at_put(cp_indices[i], sym);
   }
 }
 
-Symbol* SymbolTable::do_add_if_needed(const char* name, int len, uintx hash, bool heap) {
+Symbol* SymbolTable::do_add_if_needed(const char* name, int len, uintx hash, bool heap,
+                                      Symbol* allocated) {
   SymbolTableLookup lookup(name, len, hash);
   SymbolTableGet stg;
   bool clean_hint = false;
@@ -482,7 +498,12 @@ Symbol* SymbolTable::do_add_if_needed(const char* name, int len, uintx hash, boo
 
   do {
     // Callers have looked up the symbol once, insert the symbol.
-    sym = allocate_symbol(name, len, heap);
+    if (allocated != NULL) {
+      sym = allocated;
+      allocated = NULL;
+    } else {
+      sym = allocate_symbol(name, len, heap);
+    }
     if (_local_table->insert(THREAD, lookup, sym, &rehash_warning, &clean_hint)) {
       break;
     }
@@ -659,20 +680,35 @@ void SymbolTable::serialize_shared_table_header(SerializeClosure* soc,
 #endif //INCLUDE_CDS
 
 // Concurrent work
+struct SymbolTableGrowWorker : StackObj {
+  bool do_task(Thread* thread, SymbolTableHash::GrowTask* gt) {
+    return gt->do_task(thread);
+  }
+  void done() {}
+};
+
 void SymbolTable::grow(JavaThread* jt) {
-  SymbolTableHash::GrowTask gt(_local_table);
+  WorkGang* workers = ServiceThread::table_workers(_current_size);
+  SymbolTableHash::GrowTask gt(_local_table, workers != NULL);
   if (!gt.prepare(jt)) {
     return;
   }
   log_trace(symboltable)("Started to grow");
   {
     TraceTime timer("Grow", TRACETIME_LOG(Debug, symboltable, perf));
-    while (gt.do_task(jt)) {
-      gt.pause(jt);
-      {
-        ThreadBlockInVM tbivm(jt);
+    if (workers != NULL) {
+      SymbolTableGrowWorker prototype;
+      ConcurrentHashTableGangTask<SymbolTableHash::GrowTask, SymbolTableGrowWorker>
+        task("SymbolTable Grow", &gt, prototype);
+      task.run(jt, workers);
+    } else {
+      while (gt.do_task(jt)) {
+        gt.pause(jt);
+        {
+          ThreadBlockInVM tbivm(jt);
+        }
+        gt.cont(jt);
       }
-      gt.cont(jt);
     }
   }
   gt.done(jt);
@@ -704,31 +740,56 @@ struct SymbolTableDeleteCheck : StackObj {
   }
 };
 
+struct SymbolTableDeleteWorker : StackObj {
+  SymbolTableDeleteCheck _stdc;
+  SymbolTableDoDelete _stdd;
+  size_t* _processed;
+  size_t* _deleted;
+  SymbolTableDeleteWorker(size_t* processed, size_t* deleted)
+    : _processed(processed), _deleted(deleted) {}
+  bool do_task(Thread* thread, SymbolTableHash::BulkDeleteTask* bdt) {
+    return bdt->do_task(thread, _stdc, _stdd);
+  }
+  void done() {
+    Atomic::add(_stdc._processed, _processed);
+    Atomic::add(_stdd._deleted, _deleted);
+  }
+};
+
 void SymbolTable::clean_dead_entries(JavaThread* jt) {
-  SymbolTableHash::BulkDeleteTask bdt(_local_table);
+  WorkGang* workers = ServiceThread::table_workers(_current_size);
+  SymbolTableHash::BulkDeleteTask bdt(_local_table, workers != NULL);
   if (!bdt.prepare(jt)) {
     return;
   }
 
-  SymbolTableDeleteCheck stdc;
-  SymbolTableDoDelete stdd;
+  size_t processed = 0;
+  size_t deleted = 0;
+  SymbolTableDeleteWorker stdw(&processed, &deleted);
   {
     TraceTime timer("Clean", TRACETIME_LOG(Debug, symboltable, perf));
-    while (bdt.do_task(jt, stdc, stdd)) {
-      bdt.pause(jt);
-      {
-        ThreadBlockInVM tbivm(jt);
+    if (workers != NULL) {
+      ConcurrentHashTableGangTask<SymbolTableHash::BulkDeleteTask, SymbolTableDeleteWorker>
+        task("SymbolTable Clean", &bdt, stdw);
+      task.run(jt, workers);
+    } else {
+      while (stdw.do_task(jt, &bdt)) {
+        bdt.pause(jt);
+        {
+          ThreadBlockInVM tbivm(jt);
+        }
+        bdt.cont(jt);
       }
-      bdt.cont(jt);
+      stdw.done();
     }
     reset_has_items_to_clean();
     bdt.done(jt);
   }
 
-  Atomic::add(stdc._processed, &_symbols_counted);
+  Atomic::add(processed, &_symbols_counted);
 
   log_debug(symboltable)("Cleaned " SIZE_FORMAT " of " SIZE_FORMAT,
-                         stdd._deleted, stdc._processed);
+                         deleted, processed);
 }
 
 void SymbolTable::check_concurrent_work() {
@@ -754,9 +815,21 @@ void SymbolTable::do_concurrent_work(JavaThread* jt) {
   } else {
     clean_dead_entries(jt);
   }
+  log_chain_statistics();
   _has_work = false;
 }
 
+void SymbolTable::log_chain_statistics() {
+  LogTarget(Debug, symboltable, perf) lt;
+  if (lt.is_enabled()) {
+    TableStatistics ts = get_table_statistics();
+    lt.print("Chain length: max " SIZE_FORMAT ", average %.3f, stddev %.3f "
+             "(" SIZE_FORMAT " entries in " SIZE_FORMAT " buckets)",
+             ts._maximum_bucket_size, ts._average_bucket_size, ts._stddev_of_bucket_size,
+             ts._number_of_entries, ts._number_of_buckets);
+  }
+}
+
 // Rehash
 bool SymbolTable::do_rehash() {
   if (!_local_table->is_safepoint_safe()) {
@@ -804,15 +877,34 @@ void SymbolTable::rehash_table() {
 
   murmur_seed = AltHashing::compute_seed();
 
-  if (do_rehash()) {
-    rehashed = true;
-  } else {
-    log_info(symboltable)("Resizes in progress rehashing skipped.");
+  {
+    TraceTime timer("Rehash", TRACETIME_LOG(Debug, symboltable, perf));
+    if (do_rehash()) {
+      rehashed = true;
+    } else {
+      log_info(symboltable)("Resizes in progress rehashing skipped.");
+    }
   }
 
   _needs_rehashing = false;
 }
 
+// A lookup walked a chain longer than REHASH_LEN. If the table is due to grow
+// anyway, let the service thread do that concurrently, since growing spreads
+// out the chains as well. Only ask for a rehash, which needs a safepoint, if
+// growing would not help.
+void SymbolTable::request_rehash() {
+  if (get_load_factor() > PREF_AVG_LIST_LEN &&
+      !_local_table->is_max_size_reached()) {
+    if (!_has_work) {
+      log_debug(symboltable)("Long chain found, growing instead of rehashing.");
+      trigger_cleanup();
+    }
+    return;
+  }
+  _needs_rehashing = true;
+}
+
 //---------------------------------------------------------------------------
 // Non-product code
 
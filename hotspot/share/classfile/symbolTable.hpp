@@ -125,7 +125,9 @@ class SymbolTable : public AllStatic {
 
   static Symbol* allocate_symbol(const char* name, int len, bool c_heap); // Assumes no characters larger than 0x7F
   static Symbol* do_lookup(const char* name, int len, uintx hash);
-  static Symbol* do_add_if_needed(const char* name, int len, uintx hash, bool heap);
+  // If allocated is not NULL, it is inserted instead of a new symbol.
+  static Symbol* do_add_if_needed(const char* name, int len, uintx hash, bool heap,
+                                  Symbol* allocated = NULL);
 
   // lookup only, won't add. Also calculate hash. Used by the ClassfileParser.
   static Symbol* lookup_only(const char* name, int len, unsigned int& hash);
@@ -149,6 +151,7 @@ class SymbolTable : public AllStatic {
 
   static void try_rehash_table();
   static bool do_rehash();
+  static void log_chain_statistics();
 
 public:
   // The symbol table
@@ -156,7 +159,7 @@ public:
   static TableStatistics get_table_statistics();
 
   enum {
-    symbol_alloc_batch_size = 8,
+    symbol_alloc_batch_size = 32,
     // Pick initial size based on java -version size measurements
     symbol_alloc_arena_size = 360*K // TODO (revisit)
   };
@@ -196,9 +199,10 @@ public:
   // Rehash the string table if it gets out of balance
   static void rehash_table();
   static bool needs_rehashing() { return _needs_rehashing; }
+  static void request_rehash();
   static inline void update_needs_rehash(bool rehash) {
     if (rehash) {
-      _needs_rehashing = true;
+      request_rehash();
     }
   }
 
@@ -509,8 +509,7 @@ void SystemDictionary::validate_protection_domain(InstanceKlass* klass,
     unsigned int d_hash = dictionary->compute_hash(kn);
 
     MutexLocker mu(SystemDictionary_lock, THREAD);
-    int d_index = dictionary->hash_to_index(d_hash);
-    dictionary->add_protection_domain(d_index, d_hash, klass,
+    dictionary->add_protection_domain(d_hash, klass,
                                       protection_domain, THREAD);
   }
 }
@@ -927,12 +926,12 @@ InstanceKlass* SystemDictionary::resolve_instance_class_or_null(Symbol* name,
 // This routine does not lock the system dictionary.
 //
 // Since readers don't hold a lock, we must make sure that system
-// dictionary entries are only removed at a safepoint (when only one
-// thread is running), and are added to in a safe way (all links must
-// be updated in an MT-safe manner).
+// dictionary entries are only removed with the whole dictionary, and
+// are added to in a safe way (the dictionary table publishes the new
+// entries in an MT-safe manner).
 //
 // Callers should be aware that an entry could be added just after
-// _dictionary->bucket(index) is read here, so the caller will not see
+// the dictionary is looked up here, so the caller will not see
 // the new entry.
 
 Klass* SystemDictionary::find(Symbol* class_name,
@@ -1751,8 +1750,7 @@ InstanceKlass* SystemDictionary::find_class(unsigned int hash,
                                             Symbol* class_name,
                                             Dictionary* dictionary) {
   assert_locked_or_safepoint(SystemDictionary_lock);
-  int index = dictionary->hash_to_index(hash);
-  return dictionary->find_class(index, hash, class_name);
+  return dictionary->find_class(hash, class_name);
 }
 
 
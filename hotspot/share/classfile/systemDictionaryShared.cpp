@@ -38,6 +38,7 @@
 #include "classfile/vmSymbols.hpp"
 #include "logging/log.hpp"
 #include "memory/allocation.hpp"
+#include "memory/archiveUtils.hpp"
 #include "memory/filemap.hpp"
 #include "memory/metadataFactory.hpp"
 #include "memory/metaspaceClosure.hpp"
@@ -78,6 +79,7 @@ public:
   int                          _id;
   int                          _clsfile_size;
   int                          _clsfile_crc32;
+  int                          _loader_id;
   GrowableArray<DTConstraint>* _verifier_constraints;
   GrowableArray<char>*         _verifier_constraint_flags;
 
@@ -86,6 +88,7 @@ public:
     _id = -1;
     _clsfile_size = -1;
     _clsfile_crc32 = -1;
+    _loader_id = 0;
     _excluded = false;
     _verifier_constraints = NULL;
     _verifier_constraint_flags = NULL;
@@ -188,6 +191,7 @@ public:
   struct CrcInfo {
     int _clsfile_size;
     int _clsfile_crc32;
+    int _loader_id;   // 0 if any loader may use the class
   };
 
   // This is different than  DumpTimeSharedClassInfo::DTConstraint. We use
@@ -277,6 +281,7 @@ public:
       CrcInfo* c = crc();
       c->_clsfile_size = info._clsfile_size;
       c->_clsfile_crc32 = info._clsfile_crc32;
+      c->_loader_id = info._loader_id;
     }
     _num_constraints = info.num_constraints();
     if (_num_constraints > 0) {
@@ -294,11 +299,19 @@ public:
     if (DynamicDumpSharedSpaces) {
       _klass = DynamicArchive::original_to_target(info._klass);
     }
+    ArchivePtrMarker::mark_pointer(&_klass);
   }
 
-  bool matches(int clsfile_size, int clsfile_crc32) const {
+  bool matches(int clsfile_size, int clsfile_crc32, int loader_id) const {
     return crc()->_clsfile_size  == clsfile_size &&
-           crc()->_clsfile_crc32 == clsfile_crc32;
+           crc()->_clsfile_crc32 == clsfile_crc32 &&
+           (crc()->_loader_id == 0 || crc()->_loader_id == loader_id);
+  }
+
+  // The dynamic archive may have several classes of the same name from
+  // different loaders, so they are also hashed by loader and contents.
+  static unsigned int unregistered_hash(Symbol* name, int clsfile_crc32, int loader_id) {
+    return primitive_hash<Symbol*>(name) ^ (unsigned int)clsfile_crc32 ^ (unsigned int)loader_id;
   }
 
   Symbol* get_constraint_name(int i) {
@@ -337,6 +350,7 @@ public:
     } else {
       *info_pointer_addr(klass) = record;
     }
+    ArchivePtrMarker::mark_pointer(info_pointer_addr(klass));
   }
 
   // Used by RunTimeSharedDictionary to implement OffsetCompactHashtable::EQUALS
@@ -906,23 +920,23 @@ InstanceKlass* SystemDictionaryShared::lookup_from_stream(Symbol* class_name,
     return NULL;
   }
 
+  int clsfile_size  = cfs->length();
+  int clsfile_crc32 = ClassLoader::crc32(0, (const char*)cfs->buffer(), cfs->length());
+  int loader_id = 0;
+
   const RunTimeSharedClassInfo* record = find_record(&_unregistered_dictionary, class_name);
-  if (record == NULL) {
+  if (record == NULL || !record->matches(clsfile_size, clsfile_crc32, loader_id)) {
+    record = NULL;
     if (DynamicArchive::is_mapped()) {
-      record = find_record(&_dynamic_unregistered_dictionary, class_name);
+      loader_id = loader_identity(class_loader());
+      unsigned int hash = RunTimeSharedClassInfo::unregistered_hash(class_name, clsfile_crc32, loader_id);
+      record = _dynamic_unregistered_dictionary.lookup(class_name, hash, 0);
     }
-    if (record == NULL) {
+    if (record == NULL || !record->matches(clsfile_size, clsfile_crc32, loader_id)) {
       return NULL;
     }
   }
 
-  int clsfile_size  = cfs->length();
-  int clsfile_crc32 = ClassLoader::crc32(0, (const char*)cfs->buffer(), cfs->length());
-
-  if (!record->matches(clsfile_size, clsfile_crc32)) {
-    return NULL;
-  }
-
   return acquire_class_for_current_thread(record->_klass, class_loader,
                                           protection_domain, cfs,
                                           THREAD);
@@ -1034,6 +1048,27 @@ void SystemDictionaryShared::set_shared_class_misc_info(InstanceKlass* k, ClassF
   DumpTimeSharedClassInfo* info = find_or_allocate_info_for(k);
   info->_clsfile_size  = cfs->length();
   info->_clsfile_crc32 = ClassLoader::crc32(0, (const char*)cfs->buffer(), cfs->length());
+  if (DynamicDumpSharedSpaces) {
+    // The classes in the static archive are loaded from a "source:" at dump
+    // time, without a loader of their own.
+    info->_loader_id = loader_identity(k->class_loader());
+  }
+}
+
+// Custom loaders identify themselves by their class, and by the name they
+// passed to the ClassLoader constructor (e.g. a module layer or bundle name
+// and version). Never 0, which matches any loader.
+int SystemDictionaryShared::loader_identity(oop class_loader) {
+  assert(class_loader != NULL, "must be a custom loader");
+  ResourceMark rm;
+  Symbol* klass_name = class_loader->klass()->name();
+  int id = ClassLoader::crc32(0, (const char*)klass_name->bytes(), klass_name->utf8_length());
+  oop name = java_lang_ClassLoader::name(class_loader);
+  if (name != NULL) {
+    const char* s = java_lang_String::as_utf8_string(name);
+    id = ClassLoader::crc32(id, s, (int)strlen(s));
+  }
+  return id != 0 ? id : 1;
 }
 
 void SystemDictionaryShared::init_dumptime_info(InstanceKlass* k) {
@@ -1362,7 +1397,11 @@ public:
       if (DynamicDumpSharedSpaces) {
         name = DynamicArchive::original_to_target(name);
       }
-      hash = primitive_hash<Symbol*>(name);
+      if (DynamicDumpSharedSpaces && !_is_builtin) {
+        hash = RunTimeSharedClassInfo::unregistered_hash(name, info._clsfile_crc32, info._loader_id);
+      } else {
+        hash = primitive_hash<Symbol*>(name);
+      }
       u4 delta;
       if (DynamicDumpSharedSpaces) {
         delta = MetaspaceShared::object_delta_u4(DynamicArchive::buffer_to_target(record));
@@ -99,6 +99,11 @@
         search _unregistered_dictionary for an entry that matches the
         (name, clsfile_len, clsfile_crc32).
 
+        then search the dynamic archive's unregistered dictionary for an
+        entry that matches the (name, clsfile_len, clsfile_crc32, loader
+        identity). Any class defined by a custom loader while dumping with
+        -XX:ArchiveClassesAtExit is archived there, no classlist needed.
+
 ===============================================================================*/
 #define UNREGISTERED_INDEX -9999
 
@@ -271,6 +276,7 @@ public:
 
   static void update_shared_entry(InstanceKlass* klass, int id);
   static void set_shared_class_misc_info(InstanceKlass* k, ClassFileStream* cfs);
+  static int loader_identity(oop class_loader);
 
   static InstanceKlass* lookup_from_stream(Symbol* class_name,
                                            Handle class_loader,
@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#include "precompiled.hpp"
+#include "classfile/symbolTable.hpp"
+#include "classfile/verificationCache.hpp"
+#include "classfile/verificationType.hpp"
+#include "logging/log.hpp"
+#include "memory/allocation.inline.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/instanceKlass.hpp"
+#include "oops/symbol.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.hpp"
+#include "runtime/vm_version.hpp"
+#include "utilities/ostream.hpp"
+#include "utilities/resourceHash.hpp"
+
+static const char* const VerificationCacheHeader = "# verification cache 1";
+
+// A class that passed verification. Classes with the same fingerprint but
+// different names are chained. Never freed, so that replay() can use an
+// entry without holding the lock.
+class VerifiedClass : public CHeapObj<mtClass> {
+ public:
+  Symbol* _name;
+  int _length;
+  VerificationCache::Constraint* _constraints;
+  VerifiedClass* _next;
+
+  VerifiedClass(Symbol* name, int length) : _name(name), _length(length), _next(NULL) {
+    _constraints = NEW_C_HEAP_ARRAY(VerificationCache::Constraint, MAX2(length, 1), mtClass);
+  }
+};
+
+typedef ResourceHashtable<uint64_t, VerifiedClass*,
+                          primitive_hash<uint64_t>, primitive_equals<uint64_t>,
+                          4099, ResourceObj::C_HEAP, mtClass> VerifiedClassTable;
+
+static VerifiedClassTable* _table = NULL;
+static Mutex* _table_lock = NULL;
+// Whether classes were added since the file was read.
+static bool _modified = false;
+
+void verificationCache_init() {
+  VerificationCache::initialize();
+}
+
+bool VerificationCache::is_enabled() {
+  return _table != NULL;
+}
+
+bool VerificationCache::can_cache(InstanceKlass* k) {
+  // The constant pool patches of unsafe anonymous classes are not part of
+  // the fingerprint.
+  return is_enabled() && !k->is_unsafe_anonymous() && k->has_stored_fingerprint();
+}
+
+static VerifiedClass* find_locked(uint64_t fp, Symbol* name) {
+  VerifiedClass** head = _table->get(fp);
+  for (VerifiedClass* vc = head != NULL ? *head : NULL; vc != NULL; vc = vc->_next) {
+    if (vc->_name == name) {
+      return vc;
+    }
+  }
+  return NULL;
+}
+
+// Takes over the references to the symbols in vc. Returns false if a class
+// with the same name and fingerprint is already present.
+static bool add_locked(uint64_t fp, VerifiedClass* vc) {
+  if (find_locked(fp, vc->_name) != NULL) {
+    return false;
+  }
+  VerifiedClass** head = _table->get(fp);
+  if (head != NULL) {
+    vc->_next = *head;
+    *head = vc;
+  } else {
+    _table->put(fp, vc);
+  }
+  return true;
+}
+
+static bool read_flag(const char* s) {
+  return strcmp(s, "1") == 0;
+}
+
+static void read_cache_file(const char* path) {
+  FILE* stream = fopen(path, "rt");
+  if (stream == NULL) {
+    // Nothing cached yet, the file is written at exit.
+    return;
+  }
+
+  char line[4096];
+  if (fgets(line, sizeof(line), stream) == NULL ||
+      strncmp(line, VerificationCacheHeader, strlen(VerificationCacheHeader)) != 0) {
+    warning("Ignoring %s, not a verification cache", path);
+    fclose(stream);
+    return;
+  }
+  {
+    char origin[256];
+    jio_snprintf(origin, sizeof(origin), "vm %s\n", VM_Version::vm_release());
+    if (fgets(line, sizeof(line), stream) == NULL || strcmp(line, origin) != 0) {
+      log_info(verification)("Ignoring verification cache %s, it was written by a different VM", path);
+      fclose(stream);
+      return;
+    }
+  }
+
+  int classes = 0;
+  char name[1024];
+  char fingerprint[32];
+  int length;
+  while (fgets(line, sizeof(line), stream) != NULL) {
+    if (sscanf(line, "class %1023s %31s %d", name, fingerprint, &length) != 3 || length < 0) {
+      continue; // malformed or truncated entry
+    }
+    uint64_t fp = (uint64_t)strtoull(fingerprint, NULL, 16);
+    VerifiedClass* vc = new VerifiedClass(SymbolTable::new_symbol(name), length);
+    int i = 0;
+    for (; i < length && fgets(line, sizeof(line), stream) != NULL; i++) {
+      char to[1024], from[1024], is_protected[2], is_array[2], is_object[2];
+      if (sscanf(line, "%1023s %1023s %1s %1s %1s", to, from, is_protected, is_array, is_object) != 5) {
+        break;
+      }
+      VerificationCache::Constraint* c = &vc->_constraints[i];
+      c->_name = SymbolTable::new_symbol(to);
+      c->_from_name = SymbolTable::new_symbol(from);
+      c->_from_field_is_protected = read_flag(is_protected);
+      c->_from_is_array = read_flag(is_array);
+      c->_from_is_object = read_flag(is_object);
+    }
+    if (i < length) {
+      // Dropping an entry only costs verifying the class again.
+      log_info(verification)("Ignoring truncated verification cache entry for %s", name);
+      vc->_length = i;
+      continue;
+    }
+    if (add_locked(fp, vc)) {
+      classes++;
+    }
+  }
+  fclose(stream);
+
+  log_info(verification)("Loaded verification cache %s: %d classes", path, classes);
+}
+
+void VerificationCache::initialize() {
+  if (VerificationCacheFile == NULL || DumpSharedSpaces || DynamicDumpSharedSpaces) {
+    return;
+  }
+  _table_lock = new Mutex(Mutex::leaf, "VerificationCache_lock", true, Mutex::_safepoint_check_never);
+  _table = new (ResourceObj::C_HEAP, mtClass) VerifiedClassTable();
+  // Still single threaded.
+  read_cache_file(VerificationCacheFile);
+}
+
+bool VerificationCache::replay(InstanceKlass* k, TRAPS) {
+  if (!can_cache(k)) {
+    return false;
+  }
+  VerifiedClass* vc;
+  {
+    MutexLocker ml(_table_lock, Mutex::_no_safepoint_check_flag);
+    vc = find_locked(k->get_stored_fingerprint(), k->name());
+  }
+  if (vc == NULL) {
+    return false;
+  }
+
+  for (int i = 0; i < vc->_length; i++) {
+    Constraint* c = &vc->_constraints[i];
+    bool ok = VerificationType::resolve_and_check_assignability(k, c->_name, c->_from_name,
+                  c->_from_field_is_protected, c->_from_is_array, c->_from_is_object, THREAD);
+    if (HAS_PENDING_EXCEPTION) {
+      // The verifier reports the failure, if it still is one.
+      CLEAR_PENDING_EXCEPTION;
+      ok = false;
+    }
+    if (!ok) {
+      if (log_is_enabled(Info, verification)) {
+        ResourceMark rm(THREAD);
+        log_info(verification)("Cached verification of %s no longer valid: %s is not assignable from %s",
+                               k->external_name(), c->_name->as_C_string(), c->_from_name->as_C_string());
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
+void VerificationCache::record(InstanceKlass* k, GrowableArray<Constraint>* constraints) {
+  if (!can_cache(k)) {
+    return;
+  }
+  int length = constraints != NULL ? constraints->length() : 0;
+  k->name()->increment_refcount();
+  VerifiedClass* vc = new VerifiedClass(k->name(), length);
+  for (int i = 0; i < length; i++) {
+    Constraint c = constraints->at(i);
+    c._name->increment_refcount();
+    c._from_name->increment_refcount();
+    vc->_constraints[i] = c;
+  }
+
+  bool added;
+  {
+    MutexLocker ml(_table_lock, Mutex::_no_safepoint_check_flag);
+    added = add_locked(k->get_stored_fingerprint(), vc);
+    _modified |= added;
+  }
+  if (!added) {
+    // Verified concurrently by another loader; keep the first.
+    for (int i = 0; i < length; i++) {
+      vc->_constraints[i]._name->decrement_refcount();
+      vc->_constraints[i]._from_name->decrement_refcount();
+    }
+    k->name()->decrement_refcount();
+    FREE_C_HEAP_ARRAY(Constraint, vc->_constraints);
+    delete vc;
+  }
+}
+
+// ResourceHashtable::iterate() wants a closure object.
+class WriteVerifiedClass : StackObj {
+  outputStream* _st;
+  int _count;
+ public:
+  WriteVerifiedClass(outputStream* st) : _st(st), _count(0) {}
+
+  bool do_entry(const uint64_t& fp, VerifiedClass* const& head) {
+    for (VerifiedClass* vc = head; vc != NULL; vc = vc->_next) {
+      ResourceMark rm;
+      _st->print_cr("class %s " UINT64_FORMAT_X " %d", vc->_name->as_C_string(), fp, vc->_length);
+      for (int i = 0; i < vc->_length; i++) {
+        VerificationCache::Constraint* c = &vc->_constraints[i];
+        _st->print_cr("%s %s %d %d %d", c->_name->as_C_string(), c->_from_name->as_C_string(),
+                      c->_from_field_is_protected, c->_from_is_array, c->_from_is_object);
+      }
+      _count++;
+    }
+    return true;
+  }
+
+  int count() const { return _count; }
+};
+
+void VerificationCache::dump_at_exit() {
+  if (!is_enabled()) {
+    return;
+  }
+  MutexLocker ml(_table_lock, Mutex::_no_safepoint_check_flag);
+  if (!_modified) {
+    return;
+  }
+  fileStream fs(VerificationCacheFile, "w");
+  if (!fs.is_open()) {
+    warning("Could not open %s for writing the verification cache", VerificationCacheFile);
+    return;
+  }
+  fs.print_cr("%s", VerificationCacheHeader);
+  fs.print_cr("vm %s", VM_Version::vm_release());
+  WriteVerifiedClass writer(&fs);
+  _table->iterate(&writer);
+  _modified = false;
+
+  log_info(verification)("Wrote verification cache %s: %d classes", VerificationCacheFile, writer.count());
+}
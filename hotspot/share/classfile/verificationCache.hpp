@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_CLASSFILE_VERIFICATIONCACHE_HPP
+#define SHARE_CLASSFILE_VERIFICATIONCACHE_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/exceptions.hpp"
+#include "utilities/growableArray.hpp"
+
+class InstanceKlass;
+class Symbol;
+
+// Remembers, across runs, which classes passed the split verifier, so that
+// classes outside of the CDS archive - typically the ones defined by
+// application and framework class loaders - are not verified from scratch
+// on every start.
+//
+// A class is identified by its name and the fingerprint of its class file
+// bytes. What the verifier can not decide from the bytes alone is whether
+// one class is assignable to another. Just like for archived classes (see
+// SystemDictionaryShared::add_verification_constraint()), those checks are
+// recorded as constraints while the class is verified, and replayed instead
+// of verifying the class when it is loaded again. If a constraint no longer
+// holds, the class is verified as usual.
+//
+// Classes whose verification depended on anything else, such as the
+// protected members of a superclass, are not cached.
+//
+// The cache is read from VerificationCacheFile at startup and written back
+// at exit. It is only used by the VM release that wrote it, and it must be
+// protected like the CDS archive: a class found in it is not verified.
+class VerificationCache : AllStatic {
+ public:
+  // A VerificationType::resolve_and_check_assignability() call.
+  struct Constraint {
+    Symbol* _name;
+    Symbol* _from_name;
+    bool    _from_field_is_protected;
+    bool    _from_is_array;
+    bool    _from_is_object;
+  };
+
+  static void initialize();
+  static void dump_at_exit();
+
+  static bool is_enabled();
+
+  // Whether the bytes of k are identified well enough to be cached.
+  static bool can_cache(InstanceKlass* k);
+
+  // Returns true if k passed verification in an earlier run and all its
+  // constraints still hold. Resolves the classes named by the constraints.
+  static bool replay(InstanceKlass* k, TRAPS);
+
+  // Remembers that k has passed the split verifier, given the constraints.
+  static void record(InstanceKlass* k, GrowableArray<Constraint>* constraints);
+};
+
+#endif // SHARE_CLASSFILE_VERIFICATIONCACHE_HPP
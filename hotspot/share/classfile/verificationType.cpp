@@ -104,6 +104,8 @@ bool VerificationType::is_reference_assignable_from(
       }
     }
 
+    context->record_assignability_check(name(), from.name(),
+          from_field_is_protected, from.is_array(), from.is_object());
     return resolve_and_check_assignability(klass, name(), from.name(),
           from_field_is_protected, from.is_array(), from.is_object(), THREAD);
   } else if (is_array() && from.is_array()) {
@@ -162,7 +162,8 @@ bool Verifier::verify(InstanceKlass* klass, bool should_verify_class, TRAPS) {
                            ClassLoader::perf_classes_verified(),
                            jt->get_thread_stat()->perf_recursion_counts_addr(),
                            jt->get_thread_stat()->perf_timers_addr(),
-                           PerfClassTraceTime::CLASS_VERIFY);
+                           PerfClassTraceTime::CLASS_VERIFY,
+                           klass->class_loader_data());
 
   // If the class should be verified, first see if we can use the split
   // verifier.  If not, or if verification fails and FailOverToOldVerifier
@@ -175,11 +176,21 @@ bool Verifier::verify(InstanceKlass* klass, bool should_verify_class, TRAPS) {
   bool can_failover = FailOverToOldVerifier &&
      klass->major_version() < NOFAILOVER_MAJOR_VERSION;
 
+  if (klass->major_version() >= STACKMAP_ATTRIBUTE_MAJOR_VERSION &&
+      VerificationCache::replay(klass, THREAD)) {
+    log_info(class, init)("Skipped class verification for: %s, verified by an earlier run",
+                          klass->external_name());
+    return true;
+  }
+
   log_info(class, init)("Start class verification for: %s", klass->external_name());
   if (klass->major_version() >= STACKMAP_ATTRIBUTE_MAJOR_VERSION) {
     ClassVerifier split_verifier(klass, THREAD);
     split_verifier.verify_class(THREAD);
     exception_name = split_verifier.result();
+    if (!HAS_PENDING_EXCEPTION) {
+      split_verifier.record_in_cache();
+    }
     if (can_failover && !HAS_PENDING_EXCEPTION &&
         (exception_name == vmSymbols::java_lang_VerifyError() ||
          exception_name == vmSymbols::java_lang_ClassFormatError())) {
@@ -577,7 +588,8 @@ void ErrorContext::stackmap_details(outputStream* ss, const Method* method) cons
 ClassVerifier::ClassVerifier(
     InstanceKlass* klass, TRAPS)
     : _thread(THREAD), _previous_symbol(NULL), _symbols(NULL), _exception_type(NULL),
-      _message(NULL), _method_signatures_table(NULL), _klass(klass) {
+      _message(NULL), _method_signatures_table(NULL), _cache_constraints(NULL),
+      _cacheable(VerificationCache::can_cache(klass)), _klass(klass) {
   _this_type = VerificationType::reference_type(klass->name());
 }
 
@@ -2070,6 +2082,9 @@ void ClassVerifier::class_format_error(const char* msg, ...) {
 }
 
 Klass* ClassVerifier::load_class(Symbol* name, TRAPS) {
+  // The outcome depends on the loaded class, which is not recorded.
+  _cacheable = false;
+
   HandleMark hm(THREAD);
   // Get current loader and protection domain first.
   oop loader = current_class()->class_loader();
@@ -2087,6 +2102,30 @@ Klass* ClassVerifier::load_class(Symbol* name, TRAPS) {
   return kls;
 }
 
+void ClassVerifier::record_assignability_check(Symbol* name, Symbol* from_name,
+                                               bool from_field_is_protected,
+                                               bool from_is_array, bool from_is_object) {
+  if (!_cacheable) {
+    return;
+  }
+  if (_cache_constraints == NULL) {
+    _cache_constraints = new GrowableArray<VerificationCache::Constraint>(8);
+  }
+  VerificationCache::Constraint c;
+  c._name = name;
+  c._from_name = from_name;
+  c._from_field_is_protected = from_field_is_protected;
+  c._from_is_array = from_is_array;
+  c._from_is_object = from_is_object;
+  _cache_constraints->append(c);
+}
+
+void ClassVerifier::record_in_cache() {
+  if (_cacheable && !has_error()) {
+    VerificationCache::record(_klass, _cache_constraints);
+  }
+}
+
 bool ClassVerifier::is_protected_access(InstanceKlass* this_class,
                                         Klass* target_class,
                                         Symbol* field_name,
@@ -521,6 +521,7 @@ bool vmIntrinsics::is_disabled_by_flags(vmIntrinsics::ID id) {
     case vmIntrinsics::_indexOfIL:
     case vmIntrinsics::_indexOfIU:
     case vmIntrinsics::_indexOfIUL:
+    case vmIntrinsics::_indexOfL_char:
     case vmIntrinsics::_indexOfU_char:
     case vmIntrinsics::_compareToL:
     case vmIntrinsics::_compareToU:
@@ -764,6 +765,9 @@ bool vmIntrinsics::is_disabled_by_flags(vmIntrinsics::ID id) {
   case vmIntrinsics::_vectorizedMismatch:
     if (!UseVectorizedMismatchIntrinsic) return true;
     break;
+  case vmIntrinsics::_vectorizedHashCode:
+    if (!UseVectorizedHashCodeIntrinsic) return true;
+    break;
   case vmIntrinsics::_updateBytesAdler32:
   case vmIntrinsics::_updateByteBufferAdler32:
     if (!UseAdler32Intrinsics) return true;
@@ -799,6 +803,7 @@ bool vmIntrinsics::is_disabled_by_flags(vmIntrinsics::ID id) {
   case vmIntrinsics::_indexOfIL:
   case vmIntrinsics::_indexOfIU:
   case vmIntrinsics::_indexOfIUL:
+  case vmIntrinsics::_indexOfL_char:
   case vmIntrinsics::_indexOfU_char:
     if (!SpecialStringIndexOf) return true;
     break;
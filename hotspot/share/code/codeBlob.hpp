@@ -42,7 +42,8 @@ struct CodeBlobType {
     NonNMethod          = 2,    // Non-nmethods like Buffers, Adapters and Runtime Stubs
     All                 = 3,    // All types (No code cache segmentation)
     AOT                 = 4,    // AOT methods
-    NumTypes            = 5     // Number of CodeBlobTypes
+    MethodHot           = 5,    // Execution level 4 nmethods of the hottest methods
+    NumTypes            = 6     // Number of CodeBlobTypes
   };
 };
 
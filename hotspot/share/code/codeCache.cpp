@@ -52,6 +52,7 @@
 #include "runtime/icache.hpp"
 #include "runtime/java.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/perfData.hpp"
 #include "runtime/safepointVerifiers.hpp"
 #include "runtime/sweeper.hpp"
 #include "runtime/vmThread.hpp"
@@ -144,6 +145,8 @@ class CodeBlob_sizes {
 #define FOR_ALL_BLOBS(cb, heap) for (CodeBlob* cb = first_blob(heap); cb != NULL; cb = next_blob(heap, cb))
 
 address CodeCache::_low_bound = 0;
+size_t CodeCache::_reserved_page_size = 0;
+PerfVariable* CodeCache::_perf_committed_pages = NULL;
 address CodeCache::_high_bound = 0;
 int CodeCache::_number_of_nmethods_with_dependencies = 0;
 ExceptionCache* volatile CodeCache::_exception_cache_purge_list = NULL;
@@ -281,15 +284,25 @@ void CodeCache::initialize_heaps() {
         non_nmethod_size/K, min_code_cache_size/K));
   }
 
+  // If large page support is enabled, align code heaps according to large
+  // page size to make sure that code cache is covered by large pages.
+  const size_t alignment = MAX2(page_size(false, 8), (size_t) os::vm_allocation_granularity());
+
+  // The hot code heap is taken from the non-profiled code heap, which keeps
+  // at least half of its size.
+  size_t hot_size = 0;
+  if (heap_available(CodeBlobType::MethodHot)) {
+    hot_size = align_down(MIN2((size_t)HotCodeHeapSize, non_profiled_size / 2), alignment);
+    non_profiled_size -= hot_size;
+  }
+
   // Verify sizes and update flag values
-  assert(non_profiled_size + profiled_size + non_nmethod_size == cache_size, "Invalid code heap sizes");
+  assert(non_profiled_size + profiled_size + non_nmethod_size + hot_size == cache_size, "Invalid code heap sizes");
   FLAG_SET_ERGO(NonNMethodCodeHeapSize, non_nmethod_size);
   FLAG_SET_ERGO(ProfiledCodeHeapSize, profiled_size);
   FLAG_SET_ERGO(NonProfiledCodeHeapSize, non_profiled_size);
+  FLAG_SET_ERGO(HotCodeHeapSize, hot_size);
 
-  // If large page support is enabled, align code heaps according to large
-  // page size to make sure that code cache is covered by large pages.
-  const size_t alignment = MAX2(page_size(false, 8), (size_t) os::vm_allocation_granularity());
   non_nmethod_size = align_up(non_nmethod_size, alignment);
   profiled_size    = align_down(profiled_size, alignment);
 
@@ -297,6 +310,7 @@ void CodeCache::initialize_heaps() {
   // parts for the individual heaps. The memory layout looks like this:
   // ---------- high -----------
   //    Non-profiled nmethods
+  //        Hot nmethods
   //      Profiled nmethods
   //         Non-nmethods
   // ---------- low ------------
@@ -310,6 +324,12 @@ void CodeCache::initialize_heaps() {
   add_heap(non_method_space, "CodeHeap 'non-nmethods'", CodeBlobType::NonNMethod);
   // Tier 2 and tier 3 (profiled) methods
   add_heap(profiled_space, "CodeHeap 'profiled nmethods'", CodeBlobType::MethodProfiled);
+  if (hot_size > 0) {
+    // Tier 4 methods that are invoked most often
+    ReservedSpace hot_space = non_profiled_space.first_part(hot_size);
+    non_profiled_space = non_profiled_space.last_part(hot_size);
+    add_heap(hot_space, "CodeHeap 'hot nmethods'", CodeBlobType::MethodHot);
+  }
   // Tier 1 and tier 4 (non-profiled) methods and native methods
   add_heap(non_profiled_space, "CodeHeap 'non-profiled nmethods'", CodeBlobType::MethodNonProfiled);
 }
@@ -328,8 +348,10 @@ size_t CodeCache::page_size(bool aligned, size_t min_pages) {
 }
 
 ReservedCodeSpace CodeCache::reserve_heap_memory(size_t size) {
-  // Align and reserve space for code cache
-  const size_t rs_ps = page_size();
+  // Align and reserve space for code cache. The size is rounded up to the
+  // page size, so it need not be a multiple of the large page size for the
+  // code cache to be backed by large pages.
+  const size_t rs_ps = page_size(false);
   const size_t rs_align = MAX2(rs_ps, (size_t) os::vm_allocation_granularity());
   const size_t rs_size = align_up(size, rs_align);
   ReservedCodeSpace rs(rs_size, rs_align, rs_ps > (size_t) os::vm_page_size());
@@ -337,6 +359,11 @@ ReservedCodeSpace CodeCache::reserve_heap_memory(size_t size) {
     vm_exit_during_initialization(err_msg("Could not reserve enough space for code cache (" SIZE_FORMAT "K)",
                                           rs_size/K));
   }
+  _reserved_page_size = rs_ps;
+  if (os::can_execute_large_page_memory() && rs_ps == (size_t) os::vm_page_size()) {
+    log_info(codecache)("Code cache uses small pages, ReservedCodeCacheSize (" SIZE_FORMAT "K) "
+                        "is too small for large pages", size/K);
+  }
 
   // Initialize bounds
   _low_bound = (address)rs.base();
@@ -346,6 +373,11 @@ ReservedCodeSpace CodeCache::reserve_heap_memory(size_t size) {
 
 // Heaps available for allocation
 bool CodeCache::heap_available(int code_blob_type) {
+  if (code_blob_type == CodeBlobType::MethodHot) {
+    // Part of the non-profiled code heap, see initialize_heaps()
+    return SegmentedCodeCache && HotCodeHeapSize > 0 &&
+           heap_available(CodeBlobType::MethodNonProfiled);
+  }
   if (!SegmentedCodeCache) {
     // No segmentation: use a single code heap
     return (code_blob_type == CodeBlobType::All);
@@ -373,6 +405,9 @@ const char* CodeCache::get_code_heap_flag_name(int code_blob_type) {
   case CodeBlobType::MethodProfiled:
     return "ProfiledCodeHeapSize";
     break;
+  case CodeBlobType::MethodHot:
+    return "HotCodeHeapSize";
+    break;
   }
   ShouldNotReachHere();
   return NULL;
@@ -507,11 +542,13 @@ CodeBlob* CodeCache::allocate(int size, int code_blob_type, int orig_code_blob_t
       if (SegmentedCodeCache) {
         // Fallback solution: Try to store code in another code heap.
         // NonNMethod -> MethodNonProfiled -> MethodProfiled (-> MethodNonProfiled)
+        // MethodHot -> MethodNonProfiled -> MethodProfiled
         // Note that in the sweeper, we check the reverse_free_ratio of the code heap
         // and force stack scanning if less than 10% of the code heap are free.
         int type = code_blob_type;
         switch (type) {
         case CodeBlobType::NonNMethod:
+        case CodeBlobType::MethodHot:
           type = CodeBlobType::MethodNonProfiled;
           break;
         case CodeBlobType::MethodNonProfiled:
@@ -536,6 +573,7 @@ CodeBlob* CodeCache::allocate(int size, int code_blob_type, int orig_code_blob_t
       CompileBroker::handle_full_code_cache(orig_code_blob_type);
       return NULL;
     }
+    update_perf_data();
     if (PrintCodeCacheExtension) {
       ResourceMark rm;
       if (_nmethod_heaps->length() >= 1) {
@@ -552,6 +590,14 @@ CodeBlob* CodeCache::allocate(int size, int code_blob_type, int orig_code_blob_t
   return cb;
 }
 
+int CodeCache::get_code_blob_type(Method* method, int comp_level) {
+  if (comp_level == CompLevel_full_optimization && heap_available(CodeBlobType::MethodHot) &&
+      (julong)method->invocation_count() + (julong)method->backedge_count() >= HotCodeHeapThreshold) {
+    return CodeBlobType::MethodHot;
+  }
+  return get_code_blob_type(comp_level);
+}
+
 void CodeCache::free(CodeBlob* cb) {
   assert_locked_or_safepoint(CodeCache_lock);
   CodeHeap* heap = get_code_heap(cb);
@@ -956,6 +1002,31 @@ void CodeCache::initialize() {
   // This is used on Windows 64 bit platforms to register
   // Structured Exception Handlers for our generated code.
   os::register_code_area((char*)low_bound(), (char*)high_bound());
+
+  initialize_perf_data();
+}
+
+void CodeCache::initialize_perf_data() {
+  if (UsePerfData) {
+    EXCEPTION_MARK;
+    PerfDataManager::create_constant(SUN_CI, "codeCachePageSize", PerfData::U_Bytes,
+                                     (jlong)_reserved_page_size, CHECK);
+    _perf_committed_pages = PerfDataManager::create_variable(SUN_CI, "codeCacheCommittedPages",
+                                                             PerfData::U_None, CHECK);
+    update_perf_data();
+  }
+}
+
+// The more pages the code is spread over, the more iTLB entries it needs.
+void CodeCache::update_perf_data() {
+  if (_perf_committed_pages == NULL) {
+    return;
+  }
+  size_t pages = 0;
+  FOR_ALL_HEAPS(heap) {
+    pages += align_up((*heap)->capacity(), _reserved_page_size) / _reserved_page_size;
+  }
+  _perf_committed_pages->set_value((jlong)pages);
 }
 
 void codeCache_init() {
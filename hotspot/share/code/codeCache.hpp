@@ -75,6 +75,7 @@
 class ExceptionCache;
 class KlassDepChange;
 class OopClosure;
+class PerfLongVariable;
 class ShenandoahParallelCodeHeapIterator;
 
 class CodeCache : AllStatic {
@@ -93,6 +94,8 @@ class CodeCache : AllStatic {
 
   static address _low_bound;                            // Lower bound of CodeHeap addresses
   static address _high_bound;                           // Upper bound of CodeHeap addresses
+  static size_t _reserved_page_size;                    // Page size the CodeHeaps were reserved with
+  static PerfLongVariable* _perf_committed_pages;       // Pages, i.e. iTLB entries, the committed code spans
   static int _number_of_nmethods_with_dependencies;     // Total number of nmethods with dependencies
   static uint8_t _unloading_cycle;                      // Global state for recognizing old nmethods that need to be unloaded
 
@@ -109,7 +112,9 @@ class CodeCache : AllStatic {
   static CodeHeap* get_code_heap(int code_blob_type);         // Returns the CodeHeap for the given CodeBlobType
   // Returns the name of the VM option to set the size of the corresponding CodeHeap
   static const char* get_code_heap_flag_name(int code_blob_type);
-  static ReservedCodeSpace reserve_heap_memory(size_t size);  // Reserves one continuous chunk of memory for the CodeHeaps
+  static ReservedCodeSpace reserve_heap_memory(size_t size);
+  static void initialize_perf_data();
+  static void update_perf_data();  // Reserves one continuous chunk of memory for the CodeHeaps
 
   // Iteration
   static CodeBlob* first_blob(CodeHeap* heap);                // Returns the first CodeBlob on the given CodeHeap
@@ -227,17 +232,18 @@ class CodeCache : AllStatic {
   }
 
   static bool code_blob_type_accepts_compiled(int type) {
-    bool result = type == CodeBlobType::All || type <= CodeBlobType::MethodProfiled;
+    bool result = code_blob_type_accepts_nmethod(type);
     AOT_ONLY( result = result || type == CodeBlobType::AOT; )
     return result;
   }
 
   static bool code_blob_type_accepts_nmethod(int type) {
-    return type == CodeBlobType::All || type <= CodeBlobType::MethodProfiled;
+    return type == CodeBlobType::All || type <= CodeBlobType::MethodProfiled ||
+           type == CodeBlobType::MethodHot;
   }
 
   static bool code_blob_type_accepts_allocable(int type) {
-    return type <= CodeBlobType::All;
+    return type <= CodeBlobType::All || type == CodeBlobType::MethodHot;
   }
 
 
@@ -257,6 +263,11 @@ class CodeCache : AllStatic {
     return 0;
   }
 
+  // Returns the CodeBlobType for an nmethod of the given method. Tier 4 code
+  // of methods that ran HotCodeHeapThreshold times goes into the hot code heap,
+  // so that the code that runs most of the time shares fewer pages.
+  static int get_code_blob_type(Method* method, int comp_level);
+
   static void verify_clean_inline_caches();
   static void verify_icholder_relocations();
 
@@ -461,7 +461,7 @@ nmethod* nmethod::new_native_nmethod(const methodHandle& method,
     CodeOffsets offsets;
     offsets.set_value(CodeOffsets::Verified_Entry, vep_offset);
     offsets.set_value(CodeOffsets::Frame_Complete, frame_complete);
-    nm = new (native_nmethod_size, CompLevel_none)
+    nm = new (native_nmethod_size, CompLevel_none, method())
     nmethod(method(), compiler_none, native_nmethod_size,
             compile_id, &offsets,
             code_buffer, frame_size,
@@ -523,7 +523,7 @@ nmethod* nmethod::new_nmethod(const methodHandle& method,
 #endif
       + align_up(debug_info->data_size()           , oopSize);
 
-    nm = new (nmethod_size, comp_level)
+    nm = new (nmethod_size, comp_level, method())
     nmethod(method(), compiler->type(), nmethod_size, compile_id, entry_bci, offsets,
             orig_pc_offset, debug_info, dependencies, code_buffer, frame_size,
             oop_maps,
@@ -694,8 +694,8 @@ nmethod::nmethod(
   }
 }
 
-void* nmethod::operator new(size_t size, int nmethod_size, int comp_level) throw () {
-  return CodeCache::allocate(nmethod_size, CodeCache::get_code_blob_type(comp_level));
+void* nmethod::operator new(size_t size, int nmethod_size, int comp_level, Method* method) throw () {
+  return CodeCache::allocate(nmethod_size, CodeCache::get_code_blob_type(method, comp_level));
 }
 
 nmethod::nmethod(
@@ -55,6 +55,7 @@
 #include "runtime/javaCalls.hpp"
 #include "runtime/jniHandles.inline.hpp"
 #include "runtime/os.hpp"
+#include "runtime/resourceLimitWatcher.hpp"
 #include "runtime/safepointVerifiers.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/sweeper.hpp"
@@ -149,6 +150,7 @@ PerfCounter* CompileBroker::_perf_sum_osr_bytes_compiled = NULL;
 PerfCounter* CompileBroker::_perf_sum_standard_bytes_compiled = NULL;
 PerfCounter* CompileBroker::_perf_sum_nmethod_size = NULL;
 PerfCounter* CompileBroker::_perf_sum_nmethod_code_size = NULL;
+PerfLongHistogram* CompileBroker::_perf_compile_time_histogram = NULL;
 
 PerfStringVariable* CompileBroker::_perf_last_method = NULL;
 PerfStringVariable* CompileBroker::_perf_last_failed_method = NULL;
@@ -326,6 +328,25 @@ static bool can_remove(CompilerThread *ct, bool do_it) {
   return false;
 }
 
+CompileQueue::CompileQueue(const char* name) :
+  _name(name),
+  _first(NULL),
+  _last(NULL),
+  _first_stale(NULL),
+  _first_unprioritized(NULL),
+  _sweep(NULL),
+  _heap(new (ResourceObj::C_HEAP, mtCompiler) GrowableArray<CompileTask*>(64, true, mtCompiler)),
+  _size(0),
+  _peak_size(0),
+  _added_count(0),
+  _removed_count(0),
+  _stale_count(0),
+  _average_wait_time(0) {
+  for (int i = 0; i < wait_time_buckets; i++) {
+    _wait_time_histogram[i] = 0;
+  }
+}
+
 /**
  * Add a CompileTask to a CompileQueue.
  */
@@ -347,7 +368,12 @@ void CompileQueue::add(CompileTask* task) {
     task->set_prev(_last);
     _last = task;
   }
+  if (_first_unprioritized == NULL) {
+    _first_unprioritized = task;
+  }
   ++_size;
+  _peak_size = MAX2(_peak_size, _size);
+  _added_count++;
 
   // Mark the method as being in the compile queue.
   task->method()->set_queued_for_compilation();
@@ -387,6 +413,9 @@ void CompileQueue::free_all() {
     CompileTask::free(current);
   }
   _first = NULL;
+  _first_unprioritized = NULL;
+  _sweep = NULL;
+  _heap->clear();
 
   // Wake up all threads that block on the queue.
   MethodCompileQueue_lock->notify_all();
@@ -450,6 +479,7 @@ CompileTask* CompileQueue::get() {
     save_hot_method = methodHandle(task->hot_method());
 
     remove(task);
+    record_wait_time(task);
   }
   purge_stale_tasks(); // may temporarily release MCQ lock
   return task;
@@ -495,6 +525,13 @@ void CompileQueue::remove(CompileTask* task) {
     assert(task == _last, "Sanity");
     _last = task->prev();
   }
+  if (task == _first_unprioritized) {
+    _first_unprioritized = task->next();
+  }
+  if (task == _sweep) {
+    _sweep = task->next();
+  }
+  heap_remove(task);
   --_size;
 }
 
@@ -506,6 +543,125 @@ void CompileQueue::remove_and_mark_stale(CompileTask* task) {
   task->set_next(_first_stale);
   task->set_prev(NULL);
   _first_stale = task;
+  _stale_count++;
+}
+
+bool CompileQueue::higher_priority(CompileTask* x, CompileTask* y) {
+  if (x->priority_class() != y->priority_class()) {
+    return x->priority_class() > y->priority_class();
+  }
+  return x->priority_weight() > y->priority_weight();
+}
+
+void CompileQueue::heap_put(int index, CompileTask* task) {
+  _heap->at_put(index, task);
+  task->set_heap_index(index);
+}
+
+void CompileQueue::sift_up(int index) {
+  CompileTask* task = _heap->at(index);
+  while (index > 0) {
+    int parent = (index - 1) / 2;
+    if (!higher_priority(task, _heap->at(parent))) {
+      break;
+    }
+    heap_put(index, _heap->at(parent));
+    index = parent;
+  }
+  heap_put(index, task);
+}
+
+void CompileQueue::sift_down(int index) {
+  CompileTask* task = _heap->at(index);
+  int length = _heap->length();
+  while (true) {
+    int child = 2 * index + 1;
+    if (child >= length) {
+      break;
+    }
+    if (child + 1 < length && higher_priority(_heap->at(child + 1), _heap->at(child))) {
+      child++;
+    }
+    if (!higher_priority(_heap->at(child), task)) {
+      break;
+    }
+    heap_put(index, _heap->at(child));
+    index = child;
+  }
+  heap_put(index, task);
+}
+
+void CompileQueue::heap_remove(CompileTask* task) {
+  int index = task->heap_index();
+  if (index < 0) {
+    return;
+  }
+  assert(_heap->at(index) == task, "heap index out of sync");
+  CompileTask* last = _heap->pop();
+  if (last != task) {
+    heap_put(index, last);
+    sift_up(index);
+    sift_down(last->heap_index());
+  }
+  task->set_heap_index(-1);
+}
+
+void CompileQueue::prioritize(CompileTask* task, int priority_class, double weight) {
+  assert(MethodCompileQueue_lock->owned_by_self(), "must own lock");
+  task->set_priority(priority_class, weight);
+  int index = task->heap_index();
+  if (index < 0) {
+    // Tasks are prioritized in the order they were added.
+    assert(task == _first_unprioritized, "must be the first unprioritized task");
+    _first_unprioritized = task->next();
+    _heap->append(task);
+    task->set_heap_index(_heap->length() - 1);
+    sift_up(task->heap_index());
+  } else {
+    sift_up(index);
+    sift_down(task->heap_index());
+  }
+}
+
+CompileTask* CompileQueue::next_to_sweep() {
+  assert(MethodCompileQueue_lock->owned_by_self(), "must own lock");
+  CompileTask* task = (_sweep != NULL) ? _sweep : _first;
+  if (task == NULL || task == _first_unprioritized) {
+    _sweep = NULL;
+    return NULL;
+  }
+  _sweep = task->next();
+  return task;
+}
+
+void CompileQueue::record_wait_time(CompileTask* task) {
+  _removed_count++;
+  jlong wait_ms = (os::elapsed_counter() - task->time_queued()) * 1000 / os::elapsed_frequency();
+  int bucket = 0;
+  for (jlong limit = 1; bucket < wait_time_buckets - 1 && wait_ms >= limit; limit *= 10) {
+    bucket++;
+  }
+  _wait_time_histogram[bucket]++;
+  // Moving average over roughly the last 16 tasks.
+  _average_wait_time += ((double)wait_ms - _average_wait_time) / 16;
+}
+
+void CompileQueue::collect_statistics(int* size, int* peak_size, size_t* added, size_t* removed,
+                                      size_t* stale, size_t wait_time_histogram[wait_time_buckets]) {
+  MutexLocker ml(MethodCompileQueue_lock);
+  *size = _size;
+  *peak_size = _peak_size;
+  *added = _added_count;
+  *removed = _removed_count;
+  *stale = _stale_count;
+  for (int i = 0; i < wait_time_buckets; i++) {
+    wait_time_histogram[i] = _wait_time_histogram[i];
+    _wait_time_histogram[i] = 0;
+  }
+  _peak_size = _size;
+  _added_count = 0;
+  _removed_count = 0;
+  _stale_count = 0;
 }
 
 // methods in the compile queue need to be marked as used on the stack
@@ -541,6 +697,38 @@ void CompileBroker::print_compile_queues(outputStream* st) {
   }
 }
 
+static void post_compile_queue_statistics_event(CompileQueue* queue) {
+  EventCompilerQueueStatistics event;
+  if (!event.should_commit()) {
+    return;
+  }
+  int size, peak_size;
+  size_t added, removed, stale;
+  size_t waits[CompileQueue::wait_time_buckets];
+  queue->collect_statistics(&size, &peak_size, &added, &removed, &stale, waits);
+  event.set_queue(queue->name());
+  event.set_queueSize(size);
+  event.set_peakQueueSize(peak_size);
+  event.set_addedCount(added);
+  event.set_removedCount(removed);
+  event.set_staleCount(stale);
+  event.set_waitUnder1ms(waits[0]);
+  event.set_waitUnder10ms(waits[1]);
+  event.set_waitUnder100ms(waits[2]);
+  event.set_waitUnder1s(waits[3]);
+  event.set_waitOver1s(waits[4]);
+  event.commit();
+}
+
+void CompileBroker::post_compile_queue_statistics_events() {
+  if (_c1_compile_queue != NULL) {
+    post_compile_queue_statistics_event(_c1_compile_queue);
+  }
+  if (_c2_compile_queue != NULL) {
+    post_compile_queue_statistics_event(_c2_compile_queue);
+  }
+}
+
 void CompileQueue::print(outputStream* st) {
   assert_locked_or_safepoint(MethodCompileQueue_lock);
   st->print_cr("%s:", name());
@@ -675,6 +863,13 @@ void CompileBroker::compilation_init_phase1(TRAPS) {
                  PerfDataManager::create_counter(SUN_CI, "nmethodCodeSize",
                                                  PerfData::U_Bytes, CHECK);
 
+    // 100 us, doubling up to 26 s and beyond
+    _perf_compile_time_histogram =
+                 PerfDataManager::create_long_histogram(SUN_CI, "compileTimeHistogram",
+                                                        PerfData::U_Ticks,
+                                                        MAX2((jlong)1, os::elapsed_frequency() / 10000),
+                                                        20, CHECK);
+
     _perf_last_method =
                  PerfDataManager::create_string_variable(SUN_CI, "lastMethod",
                                        CompilerCounters::cmname_buffer_length,
@@ -887,10 +1082,54 @@ void CompileBroker::init_compiler_sweeper_threads() {
   }
 }
 
+// True while the process uses more than CompilerThreadsCPUThreshold percent
+// of its CPUs. os::active_processor_count() is limited by the CPU quota of
+// the container, so this holds when the application saturates its quota.
+// Called with the CompileThread_lock held, which protects the samples.
+static bool cpu_load_above_threshold() {
+  static double prev_real_time = 0;
+  static double prev_cpu_time = 0;
+  static bool above_threshold = false;
+
+  if (CompilerThreadsCPUThreshold == 0) {
+    return false;
+  }
+  double real_time, user_time, system_time;
+  if (!os::getTimesSecs(&real_time, &user_time, &system_time)) {
+    return false;
+  }
+  double cpu_time = user_time + system_time;
+  double elapsed = real_time - prev_real_time;
+  // Compiler threads call this after every compilation. Only sample
+  // every 100ms so that the load is not just noise.
+  if (prev_real_time != 0 && elapsed >= 0.1) {
+    double load = (cpu_time - prev_cpu_time) / (elapsed * os::active_processor_count());
+    bool was_above_threshold = above_threshold;
+    above_threshold = load * 100 > CompilerThreadsCPUThreshold;
+    if (TraceCompilerThreads && above_threshold != was_above_threshold) {
+      tty->print_cr("%s adding compiler threads (CPU load: %d%%)",
+                    above_threshold ? "Stopped" : "Resumed", (int)(load * 100));
+    }
+  }
+  if (prev_real_time == 0 || elapsed >= 0.1) {
+    prev_real_time = real_time;
+    prev_cpu_time = cpu_time;
+  }
+  return above_threshold;
+}
+
+// With CompileLatencyTarget, the tasks of the queue are compiled soon enough.
+static bool meets_latency_target(CompileQueue* queue) {
+  return CompileLatencyTarget > 0 && queue->average_wait_time() < (double)CompileLatencyTarget;
+}
+
 void CompileBroker::possibly_add_compiler_threads() {
   EXCEPTION_MARK;
 
   julong available_memory = os::available_memory();
+  // Never run more compiler threads of a kind than there are processors
+  // available right now, the container may have been resized.
+  int available_cpus = ResourceLimitWatcher::active_processor_count();
   // If SegmentedCodeCache is off, both values refer to the single heap (with type CodeBlobType::All).
   size_t available_cc_np  = CodeCache::unallocated_capacity(CodeBlobType::MethodNonProfiled),
          available_cc_p   = CodeCache::unallocated_capacity(CodeBlobType::MethodProfiled);
@@ -898,9 +1137,15 @@ void CompileBroker::possibly_add_compiler_threads() {
   // Only do attempt to start additional threads if the lock is free.
   if (!CompileThread_lock->try_lock()) return;
 
-  if (_c2_compile_queue != NULL) {
+  // More compiler threads would take CPU time away from the application.
+  if (cpu_load_above_threshold()) {
+    CompileThread_lock->unlock();
+    return;
+  }
+
+  if (_c2_compile_queue != NULL && !meets_latency_target(_c2_compile_queue)) {
     int old_c2_count = _compilers[1]->num_compiler_threads();
-    int new_c2_count = MIN4(_c2_count,
+    int new_c2_count = MIN4(MIN2(_c2_count, available_cpus),
         _c2_compile_queue->size() / 2,
         (int)(available_memory / (200*M)),
         (int)(available_cc_np / (128*K)));
@@ -918,9 +1163,9 @@ void CompileBroker::possibly_add_compiler_threads() {
     }
   }
 
-  if (_c1_compile_queue != NULL) {
+  if (_c1_compile_queue != NULL && !meets_latency_target(_c1_compile_queue)) {
     int old_c1_count = _compilers[0]->num_compiler_threads();
-    int new_c1_count = MIN4(_c1_count,
+    int new_c1_count = MIN4(MIN2(_c1_count, available_cpus),
         _c1_compile_queue->size() / 4,
         (int)(available_memory / (100*M)),
         (int)(available_cc_p / (128*K)));
@@ -1976,6 +2221,7 @@ static void post_compilation_event(EventCompilation* event, CompileTask* task) {
   event->set_isOsr(task->osr_bci() != CompileBroker::standard_entry_bci);
   event->set_codeSize((task->code() == NULL) ? 0 : task->code()->total_size());
   event->set_inlinedBytes(task->num_inlined_bytecodes());
+  event->set_optimizationsSkipped(task->optimizations_skipped());
   event->commit();
 }
 
@@ -2360,6 +2606,9 @@ void CompileBroker::collect_statistics(CompilerThread* thread, elapsedTimer time
   // account all time, including bailouts and failures in this counter;
   // C1 and C2 counters are counting both successful and unsuccessful compiles
   _t_total_compilation.add(time);
+  if (UsePerfData) {
+    _perf_compile_time_histogram->record(time.ticks());
+  }
 
   if (!success) {
     _total_bailout_count++;
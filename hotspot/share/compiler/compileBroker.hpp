@@ -30,6 +30,7 @@
 #include "compiler/compileTask.hpp"
 #include "compiler/compilerDirectives.hpp"
 #include "runtime/perfData.hpp"
+#include "utilities/growableArray.hpp"
 #include "utilities/stack.hpp"
 #if INCLUDE_JVMCI
 #include "jvmci/jvmciCompiler.hpp"
@@ -77,7 +78,16 @@ class CompilerCounters : public CHeapObj<mtCompiler> {
 // CompileQueue
 //
 // A list of CompileTasks.
+// The tasks are kept in a list in the order they were added. Policies that
+// order tasks by their own heuristics (see TieredThresholdPolicy::select_task())
+// also keep them in a heap with prioritize(), instead of scanning the whole
+// list for every task they select.
 class CompileQueue : public CHeapObj<mtCompiler> {
+ public:
+  // Buckets of the time tasks waited in the queue: below 1ms, 10ms, 100ms,
+  // 1s, and longer.
+  enum { wait_time_buckets = 5 };
+
  private:
   const char* _name;
 
@@ -86,17 +96,34 @@ class CompileQueue : public CHeapObj<mtCompiler> {
 
   CompileTask* _first_stale;
 
+  // Tasks from _first_unprioritized to _last have not been prioritized yet.
+  CompileTask* _first_unprioritized;
+  // Next task to revisit in next_to_sweep().
+  CompileTask* _sweep;
+  // Max-heap of the prioritized tasks.
+  GrowableArray<CompileTask*>* _heap;
+
   int _size;
 
+  // Statistics since the last call of collect_statistics().
+  int    _peak_size;
+  size_t _added_count;
+  size_t _removed_count;
+  size_t _stale_count;
+  size_t _wait_time_histogram[wait_time_buckets];
+  // Milliseconds the recently selected tasks waited in the queue.
+  volatile double _average_wait_time;
+
   void purge_stale_tasks();
+
+  static bool higher_priority(CompileTask* x, CompileTask* y);
+  void heap_put(int index, CompileTask* task);
+  void sift_up(int index);
+  void sift_down(int index);
+  void heap_remove(CompileTask* task);
+  void record_wait_time(CompileTask* task);
  public:
-  CompileQueue(const char* name) {
-    _name = name;
-    _first = NULL;
-    _last = NULL;
-    _size = 0;
-    _first_stale = NULL;
-  }
+  CompileQueue(const char* name);
 
   const char*  name() const                      { return _name; }
 
@@ -111,6 +138,22 @@ class CompileQueue : public CHeapObj<mtCompiler> {
   bool         is_empty() const                  { return _first == NULL; }
   int          size()     const                  { return _size;          }
 
+  // Adds task to the heap, or moves it, with the given priority. Tasks of
+  // a higher priority class come first, then the ones with a higher weight.
+  void         prioritize(CompileTask* task, int priority_class, double weight);
+  CompileTask* first_unprioritized()             { return _first_unprioritized; }
+  // Prioritized task that comes first, NULL if there is none.
+  CompileTask* top() const                       { return _heap->is_empty() ? NULL : _heap->at(0); }
+  // Cycles through the prioritized tasks in list order, so that priorities
+  // can be refreshed a few tasks at a time. NULL at the end of a cycle.
+  CompileTask* next_to_sweep();
+
+  double       average_wait_time() const         { return _average_wait_time; }
+
+  // Copies the statistics into the arguments, and resets them.
+  void collect_statistics(int* size, int* peak_size, size_t* added, size_t* removed,
+                          size_t* stale, size_t wait_time_histogram[wait_time_buckets]);
+
 
   // Redefine Classes support
   void mark_on_stack();
@@ -120,6 +163,7 @@ class CompileQueue : public CHeapObj<mtCompiler> {
 
   ~CompileQueue() {
     assert (is_empty(), " Compile Queue must be empty");
+    delete _heap;
   }
 };
 
@@ -193,6 +237,7 @@ class CompileBroker: AllStatic {
   static PerfCounter* _perf_sum_standard_bytes_compiled;
   static PerfCounter* _perf_sum_nmethod_size;
   static PerfCounter* _perf_sum_nmethod_code_size;
+  static PerfLongHistogram* _perf_compile_time_histogram;
 
   static PerfStringVariable* _perf_last_method;
   static PerfStringVariable* _perf_last_failed_method;
@@ -287,6 +332,8 @@ public:
   static bool compilation_is_complete(const methodHandle& method, int osr_bci, int comp_level);
   static bool compilation_is_in_queue(const methodHandle& method);
   static void print_compile_queues(outputStream* st);
+  // Posts a CompilerQueueStatistics event for each compile queue.
+  static void post_compile_queue_statistics_events();
   static void print_directives(outputStream* st);
   static int queue_size(int comp_level) {
     CompileQueue *q = compile_queue(comp_level);
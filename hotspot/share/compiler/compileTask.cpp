@@ -108,6 +108,7 @@ void CompileTask::initialize(int compile_id,
   JVMCI_ONLY(_jvmci_compiler_thread = NULL;)
   _comp_level = comp_level;
   _num_inlined_bytecodes = 0;
+  _optimizations_skipped = false;
 
   _is_complete = false;
   _is_success = false;
@@ -135,6 +136,9 @@ void CompileTask::initialize(int compile_id,
   }
 
   _next = NULL;
+  _heap_index = -1;
+  _priority_class = 0;
+  _priority_weight = 0;
 }
 
 /**
@@ -412,6 +416,9 @@ void CompileTask::log_task_done(CompileLog* log) {
   if (_num_inlined_bytecodes != 0) {
     log->print(" inlined_bytes='%d'", _num_inlined_bytecodes);
   }
+  if (_optimizations_skipped) {
+    log->print(" optimizations_skipped='1'");
+  }
   log->stamp();
   log->end_elem();
   log->clear_identities();   // next task will have different CI
@@ -94,9 +94,14 @@ class CompileTask : public CHeapObj<mtCompiler> {
 #endif
   int          _comp_level;
   int          _num_inlined_bytecodes;
+  bool         _optimizations_skipped; // compiler ran out of its optimization budget
   nmethodLocker* _code_handle;  // holder of eventual result
   CompileTask* _next, *_prev;
   bool         _is_free;
+  // Priority in the CompileQueue, see CompileQueue::prioritize().
+  int          _heap_index;      // position in the queue's heap, -1 if not in it
+  int          _priority_class;
+  double       _priority_weight;
   // Fields used for logging why the compilation was initiated:
   jlong        _time_queued;  // time when task was enqueued
   jlong        _time_started; // time when compilation started
@@ -167,6 +172,8 @@ class CompileTask : public CHeapObj<mtCompiler> {
 
   int          num_inlined_bytecodes() const     { return _num_inlined_bytecodes; }
   void         set_num_inlined_bytecodes(int n)  { _num_inlined_bytecodes = n; }
+  bool         optimizations_skipped() const     { return _optimizations_skipped; }
+  void         set_optimizations_skipped(bool z) { _optimizations_skipped = z; }
 
   CompileTask* next() const                      { return _next; }
   void         set_next(CompileTask* next)       { _next = next; }
@@ -174,6 +181,16 @@ class CompileTask : public CHeapObj<mtCompiler> {
   void         set_prev(CompileTask* prev)       { _prev = prev; }
   bool         is_free() const                   { return _is_free; }
   void         set_is_free(bool val)             { _is_free = val; }
+
+  int          heap_index() const                { return _heap_index; }
+  void         set_heap_index(int index)         { _heap_index = index; }
+  int          priority_class() const            { return _priority_class; }
+  double       priority_weight() const           { return _priority_weight; }
+  void         set_priority(int priority_class, double weight) {
+    _priority_class = priority_class;
+    _priority_weight = weight;
+  }
+  jlong        time_queued() const               { return _time_queued; }
   bool         is_unloaded() const;
 
   // RedefineClasses support
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/classLoaderDataGraph.hpp"
+#include "code/nmethod.hpp"
+#include "compiler/compilerDefinitions.hpp"
+#include "compiler/profileSnapshot.hpp"
+#include "interpreter/invocationCounter.hpp"
+#include "logging/log.hpp"
+#include "memory/filemap.hpp"
+#include "memory/allocation.inline.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/method.hpp"
+#include "oops/methodCounters.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "runtime/vm_version.hpp"
+#include "utilities/resourceHash.hpp"
+
+static const char* const ProfileSnapshotHeader = "# profile snapshot 1";
+
+// Counters are only meaningful for the same code. In particular, methods
+// and their holders from the CDS archive must be the same, so the snapshot
+// is tied to the VM release and to the mapped archive, if any.
+static void print_origin(outputStream* st) {
+  int archive_crc = 0;
+#if INCLUDE_CDS
+  if (UseSharedSpaces && FileMapInfo::current_info() != NULL) {
+    archive_crc = FileMapInfo::current_info()->crc();
+  }
+#endif
+  st->print("vm %s archive %d", VM_Version::vm_release(), archive_crc);
+}
+
+struct ProfileSnapshotEntry {
+  int _invocations;
+  int _backedges;
+};
+
+class MethodNameKey : AllStatic {
+ public:
+  static unsigned hash(const char* const& name) {
+    unsigned hash = 0;
+    for (const char* p = name; *p != '\0'; p++) {
+      hash = 31 * hash + (unsigned)*p;
+    }
+    return hash;
+  }
+
+  static bool equals(const char* const& a, const char* const& b) {
+    return strcmp(a, b) == 0;
+  }
+};
+
+typedef ResourceHashtable<const char*, ProfileSnapshotEntry,
+                          MethodNameKey::hash, MethodNameKey::equals,
+                          4099, ResourceObj::C_HEAP, mtCompiler> ProfileSnapshotTable;
+
+// Loaded at startup and never modified afterwards.
+static ProfileSnapshotTable* _loaded = NULL;
+
+void profileSnapshot_init() {
+  ProfileSnapshot::initialize();
+}
+
+// Keep the counters well away from overflowing once the method runs again.
+static int clamp_count(int count) {
+  return MIN2(MAX2(count, 0), (int)InvocationCounter::count_limit / 2);
+}
+
+void ProfileSnapshot::initialize() {
+  if (LoadProfileSnapshot == NULL) {
+    return;
+  }
+  FILE* stream = fopen(LoadProfileSnapshot, "rt");
+  if (stream == NULL) {
+    warning("Could not open profile snapshot %s", LoadProfileSnapshot);
+    return;
+  }
+
+  char line[1024];
+  if (fgets(line, sizeof(line), stream) == NULL ||
+      strncmp(line, ProfileSnapshotHeader, strlen(ProfileSnapshotHeader)) != 0) {
+    warning("Ignoring %s, not a profile snapshot", LoadProfileSnapshot);
+    fclose(stream);
+    return;
+  }
+  {
+    char origin[256];
+    stringStream ss(origin, sizeof(origin));
+    print_origin(&ss);
+    if (fgets(line, sizeof(line), stream) == NULL ||
+        strncmp(line, origin, strlen(origin)) != 0 || line[strlen(origin)] != '\n') {
+      log_info(jit, compilation)("Ignoring profile snapshot %s, it was written by a different VM or with a different CDS archive",
+                                 LoadProfileSnapshot);
+      fclose(stream);
+      return;
+    }
+  }
+
+  _loaded = new (ResourceObj::C_HEAP, mtCompiler) ProfileSnapshotTable();
+  int count = 0;
+  while (fgets(line, sizeof(line), stream) != NULL) {
+    char name[1024];
+    int invocations, backedges, level;
+    if (sscanf(line, "%1023s %d %d %d", name, &invocations, &backedges, &level) != 4) {
+      continue; // malformed or truncated line
+    }
+    ProfileSnapshotEntry entry;
+    entry._invocations = clamp_count(invocations);
+    entry._backedges = clamp_count(backedges);
+    char* key = os::strdup_check_oom(name, mtCompiler);
+    if (!_loaded->put(key, entry)) {
+      os::free(key); // duplicate line
+    } else {
+      count++;
+    }
+  }
+  fclose(stream);
+
+  log_info(jit, compilation)("Loaded profile snapshot %s: %d methods", LoadProfileSnapshot, count);
+}
+
+void ProfileSnapshot::apply(Method* m, MethodCounters* counters) {
+  if (_loaded == NULL) {
+    return;
+  }
+  ResourceMark rm;
+  const char* name = m->name_and_sig_as_C_string();
+  ProfileSnapshotEntry* entry = _loaded->get(name);
+  if (entry == NULL) {
+    return;
+  }
+  counters->invocation_counter()->set(InvocationCounter::wait_for_compile, entry->_invocations);
+  counters->backedge_counter()->set(InvocationCounter::wait_for_compile, entry->_backedges);
+  log_debug(jit, compilation)("Seeded counters of %s: %d invocations, %d backedges",
+                              name, entry->_invocations, entry->_backedges);
+}
+
+// ClassLoaderDataGraph::methods_do() only takes a function. Protected by
+// the ClassLoaderDataGraph_lock.
+static outputStream* _dump_stream = NULL;
+static int _dump_count = 0;
+
+static void dump_method(Method* m) {
+  if (m->method_counters() == NULL) {
+    return;
+  }
+  int level = MAX2(m->highest_comp_level(), m->highest_osr_comp_level());
+  CompiledMethod* code = m->code();
+  if (code != NULL) {
+    level = MAX2(level, code->comp_level());
+  }
+  if (level == CompLevel_none) {
+    return; // never got hot enough to be compiled
+  }
+  ResourceMark rm;
+  _dump_stream->print_cr("%s %d %d %d", m->name_and_sig_as_C_string(),
+                         m->invocation_count(), m->backedge_count(), level);
+  _dump_count++;
+}
+
+bool ProfileSnapshot::dump(const char* path, outputStream* st) {
+  fileStream fs(path, "w");
+  if (!fs.is_open()) {
+    st->print_cr("Could not open %s for writing the profile snapshot", path);
+    return false;
+  }
+  fs.print_cr("%s", ProfileSnapshotHeader);
+  print_origin(&fs);
+  fs.cr();
+
+  int count;
+  {
+    MutexLocker ml(ClassLoaderDataGraph_lock);
+    _dump_stream = &fs;
+    _dump_count = 0;
+    ClassLoaderDataGraph::methods_do(dump_method);
+    _dump_stream = NULL;
+    count = _dump_count;
+  }
+
+  log_info(jit, compilation)("Wrote profile snapshot %s: %d methods", path, count);
+  return true;
+}
+
+void ProfileSnapshot::dump_at_exit() {
+  if (DumpProfileSnapshot != NULL) {
+    dump(DumpProfileSnapshot, tty);
+  }
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_COMPILER_PROFILESNAPSHOT_HPP
+#define SHARE_COMPILER_PROFILESNAPSHOT_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/ostream.hpp"
+
+class Method;
+class MethodCounters;
+
+// Snapshot of the invocation and backedge counters of the methods that got
+// compiled, so that a restarted VM does not have to spend the time in the
+// interpreter again to find out which methods are hot.
+//
+// The snapshot is written at exit to DumpProfileSnapshot, or on demand with
+// the Compiler.profile_snapshot diagnostic command, and read at startup from
+// LoadProfileSnapshot. A snapshot is only loaded by the VM release, and with
+// the CDS archive, that it was written with. It is a text file with one
+// line per method after the header:
+//
+//   <class>.<name><signature> <invocations> <backedges> <highest level>
+//
+// Methods are matched by name when their MethodCounters are created, which
+// seeds the counters. The tiered policy then compiles the method on its next
+// call event, and gathers a fresh profile for C2 as usual.
+class ProfileSnapshot : AllStatic {
+ public:
+  // Reads LoadProfileSnapshot, if set.
+  static void initialize();
+
+  // Writes the counters of all compiled methods to path. Returns false and
+  // prints a message to st if the file could not be written.
+  static bool dump(const char* path, outputStream* st);
+  static void dump_at_exit();
+
+  // Seeds newly created counters of m from the loaded snapshot.
+  static void apply(Method* m, MethodCounters* counters);
+};
+
+#endif // SHARE_COMPILER_PROFILESNAPSHOT_HPP
@@ -63,6 +63,7 @@ public:
   }
 
   WorkGang* workers() const { return _workers; }
+  virtual WorkGang* get_safepoint_workers() { return _workers; }
 
   virtual void print_gc_threads_on(outputStream* st) const;
   virtual void gc_threads_do(ThreadClosure* tc) const;
@@ -22,15 +22,49 @@
  */
 
 #include "precompiled.hpp"
+#include "aot/aotLoader.hpp"
+#include "classfile/classLoaderDataGraph.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "code/codeCache.hpp"
+#include "compiler/oopMap.hpp"
 #include "gc/epsilon/epsilonHeap.hpp"
 #include "gc/epsilon/epsilonMemoryPool.hpp"
 #include "gc/epsilon/epsilonThreadLocalData.hpp"
 #include "gc/shared/gcArguments.hpp"
+#include "gc/shared/gcId.hpp"
+#include "gc/shared/gcTraceTime.inline.hpp"
+#include "gc/shared/gcVMOperations.hpp"
+#include "gc/shared/markBitMap.inline.hpp"
+#include "gc/shared/preservedMarks.inline.hpp"
+#include "gc/shared/strongRootsScope.hpp"
+#include "gc/shared/weakProcessor.hpp"
 #include "memory/allocation.hpp"
 #include "memory/allocation.inline.hpp"
+#include "memory/iterator.inline.hpp"
+#include "memory/padded.inline.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
+#include "oops/access.inline.hpp"
+#include "oops/compressedOops.inline.hpp"
+#include "oops/markOop.inline.hpp"
+#include "oops/oop.inline.hpp"
+#include "prims/jvmtiExport.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/biasedLocking.hpp"
 #include "runtime/globals.hpp"
+#include "runtime/java.hpp"
+#include "runtime/jniHandles.hpp"
+#include "runtime/synchronizer.hpp"
+#include "runtime/thread.hpp"
+#include "runtime/vmThread.hpp"
+#include "services/management.hpp"
+#include "services/memTracker.hpp"
+#include "services/memoryService.hpp"
+#include "utilities/copy.hpp"
+#include "utilities/stack.inline.hpp"
+#if INCLUDE_JVMCI
+#include "jvmci/jvmci.hpp"
+#endif
 
 jint EpsilonHeap::initialize() {
   size_t align = HeapAlignment;
@@ -60,6 +94,30 @@ jint EpsilonHeap::initialize() {
   _last_counter_update = 0;
   _last_heap_print = 0;
 
+  // Allocation stripes, if enabled
+  if (UseTLAB && EpsilonAllocChunkSize > 0) {
+    _num_stripes = (uint) MAX2(1, MIN2(os::processor_count(), 64));
+    // Chunk and TLAB sizes are kept in min_fill_size() units, so that
+    // the leftover tail of a chunk can always be filled with a dummy object
+    _stripe_chunk_size = align_up(MAX2(EpsilonAllocChunkSize / HeapWordSize, _max_tlab_size),
+                                  CollectedHeap::min_fill_size());
+    _stripes = PaddedArray<EpsilonAllocStripe, mtGC>::create_unfreeable(_num_stripes);
+  }
+
+  // Marking bitmap for sliding GC, if enabled. It is only committed
+  // for the duration of the collection.
+  if (EpsilonSlidingGC) {
+    size_t bitmap_page_size = os::vm_page_size();
+    size_t bitmap_size = align_up(MarkBitMap::compute_size(heap_rs.size()), bitmap_page_size);
+    ReservedSpace bitmap(bitmap_size, bitmap_page_size);
+    if (!bitmap.is_reserved()) {
+      vm_exit_during_initialization("Could not reserve space for Epsilon marking bitmap");
+    }
+    MemTracker::record_virtual_memory_type(bitmap.base(), mtGC);
+    _bitmap_region = MemRegion((HeapWord*) bitmap.base(), bitmap.size() / HeapWordSize);
+    _bitmap.initialize(reserved_region, _bitmap_region);
+  }
+
   // Install barrier set
   BarrierSet::set_barrier_set(new EpsilonBarrierSet());
 
@@ -79,10 +137,18 @@ jint EpsilonHeap::initialize() {
     if (EpsilonElasticTLABDecay) {
       log_info(gc)("Elastic TLABs decay enabled; decay time: " SIZE_FORMAT "ms", EpsilonTLABDecayTime);
     }
+    if (_stripes != NULL) {
+      log_info(gc)("Allocation stripes enabled; stripes: %u, chunk: " SIZE_FORMAT "K",
+                   _num_stripes, _stripe_chunk_size * HeapWordSize / K);
+    }
   } else {
     log_info(gc)("Not using TLAB allocation");
   }
 
+  if (EpsilonSlidingGC) {
+    log_info(gc)("Sliding GC enabled on explicit GC requests");
+  }
+
   return JNI_OK;
 }
 
@@ -239,7 +305,13 @@ HeapWord* EpsilonHeap::allocate_new_tlab(size_t min_size,
   }
 
   // All prepared, let's do it!
-  HeapWord* res = allocate_work(size);
+  HeapWord* res = NULL;
+  if (_stripes != NULL) {
+    res = allocate_from_stripe(thread, min_size, size, &size);
+  }
+  if (res == NULL) {
+    res = allocate_work(size);
+  }
 
   if (res != NULL) {
     // Allocation successful
@@ -261,6 +333,85 @@ HeapWord* EpsilonHeap::allocate_new_tlab(size_t min_size,
   return res;
 }
 
+HeapWord* EpsilonHeap::allocate_from_stripe(Thread* thread, size_t min_size, size_t size, size_t* actual_size) {
+  // Carve in min_fill_size() units, so that chunk tails stay fillable. Shrinking
+  // the request is fine as long as it still honors min_size, otherwise let the
+  // caller take it from the shared space.
+  size_t words = align_down(size, CollectedHeap::min_fill_size());
+  if (words < min_size || words > _stripe_chunk_size) {
+    return NULL;
+  }
+
+  uint idx = EpsilonThreadLocalData::alloc_stripe(thread);
+  if (idx >= _num_stripes) {
+    idx = Atomic::add(1u, &_next_stripe) % _num_stripes;
+    EpsilonThreadLocalData::set_alloc_stripe(thread, idx);
+  }
+  EpsilonAllocStripe* stripe = &_stripes[idx];
+
+  HeapWord* chunk = NULL;
+  while (true) {
+    Thread::SpinAcquire(&stripe->_lock, "EpsilonAllocStripe");
+    if (chunk != NULL) {
+      // Install the chunk we got on previous iteration. Somebody else might
+      // have refilled the stripe meanwhile: that is fine, their chunk is
+      // retired the same way an exhausted one is.
+      retire_stripe(stripe);
+      stripe->_top = chunk;
+      stripe->_end = chunk + _stripe_chunk_size;
+    }
+    HeapWord* top = stripe->_top;
+    if (top != NULL && pointer_delta(stripe->_end, top) >= words) {
+      stripe->_top = top + words;
+      Thread::SpinRelease(&stripe->_lock);
+      *actual_size = words;
+      return top;
+    }
+    Thread::SpinRelease(&stripe->_lock);
+
+    // Stripe is exhausted. Get the new chunk without holding the lock:
+    // heap expansion takes Heap_lock, and may block for safepoint.
+    assert(chunk == NULL, "Fresh chunk should fit the request");
+    chunk = allocate_work(_stripe_chunk_size);
+    if (chunk == NULL) {
+      return NULL;
+    }
+  }
+}
+
+void EpsilonHeap::retire_stripe(EpsilonAllocStripe* stripe) {
+  HeapWord* top = stripe->_top;
+  HeapWord* end = stripe->_end;
+  if (top != NULL && top < end) {
+    fill_with_objects(top, pointer_delta(end, top));
+  }
+  stripe->_top = NULL;
+  stripe->_end = NULL;
+}
+
+void EpsilonHeap::ensure_parsability(bool retire_tlabs) {
+  CollectedHeap::ensure_parsability(retire_tlabs);
+
+  // Unused chunk tails are not parsable. Retire them all, stripes would
+  // pick up the new chunks on next allocation.
+  for (uint i = 0; i < _num_stripes; i++) {
+    retire_stripe(&_stripes[i]);
+  }
+}
+
+oop EpsilonHeap::pin_object(JavaThread* thread, oop obj) {
+  if (EpsilonSlidingGC) {
+    Atomic::inc(&_pinned_objects);
+  }
+  return obj;
+}
+
+void EpsilonHeap::unpin_object(JavaThread* thread, oop obj) {
+  if (EpsilonSlidingGC) {
+    Atomic::dec(&_pinned_objects);
+  }
+}
+
 HeapWord* EpsilonHeap::mem_allocate(size_t size, bool *gc_overhead_limit_was_exceeded) {
   *gc_overhead_limit_was_exceeded = false;
   return allocate_work(size);
@@ -280,7 +431,15 @@ void EpsilonHeap::collect(GCCause::Cause cause) {
       print_metaspace_info();
       break;
     default:
-      log_info(gc)("GC request for \"%s\" is ignored", GCCause::to_string(cause));
+      if (EpsilonSlidingGC && GCCause::is_user_requested_gc(cause)) {
+        if (SafepointSynchronize::is_at_safepoint()) {
+          entry_collect(cause);
+        } else {
+          vmentry_collect(cause);
+        }
+      } else {
+        log_info(gc)("GC request for \"%s\" is ignored", GCCause::to_string(cause));
+      }
   }
   _monitoring_support->update_counters();
 }
@@ -344,3 +503,260 @@ void EpsilonHeap::print_metaspace_info() const {
     log_info(gc, metaspace)("Metaspace: no reliable data");
   }
 }
+
+// ------------------ SLIDING GC -----------------------
+//
+// Simple single-threaded stop-the-world mark-compact, done on explicit
+// GC requests only. Everything reachable from roots, including the weak
+// ones, is treated as live, so this never unloads classes or clears
+// references. Objects are slid to the bottom of the heap in LISP2 style:
+// mark, compute new addresses, adjust references, move.
+
+class VM_EpsilonCollect: public VM_GC_Operation {
+public:
+  VM_EpsilonCollect(uint gc_count_before, uint full_gc_count_before, GCCause::Cause cause) :
+          VM_GC_Operation(gc_count_before, cause, full_gc_count_before, true /* full */) {}
+
+  VM_Operation::VMOp_Type type() const { return VMOp_EpsilonCollect; }
+  const char* name()             const { return "Epsilon Collection"; }
+
+  virtual void doit() {
+    SvcGCMarker sgcm(SvcGCMarker::FULL);
+    EpsilonHeap* heap = EpsilonHeap::heap();
+    GCCauseSetter gccs(heap, _gc_cause);
+    heap->entry_collect(_gc_cause);
+  }
+};
+
+void EpsilonHeap::vmentry_collect(GCCause::Cause cause) {
+  uint gc_count_before;
+  uint full_gc_count_before;
+  {
+    MutexLocker ml(Heap_lock);
+    gc_count_before = total_collections();
+    full_gc_count_before = total_full_collections();
+  }
+  VM_EpsilonCollect vmop(gc_count_before, full_gc_count_before, cause);
+  VMThread::execute(&vmop);
+}
+
+typedef Stack<oop, mtGC> EpsilonMarkStack;
+
+class EpsilonScanOopClosure : public BasicOopIterateClosure {
+private:
+  EpsilonMarkStack* const _stack;
+  MarkBitMap* const _bitmap;
+
+  template <class T>
+  void do_oop_work(T* p) {
+    T o = RawAccess<>::oop_load(p);
+    if (!CompressedOops::is_null(o)) {
+      oop obj = CompressedOops::decode_not_null(o);
+      if (!_bitmap->is_marked(obj)) {
+        _bitmap->mark((HeapWord*) obj);
+        _stack->push(obj);
+      }
+    }
+  }
+
+public:
+  EpsilonScanOopClosure(EpsilonMarkStack* stack, MarkBitMap* bitmap) :
+          _stack(stack), _bitmap(bitmap) {}
+  virtual void do_oop(oop* p)       { do_oop_work(p); }
+  virtual void do_oop(narrowOop* p) { do_oop_work(p); }
+};
+
+class EpsilonCalcNewLocationObjectClosure : public ObjectClosure {
+private:
+  HeapWord* _compact_point;
+  PreservedMarks* const _preserved_marks;
+
+public:
+  EpsilonCalcNewLocationObjectClosure(HeapWord* start, PreservedMarks* pm) :
+          _compact_point(start), _preserved_marks(pm) {}
+
+  void do_object(oop obj) {
+    if ((HeapWord*) obj != _compact_point) {
+      // Object moves: save the mark if it carries anything interesting,
+      // and install the forwarding pointer over it.
+      _preserved_marks->push_if_necessary(obj, obj->mark_raw());
+      obj->forward_to(oop(_compact_point));
+    }
+    _compact_point += obj->size();
+  }
+
+  HeapWord* compact_point() {
+    return _compact_point;
+  }
+};
+
+class EpsilonAdjustPointersOopClosure : public BasicOopIterateClosure {
+private:
+  template <class T>
+  void do_oop_work(T* p) {
+    T o = RawAccess<>::oop_load(p);
+    if (!CompressedOops::is_null(o)) {
+      oop obj = CompressedOops::decode_not_null(o);
+      if (obj->is_forwarded()) {
+        RawAccess<IS_NOT_NULL>::oop_store(p, obj->forwardee());
+      }
+    }
+  }
+
+public:
+  virtual void do_oop(oop* p)       { do_oop_work(p); }
+  virtual void do_oop(narrowOop* p) { do_oop_work(p); }
+};
+
+class EpsilonAdjustPointersObjectClosure : public ObjectClosure {
+private:
+  EpsilonAdjustPointersOopClosure _cl;
+public:
+  void do_object(oop obj) {
+    obj->oop_iterate(&_cl);
+  }
+};
+
+class EpsilonMoveObjectsObjectClosure : public ObjectClosure {
+public:
+  void do_object(oop obj) {
+    if (obj->is_forwarded()) {
+      oop fwd = obj->forwardee();
+      // New location is always below the old one, and all objects below
+      // had already been moved, so overlapping copy is safe here.
+      Copy::aligned_conjoint_words((HeapWord*) obj, (HeapWord*) fwd, obj->size());
+      fwd->init_mark_raw();
+    }
+  }
+};
+
+void EpsilonHeap::entry_collect(GCCause::Cause cause) {
+  assert(SafepointSynchronize::is_at_safepoint(), "Should be at safepoint");
+  assert(Thread::current()->is_VM_thread(), "Should be in VM thread");
+
+  if (_pinned_objects > 0) {
+    // JNI critical sections hold raw pointers into the heap: we cannot move anything.
+    log_info(gc)("GC request for \"%s\" is skipped: " SIZE_FORMAT " objects are pinned",
+                 GCCause::to_string(cause), _pinned_objects);
+    return;
+  }
+
+  GCIdMark mark;
+  GCTraceTime(Info, gc) time("Pause Full (Epsilon Sliding)", NULL, cause, true);
+  TraceMemoryManagerStats tms(&_memory_manager, cause);
+  increment_total_collections(true /* full */);
+
+  size_t used_before = used();
+
+  // Bitmap is committed only for the duration of GC. Fresh pages come
+  // zeroed, so there is no need to clear it.
+  char* bitmap_base = (char*) _bitmap_region.start();
+  size_t bitmap_size = _bitmap_region.byte_size();
+  if (!os::commit_memory(bitmap_base, bitmap_size, false)) {
+    log_warning(gc)("Could not commit native memory for marking bitmap, GC failed");
+    return;
+  }
+
+  // Make heap parsable, and preserve whatever needs preserving.
+  ensure_parsability(true);
+  BiasedLocking::preserve_marks();
+#if COMPILER2_OR_JVMCI
+  DerivedPointerTable::clear();
+#endif
+
+  {
+    GCTraceTime(Info, gc, phases) time("Phase 1: Mark live objects");
+    EpsilonMarkStack stack;
+    EpsilonScanOopClosure cl(&stack, &_bitmap);
+    process_roots(&cl);
+    while (!stack.is_empty()) {
+      oop obj = stack.pop();
+      obj->oop_iterate(&cl);
+    }
+  }
+
+#if COMPILER2_OR_JVMCI
+  // Roots are walked once more for adjustment, do not record them twice.
+  DerivedPointerTable::set_active(false);
+#endif
+
+  PreservedMarks preserved_marks;
+  HeapWord* new_top;
+  {
+    GCTraceTime(Info, gc, phases) time("Phase 2: Compute new object addresses");
+    EpsilonCalcNewLocationObjectClosure cl(_space->bottom(), &preserved_marks);
+    walk_bitmap(&cl);
+    new_top = cl.compact_point();
+  }
+
+  {
+    GCTraceTime(Info, gc, phases) time("Phase 3: Adjust pointers");
+    EpsilonAdjustPointersObjectClosure cl;
+    walk_bitmap(&cl);
+    EpsilonAdjustPointersOopClosure root_cl;
+    process_roots(&root_cl);
+    preserved_marks.adjust_during_full_gc();
+  }
+
+  {
+    GCTraceTime(Info, gc, phases) time("Phase 4: Move objects");
+    EpsilonMoveObjectsObjectClosure cl;
+    walk_bitmap(&cl);
+    _space->set_top(new_top);
+  }
+
+  preserved_marks.restore();
+#if COMPILER2_OR_JVMCI
+  DerivedPointerTable::update_pointers();
+#endif
+  BiasedLocking::restore_marks();
+
+  if (!os::uncommit_memory(bitmap_base, bitmap_size)) {
+    log_warning(gc)("Could not uncommit native memory for marking bitmap");
+  }
+
+  size_t used_after = used();
+  _last_counter_update = used_after;
+  _last_heap_print = used_after;
+
+  log_info(gc)("Heap: " SIZE_FORMAT "%s -> " SIZE_FORMAT "%s",
+               byte_size_in_proper_unit(used_before), proper_unit_for_byte_size(used_before),
+               byte_size_in_proper_unit(used_after),  proper_unit_for_byte_size(used_after));
+}
+
+void EpsilonHeap::process_roots(OopClosure* cl) {
+  // Need to tell runtime we are about to walk the roots with 1 thread
+  StrongRootsScope scope(1);
+
+  // Need to adapt oop closure for some special root types.
+  CLDToOopClosure clds(cl, ClassLoaderData::_claim_none);
+  MarkingCodeBlobClosure blobs(cl, CodeBlobToOopClosure::FixRelocations);
+
+  // Walk all these different parts of runtime roots. Some roots require
+  // holding the lock when walking them, but at safepoint they are stable.
+  CodeCache::blobs_do(&blobs);
+  ClassLoaderDataGraph::cld_do(&clds);
+  Universe::oops_do(cl);
+  Management::oops_do(cl);
+  JvmtiExport::oops_do(cl);
+  JNIHandles::oops_do(cl);
+  WeakProcessor::oops_do(cl);
+  ObjectSynchronizer::oops_do(cl);
+  SystemDictionary::oops_do(cl);
+  AOT_ONLY(AOTLoader::oops_do(cl);)
+  JVMCI_ONLY(JVMCI::oops_do(cl);)
+  Threads::possibly_parallel_oops_do(false, cl, &blobs);
+}
+
+void EpsilonHeap::walk_bitmap(ObjectClosure* cl) {
+  HeapWord* limit = _space->top();
+  HeapWord* addr = _bitmap.get_next_marked_addr(_space->bottom(), limit);
+  while (addr < limit) {
+    oop obj = oop(addr);
+    assert(_bitmap.is_marked(obj), "sanity");
+    // Read the size before the closure had a chance to move the object
+    HeapWord* next = addr + obj->size();
+    cl->do_object(obj);
+    addr = _bitmap.get_next_marked_addr(next, limit);
+  }
+}
@@ -25,12 +25,25 @@
 #define SHARE_GC_EPSILON_EPSILONHEAP_HPP
 
 #include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/markBitMap.hpp"
 #include "gc/shared/softRefPolicy.hpp"
 #include "gc/shared/space.hpp"
 #include "gc/epsilon/epsilonMonitoringSupport.hpp"
 #include "gc/epsilon/epsilonBarrierSet.hpp"
+#include "memory/padded.hpp"
 #include "services/memoryManager.hpp"
 
+// A chunk of heap that a subset of threads carve their TLABs from,
+// so that TLAB refills do not all race on the shared space top.
+class EpsilonAllocStripe {
+public:
+  volatile int _lock;
+  HeapWord* _top;
+  HeapWord* _end;
+
+  EpsilonAllocStripe() : _lock(0), _top(NULL), _end(NULL) {}
+};
+
 class EpsilonHeap : public CollectedHeap {
   friend class VMStructs;
 private:
@@ -46,12 +59,24 @@ private:
   int64_t _decay_time_ns;
   volatile size_t _last_counter_update;
   volatile size_t _last_heap_print;
+  PaddedEnd<EpsilonAllocStripe>* _stripes;
+  uint _num_stripes;
+  volatile uint _next_stripe;
+  size_t _stripe_chunk_size;
+  MemRegion _bitmap_region;
+  MarkBitMap _bitmap;
+  volatile size_t _pinned_objects;
 
 public:
   static EpsilonHeap* heap();
 
   EpsilonHeap() :
-          _memory_manager("Epsilon Heap", "") {};
+          _memory_manager("Epsilon Heap", ""),
+          _stripes(NULL),
+          _num_stripes(0),
+          _next_stripe(0),
+          _stripe_chunk_size(0),
+          _pinned_objects(0) {};
 
   virtual Name kind() const {
     return CollectedHeap::Epsilon;
@@ -102,16 +127,22 @@ public:
   virtual void collect(GCCause::Cause cause);
   virtual void do_full_collection(bool clear_all_soft_refs);
 
+  // Sliding mark-compact, see EpsilonSlidingGC
+  void entry_collect(GCCause::Cause cause);
+
+  virtual void ensure_parsability(bool retire_tlabs);
+
   // Heap walking support
   virtual void safe_object_iterate(ObjectClosure* cl);
   virtual void object_iterate(ObjectClosure* cl) {
     safe_object_iterate(cl);
   }
 
-  // Object pinning support: every object is implicitly pinned
+  // Object pinning support: every object is implicitly pinned, only
+  // the sliding GC needs to know whether any are in use
   virtual bool supports_object_pinning() const           { return true; }
-  virtual oop pin_object(JavaThread* thread, oop obj)    { return obj; }
-  virtual void unpin_object(JavaThread* thread, oop obj) { }
+  virtual oop pin_object(JavaThread* thread, oop obj);
+  virtual void unpin_object(JavaThread* thread, oop obj);
 
   // No support for block parsing.
   virtual HeapWord* block_start(const void* addr) const { return NULL;  }
@@ -140,6 +171,13 @@ public:
   virtual void print_tracing_info() const;
 
 private:
+  HeapWord* allocate_from_stripe(Thread* thread, size_t min_size, size_t size, size_t* actual_size);
+  void retire_stripe(EpsilonAllocStripe* stripe);
+
+  void vmentry_collect(GCCause::Cause cause);
+  void process_roots(OopClosure* cl);
+  void walk_bitmap(ObjectClosure* cl);
+
   void print_heap_info(size_t used) const;
   void print_metaspace_info() const;
 
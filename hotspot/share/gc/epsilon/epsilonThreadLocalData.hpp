@@ -31,10 +31,12 @@ class EpsilonThreadLocalData {
 private:
   size_t _ergo_tlab_size;
   int64_t _last_tlab_time;
+  uint _alloc_stripe;
 
   EpsilonThreadLocalData() :
           _ergo_tlab_size(0),
-          _last_tlab_time(0) {}
+          _last_tlab_time(0),
+          _alloc_stripe(max_juint) {}
 
   static EpsilonThreadLocalData* data(Thread* thread) {
     assert(UseEpsilonGC, "Sanity");
@@ -65,6 +67,14 @@ public:
   static void set_last_tlab_time(Thread *thread, int64_t time) {
     data(thread)->_last_tlab_time = time;
   }
+
+  static uint alloc_stripe(Thread *thread) {
+    return data(thread)->_alloc_stripe;
+  }
+
+  static void set_alloc_stripe(Thread *thread, uint stripe) {
+    data(thread)->_alloc_stripe = stripe;
+  }
 };
 
 #endif // SHARE_GC_EPSILON_EPSILONTHREADLOCALDATA_HPP
@@ -92,6 +92,19 @@
   experimental(size_t, EpsilonMinHeapExpand, 128 * M,                       \
           "Min expansion step for heap. Larger value improves performance " \
           "at the potential expense of memory waste.")                      \
-          range(1, max_intx)
+          range(1, max_intx)                                                \
+                                                                            \
+  experimental(size_t, EpsilonAllocChunkSize, 0,                            \
+          "Carve TLABs out of chunks of this size, one chunk per "          \
+          "allocation stripe that threads are spread over, instead of "     \
+          "taking every TLAB from the shared heap top. Reduces contention " \
+          "between many allocating threads at the expense of up to this "   \
+          "much unused memory per stripe. 0 disables the stripes.")         \
+          range(0, max_intx)                                                \
+                                                                            \
+  experimental(bool, EpsilonSlidingGC, false,                               \
+          "Slide live objects to the bottom of the heap on explicit GC "    \
+          "requests (System.gc() and the GC.run diagnostic command). "      \
+          "There are still no barriers, and no other collections.")
 
 #endif // SHARE_GC_EPSILON_EPSILON_GLOBALS_HPP
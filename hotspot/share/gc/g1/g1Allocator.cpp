@@ -36,22 +36,57 @@
 
 G1Allocator::G1Allocator(G1CollectedHeap* heap) :
   _g1h(heap),
+  _numa(heap->numa()),
   _survivor_is_full(false),
   _old_is_full(false),
-  _mutator_alloc_region(),
-  _survivor_gc_alloc_region(heap->alloc_buffer_stats(G1HeapRegionAttr::Young)),
+  _num_alloc_regions(_numa->num_active_nodes()),
+  _mutator_alloc_regions(NULL),
+  _survivor_gc_alloc_regions(NULL),
   _old_gc_alloc_region(heap->alloc_buffer_stats(G1HeapRegionAttr::Old)),
   _retained_old_gc_alloc_region(NULL) {
+
+  _mutator_alloc_regions = NEW_C_HEAP_ARRAY(MutatorAllocRegion, _num_alloc_regions, mtGC);
+  _survivor_gc_alloc_regions = NEW_C_HEAP_ARRAY(SurvivorGCAllocRegion, _num_alloc_regions, mtGC);
+  G1EvacStats* stat = heap->alloc_buffer_stats(G1HeapRegionAttr::Young);
+
+  for (uint i = 0; i < _num_alloc_regions; i++) {
+    ::new(_mutator_alloc_regions + i) MutatorAllocRegion(i);
+    ::new(_survivor_gc_alloc_regions + i) SurvivorGCAllocRegion(stat, i);
+  }
+}
+
+G1Allocator::~G1Allocator() {
+  for (uint i = 0; i < _num_alloc_regions; i++) {
+    _mutator_alloc_regions[i].~MutatorAllocRegion();
+    _survivor_gc_alloc_regions[i].~SurvivorGCAllocRegion();
+  }
+  FREE_C_HEAP_ARRAY(MutatorAllocRegion, _mutator_alloc_regions);
+  FREE_C_HEAP_ARRAY(SurvivorGCAllocRegion, _survivor_gc_alloc_regions);
 }
 
+#ifdef ASSERT
+bool G1Allocator::has_mutator_alloc_region() {
+  for (uint i = 0; i < _num_alloc_regions; i++) {
+    if (mutator_alloc_region(i)->get() != NULL) {
+      return true;
+    }
+  }
+  return false;
+}
+#endif
+
 void G1Allocator::init_mutator_alloc_region() {
-  assert(_mutator_alloc_region.get() == NULL, "pre-condition");
-  _mutator_alloc_region.init();
+  for (uint i = 0; i < _num_alloc_regions; i++) {
+    assert(mutator_alloc_region(i)->get() == NULL, "pre-condition");
+    mutator_alloc_region(i)->init();
+  }
 }
 
 void G1Allocator::release_mutator_alloc_region() {
-  _mutator_alloc_region.release();
-  assert(_mutator_alloc_region.get() == NULL, "post-condition");
+  for (uint i = 0; i < _num_alloc_regions; i++) {
+    mutator_alloc_region(i)->release();
+    assert(mutator_alloc_region(i)->get() == NULL, "post-condition");
+  }
 }
 
 bool G1Allocator::is_retained_old_region(HeapRegion* hr) {
@@ -97,7 +132,9 @@ void G1Allocator::init_gc_alloc_regions(G1EvacuationInfo& evacuation_info) {
   _survivor_is_full = false;
   _old_is_full = false;
 
-  _survivor_gc_alloc_region.init();
+  for (uint i = 0; i < _num_alloc_regions; i++) {
+    survivor_gc_alloc_region(i)->init();
+  }
   _old_gc_alloc_region.init();
   reuse_retained_old_region(evacuation_info,
                             &_old_gc_alloc_region,
@@ -105,9 +142,13 @@ void G1Allocator::init_gc_alloc_regions(G1EvacuationInfo& evacuation_info) {
 }
 
 void G1Allocator::release_gc_alloc_regions(G1EvacuationInfo& evacuation_info) {
-  evacuation_info.set_allocation_regions(survivor_gc_alloc_region()->count() +
+  uint survivor_region_count = 0;
+  for (uint i = 0; i < _num_alloc_regions; i++) {
+    survivor_region_count += survivor_gc_alloc_region(i)->count();
+    survivor_gc_alloc_region(i)->release();
+  }
+  evacuation_info.set_allocation_regions(survivor_region_count +
                                          old_gc_alloc_region()->count());
-  survivor_gc_alloc_region()->release();
   // If we have an old GC alloc region to release, we'll save it in
   // _retained_old_gc_alloc_region. If we don't
   // _retained_old_gc_alloc_region will become NULL. This is what we
@@ -117,7 +158,9 @@ void G1Allocator::release_gc_alloc_regions(G1EvacuationInfo& evacuation_info) {
 }
 
 void G1Allocator::abandon_gc_alloc_regions() {
-  assert(survivor_gc_alloc_region()->get() == NULL, "pre-condition");
+  for (uint i = 0; i < _num_alloc_regions; i++) {
+    assert(survivor_gc_alloc_region(i)->get() == NULL, "pre-condition");
+  }
   assert(old_gc_alloc_region()->get() == NULL, "pre-condition");
   _retained_old_gc_alloc_region = NULL;
 }
@@ -146,7 +189,8 @@ size_t G1Allocator::unsafe_max_tlab_alloc() {
   // since we can't allow tlabs to grow big enough to accommodate
   // humongous objects.
 
-  HeapRegion* hr = mutator_alloc_region()->get();
+  uint node_index = current_node_index();
+  HeapRegion* hr = mutator_alloc_region(node_index)->get();
   size_t max_tlab = _g1h->max_tlab_size() * wordSize;
   if (hr == NULL) {
     return max_tlab;
@@ -157,14 +201,19 @@ size_t G1Allocator::unsafe_max_tlab_alloc() {
 
 size_t G1Allocator::used_in_alloc_regions() {
   assert(Heap_lock->owner() != NULL, "Should be owned on this thread's behalf.");
-  return mutator_alloc_region()->used_in_alloc_regions();
+  size_t used = 0;
+  for (uint i = 0; i < _num_alloc_regions; i++) {
+    used += mutator_alloc_region(i)->used_in_alloc_regions();
+  }
+  return used;
 }
 
 
 HeapWord* G1Allocator::par_allocate_during_gc(G1HeapRegionAttr dest,
-                                              size_t word_size) {
+                                              size_t word_size,
+                                              uint node_index) {
   size_t temp = 0;
-  HeapWord* result = par_allocate_during_gc(dest, word_size, word_size, &temp);
+  HeapWord* result = par_allocate_during_gc(dest, word_size, word_size, &temp, node_index);
   assert(result == NULL || temp == word_size,
          "Requested " SIZE_FORMAT " words, but got " SIZE_FORMAT " at " PTR_FORMAT,
          word_size, temp, p2i(result));
@@ -174,10 +223,11 @@ HeapWord* G1Allocator::par_allocate_during_gc(G1HeapRegionAttr dest,
 HeapWord* G1Allocator::par_allocate_during_gc(G1HeapRegionAttr dest,
                                               size_t min_word_size,
                                               size_t desired_word_size,
-                                              size_t* actual_word_size) {
+                                              size_t* actual_word_size,
+                                              uint node_index) {
   switch (dest.type()) {
     case G1HeapRegionAttr::Young:
-      return survivor_attempt_allocation(min_word_size, desired_word_size, actual_word_size);
+      return survivor_attempt_allocation(min_word_size, desired_word_size, actual_word_size, node_index);
     case G1HeapRegionAttr::Old:
       return old_attempt_allocation(min_word_size, desired_word_size, actual_word_size);
     default:
@@ -188,18 +238,19 @@ HeapWord* G1Allocator::par_allocate_during_gc(G1HeapRegionAttr dest,
 
 HeapWord* G1Allocator::survivor_attempt_allocation(size_t min_word_size,
                                                    size_t desired_word_size,
-                                                   size_t* actual_word_size) {
+                                                   size_t* actual_word_size,
+                                                   uint node_index) {
   assert(!_g1h->is_humongous(desired_word_size),
          "we should not be seeing humongous-size allocations in this path");
 
-  HeapWord* result = survivor_gc_alloc_region()->attempt_allocation(min_word_size,
-                                                                    desired_word_size,
-                                                                    actual_word_size);
+  HeapWord* result = survivor_gc_alloc_region(node_index)->attempt_allocation(min_word_size,
+                                                                              desired_word_size,
+                                                                              actual_word_size);
   if (result == NULL && !survivor_is_full()) {
     MutexLocker x(FreeList_lock, Mutex::_no_safepoint_check_flag);
-    result = survivor_gc_alloc_region()->attempt_allocation_locked(min_word_size,
-                                                                   desired_word_size,
-                                                                   actual_word_size);
+    result = survivor_gc_alloc_region(node_index)->attempt_allocation_locked(min_word_size,
+                                                                             desired_word_size,
+                                                                             actual_word_size);
     if (result == NULL) {
       set_survivor_full();
     }
@@ -248,38 +299,79 @@ G1PLABAllocator::G1PLABAllocator(G1Allocator* allocator) :
   _allocator(allocator),
   _surviving_alloc_buffer(_g1h->desired_plab_sz(G1HeapRegionAttr::Young)),
   _tenured_alloc_buffer(_g1h->desired_plab_sz(G1HeapRegionAttr::Old)),
-  _survivor_alignment_bytes(calc_survivor_alignment_bytes()) {
+  _survivor_alignment_bytes(calc_survivor_alignment_bytes()),
+  _node_index(allocator->current_node_index()) {
   for (uint state = 0; state < G1HeapRegionAttr::Num; state++) {
     _direct_allocated[state] = 0;
     _alloc_buffers[state] = NULL;
+    _num_plab_fills[state] = 0;
+    _plab_fill_counter[state] = 0;
+    _cur_desired_plab_size[state] = 0;
   }
   _alloc_buffers[G1HeapRegionAttr::Young] = &_surviving_alloc_buffer;
   _alloc_buffers[G1HeapRegionAttr::Old]  = &_tenured_alloc_buffer;
+
+  if (ResizePLAB) {
+    // The global PLAB size is chosen so that a worker is expected to fill about
+    // G1LastPLABAverageOccupancy / TargetPLABWastePct PLABs. Tolerate some more
+    // refills than that before increasing the size; limits on the PLAB size and
+    // region ends cause additional refills in any case.
+    double const expected_refills = G1LastPLABAverageOccupancy / TargetPLABWastePct;
+    _tolerated_refills = (size_t)(MAX2(expected_refills, 1.0) * 1.5);
+  } else {
+    _tolerated_refills = SIZE_MAX;
+  }
+  for (uint state = 0; state < G1HeapRegionAttr::Num; state++) {
+    if (_alloc_buffers[state] != NULL) {
+      _cur_desired_plab_size[state] = _alloc_buffers[state]->word_sz();
+      _plab_fill_counter[state] = _tolerated_refills;
+    }
+  }
 }
 
 bool G1PLABAllocator::may_throw_away_buffer(size_t const allocation_word_sz, size_t const buffer_size) const {
   return (allocation_word_sz * 100 < buffer_size * ParallelGCBufferWastePct);
 }
 
+size_t G1PLABAllocator::next_plab_size(G1HeapRegionAttr dest, bool* boosted) const {
+  size_t const cur_size = _cur_desired_plab_size[dest.type()];
+  *boosted = _plab_fill_counter[dest.type()] == 0;
+  if (*boosted) {
+    return _g1h->clamp_plab_size(cur_size * 2);
+  }
+  return cur_size;
+}
+
 HeapWord* G1PLABAllocator::allocate_direct_or_new_plab(G1HeapRegionAttr dest,
                                                        size_t word_sz,
                                                        bool* plab_refill_failed) {
-  size_t plab_word_size = _g1h->desired_plab_sz(dest);
+  bool boosted;
+  size_t plab_word_size = next_plab_size(dest, &boosted);
   size_t required_in_plab = PLAB::size_required_for_allocation(word_sz);
 
   // Only get a new PLAB if the allocation fits and it would not waste more than
-  // ParallelGCBufferWastePct in the existing buffer.
+  // ParallelGCBufferWastePct in the existing buffer. Both limits grow with the
+  // PLAB size of this worker.
   if ((required_in_plab <= plab_word_size) &&
     may_throw_away_buffer(required_in_plab, plab_word_size)) {
 
     PLAB* alloc_buf = alloc_buffer(dest);
     alloc_buf->retire();
 
+    _num_plab_fills[dest.type()]++;
+    if (boosted) {
+      _cur_desired_plab_size[dest.type()] = plab_word_size;
+      _plab_fill_counter[dest.type()] = _tolerated_refills;
+    } else {
+      _plab_fill_counter[dest.type()]--;
+    }
+
     size_t actual_plab_size = 0;
     HeapWord* buf = _allocator->par_allocate_during_gc(dest,
                                                        required_in_plab,
                                                        plab_word_size,
-                                                       &actual_plab_size);
+                                                       &actual_plab_size,
+                                                       _node_index);
 
     assert(buf == NULL || ((actual_plab_size >= required_in_plab) && (actual_plab_size <= plab_word_size)),
            "Requested at minimum " SIZE_FORMAT ", desired " SIZE_FORMAT " words, but got " SIZE_FORMAT " at " PTR_FORMAT,
@@ -298,7 +390,7 @@ HeapWord* G1PLABAllocator::allocate_direct_or_new_plab(G1HeapRegionAttr dest,
     *plab_refill_failed = true;
   }
   // Try direct allocation.
-  HeapWord* result = _allocator->par_allocate_during_gc(dest, word_sz);
+  HeapWord* result = _allocator->par_allocate_during_gc(dest, word_sz, _node_index);
   if (result != NULL) {
     _direct_allocated[dest.type()] += word_sz;
   }
@@ -316,11 +408,29 @@ void G1PLABAllocator::flush_and_retire_stats() {
       G1EvacStats* stats = _g1h->alloc_buffer_stats(state);
       buf->flush_and_retire_stats(stats);
       stats->add_direct_allocated(_direct_allocated[state]);
+      stats->add_num_plab_filled(_num_plab_fills[state]);
       _direct_allocated[state] = 0;
+      _num_plab_fills[state] = 0;
     }
   }
 }
 
+size_t G1PLABAllocator::plab_fills() const {
+  size_t result = 0;
+  for (uint state = 0; state < G1HeapRegionAttr::Num; state++) {
+    result += _num_plab_fills[state];
+  }
+  return result;
+}
+
+size_t G1PLABAllocator::direct_allocated() const {
+  size_t result = 0;
+  for (uint state = 0; state < G1HeapRegionAttr::Num; state++) {
+    result += _direct_allocated[state];
+  }
+  return result;
+}
+
 size_t G1PLABAllocator::waste() const {
   size_t result = 0;
   for (uint state = 0; state < G1HeapRegionAttr::Num; state++) {
@@ -40,16 +40,21 @@ class G1Allocator : public CHeapObj<mtGC> {
 
 private:
   G1CollectedHeap* _g1h;
+  G1NUMA* _numa;
 
   bool _survivor_is_full;
   bool _old_is_full;
 
-  // Alloc region used to satisfy mutator allocation requests.
-  MutatorAllocRegion _mutator_alloc_region;
+  // The number of mutator and survivor alloc regions, one per NUMA node.
+  uint _num_alloc_regions;
 
-  // Alloc region used to satisfy allocation requests by the GC for
-  // survivor objects.
-  SurvivorGCAllocRegion _survivor_gc_alloc_region;
+  // Alloc regions used to satisfy mutator allocation requests, indexed
+  // by the NUMA node index of the allocating thread.
+  MutatorAllocRegion* _mutator_alloc_regions;
+
+  // Alloc regions used to satisfy allocation requests by the GC for
+  // survivor objects, indexed by the NUMA node index of the GC worker.
+  SurvivorGCAllocRegion* _survivor_gc_alloc_regions;
 
   // Alloc region used to satisfy allocation requests by the GC for
   // old objects.
@@ -68,14 +73,15 @@ private:
                                  HeapRegion** retained);
 
   // Accessors to the allocation regions.
-  inline MutatorAllocRegion* mutator_alloc_region();
-  inline SurvivorGCAllocRegion* survivor_gc_alloc_region();
+  inline MutatorAllocRegion* mutator_alloc_region(uint node_index);
+  inline SurvivorGCAllocRegion* survivor_gc_alloc_region(uint node_index);
   inline OldGCAllocRegion* old_gc_alloc_region();
 
   // Allocation attempt during GC for a survivor object / PLAB.
   HeapWord* survivor_attempt_allocation(size_t min_word_size,
-                                               size_t desired_word_size,
-                                               size_t* actual_word_size);
+                                        size_t desired_word_size,
+                                        size_t* actual_word_size,
+                                        uint node_index);
 
   // Allocation attempt during GC for an old object / PLAB.
   HeapWord* old_attempt_allocation(size_t min_word_size,
@@ -83,10 +89,16 @@ private:
                                           size_t* actual_word_size);
 public:
   G1Allocator(G1CollectedHeap* heap);
+  ~G1Allocator();
+
+  uint num_nodes() { return _num_alloc_regions; }
+
+  // Node index of the NUMA node the current thread runs on.
+  uint current_node_index() const;
 
 #ifdef ASSERT
   // Do we currently have an active mutator region to allocate into?
-  bool has_mutator_alloc_region() { return mutator_alloc_region()->get() != NULL; }
+  bool has_mutator_alloc_region();
 #endif
 
   void init_mutator_alloc_region();
@@ -112,13 +124,16 @@ public:
   // allocation region, either by picking one or expanding the
   // heap, and then allocate a block of the given size. The block
   // may not be a humongous - it must fit into a single heap region.
+  // Survivor space is allocated on the NUMA node with the given index.
   HeapWord* par_allocate_during_gc(G1HeapRegionAttr dest,
-                                   size_t word_size);
+                                   size_t word_size,
+                                   uint node_index);
 
   HeapWord* par_allocate_during_gc(G1HeapRegionAttr dest,
                                    size_t min_word_size,
                                    size_t desired_word_size,
-                                   size_t* actual_word_size);
+                                   size_t* actual_word_size,
+                                   uint node_index);
 };
 
 // Manages the PLABs used during garbage collection. Interface for allocation from PLABs.
@@ -144,6 +159,22 @@ private:
   // Number of words allocated directly (not counting PLAB allocation).
   size_t _direct_allocated[G1HeapRegionAttr::Num];
 
+  // Per-destination PLAB sizing of this worker. Every worker starts out with the
+  // PLAB size derived from the global statistics, and doubles it whenever it
+  // refilled its PLAB more often than expected. This keeps workers that copy
+  // most of the objects from refilling all the time, without increasing the
+  // tail waste of the other workers.
+  size_t _num_plab_fills[G1HeapRegionAttr::Num];
+  size_t _plab_fill_counter[G1HeapRegionAttr::Num];
+  size_t _cur_desired_plab_size[G1HeapRegionAttr::Num];
+
+  // Number of PLAB refills after which the PLAB size is increased.
+  size_t _tolerated_refills;
+
+  // NUMA node index of the GC worker owning this allocator. New survivor
+  // PLABs are carved out of survivor regions on this node.
+  uint _node_index;
+
   void flush_and_retire_stats();
   inline PLAB* alloc_buffer(G1HeapRegionAttr dest);
 
@@ -152,11 +183,19 @@ private:
   static uint calc_survivor_alignment_bytes();
 
   bool may_throw_away_buffer(size_t const allocation_word_sz, size_t const buffer_size) const;
+
+  // Returns the PLAB size to use for the next refill for dest, and whether it
+  // has been increased.
+  size_t next_plab_size(G1HeapRegionAttr dest, bool* boosted) const;
 public:
   G1PLABAllocator(G1Allocator* allocator);
 
   size_t waste() const;
   size_t undo_waste() const;
+  // Number of PLAB refills and number of words allocated directly since the
+  // last flush_and_retire_stats().
+  size_t plab_fills() const;
+  size_t direct_allocated() const;
 
   // Allocate word_sz words in dest, either directly into the regions or by
   // allocating a new PLAB. Returns the address of the allocated memory, NULL if
@@ -55,6 +55,10 @@ static double cost_per_byte_ms_defaults[] = {
   0.00006, 0.00003, 0.00003, 0.000015, 0.000015, 0.00001, 0.00001, 0.000009
 };
 
+static double cost_per_code_root_ms_defaults[] = {
+  0.002, 0.001, 0.001, 0.0008, 0.0008, 0.0006, 0.0006, 0.0005
+};
+
 // these should be pretty consistent
 static double constant_other_time_ms_defaults[] = {
   5.0, 5.0, 5.0, 5.0, 5.0, 5.0, 5.0, 5.0
@@ -84,6 +88,9 @@ G1Analytics::G1Analytics(const G1Predictions* predictor) :
     _cost_per_entry_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
     _mixed_cost_per_entry_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
     _cost_per_byte_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
+    _cost_per_code_root_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
+    _root_scan_time_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
+    _ref_proc_time_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
     _constant_other_time_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
     _young_other_cost_per_region_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
     _non_young_other_cost_per_region_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
@@ -106,6 +113,9 @@ G1Analytics::G1Analytics(const G1Predictions* predictor) :
   _young_cards_per_entry_ratio_seq->add(young_cards_per_entry_ratio_defaults[index]);
   _cost_per_entry_ms_seq->add(cost_per_entry_ms_defaults[index]);
   _cost_per_byte_ms_seq->add(cost_per_byte_ms_defaults[index]);
+  _cost_per_code_root_ms_seq->add(cost_per_code_root_ms_defaults[index]);
+  _root_scan_time_ms_seq->add(0.0);
+  _ref_proc_time_ms_seq->add(0.0);
   _constant_other_time_ms_seq->add(constant_other_time_ms_defaults[index]);
   _young_other_cost_per_region_ms_seq->add(young_other_cost_per_region_ms_defaults[index]);
   _non_young_other_cost_per_region_ms_seq->add(non_young_other_cost_per_region_ms_defaults[index]);
@@ -194,6 +204,18 @@ void G1Analytics::report_cost_per_byte_ms(double cost_per_byte_ms, bool mark_or_
   }
 }
 
+void G1Analytics::report_cost_per_code_root_ms(double cost_per_code_root_ms) {
+  _cost_per_code_root_ms_seq->add(cost_per_code_root_ms);
+}
+
+void G1Analytics::report_root_scan_time_ms(double root_scan_time_ms) {
+  _root_scan_time_ms_seq->add(root_scan_time_ms);
+}
+
+void G1Analytics::report_ref_proc_time_ms(double ref_proc_time_ms) {
+  _ref_proc_time_ms_seq->add(ref_proc_time_ms);
+}
+
 void G1Analytics::report_young_other_cost_per_region_ms(double other_cost_per_region_ms) {
   _young_other_cost_per_region_ms_seq->add(other_cost_per_region_ms);
 }
@@ -290,6 +312,18 @@ double G1Analytics::predict_cost_per_byte_ms() const {
   return get_new_prediction(_cost_per_byte_ms_seq);
 }
 
+double G1Analytics::predict_code_root_scan_time_ms(size_t code_root_num) const {
+  return code_root_num * get_new_prediction(_cost_per_code_root_ms_seq);
+}
+
+double G1Analytics::predict_root_scan_time_ms() const {
+  return get_new_prediction(_root_scan_time_ms_seq);
+}
+
+double G1Analytics::predict_ref_proc_time_ms() const {
+  return get_new_prediction(_ref_proc_time_ms_seq);
+}
+
 double G1Analytics::predict_constant_other_time_ms() const {
   return get_new_prediction(_constant_other_time_ms_seq);
 }
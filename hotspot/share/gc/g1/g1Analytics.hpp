@@ -53,6 +53,9 @@ class G1Analytics: public CHeapObj<mtGC> {
   TruncatedSeq* _cost_per_entry_ms_seq;
   TruncatedSeq* _mixed_cost_per_entry_ms_seq;
   TruncatedSeq* _cost_per_byte_ms_seq;
+  TruncatedSeq* _cost_per_code_root_ms_seq;
+  TruncatedSeq* _root_scan_time_ms_seq;
+  TruncatedSeq* _ref_proc_time_ms_seq;
   TruncatedSeq* _constant_other_time_ms_seq;
   TruncatedSeq* _young_other_cost_per_region_ms_seq;
   TruncatedSeq* _non_young_other_cost_per_region_ms_seq;
@@ -105,6 +108,9 @@ public:
   void report_cards_per_entry_ratio(double cards_per_entry_ratio, bool for_young_gc);
   void report_rs_length_diff(double rs_length_diff);
   void report_cost_per_byte_ms(double cost_per_byte_ms, bool mark_or_rebuild_in_progress);
+  void report_cost_per_code_root_ms(double cost_per_code_root_ms);
+  void report_root_scan_time_ms(double root_scan_time_ms);
+  void report_ref_proc_time_ms(double ref_proc_time_ms);
   void report_young_other_cost_per_region_ms(double other_cost_per_region_ms);
   void report_non_young_other_cost_per_region_ms(double other_cost_per_region_ms);
   void report_constant_other_time_ms(double constant_other_time_ms);
@@ -136,6 +142,12 @@ public:
 
   double predict_object_copy_time_ms(size_t bytes_to_copy, bool during_concurrent_mark) const;
 
+  double predict_code_root_scan_time_ms(size_t code_root_num) const;
+
+  double predict_root_scan_time_ms() const;
+
+  double predict_ref_proc_time_ms() const;
+
   double predict_constant_other_time_ms() const;
 
   double predict_young_other_time_ms(size_t young_num) const;
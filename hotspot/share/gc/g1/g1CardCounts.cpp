@@ -58,7 +58,8 @@ void G1CardCounts::clear_range(size_t from_card_num, size_t to_card_num) {
 }
 
 G1CardCounts::G1CardCounts(G1CollectedHeap *g1h):
-  _listener(), _g1h(g1h), _ct(NULL), _card_counts(NULL), _reserved_max_card_num(0), _ct_bot(NULL) {
+  _listener(), _g1h(g1h), _ct(NULL), _card_counts(NULL), _reserved_max_card_num(0), _ct_bot(NULL),
+  _hot_threshold((uint)G1ConcRSHotCardLimit) {
   _listener.set_cardcounts(this);
 }
 
@@ -97,16 +98,22 @@ uint G1CardCounts::add_card_count(CardValue* card_ptr) {
            "Card " SIZE_FORMAT " outside of card counts table (max size " SIZE_FORMAT ")",
            card_num, _reserved_max_card_num);
     count = (uint) _card_counts[card_num];
-    if (count < G1ConcRSHotCardLimit) {
+    if (count < _hot_threshold) {
       _card_counts[card_num] =
-        (jubyte)(MIN2((uintx)(_card_counts[card_num] + 1), G1ConcRSHotCardLimit));
+        (jubyte)(MIN2(_card_counts[card_num] + 1u, _hot_threshold));
     }
   }
   return count;
 }
 
 bool G1CardCounts::is_hot(uint count) {
-  return (count >= G1ConcRSHotCardLimit);
+  return (count >= _hot_threshold);
+}
+
+void G1CardCounts::set_hot_threshold(uint threshold) {
+  assert(threshold >= G1ConcRSHotCardLimit && threshold <= max_jubyte,
+         "hot card threshold %u out of range", threshold);
+  _hot_threshold = threshold;
 }
 
 void G1CardCounts::clear_region(HeapRegion* hr) {
@@ -72,6 +72,10 @@ private:
   // CardTable bottom.
   const CardValue* _ct_bot;
 
+  // The current threshold that defines (>=) a hot card. Starts out at
+  // G1ConcRSHotCardLimit and is adjusted by the hot card cache.
+  uint _hot_threshold;
+
   // Returns true if the card counts table has been reserved.
   bool has_reserved_count_table() { return _card_counts != NULL; }
 
@@ -122,6 +126,9 @@ private:
   // 'hot'; false otherwise.
   bool is_hot(uint count);
 
+  uint hot_threshold() const { return _hot_threshold; }
+  void set_hot_threshold(uint threshold);
+
   // Clears the card counts for the cards spanned by the region
   void clear_region(HeapRegion* hr);
 
@@ -59,6 +59,37 @@ void G1CardTable::g1_mark_as_young(const MemRegion& mr) {
   memset_with_concurrent_readers(first, g1_young_gen, last - first);
 }
 
+void G1CardTable::clear_sparse(MemRegion mr) {
+  CardValue* cur = byte_for(mr.start());
+  CardValue* const last = byte_after(mr.last());
+
+  while (cur < last && !is_aligned(cur, BytesPerWord)) {
+    *cur++ = clean_card;
+  }
+
+  uintptr_t clean_word;
+  memset(&clean_word, clean_card, sizeof(clean_word));
+
+  const size_t words_per_run = 32 / BytesPerWord;
+  uintptr_t* word = (uintptr_t*)cur;
+  uintptr_t* const last_run = word + pointer_delta(last, cur, sizeof(CardValue)) / BytesPerWord / words_per_run * words_per_run;
+  for (; word < last_run; word += words_per_run) {
+    uintptr_t diff = 0;
+    for (size_t i = 0; i < words_per_run; i++) {
+      diff |= word[i] ^ clean_word;
+    }
+    if (diff != 0) {
+      for (size_t i = 0; i < words_per_run; i++) {
+        word[i] = clean_word;
+      }
+    }
+  }
+
+  for (cur = (CardValue*)last_run; cur < last; cur++) {
+    *cur = clean_card;
+  }
+}
+
 #ifndef PRODUCT
 void G1CardTable::verify_g1_young_region(MemRegion mr) {
   verify_region(mr, g1_young_gen,  true);
@@ -87,6 +87,11 @@ public:
   void verify_g1_young_region(MemRegion mr) PRODUCT_RETURN;
   void g1_mark_as_young(const MemRegion& mr);
 
+  // Reset the cards covering the given card-aligned region to clean. Only
+  // stores to 32 byte runs of cards that are not already clean, so that
+  // clearing a mostly clean card table is mostly reads.
+  void clear_sparse(MemRegion mr);
+
   bool mark_card_deferred(size_t card_index);
 
   bool is_card_deferred(size_t card_index) {
@@ -168,12 +168,15 @@ HeapRegion* G1CollectedHeap::new_heap_region(uint hrs_index,
 
 // Private methods.
 
-HeapRegion* G1CollectedHeap::new_region(size_t word_size, HeapRegionType type, bool do_expand) {
+HeapRegion* G1CollectedHeap::new_region(size_t word_size,
+                                        HeapRegionType type,
+                                        bool do_expand,
+                                        uint node_index) {
   assert(!is_humongous(word_size) || word_size <= HeapRegion::GrainWords,
          "the only time we use this to allocate a humongous region is "
          "when we are allocating a single humongous region");
 
-  HeapRegion* res = _hrm->allocate_free_region(type);
+  HeapRegion* res = _hrm->allocate_free_region(type, node_index);
 
   if (res == NULL && do_expand && _expand_heap_after_alloc_failure) {
     // Currently, only attempts to allocate GC alloc regions set
@@ -190,7 +193,7 @@ HeapRegion* G1CollectedHeap::new_region(size_t word_size, HeapRegionType type, b
       // always expand the heap by an amount aligned to the heap
       // region size, the free list should in theory not be empty.
       // In either case allocate_free_region() will check for NULL.
-      res = _hrm->allocate_free_region(type);
+      res = _hrm->allocate_free_region(type, node_index);
     } else {
       _expand_heap_after_alloc_failure = false;
     }
@@ -1401,6 +1404,42 @@ void G1CollectedHeap::shrink_helper(size_t shrink_bytes) {
   }
 }
 
+size_t G1CollectedHeap::periodic_uncommit() {
+  assert(!SafepointSynchronize::is_at_safepoint(), "should be called concurrently");
+
+  // The heterogeneous heap keeps separate free lists per memory type.
+  if (is_heterogeneous_heap()) {
+    return 0;
+  }
+
+  // The Heap_lock keeps out region allocation and GC pauses, and with them
+  // the start of a concurrent cycle.
+  MutexLocker ml(Heap_lock);
+
+  // Concurrent marking accesses the marking bitmaps of all committed
+  // regions; it resizes the heap at Remark anyway.
+  if (_cm_thread->during_cycle()) {
+    log_debug(gc, periodic)("Concurrent cycle in progress. Skipping uncommit.");
+    return 0;
+  }
+
+  size_t uncommit_bytes = _heap_sizing_policy->uncommit_amount();
+  uint num_to_uncommit = (uint)MIN2(uncommit_bytes / HeapRegion::GrainBytes, (size_t)G1PeriodicUncommitBatchRegions);
+  if (num_to_uncommit == 0) {
+    return 0;
+  }
+
+  uint num_regions_removed = _hrm->uncommit_free_regions(num_to_uncommit);
+  size_t uncommitted_bytes = num_regions_removed * HeapRegion::GrainBytes;
+  if (num_regions_removed > 0) {
+    policy()->record_new_heap_size(num_regions());
+  }
+
+  log_debug(gc, periodic)("Uncommitted " SIZE_FORMAT "B (%u regions), capacity " SIZE_FORMAT "B, remaining excess " SIZE_FORMAT "B",
+                          uncommitted_bytes, num_regions_removed, capacity(), uncommit_bytes - uncommitted_bytes);
+  return uncommitted_bytes;
+}
+
 void G1CollectedHeap::shrink(size_t shrink_bytes) {
   _verifier->verify_region_sets_optional();
 
@@ -1494,6 +1533,7 @@ G1CollectedHeap::G1CollectedHeap() :
   _bot(NULL),
   _listener(),
   _hrm(NULL),
+  _numa(G1NUMA::create()),
   _allocator(NULL),
   _verifier(NULL),
   _summary_bytes_used(0),
@@ -1524,6 +1564,7 @@ G1CollectedHeap::G1CollectedHeap() :
   _task_queues(NULL),
   _evacuation_failed(false),
   _evacuation_failed_info_array(NULL),
+  _evacuation_failed_objects(NULL),
   _preserved_marks_set(true /* in_c_heap */),
 #ifndef PRODUCT
   _evacuation_failure_alot_for_current_gc(false),
@@ -1552,14 +1593,17 @@ G1CollectedHeap::G1CollectedHeap() :
 
   uint n_queues = ParallelGCThreads;
   _task_queues = new RefToScanQueueSet(n_queues);
+  _task_queues->set_steal_batch((uint) WorkStealingBatchSize);
 
   _evacuation_failed_info_array = NEW_C_HEAP_ARRAY(EvacuationFailedInfo, n_queues, mtGC);
+  _evacuation_failed_objects = NEW_C_HEAP_ARRAY(G1EvacFailureObjectList, n_queues, mtGC);
 
   for (uint i = 0; i < n_queues; i++) {
     RefToScanQueue* q = new RefToScanQueue();
     q->initialize();
     _task_queues->register_queue(i, q);
     ::new (&_evacuation_failed_info_array[i]) EvacuationFailedInfo();
+    ::new (&_evacuation_failed_objects[i]) G1EvacFailureObjectList();
   }
 
   // Initialize the G1EvacuationFailureALot counters and flags.
@@ -1697,6 +1741,7 @@ jint G1CollectedHeap::initialize() {
   // Carve out the G1 part of the heap.
   ReservedSpace g1_rs = heap_rs.first_part(reserved_byte_size);
   size_t page_size = actual_reserved_page_size(heap_rs);
+  _numa->set_region_info(HeapRegion::GrainBytes, page_size);
   G1RegionToSpaceMapper* heap_storage =
     G1RegionToSpaceMapper::create_heap_mapper(g1_rs,
                                               g1_rs.size(),
@@ -2220,6 +2265,43 @@ void G1CollectedHeap::object_iterate(ObjectClosure* cl) {
   heap_region_iterate(&blk);
 }
 
+class G1ParallelObjectIterator : public ParallelObjectIterator {
+private:
+  G1CollectedHeap*  _heap;
+  HeapRegionClaimer _claimer;
+
+public:
+  G1ParallelObjectIterator(uint thread_num) :
+      _heap(G1CollectedHeap::heap()),
+      _claimer(thread_num == 0 ? G1CollectedHeap::heap()->workers()->active_workers() : thread_num) {}
+
+  virtual void object_iterate(ObjectClosure* cl, uint worker_id) {
+    _heap->object_par_iterate(cl, &_claimer, worker_id);
+  }
+};
+
+bool G1CollectedHeap::can_pin_object(oop obj) const {
+  return heap_region_containing(obj)->is_starts_humongous();
+}
+
+oop G1CollectedHeap::pin_object(JavaThread* thread, oop obj) {
+  heap_region_containing(obj)->increment_pinned_object_count();
+  return obj;
+}
+
+void G1CollectedHeap::unpin_object(JavaThread* thread, oop obj) {
+  heap_region_containing(obj)->decrement_pinned_object_count();
+}
+
+ParallelObjectIterator* G1CollectedHeap::parallel_object_iterator(uint thread_num) {
+  return new G1ParallelObjectIterator(thread_num);
+}
+
+void G1CollectedHeap::object_par_iterate(ObjectClosure* cl, HeapRegionClaimer* claimer, uint worker_id) {
+  IterateObjectClosureRegionClosure blk(cl);
+  heap_region_par_iterate_from_worker_offset(&blk, claimer, worker_id);
+}
+
 void G1CollectedHeap::heap_region_iterate(HeapRegionClosure* cl) const {
   _hrm->iterate(cl);
 }
@@ -2649,6 +2731,12 @@ class RegisterRegionsWithRegionAttrTableClosure : public HeapRegionClosure {
     if (!region->rem_set()->is_complete()) {
       return false;
     }
+
+    // Native code in a JNI critical section may access the object without
+    // holding a reference the GC can see.
+    if (region->has_pinned_objects()) {
+      return false;
+    }
     // Candidate selection must satisfy the following constraints
     // while concurrent marking is in progress:
     //
@@ -2670,12 +2758,7 @@ class RegisterRegionsWithRegionAttrTableClosure : public HeapRegionClosure {
     // structures don't support efficiently performing the needed
     // additional tests or scrubbing of the mark stack.
     //
-    // However, we presently only nominate is_typeArray() objects.
-    // A humongous object containing references induces remembered
-    // set entries on other regions.  In order to reclaim such an
-    // object, those remembered sets would need to be cleaned up.
-    //
-    // We also treat is_typeArray() objects specially, allowing them
+    // We treat is_typeArray() objects specially, allowing them
     // to be reclaimed even if allocated before the start of
     // concurrent mark.  For this we rely on mark stack insertion to
     // exclude is_typeArray() objects, preventing reclaiming an object
@@ -2684,8 +2767,20 @@ class RegisterRegionsWithRegionAttrTableClosure : public HeapRegionClosure {
     // Frequent allocation and drop of large binary blobs is an
     // important use case for eager reclaim, and this special handling
     // may reduce needed headroom.
-
-    return obj->is_typeArray() &&
+    //
+    // Humongous object arrays are only nominated outside of concurrent
+    // marking, as they may be on the mark stack or have unscanned
+    // references otherwise.  Their references induce remembered set
+    // entries on other regions that become stale when the object is
+    // reclaimed.  Stale entries into free or reallocated regions are
+    // tolerated by card scanning just like the ones left behind by
+    // regular region freeing, so they need no cleanup.
+    if (obj->is_typeArray()) {
+      return g1h->is_potential_eager_reclaim_candidate(region);
+    }
+    return G1EagerReclaimHumongousObjArrays &&
+           obj->is_objArray() &&
+           !g1h->collector_state()->mark_or_rebuild_in_progress() &&
            g1h->is_potential_eager_reclaim_candidate(region);
   }
 
@@ -2765,19 +2860,43 @@ class RegisterRegionsWithRegionAttrTableClosure : public HeapRegionClosure {
   void flush_rem_set_entries() { _dcq.flush(); }
 };
 
+class G1RegisterRegionsWithRegionAttrTask : public AbstractGangTask {
+  HeapRegionClaimer _claimer;
+  volatile size_t _total_humongous;
+  volatile size_t _candidate_humongous;
+
+public:
+  G1RegisterRegionsWithRegionAttrTask(uint num_workers) :
+    AbstractGangTask("G1 Register Regions With Region Attr"),
+    _claimer(num_workers),
+    _total_humongous(0),
+    _candidate_humongous(0) { }
+
+  virtual void work(uint worker_id) {
+    RegisterRegionsWithRegionAttrTableClosure cl;
+    G1CollectedHeap::heap()->heap_region_par_iterate_from_worker_offset(&cl, &_claimer, worker_id);
+
+    // Flush the remembered set entries to re-check into the global DCQS.
+    cl.flush_rem_set_entries();
+
+    Atomic::add(cl.total_humongous(), &_total_humongous);
+    Atomic::add(cl.candidate_humongous(), &_candidate_humongous);
+  }
+
+  size_t total_humongous() const { return _total_humongous; }
+  size_t candidate_humongous() const { return _candidate_humongous; }
+};
+
 void G1CollectedHeap::register_regions_with_region_attr() {
   Ticks start = Ticks::now();
 
-  RegisterRegionsWithRegionAttrTableClosure cl;
-  heap_region_iterate(&cl);
+  G1RegisterRegionsWithRegionAttrTask task(workers()->active_workers());
+  workers()->run_task(&task);
 
   phase_times()->record_register_regions((Ticks::now() - start).seconds() * 1000.0,
-                                         cl.total_humongous(),
-                                         cl.candidate_humongous());
-  _has_humongous_reclaim_candidates = cl.candidate_humongous() > 0;
-
-  // Finally flush all remembered set entries to re-check into the global DCQS.
-  cl.flush_rem_set_entries();
+                                         task.total_humongous(),
+                                         task.candidate_humongous());
+  _has_humongous_reclaim_candidates = task.candidate_humongous() > 0;
 }
 
 #ifndef PRODUCT
@@ -2895,6 +3014,7 @@ void G1CollectedHeap::start_new_collection_set() {
 void G1CollectedHeap::calculate_collection_set(G1EvacuationInfo& evacuation_info, double target_pause_time_ms) {
 
   _collection_set.finalize_initial_collection_set(target_pause_time_ms, &_survivor);
+  policy()->record_pause_phase_predictions();
   evacuation_info.set_collectionset_regions(collection_set()->region_length() +
                                             collection_set()->optional_region_length());
 
@@ -3125,6 +3245,7 @@ bool G1CollectedHeap::do_collection_pause_at_safepoint(double target_pause_time_
     }
 
     policy()->print_phases();
+    policy()->phase_times()->report_par_phases(_gc_tracer_stw);
     heap_transition.print();
 
     _hrm->verify_optional();
@@ -3165,8 +3286,18 @@ bool G1CollectedHeap::do_collection_pause_at_safepoint(double target_pause_time_
 }
 
 void G1CollectedHeap::remove_self_forwarding_pointers() {
+  G1PrepareEvacFailureRegionsTask prepare_task;
+  workers()->run_task(&prepare_task);
+
+  G1RestoreEvacFailureObjectsTask restore_task(_evacuation_failed_objects, ParallelGCThreads);
+  workers()->run_task(&restore_task);
+
   G1ParRemoveSelfForwardPtrsTask rsfp_task;
   workers()->run_task(&rsfp_task);
+
+  for (uint i = 0; i < ParallelGCThreads; i++) {
+    _evacuation_failed_objects[i].clear();
+  }
 }
 
 void G1CollectedHeap::restore_after_evac_failure() {
@@ -3185,6 +3316,7 @@ void G1CollectedHeap::preserve_mark_during_evac_failure(uint worker_id, oop obj,
   }
 
   _evacuation_failed_info_array[worker_id].register_copy_failure(obj->size());
+  _evacuation_failed_objects[worker_id].add(obj);
   _preserved_marks_set.get(worker_id)->push_if_necessary(obj, m);
 }
 
@@ -3645,6 +3777,8 @@ protected:
 
     p->record_or_add_thread_work_item(objcopy_phase, worker_id, pss->lab_waste_words() * HeapWordSize, G1GCPhaseTimes::ObjCopyLABWaste);
     p->record_or_add_thread_work_item(objcopy_phase, worker_id, pss->lab_undo_waste_words() * HeapWordSize, G1GCPhaseTimes::ObjCopyLABUndoWaste);
+    p->record_or_add_thread_work_item(objcopy_phase, worker_id, pss->lab_refills(), G1GCPhaseTimes::ObjCopyLABRefills);
+    p->record_or_add_thread_work_item(objcopy_phase, worker_id, pss->direct_allocated_words() * HeapWordSize, G1GCPhaseTimes::ObjCopyDirectAllocated);
 
     if (termination_phase == G1GCPhaseTimes::Termination) {
       p->record_time_secs(termination_phase, worker_id, cl.term_time());
@@ -4279,10 +4413,9 @@ class G1FreeHumongousRegionClosure : public HeapRegionClosure {
     // are completely up-to-date wrt to references to the humongous object.
     //
     // Other implementation considerations:
-    // - never consider object arrays at this time because they would pose
-    // considerable effort for cleaning up the the remembered sets. This is
-    // required because stale remembered sets might reference locations that
-    // are currently allocated into.
+    // - object arrays are only candidates if selected outside of concurrent
+    // marking. The remembered set entries in other regions induced by their
+    // references are left stale, like the ones of any other freed region.
     uint region_idx = r->hrm_index();
     if (!g1h->is_humongous_reclaim_candidate(region_idx) ||
         !r->rem_set()->is_empty()) {
@@ -4299,8 +4432,8 @@ class G1FreeHumongousRegionClosure : public HeapRegionClosure {
       return false;
     }
 
-    guarantee(obj->is_typeArray(),
-              "Only eagerly reclaiming type arrays is supported, but the object "
+    guarantee(obj->is_typeArray() || (G1EagerReclaimHumongousObjArrays && obj->is_objArray()),
+              "Only eagerly reclaiming type and object arrays is supported, but the object "
               PTR_FORMAT " is not.", p2i(r->bottom()));
 
     log_debug(gc, humongous)("Dead humongous region %u object size " SIZE_FORMAT " start " PTR_FORMAT " with remset " SIZE_FORMAT " code roots " SIZE_FORMAT " is marked %d reclaim candidate %d type array %d",
@@ -4566,13 +4699,15 @@ void G1CollectedHeap::rebuild_region_sets(bool free_list_only) {
 // Methods for the mutator alloc region
 
 HeapRegion* G1CollectedHeap::new_mutator_alloc_region(size_t word_size,
-                                                      bool force) {
+                                                      bool force,
+                                                      uint node_index) {
   assert_heap_locked_or_at_safepoint(true /* should_be_vm_thread */);
   bool should_allocate = policy()->should_allocate_mutator_region();
   if (force || should_allocate) {
     HeapRegion* new_alloc_region = new_region(word_size,
                                               HeapRegionType::Eden,
-                                              false /* do_expand */);
+                                              false /* do_expand */,
+                                              node_index);
     if (new_alloc_region != NULL) {
       set_region_short_lived_locked(new_alloc_region);
       _hr_printer.alloc(new_alloc_region, !should_allocate);
@@ -4610,7 +4745,7 @@ bool G1CollectedHeap::has_more_regions(G1HeapRegionAttr dest) {
   }
 }
 
-HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size, G1HeapRegionAttr dest) {
+HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size, G1HeapRegionAttr dest, uint node_index) {
   assert(FreeList_lock->owned_by_self(), "pre-condition");
 
   if (!has_more_regions(dest)) {
@@ -4626,7 +4761,8 @@ HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size, G1HeapRegionA
 
   HeapRegion* new_alloc_region = new_region(word_size,
                                             type,
-                                            true /* do_expand */);
+                                            true /* do_expand */,
+                                            node_index);
 
   if (new_alloc_region != NULL) {
     if (type.is_survivor()) {
@@ -42,6 +42,7 @@
 #include "gc/g1/g1HRPrinter.hpp"
 #include "gc/g1/g1HeapRegionAttr.hpp"
 #include "gc/g1/g1MonitoringSupport.hpp"
+#include "gc/g1/g1NUMA.hpp"
 #include "gc/g1/g1SurvivorRegions.hpp"
 #include "gc/g1/g1YCTypes.hpp"
 #include "gc/g1/heapRegionManager.hpp"
@@ -195,6 +196,9 @@ private:
   // The sequence of all heap regions in the heap.
   HeapRegionManager* _hrm;
 
+  // NUMA node information used for region placement and allocation.
+  G1NUMA* _numa;
+
   // Manages all allocations with regions except humongous object allocations.
   G1Allocator* _allocator;
 
@@ -383,8 +387,12 @@ private:
   // an allocation of the given word_size. If do_expand is true,
   // attempt to expand the heap if necessary to satisfy the allocation
   // request. 'type' takes the type of region to be allocated. (Use constants
-  // Old, Eden, Humongous, Survivor defined in HeapRegionType.)
-  HeapRegion* new_region(size_t word_size, HeapRegionType type, bool do_expand);
+  // Old, Eden, Humongous, Survivor defined in HeapRegionType.) 'node_index'
+  // is the NUMA node the region is preferably allocated on.
+  HeapRegion* new_region(size_t word_size,
+                         HeapRegionType type,
+                         bool do_expand,
+                         uint node_index = G1NUMA::AnyNodeIndex);
 
   // Initialize a contiguous set of free regions of length num_regions
   // and starting at index first so that they appear as a single
@@ -459,13 +467,13 @@ private:
   // These methods are the "callbacks" from the G1AllocRegion class.
 
   // For mutator alloc regions.
-  HeapRegion* new_mutator_alloc_region(size_t word_size, bool force);
+  HeapRegion* new_mutator_alloc_region(size_t word_size, bool force, uint node_index);
   void retire_mutator_alloc_region(HeapRegion* alloc_region,
                                    size_t allocated_bytes);
 
   // For GC alloc regions.
   bool has_more_regions(G1HeapRegionAttr dest);
-  HeapRegion* new_gc_alloc_region(size_t word_size, G1HeapRegionAttr dest);
+  HeapRegion* new_gc_alloc_region(size_t word_size, G1HeapRegionAttr dest, uint node_index);
   void retire_gc_alloc_region(HeapRegion* alloc_region,
                               size_t allocated_bytes, G1HeapRegionAttr dest);
 
@@ -533,6 +541,10 @@ public:
     return _allocator;
   }
 
+  G1NUMA* numa() const {
+    return _numa;
+  }
+
   G1HeapVerifier* verifier() {
     return _verifier;
   }
@@ -555,6 +567,8 @@ public:
 
   // Determines PLAB size for a given destination.
   inline size_t desired_plab_sz(G1HeapRegionAttr dest);
+  // Limit the given PLAB size to what may be used for PLABs.
+  inline size_t clamp_plab_size(size_t value) const;
 
   // Do anything common to GC's.
   void gc_prologue(bool full);
@@ -708,6 +722,12 @@ public:
 
   oop materialize_archived_object(oop obj);
 
+  // Uncommit at most G1PeriodicUncommitBatchRegions free regions above the
+  // capacity the heap sizing policy wants to keep, without a safepoint.
+  // Called by the service thread while the heap is idle. Returns the
+  // number of bytes uncommitted.
+  size_t periodic_uncommit();
+
 private:
 
   // Shrink the garbage-first heap by at most the given size (in bytes!).
@@ -797,6 +817,9 @@ public:
 
   EvacuationFailedInfo* _evacuation_failed_info_array;
 
+  // The objects each worker failed to evacuate in the current collection.
+  G1EvacFailureObjectList* _evacuation_failed_objects;
+
   // Failed evacuations cause some logical from-space objects to have
   // forwarding pointers to themselves.  Reset them.
   void remove_self_forwarding_pointers();
@@ -1144,6 +1167,11 @@ public:
     object_iterate(cl);
   }
 
+  virtual ParallelObjectIterator* parallel_object_iterator(uint thread_num);
+
+  // Iterate over the objects in the regions claimed by this worker.
+  void object_par_iterate(ObjectClosure* cl, HeapRegionClaimer* claimer, uint worker_id);
+
   // Iterate over heap regions, in address order, terminating the
   // iteration early if the "do_heap_region" method returns "true".
   void heap_region_iterate(HeapRegionClosure* blk) const;
@@ -1387,6 +1415,12 @@ public:
 
   virtual WorkGang* get_safepoint_workers() { return _workers; }
 
+  // Humongous objects are never moved, so JNI critical sections on them
+  // do not need the GCLocker. Other objects are not pinned.
+  virtual bool can_pin_object(oop obj) const;
+  virtual oop pin_object(JavaThread* thread, oop obj);
+  virtual void unpin_object(JavaThread* thread, oop obj);
+
   // The methods below are here for convenience and dispatch the
   // appropriate method depending on value of the given VerifyOption
   // parameter. The values for that parameter, and their meanings,
@@ -26,8 +26,10 @@
 #include "gc/g1/g1CollectedHeap.inline.hpp"
 #include "gc/g1/g1CollectionSetCandidates.hpp"
 #include "gc/g1/g1CollectionSetChooser.hpp"
+#include "gc/g1/g1ConcurrentMark.inline.hpp"
 #include "gc/g1/heapRegionRemSet.hpp"
 #include "gc/shared/space.inline.hpp"
+#include "gc/shared/suspendibleThreadSet.hpp"
 #include "runtime/atomic.hpp"
 #include "utilities/quickSort.hpp"
 
@@ -69,6 +71,9 @@ static int order_regions(HeapRegion* hr1, HeapRegion* hr2) {
 // put them into some work area unsorted. At the end the array is sorted and
 // copied into the G1CollectionSetCandidates instance; the caller will be the new
 // owner of this object.
+// This task runs concurrently with the application after the remembered set
+// rebuild. Old regions with a remembered set that are not selected are collected
+// separately, as their remembered sets can only be cleared in the Cleanup pause.
 class G1BuildCandidateRegionsTask : public AbstractGangTask {
 
   // Work area for building the set of collection set candidates. Contains references
@@ -142,20 +147,40 @@ class G1BuildCandidateRegionsTask : public AbstractGangTask {
         dest[i] = _data[i];
       }
     }
+
+    // Copy the non-NULL elements into dest, without sorting.
+    void compact_into(HeapRegion** dest, uint num_regions) {
+      uint dest_idx = 0;
+      for (uint i = 0; i < _cur_claim_idx; i++) {
+        if (_data[i] != NULL) {
+          assert(dest_idx < num_regions, "Index %u out of bounds %u", dest_idx, num_regions);
+          dest[dest_idx++] = _data[i];
+        }
+      }
+      assert(dest_idx == num_regions, "Copied %u regions but expected %u", dest_idx, num_regions);
+    }
   };
 
   // Per-region closure. In addition to determining whether a region should be
   // added to the candidates, and calculating those regions' gc efficiencies, also
   // gather additional statistics.
   class G1BuildCandidateRegionsClosure : public HeapRegionClosure {
+    G1ConcurrentMark* _cm;
+
     G1BuildCandidateArray* _array;
+    G1BuildCandidateArray* _rejected;
 
     uint _cur_chunk_idx;
     uint _cur_chunk_end;
 
+    uint _cur_rejected_chunk_idx;
+    uint _cur_rejected_chunk_end;
+
     uint _regions_added;
     size_t _reclaimable_bytes_added;
 
+    uint _regions_rejected;
+
     void add_region(HeapRegion* hr) {
       if (_cur_chunk_idx == _cur_chunk_end) {
         _array->claim_chunk(_cur_chunk_idx, _cur_chunk_end);
@@ -171,15 +196,33 @@ class G1BuildCandidateRegionsTask : public AbstractGangTask {
       _reclaimable_bytes_added += hr->reclaimable_bytes();
     }
 
-    bool should_add(HeapRegion* hr) { return G1CollectionSetChooser::should_add(hr); }
+    void reject_region(HeapRegion* hr) {
+      if (_cur_rejected_chunk_idx == _cur_rejected_chunk_end) {
+        _rejected->claim_chunk(_cur_rejected_chunk_idx, _cur_rejected_chunk_end);
+      }
+      assert(_cur_rejected_chunk_idx < _cur_rejected_chunk_end, "Must be");
+
+      _rejected->set(_cur_rejected_chunk_idx, hr);
+
+      _cur_rejected_chunk_idx++;
+
+      _regions_rejected++;
+    }
+
+    bool should_add(HeapRegion* hr) { return G1CollectionSetChooser::should_add_after_rebuild(hr); }
 
   public:
-    G1BuildCandidateRegionsClosure(G1BuildCandidateArray* array) :
+    G1BuildCandidateRegionsClosure(G1ConcurrentMark* cm, G1BuildCandidateArray* array, G1BuildCandidateArray* rejected) :
+      _cm(cm),
       _array(array),
+      _rejected(rejected),
       _cur_chunk_idx(0),
       _cur_chunk_end(0),
+      _cur_rejected_chunk_idx(0),
+      _cur_rejected_chunk_end(0),
       _regions_added(0),
-      _reclaimable_bytes_added(0) { }
+      _reclaimable_bytes_added(0),
+      _regions_rejected(0) { }
 
     bool do_heap_region(HeapRegion* r) {
       // We will skip any region that's currently used as an old GC
@@ -187,31 +230,34 @@ class G1BuildCandidateRegionsTask : public AbstractGangTask {
       // before we fill them up).
       if (should_add(r) && !G1CollectedHeap::heap()->is_old_gc_alloc_region(r)) {
         add_region(r);
-      } else if (r->is_old()) {
+      } else if (r->is_old() && r->rem_set()->is_tracked()) {
         // Keep remembered sets for humongous regions, otherwise clean out remembered
-        // sets for old regions.
-        r->rem_set()->clear(true /* only_cardset */);
-      } else {
-        assert(r->is_archive() || !r->is_old() || !r->rem_set()->is_tracked(),
-               "Missed to clear unused remembered set of region %u (%s) that is %s",
-               r->hrm_index(), r->get_type_str(), r->rem_set()->get_state_str());
+        // sets for old regions. Refinement may still be adding to them, so this is
+        // left to the Cleanup pause.
+        reject_region(r);
       }
-      return false;
+      _cm->do_yield_check();
+      // Regions may have changed completely if a Full GC aborted marking during the yield.
+      return _cm->has_aborted();
     }
 
     uint regions_added() const { return _regions_added; }
     size_t reclaimable_bytes_added() const { return _reclaimable_bytes_added; }
+    uint regions_rejected() const { return _regions_rejected; }
   };
 
   G1CollectedHeap* _g1h;
+  G1ConcurrentMark* _cm;
   HeapRegionClaimer _hrclaimer;
 
   uint volatile _num_regions_added;
   size_t volatile _reclaimable_bytes_added;
+  uint volatile _num_regions_rejected;
 
   G1BuildCandidateArray _result;
+  G1BuildCandidateArray _rejected;
 
-  void update_totals(uint num_regions, size_t reclaimable_bytes) {
+  void update_totals(uint num_regions, size_t reclaimable_bytes, uint num_rejected) {
     if (num_regions > 0) {
       assert(reclaimable_bytes > 0, "invariant");
       Atomic::add(num_regions, &_num_regions_added);
@@ -219,21 +265,28 @@ class G1BuildCandidateRegionsTask : public AbstractGangTask {
     } else {
       assert(reclaimable_bytes == 0, "invariant");
     }
+    if (num_rejected > 0) {
+      Atomic::add(num_rejected, &_num_regions_rejected);
+    }
   }
 
 public:
-  G1BuildCandidateRegionsTask(uint max_num_regions, uint chunk_size, uint num_workers) :
+  G1BuildCandidateRegionsTask(G1ConcurrentMark* cm, uint max_num_regions, uint chunk_size, uint num_workers) :
     AbstractGangTask("G1 Build Candidate Regions"),
     _g1h(G1CollectedHeap::heap()),
+    _cm(cm),
     _hrclaimer(num_workers),
     _num_regions_added(0),
     _reclaimable_bytes_added(0),
-    _result(max_num_regions, chunk_size, num_workers) { }
+    _num_regions_rejected(0),
+    _result(max_num_regions, chunk_size, num_workers),
+    _rejected(max_num_regions, chunk_size, num_workers) { }
 
   void work(uint worker_id) {
-    G1BuildCandidateRegionsClosure cl(&_result);
+    SuspendibleThreadSetJoiner sts_join;
+    G1BuildCandidateRegionsClosure cl(_cm, &_result, &_rejected);
     _g1h->heap_region_par_iterate_from_worker_offset(&cl, &_hrclaimer, worker_id);
-    update_totals(cl.regions_added(), cl.reclaimable_bytes_added());
+    update_totals(cl.regions_added(), cl.reclaimable_bytes_added(), cl.regions_rejected());
   }
 
   G1CollectionSetCandidates* get_sorted_candidates() {
@@ -243,6 +296,16 @@ public:
                                          _num_regions_added,
                                          _reclaimable_bytes_added);
   }
+
+  HeapRegion** get_rejected_regions(uint& num_regions) {
+    num_regions = _num_regions_rejected;
+    if (num_regions == 0) {
+      return NULL;
+    }
+    HeapRegion** regions = NEW_C_HEAP_ARRAY(HeapRegion*, num_regions, mtGC);
+    _rejected.compact_into(regions, num_regions);
+    return regions;
+  }
 };
 
 uint G1CollectionSetChooser::calculate_work_chunk_size(uint num_workers, uint num_regions) {
@@ -250,21 +313,40 @@ uint G1CollectionSetChooser::calculate_work_chunk_size(uint num_workers, uint nu
   return MAX2(num_regions / num_workers, 1U);
 }
 
-bool G1CollectionSetChooser::should_add(HeapRegion* hr) {
+static bool is_candidate_region(HeapRegion* hr) {
   return !hr->is_young() &&
          !hr->is_pinned() &&
-         region_occupancy_low_enough_for_evac(hr->live_bytes()) &&
+         G1CollectionSetChooser::region_occupancy_low_enough_for_evac(hr->live_bytes());
+}
+
+bool G1CollectionSetChooser::should_add(HeapRegion* hr) {
+  return is_candidate_region(hr) &&
          hr->rem_set()->is_complete();
 }
 
-G1CollectionSetCandidates* G1CollectionSetChooser::build(WorkGang* workers, uint max_num_regions) {
+bool G1CollectionSetChooser::should_add_after_rebuild(HeapRegion* hr) {
+  // Remembered sets that are still being updated become complete in the Cleanup pause.
+  return is_candidate_region(hr) &&
+         hr->rem_set()->is_tracked();
+}
+
+G1CollectionSetCandidates* G1CollectionSetChooser::build(G1ConcurrentMark* cm,
+                                                         WorkGang* workers,
+                                                         uint max_num_regions,
+                                                         HeapRegion**& rejected_regions,
+                                                         uint& num_rejected_regions) {
   uint num_workers = workers->active_workers();
   uint chunk_size = calculate_work_chunk_size(num_workers, max_num_regions);
 
-  G1BuildCandidateRegionsTask cl(max_num_regions, chunk_size, num_workers);
+  G1BuildCandidateRegionsTask cl(cm, max_num_regions, chunk_size, num_workers);
   workers->run_task(&cl, num_workers);
 
-  G1CollectionSetCandidates* result = cl.get_sorted_candidates();
-  result->verify();
-  return result;
+  if (cm->has_aborted()) {
+    rejected_regions = NULL;
+    num_rejected_regions = 0;
+    return NULL;
+  }
+
+  rejected_regions = cl.get_rejected_regions(num_rejected_regions);
+  return cl.get_sorted_candidates();
 }
@@ -30,6 +30,7 @@
 #include "runtime/globals.hpp"
 
 class G1CollectionSetCandidates;
+class G1ConcurrentMark;
 class WorkGang;
 
 // Helper class to calculate collection set candidates, and containing some related
@@ -51,10 +52,20 @@ public:
   // bytes are over the threshold. Humongous regions may be reclaimed during cleanup.
   // Regions also need a complete remembered set to be a candidate.
   static bool should_add(HeapRegion* hr);
+  // Same as should_add(), but also accepts regions whose remembered set is still
+  // being rebuilt and becomes complete in the Cleanup pause.
+  static bool should_add_after_rebuild(HeapRegion* hr);
 
   // Build and return set of collection set candidates sorted by decreasing gc
-  // efficiency.
-  static G1CollectionSetCandidates* build(WorkGang* workers, uint max_num_regions);
+  // efficiency. Runs concurrently with the application after the remembered set
+  // rebuild. Old regions with a remembered set that were not selected are returned
+  // in rejected_regions; the caller owns that array and must clear these remembered
+  // sets in the Cleanup pause. Returns NULL if marking has been aborted.
+  static G1CollectionSetCandidates* build(G1ConcurrentMark* cm,
+                                          WorkGang* workers,
+                                          uint max_num_regions,
+                                          HeapRegion**& rejected_regions,
+                                          uint& num_rejected_regions);
 };
 
 #endif // SHARE_GC_G1_G1COLLECTIONSETCHOOSER_HPP
@@ -27,6 +27,8 @@
 #include "code/codeCache.hpp"
 #include "gc/g1/g1BarrierSet.hpp"
 #include "gc/g1/g1CollectedHeap.inline.hpp"
+#include "gc/g1/g1CollectionSetCandidates.hpp"
+#include "gc/g1/g1CollectionSetChooser.hpp"
 #include "gc/g1/g1CollectorState.hpp"
 #include "gc/g1/g1ConcurrentMark.inline.hpp"
 #include "gc/g1/g1ConcurrentMarkThread.inline.hpp"
@@ -415,6 +417,10 @@ G1ConcurrentMark::G1ConcurrentMark(G1CollectedHeap* g1h,
   _num_concurrent_workers(0),
   _max_concurrent_workers(0),
 
+  _cleanup_candidates(NULL),
+  _cleanup_rejected_regions(NULL),
+  _num_cleanup_rejected_regions(0),
+
   _region_mark_stats(NEW_C_HEAP_ARRAY(G1RegionMarkStats, _g1h->max_regions(), mtGC)),
   _top_at_rebuild_starts(NEW_C_HEAP_ARRAY(HeapWord*, _g1h->max_regions(), mtGC))
 {
@@ -496,6 +502,7 @@ G1ConcurrentMark::G1ConcurrentMark(G1CollectedHeap* g1h,
   // so that the assertion in MarkingTaskQueue::task_queue doesn't fail
   _num_active_tasks = _max_num_tasks;
 
+  _task_queues->set_steal_batch((uint) WorkStealingBatchSize);
   for (uint i = 0; i < _max_num_tasks; ++i) {
     G1CMTaskQueue* task_queue = new G1CMTaskQueue();
     task_queue->initialize();
@@ -653,7 +660,7 @@ private:
 
       while (cur < end) {
         MemRegion mr(cur, MIN2(cur + chunk_size_in_words, end));
-        _bitmap->clear_range(mr);
+        _bitmap->clear_range_large(mr);
 
         cur += chunk_size_in_words;
 
@@ -963,6 +970,9 @@ void G1ConcurrentMark::concurrent_cycle_start() {
 void G1ConcurrentMark::concurrent_cycle_end() {
   _g1h->collector_state()->set_clearing_next_bitmap(false);
 
+  // Candidates may be left over if marking has been aborted after selecting them.
+  clear_cleanup_candidates();
+
   _g1h->trace_heap_after_gc(_gc_tracer_cm);
 
   if (has_aborted()) {
@@ -1130,14 +1140,31 @@ public:
   static const uint RegionsPerThread = 384;
 };
 
-class G1UpdateRemSetTrackingAfterRebuild : public HeapRegionClosure {
+class G1UpdateRemSetTrackingAfterRebuildTask : public AbstractGangTask {
   G1CollectedHeap* _g1h;
+  HeapRegionClaimer _hrclaimer;
+
+  class G1UpdateRemSetTrackingAfterRebuild : public HeapRegionClosure {
+    G1CollectedHeap* _g1h;
+  public:
+    G1UpdateRemSetTrackingAfterRebuild(G1CollectedHeap* g1h) : _g1h(g1h) { }
+
+    virtual bool do_heap_region(HeapRegion* r) {
+      _g1h->policy()->remset_tracker()->update_after_rebuild(r);
+      return false;
+    }
+  };
+
 public:
-  G1UpdateRemSetTrackingAfterRebuild(G1CollectedHeap* g1h) : _g1h(g1h) { }
+  G1UpdateRemSetTrackingAfterRebuildTask(G1CollectedHeap* g1h, uint num_workers) :
+    AbstractGangTask("G1 Update RemSet Tracking After Rebuild"),
+    _g1h(g1h),
+    _hrclaimer(num_workers) {
+  }
 
-  virtual bool do_heap_region(HeapRegion* r) {
-    _g1h->policy()->remset_tracker()->update_after_rebuild(r);
-    return false;
+  virtual void work(uint worker_id) {
+    G1UpdateRemSetTrackingAfterRebuild cl(_g1h);
+    _g1h->heap_region_par_iterate_from_worker_offset(&cl, &_hrclaimer, worker_id);
   }
 };
 
@@ -1353,6 +1380,7 @@ void G1ConcurrentMark::cleanup() {
 
   // If a full collection has happened, we shouldn't do this.
   if (has_aborted()) {
+    clear_cleanup_candidates();
     return;
   }
 
@@ -1365,8 +1393,18 @@ void G1ConcurrentMark::cleanup() {
 
   {
     GCTraceTime(Debug, gc, phases) debug("Update Remembered Set Tracking After Rebuild", _gc_timer_cm);
-    G1UpdateRemSetTrackingAfterRebuild cl(_g1h);
-    _g1h->heap_region_iterate(&cl);
+    WorkGang* workers = _g1h->workers();
+    G1UpdateRemSetTrackingAfterRebuildTask cl(_g1h, workers->active_workers());
+    workers->run_task(&cl);
+  }
+
+  {
+    GCTraceTime(Debug, gc, phases) debug("Clear Rejected Remembered Sets", _gc_timer_cm);
+    for (uint i = 0; i < _num_cleanup_rejected_regions; i++) {
+      HeapRegion* r = _cleanup_rejected_regions[i];
+      assert(r->is_old(), "Rejected region %u must be old but is %s", r->hrm_index(), r->get_type_str());
+      r->rem_set()->clear(true /* only_cardset */);
+    }
   }
 
   if (log_is_enabled(Trace, gc, liveness)) {
@@ -1387,8 +1425,36 @@ void G1ConcurrentMark::cleanup() {
 
   {
     GCTraceTime(Debug, gc, phases) debug("Finalize Concurrent Mark Cleanup", _gc_timer_cm);
-    policy->record_concurrent_mark_cleanup_end();
+    G1CollectionSetCandidates* candidates = _cleanup_candidates;
+    _cleanup_candidates = NULL;
+    clear_cleanup_candidates();
+    policy->record_concurrent_mark_cleanup_end(candidates);
+  }
+}
+
+void G1ConcurrentMark::select_collection_set_candidates() {
+  assert(_cleanup_candidates == NULL && _cleanup_rejected_regions == NULL, "must be");
+  _cleanup_candidates = G1CollectionSetChooser::build(this,
+                                                      _concurrent_workers,
+                                                      _g1h->max_regions(),
+                                                      _cleanup_rejected_regions,
+                                                      _num_cleanup_rejected_regions);
+  if (_cleanup_candidates != NULL) {
+    log_debug(gc, ergo)("Selected %u collection set candidates, rejected %u regions",
+                        _cleanup_candidates->num_regions(), _num_cleanup_rejected_regions);
+  }
+}
+
+void G1ConcurrentMark::clear_cleanup_candidates() {
+  if (_cleanup_candidates != NULL) {
+    delete _cleanup_candidates;
+    _cleanup_candidates = NULL;
+  }
+  if (_cleanup_rejected_regions != NULL) {
+    FREE_C_HEAP_ARRAY(HeapRegion*, _cleanup_rejected_regions);
+    _cleanup_rejected_regions = NULL;
   }
+  _num_cleanup_rejected_regions = 0;
 }
 
 // 'Keep Alive' oop closure used by both serial parallel reference processing.
@@ -40,6 +40,7 @@ class G1ConcurrentMarkThread;
 class G1CollectedHeap;
 class G1CMOopClosure;
 class G1CMTask;
+class G1CollectionSetCandidates;
 class G1ConcurrentMark;
 class G1OldTracer;
 class G1RegionToSpaceMapper;
@@ -370,6 +371,14 @@ class G1ConcurrentMark : public CHeapObj<mtGC> {
   uint      _num_concurrent_workers; // The number of marking worker threads we're using
   uint      _max_concurrent_workers; // Maximum number of marking worker threads
 
+  // Collection set candidates selected concurrently after the remembered set rebuild,
+  // and the old regions whose remembered sets are to be dropped during Cleanup.
+  G1CollectionSetCandidates* _cleanup_candidates;
+  HeapRegion**               _cleanup_rejected_regions;
+  uint                       _num_cleanup_rejected_regions;
+
+  void clear_cleanup_candidates();
+
   void verify_during_pause(G1HeapVerifier::G1VerifyType type, VerifyOption vo, const char* caller);
 
   void finalize_marking();
@@ -571,6 +580,8 @@ public:
   // Mark in the previous bitmap. Caution: the prev bitmap is usually read-only, so use
   // this carefully.
   inline void mark_in_prev_bitmap(oop p);
+  // Same as mark_in_prev_bitmap(), for use by multiple threads at once.
+  inline void par_mark_in_prev_bitmap(oop p);
 
   // Clears marks for all objects in the given range, for the prev or
   // next bitmaps.  Caution: the previous bitmap is usually
@@ -612,6 +623,11 @@ public:
 private:
   // Rebuilds the remembered sets for chosen regions in parallel and concurrently to the application.
   void rebuild_rem_set_concurrently();
+
+public:
+  // Determines the collection set candidates for the following mixed gcs in parallel
+  // and concurrently to the application, to be installed during Cleanup.
+  void select_collection_set_candidates();
 };
 
 // A class representing a marking task.
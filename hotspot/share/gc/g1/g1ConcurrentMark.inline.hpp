@@ -274,6 +274,11 @@ inline void G1ConcurrentMark::mark_in_prev_bitmap(oop p) {
  _prev_mark_bitmap->mark((HeapWord*) p);
 }
 
+inline void G1ConcurrentMark::par_mark_in_prev_bitmap(oop p) {
+  assert(!_prev_mark_bitmap->is_marked((HeapWord*) p), "sanity");
+  _prev_mark_bitmap->par_mark((HeapWord*) p);
+}
+
 bool G1ConcurrentMark::is_marked_in_prev_bitmap(oop p) const {
   assert(p != NULL && oopDesc::is_oop(p), "expected an oop");
   return _prev_mark_bitmap->is_marked((HeapWord*)p);
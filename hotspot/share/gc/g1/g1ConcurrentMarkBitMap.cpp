@@ -39,7 +39,7 @@ void G1CMBitMapMappingChangedListener::on_commit(uint start_region, size_t num_r
   }
   // We need to clear the bitmap on commit, removing any existing information.
   MemRegion mr(G1CollectedHeap::heap()->bottom_addr_for_region(start_region), num_regions * HeapRegion::GrainWords);
-  _bm->clear_range(mr);
+  _bm->clear_range_large(mr);
 }
 
 void G1CMBitMap::clear_region(HeapRegion* region) {
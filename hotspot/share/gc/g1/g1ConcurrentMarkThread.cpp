@@ -61,6 +61,7 @@ STATIC_ASSERT(ConcurrentGCPhaseManager::UNCONSTRAINED_PHASE <
   expander(BEFORE_REMARK,, NULL)                                           \
   expander(REMARK,, NULL)                                                  \
   expander(REBUILD_REMEMBERED_SETS,, "Concurrent Rebuild Remembered Sets") \
+  expander(SELECT_CANDIDATES,, "Concurrent Select Candidates")             \
   expander(CLEANUP_FOR_NEXT_MARK,, "Concurrent Cleanup for Next Mark")     \
   /* */
 
@@ -355,6 +356,11 @@ void G1ConcurrentMarkThread::run_service() {
         _cm->rebuild_rem_set_concurrently();
       }
 
+      if (!_cm->has_aborted()) {
+        G1ConcPhase p(G1ConcurrentPhase::SELECT_CANDIDATES, this);
+        _cm->select_collection_set_candidates();
+      }
+
       double end_time = os::elapsedVTime();
       // Update the total virtual time before doing this, since it will try
       // to measure it to get the vtime for this marking.
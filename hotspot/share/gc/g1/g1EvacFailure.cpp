@@ -36,6 +36,7 @@
 #include "oops/access.inline.hpp"
 #include "oops/compressedOops.inline.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.hpp"
 
 class UpdateRSetDeferred : public BasicOopIterateClosure {
 private:
@@ -68,99 +69,144 @@ public:
   }
 };
 
-class RemoveSelfForwardPtrObjClosure: public ObjectClosure {
+void G1EvacFailureObjectList::add(oop obj) {
+  if (_head == NULL || _head->is_full()) {
+    ChunkedList<oop, mtGC>* chunk = new ChunkedList<oop, mtGC>();
+    chunk->set_next_used(_head);
+    _head = chunk;
+  }
+  _head->push(obj);
+  _length++;
+}
+
+void G1EvacFailureObjectList::oops_do(ObjectClosure* cl) const {
+  for (ChunkedList<oop, mtGC>* c = _head; c != NULL; c = c->next_used()) {
+    for (size_t i = 0; i < c->size(); i++) {
+      cl->do_object(c->at(i));
+    }
+  }
+}
+
+void G1EvacFailureObjectList::clear() {
+  while (_head != NULL) {
+    ChunkedList<oop, mtGC>* next = _head->next_used();
+    delete _head;
+    _head = next;
+  }
+  _length = 0;
+}
+
+class RestoreEvacFailureObjectClosure: public ObjectClosure {
   G1CollectedHeap* _g1h;
   G1ConcurrentMark* _cm;
-  HeapRegion* _hr;
-  size_t _marked_bytes;
   UpdateRSetDeferred* _update_rset_cl;
   bool _during_initial_mark;
   uint _worker_id;
+
+public:
+  RestoreEvacFailureObjectClosure(UpdateRSetDeferred* update_rset_cl,
+                                  bool during_initial_mark,
+                                  uint worker_id) :
+    _g1h(G1CollectedHeap::heap()),
+    _cm(_g1h->concurrent_mark()),
+    _update_rset_cl(update_rset_cl),
+    _during_initial_mark(during_initial_mark),
+    _worker_id(worker_id) { }
+
+  void do_object(oop obj) {
+    HeapRegion* hr = _g1h->heap_region_containing(obj);
+    assert(hr->evacuation_failed(), "Object " PTR_FORMAT " failed evacuation in region %u", p2i(obj), hr->hrm_index());
+    assert(obj->is_forwarded() && obj->forwardee() == obj, "Object " PTR_FORMAT " must be self-forwarded", p2i(obj));
+
+    // We consider all objects that we find self-forwarded to be
+    // live. What we'll do is that we'll update the prev marking
+    // info so that they are all under PTAMS and explicitly marked.
+    // Other workers mark objects in the same region at the same time.
+    _cm->par_mark_in_prev_bitmap(obj);
+    if (_during_initial_mark) {
+      // For the next marking info we'll only mark the
+      // self-forwarded objects explicitly if we are during
+      // initial-mark (since, normally, we only mark objects pointed
+      // to by roots if we succeed in copying them). By marking all
+      // self-forwarded objects we ensure that we mark any that are
+      // still pointed to be roots. During concurrent marking, and
+      // after initial-mark, we don't need to mark any objects
+      // explicitly and all objects in the CSet are considered
+      // (implicitly) live. So, we won't mark them explicitly and
+      // we'll leave them over NTAMS.
+      _cm->mark_in_next_bitmap(_worker_id, hr, obj);
+    }
+    PreservedMarks::init_forwarded_mark(obj);
+
+    // While we were processing RSet buffers during the collection,
+    // we actually didn't scan any cards on the collection set,
+    // since we didn't want to update remembered sets with entries
+    // that point into the collection set, given that live objects
+    // from the collection set are about to move and such entries
+    // will be stale very soon.
+    // This change also dealt with a reliability issue which
+    // involved scanning a card in the collection set and coming
+    // across an array that was being chunked and looking malformed.
+    // The problem is that, if evacuation fails, we might have
+    // remembered set entries missing given that we skipped cards on
+    // the collection set. So, we'll recreate such entries now.
+    obj->oop_iterate(_update_rset_cl);
+  }
+};
+
+class RemoveSelfForwardPtrWalker: public StackObj {
+  G1CollectedHeap* _g1h;
+  G1ConcurrentMark* _cm;
+  HeapRegion* _hr;
+  size_t _marked_bytes;
   HeapWord* _last_forwarded_object_end;
 
 public:
-  RemoveSelfForwardPtrObjClosure(HeapRegion* hr,
-                                 UpdateRSetDeferred* update_rset_cl,
-                                 bool during_initial_mark,
-                                 uint worker_id) :
+  RemoveSelfForwardPtrWalker(HeapRegion* hr) :
     _g1h(G1CollectedHeap::heap()),
     _cm(_g1h->concurrent_mark()),
     _hr(hr),
     _marked_bytes(0),
-    _update_rset_cl(update_rset_cl),
-    _during_initial_mark(during_initial_mark),
-    _worker_id(worker_id),
     _last_forwarded_object_end(hr->bottom()) { }
 
   size_t marked_bytes() { return _marked_bytes; }
 
-  // Iterate over the live objects in the region to find self-forwarded objects
-  // that need to be kept live. We need to update the remembered sets of these
-  // objects. Further update the BOT and marks.
-  // We can coalesce and overwrite the remaining heap contents with dummy objects
-  // as they have either been dead or evacuated (which are unreferenced now, i.e.
-  // dead too) already.
-  void do_object(oop obj) {
-    HeapWord* obj_addr = (HeapWord*) obj;
+  // The objects that failed to move are exactly the ones marked on the
+  // prev bitmap of the region by now. Update the BOT for them, and
+  // coalesce and overwrite the remaining heap contents with dummy
+  // objects as they have either been dead or evacuated (which are
+  // unreferenced now, i.e. dead too) already.
+  void do_failed_object(HeapWord* obj_addr) {
     assert(_hr->is_in(obj_addr), "sanity");
 
-    if (obj->is_forwarded() && obj->forwardee() == obj) {
-      // The object failed to move.
+    zap_dead_objects(_last_forwarded_object_end, obj_addr);
 
-      zap_dead_objects(_last_forwarded_object_end, obj_addr);
-      // We consider all objects that we find self-forwarded to be
-      // live. What we'll do is that we'll update the prev marking
-      // info so that they are all under PTAMS and explicitly marked.
-      if (!_cm->is_marked_in_prev_bitmap(obj)) {
-        _cm->mark_in_prev_bitmap(obj);
-      }
-      if (_during_initial_mark) {
-        // For the next marking info we'll only mark the
-        // self-forwarded objects explicitly if we are during
-        // initial-mark (since, normally, we only mark objects pointed
-        // to by roots if we succeed in copying them). By marking all
-        // self-forwarded objects we ensure that we mark any that are
-        // still pointed to be roots. During concurrent marking, and
-        // after initial-mark, we don't need to mark any objects
-        // explicitly and all objects in the CSet are considered
-        // (implicitly) live. So, we won't mark them explicitly and
-        // we'll leave them over NTAMS.
-        _cm->mark_in_next_bitmap(_worker_id, _hr, obj);
-      }
-      size_t obj_size = obj->size();
-
-      _marked_bytes += (obj_size * HeapWordSize);
-      PreservedMarks::init_forwarded_mark(obj);
-
-      // While we were processing RSet buffers during the collection,
-      // we actually didn't scan any cards on the collection set,
-      // since we didn't want to update remembered sets with entries
-      // that point into the collection set, given that live objects
-      // from the collection set are about to move and such entries
-      // will be stale very soon.
-      // This change also dealt with a reliability issue which
-      // involved scanning a card in the collection set and coming
-      // across an array that was being chunked and looking malformed.
-      // The problem is that, if evacuation fails, we might have
-      // remembered set entries missing given that we skipped cards on
-      // the collection set. So, we'll recreate such entries now.
-      obj->oop_iterate(_update_rset_cl);
-
-      HeapWord* obj_end = obj_addr + obj_size;
-      _last_forwarded_object_end = obj_end;
-      _hr->cross_threshold(obj_addr, obj_end);
+    size_t obj_size = ((oop)obj_addr)->size();
+    _marked_bytes += (obj_size * HeapWordSize);
+
+    HeapWord* obj_end = obj_addr + obj_size;
+    _last_forwarded_object_end = obj_end;
+    _hr->cross_threshold(obj_addr, obj_end);
+  }
+
+  void iterate_failed_objects() {
+    const G1CMBitMap* const bitmap = _cm->prev_mark_bitmap();
+    HeapWord* const limit = _hr->top();
+    HeapWord* addr = bitmap->get_next_marked_addr(_hr->bottom(), limit);
+    while (addr < limit) {
+      do_failed_object(addr);
+      addr = bitmap->get_next_marked_addr(_last_forwarded_object_end, limit);
     }
   }
 
   // Fill the memory area from start to end with filler objects, and update the BOT
-  // and the mark bitmap accordingly.
+  // accordingly. The prev bitmap of the area has already been cleared.
   void zap_dead_objects(HeapWord* start, HeapWord* end) {
     if (start == end) {
       return;
     }
 
     size_t gap_size = pointer_delta(end, start);
-    MemRegion mr(start, gap_size);
     if (gap_size >= CollectedHeap::min_fill_size()) {
       CollectedHeap::fill_with_objects(start, gap_size);
 
@@ -182,7 +228,6 @@ public:
 #endif
       }
     }
-    _cm->clear_range_in_prev_bitmap(mr);
   }
 
   void zap_remainder() {
@@ -190,31 +235,49 @@ public:
   }
 };
 
-class RemoveSelfForwardPtrHRClosure: public HeapRegionClosure {
+class PrepareEvacFailureRegionClosure: public HeapRegionClosure {
   G1CollectedHeap* _g1h;
-  uint _worker_id;
   HeapRegionClaimer* _hrclaimer;
 
-  G1DirtyCardQueue _dcq;
-  UpdateRSetDeferred _update_rset_cl;
+public:
+  PrepareEvacFailureRegionClosure(HeapRegionClaimer* hrclaimer) :
+    _g1h(G1CollectedHeap::heap()),
+    _hrclaimer(hrclaimer) { }
+
+  bool do_heap_region(HeapRegion* hr) {
+    assert(!hr->is_pinned(), "Unexpected pinned region at index %u", hr->hrm_index());
+    assert(hr->in_collection_set(), "bad CS");
+
+    if (_hrclaimer->claim_region(hr->hrm_index())) {
+      if (hr->evacuation_failed()) {
+        bool during_initial_mark = _g1h->collector_state()->in_initial_mark_gc();
+        bool during_conc_mark = _g1h->collector_state()->mark_or_rebuild_in_progress();
+
+        hr->note_self_forwarding_removal_start(during_initial_mark,
+                                               during_conc_mark);
+        _g1h->verifier()->check_bitmaps("Self-Forwarding Ptr Removal", hr);
+
+        // Only the failed objects will be marked on the prev bitmap.
+        _g1h->concurrent_mark()->clear_range_in_prev_bitmap(MemRegion(hr->bottom(), hr->top()));
+      }
+    }
+    return false;
+  }
+};
+
+class RemoveSelfForwardPtrHRClosure: public HeapRegionClosure {
+  G1CollectedHeap* _g1h;
+  HeapRegionClaimer* _hrclaimer;
 
 public:
-  RemoveSelfForwardPtrHRClosure(uint worker_id,
-                                HeapRegionClaimer* hrclaimer) :
+  RemoveSelfForwardPtrHRClosure(HeapRegionClaimer* hrclaimer) :
     _g1h(G1CollectedHeap::heap()),
-    _worker_id(worker_id),
-    _hrclaimer(hrclaimer),
-    _dcq(&_g1h->dirty_card_queue_set()),
-    _update_rset_cl(&_dcq){
+    _hrclaimer(hrclaimer) {
   }
 
-  size_t remove_self_forward_ptr_by_walking_hr(HeapRegion* hr,
-                                               bool during_initial_mark) {
-    RemoveSelfForwardPtrObjClosure rspc(hr,
-                                        &_update_rset_cl,
-                                        during_initial_mark,
-                                        _worker_id);
-    hr->object_iterate(&rspc);
+  size_t remove_self_forward_ptr_by_walking_marks(HeapRegion* hr) {
+    RemoveSelfForwardPtrWalker rspc(hr);
+    rspc.iterate_failed_objects();
     // Need to zap the remainder area of the processed region.
     rspc.zap_remainder();
 
@@ -229,16 +292,9 @@ public:
       if (hr->evacuation_failed()) {
         hr->clear_index_in_opt_cset();
 
-        bool during_initial_mark = _g1h->collector_state()->in_initial_mark_gc();
-        bool during_conc_mark = _g1h->collector_state()->mark_or_rebuild_in_progress();
-
-        hr->note_self_forwarding_removal_start(during_initial_mark,
-                                               during_conc_mark);
-        _g1h->verifier()->check_bitmaps("Self-Forwarding Ptr Removal", hr);
-
         hr->reset_bot();
 
-        size_t live_bytes = remove_self_forward_ptr_by_walking_hr(hr, during_initial_mark);
+        size_t live_bytes = remove_self_forward_ptr_by_walking_marks(hr);
 
         hr->rem_set()->clean_strong_code_roots(hr);
         hr->rem_set()->clear_locked(true);
@@ -250,13 +306,46 @@ public:
   }
 };
 
+G1PrepareEvacFailureRegionsTask::G1PrepareEvacFailureRegionsTask() :
+  AbstractGangTask("G1 Prepare Evacuation Failure Regions"),
+  _g1h(G1CollectedHeap::heap()),
+  _hrclaimer(_g1h->workers()->active_workers()) { }
+
+void G1PrepareEvacFailureRegionsTask::work(uint worker_id) {
+  PrepareEvacFailureRegionClosure cl(&_hrclaimer);
+
+  _g1h->collection_set_iterate_increment_from(&cl, worker_id);
+}
+
+G1RestoreEvacFailureObjectsTask::G1RestoreEvacFailureObjectsTask(G1EvacFailureObjectList* lists, uint num_lists) :
+  AbstractGangTask("G1 Restore Evacuation Failure Objects"),
+  _g1h(G1CollectedHeap::heap()),
+  _lists(lists),
+  _num_lists(num_lists),
+  _next_list(0) { }
+
+void G1RestoreEvacFailureObjectsTask::work(uint worker_id) {
+  G1DirtyCardQueue dcq(&_g1h->dirty_card_queue_set());
+  UpdateRSetDeferred update_rset_cl(&dcq);
+  RestoreEvacFailureObjectClosure cl(&update_rset_cl,
+                                     _g1h->collector_state()->in_initial_mark_gc(),
+                                     worker_id);
+
+  // The lists were filled by the workers during evacuation, so they are
+  // about as well balanced as the evacuation work itself.
+  uint i;
+  while ((i = Atomic::add(1u, &_next_list) - 1) < _num_lists) {
+    _lists[i].oops_do(&cl);
+  }
+}
+
 G1ParRemoveSelfForwardPtrsTask::G1ParRemoveSelfForwardPtrsTask() :
   AbstractGangTask("G1 Remove Self-forwarding Pointers"),
   _g1h(G1CollectedHeap::heap()),
   _hrclaimer(_g1h->workers()->active_workers()) { }
 
 void G1ParRemoveSelfForwardPtrsTask::work(uint worker_id) {
-  RemoveSelfForwardPtrHRClosure rsfp_cl(worker_id, &_hrclaimer);
+  RemoveSelfForwardPtrHRClosure rsfp_cl(&_hrclaimer);
 
   _g1h->collection_set_iterate_increment_from(&rsfp_cl, worker_id);
 }
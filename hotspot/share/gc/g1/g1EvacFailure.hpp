@@ -28,9 +28,66 @@
 #include "gc/g1/g1OopClosures.hpp"
 #include "gc/g1/heapRegionManager.hpp"
 #include "gc/shared/workgroup.hpp"
+#include "oops/oopsHierarchy.hpp"
+#include "utilities/chunkedList.hpp"
 #include "utilities/globalDefinitions.hpp"
 
 class G1CollectedHeap;
+class ObjectClosure;
+
+// The objects a single GC worker failed to evacuate, in the order they
+// failed. Recording them lets the fixup after an evacuation failure visit
+// just these objects instead of parsing all of the failed regions.
+class G1EvacFailureObjectList : public CHeapObj<mtGC> {
+  ChunkedList<oop, mtGC>* _head;
+  size_t _length;
+
+public:
+  G1EvacFailureObjectList() : _head(NULL), _length(0) { }
+  ~G1EvacFailureObjectList() { clear(); }
+
+  void add(oop obj);
+  void oops_do(ObjectClosure* cl) const;
+
+  size_t length() const { return _length; }
+
+  // Free all chunks.
+  void clear();
+};
+
+// Fixing up the regions that failed evacuation happens in three tasks:
+//
+// 1. G1PrepareEvacFailureRegionsTask resets the marking information of
+//    each failed region, claiming regions.
+// 2. G1RestoreEvacFailureObjectsTask marks the failed objects as live,
+//    restores their headers and recreates their remembered set entries,
+//    claiming the per-worker G1EvacFailureObjectLists.
+// 3. G1ParRemoveSelfForwardPtrsTask fills the gaps between the failed
+//    objects and rebuilds the BOT of each failed region, claiming regions
+//    again and finding the failed objects on the prev bitmap.
+class G1PrepareEvacFailureRegionsTask: public AbstractGangTask {
+protected:
+  G1CollectedHeap* _g1h;
+  HeapRegionClaimer _hrclaimer;
+
+public:
+  G1PrepareEvacFailureRegionsTask();
+
+  void work(uint worker_id);
+};
+
+class G1RestoreEvacFailureObjectsTask: public AbstractGangTask {
+protected:
+  G1CollectedHeap* _g1h;
+  G1EvacFailureObjectList* _lists;
+  uint _num_lists;
+  volatile uint _next_list;
+
+public:
+  G1RestoreEvacFailureObjectsTask(G1EvacFailureObjectList* lists, uint num_lists);
+
+  void work(uint worker_id);
+};
 
 // Task to fixup self-forwarding pointers
 // installed as a result of an evacuation failure.
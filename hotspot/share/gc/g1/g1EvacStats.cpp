@@ -34,12 +34,14 @@ void G1EvacStats::log_plab_allocation() {
                       "region end waste: " SIZE_FORMAT "B, "
                       "regions filled: %u, "
                       "direct allocated: " SIZE_FORMAT "B, "
+                      "PLABs filled: " SIZE_FORMAT ", "
                       "failure used: " SIZE_FORMAT "B, "
                       "failure wasted: " SIZE_FORMAT "B",
                       _description,
                       _region_end_waste * HeapWordSize,
                       _regions_filled,
                       _direct_allocated * HeapWordSize,
+                      _num_plab_filled,
                       _failure_used * HeapWordSize,
                       _failure_waste * HeapWordSize);
 }
@@ -93,6 +95,7 @@ G1EvacStats::G1EvacStats(const char* description, size_t desired_plab_sz_, unsig
   _region_end_waste(0),
   _regions_filled(0),
   _direct_allocated(0),
+  _num_plab_filled(0),
   _failure_used(0),
   _failure_waste(0) {
 }
@@ -32,6 +32,10 @@ inline void G1EvacStats::add_direct_allocated(size_t value) {
   Atomic::add(value, &_direct_allocated);
 }
 
+inline void G1EvacStats::add_num_plab_filled(size_t value) {
+  Atomic::add(value, &_num_plab_filled);
+}
+
 inline void G1EvacStats::add_region_end_waste(size_t value) {
   Atomic::add(value, &_region_end_waste);
   Atomic::inc(&_regions_filled);
@@ -113,6 +113,8 @@ G1FullCollector::G1FullCollector(G1CollectedHeap* heap, bool explicit_gc, bool c
     _serial_compaction_point(),
     _is_alive(heap->concurrent_mark()->next_mark_bitmap()),
     _is_alive_mutator(heap->ref_processor_stw(), &_is_alive),
+    _live_stats(NULL),
+    _skip_compacting(NULL),
     _always_subject_to_discovery(),
     _is_subject_mutator(heap->ref_processor_stw(), &_always_subject_to_discovery) {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at a safepoint");
@@ -120,8 +122,17 @@ G1FullCollector::G1FullCollector(G1CollectedHeap* heap, bool explicit_gc, bool c
   _preserved_marks_set.init(_num_workers);
   _markers = NEW_C_HEAP_ARRAY(G1FullGCMarker*, _num_workers, mtGC);
   _compaction_points = NEW_C_HEAP_ARRAY(G1FullGCCompactionPoint*, _num_workers, mtGC);
+
+  uint max_regions = heap->max_regions();
+  _live_stats = NEW_C_HEAP_ARRAY(G1RegionMarkStats, max_regions, mtGC);
+  _skip_compacting = NEW_C_HEAP_ARRAY(bool, max_regions, mtGC);
+  for (uint j = 0; j < max_regions; j++) {
+    _live_stats[j].clear();
+    _skip_compacting[j] = false;
+  }
+
   for (uint i = 0; i < _num_workers; i++) {
-    _markers[i] = new G1FullGCMarker(i, _preserved_marks_set.get(i), mark_bitmap());
+    _markers[i] = new G1FullGCMarker(i, _preserved_marks_set.get(i), mark_bitmap(), _live_stats);
     _compaction_points[i] = new G1FullGCCompactionPoint();
     _oop_queue_set.register_queue(i, marker(i)->oop_stack());
     _array_queue_set.register_queue(i, marker(i)->objarray_stack());
@@ -135,6 +146,8 @@ G1FullCollector::~G1FullCollector() {
   }
   FREE_C_HEAP_ARRAY(G1FullGCMarker*, _markers);
   FREE_C_HEAP_ARRAY(G1FullGCCompactionPoint*, _compaction_points);
+  FREE_C_HEAP_ARRAY(G1RegionMarkStats, _live_stats);
+  FREE_C_HEAP_ARRAY(bool, _skip_compacting);
 }
 
 void G1FullCollector::prepare_collection() {
@@ -207,6 +220,12 @@ void G1FullCollector::phase1_mark_live_objects() {
   G1FullGCReferenceProcessingExecutor reference_processing(this);
   reference_processing.execute(scope()->timer(), scope()->tracer());
 
+  // Reference processing may have marked more objects, so only publish
+  // the per-region live words once all marking is done.
+  for (uint i = 0; i < _num_workers; i++) {
+    marker(i)->flush_mark_stats_cache();
+  }
+
   // Weak oops cleanup.
   {
     GCTraceTime(Debug, gc, phases) debug("Phase 1: Weak Processing", scope()->timer());
@@ -232,6 +251,7 @@ void G1FullCollector::phase2_prepare_compaction() {
   GCTraceTime(Info, gc, phases) info("Phase 2: Prepare for compaction", scope()->timer());
   G1FullGCPrepareTask task(this);
   run_task(&task);
+  log_debug(gc, phases)("Skipped compaction of %u dense regions", task.skipped_regions());
 
   // To avoid OOM when there is memory left.
   if (!task.has_freed_regions()) {
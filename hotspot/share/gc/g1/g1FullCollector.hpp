@@ -29,6 +29,7 @@
 #include "gc/g1/g1FullGCMarker.hpp"
 #include "gc/g1/g1FullGCOopClosures.hpp"
 #include "gc/g1/g1FullGCScope.hpp"
+#include "gc/g1/g1RegionMarkStatsCache.hpp"
 #include "gc/shared/preservedMarks.hpp"
 #include "gc/shared/referenceProcessor.hpp"
 #include "gc/shared/taskqueue.hpp"
@@ -65,6 +66,9 @@ class G1FullCollector : StackObj {
   G1FullGCCompactionPoint   _serial_compaction_point;
   G1IsAliveClosure          _is_alive;
   ReferenceProcessorIsAliveMutator _is_alive_mutator;
+  G1RegionMarkStats*        _live_stats;
+  // Regions left in place because they are too dense to be worth compacting.
+  bool*                     _skip_compacting;
 
   static uint calc_active_workers();
 
@@ -90,6 +94,10 @@ public:
   G1CMBitMap*              mark_bitmap();
   ReferenceProcessor*      reference_processor();
 
+  size_t live_words(uint region_index) const { return _live_stats[region_index]._live_words; }
+  bool is_skip_compacting(uint region_index) const { return _skip_compacting[region_index]; }
+  void set_skip_compacting(uint region_index) { _skip_compacting[region_index] = true; }
+
 private:
   void phase1_mark_live_objects();
   void phase2_prepare_compaction();
@@ -34,15 +34,21 @@
 #include "oops/oop.inline.hpp"
 #include "utilities/ticks.hpp"
 
-class G1ResetHumongousClosure : public HeapRegionClosure {
+class G1ResetNotCompactedClosure : public HeapRegionClosure {
+  G1FullCollector* _collector;
   G1CMBitMap* _bitmap;
 
 public:
-  G1ResetHumongousClosure(G1CMBitMap* bitmap) :
-      _bitmap(bitmap) { }
+  G1ResetNotCompactedClosure(G1FullCollector* collector) :
+      _collector(collector),
+      _bitmap(collector->mark_bitmap()) { }
 
   bool do_heap_region(HeapRegion* current) {
-    if (current->is_humongous()) {
+    if (_collector->is_skip_compacting(current->hrm_index())) {
+      // Objects stay in place, only the liveness information is reset.
+      _bitmap->clear_region(current);
+      current->complete_compaction();
+    } else if (current->is_humongous()) {
       if (current->is_starts_humongous()) {
         oop obj = oop(current->bottom());
         if (_bitmap->is_marked(obj)) {
@@ -96,7 +102,7 @@ void G1FullGCCompactTask::work(uint worker_id) {
     compact_region(*it);
   }
 
-  G1ResetHumongousClosure hc(collector()->mark_bitmap());
+  G1ResetNotCompactedClosure hc(collector());
   G1CollectedHeap::heap()->heap_region_par_iterate_from_worker_offset(&hc, &_claimer, worker_id);
   log_task("Compaction task", worker_id, start);
 }
@@ -26,9 +26,11 @@
 #define SHARE_GC_G1_G1FULLGCMARKER_INLINE_HPP
 
 #include "gc/g1/g1Allocator.inline.hpp"
+#include "gc/g1/g1CollectedHeap.inline.hpp"
 #include "gc/g1/g1ConcurrentMarkBitMap.inline.hpp"
 #include "gc/g1/g1FullGCMarker.hpp"
 #include "gc/g1/g1FullGCOopClosures.inline.hpp"
+#include "gc/g1/g1RegionMarkStatsCache.inline.hpp"
 #include "gc/g1/g1StringDedup.hpp"
 #include "gc/g1/g1StringDedupQueue.hpp"
 #include "gc/shared/preservedMarks.inline.hpp"
@@ -49,6 +51,9 @@ inline bool G1FullGCMarker::mark_object(oop obj) {
     return false;
   }
 
+  // Account the live words to the region for compaction planning.
+  _mark_stats_cache.add_live_words(G1CollectedHeap::heap()->addr_to_region((HeapWord*)obj), (size_t)obj->size());
+
   // Marked by us, preserve if needed.
   markOop mark = obj->mark_raw();
   if (mark->must_be_preserved(obj) &&
@@ -37,6 +37,7 @@
 #include "logging/log.hpp"
 #include "memory/iterator.inline.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "utilities/ticks.hpp"
 
 bool G1FullGCPrepareTask::G1CalculatePointersClosure::do_heap_region(HeapRegion* hr) {
@@ -50,7 +51,11 @@ bool G1FullGCPrepareTask::G1CalculatePointersClosure::do_heap_region(HeapRegion*
       free_humongous_region(hr);
     }
   } else if (!hr->is_pinned()) {
-    prepare_for_compaction(hr);
+    if (should_compact(hr)) {
+      prepare_for_compaction(hr);
+    } else {
+      prepare_for_skip_compaction(hr);
+    }
   }
 
   // Reset data structures not valid after Full GC.
@@ -62,6 +67,7 @@ bool G1FullGCPrepareTask::G1CalculatePointersClosure::do_heap_region(HeapRegion*
 G1FullGCPrepareTask::G1FullGCPrepareTask(G1FullCollector* collector) :
     G1FullGCTask("G1 Prepare Compact Task", collector),
     _freed_regions(false),
+    _skipped_regions(0),
     _hrclaimer(collector->workers()) {
 }
 
@@ -75,10 +81,14 @@ bool G1FullGCPrepareTask::has_freed_regions() {
   return _freed_regions;
 }
 
+uint G1FullGCPrepareTask::skipped_regions() {
+  return _skipped_regions;
+}
+
 void G1FullGCPrepareTask::work(uint worker_id) {
   Ticks start = Ticks::now();
   G1FullGCCompactionPoint* compaction_point = collector()->compaction_point(worker_id);
-  G1CalculatePointersClosure closure(collector()->mark_bitmap(), compaction_point);
+  G1CalculatePointersClosure closure(collector(), compaction_point);
   G1CollectedHeap::heap()->heap_region_par_iterate_from_start(&closure, &_hrclaimer);
 
   // Update humongous region sets
@@ -89,15 +99,20 @@ void G1FullGCPrepareTask::work(uint worker_id) {
   if (closure.freed_regions()) {
     set_freed_regions();
   }
+  if (closure.skipped_regions() > 0) {
+    Atomic::add(closure.skipped_regions(), &_skipped_regions);
+  }
   log_task("Prepare compaction task", worker_id, start);
 }
 
-G1FullGCPrepareTask::G1CalculatePointersClosure::G1CalculatePointersClosure(G1CMBitMap* bitmap,
+G1FullGCPrepareTask::G1CalculatePointersClosure::G1CalculatePointersClosure(G1FullCollector* collector,
                                                                             G1FullGCCompactionPoint* cp) :
     _g1h(G1CollectedHeap::heap()),
-    _bitmap(bitmap),
+    _collector(collector),
+    _bitmap(collector->mark_bitmap()),
     _cp(cp),
-    _humongous_regions_removed(0) { }
+    _humongous_regions_removed(0),
+    _skipped_regions(0) { }
 
 void G1FullGCPrepareTask::G1CalculatePointersClosure::free_humongous_region(HeapRegion* hr) {
   FreeRegionList dummy_free_list("Dummy Free List for G1MarkSweep");
@@ -160,6 +175,64 @@ void G1FullGCPrepareTask::G1CalculatePointersClosure::prepare_for_compaction(Hea
   prepare_for_compaction_work(_cp, hr);
 }
 
+bool G1FullGCPrepareTask::G1CalculatePointersClosure::should_compact(HeapRegion* hr) {
+  // Only old regions keep an up to date BOT, which is required to
+  // leave the region in place.
+  if (!hr->is_old()) {
+    return true;
+  }
+  // Moving the objects of a dense region frees little space for the
+  // cost of copying almost all of it.
+  return _collector->live_words(hr->hrm_index()) <= _collector->scope()->region_compaction_threshold();
+}
+
+void G1FullGCPrepareTask::G1CalculatePointersClosure::fill_dead_range(HeapRegion* hr,
+                                                                      HeapWord* start,
+                                                                      HeapWord* end,
+                                                                      HeapWord*& threshold) {
+  // Dead objects may refer to unloaded classes, so replace them with
+  // filler objects and record those in the BOT.
+  CollectedHeap::fill_with_objects(start, pointer_delta(end, start));
+  while (start < end) {
+    HeapWord* obj_end = start + oop(start)->size();
+    if (obj_end > threshold) {
+      threshold = hr->cross_threshold(start, obj_end);
+    }
+    start = obj_end;
+  }
+}
+
+void G1FullGCPrepareTask::G1CalculatePointersClosure::prepare_for_skip_compaction(HeapRegion* hr) {
+  HeapWord* const limit = hr->top();
+  HeapWord* threshold = hr->initialize_threshold();
+  HeapWord* addr = hr->bottom();
+
+  while (addr < limit) {
+    HeapWord* live = _bitmap->get_next_marked_addr(addr, limit);
+    if (addr < live) {
+      fill_dead_range(hr, addr, live, threshold);
+    }
+    if (live == limit) {
+      break;
+    }
+
+    // The object does not move, make sure it is not seen as forwarded.
+    // The original mark has been preserved during marking if needed.
+    oop obj = oop(live);
+    if (obj->forwardee() != NULL) {
+      obj->init_mark_raw();
+    }
+    addr = live + obj->size();
+    if (addr > threshold) {
+      threshold = hr->cross_threshold(live, addr);
+    }
+  }
+
+  hr->set_compaction_top(limit);
+  _collector->set_skip_compacting(hr->hrm_index());
+  _skipped_regions++;
+}
+
 void G1FullGCPrepareTask::prepare_serial_compaction() {
   GCTraceTime(Debug, gc, phases) debug("Phase 2: Prepare Serial Compaction", collector()->scope()->timer());
   // At this point we know that no regions were completely freed by
@@ -198,6 +271,10 @@ void G1FullGCPrepareTask::G1CalculatePointersClosure::update_sets() {
   _g1h->remove_from_old_sets(0, _humongous_regions_removed);
 }
 
+uint G1FullGCPrepareTask::G1CalculatePointersClosure::skipped_regions() {
+  return _skipped_regions;
+}
+
 bool G1FullGCPrepareTask::G1CalculatePointersClosure::freed_regions() {
   if (_humongous_regions_removed > 0) {
     // Free regions from dead humongous regions.
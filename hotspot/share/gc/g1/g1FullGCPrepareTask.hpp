@@ -38,6 +38,7 @@ class G1CMBitMap;
 class G1FullGCPrepareTask : public G1FullGCTask {
 protected:
   volatile bool     _freed_regions;
+  volatile uint     _skipped_regions;
   HeapRegionClaimer _hrclaimer;
 
   void set_freed_regions();
@@ -47,27 +48,35 @@ public:
   void work(uint worker_id);
   void prepare_serial_compaction();
   bool has_freed_regions();
+  uint skipped_regions();
 
 protected:
   class G1CalculatePointersClosure : public HeapRegionClosure {
   protected:
     G1CollectedHeap* _g1h;
+    G1FullCollector* _collector;
     G1CMBitMap* _bitmap;
     G1FullGCCompactionPoint* _cp;
     uint _humongous_regions_removed;
+    uint _skipped_regions;
 
+    bool should_compact(HeapRegion* hr);
     virtual void prepare_for_compaction(HeapRegion* hr);
     void prepare_for_compaction_work(G1FullGCCompactionPoint* cp, HeapRegion* hr);
+    // Leave a dense region in place instead of adding it to a compaction queue.
+    void prepare_for_skip_compaction(HeapRegion* hr);
+    void fill_dead_range(HeapRegion* hr, HeapWord* start, HeapWord* end, HeapWord*& threshold);
     void free_humongous_region(HeapRegion* hr);
     void reset_region_metadata(HeapRegion* hr);
 
   public:
-    G1CalculatePointersClosure(G1CMBitMap* bitmap,
+    G1CalculatePointersClosure(G1FullCollector* collector,
                                G1FullGCCompactionPoint* cp);
 
     void update_sets();
     bool do_heap_region(HeapRegion* hr);
     bool freed_regions();
+    uint skipped_regions();
   };
 
   class G1PrepareCompactLiveClosure : public StackObj {
@@ -37,7 +37,14 @@ G1FullGCScope::G1FullGCScope(G1MonitoringSupport* monitoring_support, bool expli
     _cpu_time(),
     _soft_refs(clear_soft, _g1h->soft_ref_policy()),
     _monitoring_scope(monitoring_support, true /* full_gc */, true /* all_memory_pools_affected */),
-    _heap_transition(_g1h) {
+    _heap_transition(_g1h),
+    _region_compaction_threshold(HeapRegion::GrainWords) {
+  // Every MarkSweepAlwaysCompactCount collections, and whenever soft
+  // references are cleared as a last resort, compact all regions.
+  if (!should_clear_soft_refs() &&
+      (_g1h->total_full_collections() % MarkSweepAlwaysCompactCount) != 0) {
+    _region_compaction_threshold = HeapRegion::GrainWords * (100 - MarkSweepDeadRatio) / 100;
+  }
   _timer.register_gc_start();
   _tracer.report_gc_start(_g1h->gc_cause(), _timer.gc_start());
   _g1h->pre_full_gc_dump(&_timer);
@@ -75,3 +82,7 @@ G1FullGCTracer* G1FullGCScope::tracer() {
 G1HeapTransition* G1FullGCScope::heap_transition() {
   return &_heap_transition;
 }
+
+size_t G1FullGCScope::region_compaction_threshold() {
+  return _region_compaction_threshold;
+}
@@ -52,6 +52,7 @@ class G1FullGCScope : public StackObj {
   ClearedAllSoftRefs      _soft_refs;
   G1MonitoringScope       _monitoring_scope;
   G1HeapTransition        _heap_transition;
+  size_t                  _region_compaction_threshold;
 
 public:
   G1FullGCScope(G1MonitoringSupport* monitoring_support, bool explicit_gc, bool clear_soft);
@@ -63,6 +64,9 @@ public:
   STWGCTimer* timer();
   G1FullGCTracer* tracer();
   G1HeapTransition* heap_transition();
+
+  // Regions with more live words than this are not compacted.
+  size_t region_compaction_threshold();
 };
 
 #endif // SHARE_GC_G1_G1FULLGCSCOPE_HPP
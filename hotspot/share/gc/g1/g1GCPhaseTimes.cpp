@@ -29,6 +29,7 @@
 #include "gc/g1/g1ParScanThreadState.inline.hpp"
 #include "gc/g1/g1StringDedup.hpp"
 #include "gc/shared/gcTimer.hpp"
+#include "gc/shared/gcTrace.hpp"
 #include "gc/shared/workerDataArray.inline.hpp"
 #include "memory/resourceArea.hpp"
 #include "logging/log.hpp"
@@ -109,15 +110,28 @@ G1GCPhaseTimes::G1GCPhaseTimes(STWGCTimer* gc_timer, uint max_gc_threads) :
   _update_rs_skipped_cards = new WorkerDataArray<size_t>(max_gc_threads, "Skipped Cards:");
   _gc_par_phases[UpdateRS]->link_thread_work_items(_update_rs_skipped_cards, UpdateRSSkippedCards);
 
+  _code_roots_scanned_nmethods = new WorkerDataArray<size_t>(max_gc_threads, "Scanned NMethods:");
+  _gc_par_phases[CodeRoots]->link_thread_work_items(_code_roots_scanned_nmethods, CodeRootsScannedNMethods);
+  _opt_code_roots_scanned_nmethods = new WorkerDataArray<size_t>(max_gc_threads, "Scanned NMethods:");
+  _gc_par_phases[OptCodeRoots]->link_thread_work_items(_opt_code_roots_scanned_nmethods, CodeRootsScannedNMethods);
+
   _obj_copy_lab_waste = new WorkerDataArray<size_t>(max_gc_threads, "LAB Waste");
   _gc_par_phases[ObjCopy]->link_thread_work_items(_obj_copy_lab_waste, ObjCopyLABWaste);
   _obj_copy_lab_undo_waste = new WorkerDataArray<size_t>(max_gc_threads, "LAB Undo Waste");
   _gc_par_phases[ObjCopy]->link_thread_work_items(_obj_copy_lab_undo_waste, ObjCopyLABUndoWaste);
+  _obj_copy_lab_refills = new WorkerDataArray<size_t>(max_gc_threads, "LAB Refills");
+  _gc_par_phases[ObjCopy]->link_thread_work_items(_obj_copy_lab_refills, ObjCopyLABRefills);
+  _obj_copy_direct_allocated = new WorkerDataArray<size_t>(max_gc_threads, "Direct Allocated");
+  _gc_par_phases[ObjCopy]->link_thread_work_items(_obj_copy_direct_allocated, ObjCopyDirectAllocated);
 
   _opt_obj_copy_lab_waste = new WorkerDataArray<size_t>(max_gc_threads, "LAB Waste");
   _gc_par_phases[OptObjCopy]->link_thread_work_items(_obj_copy_lab_waste, ObjCopyLABWaste);
   _opt_obj_copy_lab_undo_waste  = new WorkerDataArray<size_t>(max_gc_threads, "LAB Undo Waste");
   _gc_par_phases[OptObjCopy]->link_thread_work_items(_obj_copy_lab_undo_waste, ObjCopyLABUndoWaste);
+  _opt_obj_copy_lab_refills = new WorkerDataArray<size_t>(max_gc_threads, "LAB Refills");
+  _gc_par_phases[OptObjCopy]->link_thread_work_items(_opt_obj_copy_lab_refills, ObjCopyLABRefills);
+  _opt_obj_copy_direct_allocated = new WorkerDataArray<size_t>(max_gc_threads, "Direct Allocated");
+  _gc_par_phases[OptObjCopy]->link_thread_work_items(_opt_obj_copy_direct_allocated, ObjCopyDirectAllocated);
 
   _termination_attempts = new WorkerDataArray<size_t>(max_gc_threads, "Termination Attempts:");
   _gc_par_phases[Termination]->link_thread_work_items(_termination_attempts);
@@ -513,6 +527,19 @@ void G1GCPhaseTimes::print() {
   }
 }
 
+void G1GCPhaseTimes::report_par_phases(GCTracer* tracer) const {
+  for (int i = 0; i < GCParPhasesSentinel; i++) {
+    const GCParPhases phase = (GCParPhases)i;
+    if (phase == GCWorkerStart || phase == GCWorkerEnd) {
+      // timestamps, not durations
+      continue;
+    }
+    if (_gc_par_phases[phase] != NULL) {
+      tracer->report_gc_phase_parallel_summary(phase_name(phase), _gc_par_phases[phase]);
+    }
+  }
+}
+
 const char* G1GCPhaseTimes::phase_name(GCParPhases phase) {
   static const char* names[] = {
       "GCWorkerStart",
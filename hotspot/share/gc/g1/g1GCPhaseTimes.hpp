@@ -34,6 +34,7 @@
 
 class LineBuffer;
 class G1ParScanThreadState;
+class GCTracer;
 class STWGCTimer;
 
 template <class T> class WorkerDataArray;
@@ -100,7 +101,13 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
 
   enum GCObjCopyWorkItems {
     ObjCopyLABWaste,
-    ObjCopyLABUndoWaste
+    ObjCopyLABUndoWaste,
+    ObjCopyLABRefills,
+    ObjCopyDirectAllocated
+  };
+
+  enum GCCodeRootsWorkItems {
+    CodeRootsScannedNMethods
   };
 
  private:
@@ -123,11 +130,18 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
   WorkerDataArray<size_t>* _opt_scan_rs_scanned_opt_refs;
   WorkerDataArray<size_t>* _opt_scan_rs_used_memory;
 
+  WorkerDataArray<size_t>* _code_roots_scanned_nmethods;
+  WorkerDataArray<size_t>* _opt_code_roots_scanned_nmethods;
+
   WorkerDataArray<size_t>* _obj_copy_lab_waste;
   WorkerDataArray<size_t>* _obj_copy_lab_undo_waste;
+  WorkerDataArray<size_t>* _obj_copy_lab_refills;
+  WorkerDataArray<size_t>* _obj_copy_direct_allocated;
 
   WorkerDataArray<size_t>* _opt_obj_copy_lab_waste;
   WorkerDataArray<size_t>* _opt_obj_copy_lab_undo_waste;
+  WorkerDataArray<size_t>* _opt_obj_copy_lab_refills;
+  WorkerDataArray<size_t>* _opt_obj_copy_direct_allocated;
 
   WorkerDataArray<size_t>* _termination_attempts;
 
@@ -217,6 +231,8 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
   G1GCPhaseTimes(STWGCTimer* gc_timer, uint max_gc_threads);
   void note_gc_start();
   void print();
+  // Sends the per-worker distribution of every phase the workers took part in
+  void report_par_phases(GCTracer* tracer) const;
   static const char* phase_name(GCParPhases phase);
 
   // record the time a phase took in seconds
@@ -369,6 +385,14 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     return _cur_collection_initial_evac_time_ms;
   }
 
+  double cur_optional_evac_time_ms() {
+    return _cur_optional_evac_ms;
+  }
+
+  double cur_ref_proc_time_ms() {
+    return _cur_ref_proc_time_ms;
+  }
+
   double cur_clear_ct_time_ms() {
     return _cur_clear_ct_time_ms;
   }
@@ -156,3 +156,22 @@ size_t G1HeapSizingPolicy::expansion_amount() {
 
   return expand_bytes;
 }
+
+size_t G1HeapSizingPolicy::uncommit_amount() const {
+  // Count used as full regions to include the waste, as for the resize
+  // after a full GC.
+  const size_t capacity = _g1h->capacity();
+  const size_t used = capacity - _g1h->unused_committed_regions_in_bytes();
+
+  const double minimum_used_percentage = 1.0 - (double) MaxHeapFreeRatio / 100.0;
+  double maximum_desired_capacity_d = (double) MaxHeapSize;
+  if (minimum_used_percentage > 0.0) {
+    maximum_desired_capacity_d = MIN2((double) used / minimum_used_percentage, maximum_desired_capacity_d);
+  }
+  size_t maximum_desired_capacity = MAX2((size_t) maximum_desired_capacity_d, MinHeapSize);
+
+  if (capacity <= maximum_desired_capacity) {
+    return 0;
+  }
+  return capacity - maximum_desired_capacity;
+}
@@ -57,6 +57,11 @@ public:
   // Clear ratio tracking data used by expansion_amount().
   void clear_ratio_check_data();
 
+  // Return the amount of committed memory above the capacity allowed by
+  // MaxHeapFreeRatio for the current heap occupancy, to be given back
+  // by periodic uncommit.
+  size_t uncommit_amount() const;
+
   static G1HeapSizingPolicy* create(const G1CollectedHeap* g1h, const G1Analytics* analytics);
 };
 
@@ -26,6 +26,7 @@
 #include "gc/g1/g1CollectedHeap.inline.hpp"
 #include "gc/g1/g1DirtyCardQueue.hpp"
 #include "gc/g1/g1HotCardCache.hpp"
+#include "logging/log.hpp"
 #include "runtime/atomic.hpp"
 
 G1HotCardCache::G1HotCardCache(G1CollectedHeap *g1h):
@@ -110,6 +111,30 @@ void G1HotCardCache::drain(G1CardTableEntryClosure* cl, uint worker_i) {
   // above, are discarded prior to re-enabling the cache near the end of the GC.
 }
 
+void G1HotCardCache::adjust_hot_threshold() {
+  if (G1ConcRSHotCardLimit == 0) {
+    // Every card is hot; there is no threshold to adapt.
+    return;
+  }
+
+  size_t inserted = _hot_cache_idx;
+  uint old_threshold = _card_counts.hot_threshold();
+  uint new_threshold = old_threshold;
+  if (inserted > 2 * _hot_cache_size) {
+    // Most hot cards were evicted, and refined, before this pause.
+    new_threshold = MIN2(old_threshold * 2, (uint)max_jubyte);
+  } else if (inserted < _hot_cache_size / 2) {
+    new_threshold = MAX2(old_threshold / 2, (uint)G1ConcRSHotCardLimit);
+  }
+
+  if (new_threshold != old_threshold) {
+    _card_counts.set_hot_threshold(new_threshold);
+    log_debug(gc, refine)("Hot card cache: " SIZE_FORMAT " cards inserted into " SIZE_FORMAT " entries, "
+                          "hot card threshold %u -> %u",
+                          inserted, _hot_cache_size, old_threshold, new_threshold);
+  }
+}
+
 void G1HotCardCache::reset_card_counts(HeapRegion* hr) {
   _card_counts.clear_region(hr);
 }
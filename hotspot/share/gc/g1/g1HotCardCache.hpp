@@ -50,6 +50,14 @@ class HeapRegion;
 //
 // This can significantly reduce the overhead of the write barrier
 // code, increasing throughput.
+//
+// The cache is a ring, so when more hot cards are logged between two
+// pauses than it can hold, hot cards are evicted and refined while they
+// are still being written to. At the end of every pause the number of
+// cards inserted since the last one is used to adjust the hotness
+// threshold of the card counts: a thrashing cache only admits hotter
+// cards, an underused one lowers the threshold back towards
+// G1ConcRSHotCardLimit.
 
 class G1HotCardCache: public CHeapObj<mtGC> {
 public:
@@ -125,7 +133,8 @@ private:
     assert(SafepointSynchronize::is_at_safepoint(), "Should be at a safepoint");
     assert(Thread::current()->is_VM_thread(), "Current thread should be the VMthread");
     if (default_use_cache()) {
-        reset_hot_cache_internal();
+      adjust_hot_threshold();
+      reset_hot_cache_internal();
     }
   }
 
@@ -133,6 +142,10 @@ private:
   void reset_card_counts(HeapRegion* hr);
 
  private:
+  // Adapts the card counts hotness threshold to the number of cards
+  // inserted since the last reset.
+  void adjust_hot_threshold();
+
   void reset_hot_cache_internal() {
     assert(_hot_cache != NULL, "Logic");
     _hot_cache_idx = 0;
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/g1NUMA.hpp"
+#include "logging/log.hpp"
+#include "memory/allocation.inline.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/os.hpp"
+#include "utilities/align.hpp"
+
+G1NUMA* G1NUMA::_inst = NULL;
+
+G1NUMA* G1NUMA::create() {
+  guarantee(_inst == NULL, "Should be called once.");
+  _inst = new G1NUMA();
+  // Heterogeneous heaps place regions by memory type rather than by node.
+  _inst->initialize(UseNUMA && AllocateOldGenAt == NULL);
+  return _inst;
+}
+
+G1NUMA::G1NUMA() :
+  _node_id_to_index_map(NULL), _len_node_id_to_index_map(0),
+  _node_ids(NULL), _num_active_node_ids(0),
+  _region_size(0), _page_size(0) {
+}
+
+G1NUMA::~G1NUMA() {
+  FREE_C_HEAP_ARRAY(uint, _node_id_to_index_map);
+  FREE_C_HEAP_ARRAY(int, _node_ids);
+}
+
+void G1NUMA::initialize(bool use_numa) {
+  size_t num_node_ids = use_numa ? os::numa_get_groups_num() : 1;
+  _node_ids = NEW_C_HEAP_ARRAY(int, MAX2(num_node_ids, (size_t)1), mtGC);
+  _num_active_node_ids = use_numa ? (uint)os::numa_get_leaf_groups(_node_ids, num_node_ids) : 0;
+
+  if (_num_active_node_ids <= 1) {
+    // Either NUMA is not in use or there is nothing to choose from;
+    // treat the whole heap as a single node.
+    _node_ids[0] = 0;
+    _num_active_node_ids = 1;
+  }
+
+  int max_node_id = 0;
+  for (uint i = 0; i < _num_active_node_ids; i++) {
+    max_node_id = MAX2(max_node_id, _node_ids[i]);
+  }
+
+  _len_node_id_to_index_map = max_node_id + 1;
+  _node_id_to_index_map = NEW_C_HEAP_ARRAY(uint, _len_node_id_to_index_map, mtGC);
+  for (int i = 0; i < _len_node_id_to_index_map; i++) {
+    _node_id_to_index_map[i] = UnknownNodeIndex;
+  }
+  for (uint i = 0; i < _num_active_node_ids; i++) {
+    _node_id_to_index_map[_node_ids[i]] = i;
+  }
+
+  if (is_enabled()) {
+    log_info(gc, heap)("NUMA-aware region allocation enabled, %u nodes", _num_active_node_ids);
+  }
+}
+
+void G1NUMA::set_region_info(size_t region_size, size_t page_size) {
+  _region_size = region_size;
+  _page_size = page_size;
+}
+
+int G1NUMA::numa_id(uint index) const {
+  assert(index < _num_active_node_ids, "Invalid node index %u", index);
+  return _node_ids[index];
+}
+
+uint G1NUMA::index_of_node_id(int node_id) const {
+  if (node_id < 0 || node_id >= _len_node_id_to_index_map) {
+    return UnknownNodeIndex;
+  }
+  return _node_id_to_index_map[node_id];
+}
+
+uint G1NUMA::index_of_current_thread() const {
+  if (!is_enabled()) {
+    return 0;
+  }
+  uint node_index = index_of_node_id(os::numa_get_group_id());
+  // The thread may run on a node without memory of its own, or one we
+  // are not allowed to allocate on. Any node will do then.
+  return node_index == UnknownNodeIndex ? 0 : node_index;
+}
+
+uint G1NUMA::preferred_node_index_for_index(uint region_index) const {
+  if (_region_size >= _page_size) {
+    return region_index % _num_active_node_ids;
+  } else {
+    // Several regions share a page; they must all map to the node of that page.
+    size_t regions_per_page = _page_size / _region_size;
+    return (uint)((region_index / regions_per_page) % _num_active_node_ids);
+  }
+}
+
+void G1NUMA::request_memory_on_node(void* aligned_address, size_t size_in_bytes, uint region_index) {
+  if (!is_enabled() || size_in_bytes == 0) {
+    return;
+  }
+
+  assert(is_aligned(aligned_address, _page_size), "Given address (" PTR_FORMAT ") should be aligned.", p2i(aligned_address));
+  assert(is_aligned(size_in_bytes, _page_size), "Given size (" SIZE_FORMAT ") should be aligned.", size_in_bytes);
+
+  uint node_index = preferred_node_index_for_index(region_index);
+
+  log_trace(gc, heap)("Request memory [" PTR_FORMAT ", " PTR_FORMAT ") to be NUMA id (%d)",
+                      p2i(aligned_address), p2i((char*)aligned_address + size_in_bytes),
+                      _node_ids[node_index]);
+  os::numa_make_local((char*)aligned_address, size_in_bytes, _node_ids[node_index]);
+}
+
+uint G1NUMA::max_search_depth() const {
+  // Regions are striped round-robin across the nodes, so looking at a few
+  // stripes worth of free regions is enough to find one on a given node
+  // if there is any nearby. If a page spans several regions, increase
+  // the search depth accordingly.
+  const uint StripesToSearch = 3;
+  size_t regions_per_stripe = _num_active_node_ids;
+  if (_region_size < _page_size) {
+    regions_per_stripe *= _page_size / _region_size;
+  }
+  return StripesToSearch * (uint)regions_per_stripe;
+}
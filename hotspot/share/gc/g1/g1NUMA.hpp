@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_G1_G1NUMA_HPP
+#define SHARE_GC_G1_G1NUMA_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/os.hpp"
+
+// Keeps track of the NUMA memory nodes G1 allocates heap regions from.
+//
+// Node ids as reported by the OS are not necessarily consecutive, so G1
+// works with node indexes in the range [0, num_active_nodes()) instead.
+// Without UseNUMA, or on a single node machine, there is exactly one
+// node with index 0 and all requests are no-ops.
+//
+// Heap regions are assigned to nodes in a round-robin fashion by their
+// region index, so that the heap is spread evenly across all nodes.
+class G1NUMA: public CHeapObj<mtGC> {
+  // Maps a node id to its node index; UnknownNodeIndex if the node id
+  // is not an active node.
+  uint* _node_id_to_index_map;
+  // Length of _node_id_to_index_map, i.e. the highest active node id plus one.
+  int _len_node_id_to_index_map;
+
+  // Active node ids, indexed by node index.
+  int* _node_ids;
+  uint _num_active_node_ids;
+
+  // Heap region size and the page size of the Java heap. Needed to
+  // decide the preferred node when a page spans several regions.
+  size_t _region_size;
+  size_t _page_size;
+
+  static G1NUMA* _inst;
+
+  G1NUMA();
+  void initialize(bool use_numa);
+
+  // Returns the node index of the given node id, UnknownNodeIndex if
+  // the node id is not active.
+  uint index_of_node_id(int node_id) const;
+
+public:
+  static const uint UnknownNodeIndex = UINT_MAX;
+  // Used to request a region without any node preference.
+  static const uint AnyNodeIndex = UnknownNodeIndex - 1;
+
+  static G1NUMA* numa() { return _inst; }
+  static G1NUMA* create();
+
+  ~G1NUMA();
+
+  // Sets the heap region and page sizes once they have been determined
+  // during heap initialization.
+  void set_region_info(size_t region_size, size_t page_size);
+
+  uint num_active_nodes() const { return _num_active_node_ids; }
+  bool is_enabled() const { return num_active_nodes() > 1; }
+
+  // Returns the node id of the given node index.
+  int numa_id(uint index) const;
+
+  // Returns the node index of the node the calling thread currently
+  // runs on. Always a valid node index.
+  uint index_of_current_thread() const;
+
+  // Returns the node index the given heap region is preferably placed on.
+  // If a page spans several regions, all these regions map to the node
+  // of that page.
+  uint preferred_node_index_for_index(uint region_index) const;
+
+  // Requests the memory of the given, just committed, range to be placed
+  // on the preferred node of the region at region_index.
+  void request_memory_on_node(void* aligned_address, size_t size_in_bytes, uint region_index);
+
+  // Maximum number of free regions to examine when looking for a region
+  // on a specific node before falling back to any node.
+  uint max_search_depth() const;
+};
+
+#endif // SHARE_GC_G1_G1NUMA_HPP
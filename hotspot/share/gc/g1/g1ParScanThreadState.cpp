@@ -113,6 +113,14 @@ size_t G1ParScanThreadState::lab_undo_waste_words() const {
   return _plab_allocator->undo_waste();
 }
 
+size_t G1ParScanThreadState::lab_refills() const {
+  return _plab_allocator->plab_fills();
+}
+
+size_t G1ParScanThreadState::direct_allocated_words() const {
+  return _plab_allocator->direct_allocated();
+}
+
 #ifdef ASSERT
 bool G1ParScanThreadState::verify_ref(narrowOop* ref) const {
   assert(ref != NULL, "invariant");
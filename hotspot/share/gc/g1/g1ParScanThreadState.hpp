@@ -138,6 +138,8 @@ public:
 
   size_t lab_waste_words() const;
   size_t lab_undo_waste_words() const;
+  size_t lab_refills() const;
+  size_t direct_allocated_words() const;
 
   size_t* surviving_young_words() {
     // We add one to hide entry 0 which accumulates surviving words for
@@ -42,6 +42,7 @@
 #include "gc/g1/heapRegion.inline.hpp"
 #include "gc/g1/heapRegionRemSet.hpp"
 #include "gc/shared/gcPolicyCounters.hpp"
+#include "gc/shared/gcTrace.hpp"
 #include "logging/logStream.hpp"
 #include "runtime/arguments.hpp"
 #include "runtime/java.hpp"
@@ -83,6 +84,9 @@ G1Policy::G1Policy(STWGCTimer* gc_timer) :
   _max_survivor_regions(0),
   _survivors_age_table(true)
 {
+  for (uint i = 0; i < PausePhaseSentinel; i++) {
+    _predicted_phase_time_ms[i] = 0.0;
+  }
 }
 
 G1Policy::~G1Policy() {
@@ -538,12 +542,127 @@ double G1Policy::non_young_other_time_ms() const {
          phase_times()->average_time_ms(G1GCPhaseTimes::NonYoungFreeCSet);
 }
 
-double G1Policy::other_time_ms(double pause_time_ms) const {
-  return pause_time_ms - phase_times()->cur_collection_par_time_ms();
+double G1Policy::predicted_par_phases_time_ms() const {
+  double scan_hcc_time_ms = G1HotCardCache::default_use_cache() ? average_time_ms(G1GCPhaseTimes::ScanHCC) : 0.0;
+  return average_time_ms(G1GCPhaseTimes::ExtRootScan) +
+         average_time_ms(G1GCPhaseTimes::UpdateRS) + scan_hcc_time_ms +
+         average_time_ms(G1GCPhaseTimes::ScanRS) + average_time_ms(G1GCPhaseTimes::OptScanRS) +
+         average_time_ms(G1GCPhaseTimes::CodeRoots) + average_time_ms(G1GCPhaseTimes::OptCodeRoots) +
+         average_time_ms(G1GCPhaseTimes::ObjCopy) + average_time_ms(G1GCPhaseTimes::OptObjCopy);
 }
 
 double G1Policy::constant_other_time_ms(double pause_time_ms) const {
-  return other_time_ms(pause_time_ms) - phase_times()->total_free_cset_time_ms();
+  // Everything not covered by a prediction of its own. This includes time
+  // lost to termination and load imbalance within the evacuation phases.
+  double other_time_ms = pause_time_ms -
+                         predicted_par_phases_time_ms() -
+                         phase_times()->cur_ref_proc_time_ms() -
+                         phase_times()->total_free_cset_time_ms();
+  return MAX2(other_time_ms, 0.0);
+}
+
+const char* G1Policy::pause_phase_name(PausePhase phase) {
+  static const char* names[] = {
+      "Root Scanning",
+      "Update RS",
+      "Scan RS",
+      "Code Root Scanning",
+      "Object Copy",
+      "Reference Processing",
+      "Other"
+  };
+  STATIC_ASSERT(PausePhaseSentinel == ARRAY_SIZE(names));
+  return names[phase];
+}
+
+void G1Policy::actual_phase_times_ms(double pause_time_ms, double* phase_times_ms) const {
+  double scan_hcc_time_ms = G1HotCardCache::default_use_cache() ? average_time_ms(G1GCPhaseTimes::ScanHCC) : 0.0;
+  phase_times_ms[RootScanPhase] = average_time_ms(G1GCPhaseTimes::ExtRootScan);
+  phase_times_ms[UpdateRSPhase] = average_time_ms(G1GCPhaseTimes::UpdateRS) + scan_hcc_time_ms;
+  phase_times_ms[ScanRSPhase] = average_time_ms(G1GCPhaseTimes::ScanRS) + average_time_ms(G1GCPhaseTimes::OptScanRS);
+  phase_times_ms[CodeRootScanPhase] = average_time_ms(G1GCPhaseTimes::CodeRoots) + average_time_ms(G1GCPhaseTimes::OptCodeRoots);
+  phase_times_ms[ObjCopyPhase] = average_time_ms(G1GCPhaseTimes::ObjCopy) + average_time_ms(G1GCPhaseTimes::OptObjCopy);
+  phase_times_ms[RefProcPhase] = phase_times()->cur_ref_proc_time_ms();
+
+  double accounted_ms = 0.0;
+  for (uint i = 0; i < OtherPhase; i++) {
+    accounted_ms += phase_times_ms[i];
+  }
+  phase_times_ms[OtherPhase] = MAX2(pause_time_ms - accounted_ms, 0.0);
+}
+
+class G1PredictPausePhasesClosure : public HeapRegionClosure {
+  const G1Policy* _policy;
+  bool _for_young_gc;
+
+  size_t _card_num;
+  size_t _code_root_num;
+  size_t _bytes_to_copy;
+  uint _young_num;
+  uint _non_young_num;
+
+public:
+  G1PredictPausePhasesClosure(const G1Policy* policy, bool for_young_gc) :
+    _policy(policy),
+    _for_young_gc(for_young_gc),
+    _card_num(0),
+    _code_root_num(0),
+    _bytes_to_copy(0),
+    _young_num(0),
+    _non_young_num(0) { }
+
+  virtual bool do_heap_region(HeapRegion* r) {
+    _card_num += _policy->analytics()->predict_card_num(r->rem_set()->occupied(), _for_young_gc);
+    _code_root_num += r->rem_set()->strong_code_roots_list_length();
+    _bytes_to_copy += _policy->predict_bytes_to_copy(r);
+    if (r->is_young()) {
+      _young_num++;
+    } else {
+      _non_young_num++;
+    }
+    return false;
+  }
+
+  size_t card_num() const { return _card_num; }
+  size_t code_root_num() const { return _code_root_num; }
+  size_t bytes_to_copy() const { return _bytes_to_copy; }
+  uint young_num() const { return _young_num; }
+  uint non_young_num() const { return _non_young_num; }
+};
+
+void G1Policy::record_pause_phase_predictions() {
+  bool for_young_gc = collector_state()->in_young_only_phase();
+  G1PredictPausePhasesClosure cl(this, for_young_gc);
+  _collection_set->iterate(&cl);
+
+  _predicted_phase_time_ms[RootScanPhase] = _analytics->predict_root_scan_time_ms();
+  _predicted_phase_time_ms[UpdateRSPhase] = _analytics->predict_rs_update_time_ms(_pending_cards);
+  _predicted_phase_time_ms[ScanRSPhase] = _analytics->predict_rs_scan_time_ms(cl.card_num(), for_young_gc);
+  _predicted_phase_time_ms[CodeRootScanPhase] = _analytics->predict_code_root_scan_time_ms(cl.code_root_num());
+  _predicted_phase_time_ms[ObjCopyPhase] =
+    _analytics->predict_object_copy_time_ms(cl.bytes_to_copy(), collector_state()->mark_or_rebuild_in_progress());
+  _predicted_phase_time_ms[RefProcPhase] = _analytics->predict_ref_proc_time_ms();
+  _predicted_phase_time_ms[OtherPhase] = _analytics->predict_constant_other_time_ms() +
+                                         _analytics->predict_young_other_time_ms(cl.young_num()) +
+                                         _analytics->predict_non_young_other_time_ms(cl.non_young_num());
+}
+
+void G1Policy::report_pause_phase_predictions(double pause_time_ms) const {
+  double actual_ms[PausePhaseSentinel];
+  actual_phase_times_ms(pause_time_ms, actual_ms);
+
+  double predicted_total_ms = 0.0;
+  for (uint i = 0; i < PausePhaseSentinel; i++) {
+    PausePhase phase = (PausePhase)i;
+    log_debug(gc, ergo)("Pause phase %s: predicted %1.2fms actual %1.2fms",
+                        pause_phase_name(phase), _predicted_phase_time_ms[i], actual_ms[i]);
+    _g1h->gc_tracer_stw()->report_pause_phase_prediction(pause_phase_name(phase),
+                                                         _predicted_phase_time_ms[i],
+                                                         actual_ms[i]);
+    predicted_total_ms += _predicted_phase_time_ms[i];
+  }
+  log_debug(gc, ergo)("Pause time: predicted %1.2fms (initial collection set) actual %1.2fms target %1.2fms",
+                      predicted_total_ms, pause_time_ms, max_pause_time_ms());
 }
 
 bool G1Policy::about_to_start_mixed_phase() const {
@@ -587,6 +706,8 @@ void G1Policy::record_collection_pause_end(double pause_time_ms, size_t cards_sc
 
   record_pause(young_gc_pause_kind(), end_time_sec - pause_time_ms / 1000.0, end_time_sec);
 
+  report_pause_phase_predictions(pause_time_ms);
+
   _collection_pause_end_millis = os::javaTimeNanos() / NANOSECS_PER_MILLISEC;
 
   this_pause_included_initial_mark = collector_state()->in_initial_mark_gc();
@@ -700,6 +821,16 @@ void G1Policy::record_collection_pause_end(double pause_time_ms, size_t cards_sc
       _analytics->report_cost_per_byte_ms(cost_per_byte_ms, collector_state()->mark_or_rebuild_in_progress());
     }
 
+    size_t code_roots_scanned = phase_times()->sum_thread_work_items(G1GCPhaseTimes::CodeRoots, G1GCPhaseTimes::CodeRootsScannedNMethods) +
+                                phase_times()->sum_thread_work_items(G1GCPhaseTimes::OptCodeRoots, G1GCPhaseTimes::CodeRootsScannedNMethods);
+    if (code_roots_scanned > 0) {
+      double cost_per_code_root_ms = (average_time_ms(G1GCPhaseTimes::CodeRoots) + average_time_ms(G1GCPhaseTimes::OptCodeRoots)) / (double) code_roots_scanned;
+      _analytics->report_cost_per_code_root_ms(cost_per_code_root_ms);
+    }
+
+    _analytics->report_root_scan_time_ms(average_time_ms(G1GCPhaseTimes::ExtRootScan));
+    _analytics->report_ref_proc_time_ms(phase_times()->cur_ref_proc_time_ms());
+
     if (_collection_set->young_region_length() > 0) {
       _analytics->report_young_other_cost_per_region_ms(young_other_time_ms() /
                                                         _collection_set->young_region_length());
@@ -852,6 +983,8 @@ double G1Policy::predict_base_elapsed_time_ms(size_t pending_cards,
   return
     _analytics->predict_rs_update_time_ms(pending_cards) +
     _analytics->predict_rs_scan_time_ms(scanned_cards, collector_state()->in_young_only_phase()) +
+    _analytics->predict_root_scan_time_ms() +
+    _analytics->predict_ref_proc_time_ms() +
     _analytics->predict_constant_other_time_ms();
 }
 
@@ -884,6 +1017,7 @@ double G1Policy::predict_region_elapsed_time_ms(HeapRegion* hr,
 
   double region_elapsed_time_ms =
     _analytics->predict_rs_scan_time_ms(card_num, collector_state()->in_young_only_phase()) +
+    _analytics->predict_code_root_scan_time_ms(hr->rem_set()->strong_code_roots_list_length()) +
     _analytics->predict_object_copy_time_ms(bytes_to_copy, collector_state()->mark_or_rebuild_in_progress());
 
   // The prediction of the "other" time for this region is based
@@ -1029,8 +1163,9 @@ void G1Policy::decide_on_conc_mark_initiation() {
   }
 }
 
-void G1Policy::record_concurrent_mark_cleanup_end() {
-  G1CollectionSetCandidates* candidates = G1CollectionSetChooser::build(_g1h->workers(), _g1h->num_regions());
+void G1Policy::record_concurrent_mark_cleanup_end(G1CollectionSetCandidates* candidates) {
+  assert(candidates != NULL, "must be");
+  candidates->verify();
   _collection_set->set_candidates(candidates);
 
   bool mixed_gc_pending = next_gc_should_be_mixed("request mixed gcs", "request young-only gcs");
@@ -142,6 +142,10 @@ public:
 
   double predict_survivor_regions_evac_time() const;
 
+  // Record the per phase pause time prediction for the just finalized
+  // initial collection set.
+  void record_pause_phase_predictions();
+
   void cset_regions_freed() {
     bool update = should_update_surv_rate_group_predictors();
 
@@ -170,12 +174,33 @@ public:
 private:
   G1CollectionSet* _collection_set;
   double average_time_ms(G1GCPhaseTimes::GCParPhases phase) const;
-  double other_time_ms(double pause_time_ms) const;
 
   double young_other_time_ms() const;
   double non_young_other_time_ms() const;
   double constant_other_time_ms(double pause_time_ms) const;
 
+  // The parts of the pause predicted separately, used to compare the
+  // prediction for the initial collection set with the actual pause.
+  enum PausePhase {
+    RootScanPhase,
+    UpdateRSPhase,
+    ScanRSPhase,
+    CodeRootScanPhase,
+    ObjCopyPhase,
+    RefProcPhase,
+    OtherPhase,
+    PausePhaseSentinel
+  };
+  static const char* pause_phase_name(PausePhase phase);
+
+  double _predicted_phase_time_ms[PausePhaseSentinel];
+
+  // Per worker average time spent in the pause phases that have a prediction
+  // of their own, excluding reference processing.
+  double predicted_par_phases_time_ms() const;
+  void actual_phase_times_ms(double pause_time_ms, double* phase_times_ms) const;
+  void report_pause_phase_predictions(double pause_time_ms) const;
+
   G1CollectionSetChooser* cset_chooser() const;
 
   // The number of bytes copied during the GC.
@@ -324,9 +349,10 @@ public:
   void record_concurrent_mark_remark_start();
   void record_concurrent_mark_remark_end();
 
-  // Record start, end, and completion of cleanup.
+  // Record start, end, and completion of cleanup. Takes ownership of the
+  // collection set candidates selected after the remembered set rebuild.
   void record_concurrent_mark_cleanup_start();
-  void record_concurrent_mark_cleanup_end();
+  void record_concurrent_mark_cleanup_end(G1CollectionSetCandidates* candidates);
 
   void print_phases();
 
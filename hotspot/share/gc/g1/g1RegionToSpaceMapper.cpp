@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "gc/g1/g1BiasedArray.hpp"
+#include "gc/g1/g1NUMA.hpp"
 #include "gc/g1/g1RegionToSpaceMapper.hpp"
 #include "logging/log.hpp"
 #include "memory/allocation.inline.hpp"
@@ -44,7 +45,8 @@ G1RegionToSpaceMapper::G1RegionToSpaceMapper(ReservedSpace rs,
   _listener(NULL),
   _storage(rs, used_size, page_size),
   _region_granularity(region_granularity),
-  _commit_map(rs.size() * commit_factor / region_granularity, mtGC) {
+  _commit_map(rs.size() * commit_factor / region_granularity, mtGC),
+  _memory_type(type) {
   guarantee(is_power_of_2(page_size), "must be");
   guarantee(is_power_of_2(region_granularity), "must be");
 
@@ -74,6 +76,14 @@ class G1RegionsLargerThanCommitSizeMapper : public G1RegionToSpaceMapper {
   virtual void commit_regions(uint start_idx, size_t num_regions, WorkGang* pretouch_gang) {
     size_t const start_page = (size_t)start_idx * _pages_per_region;
     bool zero_filled = _storage.commit(start_page, num_regions * _pages_per_region);
+    if (_memory_type == mtJavaHeap) {
+      // Place each region on its preferred node before anyone touches it.
+      for (uint region_index = start_idx; region_index < start_idx + num_regions; region_index++) {
+        void* address = _storage.page_start((size_t)region_index * _pages_per_region);
+        size_t size_in_bytes = _storage.page_size() * _pages_per_region;
+        G1NUMA::numa()->request_memory_on_node(address, size_in_bytes, region_index);
+      }
+    }
     if (AlwaysPreTouch) {
       _storage.pretouch(start_page, num_regions * _pages_per_region, pretouch_gang);
     }
@@ -141,6 +151,11 @@ class G1RegionsSmallerThanCommitSizeMapper : public G1RegionToSpaceMapper {
           num_committed++;
         }
         zero_filled = _storage.commit(idx, 1);
+        if (_memory_type == mtJavaHeap) {
+          void* address = _storage.page_start(idx);
+          size_t size_in_bytes = _storage.page_size();
+          G1NUMA::numa()->request_memory_on_node(address, size_in_bytes, i);
+        }
       }
       all_zero_filled &= zero_filled;
 
@@ -334,6 +334,8 @@ class G1ScanRSForRegionClosure : public HeapRegionClosure {
   Tickspan _strong_code_root_scan_time;
   Tickspan _strong_code_trim_partially_time;
 
+  size_t _strong_code_roots_scanned;
+
   void claim_card(size_t card_index, const uint region_idx_for_card) {
     _ct->set_card_claimed(card_index);
     _scan_state->add_dirty_region(region_idx_for_card);
@@ -432,6 +434,7 @@ class G1ScanRSForRegionClosure : public HeapRegionClosure {
     // We only want to make sure that the oops in the nmethods are adjusted with regard to the
     // objects copied by the current evacuation.
     r->strong_code_roots_do(_pss->closures()->weak_codeblobs());
+    _strong_code_roots_scanned += r->rem_set()->strong_code_roots_list_length();
     event.commit(GCId::current(), _worker_i, G1GCPhaseTimes::phase_name(G1GCPhaseTimes::CodeRoots));
   }
 
@@ -456,7 +459,8 @@ public:
     _rem_set_root_scan_time(),
     _rem_set_trim_partially_time(),
     _strong_code_root_scan_time(),
-    _strong_code_trim_partially_time() { }
+    _strong_code_trim_partially_time(),
+    _strong_code_roots_scanned(0) { }
 
   bool do_heap_region(HeapRegion* r) {
     assert(r->in_collection_set(), "Region %u is not in the collection set.", r->hrm_index());
@@ -493,6 +497,8 @@ public:
   Tickspan strong_code_root_scan_time() const { return _strong_code_root_scan_time;  }
   Tickspan strong_code_root_trim_partially_time() const { return _strong_code_trim_partially_time; }
 
+  size_t strong_code_roots_scanned() const { return _strong_code_roots_scanned; }
+
   size_t cards_scanned() const { return _cards_scanned; }
   size_t cards_claimed() const { return _cards_claimed; }
   size_t cards_skipped() const { return _cards_skipped; }
@@ -527,6 +533,7 @@ void G1RemSet::scan_rem_set(G1ParScanThreadState* pss,
   }
 
   p->record_or_add_time_secs(coderoots_phase, worker_i, cl.strong_code_root_scan_time().seconds());
+  p->record_or_add_thread_work_item(coderoots_phase, worker_i, cl.strong_code_roots_scanned(), G1GCPhaseTimes::CodeRootsScannedNMethods);
   p->add_time_secs(objcopy_phase, worker_i, cl.strong_code_root_trim_partially_time().seconds());
 }
 
@@ -99,6 +99,20 @@ void G1YoungRemSetSamplingThread::check_for_periodic_gc(){
   }
 }
 
+void G1YoungRemSetSamplingThread::check_for_periodic_uncommit() {
+  // If disabled, just return.
+  if (G1PeriodicUncommitDelay == 0) {
+    return;
+  }
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+  if ((uintx)g1h->millis_since_last_gc() < G1PeriodicUncommitDelay) {
+    return;
+  }
+  // One batch per service interval, so that region allocation is never
+  // held up for long.
+  g1h->periodic_uncommit();
+}
+
 void G1YoungRemSetSamplingThread::run_service() {
   double vtime_start = os::elapsedVTime();
 
@@ -108,6 +122,9 @@ void G1YoungRemSetSamplingThread::run_service() {
   } else {
     log_info(gc)("Periodic GC disabled");
   }
+  if (G1PeriodicUncommitDelay != 0) {
+    log_info(gc)("Periodic uncommit enabled with delay " UINTX_FORMAT "ms", G1PeriodicUncommitDelay);
+  }
 
   while (!should_terminate()) {
     sample_young_list_rs_lengths();
@@ -119,6 +136,7 @@ void G1YoungRemSetSamplingThread::run_service() {
     }
 
     check_for_periodic_gc();
+    check_for_periodic_uncommit();
 
     sleep_before_next_cycle();
   }
@@ -51,6 +51,7 @@ private:
 
   void run_service();
   void check_for_periodic_gc();
+  void check_for_periodic_uncommit();
 
   void stop_service();
 
@@ -255,6 +255,10 @@
           "Try to reclaim dead large objects that have a few stale "        \
           "references at every young GC.")                                  \
                                                                             \
+  experimental(bool, G1EagerReclaimHumongousObjArrays, true,                \
+          "Try to reclaim dead large object arrays at young GCs outside "   \
+          "of concurrent marking.")                                         \
+                                                                            \
   experimental(size_t, G1RebuildRemSetChunkSize, 256 * K,                   \
           "Chunk size used for rebuilding the remembered set.")             \
           range(4 * K, 32 * M)                                              \
@@ -319,6 +323,18 @@
           "disables this check.")                                           \
           range(0.0, (double)max_uintx)                                     \
                                                                             \
+  manageable(uintx, G1PeriodicUncommitDelay, 0,                             \
+          "Number of milliseconds after a previous GC to wait before "      \
+          "concurrently uncommitting free regions above the capacity "      \
+          "allowed by MaxHeapFreeRatio. A value of zero disables "          \
+          "periodic uncommit.")                                             \
+                                                                            \
+  experimental(uint, G1PeriodicUncommitBatchRegions, 8,                     \
+          "Maximum number of regions uncommitted at a time by periodic "    \
+          "uncommit. Region allocation is blocked while a batch is "        \
+          "uncommitted.")                                                   \
+          range(1, max_juint)                                               \
+                                                                            \
   experimental(uintx, G1YoungExpansionBufferPercent, 10,                    \
                "When heterogenous heap is enabled by AllocateOldGenAt "     \
                "option, after every GC, young gen is re-sized which "       \
@@ -28,6 +28,7 @@
 #include "gc/g1/g1CollectedHeap.inline.hpp"
 #include "gc/g1/g1CollectionSet.hpp"
 #include "gc/g1/g1HeapRegionTraceType.hpp"
+#include "gc/g1/g1NUMA.hpp"
 #include "gc/g1/g1OopClosures.inline.hpp"
 #include "gc/g1/heapRegion.inline.hpp"
 #include "gc/g1/heapRegionBounds.inline.hpp"
@@ -138,7 +139,7 @@ void HeapRegion::hr_clear(bool keep_remset, bool clear_space, bool locked) {
 
 void HeapRegion::clear_cardtable() {
   G1CardTable* ct = G1CollectedHeap::heap()->card_table();
-  ct->clear(MemRegion(bottom(), end()));
+  ct->clear_sparse(MemRegion(bottom(), end()));
 }
 
 void HeapRegion::calc_gc_efficiency() {
@@ -234,9 +235,11 @@ HeapRegion::HeapRegion(uint hrm_index,
     G1ContiguousSpace(bot),
     _rem_set(NULL),
     _hrm_index(hrm_index),
+    _node_index(G1NUMA::numa()->preferred_node_index_for_index(hrm_index)),
     _type(),
     _humongous_start_region(NULL),
     _evacuation_failed(false),
+    _pinned_object_count(0),
     _next(NULL), _prev(NULL),
 #ifdef ASSERT
     _containing_set(NULL),
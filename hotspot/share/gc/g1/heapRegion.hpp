@@ -228,6 +228,9 @@ class HeapRegion: public G1ContiguousSpace {
   // The index of this region in the heap region sequence.
   uint  _hrm_index;
 
+  // The index of the NUMA node this region's memory is placed on.
+  uint  _node_index;
+
   HeapRegionType _type;
 
   // For a humongous region, region in which it starts.
@@ -236,6 +239,10 @@ class HeapRegion: public G1ContiguousSpace {
   // True iff an attempt to evacuate an object in the region failed.
   bool _evacuation_failed;
 
+  // Number of JNI critical sections that currently hold the humongous
+  // object starting in this region.
+  volatile size_t _pinned_object_count;
+
   // Fields used by the HeapRegionSetBase class and subclasses.
   HeapRegion* _next;
   HeapRegion* _prev;
@@ -372,6 +379,9 @@ class HeapRegion: public G1ContiguousSpace {
   // sequence, otherwise -1.
   uint hrm_index() const { return _hrm_index; }
 
+  // The NUMA node index of this region, see G1NUMA.
+  uint node_index() const { return _node_index; }
+
   // The number of bytes marked live in the region in the last marking phase.
   size_t marked_bytes()    { return _prev_marked_bytes; }
   size_t live_bytes() {
@@ -438,6 +448,13 @@ class HeapRegion: public G1ContiguousSpace {
   // Humongous regions and archive regions are pinned.
   bool is_pinned() const { return _type.is_pinned(); }
 
+  // Pinning of the humongous object that starts in this region by JNI
+  // critical sections. Humongous objects are never moved, the count only
+  // keeps the object from being reclaimed while native code accesses it.
+  inline void increment_pinned_object_count();
+  inline void decrement_pinned_object_count();
+  bool has_pinned_objects() const { return _pinned_object_count > 0; }
+
   // An archive region is a pinned region, also tagged as old, which
   // should not be marked during mark/sweep. This allows the address
   // space to be shared by JVM instances.
@@ -362,4 +362,15 @@ bool HeapRegion::oops_on_card_seq_iterate_careful(MemRegion mr,
   return true;
 }
 
+inline void HeapRegion::increment_pinned_object_count() {
+  assert(is_starts_humongous(), "only humongous objects are pinned");
+  Atomic::inc(&_pinned_object_count);
+}
+
+inline void HeapRegion::decrement_pinned_object_count() {
+  assert(is_starts_humongous(), "only humongous objects are pinned");
+  assert(_pinned_object_count > 0, "unbalanced unpin");
+  Atomic::dec(&_pinned_object_count);
+}
+
 #endif // SHARE_GC_G1_HEAPREGION_INLINE_HPP
@@ -26,6 +26,7 @@
 #include "gc/g1/g1Arguments.hpp"
 #include "gc/g1/g1CollectedHeap.inline.hpp"
 #include "gc/g1/g1ConcurrentRefine.hpp"
+#include "gc/g1/g1NUMA.hpp"
 #include "gc/g1/heapRegion.hpp"
 #include "gc/g1/heapRegionManager.inline.hpp"
 #include "gc/g1/heapRegionSet.inline.hpp"
@@ -109,6 +110,28 @@ bool HeapRegionManager::is_free(HeapRegion* hr) const {
 }
 #endif
 
+HeapRegion* HeapRegionManager::allocate_free_region(HeapRegionType type, uint requested_node_index) {
+  HeapRegion* hr = NULL;
+  bool from_head = !type.is_young();
+
+  if (requested_node_index != G1NUMA::AnyNodeIndex && G1NUMA::numa()->is_enabled()) {
+    // Try to allocate with requested node index.
+    hr = _free_list.remove_region_with_node_index(from_head, requested_node_index);
+  }
+
+  if (hr == NULL) {
+    // If there's a single active node or we did not get a region from our requested node,
+    // try without requested node index.
+    hr = _free_list.remove_region(from_head);
+  }
+
+  if (hr != NULL) {
+    assert(hr->next() == NULL, "Single region should not have next");
+    assert(is_available(hr->hrm_index()), "Must be committed");
+  }
+  return hr;
+}
+
 HeapRegion* HeapRegionManager::new_heap_region(uint hrm_index) {
   G1CollectedHeap* g1h = G1CollectedHeap::heap();
   HeapWord* bottom = g1h->bottom_addr_for_region(hrm_index);
@@ -235,36 +258,66 @@ uint HeapRegionManager::expand_at(uint start, uint num_regions, WorkGang* pretou
   return expanded;
 }
 
+bool HeapRegionManager::is_contiguous_candidate(uint index, bool empty_only) const {
+  HeapRegion* hr = _regions.get_by_index(index);
+  return (!empty_only && !is_available(index)) || (is_available(index) && hr != NULL && hr->is_empty());
+}
+
 uint HeapRegionManager::find_contiguous(size_t num, bool empty_only) {
-  uint found = 0;
-  size_t length_found = 0;
-  uint cur = 0;
-
-  while (length_found < num && cur < max_length()) {
-    HeapRegion* hr = _regions.get_by_index(cur);
-    if ((!empty_only && !is_available(cur)) || (is_available(cur) && hr != NULL && hr->is_empty())) {
-      // This region is a potential candidate for allocation into.
-      length_found++;
-    } else {
-      // This region is not a candidate. The next region is the next possible one.
-      found = cur + 1;
-      length_found = 0;
+  uint found = G1_NO_HRM_INDEX;
+
+  if (empty_only) {
+    // Best-fit: take the shortest run of empty regions that is long enough,
+    // keeping longer runs available for larger humongous objects. Otherwise
+    // small humongous objects placed first-fit gradually split up the free
+    // space until larger allocations only succeed after a full collection.
+    size_t best_length = SIZE_MAX;
+    uint cur = 0;
+    while (cur < max_length() && best_length > num) {
+      if (!is_contiguous_candidate(cur, empty_only)) {
+        cur++;
+        continue;
+      }
+      uint start = cur;
+      while (cur < max_length() && is_contiguous_candidate(cur, empty_only)) {
+        cur++;
+      }
+      size_t length = cur - start;
+      if (length >= num && length < best_length) {
+        found = start;
+        best_length = length;
+      }
+    }
+  } else {
+    size_t length_found = 0;
+    uint cur = 0;
+    uint start = 0;
+
+    while (length_found < num && cur < max_length()) {
+      if (is_contiguous_candidate(cur, empty_only)) {
+        // This region is a potential candidate for allocation into.
+        length_found++;
+      } else {
+        // This region is not a candidate. The next region is the next possible one.
+        start = cur + 1;
+        length_found = 0;
+      }
+      cur++;
+    }
+    if (length_found == num) {
+      found = start;
     }
-    cur++;
   }
 
-  if (length_found == num) {
+  if (found != G1_NO_HRM_INDEX) {
     for (uint i = found; i < (found + num); i++) {
-      HeapRegion* hr = _regions.get_by_index(i);
       // sanity check
-      guarantee((!empty_only && !is_available(i)) || (is_available(i) && hr != NULL && hr->is_empty()),
+      guarantee(is_contiguous_candidate(i, empty_only),
                 "Found region sequence starting at " UINT32_FORMAT ", length " SIZE_FORMAT
-                " that is not empty at " UINT32_FORMAT ". Hr is " PTR_FORMAT, found, num, i, p2i(hr));
+                " that is not empty at " UINT32_FORMAT ". Hr is " PTR_FORMAT, found, num, i, p2i(_regions.get_by_index(i)));
     }
-    return found;
-  } else {
-    return G1_NO_HRM_INDEX;
   }
+  return found;
 }
 
 HeapRegion* HeapRegionManager::next_region_in_heap(const HeapRegion* r) const {
@@ -446,6 +499,37 @@ void HeapRegionManager::shrink_at(uint index, size_t num_regions) {
   uncommit_regions(index, num_regions);
 }
 
+uint HeapRegionManager::uncommit_free_regions(uint num_regions) {
+  assert(num_regions > 0, "Need to uncommit at least one region");
+  assert(num_regions < length(), "We should never remove all regions");
+
+  uint removed = 0;
+  uint cur = _allocated_heapregions_length;
+  while (removed < num_regions && cur > 0) {
+    // Find the highest run of free regions below cur.
+    while (cur > 0 && !(is_available(cur - 1) && at(cur - 1)->is_free())) {
+      cur--;
+    }
+    uint end = cur;
+    while (cur > 0 && end - cur < num_regions - removed &&
+           is_available(cur - 1) && at(cur - 1)->is_free()) {
+      cur--;
+    }
+    if (end == cur) {
+      break;
+    }
+    // Regions in the free list are sorted by index, so the run is contiguous there too.
+    uint to_remove = end - cur;
+    _free_list.remove_starting_at(at(cur), to_remove);
+    shrink_at(cur, to_remove);
+    removed += to_remove;
+  }
+
+  verify_optional();
+
+  return removed;
+}
+
 uint HeapRegionManager::find_empty_from_idx_reverse(uint start_idx, uint* res_idx) const {
   guarantee(start_idx < _allocated_heapregions_length, "checking");
   guarantee(res_idx != NULL, "checking");
@@ -96,9 +96,13 @@ class HeapRegionManager: public CHeapObj<mtGC> {
 
   // Find a contiguous set of empty or uncommitted regions of length num and return
   // the index of the first region or G1_NO_HRM_INDEX if the search was unsuccessful.
-  // If only_empty is true, only empty regions are considered.
-  // Searches from bottom to top of the heap, doing a first-fit.
+  // If only_empty is true, only empty regions are considered and the shortest
+  // sufficiently long sequence is returned (best-fit). Otherwise searches from
+  // bottom to top of the heap, doing a first-fit.
   uint find_contiguous(size_t num, bool only_empty);
+  // Returns whether the region at index may be part of a sequence found by
+  // find_contiguous().
+  bool is_contiguous_candidate(uint index, bool only_empty) const;
   // Finds the next sequence of unavailable regions starting from start_idx. Returns the
   // length of the sequence found. If this result is zero, no such sequence could be found,
   // otherwise res_idx indicates the start index of these regions.
@@ -174,15 +178,10 @@ public:
     _free_list.add_ordered(list);
   }
 
-  virtual HeapRegion* allocate_free_region(HeapRegionType type) {
-    HeapRegion* hr = _free_list.remove_region(!type.is_young());
-
-    if (hr != NULL) {
-      assert(hr->next() == NULL, "Single region should not have next");
-      assert(is_available(hr->hrm_index()), "Must be committed");
-    }
-    return hr;
-  }
+  // Allocate a free region of the given type, preferably on the given NUMA
+  // node. Falls back to a region on any node if there is none on the
+  // requested node.
+  virtual HeapRegion* allocate_free_region(HeapRegionType type, uint requested_node_index);
 
   inline void allocate_free_regions_starting_at(uint first, uint num_regions);
 
@@ -260,6 +259,12 @@ public:
   // empty, and free.
   void shrink_at(uint index, size_t num_regions);
 
+  // Uncommit up to num_regions free regions from the top of the committed heap,
+  // taking them off the free list. Unlike shrink_by() this does not require the
+  // free list to be torn down, so it may be called concurrently with the
+  // Heap_lock held. Return the actual number of uncommitted regions.
+  uint uncommit_free_regions(uint num_regions);
+
   virtual void verify();
 
   // Do some sanity checking.
@@ -33,6 +33,8 @@
 #include "memory/padded.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/orderAccess.hpp"
+#include "runtime/safepoint.hpp"
 #include "utilities/bitMap.inline.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/formatBuffer.hpp"
@@ -42,13 +44,27 @@
 const char* HeapRegionRemSet::_state_strings[] =  {"Untracked", "Updating", "Complete"};
 const char* HeapRegionRemSet::_short_state_strings[] =  {"UNTRA", "UPDAT", "CMPLT"};
 
+// The cards of a PerRegionTable are kept in a bitmap that is split into
+// fixed size chunks. A chunk is only allocated once the first card in its
+// range is added, so the memory used by a PRT follows the number of card
+// ranges in the from-region that actually refer into the owner region,
+// instead of always covering the whole from-region.
 class PerRegionTable: public CHeapObj<mtGC> {
   friend class OtherRegionsTable;
   friend class HeapRegionRemSetIterator;
 
-  HeapRegion*     _hr;
-  CHeapBitMap     _bm;
-  jint            _occupied;
+  typedef BitMap::bm_word_t bm_word_t;
+
+  // Smallest chunk size in cards, i.e. 64 bytes of bitmap.
+  static const size_t MinCardsPerChunk = 512;
+  // Upper bound for the number of chunks of a table, limiting the size of
+  // the chunk array for large regions.
+  static const size_t MaxChunksPerTable = 64;
+
+  HeapRegion*          _hr;
+  bm_word_t* volatile* _chunks;
+  volatile jint        _num_chunks;  // Number of allocated chunks.
+  jint                 _occupied;
 
   // next pointer for free/allocated 'all' list
   PerRegionTable* _next;
@@ -62,26 +78,65 @@ class PerRegionTable: public CHeapObj<mtGC> {
   // Global free list of PRTs
   static PerRegionTable* volatile _free_list;
 
-protected:
-  // We need access in order to union things into the base table.
-  BitMap* bm() { return &_bm; }
+  static size_t cards_per_chunk() {
+    return MAX2(MinCardsPerChunk, HeapRegion::CardsPerRegion / MaxChunksPerTable);
+  }
+
+  static size_t chunks_per_table() {
+    return HeapRegion::CardsPerRegion / cards_per_chunk();
+  }
+
+  static size_t chunk_size_in_words() {
+    return cards_per_chunk() / BitsPerWord;
+  }
+
+  bm_word_t* chunk_at(size_t chunk_idx) const {
+    assert(chunk_idx < chunks_per_table(), "Chunk index " SIZE_FORMAT " out of bounds", chunk_idx);
+    return OrderAccess::load_acquire(&_chunks[chunk_idx]);
+  }
+
+  // Returns the chunk at chunk_idx, allocating it if needed. Concurrent
+  // adders race to install their chunk, and the losers free theirs.
+  bm_word_t* chunk_at_create(size_t chunk_idx) {
+    bm_word_t* chunk = chunk_at(chunk_idx);
+    if (chunk == NULL) {
+      bm_word_t* new_chunk = NEW_C_HEAP_ARRAY(bm_word_t, chunk_size_in_words(), mtGC);
+      memset(new_chunk, 0, chunk_size_in_words() * sizeof(bm_word_t));
+      chunk = Atomic::cmpxchg(new_chunk, &_chunks[chunk_idx], (bm_word_t*)NULL);
+      if (chunk == NULL) {
+        Atomic::inc(&_num_chunks);
+        chunk = new_chunk;
+      } else {
+        FREE_C_HEAP_ARRAY(bm_word_t, new_chunk);
+      }
+    }
+    return chunk;
+  }
 
   PerRegionTable(HeapRegion* hr) :
     _hr(hr),
-    _bm(HeapRegion::CardsPerRegion, mtGC),
+    _chunks(NEW_C_HEAP_ARRAY(bm_word_t* volatile, chunks_per_table(), mtGC)),
+    _num_chunks(0),
     _occupied(0),
     _next(NULL), _prev(NULL),
     _collision_list_next(NULL)
-  {}
+  {
+    for (size_t i = 0; i < chunks_per_table(); i++) {
+      _chunks[i] = NULL;
+    }
+  }
 
   void add_card_work(CardIdx_t from_card, bool par) {
-    if (!_bm.at(from_card)) {
+    size_t chunk_idx = (size_t)from_card / cards_per_chunk();
+    BitMapView bm(chunk_at_create(chunk_idx), cards_per_chunk());
+    BitMap::idx_t bit = (size_t)from_card % cards_per_chunk();
+    if (!bm.at(bit)) {
       if (par) {
-        if (_bm.par_at_put(from_card, 1)) {
+        if (bm.par_at_put(bit, 1)) {
           Atomic::inc(&_occupied);
         }
       } else {
-        _bm.at_put(from_card, 1);
+        bm.at_put(bit, 1);
         _occupied++;
       }
     }
@@ -106,11 +161,40 @@ public:
   HeapRegion* hr() const { return OrderAccess::load_acquire(&_hr); }
 
   jint occupied() const {
-    // Overkill, but if we ever need it...
-    // guarantee(_occupied == _bm.count_one_bits(), "Check");
     return _occupied;
   }
 
+  // Returns the first card at or after from_card, or CardsPerRegion if there is none.
+  size_t next_card(size_t from_card) const {
+    for (size_t chunk_idx = from_card / cards_per_chunk(); chunk_idx < chunks_per_table(); chunk_idx++) {
+      bm_word_t* chunk = chunk_at(chunk_idx);
+      if (chunk == NULL) {
+        continue;
+      }
+      size_t chunk_start = chunk_idx * cards_per_chunk();
+      size_t start = MAX2(from_card, chunk_start) - chunk_start;
+      BitMapView bm(chunk, cards_per_chunk());
+      size_t bit = bm.get_next_one_offset(start);
+      if (bit < cards_per_chunk()) {
+        return chunk_start + bit;
+      }
+    }
+    return HeapRegion::CardsPerRegion;
+  }
+
+  // Frees the chunks of this table. Only safe when no other thread may
+  // add cards to it, i.e. at a safepoint.
+  void release_chunks() {
+    for (size_t i = 0; i < chunks_per_table(); i++) {
+      bm_word_t* chunk = _chunks[i];
+      if (chunk != NULL) {
+        FREE_C_HEAP_ARRAY(bm_word_t, chunk);
+        _chunks[i] = NULL;
+      }
+    }
+    _num_chunks = 0;
+  }
+
   void init(HeapRegion* hr, bool clear_links_to_all_list) {
     if (clear_links_to_all_list) {
       set_next(NULL);
@@ -118,7 +202,14 @@ public:
     }
     _collision_list_next = NULL;
     _occupied = 0;
-    _bm.clear();
+    // Clear instead of freeing the chunks: threads that still think this
+    // table belongs to its previous region may be adding cards to them.
+    for (size_t i = 0; i < chunks_per_table(); i++) {
+      bm_word_t* chunk = _chunks[i];
+      if (chunk != NULL) {
+        memset(chunk, 0, chunk_size_in_words() * sizeof(bm_word_t));
+      }
+    }
     // Make sure that the bitmap clearing above has been finished before publishing
     // this PRT to concurrent threads.
     OrderAccess::release_store(&_hr, hr);
@@ -140,15 +231,11 @@ public:
     add_card_work(from_card_index, /*parallel*/ false);
   }
 
-  // (Destructively) union the bitmap of the current table into the given
-  // bitmap (which is assumed to be of the same size.)
-  void union_bitmap_into(BitMap* bm) {
-    bm->set_union(_bm);
-  }
-
   // Mem size in bytes.
   size_t mem_size() const {
-    return sizeof(PerRegionTable) + _bm.size_in_words() * HeapWordSize;
+    return sizeof(PerRegionTable) +
+           chunks_per_table() * sizeof(bm_word_t*) +
+           (size_t)_num_chunks * chunk_size_in_words() * HeapWordSize;
   }
 
   // Requires "from" to be in "hr()".
@@ -156,7 +243,12 @@ public:
     assert(hr()->is_in_reserved(from), "Precondition.");
     size_t card_ind = pointer_delta(from, hr()->bottom(),
                                     G1CardTable::card_size);
-    return _bm.at(card_ind);
+    bm_word_t* chunk = chunk_at(card_ind / cards_per_chunk());
+    if (chunk == NULL) {
+      return false;
+    }
+    BitMapView bm(chunk, cards_per_chunk());
+    return bm.at(card_ind % cards_per_chunk());
   }
 
   // Bulk-free the PRTs from prt to last, assumes that they are
@@ -535,11 +627,9 @@ size_t OtherRegionsTable::occ_sparse() const {
 
 size_t OtherRegionsTable::mem_size() const {
   size_t sum = 0;
-  // all PRTs are of the same size so it is sufficient to query only one of them.
-  if (_first_all_fine_prts != NULL) {
-    assert(_last_all_fine_prts != NULL &&
-      _first_all_fine_prts->mem_size() == _last_all_fine_prts->mem_size(), "check that mem_size() is constant");
-    sum += _first_all_fine_prts->mem_size() * _n_fine_entries;
+  // PRTs only allocate the parts of their bitmap in use, so they differ in size.
+  for (PerRegionTable* cur = _first_all_fine_prts; cur != NULL; cur = cur->next()) {
+    sum += cur->mem_size();
   }
   sum += (sizeof(PerRegionTable*) * _max_fine_entries);
   sum += (_coarse_map.size_in_words() * HeapWordSize);
@@ -560,6 +650,13 @@ void OtherRegionsTable::clear() {
   // if there are no entries, skip this step
   if (_first_all_fine_prts != NULL) {
     guarantee(_first_all_fine_prts != NULL && _last_all_fine_prts != NULL, "just checking");
+    if (SafepointSynchronize::is_at_safepoint()) {
+      // Nobody adds cards concurrently, so give back the bitmap memory
+      // instead of keeping it around on the free list.
+      for (PerRegionTable* cur = _first_all_fine_prts; cur != NULL; cur = cur->next()) {
+        cur->release_chunks();
+      }
+    }
     PerRegionTable::bulk_free(_first_all_fine_prts, _last_all_fine_prts);
     memset(_fine_grain_regions, 0, _max_fine_entries * sizeof(_fine_grain_regions[0]));
   } else {
@@ -741,8 +838,7 @@ bool HeapRegionRemSetIterator::coarse_has_next(size_t& card_index) {
 
 bool HeapRegionRemSetIterator::fine_has_next(size_t& card_index) {
   if (fine_has_next()) {
-    _cur_card_in_prt =
-      _fine_cur_prt->_bm.get_next_one_offset(_cur_card_in_prt + 1);
+    _cur_card_in_prt = _fine_cur_prt->next_card(_cur_card_in_prt + 1);
   }
   if (_cur_card_in_prt == HeapRegion::CardsPerRegion) {
     // _fine_cur_prt may still be NULL in case if there are not PRTs at all for
@@ -752,7 +848,7 @@ bool HeapRegionRemSetIterator::fine_has_next(size_t& card_index) {
     }
     PerRegionTable* next_prt = _fine_cur_prt->next();
     switch_to_prt(next_prt);
-    _cur_card_in_prt = _fine_cur_prt->_bm.get_next_one_offset(_cur_card_in_prt + 1);
+    _cur_card_in_prt = _fine_cur_prt->next_card(_cur_card_in_prt + 1);
   }
 
   card_index = _cur_region_card_offset + _cur_card_in_prt;
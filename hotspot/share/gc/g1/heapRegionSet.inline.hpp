@@ -25,6 +25,7 @@
 #ifndef SHARE_GC_G1_HEAPREGIONSET_INLINE_HPP
 #define SHARE_GC_G1_HEAPREGIONSET_INLINE_HPP
 
+#include "gc/g1/g1NUMA.hpp"
 #include "gc/g1/heapRegionSet.hpp"
 
 inline void HeapRegionSetBase::add(HeapRegion* hr) {
@@ -147,4 +148,65 @@ inline HeapRegion* FreeRegionList::remove_region(bool from_head) {
   return hr;
 }
 
+inline HeapRegion* FreeRegionList::remove_region_with_node_index(bool from_head,
+                                                                 uint requested_node_index) {
+  assert(G1NUMA::numa()->is_enabled(), "Only used with NUMA-aware region allocation");
+  check_mt_safety();
+  verify_optional();
+
+  const uint max_search_depth = G1NUMA::numa()->max_search_depth();
+  HeapRegion* cur;
+
+  // Search a limited number of regions from the requested end for one on
+  // the requested node.
+  uint cur_depth = 0;
+  if (from_head) {
+    for (cur = _head;
+         cur != NULL && cur_depth < max_search_depth;
+         cur = cur->next(), ++cur_depth) {
+      if (cur->node_index() == requested_node_index) {
+        break;
+      }
+    }
+  } else {
+    for (cur = _tail;
+         cur != NULL && cur_depth < max_search_depth;
+         cur = cur->prev(), ++cur_depth) {
+      if (cur->node_index() == requested_node_index) {
+        break;
+      }
+    }
+  }
+
+  if (cur == NULL || cur_depth >= max_search_depth) {
+    return NULL;
+  }
+
+  // Unlink the region from the list.
+  HeapRegion* prev = cur->prev();
+  HeapRegion* next = cur->next();
+  if (prev == NULL) {
+    assert_free_region_list(_head == cur, "invariant");
+    _head = next;
+  } else {
+    prev->set_next(next);
+  }
+  if (next == NULL) {
+    assert_free_region_list(_tail == cur, "invariant");
+    _tail = prev;
+  } else {
+    next->set_prev(prev);
+  }
+  cur->set_next(NULL);
+  cur->set_prev(NULL);
+
+  if (_last == cur) {
+    _last = NULL;
+  }
+
+  // remove() will verify the region and check mt safety.
+  remove(cur);
+  return cur;
+}
+
 #endif // SHARE_GC_G1_HEAPREGIONSET_INLINE_HPP
@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "gc/parallel/mutableSpace.hpp"
+#include "gc/shared/pretouchTask.hpp"
 #include "gc/shared/spaceDecorator.hpp"
 #include "memory/iterator.inline.hpp"
 #include "memory/universe.hpp"
@@ -61,7 +62,8 @@ void MutableSpace::numa_setup_pages(MemRegion mr, bool clear_space) {
 }
 
 void MutableSpace::pretouch_pages(MemRegion mr) {
-  os::pretouch_memory(mr.start(), mr.end());
+  PretouchTask::pretouch("ParallelGC PreTouch", (char*)mr.start(), (char*)mr.end(),
+                         os::vm_page_size(), PretouchTask::default_gang());
 }
 
 void MutableSpace::initialize(MemRegion mr,
@@ -33,8 +33,8 @@ inline ParMarkBitMap::ParMarkBitMap():
 { }
 
 inline void ParMarkBitMap::clear_range(idx_t beg, idx_t end) {
-  _beg_bits.clear_range(beg, end);
-  _end_bits.clear_range(beg, end);
+  _beg_bits.clear_large_range(beg, end);
+  _end_bits.clear_large_range(beg, end);
 }
 
 inline ParMarkBitMap::idx_t ParMarkBitMap::bits_required(size_t words) {
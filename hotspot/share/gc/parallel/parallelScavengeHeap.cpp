@@ -28,7 +28,6 @@
 #include "gc/parallel/adjoiningGenerationsForHeteroHeap.hpp"
 #include "gc/parallel/adjoiningVirtualSpaces.hpp"
 #include "gc/parallel/parallelArguments.hpp"
-#include "gc/parallel/gcTaskManager.hpp"
 #include "gc/parallel/objectStartArray.inline.hpp"
 #include "gc/parallel/parallelScavengeHeap.inline.hpp"
 #include "gc/parallel/psAdaptiveSizePolicy.hpp"
@@ -37,12 +36,14 @@
 #include "gc/parallel/psParallelCompact.inline.hpp"
 #include "gc/parallel/psPromotionManager.hpp"
 #include "gc/parallel/psScavenge.hpp"
+#include "gc/parallel/psStringDedup.hpp"
 #include "gc/parallel/psVMOperations.hpp"
 #include "gc/shared/gcHeapSummary.hpp"
 #include "gc/shared/gcLocker.hpp"
 #include "gc/shared/gcWhen.hpp"
 #include "gc/shared/genArguments.hpp"
 #include "gc/shared/scavengableNMethods.hpp"
+#include "gc/shared/suspendibleThreadSet.hpp"
 #include "logging/log.hpp"
 #include "memory/metaspaceCounters.hpp"
 #include "memory/universe.hpp"
@@ -59,7 +60,6 @@ PSYoungGen*  ParallelScavengeHeap::_young_gen = NULL;
 PSOldGen*    ParallelScavengeHeap::_old_gen = NULL;
 PSAdaptiveSizePolicy* ParallelScavengeHeap::_size_policy = NULL;
 PSGCAdaptivePolicyCounters* ParallelScavengeHeap::_gc_policy_counters = NULL;
-GCTaskManager* ParallelScavengeHeap::_gc_task_manager = NULL;
 
 jint ParallelScavengeHeap::initialize() {
   const size_t reserved_heap_size = ParallelArguments::heap_reserved_size_bytes();
@@ -81,6 +81,9 @@ jint ParallelScavengeHeap::initialize() {
   barrier_set->initialize();
   BarrierSet::set_barrier_set(barrier_set);
 
+  // Set up the GC worker threads, they pre-touch the generations
+  _workers.initialize_workers();
+
   // Make up the generations
   // Calculate the maximum size that a generation can grow.  This
   // includes growth into the other generation.  Note that the
@@ -116,13 +119,13 @@ jint ParallelScavengeHeap::initialize() {
   _gc_policy_counters =
     new PSGCAdaptivePolicyCounters("ParScav:MSC", 2, 2, _size_policy);
 
-  // Set up the GCTaskManager
-  _gc_task_manager = GCTaskManager::create(ParallelGCThreads);
-
   if (UseParallelOldGC && !PSParallelCompact::initialize()) {
     return JNI_ENOMEM;
   }
 
+  // Initialize string deduplication
+  PSStringDedup::initialize();
+
   return JNI_OK;
 }
 
@@ -175,6 +178,24 @@ void ParallelScavengeHeap::post_initialize() {
   ScavengableNMethods::initialize(&_is_scavengable);
 }
 
+void ParallelScavengeHeap::stop() {
+  if (PSStringDedup::is_enabled()) {
+    PSStringDedup::stop();
+  }
+}
+
+void ParallelScavengeHeap::safepoint_synchronize_begin() {
+  if (PSStringDedup::is_enabled()) {
+    SuspendibleThreadSet::synchronize();
+  }
+}
+
+void ParallelScavengeHeap::safepoint_synchronize_end() {
+  if (PSStringDedup::is_enabled()) {
+    SuspendibleThreadSet::desynchronize();
+  }
+}
+
 void ParallelScavengeHeap::update_counters() {
   young_gen()->update_counters();
   old_gen()->update_counters();
@@ -598,11 +619,17 @@ void ParallelScavengeHeap::print_on_error(outputStream* st) const {
 }
 
 void ParallelScavengeHeap::gc_threads_do(ThreadClosure* tc) const {
-  PSScavenge::gc_task_manager()->threads_do(tc);
+  _workers.threads_do(tc);
+  if (PSStringDedup::is_enabled()) {
+    PSStringDedup::threads_do(tc);
+  }
 }
 
 void ParallelScavengeHeap::print_gc_threads_on(outputStream* st) const {
-  PSScavenge::gc_task_manager()->print_threads_on(st);
+  _workers.print_worker_threads_on(st);
+  if (PSStringDedup::is_enabled()) {
+    PSStringDedup::print_worker_threads_on(st);
+  }
 }
 
 void ParallelScavengeHeap::print_tracing_info() const {
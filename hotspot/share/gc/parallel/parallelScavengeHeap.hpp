@@ -36,6 +36,7 @@
 #include "gc/shared/referenceProcessor.hpp"
 #include "gc/shared/softRefPolicy.hpp"
 #include "gc/shared/strongRootsScope.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "logging/log.hpp"
 #include "memory/metaspace.hpp"
 #include "utilities/growableArray.hpp"
@@ -43,7 +44,6 @@
 
 class AdjoiningGenerations;
 class GCHeapSummary;
-class GCTaskManager;
 class MemoryManager;
 class MemoryPool;
 class PSAdaptiveSizePolicy;
@@ -67,9 +67,6 @@ class ParallelScavengeHeap : public CollectedHeap {
   AdjoiningGenerations* _gens;
   unsigned int _death_march_count;
 
-  // The task manager
-  static GCTaskManager* _gc_task_manager;
-
   GCMemoryManager* _young_manager;
   GCMemoryManager* _old_manager;
 
@@ -77,6 +74,8 @@ class ParallelScavengeHeap : public CollectedHeap {
   MemoryPool* _survivor_pool;
   MemoryPool* _old_pool;
 
+  WorkGang _workers;
+
   virtual void initialize_serviceability();
 
   void trace_heap(GCWhen::Type when, const GCTracer* tracer);
@@ -98,7 +97,11 @@ class ParallelScavengeHeap : public CollectedHeap {
     _old_manager(NULL),
     _eden_pool(NULL),
     _survivor_pool(NULL),
-    _old_pool(NULL) { }
+    _old_pool(NULL),
+    _workers("GC Thread",
+             ParallelGCThreads,
+             true /* are_GC_task_threads */,
+             false /* are_ConcurrentGC_threads */) { }
 
   // For use by VM operations
   enum CollectionType {
@@ -128,7 +131,10 @@ class ParallelScavengeHeap : public CollectedHeap {
 
   static ParallelScavengeHeap* heap();
 
-  static GCTaskManager* const gc_task_manager() { return _gc_task_manager; }
+  WorkGang* workers() {
+    return &_workers;
+  }
+  virtual WorkGang* get_safepoint_workers() { return &_workers; }
 
   CardTableBarrierSet* barrier_set();
   PSCardTable* card_table();
@@ -141,6 +147,12 @@ class ParallelScavengeHeap : public CollectedHeap {
   void post_initialize();
   void update_counters();
 
+  virtual void stop();
+
+  // Suspends the string deduplication thread, if any, at safepoints.
+  virtual void safepoint_synchronize_begin();
+  virtual void safepoint_synchronize_end();
+
   size_t capacity() const;
   size_t used() const;
 
@@ -35,6 +35,7 @@
 #include "gc/parallel/psMarkSweepDecorator.hpp"
 #include "gc/parallel/psOldGen.hpp"
 #include "gc/parallel/psScavenge.hpp"
+#include "gc/parallel/psStringDedup.hpp"
 #include "gc/parallel/psYoungGen.hpp"
 #include "gc/serial/markSweep.hpp"
 #include "gc/shared/gcCause.hpp"
@@ -499,8 +500,7 @@ void PSMarkSweep::allocate_stacks() {
 
 
 void PSMarkSweep::deallocate_stacks() {
-  _preserved_mark_stack.clear(true);
-  _preserved_oop_stack.clear(true);
+  _preserved_overflow_stack.clear(true);
   _marking_stack.clear();
   _objarray_stack.clear(true);
 }
@@ -554,6 +554,10 @@ void PSMarkSweep::mark_sweep_phase1(bool clear_all_softrefs) {
   {
     GCTraceTime(Debug, gc, phases) t("Weak Processing", _gc_timer);
     WeakProcessor::weak_oops_do(is_alive_closure(), &do_nothing_cl);
+
+    if (PSStringDedup::is_enabled()) {
+      PSStringDedup::unlink(is_alive_closure());
+    }
   }
 
   {
@@ -621,6 +625,10 @@ void PSMarkSweep::mark_sweep_phase3() {
   // Global (weak) JNI handles
   WeakProcessor::oops_do(adjust_pointer_closure());
 
+  if (PSStringDedup::is_enabled()) {
+    PSStringDedup::oops_do(adjust_pointer_closure());
+  }
+
   CodeBlobToOopClosure adjust_from_blobs(adjust_pointer_closure(), CodeBlobToOopClosure::FixRelocations);
   CodeCache::blobs_do(&adjust_from_blobs);
   AOT_ONLY(AOTLoader::oops_do(adjust_pointer_closure());)
@@ -24,7 +24,6 @@
 
 #include "precompiled.hpp"
 #include "classfile/javaClasses.inline.hpp"
-#include "gc/parallel/gcTaskManager.hpp"
 #include "gc/parallel/mutableSpace.hpp"
 #include "gc/parallel/parallelScavengeHeap.hpp"
 #include "gc/parallel/psOldGen.hpp"
@@ -79,6 +78,7 @@ void PSPromotionManager::initialize() {
   _preserved_marks_set->init(promotion_manager_num);
   for (uint i = 0; i < promotion_manager_num; i += 1) {
     _manager_array[i].register_preserved_marks(_preserved_marks_set->get(i));
+    _manager_array[i].set_worker_id(i);
   }
 }
 
@@ -210,6 +210,7 @@ PSPromotionManager::PSPromotionManager() {
   _min_array_size_for_chunking = 3 * _array_chunk_size / 2;
 
   _preserved_marks = NULL;
+  _worker_id = 0;
 
   reset();
 }
@@ -240,52 +241,8 @@ void PSPromotionManager::register_preserved_marks(PreservedMarks* preserved_mark
   _preserved_marks = preserved_marks;
 }
 
-class ParRestoreGCTask : public GCTask {
-private:
-  const uint _id;
-  PreservedMarksSet* const _preserved_marks_set;
-  volatile size_t* const _total_size_addr;
-
-public:
-  virtual char* name() {
-    return (char*) "preserved mark restoration task";
-  }
-
-  virtual void do_it(GCTaskManager* manager, uint which){
-    _preserved_marks_set->get(_id)->restore_and_increment(_total_size_addr);
-  }
-
-  ParRestoreGCTask(uint id,
-                   PreservedMarksSet* preserved_marks_set,
-                   volatile size_t* total_size_addr)
-    : _id(id),
-      _preserved_marks_set(preserved_marks_set),
-      _total_size_addr(total_size_addr) { }
-};
-
-class PSRestorePreservedMarksTaskExecutor : public RestorePreservedMarksTaskExecutor {
-private:
-  GCTaskManager* _gc_task_manager;
-
-public:
-  PSRestorePreservedMarksTaskExecutor(GCTaskManager* gc_task_manager)
-      : _gc_task_manager(gc_task_manager) { }
-
-  void restore(PreservedMarksSet* preserved_marks_set,
-               volatile size_t* total_size_addr) {
-    // GCTask / GCTaskQueue are ResourceObjs
-    ResourceMark rm;
-
-    GCTaskQueue* q = GCTaskQueue::create();
-    for (uint i = 0; i < preserved_marks_set->num(); i += 1) {
-      q->enqueue(new ParRestoreGCTask(i, preserved_marks_set, total_size_addr));
-    }
-    _gc_task_manager->execute_and_wait(q);
-  }
-};
-
 void PSPromotionManager::restore_preserved_marks() {
-  PSRestorePreservedMarksTaskExecutor task_executor(PSScavenge::gc_task_manager());
+  SharedRestorePreservedMarksTaskExecutor task_executor(ParallelScavengeHeap::heap()->workers());
   _preserved_marks_set->restore(&task_executor);
 }
 
@@ -88,6 +88,9 @@ class PSPromotionManager {
   PreservedMarks*                     _preserved_marks;
   PromotionFailedInfo                 _promotion_failed_info;
 
+  // Index in _manager_array, identifies the string deduplication queue
+  uint                                _worker_id;
+
   // Accessors
   static PSOldGen* old_gen()         { return _old_gen; }
   static MutableSpace* young_space() { return _young_space; }
@@ -147,8 +150,6 @@ class PSPromotionManager {
                                     uint age, bool tenured,
                                     const PSPromotionLAB* lab);
 
- protected:
-  static OopStarTaskQueueSet* stack_array_depth()   { return _stack_array_depth; }
  public:
   // Static
   static void initialize();
@@ -161,6 +162,9 @@ class PSPromotionManager {
 
   static bool steal_depth(int queue_num, StarTask& t);
 
+  // The queues other workers steal from, for task terminators.
+  static OopStarTaskQueueSet* stack_array_depth()   { return _stack_array_depth; }
+
   PSPromotionManager();
 
   // Accessors
@@ -179,6 +183,7 @@ class PSPromotionManager {
 
   void reset();
   void register_preserved_marks(PreservedMarks* preserved_marks);
+  void set_worker_id(uint worker_id) { _worker_id = worker_id; }
   static void restore_preserved_marks();
 
   void flush_labs();
@@ -31,6 +31,7 @@
 #include "gc/parallel/psPromotionLAB.inline.hpp"
 #include "gc/parallel/psPromotionManager.hpp"
 #include "gc/parallel/psScavenge.inline.hpp"
+#include "gc/parallel/psStringDedup.hpp"
 #include "gc/shared/taskqueue.inline.hpp"
 #include "logging/log.hpp"
 #include "memory/iterator.inline.hpp"
@@ -267,6 +268,10 @@ inline oop PSPromotionManager::copy_to_survivor_space(oop o) {
         assert(young_space()->contains(new_obj), "Attempt to push non-promoted obj");
       }
 
+      if (PSStringDedup::is_enabled()) {
+        PSStringDedup::enqueue_from_evacuation(!new_obj_is_tenured, _worker_id, new_obj);
+      }
+
       // Do the size comparison first with new_obj_size, which we
       // already have. Hopefully, only a few objects are larger than
       // _min_array_size_for_chunking, and most of them will be arrays.
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/javaClasses.inline.hpp"
+#include "gc/parallel/psStringDedup.hpp"
+#include "gc/shared/stringdedup/stringDedup.inline.hpp"
+#include "gc/shared/stringdedup/stringDedupBufferedQueue.hpp"
+#include "gc/shared/stringdedup/stringDedupQueue.inline.hpp"
+#include "gc/shared/stringdedup/stringDedupStat.hpp"
+#include "gc/shared/stringdedup/stringDedupTable.hpp"
+#include "oops/oop.inline.hpp"
+#include "runtime/safepoint.hpp"
+
+void PSStringDedup::initialize() {
+  assert(UseParallelGC, "String deduplication available with ParallelGC");
+  StringDedup::initialize_impl<StringDedupBufferedQueue, StringDedupStat>();
+}
+
+bool PSStringDedup::is_candidate_from_evacuation(bool to_young, oop obj) {
+  if (java_lang_String::is_instance_inlined(obj)) {
+    if (to_young && obj->age() == StringDeduplicationAgeThreshold) {
+      // Candidate found. String is being copied to the survivor space and
+      // just reached the deduplication age threshold.
+      return true;
+    }
+    if (!to_young && obj->age() < StringDeduplicationAgeThreshold) {
+      // Candidate found. String is being promoted but has not reached the
+      // deduplication age threshold, i.e. has not previously been a
+      // candidate during its life in the young generation.
+      return true;
+    }
+  }
+
+  // Not a candidate
+  return false;
+}
+
+void PSStringDedup::enqueue_from_evacuation(bool to_young, uint worker_id, oop java_string) {
+  assert(is_enabled(), "String deduplication not enabled");
+  if (is_candidate_from_evacuation(to_young, java_string)) {
+    StringDedupQueue::push(worker_id, java_string);
+  }
+}
+
+void PSStringDedup::publish_candidates() {
+  assert(is_enabled(), "String deduplication not enabled");
+  StringDedupBufferedQueue::publish();
+}
+
+void PSStringDedup::unlink_or_oops_do(BoolObjectClosure* is_alive,
+                                      OopClosure* keep_alive,
+                                      bool allow_resize_and_rehash) {
+  assert(SafepointSynchronize::is_at_safepoint(), "Must be at a safepoint");
+  assert(is_enabled(), "String deduplication not enabled");
+
+  StringDedupUnlinkOrOopsDoClosure cl(is_alive, keep_alive);
+  gc_prologue(allow_resize_and_rehash);
+  parallel_unlink(&cl, 0 /* worker_id */);
+  gc_epilogue();
+}
+
+void PSStringDedup::unlink(BoolObjectClosure* is_alive) {
+  unlink_or_oops_do(is_alive, NULL, false);
+}
+
+void PSStringDedup::oops_do(OopClosure* keep_alive) {
+  unlink_or_oops_do(NULL, keep_alive, false);
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_PARALLEL_PSSTRINGDEDUP_HPP
+#define SHARE_GC_PARALLEL_PSSTRINGDEDUP_HPP
+
+#include "gc/shared/stringdedup/stringDedup.hpp"
+#include "memory/allocation.hpp"
+#include "oops/oop.hpp"
+
+class BoolObjectClosure;
+class OopClosure;
+
+//
+// ParallelGC selects candidates while objects are copied by a scavenge,
+// using the same age based policy as G1 evacuation. The candidates are
+// published to the deduplication thread at the end of the scavenge, after
+// the queue and table have been updated by weak processing.
+//
+
+class PSStringDedup : public StringDedup {
+private:
+  static bool is_candidate_from_evacuation(bool to_young, oop obj);
+
+public:
+  // Initialize string deduplication.
+  static void initialize();
+
+  // Enqueues a String copied by a scavenge if it passes the candidate
+  // selection policy.
+  static void enqueue_from_evacuation(bool to_young, uint worker_id, oop java_string);
+
+  // Makes the candidates found by the scavenge visible to the deduplication thread.
+  static void publish_candidates();
+
+  // Apply the given is_alive and keep_alive closures serially on the VM thread.
+  static void unlink_or_oops_do(BoolObjectClosure* is_alive, OopClosure* keep_alive,
+                                bool allow_resize_and_rehash = true);
+
+  static void unlink(BoolObjectClosure* is_alive);
+  static void oops_do(OopClosure* keep_alive);
+};
+
+#endif // SHARE_GC_PARALLEL_PSSTRINGDEDUP_HPP
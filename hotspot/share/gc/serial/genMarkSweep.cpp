@@ -32,6 +32,7 @@
 #include "code/codeCache.hpp"
 #include "code/icBuffer.hpp"
 #include "gc/serial/genMarkSweep.hpp"
+#include "gc/serial/serialHeap.hpp"
 #include "gc/shared/collectedHeap.inline.hpp"
 #include "gc/shared/gcHeapSummary.hpp"
 #include "gc/shared/gcTimer.hpp"
@@ -46,10 +47,13 @@
 #include "gc/shared/space.hpp"
 #include "gc/shared/strongRootsScope.hpp"
 #include "gc/shared/weakProcessor.hpp"
+#include "gc/shared/workgroup.hpp"
+#include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
 #include "oops/instanceRefKlass.hpp"
 #include "oops/oop.inline.hpp"
 #include "prims/jvmtiExport.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/synchronizer.hpp"
 #include "runtime/thread.inline.hpp"
@@ -103,7 +107,7 @@ void GenMarkSweep::invoke_at_safepoint(ReferenceProcessor* rp, bool clear_all_so
 
   mark_sweep_phase4();
 
-  restore_marks();
+  restore_marks(full_gc_workers());
 
   // Set saved marks for allocation profiler (and other things? -- dld)
   // (Should this be in general part?)
@@ -149,6 +153,12 @@ void GenMarkSweep::invoke_at_safepoint(ReferenceProcessor* rp, bool clear_all_so
   gch->trace_heap_after_gc(_gc_tracer);
 }
 
+WorkGang* GenMarkSweep::full_gc_workers() {
+  // CMS also uses GenMarkSweep for its compacting collections, but always
+  // single-threaded.
+  return UseSerialGC ? SerialHeap::heap()->full_gc_workers() : NULL;
+}
+
 void GenMarkSweep::allocate_stacks() {
   GenCollectedHeap* gch = GenCollectedHeap::heap();
   // Scratch request on behalf of old generation; will do no allocation.
@@ -172,8 +182,7 @@ void GenMarkSweep::deallocate_stacks() {
   GenCollectedHeap* gch = GenCollectedHeap::heap();
   gch->release_scratch();
 
-  _preserved_mark_stack.clear(true);
-  _preserved_oop_stack.clear(true);
+  _preserved_overflow_stack.clear(true);
   _marking_stack.clear();
   _objarray_stack.clear(true);
 }
@@ -274,6 +283,35 @@ public:
   }
 };
 
+class GenCollectSpacesClosure: public SpaceClosure {
+  GrowableArray<Space*>* _spaces;
+public:
+  GenCollectSpacesClosure(GrowableArray<Space*>* spaces) : _spaces(spaces) { }
+  void do_space(Space* sp) {
+    _spaces->append(sp);
+  }
+};
+
+// Adjusts the pointers of all spaces in parallel, one space per worker. Adjusting
+// a space only writes to the objects in that space, and only reads the forwarding
+// pointers of the referenced objects, which are not modified in this phase.
+class GenParAdjustPointersTask: public AbstractGangTask {
+  GrowableArray<Space*>* _spaces;
+  volatile int _next_space;
+public:
+  GenParAdjustPointersTask(GrowableArray<Space*>* spaces) :
+    AbstractGangTask("Parallel Adjust Pointers"),
+    _spaces(spaces),
+    _next_space(0) { }
+
+  void work(uint worker_id) {
+    int idx;
+    while ((idx = Atomic::add(1, &_next_space) - 1) < _spaces->length()) {
+      _spaces->at(idx)->adjust_pointers();
+    }
+  }
+};
+
 void GenMarkSweep::mark_sweep_phase3() {
   GenCollectedHeap* gch = GenCollectedHeap::heap();
 
@@ -302,9 +340,21 @@ void GenMarkSweep::mark_sweep_phase3() {
 
   gch->gen_process_weak_roots(&adjust_pointer_closure);
 
-  adjust_marks();
-  GenAdjustPointersClosure blk;
-  gch->generation_iterate(&blk, true);
+  WorkGang* workers = full_gc_workers();
+  adjust_marks(workers);
+  if (workers != NULL) {
+    ResourceMark rm;
+    GrowableArray<Space*> spaces;
+    GenCollectSpacesClosure cl(&spaces);
+    gch->old_gen()->space_iterate(&cl, true);
+    gch->young_gen()->space_iterate(&cl, true);
+
+    GenParAdjustPointersTask task(&spaces);
+    workers->run_task(&task, MIN2(workers->active_workers(), (uint)spaces.length()));
+  } else {
+    GenAdjustPointersClosure blk;
+    gch->generation_iterate(&blk, true);
+  }
 }
 
 class GenCompactClosure: public GenCollectedHeap::GenClosure {
@@ -43,6 +43,10 @@ class GenMarkSweep : public MarkSweep {
   // Move objects to new positions
   static void mark_sweep_phase4();
 
+  // Helper threads for the adjust phase and the restoration of preserved
+  // marks, NULL if the full collection runs single-threaded.
+  static WorkGang* full_gc_workers();
+
   // Temporary data structures for traversal and storing/restoring marks
   static void allocate_stacks();
   static void deallocate_stacks();
@@ -28,6 +28,7 @@
 #include "gc/shared/collectedHeap.inline.hpp"
 #include "gc/shared/gcTimer.hpp"
 #include "gc/shared/gcTrace.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "memory/iterator.inline.hpp"
 #include "memory/universe.hpp"
 #include "oops/access.inline.hpp"
@@ -40,6 +41,7 @@
 #include "oops/objArrayKlass.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/typeArrayOop.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "utilities/macros.hpp"
 #include "utilities/stack.inline.hpp"
 
@@ -48,8 +50,7 @@ uint                    MarkSweep::_total_invocations = 0;
 Stack<oop, mtGC>              MarkSweep::_marking_stack;
 Stack<ObjArrayTask, mtGC>     MarkSweep::_objarray_stack;
 
-Stack<oop, mtGC>              MarkSweep::_preserved_oop_stack;
-Stack<markOop, mtGC>          MarkSweep::_preserved_mark_stack;
+Stack<PreservedMark, mtGC>    MarkSweep::_preserved_overflow_stack;
 size_t                  MarkSweep::_preserved_count = 0;
 size_t                  MarkSweep::_preserved_count_max = 0;
 PreservedMark*          MarkSweep::_preserved_marks = NULL;
@@ -162,8 +163,9 @@ void MarkSweep::preserve_mark(oop obj, markOop mark) {
   if (_preserved_count < _preserved_count_max) {
     _preserved_marks[_preserved_count++].init(obj, mark);
   } else {
-    _preserved_mark_stack.push(mark);
-    _preserved_oop_stack.push(obj);
+    PreservedMark pm;
+    pm.init(obj, mark);
+    _preserved_overflow_stack.push(pm);
   }
 }
 
@@ -174,39 +176,102 @@ void MarkSweep::set_ref_processor(ReferenceProcessor* rp) {
 
 AdjustPointerClosure MarkSweep::adjust_pointer_closure;
 
-void MarkSweep::adjust_marks() {
-  assert( _preserved_oop_stack.size() == _preserved_mark_stack.size(),
-         "inconsistent preserved oop stacks");
-
-  // adjust the oops we saved earlier
-  for (size_t i = 0; i < _preserved_count; i++) {
+void MarkSweep::adjust_marks_in_table(size_t from, size_t to) {
+  for (size_t i = from; i < to; i++) {
     _preserved_marks[i].adjust_pointer();
   }
+}
 
-  // deal with the overflow stack
-  StackIterator<oop, mtGC> iter(_preserved_oop_stack);
+void MarkSweep::restore_marks_in_table(size_t from, size_t to) {
+  for (size_t i = from; i < to; i++) {
+    _preserved_marks[i].restore();
+  }
+}
+
+void MarkSweep::adjust_overflow_marks() {
+  StackIterator<PreservedMark, mtGC> iter(_preserved_overflow_stack);
   while (!iter.is_empty()) {
-    oop* p = iter.next_addr();
-    adjust_pointer(p);
+    iter.next_addr()->adjust_pointer();
   }
 }
 
-void MarkSweep::restore_marks() {
-  assert(_preserved_oop_stack.size() == _preserved_mark_stack.size(),
-         "inconsistent preserved oop stacks");
-  log_trace(gc)("Restoring " SIZE_FORMAT " marks", _preserved_count + _preserved_oop_stack.size());
+void MarkSweep::restore_overflow_marks() {
+  while (!_preserved_overflow_stack.is_empty()) {
+    _preserved_overflow_stack.pop().restore();
+  }
+}
 
-  // restore the marks we saved earlier
-  for (size_t i = 0; i < _preserved_count; i++) {
-    _preserved_marks[i].restore();
+// Adjusts or restores the preserved marks table in chunks claimed by the
+// workers. The overflow stacks are processed by whichever worker gets to
+// them first.
+class ParPreservedMarksTask : public AbstractGangTask {
+  static const size_t ChunkSize = 1024;
+
+  const bool _restore;
+  const size_t _num_marks;
+  volatile size_t _next_chunk;
+  volatile uint _overflow_claimed;
+
+public:
+  ParPreservedMarksTask(bool restore, size_t num_marks) :
+    AbstractGangTask(restore ? "Parallel Preserved Marks Restoration" : "Parallel Preserved Marks Adjustment"),
+    _restore(restore),
+    _num_marks(num_marks),
+    _next_chunk(0),
+    _overflow_claimed(0) { }
+
+  void work(uint worker_id) {
+    if (Atomic::cmpxchg(1u, &_overflow_claimed, 0u) == 0u) {
+      if (_restore) {
+        MarkSweep::restore_overflow_marks();
+      } else {
+        MarkSweep::adjust_overflow_marks();
+      }
+    }
+    while (true) {
+      size_t end = Atomic::add(ChunkSize, &_next_chunk);
+      size_t start = end - ChunkSize;
+      if (start >= _num_marks) {
+        break;
+      }
+      end = MIN2(end, _num_marks);
+      if (_restore) {
+        MarkSweep::restore_marks_in_table(start, end);
+      } else {
+        MarkSweep::adjust_marks_in_table(start, end);
+      }
+    }
   }
+};
 
-  // deal with the overflow
-  while (!_preserved_oop_stack.is_empty()) {
-    oop obj       = _preserved_oop_stack.pop();
-    markOop mark  = _preserved_mark_stack.pop();
-    obj->set_mark_raw(mark);
+void MarkSweep::adjust_marks(WorkGang* workers) {
+  if (workers != NULL) {
+    ParPreservedMarksTask task(false /* restore */, _preserved_count);
+    workers->run_task(&task);
+    return;
   }
+
+  // adjust the oops we saved earlier
+  adjust_marks_in_table(0, _preserved_count);
+
+  // deal with the overflow stack
+  adjust_overflow_marks();
+}
+
+void MarkSweep::restore_marks(WorkGang* workers) {
+  log_trace(gc)("Restoring " SIZE_FORMAT " marks", _preserved_count + _preserved_overflow_stack.size());
+
+  if (workers != NULL) {
+    ParPreservedMarksTask task(true /* restore */, _preserved_count);
+    workers->run_task(&task);
+    return;
+  }
+
+  // restore the marks we saved earlier
+  restore_marks_in_table(0, _preserved_count);
+
+  // deal with the overflow
+  restore_overflow_marks();
 }
 
 MarkSweep::IsAliveClosure   MarkSweep::is_alive;
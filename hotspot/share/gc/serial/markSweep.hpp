@@ -39,6 +39,7 @@ class ReferenceProcessor;
 class DataLayout;
 class SerialOldTracer;
 class STWGCTimer;
+class WorkGang;
 
 // MarkSweep takes care of global mark-compact garbage collection for a
 // GenCollectedHeap using a four-phase pointer forwarding algorithm.  All
@@ -48,10 +49,24 @@ class STWGCTimer;
 // Class unloading will only occur when a full gc is invoked.
 
 // declared at end
-class PreservedMark;
 class MarkAndPushClosure;
 class AdjustPointerClosure;
 
+class PreservedMark {
+private:
+  oop _obj;
+  markOop _mark;
+
+public:
+  void init(oop obj, markOop mark) {
+    _obj = obj;
+    _mark = mark;
+  }
+
+  void adjust_pointer();
+  void restore();
+};
+
 class MarkSweep : AllStatic {
   //
   // Inline closure decls
@@ -100,8 +115,7 @@ class MarkSweep : AllStatic {
   static Stack<ObjArrayTask, mtGC>             _objarray_stack;
 
   // Space for storing/restoring mark word
-  static Stack<markOop, mtGC>                  _preserved_mark_stack;
-  static Stack<oop, mtGC>                      _preserved_oop_stack;
+  static Stack<PreservedMark, mtGC>            _preserved_overflow_stack;
   static size_t                          _preserved_count;
   static size_t                          _preserved_count_max;
   static PreservedMark*                  _preserved_marks;
@@ -139,8 +153,12 @@ class MarkSweep : AllStatic {
 
   static void preserve_mark(oop p, markOop mark);
                                 // Save the mark word so it can be restored later
-  static void adjust_marks();   // Adjust the pointers in the preserved marks table
-  static void restore_marks();  // Restore the marks that we saved in preserve_mark
+  // Adjust the pointers in the preserved marks table. Uses the given workers,
+  // if any, to process the table in parallel.
+  static void adjust_marks(WorkGang* workers = NULL);
+  // Restore the marks that we saved in preserve_mark, in parallel if workers
+  // are given.
+  static void restore_marks(WorkGang* workers = NULL);
 
   static int adjust_pointers(oop obj);
 
@@ -156,6 +174,14 @@ class MarkSweep : AllStatic {
   template <class T> static void mark_and_push(T* p);
 
  private:
+  friend class ParPreservedMarksTask;
+
+  // Process the [from, to) part of the preserved marks table, and the overflow stacks.
+  static void adjust_marks_in_table(size_t from, size_t to);
+  static void restore_marks_in_table(size_t from, size_t to);
+  static void adjust_overflow_marks();
+  static void restore_overflow_marks();
+
   // Call backs for marking
   static void mark_object(oop obj);
   // Mark pointer and follow contents.  Empty marking stack afterwards.
@@ -196,19 +222,4 @@ class AdjustPointerClosure: public BasicOopsInGenClosure {
   debug_only(virtual bool should_verify_oops() { return false; })
 };
 
-class PreservedMark {
-private:
-  oop _obj;
-  markOop _mark;
-
-public:
-  void init(oop obj, markOop mark) {
-    _obj = obj;
-    _mark = mark;
-  }
-
-  void adjust_pointer();
-  void restore();
-};
-
 #endif // SHARE_GC_SERIAL_MARKSWEEP_HPP
@@ -27,7 +27,9 @@
 #include "gc/serial/serialHeap.hpp"
 #include "gc/serial/tenuredGeneration.inline.hpp"
 #include "gc/shared/genMemoryPools.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "memory/universe.hpp"
+#include "runtime/os.hpp"
 #include "services/memoryManager.hpp"
 
 SerialHeap* SerialHeap::heap() {
@@ -43,11 +45,30 @@ SerialHeap::SerialHeap() :
                      "Copy:MSC"),
     _eden_pool(NULL),
     _survivor_pool(NULL),
-    _old_pool(NULL) {
+    _old_pool(NULL),
+    _full_gc_workers(NULL) {
   _young_manager = new GCMemoryManager("Copy", "end of minor GC");
   _old_manager = new GCMemoryManager("MarkSweepCompact", "end of major GC");
 }
 
+jint SerialHeap::initialize() {
+  // Set up the helper threads first, they pre-touch the generations.
+  // Helper threads do not pay off without a second processor to run them on.
+  uint num_workers = MIN2(SerialFullGCThreads, (uint)os::active_processor_count());
+  if (num_workers > 1) {
+    _full_gc_workers = new WorkGang("Serial Full GC Thread", num_workers,
+                                    /* are_GC_task_threads */true,
+                                    /* are_ConcurrentGC_threads */false);
+    if (_full_gc_workers == NULL) {
+      return JNI_ENOMEM;
+    }
+    _full_gc_workers->initialize_workers();
+    _full_gc_workers->update_active_workers(num_workers);
+  }
+
+  return GenCollectedHeap::initialize();
+}
+
 void SerialHeap::initialize_serviceability() {
 
   DefNewGeneration* young = young_gen();
@@ -90,3 +111,15 @@ GrowableArray<MemoryPool*> SerialHeap::memory_pools() {
   memory_pools.append(_old_pool);
   return memory_pools;
 }
+
+void SerialHeap::print_gc_threads_on(outputStream* st) const {
+  if (_full_gc_workers != NULL) {
+    _full_gc_workers->print_worker_threads_on(st);
+  }
+}
+
+void SerialHeap::gc_threads_do(ThreadClosure* tc) const {
+  if (_full_gc_workers != NULL) {
+    _full_gc_workers->threads_do(tc);
+  }
+}
@@ -33,6 +33,7 @@
 class GCMemoryManager;
 class MemoryPool;
 class TenuredGeneration;
+class WorkGang;
 
 class SerialHeap : public GenCollectedHeap {
 private:
@@ -40,6 +41,9 @@ private:
   MemoryPool* _survivor_pool;
   MemoryPool* _old_pool;
 
+  // Helper threads for full collections, NULL if they run single-threaded.
+  WorkGang* _full_gc_workers;
+
   virtual void initialize_serviceability();
 
 public:
@@ -47,6 +51,8 @@ public:
 
   SerialHeap();
 
+  virtual jint initialize();
+
   virtual Name kind() const {
     return CollectedHeap::Serial;
   }
@@ -58,6 +64,12 @@ public:
   virtual GrowableArray<GCMemoryManager*> memory_managers();
   virtual GrowableArray<MemoryPool*> memory_pools();
 
+  WorkGang* full_gc_workers() const { return _full_gc_workers; }
+  virtual WorkGang* get_safepoint_workers() { return _full_gc_workers; }
+
+  virtual void print_gc_threads_on(outputStream* st) const;
+  virtual void gc_threads_do(ThreadClosure* tc) const;
+
   DefNewGeneration* young_gen() const {
     assert(_young_gen->kind() == Generation::DefNew, "Wrong generation type");
     return static_cast<DefNewGeneration*>(_young_gen);
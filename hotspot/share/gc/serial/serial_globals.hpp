@@ -38,6 +38,13 @@
                         lp64_product,                                       \
                         range,                                              \
                         constraint,                                         \
-                        writeable)
+                        writeable)                                          \
+                                                                            \
+  product(uint, SerialFullGCThreads, 0,                                     \
+          "Number of threads the Serial collector uses to adjust pointers " \
+          "and restore preserved marks during full collections. Limited "   \
+          "to the number of active processors; a value of 0 or 1 keeps "    \
+          "full collections single-threaded")                               \
+          range(0, max_jint)
 
 #endif // SHARE_GC_SERIAL_SERIAL_GLOBALS_HPP
@@ -25,6 +25,8 @@
 #include "precompiled.hpp"
 #include "gc/shared/barrierSet.hpp"
 #include "gc/shared/barrierSetAssembler.hpp"
+#include "gc/shared/sweeperBarrierSetNMethod.hpp"
+#include "runtime/globals_extension.hpp"
 #include "runtime/thread.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/macros.hpp"
@@ -57,3 +59,17 @@ void gc_barrier_stubs_init() {
   bs_assembler->barrier_stubs_init();
 #endif
 }
+
+BarrierSetNMethod* BarrierSet::make_sweeper_barrier_set_nmethod() {
+  if (!SweepUsingEntryBarriers) {
+    return NULL;
+  }
+#ifdef AMD64
+  return new SweeperBarrierSetNMethod();
+#else
+  // Only the x86_64 compilers emit nmethod entry barriers.
+  warning("SweepUsingEntryBarriers is not supported on this platform");
+  FLAG_SET_DEFAULT(SweepUsingEntryBarriers, false);
+  return NULL;
+#endif
+}
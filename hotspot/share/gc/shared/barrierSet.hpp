@@ -121,6 +121,10 @@ protected:
     return COMPILER2_PRESENT(new BarrierSetC2T()) NOT_COMPILER2(NULL);
   }
 
+  // For collectors without nmethod entry barriers of their own. Returns
+  // NULL unless SweepUsingEntryBarriers is set.
+  static BarrierSetNMethod* make_sweeper_barrier_set_nmethod();
+
 public:
   // Support for optimizing compilers to call the barrier set on slow path allocations
   // that did not enter a TLAB. Used for e.g. ReduceInitialCardMarks.
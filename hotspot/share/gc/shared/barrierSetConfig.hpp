@@ -43,6 +43,13 @@
   FOR_EACH_ABSTRACT_BARRIER_SET_DO(f) \
   FOR_EACH_CONCRETE_BARRIER_SET_DO(f)
 
+// If CardTableBarrierSet is the only concrete barrier set in the build, i.e.
+// a VM with only Serial, Parallel and/or CMS, accesses are bound to it at
+// compile time instead of going through the RuntimeDispatch function pointers.
+#if !INCLUDE_EPSILONGC && !INCLUDE_G1GC && !INCLUDE_SHENANDOAHGC && !INCLUDE_ZGC
+#define ACCESS_HARDWIRED_BARRIER_SET CardTableBarrierSet
+#endif
+
 // To enable runtime-resolution of GC barriers on primitives, please
 // define SUPPORT_BARRIER_ON_PRIMITIVES.
 #ifdef SUPPORT_BARRIER_ON_PRIMITIVES
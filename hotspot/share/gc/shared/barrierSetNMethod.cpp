@@ -28,6 +28,8 @@
 #include "gc/shared/barrierSet.hpp"
 #include "gc/shared/barrierSetNMethod.hpp"
 #include "logging/log.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/sweeper.hpp"
 #include "runtime/thread.hpp"
 #include "utilities/debug.hpp"
 
@@ -37,6 +39,14 @@ int BarrierSetNMethod::disarmed_value() const {
   return *reinterpret_cast<int*>(disarmed_addr);
 }
 
+// The sweeper arms in-use nmethods when it visits them, so reaching the
+// barrier means the nmethod was used since the last visit.
+static void record_use(nmethod* nm) {
+  if (SweepUsingEntryBarriers) {
+    nm->set_hotness_counter(NMethodSweeper::hotness_counter_reset_val());
+  }
+}
+
 bool BarrierSetNMethod::supports_entry_barrier(nmethod* nm) {
   if (nm->method()->is_method_handle_intrinsic()) {
     return false;
@@ -67,6 +77,8 @@ int BarrierSetNMethod::nmethod_stub_entry_barrier(address* return_address_ptr) {
   if (!may_enter) {
     log_trace(nmethod, barrier)("Deoptimizing nmethod: " PTR_FORMAT, p2i(nm));
     bs_nm->deoptimize(nm, return_address_ptr);
+  } else {
+    record_use(nm);
   }
   return may_enter ? 0 : 1;
 }
@@ -83,5 +95,9 @@ bool BarrierSetNMethod::nmethod_osr_entry_barrier(nmethod* nm) {
 
   assert(nm->is_osr_method(), "Should not reach here");
   log_trace(nmethod, barrier)("Running osr nmethod entry barrier: " PTR_FORMAT, p2i(nm));
-  return nmethod_entry_barrier(nm);
+  bool may_enter = nmethod_entry_barrier(nm);
+  if (may_enter) {
+    record_use(nm);
+  }
+  return may_enter;
 }
@@ -46,6 +46,8 @@ public:
   bool nmethod_osr_entry_barrier(nmethod* nm);
   bool is_armed(nmethod* nm);
   void disarm(nmethod* nm);
+  // Arms with a value that is never a disarmed value.
+  void arm(nmethod* nm);
 };
 
 
@@ -156,10 +156,26 @@ void CollectedHeap::trace_heap(GCWhen::Type when, const GCTracer* gc_tracer) {
 
 void CollectedHeap::trace_heap_before_gc(const GCTracer* gc_tracer) {
   trace_heap(GCWhen::BeforeGC, gc_tracer);
+
+  if (UsePerfData) {
+    const size_t used_now = used();
+    const jlong elapsed = os::elapsed_counter() - _last_gc_end_ticks;
+    if (elapsed > 0 && used_now >= _used_after_last_gc) {
+      const jlong rate = (jlong)((double)(used_now - _used_after_last_gc) *
+                                 os::elapsed_frequency() / elapsed);
+      _perf_allocation_rate->record(rate);
+      _perf_recent_allocation_rate->record(rate);
+    }
+  }
 }
 
 void CollectedHeap::trace_heap_after_gc(const GCTracer* gc_tracer) {
   trace_heap(GCWhen::AfterGC, gc_tracer);
+
+  if (UsePerfData) {
+    _used_after_last_gc = used();
+    _last_gc_end_ticks = os::elapsed_counter();
+  }
 }
 
 // WhiteBox API support for concurrent collectors.  These are the
@@ -197,7 +213,11 @@ CollectedHeap::CollectedHeap() :
   _total_collections(0),
   _total_full_collections(0),
   _gc_cause(GCCause::_no_gc),
-  _gc_lastcause(GCCause::_no_gc)
+  _gc_lastcause(GCCause::_no_gc),
+  _perf_allocation_rate(NULL),
+  _perf_recent_allocation_rate(NULL),
+  _used_after_last_gc(0),
+  _last_gc_end_ticks(os::elapsed_counter())
 {
   const size_t max_len = size_t(arrayOopDesc::max_array_length(T_INT));
   const size_t elements_per_word = HeapWordSize / sizeof(jint);
@@ -217,6 +237,15 @@ CollectedHeap::CollectedHeap() :
     _perf_gc_lastcause =
                 PerfDataManager::create_string_variable(SUN_GC, "lastCause",
                              80, GCCause::to_string(_gc_lastcause), CHECK);
+
+    // 1 MB/s, doubling up to 8 GB/s and beyond
+    _perf_allocation_rate =
+                PerfDataManager::create_long_histogram(SUN_GC, "allocationRateHistogram",
+                             PerfData::U_Bytes, M, 15, CHECK);
+
+    _perf_recent_allocation_rate =
+                PerfDataManager::create_long_ring(SUN_GC, "allocationRateRecent",
+                             PerfData::U_Bytes, 32, CHECK);
   }
 
   // Create the ring log
@@ -567,6 +596,10 @@ bool CollectedHeap::supports_object_pinning() const {
   return false;
 }
 
+bool CollectedHeap::can_pin_object(oop obj) const {
+  return supports_object_pinning();
+}
+
 oop CollectedHeap::pin_object(JavaThread* thread, oop obj) {
   ShouldNotReachHere();
   return NULL;
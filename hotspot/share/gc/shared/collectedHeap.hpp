@@ -51,6 +51,7 @@ class GCTracer;
 class GCMemoryManager;
 class MemoryPool;
 class MetaspaceSummary;
+class ObjectClosure;
 class SoftRefPolicy;
 class Thread;
 class ThreadClosure;
@@ -83,6 +84,17 @@ class GCHeapLog : public EventLogBase<GCMessage> {
   }
 };
 
+// Iterates over all objects in the heap using multiple worker threads.
+// An instance is obtained from CollectedHeap::parallel_object_iterator()
+// and is shared by all workers of a single parallel iteration; each worker
+// calls object_iterate() with its own worker id and visits a disjoint part
+// of the heap. Must be used at a safepoint.
+class ParallelObjectIterator : public CHeapObj<mtGC> {
+ public:
+  virtual void object_iterate(ObjectClosure* cl, uint worker_id) = 0;
+  virtual ~ParallelObjectIterator() {}
+};
+
 //
 // CollectedHeap
 //   GenCollectedHeap
@@ -122,6 +134,12 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   PerfStringVariable* _perf_gc_cause;
   PerfStringVariable* _perf_gc_lastcause;
 
+  // Allocation rate between collections, in bytes per second
+  PerfLongHistogram* _perf_allocation_rate;
+  PerfLongRing* _perf_recent_allocation_rate;
+  size_t _used_after_last_gc;
+  jlong _last_gc_end_ticks;
+
   // Constructor
   CollectedHeap();
 
@@ -402,6 +420,13 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   // over live objects.
   virtual void safe_object_iterate(ObjectClosure* cl) = 0;
 
+  // Returns an iterator that allows thread_num workers to iterate over
+  // the objects in the heap in parallel, or NULL if the collector does not
+  // support parallel object iteration. The caller owns the iterator.
+  virtual ParallelObjectIterator* parallel_object_iterator(uint thread_num) {
+    return NULL;
+  }
+
   // NOTE! There is no requirement that a collector implement these
   // functions.
   //
@@ -516,14 +541,19 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   // it for use during safepoint cleanup. This is only possible
   // if the GC can pause and resume concurrent work (e.g. G1
   // concurrent marking) for an intermittent non-GC safepoint.
-  // If this method returns NULL, SafepointSynchronize will
-  // perform cleanup tasks serially in the VMThread.
+  // Stop-the-world collectors can always share theirs. If this
+  // method returns NULL, SafepointSynchronize will perform cleanup
+  // tasks serially in the VMThread.
   virtual WorkGang* get_safepoint_workers() { return NULL; }
 
   // Support for object pinning. This is used by JNI Get*Critical()
   // and Release*Critical() family of functions. If supported, the GC
   // must guarantee that pinned objects never move.
   virtual bool supports_object_pinning() const;
+  // Collectors that can only pin some objects override this to select
+  // them, the others are protected with the GCLocker instead. The answer
+  // must not change for an object between pinning and unpinning it.
+  virtual bool can_pin_object(oop obj) const;
   virtual oop pin_object(JavaThread* thread, oop obj);
   virtual void unpin_object(JavaThread* thread, oop obj);
 
@@ -59,6 +59,18 @@ CollectorCounters::CollectorCounters(const char* name, int ordinal) {
     _last_exit_time = PerfDataManager::create_variable(SUN_GC, cname,
                                                        PerfData::U_Ticks,
                                                        CHECK);
+
+    // 100 us, doubling up to 26 s and beyond
+    cname = PerfDataManager::counter_name(_name_space, "timeHistogram");
+    _time_histogram = PerfDataManager::create_long_histogram(SUN_GC, cname,
+                                                             PerfData::U_Ticks,
+                                                             MAX2((jlong)1, os::elapsed_frequency() / 10000),
+                                                             20, CHECK);
+
+    cname = PerfDataManager::counter_name(_name_space, "recentTimes");
+    _recent_times = PerfDataManager::create_long_ring(SUN_GC, cname,
+                                                      PerfData::U_Ticks,
+                                                      32, CHECK);
   }
 }
 
@@ -68,6 +80,11 @@ CollectorCounters::~CollectorCounters() {
   }
 }
 
+void CollectorCounters::record_time(jlong ticks) {
+  _time_histogram->record(ticks);
+  _recent_times->record(ticks);
+}
+
 TraceCollectorStats::TraceCollectorStats(CollectorCounters* c) :
     PerfTraceTimedEvent(c->time_counter(), c->invocation_counter()),
     _c(c) {
@@ -79,6 +96,8 @@ TraceCollectorStats::TraceCollectorStats(CollectorCounters* c) :
 
 TraceCollectorStats::~TraceCollectorStats() {
   if (UsePerfData) {
-    _c->last_exit_counter()->set_value(os::elapsed_counter());
+    jlong now = os::elapsed_counter();
+    _c->last_exit_counter()->set_value(now);
+    _c->record_time(now - _c->last_entry_counter()->get_value());
   }
 }
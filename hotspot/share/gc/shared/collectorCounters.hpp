@@ -38,6 +38,8 @@ class CollectorCounters: public CHeapObj<mtGC> {
     PerfCounter*      _time;
     PerfVariable*     _last_entry_time;
     PerfVariable*     _last_exit_time;
+    PerfLongHistogram* _time_histogram;
+    PerfLongRing*     _recent_times;
 
     // Constant PerfData types don't need to retain a reference.
     // However, it's a good idea to document them here.
@@ -59,6 +61,9 @@ class CollectorCounters: public CHeapObj<mtGC> {
 
     inline PerfVariable* last_exit_counter() const  { return _last_exit_time; }
 
+    // Distribution and history of the individual invocation times
+    void record_time(jlong ticks);
+
     const char* name_space() const                  { return _name_space; }
 };
 
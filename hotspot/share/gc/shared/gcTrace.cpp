@@ -69,6 +69,12 @@ void GCTracer::report_gc_reference_stats(const ReferenceProcessorStats& rps) con
   send_reference_stats_event(REF_PHANTOM, rps.phantom_count());
 }
 
+void GCTracer::report_gc_phase_parallel_summary(const char* name, const WorkerDataArray<double>* phase) const {
+  assert(name != NULL, "invariant");
+  assert(phase != NULL, "invariant");
+  send_phase_parallel_summary_event(name, phase);
+}
+
 #if INCLUDE_SERVICES
 class ObjectCountEventSenderClosure : public KlassInfoClosure {
   const double _size_threshold_percentage;
@@ -244,6 +250,12 @@ void G1NewTracer::report_adaptive_ihop_statistics(size_t threshold,
                                 prediction_active);
 }
 
+void G1NewTracer::report_pause_phase_prediction(const char* phase,
+                                                double predicted_time_ms,
+                                                double actual_time_ms) {
+  send_pause_phase_prediction(phase, predicted_time_ms, actual_time_ms);
+}
+
 void G1OldTracer::report_gc_start_impl(GCCause::Cause cause, const Ticks& timestamp) {
   _shared_gc_info.set_start_timestamp(timestamp);
 }
@@ -43,6 +43,7 @@ class GCHeapSummary;
 class MetaspaceChunkFreeListSummary;
 class MetaspaceSummary;
 class PSHeapSummary;
+template <class T> class WorkerDataArray;
 class G1HeapSummary;
 class G1EvacSummary;
 class ReferenceProcessorStats;
@@ -121,6 +122,8 @@ class GCTracer : public ResourceObj {
   void report_gc_heap_summary(GCWhen::Type when, const GCHeapSummary& heap_summary) const;
   void report_metaspace_summary(GCWhen::Type when, const MetaspaceSummary& metaspace_summary) const;
   void report_gc_reference_stats(const ReferenceProcessorStats& rp) const;
+  // Times are in seconds, as recorded by the collectors' phase timings
+  void report_gc_phase_parallel_summary(const char* name, const WorkerDataArray<double>* phase) const;
   void report_object_count_after_gc(BoolObjectClosure* object_filter) NOT_SERVICES_RETURN;
 
  protected:
@@ -135,6 +138,7 @@ class GCTracer : public ResourceObj {
   void send_metaspace_chunk_free_list_summary(GCWhen::Type when, Metaspace::MetadataType mdtype, const MetaspaceChunkFreeListSummary& summary) const;
   void send_reference_stats_event(ReferenceType type, size_t count) const;
   void send_phase_events(TimePartitions* time_partitions) const;
+  void send_phase_parallel_summary_event(const char* name, const WorkerDataArray<double>* phase) const;
 };
 
 class YoungGCTracer : public GCTracer {
@@ -266,6 +270,9 @@ class G1NewTracer : public YoungGCTracer {
                                        double predicted_allocation_rate,
                                        double predicted_marking_length,
                                        bool prediction_active);
+  void report_pause_phase_prediction(const char* phase,
+                                     double predicted_time_ms,
+                                     double actual_time_ms);
  private:
   void send_g1_young_gc_event();
   void send_evacuation_info_event(G1EvacuationInfo* info);
@@ -287,6 +294,9 @@ class G1NewTracer : public YoungGCTracer {
                                      double predicted_allocation_rate,
                                      double predicted_marking_length,
                                      bool prediction_active);
+  void send_pause_phase_prediction(const char* phase,
+                                   double predicted_time_ms,
+                                   double actual_time_ms);
 };
 
 class G1FullGCTracer : public OldGCTracer {
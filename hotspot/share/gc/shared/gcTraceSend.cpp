@@ -28,6 +28,7 @@
 #include "gc/shared/gcTimer.hpp"
 #include "gc/shared/gcTrace.hpp"
 #include "gc/shared/gcWhen.hpp"
+#include "gc/shared/workerDataArray.inline.hpp"
 #include "jfr/jfrEvents.hpp"
 #include "runtime/os.hpp"
 #include "utilities/macros.hpp"
@@ -64,6 +65,45 @@ void GCTracer::send_reference_stats_event(ReferenceType type, size_t count) cons
   }
 }
 
+static jlong secs_to_nanos(double secs) {
+  return (jlong)(secs * NANOSECS_PER_SEC);
+}
+
+void GCTracer::send_phase_parallel_summary_event(const char* name, const WorkerDataArray<double>* phase) const {
+  EventGCPhaseParallelSummary e;
+  if (e.should_commit()) {
+    // Workers that did not take part in the phase have no value
+    double min = 0.0;
+    double max = 0.0;
+    double sum = 0.0;
+    uint workers = 0;
+    for (uint i = 0; i < phase->length(); i++) {
+      const double value = phase->get(i);
+      if (value == WorkerDataArray<double>::uninitialized()) {
+        continue;
+      }
+      min = workers == 0 ? value : MIN2(min, value);
+      max = workers == 0 ? value : MAX2(max, value);
+      sum += value;
+      workers++;
+    }
+    if (workers == 0) {
+      // phase skipped in this collection
+      return;
+    }
+    const double avg = sum / workers;
+    e.set_gcId(GCId::current());
+    e.set_name(name);
+    e.set_workers(workers);
+    e.set_minimum(secs_to_nanos(min));
+    e.set_average(secs_to_nanos(avg));
+    e.set_maximum(secs_to_nanos(max));
+    e.set_sum(secs_to_nanos(sum));
+    e.set_imbalance(max > 0.0 ? (float)((max - avg) / max) : 0.0f);
+    e.commit();
+  }
+}
+
 void GCTracer::send_metaspace_chunk_free_list_summary(GCWhen::Type when, Metaspace::MetadataType mdtype,
                                                       const MetaspaceChunkFreeListSummary& summary) const {
   EventMetaspaceChunkFreeListSummary e;
@@ -309,6 +349,19 @@ void G1NewTracer::send_adaptive_ihop_statistics(size_t threshold,
   }
 }
 
+void G1NewTracer::send_pause_phase_prediction(const char* phase,
+                                              double predicted_time_ms,
+                                              double actual_time_ms) {
+  EventG1PausePhasePrediction evt;
+  if (evt.should_commit()) {
+    evt.set_gcId(GCId::current());
+    evt.set_phase(phase);
+    evt.set_predictedTime(predicted_time_ms * NANOSECS_PER_MILLISEC);
+    evt.set_actualTime(actual_time_ms * NANOSECS_PER_MILLISEC);
+    evt.commit();
+  }
+}
+
 #endif // INCLUDE_G1GC
 
 static JfrStructVirtualSpace to_struct(const VirtualSpaceSummary& summary) {
@@ -315,6 +315,15 @@ oop* OopStorage::Block::allocate() {
   }
 }
 
+// Allocates all the free entries, returning a bitmask of the entries
+// taken.  Only the free entries change state, and release only changes
+// entries that were already allocated, so an exchange suffices.
+uintx OopStorage::Block::allocate_all() {
+  uintx old_allocated = Atomic::xchg(~uintx(0), &_allocated_bitmask);
+  assert(!is_full_bitmask(old_allocated), "attempt to allocate from full block");
+  return ~old_allocated;
+}
+
 OopStorage::Block* OopStorage::Block::new_block(const OopStorage* owner) {
   // _data must be first member: aligning block => aligning _data.
   STATIC_ASSERT(_data_pos == 0);
@@ -436,6 +445,42 @@ oop* OopStorage::allocate() {
   return result;
 }
 
+size_t OopStorage::allocate(oop** ptrs, size_t size) {
+  assert(size > 0, "precondition");
+  Block* block;
+  uintx taken;
+  {
+    MutexLocker ml(_allocation_mutex, Mutex::_no_safepoint_check_flag);
+    block = block_for_allocation();
+    if (block == NULL) return 0; // Block allocation failed.
+    if (block->is_empty()) {
+      // Transitioning from empty to not empty.
+      log_debug(oopstorage, blocks)("%s: block not empty " PTR_FORMAT, name(), p2i(block));
+    }
+    // Taking all the free entries makes the block full, so remove it from
+    // consideration by future allocates.
+    taken = block->allocate_all();
+    log_debug(oopstorage, blocks)("%s: block full " PTR_FORMAT, name(), p2i(block));
+    _allocation_list.unlink(*block);
+  }
+
+  size_t count = 0;
+  while ((count < size) && (taken != 0)) {
+    unsigned index = count_trailing_zeros(taken);
+    taken ^= block->bitmask_for_index(index);
+    ptrs[count++] = block->get_pointer(index);
+  }
+  Atomic::add(count, &_allocation_count); // release updates outside lock.
+  if (taken != 0) {
+    // Hand back the entries that were not requested.  The block is no
+    // longer full, so this records a deferred update that puts it back
+    // on the _allocation_list.
+    block->release_entries(taken, this);
+  }
+  log_trace(oopstorage, ref)("%s: bulk allocated " SIZE_FORMAT, name(), count);
+  return count;
+}
+
 bool OopStorage::try_add_block() {
   assert_lock_strong(_allocation_mutex);
   Block* block;
@@ -104,6 +104,15 @@ public:
   // postcondition: *result == NULL.
   oop* allocate();
 
+  // Allocates up to size new entries, storing them in ptrs[0, result), and
+  // returns the number of entries allocated.  Takes all the free entries of
+  // a block with a single locking of _allocation_mutex, handing back those
+  // that were not requested, so the result may be less than size.  Returns
+  // 0 if memory allocation failed.
+  // precondition: size > 0.
+  // postcondition: *ptrs[i] == NULL, for i in [0,result).
+  size_t allocate(oop** ptrs, size_t size);
+
   // Deallocates ptr.  No locking.
   // precondition: ptr is a valid allocated entry.
   // precondition: *ptr == NULL.
@@ -128,8 +128,7 @@ public:
 
   // Iterate over all stacks, restore all preserved marks, and reclaim
   // the memory taken up by the stack segments.
-  // Supported executors: SharedRestorePreservedMarksTaskExecutor (Serial, CMS, G1),
-  // PSRestorePreservedMarksTaskExecutor (PS).
+  // Supported executors: SharedRestorePreservedMarksTaskExecutor (Serial, CMS, G1, PS).
   inline void restore(RestorePreservedMarksTaskExecutor* executor);
 
   // Reclaim stack array.
@@ -35,6 +35,7 @@
 #include "oops/arrayOop.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/typeArrayOop.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/safepointVerifiers.hpp"
 
@@ -266,8 +267,20 @@ void StringDedupTable::transfer(StringDedupEntry** pentry, StringDedupTable* des
   unsigned int hash = entry->hash();
   size_t index = dest->hash_to_index(hash);
   StringDedupEntry** list = dest->bucket(index);
-  entry->set_next(*list);
-  *list = entry;
+
+  // Workers only have exclusive access to the source partition they claimed,
+  // entries from other partitions may be pushed onto the same destination
+  // bucket concurrently. The destination table is never read or unlinked
+  // until it has been installed, so a lock-free push is sufficient.
+  StringDedupEntry* head = *list;
+  for (;;) {
+    entry->set_next(head);
+    StringDedupEntry* result = Atomic::cmpxchg(entry, list, head);
+    if (result == head) {
+      break;
+    }
+    head = result;
+  }
 }
 
 typeArrayOop StringDedupTable::lookup(typeArrayOop value, bool latin1, unsigned int hash,
@@ -390,19 +403,27 @@ bool StringDedupTable::is_rehashing() {
 
 StringDedupTable* StringDedupTable::prepare_resize() {
   size_t size = _table->_size;
-
-  // Check if the hashtable needs to be resized
-  if (_table->_entries > _table->_grow_threshold) {
-    // Grow table, double the size
-    size *= 2;
-    if (size > _max_size) {
+  const uintx entries = _table->_entries;
+
+  // Check if the hashtable needs to be resized. Since entries can be
+  // transferred to any destination bucket, the table goes straight to
+  // the size matching the current number of entries, instead of being
+  // doubled or halved once per scan.
+  if (entries > _table->_grow_threshold) {
+    // Grow table
+    while (size < _max_size && entries > (uintx)(size * _grow_load_factor)) {
+      size *= 2;
+    }
+    if (size == _table->_size) {
       // Too big, don't resize
       return NULL;
     }
-  } else if (_table->_entries < _table->_shrink_threshold) {
-    // Shrink table, half the size
-    size /= 2;
-    if (size < _min_size) {
+  } else if (entries < _table->_shrink_threshold) {
+    // Shrink table
+    while (size > _min_size && entries < (uintx)(size * _shrink_load_factor)) {
+      size /= 2;
+    }
+    if (size == _table->_size) {
       // Too small, don't resize
       return NULL;
     }
@@ -444,20 +465,15 @@ void StringDedupTable::finish_resize(StringDedupTable* resized_table) {
 void StringDedupTable::unlink_or_oops_do(StringDedupUnlinkOrOopsDoClosure* cl, uint worker_id) {
   // The table is divided into partitions to allow lock-less parallel processing by
   // multiple worker threads. A worker thread first claims a partition, which ensures
-  // exclusive access to that part of the table, then continues to process it. To allow
-  // shrinking of the table in parallel we also need to make sure that the same worker
-  // thread processes all partitions where entries will hash to the same destination
-  // partition. Since the table size is always a power of two and we always shrink by
-  // dividing the table in half, we know that for a given partition there is only one
-  // other partition whoes entries will hash to the same destination partition. That
-  // other partition is always the sibling partition in the second half of the table.
-  // For example, if the table is divided into 8 partitions, the sibling of partition 0
-  // is partition 4, the sibling of partition 1 is partition 5, etc.
-  size_t table_half = _table->_size / 2;
+  // exclusive access to that part of the table, then continues to process it. When
+  // the table is resized or rehashed, live entries are transferred to the new table
+  // as they are scanned, using a lock-free push onto the destination bucket, so any
+  // number of workers can populate the new table in parallel.
+  size_t table_size = _table->_size;
 
   // Let each partition be one page worth of buckets
-  size_t partition_size = MIN2(table_half, os::vm_page_size() / sizeof(StringDedupEntry*));
-  assert(table_half % partition_size == 0, "Invalid partition size");
+  size_t partition_size = MIN2(table_size, os::vm_page_size() / sizeof(StringDedupEntry*));
+  assert(table_size % partition_size == 0, "Invalid partition size");
 
   // Number of entries removed during the scan
   uintx removed = 0;
@@ -466,14 +482,12 @@ void StringDedupTable::unlink_or_oops_do(StringDedupUnlinkOrOopsDoClosure* cl, u
     // Grab next partition to scan
     size_t partition_begin = claim_table_partition(partition_size);
     size_t partition_end = partition_begin + partition_size;
-    if (partition_begin >= table_half) {
+    if (partition_begin >= table_size) {
       // End of table
       break;
     }
 
-    // Scan the partition followed by the sibling partition in the second half of the table
     removed += unlink_or_oops_do(cl, partition_begin, partition_end, worker_id);
-    removed += unlink_or_oops_do(cl, table_half + partition_begin, table_half + partition_end, worker_id);
   }
 
   // Delayed update to avoid contention on the table lock
@@ -498,19 +512,15 @@ uintx StringDedupTable::unlink_or_oops_do(StringDedupUnlinkOrOopsDoClosure* cl,
         if (is_resizing()) {
           // We are resizing the table, transfer entry to the new table
           _table->transfer(entry, _resized_table);
+        } else if (is_rehashing()) {
+          // We are rehashing the table, rehash the entry using the
+          // new hash seed and transfer it to the new table
+          typeArrayOop value = (typeArrayOop)*p;
+          bool latin1 = (*entry)->latin1();
+          unsigned int hash = hash_code(value, latin1);
+          (*entry)->set_hash(hash);
+          _table->transfer(entry, _rehashed_table);
         } else {
-          if (is_rehashing()) {
-            // We are rehashing the table, rehash the entry but keep it
-            // in the table. We can't transfer entries into the new table
-            // at this point since we don't have exclusive access to all
-            // destination partitions. finish_rehash() will do a single
-            // threaded transfer of all entries.
-            typeArrayOop value = (typeArrayOop)*p;
-            bool latin1 = (*entry)->latin1();
-            unsigned int hash = hash_code(value, latin1);
-            (*entry)->set_hash(hash);
-          }
-
           // Move to next entry
           entry = (*entry)->next_addr();
         }
@@ -541,7 +551,9 @@ void StringDedupTable::gc_prologue(bool resize_and_rehash_table) {
 
 void StringDedupTable::gc_epilogue() {
   assert(!is_resizing() || !is_rehashing(), "Can not both resize and rehash");
-  assert(_claimed_index >= _table->_size / 2 || _claimed_index == 0, "All or nothing");
+  assert(_claimed_index >= _table->_size || _claimed_index == 0, "All or nothing");
+  assert(_claimed_index > 0 || (!is_resizing() && !is_rehashing()),
+         "Entries are only transferred to a resized or rehashed table by scanning");
 
   if (is_resizing()) {
     StringDedupTable::finish_resize(_resized_table);
@@ -571,14 +583,6 @@ StringDedupTable* StringDedupTable::prepare_rehash() {
 void StringDedupTable::finish_rehash(StringDedupTable* rehashed_table) {
   assert(rehashed_table != NULL, "Invalid table");
 
-  // Move all newly rehashed entries into the correct buckets in the new table
-  for (size_t bucket = 0; bucket < _table->_size; bucket++) {
-    StringDedupEntry** entry = _table->bucket(bucket);
-    while (*entry != NULL) {
-      _table->transfer(entry, rehashed_table);
-    }
-  }
-
   rehashed_table->_entries = _table->_entries;
 
   // Free old table
@@ -100,11 +100,15 @@ public:
 //
 // The table is dynamically resized to accommodate the current number of table entries.
 // The table has hash buckets with chains for hash collision. If the average chain
-// length goes above or below given thresholds the table grows or shrinks accordingly.
+// length goes above or below given thresholds the table grows or shrinks accordingly,
+// directly to the size matching the number of entries.
 //
 // The table is also dynamically rehashed (using a new hash seed) if it becomes severely
 // unbalanced, i.e., a hash chain is significantly longer than average.
 //
+// Both resizing and rehashing are done by the GC workers while they scan the table in
+// unlink_or_oops_do(), transferring each live entry into the new table as they go.
+//
 // All access to the table is protected by the StringDedupTable_lock, except under
 // safepoints in which case GC workers are allowed to access a table partitions they
 // have claimed without first acquiring the lock. Note however, that this applies only
@@ -173,6 +177,7 @@ private:
   void remove(StringDedupEntry** pentry, uint worker_id);
 
   // Transfers a table entry from the current table to the destination table.
+  // Safe to call concurrently for entries in different source partitions.
   void transfer(StringDedupEntry** pentry, StringDedupTable* dest);
 
   // Returns an existing character array in the given hash bucket, or NULL
@@ -225,8 +230,7 @@ private:
   // hashtable and updates the hash seed.
   static StringDedupTable* prepare_rehash();
 
-  // Transfers rehashed entries from the currently active table into
-  // the new table. Installs the new table as the currently active table
+  // Installs a newly rehashed table as the currently active table
   // and deletes the previously active table.
   static void finish_rehash(StringDedupTable* rehashed_table);
 
@@ -41,7 +41,7 @@ uint ParallelTaskTerminator::_total_peeks = 0;
 
 #if TASKQUEUE_STATS
 const char * const TaskQueueStats::_names[last_stat_id] = {
-  "qpush", "qpop", "qpop-s", "qattempt", "qsteal", "opush", "omax"
+  "qpush", "qpop", "qpop-s", "qattempt", "qsteal", "qsteal-b", "opush", "omax"
 };
 
 TaskQueueStats & TaskQueueStats::operator +=(const TaskQueueStats & addend)
@@ -93,9 +93,9 @@ void TaskQueueStats::print(outputStream* stream, unsigned int width) const
 // quiescent; they do not hold at arbitrary times.
 void TaskQueueStats::verify() const
 {
-  assert(get(push) == get(pop) + get(steal),
-         "push=" SIZE_FORMAT " pop=" SIZE_FORMAT " steal=" SIZE_FORMAT,
-         get(push), get(pop), get(steal));
+  assert(get(push) == get(pop) + get(steal) + get(steal_bulk),
+         "push=" SIZE_FORMAT " pop=" SIZE_FORMAT " steal=" SIZE_FORMAT " steal_bulk=" SIZE_FORMAT,
+         get(push), get(pop), get(steal), get(steal_bulk));
   assert(get(pop_slow) <= get(pop),
          "pop_slow=" SIZE_FORMAT " pop=" SIZE_FORMAT,
          get(pop_slow), get(pop));
@@ -54,6 +54,7 @@ public:
     pop_slow,         // subset of taskqueue pops that were done slow-path
     steal_attempt,    // number of taskqueue steal attempts
     steal,            // number of taskqueue steals
+    steal_bulk,       // number of extra tasks moved to the local queue by steals
     overflow,         // number of overflow pushes
     overflow_max_len, // max length of overflow stack
     last_stat_id
@@ -67,6 +68,7 @@ public:
   inline void record_pop_slow()      { record_pop(); ++_stats[pop_slow]; }
   inline void record_steal_attempt() { ++_stats[steal_attempt]; }
   inline void record_steal()         { ++_stats[steal]; }
+  inline void record_steal_bulk()    { ++_stats[steal_bulk]; }
   inline void record_overflow(size_t new_length);
 
   TaskQueueStats & operator +=(const TaskQueueStats & addend);
@@ -302,8 +304,10 @@ private:
   DEFINE_PAD_MINUS_SIZE(0, DEFAULT_CACHE_LINE_SIZE, 0);
   // Element array.
   volatile E* _elems;
+  // NUMA node the owner was last seen running on; read by thieves.
+  uint _numa_id;
 
-  DEFINE_PAD_MINUS_SIZE(1, DEFAULT_CACHE_LINE_SIZE, sizeof(E*));
+  DEFINE_PAD_MINUS_SIZE(1, DEFAULT_CACHE_LINE_SIZE, sizeof(E*) + sizeof(uint));
   // Queue owner local variables. Not to be accessed by other threads.
 
   static const uint InvalidQueueId = uint(-1);
@@ -315,6 +319,9 @@ private:
 public:
   int next_random_queue_id();
 
+  void set_numa_id(uint id)                  { _numa_id = id; }
+  uint numa_id() const                       { return _numa_id; }
+
   void set_last_stolen_queue_id(uint id)     { _last_stolen_queue_id = id; }
   uint last_stolen_queue_id() const          { return _last_stolen_queue_id; }
   bool is_last_stolen_queue_id_valid() const { return _last_stolen_queue_id != InvalidQueueId; }
@@ -322,7 +329,7 @@ public:
 };
 
 template<class E, MEMFLAGS F, unsigned int N>
-GenericTaskQueue<E, F, N>::GenericTaskQueue() : _last_stolen_queue_id(InvalidQueueId), _seed(17 /* random number */) {
+GenericTaskQueue<E, F, N>::GenericTaskQueue() : _numa_id(0), _last_stolen_queue_id(InvalidQueueId), _seed(17 /* random number */) {
   assert(sizeof(Age) == sizeof(size_t), "Depends on this.");
 }
 
@@ -385,8 +392,11 @@ public:
 private:
   uint _n;
   T** _queues;
+  uint _steal_batch;
 
-  bool steal_best_of_2(uint queue_num, E& t);
+  uint random_victim(uint queue_num, uint other, bool same_node);
+  bool steal_best_of_2(uint queue_num, E& t, bool same_node);
+  void steal_more(T* local_queue, T* victim, uint victim_size);
 
 public:
   GenericTaskQueueSet(uint n);
@@ -396,6 +406,11 @@ public:
 
   T* queue(uint n);
 
+  // Allow steals to take up to "batch" tasks at once: one is returned, the
+  // rest are pushed onto the thief's own queue. Only for sets where the
+  // stealing worker always passes the id of the queue it owns.
+  void set_steal_batch(uint batch) { _steal_batch = MAX2(batch, 1u); }
+
   // Try to steal a task from some other queue than queue_num. It may perform several attempts at doing so.
   // Returns if stealing succeeds, and sets "t" to the stolen task.
   bool steal(uint queue_num, E& t);
@@ -29,12 +29,14 @@
 #include "memory/allocation.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/globals.hpp"
 #include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/stack.inline.hpp"
 
 template <class T, MEMFLAGS F>
-inline GenericTaskQueueSet<T, F>::GenericTaskQueueSet(uint n) : _n(n) {
+inline GenericTaskQueueSet<T, F>::GenericTaskQueueSet(uint n) : _n(n), _steal_batch(1) {
   typedef T* GenericTaskQueuePtr;
   _queues = NEW_C_HEAP_ARRAY(GenericTaskQueuePtr, n, F);
   for (uint i = 0; i < n; i++) {
@@ -251,8 +253,26 @@ int GenericTaskQueue<E, F, N>::next_random_queue_id() {
   return randomParkAndMiller(&_seed);
 }
 
+// Pick a random queue other than queue_num and other. If same_node is set,
+// prefer queues whose owners run on the same NUMA node as the caller, but
+// give up on that after a bounded number of tries.
+template<class T, MEMFLAGS F> uint
+GenericTaskQueueSet<T, F>::random_victim(uint queue_num, uint other, bool same_node) {
+  T* const local_queue = _queues[queue_num];
+  uint tries = 0;
+  while (true) {
+    uint k = local_queue->next_random_queue_id() % _n;
+    if (k == queue_num || k == other) {
+      continue;
+    }
+    if (!same_node || ++tries > _n || _queues[k]->numa_id() == local_queue->numa_id()) {
+      return k;
+    }
+  }
+}
+
 template<class T, MEMFLAGS F> bool
-GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, E& t) {
+GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, E& t, bool same_node) {
   if (_n > 2) {
     T* const local_queue = _queues[queue_num];
     uint k1 = queue_num;
@@ -261,32 +281,33 @@ GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, E& t) {
       k1 = local_queue->last_stolen_queue_id();
       assert(k1 != queue_num, "Should not be the same");
     } else {
-      while (k1 == queue_num) {
-        k1 = local_queue->next_random_queue_id() % _n;
-      }
+      k1 = random_victim(queue_num, queue_num, same_node);
     }
 
-    uint k2 = queue_num;
-    while (k2 == queue_num || k2 == k1) {
-      k2 = local_queue->next_random_queue_id() % _n;
-    }
+    uint k2 = random_victim(queue_num, k1, same_node);
     // Sample both and try the larger.
     uint sz1 = _queues[k1]->size();
     uint sz2 = _queues[k2]->size();
 
     uint sel_k = 0;
+    uint sel_sz = 0;
     bool suc = false;
 
     if (sz2 > sz1) {
       sel_k = k2;
+      sel_sz = sz2;
       suc = _queues[k2]->pop_global(t);
     } else if (sz1 > 0) {
       sel_k = k1;
+      sel_sz = sz1;
       suc = _queues[k1]->pop_global(t);
     }
 
     if (suc) {
       local_queue->set_last_stolen_queue_id(sel_k);
+      if (_steal_batch > 1) {
+        steal_more(local_queue, _queues[sel_k], sel_sz);
+      }
     } else {
       local_queue->invalidate_last_stolen_queue_id();
     }
@@ -295,19 +316,55 @@ GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, E& t) {
   } else if (_n == 2) {
     // Just try the other one.
     uint k = (queue_num + 1) % 2;
-    return _queues[k]->pop_global(t);
+    uint sz = _queues[k]->size();
+    bool suc = _queues[k]->pop_global(t);
+    if (suc && _steal_batch > 1) {
+      steal_more(_queues[queue_num], _queues[k], sz);
+    }
+    return suc;
   } else {
     assert(_n == 1, "can't be zero.");
     return false;
   }
 }
 
+// Having won one task from victim, which held about victim_size tasks, move
+// up to half of the rest onto the local queue. Each task is still claimed by
+// its own pop_global(): the owner pops without CAS while more than one task
+// is left, so claiming a whole range at once could race with it. Batching
+// saves the victim selection and the trips through steal() and termination.
+template<class T, MEMFLAGS F> void
+GenericTaskQueueSet<T, F>::steal_more(T* local_queue, T* victim, uint victim_size) {
+  if (victim_size < 3) {
+    return;
+  }
+  // Only the owner pushes to its queue, so the free space can only grow
+  // while we are here. Keep away from the slow push path.
+  uint room = local_queue->max_elems() - MIN2(local_queue->size(), local_queue->max_elems());
+  uint n = MIN3(_steal_batch - 1, (victim_size - 1) / 2, room);
+  for (uint i = 0; i < n; i++) {
+    E task;
+    if (!victim->pop_global(task)) {
+      break;
+    }
+    bool pushed = local_queue->push(task);
+    assert(pushed, "Local queue has room");
+    TASKQUEUE_STATS_ONLY(local_queue->stats.record_steal_bulk());
+  }
+}
+
 template<class T, MEMFLAGS F> bool
 GenericTaskQueueSet<T, F>::steal(uint queue_num, E& t) {
+  T* const local_queue = queue(queue_num);
+  // Look on the same NUMA node first, for the first half of the attempts.
+  bool numa = UseNUMA && _n > 2;
+  if (numa) {
+    local_queue->set_numa_id((uint) os::numa_get_group_id());
+  }
   for (uint i = 0; i < 2 * _n; i++) {
-    TASKQUEUE_STATS_ONLY(queue(queue_num)->stats.record_steal_attempt());
-    if (steal_best_of_2(queue_num, t)) {
-      TASKQUEUE_STATS_ONLY(queue(queue_num)->stats.record_steal());
+    TASKQUEUE_STATS_ONLY(local_queue->stats.record_steal_attempt());
+    if (steal_best_of_2(queue_num, t, numa && i < _n)) {
+      TASKQUEUE_STATS_ONLY(local_queue->stats.record_steal());
       return true;
     }
   }
@@ -57,10 +57,10 @@ void ThreadLocalAllocBuffer::accumulate_and_reset_statistics(ThreadLocalAllocSta
 
   print_stats("gc");
 
-  if (_number_of_refills > 0) {
-    // Update allocation history if a reasonable amount of eden was allocated.
-    bool update_allocation_history = used > 0.5 * capacity;
+  // Update allocation history if a reasonable amount of eden was allocated.
+  bool update_allocation_history = used > 0.5 * capacity;
 
+  if (_number_of_refills > 0) {
     if (update_allocation_history) {
       // Average the fraction of eden allocated in a tlab by this
       // thread for use in the next resize operation.
@@ -82,10 +82,23 @@ void ThreadLocalAllocBuffer::accumulate_and_reset_statistics(ThreadLocalAllocSta
     assert(_number_of_refills == 0 && _fast_refill_waste == 0 &&
            _slow_refill_waste == 0 && _gc_waste          == 0,
            "tlab stats == 0");
+
+    // A thread that did not refill during a full epoch is mostly idle.
+    // Decay its share of eden so that the next resize() shrinks its
+    // TLAB instead of keeping a large buffer it does not fill, which
+    // would otherwise be retired as gc waste and fragment eden.
+    if (update_allocation_history && allocated_since_last_gc == 0) {
+      _allocation_fraction.sample(0.0f);
+    }
   }
 
   stats->update_slow_allocations(_slow_allocations);
 
+  _total_refills          += _number_of_refills;
+  _total_slow_allocations += _slow_allocations;
+  _total_refill_waste     += _fast_refill_waste + _slow_refill_waste;
+  _total_gc_waste         += _gc_waste;
+
   reset_statistics();
 }
 
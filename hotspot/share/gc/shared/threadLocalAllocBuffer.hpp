@@ -68,6 +68,13 @@ private:
   unsigned  _slow_allocations;
   size_t    _allocated_size;
 
+  // Totals since thread start, folded in from the per-epoch counters above at
+  // each GC. Read without synchronization by the JFR periodic sampler.
+  size_t    _total_refills;
+  size_t    _total_slow_allocations;
+  size_t    _total_refill_waste;
+  size_t    _total_gc_waste;
+
   AdaptiveWeightedAverage _allocation_fraction;  // fraction of eden allocated in tlabs
 
   void reset_statistics();
@@ -111,7 +118,12 @@ private:
   int slow_allocations() const  { return _slow_allocations; }
 
 public:
-  ThreadLocalAllocBuffer() : _allocated_before_last_gc(0), _allocation_fraction(TLABAllocationWeight) {
+  ThreadLocalAllocBuffer() : _allocated_before_last_gc(0),
+                             _total_refills(0),
+                             _total_slow_allocations(0),
+                             _total_refill_waste(0),
+                             _total_gc_waste(0),
+                             _allocation_fraction(TLABAllocationWeight) {
     // do nothing.  tlabs must be inited by initialize() calls
   }
 
@@ -133,6 +145,13 @@ public:
   size_t refill_waste_limit() const              { return _refill_waste_limit; }
   size_t bytes_since_last_sample_point() const   { return _bytes_since_last_sample_point; }
 
+  // Per-thread statistics accumulated since thread start.
+  size_t total_refills() const                   { return _total_refills; }
+  size_t total_slow_allocations() const          { return _total_slow_allocations; }
+  size_t total_refill_waste() const              { return _total_refill_waste; }
+  size_t total_gc_waste() const                  { return _total_gc_waste; }
+  float allocation_fraction() const              { return _allocation_fraction.average(); }
+
   // Allocate size HeapWords. The memory is NOT initialized to zero.
   inline HeapWord* allocate(size_t size);
 
@@ -28,6 +28,7 @@
 #include "logging/log.hpp"
 #include "memory/universe.hpp"
 #include "runtime/os.inline.hpp"
+#include "runtime/resourceLimitWatcher.hpp"
 #include "runtime/vm_version.hpp"
 
 bool WorkerPolicy::_debug_perturbation = false;
@@ -119,6 +120,12 @@ uint WorkerPolicy::calc_default_active_workers(uintx total_workers,
   uintx max_active_workers =
     MAX2(active_workers_by_JT, active_workers_by_heap_size);
 
+  // Workers beyond the processors currently available, e.g. after the
+  // container was resized, only compete with each other.
+  uintx active_workers_by_cpus =
+    MAX2((uintx) ResourceLimitWatcher::active_processor_count(), min_workers);
+  max_active_workers = MIN2(max_active_workers, active_workers_by_cpus);
+
   new_active_workers = MIN2(max_active_workers, (uintx) total_workers);
 
   // Increase GC workers instantly but decrease them more
@@ -156,9 +163,10 @@ uint WorkerPolicy::calc_default_active_workers(uintx total_workers,
   log_trace(gc, task)("WorkerPolicy::calc_default_active_workers() : "
     "active_workers(): " UINTX_FORMAT "  new_active_workers: " UINTX_FORMAT "  "
     "prev_active_workers: " UINTX_FORMAT "\n"
-    " active_workers_by_JT: " UINTX_FORMAT "  active_workers_by_heap_size: " UINTX_FORMAT,
+    " active_workers_by_JT: " UINTX_FORMAT "  active_workers_by_heap_size: " UINTX_FORMAT
+    "  active_workers_by_cpus: " UINTX_FORMAT,
     active_workers, new_active_workers, prev_active_workers,
-    active_workers_by_JT, active_workers_by_heap_size);
+    active_workers_by_JT, active_workers_by_heap_size, active_workers_by_cpus);
   assert(new_active_workers > 0, "Always need at least 1");
   return new_active_workers;
 }
@@ -289,6 +289,7 @@ AbstractGangWorker::AbstractGangWorker(AbstractWorkGang* gang, uint id) {
   _gang = gang;
   set_id(id);
   set_name("%s#%d", gang->name(), id);
+  enable_chunk_cache();
 }
 
 void AbstractGangWorker::run() {
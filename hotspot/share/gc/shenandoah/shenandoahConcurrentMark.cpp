@@ -347,6 +347,7 @@ void ShenandoahConcurrentMark::initialize(uint workers) {
   uint num_queues = MAX2(workers, 1U);
 
   _task_queues = new ShenandoahObjToScanQueueSet((int) num_queues);
+  _task_queues->set_steal_batch((uint) WorkStealingBatchSize);
 
   for (uint i = 0; i < num_queues; ++i) {
     ShenandoahObjToScanQueue* task_queue = new ShenandoahObjToScanQueue();
@@ -69,6 +69,7 @@ ShenandoahHeapRegion::ShenandoahHeapRegion(ShenandoahHeap* heap, HeapWord* start
   _seqnum_first_alloc_gc(0),
   _seqnum_last_alloc_mutator(0),
   _seqnum_last_alloc_gc(0),
+  _age(0),
   _live_data(0) {
 
   ContiguousSpace::initialize(_reserved, true, committed);
@@ -333,6 +334,7 @@ void ShenandoahHeapRegion::reset_alloc_metadata() {
   _seqnum_last_alloc_mutator = 0;
   _seqnum_first_alloc_gc = 0;
   _seqnum_last_alloc_gc = 0;
+  _age = 0;
 }
 
 void ShenandoahHeapRegion::reset_alloc_metadata_to_shared() {
@@ -254,6 +254,9 @@ private:
   uint64_t _seqnum_last_alloc_mutator;
   uint64_t _seqnum_last_alloc_gc;
 
+  // Number of GC cycles without allocations into this region
+  uint _age;
+
   volatile size_t _live_data;
 
   // Claim some space at the end to protect next region
@@ -423,6 +426,20 @@ public:
     return _seqnum_last_alloc_gc;
   }
 
+  uint age() const {
+    return _age;
+  }
+
+  // Called once per cycle. Ages the region if it has not seen any
+  // allocations since the given allocation sequence number.
+  void update_age(uint64_t seqnum_last_cycle) {
+    if (seqnum_last_alloc() > seqnum_last_cycle) {
+      _age = 0;
+    } else if (_age < UINT_MAX) {
+      _age++;
+    }
+  }
+
 private:
   void do_commit();
   void do_uncommit();
@@ -69,6 +69,7 @@ ShenandoahHeuristics::ShenandoahHeuristics() :
   _degenerated_cycles_in_a_row(0),
   _successful_cycles_in_a_row(0),
   _bytes_in_cset(0),
+  _seqnum_last_cset(0),
   _cycle_start(os::elapsedTime()),
   _last_cycle_end(0),
   _gc_times_learned(0),
@@ -136,10 +137,20 @@ void ShenandoahHeuristics::choose_collection_set(ShenandoahCollectionSet* collec
   size_t free = 0;
   size_t free_regions = 0;
 
+  size_t old_regions = 0;
+
+  // Regions that have not been allocated into for a while mostly hold long-lived
+  // objects. Leave them out of most collection sets, so evacuation work goes to
+  // the regions that are still filled by the application.
+  const size_t cycle = heap->shenandoah_policy()->cycle_counter();
+  const bool collect_old = ShenandoahOldRegionAge == 0 ||
+                           (cycle % ShenandoahOldRegionCollectionInterval) == 0;
+
   ShenandoahMarkingContext* const ctx = heap->complete_marking_context();
 
   for (size_t i = 0; i < num_regions; i++) {
     ShenandoahHeapRegion* region = heap->get_region(i);
+    region->update_age(_seqnum_last_cset);
 
     size_t garbage = region->garbage();
     total_garbage += garbage;
@@ -153,6 +164,9 @@ void ShenandoahHeuristics::choose_collection_set(ShenandoahCollectionSet* collec
         immediate_regions++;
         immediate_garbage += garbage;
         region->make_trash_immediate();
+      } else if (!collect_old && region->age() >= ShenandoahOldRegionAge) {
+        // Old region, not collected in this cycle.
+        old_regions++;
       } else {
         // This is our candidate for later consideration.
         candidates[cand_idx]._region = region;
@@ -182,6 +196,12 @@ void ShenandoahHeuristics::choose_collection_set(ShenandoahCollectionSet* collec
     }
   }
 
+  _seqnum_last_cset = ShenandoahHeapRegion::seqnum_current_alloc();
+
+  if (old_regions > 0) {
+    log_info(gc, ergo)("Old Regions: " SIZE_FORMAT " regions not considered for collection", old_regions);
+  }
+
   // Step 2. Look back at garbage statistics, and decide if we want to collect anything,
   // given the amount of immediately reclaimable garbage. If we do, figure out the collection set.
 
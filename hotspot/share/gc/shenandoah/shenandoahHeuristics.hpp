@@ -88,6 +88,10 @@ protected:
 
   size_t _bytes_in_cset;
 
+  // Allocation sequence number at the last collection set selection,
+  // used to age the regions.
+  uint64_t _seqnum_last_cset;
+
   double _cycle_start;
   double _last_cycle_end;
 
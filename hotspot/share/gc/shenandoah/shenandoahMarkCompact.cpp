@@ -43,12 +43,14 @@
 #include "gc/shenandoah/shenandoahVerifier.hpp"
 #include "gc/shenandoah/shenandoahVMOperations.hpp"
 #include "gc/shenandoah/shenandoahWorkerPolicy.hpp"
+#include "logging/logStream.hpp"
 #include "memory/metaspace.hpp"
 #include "memory/universe.hpp"
 #include "oops/compressedOops.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/biasedLocking.hpp"
 #include "runtime/thread.hpp"
+#include "utilities/bitMap.inline.hpp"
 #include "utilities/copy.hpp"
 #include "utilities/growableArray.hpp"
 #include "gc/shared/workgroup.hpp"
@@ -324,24 +326,6 @@ private:
   PreservedMarksSet*        const _preserved_marks;
   ShenandoahHeap*           const _heap;
   ShenandoahHeapRegionSet** const _worker_slices;
-  ShenandoahRegionIterator        _heap_regions;
-
-  ShenandoahHeapRegion* next_from_region(ShenandoahHeapRegionSet* slice) {
-    ShenandoahHeapRegion* from_region = _heap_regions.next();
-
-    while (from_region != NULL && (!from_region->is_move_allowed() || from_region->is_humongous())) {
-      from_region = _heap_regions.next();
-    }
-
-    if (from_region != NULL) {
-      assert(slice != NULL, "sanity");
-      assert(!from_region->is_humongous(), "this path cannot handle humongous regions");
-      assert(from_region->is_move_allowed(), "only regions that can be moved in mark-compact");
-      slice->add_region(from_region);
-    }
-
-    return from_region;
-  }
 
 public:
   ShenandoahPrepareForCompactionTask(PreservedMarksSet* preserved_marks, ShenandoahHeapRegionSet** worker_slices) :
@@ -350,9 +334,16 @@ public:
     _heap(ShenandoahHeap::heap()), _worker_slices(worker_slices) {
   }
 
+  // Can move the region, and this is not the humongous region. Humongous
+  // moves are special cased here, because their moves are handled separately.
+  static bool is_candidate_region(ShenandoahHeapRegion* r) {
+    return r->is_move_allowed() && !r->is_humongous();
+  }
+
   void work(uint worker_id) {
     ShenandoahHeapRegionSet* slice = _worker_slices[worker_id];
-    ShenandoahHeapRegion* from_region = next_from_region(slice);
+    ShenandoahHeapRegionSetIterator it(slice);
+    ShenandoahHeapRegion* from_region = it.next();
     // No work?
     if (from_region == NULL) {
       return;
@@ -364,6 +355,8 @@ public:
     GrowableArray<ShenandoahHeapRegion*> empty_regions((int)_heap->num_regions());
     ShenandoahPrepareForCompactionObjectClosure cl(_preserved_marks->get(worker_id), empty_regions, from_region);
     while (from_region != NULL) {
+      assert(is_candidate_region(from_region), "Sanity");
+
       cl.set_from_region(from_region);
       if (from_region->has_live()) {
         _heap->marked_object_iterate(from_region, &cl);
@@ -373,7 +366,7 @@ public:
       if (!cl.is_compact_same_region()) {
         empty_regions.append(from_region);
       }
-      from_region = next_from_region(slice);
+      from_region = it.next();
     }
     cl.finish_region();
 
@@ -490,6 +483,143 @@ public:
   }
 };
 
+void ShenandoahMarkCompact::distribute_slices(ShenandoahHeapRegionSet** worker_slices) {
+  ShenandoahHeap* heap = ShenandoahHeap::heap();
+
+  uint n_workers = heap->workers()->active_workers();
+  size_t n_regions = heap->num_regions();
+
+  // The work in both computing the new addresses and copying the objects is driven
+  // by the live data that needs moving, not by the number of regions. Handing out
+  // regions one by one lets a worker that happens to claim a few dense regions lag
+  // behind the others. Instead, slice the heap up front so that every worker gets
+  // about the same amount of live data to slide.
+  //
+  // Each worker first takes a contiguous part of the heap prefix, sized to hold its
+  // share of the live data when fully compacted, so that the result is a dense prefix.
+  // The regions after that are handed out round-robin to the workers that still need
+  // live data. Since everything slides left within a slice, this keeps the leftmost,
+  // busiest tail regions spread across all workers:
+  //
+  //  AAAAAAAABBBBBBBBCCCCCCCC|ABCABCABCABCABCABCABCABABABABABABABABABABAAAAA
+  //
+  //  (.....dense-prefix.....) (.....................tail...................)
+  //  [all regions fully live] [left-most regions are fuller that right-most]
+  //
+
+  size_t total_live = 0;
+  for (size_t idx = 0; idx < n_regions; idx++) {
+    ShenandoahHeapRegion* r = heap->get_region(idx);
+    if (ShenandoahPrepareForCompactionTask::is_candidate_region(r)) {
+      total_live += r->get_live_data_words();
+    }
+  }
+
+  // Estimate the dense prefix. Only full regions are counted, so every slice
+  // has some non-full regions in its tail.
+  size_t live_per_worker = total_live / n_workers;
+  size_t prefix_regions_per_worker = live_per_worker / ShenandoahHeapRegion::region_size_words();
+  size_t prefix_regions_total = MIN2(prefix_regions_per_worker * n_workers, n_regions);
+
+  // Non-candidate regions in the prefix push the start of the tail further out.
+  size_t prefix_end = prefix_regions_total;
+  for (size_t idx = 0; idx < prefix_regions_total; idx++) {
+    ShenandoahHeapRegion* r = heap->get_region(idx);
+    if (!ShenandoahPrepareForCompactionTask::is_candidate_region(r)) {
+      prefix_end++;
+    }
+  }
+  prefix_end = MIN2(prefix_end, n_regions);
+
+  size_t* live = NEW_C_HEAP_ARRAY(size_t, n_workers, mtGC);
+
+  // Every worker gets a same-sized part of the dense prefix.
+  size_t prefix_idx = 0;
+  for (uint wid = 0; wid < n_workers; wid++) {
+    ShenandoahHeapRegionSet* slice = worker_slices[wid];
+
+    live[wid] = 0;
+    size_t regs = 0;
+    while (prefix_idx < prefix_end && regs < prefix_regions_per_worker) {
+      ShenandoahHeapRegion* r = heap->get_region(prefix_idx);
+      if (ShenandoahPrepareForCompactionTask::is_candidate_region(r)) {
+        slice->add_region(r);
+        live[wid] += r->get_live_data_words();
+        regs++;
+      }
+      prefix_idx++;
+    }
+  }
+
+  // Hand out the tail round-robin to the workers that still need live data.
+  uint wid = n_workers - 1;
+  for (size_t tail_idx = prefix_end; tail_idx < n_regions; tail_idx++) {
+    ShenandoahHeapRegion* r = heap->get_region(tail_idx);
+    if (ShenandoahPrepareForCompactionTask::is_candidate_region(r)) {
+      size_t live_region = r->get_live_data_words();
+
+      uint old_wid = wid;
+      do {
+        wid++;
+        if (wid == n_workers) wid = 0;
+      } while (live[wid] + live_region >= live_per_worker && old_wid != wid);
+
+      if (old_wid == wid) {
+        // Circled back to the same worker: everyone has its share already.
+        // Bump the limit so that the leftover work is spread out as well.
+        live_per_worker += ShenandoahHeapRegion::region_size_words();
+      }
+
+      worker_slices[wid]->add_region(r);
+      live[wid] += live_region;
+    }
+  }
+
+  LogTarget(Debug, gc, phases) lt;
+  if (lt.is_enabled()) {
+    LogStream ls(lt);
+    size_t min_live = SIZE_MAX;
+    size_t max_live = 0;
+    for (uint w = 0; w < n_workers; w++) {
+      min_live = MIN2(min_live, live[w]);
+      max_live = MAX2(max_live, live[w]);
+      ls.print_cr("Worker %u slice: " SIZE_FORMAT " regions, " SIZE_FORMAT "%s live",
+                  w, worker_slices[w]->count(),
+                  byte_size_in_proper_unit(live[w] * HeapWordSize),
+                  proper_unit_for_byte_size(live[w] * HeapWordSize));
+    }
+    ls.print_cr("Slice live data: " SIZE_FORMAT "%s total, min " SIZE_FORMAT "%s, max " SIZE_FORMAT "%s",
+                byte_size_in_proper_unit(total_live * HeapWordSize), proper_unit_for_byte_size(total_live * HeapWordSize),
+                byte_size_in_proper_unit(min_live * HeapWordSize),   proper_unit_for_byte_size(min_live * HeapWordSize),
+                byte_size_in_proper_unit(max_live * HeapWordSize),   proper_unit_for_byte_size(max_live * HeapWordSize));
+  }
+
+  FREE_C_HEAP_ARRAY(size_t, live);
+
+#ifdef ASSERT
+  ResourceMark rm;
+  ResourceBitMap map(n_regions);
+  for (uint w = 0; w < n_workers; w++) {
+    ShenandoahHeapRegionSetIterator it(worker_slices[w]);
+    ShenandoahHeapRegion* r = it.next();
+    while (r != NULL) {
+      size_t idx = r->region_number();
+      assert(ShenandoahPrepareForCompactionTask::is_candidate_region(r), "Sanity: " SIZE_FORMAT, idx);
+      assert(!map.at(idx), "No region distributed twice: " SIZE_FORMAT, idx);
+      map.at_put(idx, true);
+      r = it.next();
+    }
+  }
+
+  for (size_t idx = 0; idx < n_regions; idx++) {
+    ShenandoahHeapRegion* r = heap->get_region(idx);
+    if (ShenandoahPrepareForCompactionTask::is_candidate_region(r)) {
+      assert(map.at(idx), "All candidates are selected: " SIZE_FORMAT, idx);
+    }
+  }
+#endif
+}
+
 void ShenandoahMarkCompact::phase2_calculate_target_addresses(ShenandoahHeapRegionSet** worker_slices) {
   GCTraceTime(Info, gc, phases) time("Phase 2: Compute new object addresses", _gc_timer);
   ShenandoahGCPhase calculate_address_phase(ShenandoahPhaseTimings::full_gc_calculate_addresses);
@@ -510,6 +640,12 @@ void ShenandoahMarkCompact::phase2_calculate_target_addresses(ShenandoahHeapRegi
   // Compute the new addresses for regular objects
   {
     ShenandoahGCPhase phase(ShenandoahPhaseTimings::full_gc_calculate_addresses_regular);
+
+    {
+      ShenandoahGCPhase distribute_phase(ShenandoahPhaseTimings::full_gc_calculate_addresses_distribute);
+      distribute_slices(worker_slices);
+    }
+
     ShenandoahPrepareForCompactionTask prepare_task(_preserved_marks, worker_slices);
     heap->workers()->run_task(&prepare_task);
   }
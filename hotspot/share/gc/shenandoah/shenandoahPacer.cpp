@@ -26,6 +26,8 @@
 #include "gc/shenandoah/shenandoahFreeSet.hpp"
 #include "gc/shenandoah/shenandoahHeap.inline.hpp"
 #include "gc/shenandoah/shenandoahPacer.hpp"
+#include "gc/shenandoah/shenandoahThreadLocalData.hpp"
+#include "jfr/jfrEvents.hpp"
 
 /*
  * In normal concurrent cycle, we have to pace the application to let GC finish.
@@ -225,11 +227,27 @@ void ShenandoahPacer::pace_for_alloc(size_t words) {
     return;
   }
 
+  Thread* const thread = Thread::current();
+  const intptr_t cur_epoch = epoch();
+
   size_t max = ShenandoahPacingMaxDelay;
+  if (ShenandoahPacingMaxThreadDelay > 0) {
+    // Bound the total delay of a single thread within this phase, so that
+    // a thread that allocates a lot is not stalled over and over again.
+    const size_t paced = ShenandoahThreadLocalData::paced_time(thread, cur_epoch);
+    if (paced >= ShenandoahPacingMaxThreadDelay) {
+      claim_for_alloc(words, true);
+      return;
+    }
+    max = MIN2(max, ShenandoahPacingMaxThreadDelay - paced);
+  }
+
+  EventShenandoahPacingDelay event;
   double start = os::elapsedTime();
 
   size_t total = 0;
   size_t cur = 0;
+  bool forced = false;
 
   while (true) {
     // We could instead assist GC, but this would suffice for now.
@@ -242,7 +260,7 @@ void ShenandoahPacer::pace_for_alloc(size_t words) {
     }
     cur = MAX2<size_t>(1, cur);
 
-    os::sleep(Thread::current(), cur, true);
+    os::sleep(thread, cur, true);
 
     double end = os::elapsedTime();
     total = (size_t)((end - start) * 1000);
@@ -256,6 +274,7 @@ void ShenandoahPacer::pace_for_alloc(size_t words) {
       // Forcefully claim the budget: it may go negative at this point, and
       // GC should replenish for this and subsequent allocations
       claim_for_alloc(words, true);
+      forced = true;
       break;
     }
 
@@ -265,6 +284,16 @@ void ShenandoahPacer::pace_for_alloc(size_t words) {
       break;
     }
   }
+
+  if (ShenandoahPacingMaxThreadDelay > 0) {
+    ShenandoahThreadLocalData::add_paced_time(thread, cur_epoch, total);
+  }
+
+  if (event.should_commit()) {
+    event.set_allocationSize(words * HeapWordSize);
+    event.set_forced(forced);
+    event.commit();
+  }
 }
 
 void ShenandoahPacer::print_on(outputStream* out) const {
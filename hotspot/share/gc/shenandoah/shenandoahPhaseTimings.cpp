@@ -23,6 +23,7 @@
 
 #include "precompiled.hpp"
 
+#include "gc/shared/gcTrace.hpp"
 #include "gc/shared/workerDataArray.inline.hpp"
 #include "gc/shenandoah/shenandoahCollectorPolicy.hpp"
 #include "gc/shenandoah/shenandoahPhaseTimings.hpp"
@@ -97,6 +98,7 @@ void ShenandoahPhaseTimings::record_workers_end(Phase phase) {
     for (uint i = 0; i < GCParPhasesSentinel; i++) {
       double t = _worker_times->average(i);
       _timing_data[phase + i + 1]._secs.add(t);
+      _worker_times->report_summary(i, _phase_names[phase + i + 1], ShenandoahHeap::heap()->tracer());
     }
   }
 }
@@ -163,6 +165,10 @@ void ShenandoahWorkerTimings::print() const {
   }
 }
 
+void ShenandoahWorkerTimings::report_summary(uint i, const char* name, GCTracer* tracer) const {
+  tracer->report_gc_phase_parallel_summary(name, _gc_par_phases[i]);
+}
+
 
 ShenandoahTerminationTimings::ShenandoahTerminationTimings(uint max_gc_threads) {
   _gc_termination_phase = new WorkerDataArray<double>(max_gc_threads, "Task Termination (ms):");
@@ -181,6 +187,10 @@ void ShenandoahTerminationTimings::print() const {
   _gc_termination_phase->print_summary_on(tty);
 }
 
+void ShenandoahTerminationTimings::report_summary(const char* name, GCTracer* tracer) const {
+  tracer->report_gc_phase_parallel_summary(name, _gc_termination_phase);
+}
+
 double ShenandoahTerminationTimings::average() const {
   return _gc_termination_phase->average();
 }
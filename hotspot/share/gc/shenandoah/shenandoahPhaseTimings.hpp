@@ -31,6 +31,7 @@
 class ShenandoahCollectorPolicy;
 class ShenandoahWorkerTimings;
 class ShenandoahTerminationTimings;
+class GCTracer;
 class outputStream;
 
 #define SHENANDOAH_GC_PHASE_DO(f)                                                       \
@@ -292,6 +293,7 @@ class outputStream;
   f(full_gc_purge_cldg,                              "    CLDG")                        \
   f(full_gc_calculate_addresses,                     "  Calculate Addresses")           \
   f(full_gc_calculate_addresses_regular,             "    Regular Objects")             \
+  f(full_gc_calculate_addresses_distribute,          "      Distribute Slices")         \
   f(full_gc_calculate_addresses_humong,              "    Humongous Objects")           \
   f(full_gc_adjust_pointers,                         "  Adjust Pointers")               \
   f(full_gc_copy_objects,                            "  Copy Objects")                  \
@@ -416,6 +418,7 @@ public:
   double average(uint i) const;
   void reset(uint i);
   void print() const;
+  void report_summary(uint i, const char* name, GCTracer* tracer) const;
 };
 
 class ShenandoahTerminationTimings : public CHeapObj<mtGC> {
@@ -431,6 +434,7 @@ public:
   void reset();
 
   void print() const;
+  void report_summary(const char* name, GCTracer* tracer) const;
 };
 
 #endif // SHARE_GC_SHENANDOAH_SHENANDOAHPHASETIMINGS_HPP
@@ -43,6 +43,8 @@ private:
   size_t _gclab_size;
   uint  _worker_id;
   bool _force_satb_flush;
+  intptr_t _paced_epoch;
+  size_t _paced_time;
 
   ShenandoahThreadLocalData() :
     _gc_state(0),
@@ -51,7 +53,9 @@ private:
     _gclab(NULL),
     _gclab_size(0),
     _worker_id(INVALID_WORKER_ID),
-    _force_satb_flush(false) {
+    _force_satb_flush(false),
+    _paced_epoch(0),
+    _paced_time(0) {
   }
 
   ~ShenandoahThreadLocalData() {
@@ -120,6 +124,20 @@ public:
     return data(thread)->_force_satb_flush;
   }
 
+  // Time in milliseconds the thread has been paced in the given pacing epoch
+  static size_t paced_time(Thread* thread, intptr_t epoch) {
+    return data(thread)->_paced_epoch == epoch ? data(thread)->_paced_time : 0;
+  }
+
+  static void add_paced_time(Thread* thread, intptr_t epoch, size_t time) {
+    ShenandoahThreadLocalData* const tld = data(thread);
+    if (tld->_paced_epoch != epoch) {
+      tld->_paced_epoch = epoch;
+      tld->_paced_time = 0;
+    }
+    tld->_paced_time += time;
+  }
+
   static void initialize_gclab(Thread* thread) {
     assert (thread->is_Java_thread() || thread->is_Worker_thread(), "Only Java and GC worker threads are allowed to get GCLABs");
     assert(data(thread)->_gclab == NULL, "Only initialize once");
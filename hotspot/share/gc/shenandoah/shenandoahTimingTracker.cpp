@@ -91,5 +91,6 @@ ShenandoahTerminationTracker::~ShenandoahTerminationTracker() {
 
   double t = phase_times->termination_times()->average();
   phase_times->record_phase_time(_phase, t);
+  phase_times->termination_times()->report_summary(ShenandoahPhaseTimings::phase_name(_phase), ShenandoahHeap::heap()->tracer());
   debug_only(_current_termination_phase = ShenandoahPhaseTimings::_num_phases;)
 }
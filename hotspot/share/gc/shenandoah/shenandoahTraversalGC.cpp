@@ -307,6 +307,8 @@ ShenandoahTraversalGC::ShenandoahTraversalGC(ShenandoahHeap* heap, size_t num_re
   // Traversal does not support concurrent code root scanning
   FLAG_SET_DEFAULT(ShenandoahConcurrentScanCodeRoots, false);
 
+  _task_queues->set_steal_batch((uint) WorkStealingBatchSize);
+
   uint num_queues = heap->max_workers();
   for (uint i = 0; i < num_queues; ++i) {
     ShenandoahObjToScanQueue* task_queue = new ShenandoahObjToScanQueue();
@@ -92,6 +92,18 @@
           "heuristics.")                                                    \
           range(0,100)                                                      \
                                                                             \
+  experimental(uintx, ShenandoahOldRegionAge, 0,                            \
+          "Number of GC cycles a region must go without allocations to "    \
+          "be considered old. Old regions are only considered for the "     \
+          "collection set every ShenandoahOldRegionCollectionInterval "     \
+          "cycles. 0 means regions never become old. Does not apply to "    \
+          "all heuristics.")                                                \
+                                                                            \
+  experimental(uintx, ShenandoahOldRegionCollectionInterval, 4,             \
+          "Consider old regions for the collection set every this many "    \
+          "GC cycles.")                                                     \
+          range(1, max_uintx)                                               \
+                                                                            \
   experimental(uintx, ShenandoahFreeThreshold, 10,                          \
           "Set the percentage of free heap at which a GC cycle is started. "\
           "Does not apply to all heuristics.")                              \
@@ -255,6 +267,12 @@
           "Max delay for pacing application allocations. "                  \
           "Time is in milliseconds.")                                       \
                                                                             \
+  experimental(uintx, ShenandoahPacingMaxThreadDelay, 0,                    \
+          "Max total delay for pacing the allocations of a single thread "  \
+          "during one GC phase. After that, the thread allocates without "  \
+          "pacing until the next phase. Use zero to disable. "              \
+          "Time is in milliseconds.")                                       \
+                                                                            \
   experimental(uintx, ShenandoahPacingIdleSlack, 2,                         \
           "Percent of heap counted as non-taxable allocations during idle. "\
           "Larger value makes the pacing milder during idle phases, "       \
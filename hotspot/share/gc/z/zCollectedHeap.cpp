@@ -30,6 +30,7 @@
 #include "gc/z/zNMethod.hpp"
 #include "gc/z/zServiceability.hpp"
 #include "gc/z/zStat.hpp"
+#include "gc/z/zStringDedup.hpp"
 #include "gc/z/zUtils.inline.hpp"
 #include "memory/universe.hpp"
 #include "runtime/mutexLocker.hpp"
@@ -68,6 +69,9 @@ jint ZCollectedHeap::initialize() {
   initialize_reserved_region((HeapWord*)ZAddressReservedStart,
                              (HeapWord*)ZAddressReservedEnd);
 
+  // Initialize string deduplication
+  ZStringDedup::initialize();
+
   return JNI_OK;
 }
 
@@ -80,6 +84,9 @@ void ZCollectedHeap::stop() {
   _driver->stop();
   _uncommitter->stop();
   _stat->stop();
+  if (ZStringDedup::is_enabled()) {
+    ZStringDedup::stop();
+  }
 }
 
 SoftRefPolicy* ZCollectedHeap::soft_ref_policy() {
@@ -278,6 +285,9 @@ void ZCollectedHeap::gc_threads_do(ThreadClosure* tc) const {
   tc->do_thread(_stat);
   _heap.worker_threads_do(tc);
   _runtime_workers.threads_do(tc);
+  if (ZStringDedup::is_enabled()) {
+    ZStringDedup::threads_do(tc);
+  }
 }
 
 VirtualSpaceSummary ZCollectedHeap::create_heap_space_summary() {
@@ -340,6 +350,9 @@ void ZCollectedHeap::print_gc_threads_on(outputStream* st) const {
   st->cr();
   _heap.print_worker_threads_on(st);
   _runtime_workers.print_threads_on(st);
+  if (ZStringDedup::is_enabled()) {
+    ZStringDedup::print_worker_threads_on(st);
+  }
 }
 
 void ZCollectedHeap::print_tracing_info() const {
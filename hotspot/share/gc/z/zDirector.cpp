@@ -29,6 +29,8 @@
 #include "gc/z/zUtils.hpp"
 #include "logging/log.hpp"
 
+static const ZStatSampler ZSamplerPredictedAllocationRate("Memory", "Predicted Allocation Rate", ZStatUnitBytesPerSecond);
+
 const double ZDirector::one_in_1000 = 3.290527;
 
 ZDirector::ZDirector() :
@@ -92,6 +94,30 @@ bool ZDirector::rule_warmup() const {
   return used >= used_threshold;
 }
 
+double ZDirector::predicted_time_until_oom(size_t free, double alloc_rate) const {
+  // Assume that the allocation rate keeps changing at the pace observed
+  // between the short and the long term average. The amount of memory
+  // allocated after t seconds is then alloc_rate * t + trend * t^2 / 2,
+  // and we solve for the t where it reaches the amount of free memory.
+  // A falling allocation rate is not assumed to keep falling, so only a
+  // rising trend is taken into account.
+  const double trend = ZStatAllocRate::trend() * ZAllocationSpikeTolerance;
+  double time_until_oom;
+  if (trend > 0.0) {
+    time_until_oom = (sqrt(alloc_rate * alloc_rate + 2.0 * trend * free) - alloc_rate) / trend;
+  } else {
+    time_until_oom = free / (alloc_rate + 1.0); // Plus 1.0B/s to avoid division by zero
+  }
+
+  const double predicted_alloc_rate = alloc_rate + MAX2(trend, 0.0) * time_until_oom;
+  ZStatSample(ZSamplerPredictedAllocationRate, (uint64_t)predicted_alloc_rate);
+
+  log_debug(gc, director)("Predicted Allocation Rate, Trend: %.3lfMB/s^2, PredictedAllocRate: %.3lfMB/s, TimeUntilOOM: %.3lfs",
+                          trend / M, predicted_alloc_rate / M, time_until_oom);
+
+  return time_until_oom;
+}
+
 bool ZDirector::rule_allocation_rate() const {
   if (is_first()) {
     // Rule disabled
@@ -120,7 +146,9 @@ bool ZDirector::rule_allocation_rate() const {
   // the allocation rate variance, which means the probability is 1 in 1000
   // that a sample is outside of the confidence interval.
   const double max_alloc_rate = (ZStatAllocRate::avg() * ZAllocationSpikeTolerance) + (ZStatAllocRate::avg_sd() * one_in_1000);
-  const double time_until_oom = free / (max_alloc_rate + 1.0); // Plus 1.0B/s to avoid division by zero
+  const double time_until_oom = ZAllocationRatePrediction ?
+                                predicted_time_until_oom(free, max_alloc_rate) :
+                                free / (max_alloc_rate + 1.0); // Plus 1.0B/s to avoid division by zero
 
   // Calculate max duration of a GC cycle. The duration of GC is a moving
   // average, we add ~3.3 sigma to account for the GC duration variance.
@@ -30,8 +30,6 @@
 
 class ZDirector : public ConcurrentGCThread {
 private:
-  static const double one_in_1000;
-
   ZMetronome _metronome;
 
   void sample_allocation_rate() const;
@@ -41,6 +39,7 @@ private:
 
   bool rule_timer() const;
   bool rule_warmup() const;
+  double predicted_time_until_oom(size_t free, double alloc_rate) const;
   bool rule_allocation_rate() const;
   bool rule_proactive() const;
   bool rule_high_usage() const;
@@ -51,6 +50,8 @@ protected:
   virtual void stop_service();
 
 public:
+  static const double one_in_1000;
+
   ZDirector();
 };
 
@@ -44,6 +44,9 @@ public:
   ZGranuleMap();
   ~ZGranuleMap();
 
+  size_t size() const;
+  T at(size_t index) const;
+
   T get(uintptr_t addr) const;
   void put(uintptr_t addr, T value);
   void put(uintptr_t addr, size_t size, T value);
@@ -49,6 +49,17 @@ inline size_t ZGranuleMap<T>::index_for_addr(uintptr_t addr) const {
   return index;
 }
 
+template <typename T>
+inline size_t ZGranuleMap<T>::size() const {
+  return _size;
+}
+
+template <typename T>
+inline T ZGranuleMap<T>::at(size_t index) const {
+  assert(index < _size, "Invalid index");
+  return _map[index];
+}
+
 template <typename T>
 inline T ZGranuleMap<T>::get(uintptr_t addr) const {
   const size_t index = index_for_addr(addr);
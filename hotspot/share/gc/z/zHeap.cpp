@@ -25,6 +25,7 @@
 #include "gc/shared/gcArguments.hpp"
 #include "gc/shared/oopStorage.hpp"
 #include "gc/z/zAddress.hpp"
+#include "gc/z/zArray.inline.hpp"
 #include "gc/z/zGlobals.hpp"
 #include "gc/z/zHeap.inline.hpp"
 #include "gc/z/zHeapIterator.hpp"
@@ -386,31 +387,89 @@ void ZHeap::process_non_strong_references() {
   _reference_processor.enqueue_references();
 }
 
-void ZHeap::select_relocation_set() {
-  // Do not allow pages to be deleted
-  _page_allocator.enable_deferred_delete();
+class ZSelectRelocationSetClosure : public ZPageClosure {
+private:
+  ZArray<ZPage*> _live_pages;
+  ZArray<ZPage*> _garbage_pages;
 
-  // Register relocatable pages with selector
-  ZRelocationSetSelector selector;
-  ZPageTableIterator pt_iter(&_page_table);
-  for (ZPage* page; pt_iter.next(&page);) {
+public:
+  ZSelectRelocationSetClosure() :
+      _live_pages(),
+      _garbage_pages() {}
+
+  virtual void do_page(ZPage* page) {
     if (!page->is_relocatable()) {
       // Not relocatable, don't register
-      continue;
+      return;
     }
 
     if (page->is_marked()) {
-      // Register live page
-      selector.register_live_page(page);
+      _live_pages.add(page);
     } else {
-      // Register garbage page
-      selector.register_garbage_page(page);
+      _garbage_pages.add(page);
+    }
+  }
+
+  void register_pages(ZRelocationSetSelector* selector) {
+    ZArrayIterator<ZPage*> iter_live(&_live_pages);
+    for (ZPage* page; iter_live.next(&page);) {
+      selector->register_live_page(page);
+    }
 
-      // Reclaim page immediately
-      free_page(page, true /* reclaimed */);
+    ZArrayIterator<ZPage*> iter_garbage(&_garbage_pages);
+    for (ZPage* page; iter_garbage.next(&page);) {
+      selector->register_garbage_page(page);
     }
   }
 
+  void free_garbage_pages() {
+    // Reclaim garbage pages immediately
+    ZArrayIterator<ZPage*> iter(&_garbage_pages);
+    for (ZPage* page; iter.next(&page);) {
+      ZHeap::heap()->free_page(page, true /* reclaimed */);
+    }
+  }
+};
+
+class ZSelectRelocationSetTask : public ZTask {
+private:
+  ZPageTableParallelIterator    _iter;
+  ZRelocationSetSelector* const _selector;
+  ZLock                         _lock;
+
+public:
+  ZSelectRelocationSetTask(const ZPageTable* page_table, ZRelocationSetSelector* selector) :
+      ZTask("ZSelectRelocationSetTask"),
+      _iter(page_table),
+      _selector(selector),
+      _lock() {}
+
+  virtual void work() {
+    // Scan the page table without any synchronization, and only
+    // then register the pages found with the shared selector
+    ZSelectRelocationSetClosure cl;
+    _iter.pages_do(&cl);
+
+    {
+      ZLocker<ZLock> locker(&_lock);
+      cl.register_pages(_selector);
+    }
+
+    cl.free_garbage_pages();
+  }
+};
+
+void ZHeap::select_relocation_set() {
+  // Do not allow pages to be deleted
+  _page_allocator.enable_deferred_delete();
+
+  // Register relocatable pages with selector
+  ZRelocationSetSelector selector;
+  {
+    ZSelectRelocationSetTask task(&_page_table, &selector);
+    _workers.run_concurrent(&task);
+  }
+
   // Allow pages to be deleted
   _page_allocator.disable_deferred_delete();
 
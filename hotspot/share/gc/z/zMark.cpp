@@ -33,6 +33,7 @@
 #include "gc/z/zPageTable.inline.hpp"
 #include "gc/z/zRootsIterator.hpp"
 #include "gc/z/zStat.hpp"
+#include "gc/z/zStringDedup.hpp"
 #include "gc/z/zTask.hpp"
 #include "gc/z/zThread.hpp"
 #include "gc/z/zThreadLocalAllocBuffer.hpp"
@@ -350,7 +351,13 @@ void ZMark::mark_and_follow(ZMarkCache* cache, ZMarkStackEntry entry) {
   if (is_array(addr)) {
     follow_array_object(objArrayOop(ZOop::from_address(addr)), finalizable);
   } else {
-    follow_object(ZOop::from_address(addr), finalizable);
+    const oop obj = ZOop::from_address(addr);
+    follow_object(obj, finalizable);
+
+    // Only strongly reachable Strings are deduplication candidates
+    if (!finalizable && ZStringDedup::is_enabled()) {
+      ZStringDedup::enqueue_candidate(obj);
+    }
   }
 }
 
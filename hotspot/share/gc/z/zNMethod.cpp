@@ -33,6 +33,7 @@
 #include "gc/z/zNMethodData.hpp"
 #include "gc/z/zNMethodTable.hpp"
 #include "gc/z/zOopClosures.inline.hpp"
+#include "gc/z/zStat.hpp"
 #include "gc/z/zTask.hpp"
 #include "gc/z/zWorkers.hpp"
 #include "logging/log.hpp"
@@ -44,6 +45,10 @@
 #include "runtime/orderAccess.hpp"
 #include "utilities/debug.hpp"
 
+static const ZStatCounter ZCounterNMethodsUnlinked("Unloading", "NMethods Unlinked", ZStatUnitOpsPerSecond);
+static const ZStatCounter ZCounterNMethodsCleaned("Unloading", "NMethods Cleaned", ZStatUnitOpsPerSecond);
+static const ZStatCounter ZCounterNMethodsPurged("Unloading", "NMethods Purged", ZStatUnitOpsPerSecond);
+
 static ZNMethodData* gc_data(const nmethod* nm) {
   return nm->gc_data<ZNMethodData>();
 }
@@ -297,6 +302,7 @@ public:
 
     if (nm->is_unloading()) {
       unlink(nm);
+      ZStatInc(ZCounterNMethodsUnlinked);
       return;
     }
 
@@ -309,6 +315,8 @@ public:
     if (!nm->unload_nmethod_caches(_unloading_occurred)) {
       set_failed();
     }
+
+    ZStatInc(ZCounterNMethodsCleaned);
   }
 
   bool failed() const {
@@ -368,6 +376,7 @@ public:
   virtual void do_nmethod(nmethod* nm) {
     if (nm->is_alive() && nm->is_unloading()) {
       nm->make_unloaded();
+      ZStatInc(ZCounterNMethodsPurged);
     }
   }
 };
@@ -55,9 +55,11 @@ void ZNMethodTableIteration::nmethods_do_end() {
 
 void ZNMethodTableIteration::nmethods_do(NMethodClosure* cl) {
   for (;;) {
-    // Claim table partition. Each partition is currently sized to span
-    // two cache lines. This number is just a guess, but seems to work well.
-    const size_t partition_size = (ZCacheLineSize * 2) / sizeof(ZNMethodTableEntry);
+    // Claim table partition. Each partition is sized to span a single
+    // cache line. Processing an nmethod during unlinking can be expensive
+    // (cleaning of inline caches and exception caches), so small partitions
+    // are needed to keep the workers evenly loaded.
+    const size_t partition_size = ZCacheLineSize / sizeof(ZNMethodTableEntry);
     const size_t partition_start = MIN2(Atomic::add(partition_size, &_claimed) - partition_size, _size);
     const size_t partition_end = MIN2(partition_start + partition_size, _size);
     if (partition_start == partition_end) {
@@ -76,6 +76,9 @@ public:
   bool is_allocating() const;
   bool is_relocatable() const;
 
+  // Number of GC cycles this page has survived without being relocated
+  uint32_t age() const;
+
   bool is_mapped() const;
   void set_pre_mapped();
 
@@ -153,6 +153,11 @@ inline bool ZPage::is_relocatable() const {
   return _seqnum < ZGlobalSeqNum;
 }
 
+inline uint32_t ZPage::age() const {
+  assert(is_relocatable(), "Invalid page state");
+  return ZGlobalSeqNum - _seqnum;
+}
+
 inline bool ZPage::is_mapped() const {
   return _seqnum > 0;
 }
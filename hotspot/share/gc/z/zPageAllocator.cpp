@@ -25,6 +25,7 @@
 #include "gc/shared/suspendibleThreadSet.hpp"
 #include "gc/z/zAddress.inline.hpp"
 #include "gc/z/zCollectedHeap.hpp"
+#include "gc/z/zDirector.hpp"
 #include "gc/z/zFuture.inline.hpp"
 #include "gc/z/zGlobals.hpp"
 #include "gc/z/zLock.inline.hpp"
@@ -617,6 +618,24 @@ public:
   }
 };
 
+size_t ZPageAllocator::uncommit_headroom() const {
+  // Memory is only reclaimed by a GC cycle, so capacity that is expected
+  // to be allocated during the next GC cycle, or before the next uncommit
+  // attempt, would just have to be committed again. The forecast uses the
+  // same max allocation rate and GC duration estimates as the director,
+  // and a rising allocation rate is extrapolated to guard against an
+  // upcoming allocation burst.
+  const double max_alloc_rate = (ZStatAllocRate::avg() * ZAllocationSpikeTolerance) +
+                                (ZStatAllocRate::avg_sd() * ZDirector::one_in_1000);
+  const double trend = MAX2(ZStatAllocRate::trend(), 0.0);
+  const AbsSeq& duration_of_gc = ZStatCycle::normalized_duration();
+  const double max_duration_of_gc = duration_of_gc.davg() + (duration_of_gc.dsd() * ZDirector::one_in_1000);
+  const double horizon = max_duration_of_gc + 1.0; // Plus the minimum uncommit interval
+  const double forecast = (max_alloc_rate * horizon) + (trend * horizon * horizon / 2.0);
+
+  return (size_t)MIN2(forecast, (double)_current_max_capacity);
+}
+
 uint64_t ZPageAllocator::uncommit(uint64_t delay) {
   // Set the default timeout, when no pages are found in the
   // cache or when uncommit is disabled, equal to the delay.
@@ -627,6 +646,11 @@ uint64_t ZPageAllocator::uncommit(uint64_t delay) {
     return timeout;
   }
 
+  // Keep the capacity the allocation forecast says will soon be needed
+  const size_t headroom = uncommit_headroom();
+
+  log_trace(gc, heap)("Uncommit Headroom: " SIZE_FORMAT "M", headroom / M);
+
   size_t capacity_before;
   size_t capacity_after;
   size_t uncommitted;
@@ -635,11 +659,12 @@ uint64_t ZPageAllocator::uncommit(uint64_t delay) {
     SuspendibleThreadSetJoiner joiner;
     ZLocker<ZLock> locker(&_lock);
 
-    // Don't flush more than we will uncommit. Never uncommit
-    // the reserve, and never uncommit below min capacity.
-    const size_t needed = MIN2(_used + _max_reserve, _current_max_capacity);
+    // Don't flush more than we will uncommit. Never uncommit the
+    // reserve or the forecasted headroom, and never uncommit below
+    // min capacity.
+    const size_t needed = MIN2(_used + _max_reserve + headroom, _current_max_capacity);
     const size_t guarded = MAX2(needed, _min_capacity);
-    const size_t uncommittable = _capacity - guarded;
+    const size_t uncommittable = _capacity - MIN2(_capacity, guarded);
     const size_t uncached_available = _capacity - _used - _cache.available();
     size_t uncommit = MIN2(uncommittable, uncached_available);
     const size_t flush = uncommittable - uncommit;
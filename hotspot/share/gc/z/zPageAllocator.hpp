@@ -84,6 +84,8 @@ private:
 
   void satisfy_alloc_queue();
 
+  size_t uncommit_headroom() const;
+
 public:
   ZPageAllocator(size_t min_capacity,
                  size_t initial_capacity,
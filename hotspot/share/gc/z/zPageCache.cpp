@@ -48,14 +48,16 @@ ZPageCache::ZPageCache() :
     _medium(),
     _large() {}
 
-ZPage* ZPageCache::alloc_small_page() {
+ZPage* ZPageCache::alloc_numa_page(ZPerNUMA<ZList<ZPage> >* lists, bool count_hits) {
   const uint32_t numa_id = ZNUMA::id();
   const uint32_t numa_count = ZNUMA::count();
 
   // Try NUMA local page cache
-  ZPage* const l1_page = _small.get(numa_id).remove_first();
+  ZPage* const l1_page = lists->get(numa_id).remove_first();
   if (l1_page != NULL) {
-    ZStatInc(ZCounterPageCacheHitL1);
+    if (count_hits) {
+      ZStatInc(ZCounterPageCacheHitL1);
+    }
     return l1_page;
   }
 
@@ -67,9 +69,11 @@ ZPage* ZPageCache::alloc_small_page() {
       remote_numa_id = 0;
     }
 
-    ZPage* const l2_page = _small.get(remote_numa_id).remove_first();
+    ZPage* const l2_page = lists->get(remote_numa_id).remove_first();
     if (l2_page != NULL) {
-      ZStatInc(ZCounterPageCacheHitL2);
+      if (count_hits) {
+        ZStatInc(ZCounterPageCacheHitL2);
+      }
       return l2_page;
     }
 
@@ -79,14 +83,12 @@ ZPage* ZPageCache::alloc_small_page() {
   return NULL;
 }
 
-ZPage* ZPageCache::alloc_medium_page() {
-  ZPage* const page = _medium.remove_first();
-  if (page != NULL) {
-    ZStatInc(ZCounterPageCacheHitL1);
-    return page;
-  }
+ZPage* ZPageCache::alloc_small_page() {
+  return alloc_numa_page(&_small, true /* count_hits */);
+}
 
-  return NULL;
+ZPage* ZPageCache::alloc_medium_page() {
+  return alloc_numa_page(&_medium, true /* count_hits */);
 }
 
 ZPage* ZPageCache::alloc_large_page(size_t size) {
@@ -106,30 +108,40 @@ ZPage* ZPageCache::alloc_large_page(size_t size) {
 
 ZPage* ZPageCache::alloc_oversized_medium_page(size_t size) {
   if (size <= ZPageSizeMedium) {
-    return _medium.remove_first();
+    return alloc_numa_page(&_medium, false /* count_hits */);
   }
 
   return NULL;
 }
 
 ZPage* ZPageCache::alloc_oversized_large_page(size_t size) {
-  // Find a page that is large enough
+  // Find the smallest page that is large enough. Splitting the best
+  // fitting page keeps larger pages intact for later large allocations,
+  // which would otherwise have to be satisfied by new, unmapped memory.
+  ZPage* best = NULL;
   ZListIterator<ZPage> iter(&_large);
   for (ZPage* page; iter.next(&page);) {
-    if (size <= page->size()) {
-      // Page found
-      _large.remove(page);
-      return page;
+    if (size <= page->size() && (best == NULL || page->size() < best->size())) {
+      best = page;
+      if (size == page->size()) {
+        // Can't do better
+        break;
+      }
     }
   }
 
-  return NULL;
+  if (best != NULL) {
+    _large.remove(best);
+  }
+
+  return best;
 }
 
 ZPage* ZPageCache::alloc_oversized_page(size_t size) {
-  ZPage* page = alloc_oversized_large_page(size);
+  // Prefer splitting a medium page over a large page
+  ZPage* page = alloc_oversized_medium_page(size);
   if (page == NULL) {
-    page = alloc_oversized_medium_page(size);
+    page = alloc_oversized_large_page(size);
   }
 
   if (page != NULL) {
@@ -182,7 +194,7 @@ void ZPageCache::free_page_inner(ZPage* page) {
   if (type == ZPageTypeSmall) {
     _small.get(page->numa_id()).insert_first(page);
   } else if (type == ZPageTypeMedium) {
-    _medium.insert_first(page);
+    _medium.get(page->numa_id()).insert_first(page);
   } else {
     _large.insert_first(page);
   }
@@ -236,6 +248,6 @@ void ZPageCache::flush_per_numa_lists(ZPageCacheFlushClosure* cl, ZPerNUMA<ZList
 void ZPageCache::flush(ZPageCacheFlushClosure* cl, ZList<ZPage>* to) {
   // Prefer flushing large, then medium and last small pages
   flush_list(cl, &_large, to);
-  flush_list(cl, &_medium, to);
+  flush_per_numa_lists(cl, &_medium, to);
   flush_per_numa_lists(cl, &_small, to);
 }
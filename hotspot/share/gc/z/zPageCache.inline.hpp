@@ -34,8 +34,8 @@ inline size_t ZPageCache::available() const {
 template <typename Closure>
 inline void ZPageCache::pages_do(Closure* cl) const {
   // Small
-  ZPerNUMAConstIterator<ZList<ZPage> > iter_numa(&_small);
-  for (const ZList<ZPage>* list; iter_numa.next(&list);) {
+  ZPerNUMAConstIterator<ZList<ZPage> > iter_numa_small(&_small);
+  for (const ZList<ZPage>* list; iter_numa_small.next(&list);) {
     ZListIterator<ZPage> iter_small(list);
     for (ZPage* page; iter_small.next(&page);) {
       cl->do_page(page);
@@ -43,9 +43,12 @@ inline void ZPageCache::pages_do(Closure* cl) const {
   }
 
   // Medium
-  ZListIterator<ZPage> iter_medium(&_medium);
-  for (ZPage* page; iter_medium.next(&page);) {
-    cl->do_page(page);
+  ZPerNUMAConstIterator<ZList<ZPage> > iter_numa_medium(&_medium);
+  for (const ZList<ZPage>* list; iter_numa_medium.next(&list);) {
+    ZListIterator<ZPage> iter_medium(list);
+    for (ZPage* page; iter_medium.next(&page);) {
+      cl->do_page(page);
+    }
   }
 
   // Large
@@ -26,6 +26,7 @@
 #include "gc/z/zGranuleMap.inline.hpp"
 #include "gc/z/zPage.inline.hpp"
 #include "gc/z/zPageTable.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/orderAccess.hpp"
 #include "utilities/debug.hpp"
 
@@ -51,3 +52,34 @@ void ZPageTable::remove(ZPage* page) {
   assert(get(addr) == page, "Invalid entry");
   _map.put(addr, size, NULL);
 }
+
+ZPageTableParallelIterator::ZPageTableParallelIterator(const ZPageTable* page_table) :
+    _page_table(page_table),
+    _claimed(0) {}
+
+void ZPageTableParallelIterator::pages_do(ZPageClosure* cl) {
+  const ZGranuleMap<ZPage*>* const map = &_page_table->_map;
+  const size_t size = map->size();
+
+  for (;;) {
+    // Claim range of granules. Each range spans 4096 granules, which is
+    // small enough to balance the work also on moderately sized heaps.
+    const size_t range_size = 4096;
+    const size_t range_start = MIN2(Atomic::add(range_size, &_claimed) - range_size, size);
+    const size_t range_end = MIN2(range_start + range_size, size);
+    if (range_start == range_end) {
+      // End of table
+      break;
+    }
+
+    for (size_t index = range_start; index < range_end; index++) {
+      ZPage* const page = map->at(index);
+
+      // A page that spans several granules is visited by the
+      // worker that claimed the range the page starts in.
+      if (page != NULL && (page->start() >> ZGranuleSizeShift) == index) {
+        cl->do_page(page);
+      }
+    }
+  }
+}
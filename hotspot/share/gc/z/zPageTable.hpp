@@ -29,9 +29,15 @@
 
 class ZPage;
 
+class ZPageClosure {
+public:
+  virtual void do_page(ZPage* page) = 0;
+};
+
 class ZPageTable {
   friend class VMStructs;
   friend class ZPageTableIterator;
+  friend class ZPageTableParallelIterator;
 
 private:
   ZGranuleMap<ZPage*> _map;
@@ -56,4 +62,17 @@ public:
   bool next(ZPage** page);
 };
 
+// Shared by a set of workers, each calling pages_do(). The workers claim
+// ranges of granules, so that every page is visited by exactly one worker.
+class ZPageTableParallelIterator : public StackObj {
+private:
+  const ZPageTable* const _page_table;
+  volatile size_t         _claimed;
+
+public:
+  ZPageTableParallelIterator(const ZPageTable* page_table);
+
+  void pages_do(ZPageClosure* cl);
+};
+
 #endif // SHARE_GC_Z_ZPAGETABLE_HPP
@@ -32,6 +32,7 @@
 #include "gc/z/zRelocationSet.inline.hpp"
 #include "gc/z/zRootsIterator.hpp"
 #include "gc/z/zStat.hpp"
+#include "gc/z/zStringDedup.hpp"
 #include "gc/z/zTask.hpp"
 #include "gc/z/zThreadLocalAllocBuffer.hpp"
 #include "gc/z/zWorkers.hpp"
@@ -69,12 +70,28 @@ private:
 public:
   ZRelocateRootsTask() :
       ZTask("ZRelocateRootsTask"),
-      _roots() {}
+      _roots() {
+    if (ZStringDedup::is_enabled()) {
+      ZStringDedup::gc_prologue(false /* resize_and_rehash_table */);
+    }
+  }
+
+  ~ZRelocateRootsTask() {
+    if (ZStringDedup::is_enabled()) {
+      ZStringDedup::gc_epilogue();
+    }
+  }
 
   virtual void work() {
     // During relocation we need to visit the JVMTI
     // export weak roots to rehash the JVMTI tag map
     _roots.oops_do(&_cl, true /* visit_jvmti_weak_export */);
+
+    // The string deduplication thread dereferences queue and table
+    // entries directly, so they must not refer to relocated objects
+    if (ZStringDedup::is_enabled()) {
+      ZStringDedup::oops_do(&_cl);
+    }
   }
 };
 
@@ -23,6 +23,7 @@
 
 #include "precompiled.hpp"
 #include "gc/z/zArray.inline.hpp"
+#include "gc/z/zGlobals.hpp"
 #include "gc/z/zPage.inline.hpp"
 #include "gc/z/zRelocationSet.hpp"
 #include "gc/z/zRelocationSetSelector.hpp"
@@ -169,16 +170,33 @@ size_t ZRelocationSetSelectorGroup::fragmentation() const {
 ZRelocationSetSelector::ZRelocationSetSelector() :
     _small("Small", ZPageSizeSmall, ZObjectSizeLimitSmall),
     _medium("Medium", ZPageSizeMedium, ZObjectSizeLimitMedium),
+    _relocate_old(is_old_relocation_cycle()),
     _live(0),
     _garbage(0),
-    _fragmentation(0) {}
+    _fragmentation(0),
+    _old_skipped(0) {}
+
+bool ZRelocationSetSelector::is_old_relocation_cycle() {
+  return ZPageTenuringThreshold == 0 || (ZGlobalSeqNum % ZOldPageRelocationInterval) == 0;
+}
+
+bool ZRelocationSetSelector::is_old(const ZPage* page) const {
+  return ZPageTenuringThreshold > 0 && page->age() >= ZPageTenuringThreshold;
+}
 
 void ZRelocationSetSelector::register_live_page(ZPage* page) {
   const uint8_t type = page->type();
   const size_t live = page->live_bytes();
   const size_t garbage = page->size() - live;
 
-  if (type == ZPageTypeSmall) {
+  if (!_relocate_old && is_old(page)) {
+    // Most objects die young, so pages that have survived many cycles
+    // are expected to stay mostly live. Leave them in place, except in
+    // every ZOldPageRelocationInterval cycle, to keep relocation work
+    // focused on the pages where it reclaims the most memory.
+    _fragmentation += garbage;
+    _old_skipped++;
+  } else if (type == ZPageTypeSmall) {
     _small.register_live_page(page, garbage);
   } else if (type == ZPageTypeMedium) {
     _medium.register_live_page(page, garbage);
@@ -205,6 +223,10 @@ void ZRelocationSetSelector::select(ZRelocationSet* relocation_set) {
   _medium.select();
   _small.select();
 
+  if (!_relocate_old) {
+    log_debug(gc, reloc)("Relocation Set: " SIZE_FORMAT " old pages skipped", _old_skipped);
+  }
+
   // Populate relocation set
   relocation_set->populate(_medium.selected(), _medium.nselected(),
                            _small.selected(), _small.nselected());
@@ -64,9 +64,14 @@ class ZRelocationSetSelector : public StackObj {
 private:
   ZRelocationSetSelectorGroup _small;
   ZRelocationSetSelectorGroup _medium;
+  const bool                  _relocate_old;
   size_t                      _live;
   size_t                      _garbage;
   size_t                      _fragmentation;
+  size_t                      _old_skipped;
+
+  static bool is_old_relocation_cycle();
+  bool is_old(const ZPage* page) const;
 
 public:
   ZRelocationSetSelector();
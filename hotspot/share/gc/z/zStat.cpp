@@ -808,6 +808,7 @@ void ZStatInc(const ZStatUnsampledCounter& counter, uint64_t increment) {
 const ZStatUnsampledCounter ZStatAllocRate::_counter("Allocation Rate");
 TruncatedSeq                ZStatAllocRate::_rate(ZStatAllocRate::sample_window_sec * ZStatAllocRate::sample_hz);
 TruncatedSeq                ZStatAllocRate::_rate_avg(ZStatAllocRate::sample_window_sec * ZStatAllocRate::sample_hz);
+TruncatedSeq                ZStatAllocRate::_rate_long(ZStatAllocRate::long_sample_window_sec * ZStatAllocRate::sample_hz);
 
 const ZStatUnsampledCounter& ZStatAllocRate::counter() {
   return _counter;
@@ -819,6 +820,7 @@ uint64_t ZStatAllocRate::sample_and_reset() {
 
   _rate.add(bytes_per_second);
   _rate_avg.add(_rate.avg());
+  _rate_long.add(bytes_per_second);
 
   return bytes_per_second;
 }
@@ -831,6 +833,18 @@ double ZStatAllocRate::avg_sd() {
   return _rate_avg.sd();
 }
 
+double ZStatAllocRate::trend() {
+  if ((uint64_t)_rate_long.num() < long_sample_window_sec * sample_hz) {
+    // Not enough history yet
+    return 0.0;
+  }
+
+  // Both averages are taken over windows ending now, so their
+  // midpoints are half the difference of the window lengths apart.
+  const double distance = (long_sample_window_sec - sample_window_sec) / 2.0;
+  return (_rate.avg() - _rate_long.avg()) / distance;
+}
+
 //
 // Stat thread
 //
@@ -326,16 +326,21 @@ private:
   static const ZStatUnsampledCounter _counter;
   static TruncatedSeq                _rate;     // B/s
   static TruncatedSeq                _rate_avg; // B/s
+  static TruncatedSeq                _rate_long; // B/s
 
 public:
-  static const uint64_t sample_window_sec = 1; // seconds
-  static const uint64_t sample_hz         = 10;
+  static const uint64_t sample_window_sec      = 1;  // seconds
+  static const uint64_t long_sample_window_sec = 10; // seconds
+  static const uint64_t sample_hz              = 10;
 
   static const ZStatUnsampledCounter& counter();
   static uint64_t sample_and_reset();
 
   static double avg();
   static double avg_sd();
+
+  // Change of the allocation rate, B/s per second
+  static double trend();
 };
 
 //
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/javaClasses.inline.hpp"
+#include "gc/shared/stringdedup/stringDedup.inline.hpp"
+#include "gc/shared/stringdedup/stringDedupBufferedQueue.hpp"
+#include "gc/shared/stringdedup/stringDedupQueue.inline.hpp"
+#include "gc/shared/stringdedup/stringDedupStat.hpp"
+#include "gc/z/zStringDedup.hpp"
+#include "gc/z/zThread.hpp"
+#include "oops/markOop.inline.hpp"
+#include "oops/oop.inline.hpp"
+#include "runtime/safepoint.hpp"
+
+void ZStringDedup::initialize() {
+  assert(UseZGC, "String deduplication available with ZGC");
+  StringDedup::initialize_impl<StringDedupBufferedQueue, StringDedupStat>();
+}
+
+void ZStringDedup::enqueue_candidate(oop obj) {
+  assert(is_enabled(), "String deduplication not enabled");
+
+  if (!java_lang_String::is_instance_inlined(obj)) {
+    // Not a candidate
+    return;
+  }
+
+  const markOop mark = obj->mark();
+  if (mark == markOopDesc::INFLATING() || mark->has_displaced_mark_helper()) {
+    // Locked, too risky to update the age
+    return;
+  }
+
+  if (mark->age() >= StringDeduplicationAgeThreshold) {
+    // Already been a candidate
+    return;
+  }
+
+  // Increase the age and enqueue the string when it reaches the threshold.
+  // Only the marking worker that wins the race gets to enqueue it.
+  const markOop new_mark = mark->incr_age();
+  if (obj->cas_set_mark(new_mark, mark) == mark &&
+      new_mark->age() == StringDeduplicationAgeThreshold) {
+    StringDedupQueue::push(ZThread::worker_id(), obj);
+  }
+}
+
+void ZStringDedup::publish_candidates() {
+  assert(is_enabled(), "String deduplication not enabled");
+  StringDedupBufferedQueue::publish();
+}
+
+void ZStringDedup::weak_oops_do(BoolObjectClosure* is_alive, OopClosure* cl) {
+  assert(SafepointSynchronize::is_at_safepoint(), "Must be at a safepoint");
+  assert(is_enabled(), "String deduplication not enabled");
+  StringDedupUnlinkOrOopsDoClosure sd_cl(is_alive, cl);
+  parallel_unlink(&sd_cl, ZThread::worker_id());
+}
+
+void ZStringDedup::oops_do(OopClosure* cl) {
+  weak_oops_do(NULL, cl);
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_Z_ZSTRINGDEDUP_HPP
+#define SHARE_GC_Z_ZSTRINGDEDUP_HPP
+
+#include "gc/shared/stringdedup/stringDedup.hpp"
+#include "oops/oop.hpp"
+
+class BoolObjectClosure;
+class OopClosure;
+
+//
+// ZGC has no young generation, so a String is aged once per marking
+// cycle in which it is strongly reachable, and becomes a candidate when
+// it reaches StringDeduplicationAgeThreshold. Candidates are buffered by
+// the marking workers and published when weak roots are processed in
+// the mark end pause. The queue and table are weak roots, cleaned in the
+// mark end pause and relocated in the relocate start pause.
+//
+class ZStringDedup : public StringDedup {
+public:
+  // Initialize string deduplication.
+  static void initialize();
+
+  // Age a String found by marking, and enqueue it on the worker's buffer
+  // when it reaches the deduplication age threshold.
+  static void enqueue_candidate(oop obj);
+
+  // Makes the candidates found by marking visible to the deduplication thread.
+  static void publish_candidates();
+
+  // Apply the given closures to the queue and table, in parallel by
+  // the workers of a pause.
+  static void weak_oops_do(BoolObjectClosure* is_alive, OopClosure* cl);
+  static void oops_do(OopClosure* cl);
+};
+
+#endif // SHARE_GC_Z_ZSTRINGDEDUP_HPP
@@ -37,6 +37,10 @@
 #include "oops/access.inline.hpp"
 
 static const ZStatSubPhase ZSubPhaseConcurrentClassesUnload("Concurrent Classes Unload");
+static const ZStatSubPhase ZSubPhaseConcurrentClassesUnlinkMetadata("Concurrent Classes Unlink Metadata");
+static const ZStatSubPhase ZSubPhaseConcurrentClassesUnlinkNMethods("Concurrent Classes Unlink NMethods");
+static const ZStatSubPhase ZSubPhaseConcurrentClassesPurgeNMethods("Concurrent Classes Purge NMethods");
+static const ZStatSubPhase ZSubPhaseConcurrentClassesPurgeMetadata("Concurrent Classes Purge Metadata");
 
 class ZIsUnloadingOopClosure : public OopClosure {
 private:
@@ -130,23 +134,31 @@ void ZUnload::unlink() {
   bool unloading_occurred;
 
   {
-    MutexLocker ml(ClassLoaderDataGraph_lock);
-    unloading_occurred = SystemDictionary::do_unloading(ZStatPhase::timer());
-  }
+    ZStatTimer timer(ZSubPhaseConcurrentClassesUnlinkMetadata);
+    {
+      MutexLocker ml(ClassLoaderDataGraph_lock);
+      unloading_occurred = SystemDictionary::do_unloading(ZStatPhase::timer());
+    }
 
-  Klass::clean_weak_klass_links(unloading_occurred);
+    Klass::clean_weak_klass_links(unloading_occurred);
+  }
 
-  ZNMethod::unlink(_workers, unloading_occurred);
+  {
+    ZStatTimer timer(ZSubPhaseConcurrentClassesUnlinkNMethods);
+    ZNMethod::unlink(_workers, unloading_occurred);
+  }
 
   DependencyContext::cleaning_end();
 }
 
 void ZUnload::purge() {
   {
+    ZStatTimer timer(ZSubPhaseConcurrentClassesPurgeNMethods);
     SuspendibleThreadSetJoiner sts;
     ZNMethod::purge(_workers);
   }
 
+  ZStatTimer timer(ZSubPhaseConcurrentClassesPurgeMetadata);
   ClassLoaderDataGraph::purge();
   CodeCache::purge_exception_caches();
 }
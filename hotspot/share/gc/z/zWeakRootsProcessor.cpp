@@ -25,6 +25,7 @@
 #include "gc/z/zHeap.inline.hpp"
 #include "gc/z/zOopClosures.inline.hpp"
 #include "gc/z/zStat.hpp"
+#include "gc/z/zStringDedup.hpp"
 #include "gc/z/zTask.hpp"
 #include "gc/z/zThread.hpp"
 #include "runtime/jniHandles.hpp"
@@ -39,12 +40,30 @@ private:
 public:
   ZProcessWeakRootsTask() :
       ZTask("ZProcessWeakRootsTask"),
-      _weak_roots() {}
+      _weak_roots() {
+    if (ZStringDedup::is_enabled()) {
+      ZStringDedup::gc_prologue(true /* resize_and_rehash_table */);
+    }
+  }
+
+  ~ZProcessWeakRootsTask() {
+    if (ZStringDedup::is_enabled()) {
+      ZStringDedup::gc_epilogue();
+
+      // Hand the candidates found by this marking cycle to the
+      // deduplication thread, now that the queue has been cleaned.
+      ZStringDedup::publish_candidates();
+    }
+  }
 
   virtual void work() {
     ZPhantomIsAliveObjectClosure is_alive;
     ZPhantomKeepAliveOopClosure keep_alive;
     _weak_roots.weak_oops_do(&is_alive, &keep_alive);
+
+    if (ZStringDedup::is_enabled()) {
+      ZStringDedup::weak_oops_do(&is_alive, &keep_alive);
+    }
   }
 };
 
@@ -46,9 +46,22 @@
   experimental(double, ZAllocationSpikeTolerance, 2.0,                      \
           "Allocation spike tolerance factor")                              \
                                                                             \
+  experimental(bool, ZAllocationRatePrediction, false,                      \
+          "Extrapolate the recent allocation rate trend when deciding "     \
+          "when to start a GC cycle")                                       \
+                                                                            \
   experimental(double, ZFragmentationLimit, 25.0,                           \
           "Maximum allowed heap fragmentation")                             \
                                                                             \
+  experimental(uint, ZPageTenuringThreshold, 0,                             \
+          "Number of GC cycles a page must survive to be considered old. "  \
+          "Old pages are only relocated every ZOldPageRelocationInterval "  \
+          "cycles (0 means pages never become old)")                        \
+                                                                            \
+  experimental(uint, ZOldPageRelocationInterval, 4,                         \
+          "Relocate old pages every this many GC cycles")                   \
+          range(1, (uint)-1)                                                \
+                                                                            \
   experimental(size_t, ZMarkStackSpaceLimit, 8*G,                           \
           "Maximum number of bytes allocated for mark stacks")              \
           range(32*M, 1024*G)                                               \
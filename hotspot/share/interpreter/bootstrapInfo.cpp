@@ -26,6 +26,7 @@
 #include "jvm.h"
 #include "classfile/javaClasses.inline.hpp"
 #include "classfile/resolutionErrors.hpp"
+#include "classfile/vmSymbols.hpp"
 #include "interpreter/bootstrapInfo.hpp"
 #include "interpreter/linkResolver.hpp"
 #include "logging/log.hpp"
@@ -76,6 +77,39 @@ bool BootstrapInfo::resolve_previously_linked_invokedynamic(CallInfo& result, TR
   }
 }
 
+// javac emits a single CONSTANT_InvokeDynamic for all string concatenations
+// of a class with the same recipe, constants and argument types, while each
+// invokedynamic instruction gets its own cache entry. StringConcatFactory
+// has no side effects and returns a ConstantCallSite whose target depends
+// only on the bootstrap specifier, so the linkage of any call site is good
+// for all of them. Only the boot loader can define the factory.
+bool BootstrapInfo::resolve_from_linked_sibling_invokedynamic(CallInfo& result, TRAPS) {
+  assert(_indy_index != -1, "");
+  if (!_pool->tag_at(bsm_index()).is_method_handle()) {
+    return false;
+  }
+  int member_index = _pool->method_handle_index_at(bsm_index());
+  Symbol* bsm_klass = _pool->klass_name_at(_pool->uncached_klass_ref_index_at(member_index));
+  if (bsm_klass != vmSymbols::java_lang_invoke_StringConcatFactory()) {
+    return false;
+  }
+
+  ConstantPoolCache* cache = _pool->cache();
+  ConstantPoolCacheEntry* self = invokedynamic_cp_cache_entry();
+  for (int i = 0; i < cache->length(); i++) {
+    ConstantPoolCacheEntry* cpce = cache->entry_at(i);
+    // f1 is set last, after the appendix, when a call site is linked.
+    if (cpce != self && cpce->constant_pool_index() == _bss_index && !cpce->is_f1_null()) {
+      methodHandle method(     THREAD, cpce->f1_as_method());
+      Handle       appendix(   THREAD, cpce->appendix_if_resolved(_pool));
+      result.set_handle(method, appendix, THREAD);
+      Exceptions::wrap_dynamic_exception(CHECK_false);
+      return true;
+    }
+  }
+  return false;
+}
+
 // Resolve the bootstrap specifier in 3 steps:
 // - unpack the BSM by resolving the MH constant
 // - obtain the NameAndType description for the condy/indy
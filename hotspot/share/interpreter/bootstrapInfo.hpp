@@ -92,6 +92,10 @@ class BootstrapInfo : public StackObj {
   // existing linkage data into result, or throw previous exception.
   // Return true if either action is taken, else false.
   bool resolve_previously_linked_invokedynamic(CallInfo& result, TRAPS);
+  // If another call site of the same bootstrap specifier was already
+  // linked and its linkage can be shared, set it into result and return
+  // true, else return false.
+  bool resolve_from_linked_sibling_invokedynamic(CallInfo& result, TRAPS);
   bool save_and_throw_indy_exc(TRAPS);
   void resolve_newly_linked_invokedynamic(CallInfo& result, TRAPS);
 
@@ -511,6 +511,8 @@ void Bytecodes::initialize() {
   def(_fast_iaccess_0      , "fast_iaccess_0"      , "b_JJ" , NULL    , T_INT    ,  1, true , _aload_0        );
   def(_fast_aaccess_0      , "fast_aaccess_0"      , "b_JJ" , NULL    , T_OBJECT ,  1, true , _aload_0        );
   def(_fast_faccess_0      , "fast_faccess_0"      , "b_JJ" , NULL    , T_OBJECT ,  1, true , _aload_0        );
+  def(_fast_aload_0_aload_1, "fast_aload_0_aload_1", "b_"   , NULL    , T_OBJECT ,  2, false, _aload_0        );
+  def(_fast_aload_0_iload_1, "fast_aload_0_iload_1", "b_"   , NULL    , T_INT    ,  2, false, _aload_0        );
 
   def(_fast_iload          , "fast_iload"          , "bi"   , NULL    , T_INT    ,  1, false, _iload);
   def(_fast_iload2         , "fast_iload2"         , "bi_i" , NULL    , T_INT    ,  2, false, _iload);
@@ -1707,6 +1707,13 @@ void LinkResolver::resolve_invokedynamic(CallInfo& result, const constantPoolHan
     if (is_done) return;
   }
 
+  // Share the linkage of an equivalent call site, rather than running the
+  // bootstrap method again:
+  if (ShareStringConcatCallSites) {
+    bool is_done = bootstrap_specifier.resolve_from_linked_sibling_invokedynamic(result, CHECK);
+    if (is_done) return;
+  }
+
   // The initial step in Call Site Specifier Resolution is to resolve the symbolic
   // reference to a method handle which will be the bootstrap method for a dynamic
   // call site.  If resolution for the java.lang.invoke.MethodHandle for the bootstrap
@@ -425,15 +425,33 @@ void InterpreterOopMap::resource_copy(OopMapCacheEntry* from) {
 inline unsigned int OopMapCache::hash_value_for(const methodHandle& method, int bci) const {
   // We use method->code_size() rather than method->identity_hash() below since
   // the mark may not be present if a pointer to the method is already reversed.
+  // Methods of the same shape are told apart by their address, which does
+  // not change while the method is in use.
   return   ((unsigned int) bci)
          ^ ((unsigned int) method->max_locals()         << 2)
          ^ ((unsigned int) method->code_size()          << 4)
-         ^ ((unsigned int) method->size_of_parameters() << 6);
+         ^ ((unsigned int) method->size_of_parameters() << 6)
+         ^ ((unsigned int) ((uintptr_t) method() >> LogBytesPerWord));
 }
 
 OopMapCacheEntry* volatile OopMapCache::_old_entries = NULL;
 
-OopMapCache::OopMapCache() {
+volatile size_t OopMapCache::_lookups   = 0;
+volatile size_t OopMapCache::_hits      = 0;
+volatile size_t OopMapCache::_evictions = 0;
+
+// Two entries per method, so that a class with many hot methods does not
+// keep evicting and recomputing the oop maps of its frames.
+int OopMapCache::size_for(int method_count) {
+  int size = _min_size;
+  while (size < _max_size && size < 2 * method_count) {
+    size <<= 1;
+  }
+  return size;
+}
+
+OopMapCache::OopMapCache(int method_count) : _size(size_for(method_count)) {
+  assert(is_power_of_2(_size), "mask in entry_at() and put_at()");
   _array  = NEW_C_HEAP_ARRAY(OopMapCacheEntry*, _size, mtClass);
   for(int i = 0; i < _size; i++) _array[i] = NULL;
 }
@@ -448,11 +466,11 @@ OopMapCache::~OopMapCache() {
 }
 
 OopMapCacheEntry* OopMapCache::entry_at(int i) const {
-  return OrderAccess::load_acquire(&(_array[i % _size]));
+  return OrderAccess::load_acquire(&(_array[i & (_size - 1)]));
 }
 
 bool OopMapCache::put_at(int i, OopMapCacheEntry* entry, OopMapCacheEntry* old) {
-  return Atomic::cmpxchg(entry, &_array[i % _size], old) == old;
+  return Atomic::cmpxchg(entry, &_array[i & (_size - 1)], old) == old;
 }
 
 void OopMapCache::flush() {
@@ -495,6 +513,10 @@ void OopMapCache::lookup(const methodHandle& method,
   int probe = hash_value_for(method, bci);
   int i;
   OopMapCacheEntry* entry = NULL;
+  const bool count = log_is_enabled(Info, gc, phases);
+  if (count) {
+    Atomic::inc(&_lookups);
+  }
 
   if (log_is_enabled(Debug, interpreter, oopmap)) {
     static int count = 0;
@@ -511,6 +533,9 @@ void OopMapCache::lookup(const methodHandle& method,
       entry_for->resource_copy(entry);
       assert(!entry_for->is_empty(), "A non-empty oop map should be returned");
       log_debug(interpreter, oopmap)("- found at hash %d", probe + i);
+      if (count) {
+        Atomic::inc(&_hits);
+      }
       return;
     }
   }
@@ -549,6 +574,9 @@ void OopMapCache::lookup(const methodHandle& method,
   // where the first entry in the collision array is replaced with the new one.
   OopMapCacheEntry* old = entry_at(probe + 0);
   if (put_at(probe + 0, tmp, old)) {
+    if (count) {
+      Atomic::inc(&_evictions);
+    }
     enqueue_for_cleanup(old);
   } else {
     enqueue_for_cleanup(tmp);
@@ -592,6 +620,21 @@ void OopMapCache::cleanup_old_entries() {
   }
 }
 
+void OopMapCache::log_statistics() {
+  // Called by the VM thread after the GC, like cleanup_old_entries().
+  size_t lookups = _lookups;
+  if (lookups == 0) {
+    return;
+  }
+  size_t hits = _hits;
+  log_info(gc, phases)("Interpreter oop map cache: " SIZE_FORMAT " lookups, " SIZE_FORMAT " hits (%.1f%%), "
+                       SIZE_FORMAT " computed, " SIZE_FORMAT " evicted",
+                       lookups, hits, percent_of(hits, lookups), lookups - hits, _evictions);
+  _lookups = 0;
+  _hits = 0;
+  _evictions = 0;
+}
+
 void OopMapCache::compute_one_oop_map(const methodHandle& method, int bci, InterpreterOopMap* entry) {
   // Due to the invariants above it's tricky to allocate a temporary OopMapCacheEntry on the stack
   OopMapCacheEntry* tmp = NEW_C_HEAP_ARRAY(OopMapCacheEntry, 1, mtClass);
@@ -146,13 +146,21 @@ class InterpreterOopMap: ResourceObj {
 
 class OopMapCache : public CHeapObj<mtClass> {
  static OopMapCacheEntry* volatile _old_entries;
+
+ // Statistics, reported with -Xlog:gc+phases after each GC.
+ static volatile size_t _lookups;
+ static volatile size_t _hits;
+ static volatile size_t _evictions;
  private:
-  enum { _size        = 32,     // Use fixed size for now
+  enum { _min_size    = 32,     // The size grows with the number of methods
+         _max_size    = 1024,   // of the class, as a power of two
          _probe_depth = 3       // probe depth in case of collisions
   };
 
+  const int _size;
   OopMapCacheEntry* volatile * _array;
 
+  static int size_for(int method_count);
   unsigned int hash_value_for(const methodHandle& method, int bci) const;
   OopMapCacheEntry* entry_at(int i) const;
   bool put_at(int i, OopMapCacheEntry* entry, OopMapCacheEntry* old);
@@ -162,7 +170,7 @@ class OopMapCache : public CHeapObj<mtClass> {
   void flush();
 
  public:
-  OopMapCache();
+  OopMapCache(int method_count);
   ~OopMapCache();                                // free up memory
 
   // flush cache entry is occupied by an obsolete method
@@ -175,6 +183,8 @@ class OopMapCache : public CHeapObj<mtClass> {
   // Compute an oop map without updating the cache or grabbing any locks (for debugging)
   static void compute_one_oop_map(const methodHandle& method, int bci, InterpreterOopMap* entry);
   static void cleanup_old_entries();
+  // Log and reset the statistics of the lookups since the last call.
+  static void log_statistics();
 };
 
 #endif // SHARE_INTERPRETER_OOPMAPCACHE_HPP
@@ -481,6 +481,8 @@ void TemplateTable::initialize() {
   def(Bytecodes::_fast_iaccess_0      , ubcp|____|____|____, vtos, itos, fast_xaccess        ,  itos        );
   def(Bytecodes::_fast_aaccess_0      , ubcp|____|____|____, vtos, atos, fast_xaccess        ,  atos        );
   def(Bytecodes::_fast_faccess_0      , ubcp|____|____|____, vtos, ftos, fast_xaccess        ,  ftos        );
+  def(Bytecodes::_fast_aload_0_aload_1, ____|____|____|____, vtos, atos, fast_aload_0_aload_1,  _           );
+  def(Bytecodes::_fast_aload_0_iload_1, ____|____|____|____, vtos, itos, fast_aload_0_iload_1,  _           );
 
   def(Bytecodes::_fast_iload          , ubcp|____|____|____, vtos, itos, fast_iload          ,  _       );
   def(Bytecodes::_fast_iload2         , ubcp|____|____|____, vtos, itos, fast_iload2         ,  _       );
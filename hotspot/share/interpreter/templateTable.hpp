@@ -145,6 +145,8 @@ class TemplateTable: AllStatic {
   static void fload();
   static void dload();
   static void aload();
+  static void fast_aload_0_aload_1();
+  static void fast_aload_0_iload_1();
 
   static void locals_index_wide(Register reg);
   static void wide_iload();
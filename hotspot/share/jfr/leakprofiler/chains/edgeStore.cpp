@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "jfr/leakprofiler/chains/edgeStore.hpp"
 #include "jfr/leakprofiler/chains/edgeUtils.hpp"
+#include "jfr/leakprofiler/utilities/granularTimer.hpp"
 #include "oops/oop.inline.hpp"
 
 StoredEdge::StoredEdge() : Edge() {}
@@ -42,7 +43,7 @@ void StoredEdge::operator=(const StoredEdge& edge) {
 
 traceid EdgeStore::_edge_id_counter = 0;
 
-EdgeStore::EdgeStore() : _edges(NULL) {
+EdgeStore::EdgeStore() : _edges(NULL), _unreached_candidates(0) {
   _edges = new EdgeHashTable(this);
 }
 
@@ -254,6 +255,12 @@ void EdgeStore::put_chain(const Edge* chain, size_t length) {
   assert(leak_context_edge != NULL, "invariant");
   assert(leak_context_edge->parent() == NULL, "invariant");
 
+  // a candidate is reached only once, as its mark now refers to the leak context edge
+  if (_unreached_candidates > 0 && --_unreached_candidates == 0) {
+    // all candidates have their chains, no need to traverse the rest of the heap
+    GranularTimer::finish();
+  }
+
   if (1 == length) {
     return;
   }
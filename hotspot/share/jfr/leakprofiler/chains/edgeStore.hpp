@@ -72,6 +72,7 @@ class EdgeStore : public CHeapObj<mtTracing> {
  private:
   static traceid _edge_id_counter;
   EdgeHashTable* _edges;
+  size_t _unreached_candidates;
 
   // Hash table callbacks
   void assign_id(EdgeEntry* entry);
@@ -102,6 +103,11 @@ class EdgeStore : public CHeapObj<mtTracing> {
   bool is_empty() const;
   traceid get_id(const Edge* edge) const;
   void put_chain(const Edge* chain, size_t length);
+
+  // The traversal is finished when chains are put for this many leak candidates
+  void set_unreached_candidates(size_t count) {
+    _unreached_candidates = count;
+  }
 };
 
 #endif // SHARE_JFR_LEAKPROFILER_CHAINS_EDGESTORE_HPP
@@ -102,10 +102,13 @@ void PathToGcRootsOperation::doit() {
   // Save the original markWord for the potential leak objects,
   // to be restored on function exit
   ObjectSampleMarker marker;
-  if (ObjectSampleCheckpoint::mark(_sampler, marker, _emit_all) == 0) {
+  const int number_of_candidates = ObjectSampleCheckpoint::mark(_sampler, marker, _emit_all);
+  if (number_of_candidates == 0) {
     // no valid samples to process
     return;
   }
+  // stop the traversal once every candidate is reached
+  _edge_store->set_unreached_candidates((size_t)number_of_candidates);
 
   // Necessary condition for attempting a root set iteration
   Universe::heap()->ensure_parsability(false);
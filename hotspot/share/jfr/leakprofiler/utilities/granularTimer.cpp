@@ -47,6 +47,15 @@ void GranularTimer::stop() {
     _finish_time_ticks = JfrTicks::now();
   }
 }
+// Ends the period ahead of the finish time, when there is no work left.
+void GranularTimer::finish() {
+  if (!_finished) {
+    _finish_time_ticks = JfrTicks::now();
+    _finished = true;
+    _counter = 1;
+  }
+}
+
 const JfrTicks& GranularTimer::start_time() {
   return _start_time_ticks;
 }
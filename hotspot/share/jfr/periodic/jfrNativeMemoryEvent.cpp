@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "jfr/jfrEvents.hpp"
+#include "jfr/periodic/jfrNativeMemoryEvent.hpp"
+#include "jfr/utilities/jfrTime.hpp"
+#include "memory/resourceArea.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "services/memBaseline.hpp"
+#include "services/memTracker.hpp"
+#include "services/threadStackTracker.hpp"
+#include "services/virtualMemoryTracker.hpp"
+#include "utilities/macros.hpp"
+#include "utilities/ostream.hpp"
+
+#if INCLUDE_NMT
+
+// Number of the largest malloc sites sent per period
+static const int max_allocation_site_events = 20;
+
+// Committed memory per type at the previous period, for the deltas
+static size_t last_committed[mt_number_of_types];
+
+static size_t reserved_total(const MallocMemory* malloc, const VirtualMemory* vm) {
+  return malloc->malloc_size() + malloc->arena_size() + vm->reserved();
+}
+
+static size_t committed_total(const MallocMemory* malloc, const VirtualMemory* vm) {
+  return malloc->malloc_size() + malloc->arena_size() + vm->committed();
+}
+
+void JfrNativeMemoryEvent::send_total_event() {
+  if (MemTracker::tracking_level() < NMT_summary) {
+    return;
+  }
+  MutexLocker locker(MemTracker::query_lock());
+  MemBaseline baseline;
+  if (!baseline.baseline(true)) {
+    return;
+  }
+  EventNativeMemoryUsageTotal event;
+  event.set_reserved(baseline.total_reserved_memory());
+  event.set_committed(baseline.total_committed_memory());
+  event.commit();
+}
+
+// Accounted the same way as in the summary of the VM.native_memory command
+void JfrNativeMemoryEvent::send_type_events() {
+  if (MemTracker::tracking_level() < NMT_summary) {
+    return;
+  }
+  MutexLocker locker(MemTracker::query_lock());
+  MemBaseline baseline;
+  if (!baseline.baseline(true)) {
+    return;
+  }
+  const JfrTicks timestamp = JfrTicks::now();
+  for (int index = 0; index < mt_number_of_types; index++) {
+    const MEMFLAGS flag = NMTUtil::index_to_flag(index);
+    // thread stack is reported as part of thread category
+    if (flag == mtThreadStack) {
+      continue;
+    }
+    size_t reserved = reserved_total(baseline.malloc_memory(flag), baseline.virtual_memory(flag));
+    size_t committed = committed_total(baseline.malloc_memory(flag), baseline.virtual_memory(flag));
+    if (flag == mtThread) {
+      if (ThreadStackTracker::track_as_vm()) {
+        const VirtualMemory* const thread_stack_usage = baseline.virtual_memory(mtThreadStack);
+        reserved += thread_stack_usage->reserved();
+        committed += thread_stack_usage->committed();
+      } else {
+        const MallocMemory* const thread_stack_usage = baseline.malloc_memory(mtThreadStack);
+        reserved += thread_stack_usage->malloc_size();
+        committed += thread_stack_usage->malloc_size();
+      }
+    } else if (flag == mtNMT) {
+      reserved += baseline.malloc_tracking_overhead();
+      committed += baseline.malloc_tracking_overhead();
+    }
+    const jlong committed_delta = (jlong)committed - (jlong)last_committed[index];
+    last_committed[index] = committed;
+    if (reserved == 0 && committed_delta == 0) {
+      continue;
+    }
+    EventNativeMemoryUsage event(UNTIMED);
+    event.set_endtime(timestamp);
+    event.set_type(NMTUtil::flag_to_name(flag));
+    event.set_reserved(reserved);
+    event.set_committed(committed);
+    event.set_committedDelta(committed_delta);
+    event.commit();
+  }
+}
+
+void JfrNativeMemoryEvent::send_allocation_site_events() {
+  if (MemTracker::tracking_level() != NMT_detail) {
+    return;
+  }
+  ResourceMark rm;
+  MutexLocker locker(MemTracker::query_lock());
+  MemBaseline baseline;
+  if (!baseline.baseline(false)) {
+    return;
+  }
+  const JfrTicks timestamp = JfrTicks::now();
+  MallocSiteIterator itr = baseline.malloc_sites(MemBaseline::by_size);
+  const MallocSite* site;
+  for (int sent = 0; sent < max_allocation_site_events && (site = itr.next()) != NULL; sent++) {
+    stringStream call_stack;
+    site->call_stack()->print_on(&call_stack);
+    EventNativeMemoryAllocationSite event(UNTIMED);
+    event.set_endtime(timestamp);
+    event.set_type(NMTUtil::flag_to_name(site->flag()));
+    event.set_callStack(call_stack.as_string());
+    event.set_size(site->size());
+    event.set_count(site->count());
+    event.commit();
+  }
+}
+
+void JfrNativeMemoryEvent::send_mappings_event() {
+  if (MemTracker::tracking_level() < NMT_summary) {
+    return;
+  }
+  MutexLocker locker(MemTracker::query_lock());
+  ProcessMappingSnapshot snapshot;
+  if (!snapshot.take()) {
+    return;
+  }
+  EventNativeMemoryMappings event;
+  event.set_trackedSize(snapshot.tracked_size());
+  event.set_trackedResident(snapshot.tracked_rss());
+  event.set_untrackedAnonymousSize(snapshot.untracked_anon_size());
+  event.set_untrackedAnonymousResident(snapshot.untracked_anon_rss());
+  event.set_untrackedFileSize(snapshot.untracked_file_size());
+  event.set_untrackedFileResident(snapshot.untracked_file_rss());
+  event.set_mallocTotal(MallocMemorySummary::as_snapshot()->total());
+  event.commit();
+}
+
+#else // INCLUDE_NMT
+
+void JfrNativeMemoryEvent::send_total_event() {}
+void JfrNativeMemoryEvent::send_type_events() {}
+void JfrNativeMemoryEvent::send_allocation_site_events() {}
+void JfrNativeMemoryEvent::send_mappings_event() {}
+
+#endif // INCLUDE_NMT
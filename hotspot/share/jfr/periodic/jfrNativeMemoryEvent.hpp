@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_JFR_PERIODIC_JFRNATIVEMEMORYEVENT_HPP
+#define SHARE_JFR_PERIODIC_JFRNATIVEMEMORYEVENT_HPP
+
+#include "memory/allocation.hpp"
+
+// Native memory usage as tracked by NMT, sent when
+// -XX:NativeMemoryTracking is summary or detail.
+class JfrNativeMemoryEvent : AllStatic {
+ public:
+  static void send_total_event();
+  static void send_type_events();
+  // Only sent with -XX:NativeMemoryTracking=detail
+  static void send_allocation_site_events();
+  // Only sent on platforms that report the process memory mappings
+  static void send_mappings_event();
+};
+
+#endif // SHARE_JFR_PERIODIC_JFRNATIVEMEMORYEVENT_HPP
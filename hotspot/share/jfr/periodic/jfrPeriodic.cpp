@@ -39,6 +39,7 @@
 #include "gc/shared/objectCountEventSender.hpp"
 #include "jfr/jfrEvents.hpp"
 #include "jfr/periodic/jfrModuleEvent.hpp"
+#include "jfr/periodic/jfrNativeMemoryEvent.hpp"
 #include "jfr/periodic/jfrOSInterface.hpp"
 #include "jfr/periodic/jfrThreadCPULoadEvent.hpp"
 #include "jfr/periodic/jfrThreadDumpEvent.hpp"
@@ -58,6 +59,7 @@
 #include "runtime/os_perf.hpp"
 #include "runtime/thread.inline.hpp"
 #include "runtime/threadSMR.hpp"
+#include "runtime/timer.hpp"
 #include "runtime/sweeper.hpp"
 #include "runtime/vmThread.hpp"
 #include "services/classLoadingService.hpp"
@@ -437,6 +439,57 @@ TRACE_REQUEST_FUNC(ThreadAllocationStatistics) {
   }
 }
 
+struct ThreadTLABSample {
+  traceid thread_id;
+  size_t  desired_size;
+  float   allocation_fraction;
+  size_t  refills;
+  size_t  slow_allocations;
+  size_t  refill_waste;
+  size_t  gc_waste;
+};
+
+TRACE_REQUEST_FUNC(ThreadTLABStatistics) {
+  if (!UseTLAB) {
+    return;
+  }
+  ResourceMark rm;
+  int initial_size = Threads::number_of_threads();
+  GrowableArray<ThreadTLABSample> samples(initial_size);
+  JfrTicks time_stamp = JfrTicks::now();
+  {
+    // Collect TLAB statistics while holding threads lock
+    MutexLocker ml(Threads_lock);
+    for (JavaThreadIteratorWithHandle jtiwh; JavaThread *jt = jtiwh.next(); ) {
+      const ThreadLocalAllocBuffer& tlab = jt->tlab();
+      ThreadTLABSample sample;
+      sample.thread_id           = JFR_THREAD_ID(jt);
+      sample.desired_size        = tlab.desired_size() * HeapWordSize;
+      sample.allocation_fraction = tlab.allocation_fraction();
+      sample.refills             = tlab.total_refills();
+      sample.slow_allocations    = tlab.total_slow_allocations();
+      sample.refill_waste        = tlab.total_refill_waste() * HeapWordSize;
+      sample.gc_waste            = tlab.total_gc_waste() * HeapWordSize;
+      samples.append(sample);
+    }
+  }
+
+  // Write TLAB statistics to buffer.
+  for (int i = 0; i < samples.length(); i++) {
+    const ThreadTLABSample& sample = samples.at(i);
+    EventThreadTLABStatistics event(UNTIMED);
+    event.set_thread(sample.thread_id);
+    event.set_desiredSize(sample.desired_size);
+    event.set_allocationFraction(sample.allocation_fraction);
+    event.set_refills(sample.refills);
+    event.set_slowAllocations(sample.slow_allocations);
+    event.set_refillWaste(sample.refill_waste);
+    event.set_gcWaste(sample.gc_waste);
+    event.set_endtime(time_stamp);
+    event.commit();
+  }
+}
+
 /**
  *  PhysicalMemory event represents:
  *
@@ -449,6 +502,22 @@ TRACE_REQUEST_FUNC(ThreadAllocationStatistics) {
  *  If running inside a guest OS on top of a hypervisor in a virtualized environment,
  *  the total memory reported is the amount of memory configured for the guest OS by the hypervisor.
  */
+TRACE_REQUEST_FUNC(NativeMemoryUsage) {
+  JfrNativeMemoryEvent::send_type_events();
+}
+
+TRACE_REQUEST_FUNC(NativeMemoryUsageTotal) {
+  JfrNativeMemoryEvent::send_total_event();
+}
+
+TRACE_REQUEST_FUNC(NativeMemoryAllocationSite) {
+  JfrNativeMemoryEvent::send_allocation_site_events();
+}
+
+TRACE_REQUEST_FUNC(NativeMemoryMappings) {
+  JfrNativeMemoryEvent::send_mappings_event();
+}
+
 TRACE_REQUEST_FUNC(PhysicalMemory) {
   u8 totalPhysicalMemory = os::physical_memory();
   EventPhysicalMemory event;
@@ -474,6 +543,10 @@ TRACE_REQUEST_FUNC(ClassLoadingStatistics) {
 }
 
 class JfrClassLoaderStatsClosure : public ClassLoaderStatsClosure {
+  static jlong ticks_to_nanos(jlong ticks) {
+    return (jlong)(TimeHelper::counter_to_seconds(ticks) * NANOSECS_PER_SEC);
+  }
+
 public:
   JfrClassLoaderStatsClosure() : ClassLoaderStatsClosure(NULL) {}
 
@@ -492,6 +565,10 @@ public:
     event.set_unsafeAnonymousClassCount(cls->_anon_classes_count);
     event.set_unsafeAnonymousChunkSize(cls->_anon_chunk_sz);
     event.set_unsafeAnonymousBlockSize(cls->_anon_block_sz);
+    event.set_parseTime(ticks_to_nanos(cls->_loading_ticks[ClassLoaderData::parse_phase]));
+    event.set_verifyTime(ticks_to_nanos(cls->_loading_ticks[ClassLoaderData::verify_phase]));
+    event.set_linkTime(ticks_to_nanos(cls->_loading_ticks[ClassLoaderData::link_phase]));
+    event.set_initTime(ticks_to_nanos(cls->_loading_ticks[ClassLoaderData::init_phase]));
     event.commit();
     return true;
   }
@@ -573,6 +650,10 @@ TRACE_REQUEST_FUNC(CompilerStatistics) {
   event.commit();
 }
 
+TRACE_REQUEST_FUNC(CompilerQueueStatistics) {
+  CompileBroker::post_compile_queue_statistics_events();
+}
+
 TRACE_REQUEST_FUNC(CompilerConfiguration) {
   EventCompilerConfiguration event;
   event.set_threadCount(CICompilerCount);
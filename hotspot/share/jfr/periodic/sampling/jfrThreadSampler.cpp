@@ -33,6 +33,7 @@
 #include "jfr/utilities/jfrTime.hpp"
 #include "logging/log.hpp"
 #include "runtime/frame.inline.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/os.hpp"
 #include "runtime/semaphore.hpp"
 #include "runtime/thread.inline.hpp"
@@ -257,7 +258,7 @@ bool JfrThreadSampleClosure::sample_thread_in_java(JavaThread* thread, JfrStackF
   }
   EventExecutionSample *event = &_events[_added_java - 1];
   traceid id = JfrStackTraceRepository::add(sampler.stacktrace());
-  assert(id != 0, "Stacktrace id should not be 0");
+  // id is 0 if the stack trace repository is full
   event->set_stackTrace(id);
   return true;
 }
@@ -277,11 +278,50 @@ bool JfrThreadSampleClosure::sample_thread_in_native(JavaThread* thread, JfrStac
   }
   EventNativeMethodSample *event = &_events_native[_added_native - 1];
   traceid id = JfrStackTraceRepository::add(cb.stacktrace());
-  assert(id != 0, "Stacktrace id should not be 0");
+  // id is 0 if the stack trace repository is full
   event->set_stackTrace(id);
   return true;
 }
 
+// Takes the stack trace of a thread that reached a safepoint poll. Unlike
+// a suspended thread, the sampled thread can not be in the middle of a
+// malloc or holding a lock, so the stack trace is added to the repository
+// right away, while the methods in it are known to be alive.
+class JfrHandshakeSampleClosure : public ThreadClosure {
+ public:
+  JfrHandshakeSampleClosure(JfrStackFrame* frames, u4 max_frames) :
+    _stacktrace(frames, max_frames),
+    _sample_time(),
+    _stacktrace_id(0),
+    _state(java_lang_Thread::NEW) {}
+
+  void do_thread(Thread* thread) {
+    JavaThread* const jt = (JavaThread*)thread;
+    // The VM thread processes the handshake for threads that blocked or
+    // went native in the meantime; those were not executing Java code.
+    if (Thread::current() != jt || !jt->has_last_Java_frame()) {
+      return;
+    }
+    _sample_time = JfrTicks::now();
+    frame topframe = jt->last_frame();
+    if (_stacktrace.record_thread(*jt, topframe)) {
+      _stacktrace_id = JfrStackTraceRepository::add(_stacktrace);
+      _state = java_lang_Thread::get_thread_status(jt->threadObj());
+    }
+  }
+
+  bool success() const { return _stacktrace_id != 0; }
+  const JfrTicks& sample_time() const { return _sample_time; }
+  traceid stacktrace_id() const { return _stacktrace_id; }
+  java_lang_Thread::ThreadStatus state() const { return _state; }
+
+ private:
+  JfrStackTrace _stacktrace;
+  JfrTicks _sample_time;
+  traceid _stacktrace_id;
+  java_lang_Thread::ThreadStatus _state;
+};
+
 static const uint MAX_NR_OF_JAVA_SAMPLES = 5;
 static const uint MAX_NR_OF_NATIVE_SAMPLES = 1;
 
@@ -323,7 +363,9 @@ class JfrThreadSampler : public NonJavaThread {
   volatile bool _disenrolled;
 
   JavaThread* next_thread(ThreadsList* t_list, JavaThread* first_sampled, JavaThread* current);
+  uint select_by_cpu_time(ThreadsList* t_list, JfrSampleType type, JavaThread** candidates, jlong* cpu_times, uint limit);
   void task_stacktrace(JfrSampleType type, JavaThread** last_thread);
+  void task_stacktrace_with_handshakes(JavaThread** last_thread);
   JfrThreadSampler(size_t interval_java, size_t interval_native, u4 max_frames);
   ~JfrThreadSampler();
 
@@ -419,6 +461,52 @@ JavaThread* JfrThreadSampler::next_thread(ThreadsList* t_list, JavaThread* first
   return next != first_sampled ? next : NULL;
 }
 
+static bool sample_by_cpu_time() {
+  return JfrSampleByCPUTime && os::is_thread_cpu_time_supported();
+}
+
+// Picks at most limit threads in the state of the sample type, ordered by the
+// CPU time they used since they were last sampled. As a thread keeps the CPU
+// time it used until it is sampled, threads are sampled in proportion to their
+// CPU consumption however many threads there are, and idle threads not at all.
+uint JfrThreadSampler::select_by_cpu_time(ThreadsList* t_list, JfrSampleType type, JavaThread** candidates, jlong* cpu_times, uint limit) {
+  assert(Threads_lock->owned_by_self(), "Holding the thread table lock.");
+  assert(limit > 0 && limit <= MAX_NR_OF_JAVA_SAMPLES, "invariant");
+  jlong unsampled[MAX_NR_OF_JAVA_SAMPLES];
+  uint count = 0;
+  for (uint i = 0; i < t_list->length(); i++) {
+    JavaThread* const jt = t_list->thread_at(i);
+    if (jt->is_Compiler_thread() || jt->is_hidden_from_external_view()) {
+      continue;
+    }
+    if (JAVA_SAMPLE == type ? !thread_state_in_java(jt) : !thread_state_in_native(jt)) {
+      continue;
+    }
+    const jlong cpu_time = os::thread_cpu_time(jt);
+    const jlong unsampled_cpu_time = cpu_time - jt->jfr_thread_local()->sampled_cpu_time();
+    if (cpu_time < 0 || unsampled_cpu_time <= 0) {
+      continue;
+    }
+    uint pos;
+    if (count < limit) {
+      pos = count++;
+    } else if (unsampled_cpu_time > unsampled[limit - 1]) {
+      pos = limit - 1;
+    } else {
+      continue;
+    }
+    for (; pos > 0 && unsampled[pos - 1] < unsampled_cpu_time; pos--) {
+      candidates[pos] = candidates[pos - 1];
+      cpu_times[pos] = cpu_times[pos - 1];
+      unsampled[pos] = unsampled[pos - 1];
+    }
+    candidates[pos] = jt;
+    cpu_times[pos] = cpu_time;
+    unsampled[pos] = unsampled_cpu_time;
+  }
+  return count;
+}
+
 void JfrThreadSampler::start_thread() {
   if (os::create_thread(this, os::os_thread)) {
     os::start_thread(this);
@@ -486,7 +574,11 @@ void JfrThreadSampler::run() {
     }
 
     if ((next_j - sleep_to_next) <= 0) {
-      task_stacktrace(JAVA_SAMPLE, &_last_thread_java);
+      if (JfrSampleWithHandshakes && ThreadLocalHandshakes) {
+        task_stacktrace_with_handshakes(&_last_thread_java);
+      } else {
+        task_stacktrace(JAVA_SAMPLE, &_last_thread_java);
+      }
       last_java_ms = get_monotonic_ms();
     }
     if ((next_n - sleep_to_next) <= 0) {
@@ -518,12 +610,73 @@ void JfrThreadSampler::task_stacktrace(JfrSampleType type, JavaThread** last_thr
     {
       MutexLocker tlock(Threads_lock, Mutex::_no_safepoint_check_flag);
       ThreadsListHandle tlh;
-      // Resolve a sample session relative start position index into the thread list array.
-      // In cases where the last sampled thread is NULL or not-NULL but stale, find_index() returns -1.
+      if (sample_by_cpu_time()) {
+        JavaThread* candidates[MAX_NR_OF_JAVA_SAMPLES];
+        jlong cpu_times[MAX_NR_OF_JAVA_SAMPLES];
+        const uint num_candidates = select_by_cpu_time(tlh.list(), type, candidates, cpu_times, sample_limit);
+        for (uint i = 0; i < num_candidates; i++) {
+          if (sample_task.do_sample_thread(candidates[i], _frames, _max_frames, type)) {
+            candidates[i]->jfr_thread_local()->set_sampled_cpu_time(cpu_times[i]);
+            num_samples++;
+          }
+        }
+      } else {
+        // Resolve a sample session relative start position index into the thread list array.
+        // In cases where the last sampled thread is NULL or not-NULL but stale, find_index() returns -1.
+        _cur_index = tlh.list()->find_index_of_JavaThread(*last_thread);
+        JavaThread* current = _cur_index != -1 ? *last_thread : NULL;
+
+        while (num_samples < sample_limit) {
+          current = next_thread(tlh.list(), start, current);
+          if (current == NULL) {
+            break;
+          }
+          if (start == NULL) {
+            start = current;  // remember the thread where we started to attempt sampling
+          }
+          if (current->is_Compiler_thread()) {
+            continue;
+          }
+          if (sample_task.do_sample_thread(current, _frames, _max_frames, type)) {
+            num_samples++;
+          }
+        }
+        *last_thread = current;  // remember the thread we last attempted to sample
+      }
+    }
+    sample_time.stop();
+    log_trace(jfr)("JFR thread sampling done in %3.7f secs with %d java %d native samples",
+                   sample_time.seconds(), sample_task.java_entries(), sample_task.native_entries());
+  }
+  if (num_samples > 0) {
+    sample_task.commit_events(type);
+  }
+}
+
+// Picks the threads to sample under the Threads_lock, as task_stacktrace()
+// does, but handshakes with them one at a time after releasing it; the VM
+// thread needs the lock to process the handshakes.
+void JfrThreadSampler::task_stacktrace_with_handshakes(JavaThread** last_thread) {
+  ResourceMark rm;
+  EventExecutionSample samples[MAX_NR_OF_JAVA_SAMPLES];
+  JavaThread* candidates[MAX_NR_OF_JAVA_SAMPLES];
+  jlong cpu_times[MAX_NR_OF_JAVA_SAMPLES];
+  uint num_candidates = 0;
+  uint num_samples = 0;
+
+  elapsedTimer sample_time;
+  sample_time.start();
+  // Keeps the candidates alive after the Threads_lock is released.
+  ThreadsListHandle tlh;
+  {
+    MutexLocker tlock(Threads_lock, Mutex::_no_safepoint_check_flag);
+    if (sample_by_cpu_time()) {
+      num_candidates = select_by_cpu_time(tlh.list(), JAVA_SAMPLE, candidates, cpu_times, MAX_NR_OF_JAVA_SAMPLES);
+    } else {
       _cur_index = tlh.list()->find_index_of_JavaThread(*last_thread);
       JavaThread* current = _cur_index != -1 ? *last_thread : NULL;
-
-      while (num_samples < sample_limit) {
+      JavaThread* start = NULL;
+      while (num_candidates < MAX_NR_OF_JAVA_SAMPLES) {
         current = next_thread(tlh.list(), start, current);
         if (current == NULL) {
           break;
@@ -531,21 +684,36 @@ void JfrThreadSampler::task_stacktrace(JfrSampleType type, JavaThread** last_thr
         if (start == NULL) {
           start = current;  // remember the thread where we started to attempt sampling
         }
-        if (current->is_Compiler_thread()) {
+        if (current->is_Compiler_thread() || current->is_hidden_from_external_view() ||
+            !thread_state_in_java(current)) {
           continue;
         }
-        if (sample_task.do_sample_thread(current, _frames, _max_frames, type)) {
-          num_samples++;
-        }
+        candidates[num_candidates++] = current;
       }
       *last_thread = current;  // remember the thread we last attempted to sample
     }
-    sample_time.stop();
-    log_trace(jfr)("JFR thread sampling done in %3.7f secs with %d java %d native samples",
-                   sample_time.seconds(), sample_task.java_entries(), sample_task.native_entries());
   }
-  if (num_samples > 0) {
-    sample_task.commit_events(type);
+
+  for (uint i = 0; i < num_candidates; i++) {
+    JfrHandshakeSampleClosure cl(_frames, _max_frames);
+    if (Handshake::execute(&cl, candidates[i]) && cl.success()) {
+      if (sample_by_cpu_time()) {
+        candidates[i]->jfr_thread_local()->set_sampled_cpu_time(cpu_times[i]);
+      }
+      EventExecutionSample* ev = &samples[num_samples++];
+      ev->set_starttime(cl.sample_time());
+      ev->set_endtime(cl.sample_time()); // fake to not take an end time
+      ev->set_sampledThread(JFR_THREAD_ID(candidates[i]));
+      ev->set_state(cl.state());
+      ev->set_stackTrace(cl.stacktrace_id());
+    }
+  }
+  sample_time.stop();
+  log_trace(jfr)("JFR thread sampling with handshakes done in %3.7f secs with %u java samples",
+                 sample_time.seconds(), num_samples);
+
+  for (uint i = 0; i < num_samples; i++) {
+    samples[i].commit();
   }
 }
 
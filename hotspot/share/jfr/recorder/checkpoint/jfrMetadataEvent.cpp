@@ -33,6 +33,7 @@
 #include "runtime/thread.inline.hpp"
 
 static jbyteArray _metadata_blob = NULL;
+static volatile u4 _metadata_version = 0;
 static Semaphore metadata_mutex_semaphore(1);
 
 void JfrMetadataEvent::lock() {
@@ -85,5 +86,11 @@ void JfrMetadataEvent::update(jbyteArray metadata) {
   }
   const oop new_desc_oop = JfrJavaSupport::resolve_non_null(metadata);
   _metadata_blob = new_desc_oop != NULL ? (jbyteArray)JfrJavaSupport::global_jni_handle(new_desc_oop, thread) : NULL;
+  // updated under the semaphore
+  _metadata_version++;
   unlock();
 }
+
+u4 JfrMetadataEvent::version() {
+  return _metadata_version;
+}
@@ -27,6 +27,7 @@
 
 #include "jni.h"
 #include "memory/allocation.hpp"
+#include "utilities/globalDefinitions.hpp"
 
 class JfrChunkWriter;
 
@@ -41,6 +42,8 @@ class JfrMetadataEvent : AllStatic {
   static void unlock();
   static size_t write(JfrChunkWriter& writer, jlong metadata_offset);
   static void update(jbyteArray metadata);
+  // Number of updates so far, 0 if Java has not provided metadata yet
+  static u4 version();
 };
 
 #endif // SHARE_JFR_RECORDER_CHECKPOINT_JFRMETADATAEVENT_HPP
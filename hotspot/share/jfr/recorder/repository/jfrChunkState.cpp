@@ -96,6 +96,18 @@ int64_t JfrChunkState::last_chunk_duration() const {
   return _start_nanos - _previous_start_nanos;
 }
 
+int64_t JfrChunkState::start_ticks() const {
+  return _start_ticks;
+}
+
+int64_t JfrChunkState::start_nanos() const {
+  return _start_nanos;
+}
+
+int64_t JfrChunkState::current_chunk_duration() const {
+  return (os::javaTimeMillis() * JfrTimeConverter::NANOS_PER_MILLISEC) - _start_nanos;
+}
+
 static char* copy_path(const char* path) {
   assert(path != NULL, "invariant");
   const size_t path_len = strlen(path);
@@ -51,6 +51,9 @@ class JfrChunkState : public JfrCHeapObj {
   int64_t previous_start_ticks() const;
   int64_t previous_start_nanos() const;
   int64_t last_chunk_duration() const;
+  int64_t start_ticks() const;
+  int64_t start_nanos() const;
+  int64_t current_chunk_duration() const;
   void update_time_to_now();
   void set_path(const char* path);
   const char* path() const;
@@ -77,11 +77,33 @@ bool JfrChunkWriter::open() {
 size_t JfrChunkWriter::close(int64_t metadata_offset) {
   write_header(metadata_offset);
   this->flush();
+  if (JfrOptionSet::drop_cache()) {
+    this->drop_cache();
+  }
   this->close_fd();
   return (size_t)size_written();
 }
 
 void JfrChunkWriter::write_header(int64_t metadata_offset) {
+  write_header(metadata_offset,
+               _chunkstate->previous_start_nanos(),
+               _chunkstate->last_chunk_duration(),
+               _chunkstate->previous_start_ticks());
+}
+
+// Makes the chunk readable up to the current offset while it remains open.
+void JfrChunkWriter::flush_chunk(int64_t metadata_offset) {
+  write_header(metadata_offset,
+               _chunkstate->start_nanos(),
+               _chunkstate->current_chunk_duration(),
+               _chunkstate->start_ticks());
+  this->flush();
+  if (JfrOptionSet::drop_cache()) {
+    this->drop_cache();
+  }
+}
+
+void JfrChunkWriter::write_header(int64_t metadata_offset, int64_t start_nanos, int64_t duration_nanos, int64_t start_ticks) {
   assert(this->is_valid(), "invariant");
   // Chunk size
   this->write_be_at_offset(size_written(), CHUNK_SIZE_OFFSET);
@@ -90,11 +112,11 @@ void JfrChunkWriter::write_header(int64_t metadata_offset) {
   // metadata event offset
   this->write_be_at_offset(metadata_offset, CHUNK_SIZE_OFFSET + (2 * FILEHEADER_SLOT_SIZE));
   // start of chunk in nanos since epoch
-  this->write_be_at_offset(_chunkstate->previous_start_nanos(), CHUNK_SIZE_OFFSET + (3 * FILEHEADER_SLOT_SIZE));
+  this->write_be_at_offset(start_nanos, CHUNK_SIZE_OFFSET + (3 * FILEHEADER_SLOT_SIZE));
   // duration of chunk in nanos
-  this->write_be_at_offset(_chunkstate->last_chunk_duration(), CHUNK_SIZE_OFFSET + (4 * FILEHEADER_SLOT_SIZE));
+  this->write_be_at_offset(duration_nanos, CHUNK_SIZE_OFFSET + (4 * FILEHEADER_SLOT_SIZE));
   // start of chunk in ticks
-  this->write_be_at_offset(_chunkstate->previous_start_ticks(), CHUNK_SIZE_OFFSET + (5 * FILEHEADER_SLOT_SIZE));
+  this->write_be_at_offset(start_ticks, CHUNK_SIZE_OFFSET + (5 * FILEHEADER_SLOT_SIZE));
 }
 
 void JfrChunkWriter::set_chunk_path(const char* chunk_path) {
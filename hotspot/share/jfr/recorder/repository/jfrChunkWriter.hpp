@@ -43,6 +43,7 @@ class JfrChunkWriter : public JfrChunkWriterBase {
   bool open();
   size_t close(int64_t metadata_offset);
   void write_header(int64_t metadata_offset);
+  void write_header(int64_t metadata_offset, int64_t start_nanos, int64_t duration_nanos, int64_t start_ticks);
   void set_chunk_path(const char* chunk_path);
 
  public:
@@ -52,6 +53,7 @@ class JfrChunkWriter : public JfrChunkWriterBase {
   int64_t previous_checkpoint_offset() const;
   void set_previous_checkpoint_offset(int64_t offset);
   void time_stamp_chunk_now();
+  void flush_chunk(int64_t metadata_offset);
 };
 
 #endif // SHARE_JFR_RECORDER_REPOSITORY_JFRCHUNKWRITER_HPP
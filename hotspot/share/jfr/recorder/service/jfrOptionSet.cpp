@@ -103,6 +103,14 @@ void JfrOptionSet::set_old_object_queue_size(jlong value) {
   _old_object_queue_size = value;
 }
 
+jlong JfrOptionSet::flush_interval() {
+  return _flush_interval;
+}
+
+void JfrOptionSet::set_flush_interval(jlong millis) {
+  _flush_interval = millis;
+}
+
 u4 JfrOptionSet::stackdepth() {
   return _stack_depth;
 }
@@ -133,6 +141,14 @@ void JfrOptionSet::set_retransform(jboolean value) {
   _retransform = value;
 }
 
+bool JfrOptionSet::drop_cache() {
+  return _drop_cache == JNI_TRUE;
+}
+
+void JfrOptionSet::set_drop_cache(jboolean value) {
+  _drop_cache = value;
+}
+
 bool JfrOptionSet::sample_protection() {
   return _sample_protection == JNI_TRUE;
 }
@@ -171,6 +187,8 @@ const char* const default_sample_threads = "true";
 const char* const default_stack_depth = "64";
 const char* const default_retransform = "true";
 const char* const default_old_object_queue_size = "256";
+const char* const default_flush_interval = "0";
+const char* const default_drop_cache = "false";
 DEBUG_ONLY(const char* const default_sample_protection = "false";)
 
 // statics
@@ -223,6 +241,13 @@ static DCmdArgument<jlong> _dcmd_old_object_queue_size (
   false,
   default_old_object_queue_size);
 
+static DCmdArgument<NanoTimeArgument> _dcmd_flushinterval(
+  "flushinterval",
+  "Interval at which buffered data is flushed to the current disk chunk, 0 to only write data when the chunk is rotated",
+  "NANOTIME",
+  false,
+  default_flush_interval);
+
 static DCmdArgument<bool> _dcmd_sample_threads(
   "samplethreads",
   "Thread sampling enable / disable (only sampling when event enabled and sampling enabled)",
@@ -253,6 +278,13 @@ static DCmdArgument<bool> _dcmd_retransform(
   true,
   default_retransform);
 
+static DCmdArgument<bool> _dcmd_dropcache(
+  "dropcache",
+  "If written chunk data should be dropped from the file system cache (by default false)",
+  "BOOLEAN",
+  false,
+  default_drop_cache);
+
 static DCmdParser _parser;
 
 static void register_parser_options() {
@@ -266,6 +298,8 @@ static void register_parser_options() {
   _parser.add_dcmd_option(&_dcmd_sample_threads);
   _parser.add_dcmd_option(&_dcmd_retransform);
   _parser.add_dcmd_option(&_dcmd_old_object_queue_size);
+  _parser.add_dcmd_option(&_dcmd_flushinterval);
+  _parser.add_dcmd_option(&_dcmd_dropcache);
   DEBUG_ONLY(_parser.add_dcmd_option(&_dcmd_sample_protection);)
 }
 
@@ -304,9 +338,11 @@ jlong JfrOptionSet::_thread_buffer_size = 0;
 jlong JfrOptionSet::_memory_size = 0;
 jlong JfrOptionSet::_num_global_buffers = 0;
 jlong JfrOptionSet::_old_object_queue_size = 0;
+jlong JfrOptionSet::_flush_interval = 0;
 u4 JfrOptionSet::_stack_depth = STACK_DEPTH_DEFAULT;
 jboolean JfrOptionSet::_sample_threads = JNI_TRUE;
 jboolean JfrOptionSet::_retransform = JNI_TRUE;
+jboolean JfrOptionSet::_drop_cache = JNI_FALSE;
 #ifdef ASSERT
 jboolean JfrOptionSet::_sample_protection = JNI_FALSE;
 #else
@@ -322,6 +358,14 @@ bool JfrOptionSet::initialize(Thread* thread) {
     set_retransform(_dcmd_retransform.value());
   }
   set_old_object_queue_size(_dcmd_old_object_queue_size.value());
+  set_drop_cache(_dcmd_dropcache.value());
+  const jlong flush_interval_nanos = _dcmd_flushinterval.value()._nanotime;
+  if (flush_interval_nanos < 0) {
+    log_error(arguments) ("-XX:FlightRecorderOptions=flushinterval must not be negative");
+    return false;
+  }
+  // a non-zero interval below a millisecond is rounded up
+  set_flush_interval(flush_interval_nanos == 0 ? 0 : MAX2((jlong)1, flush_interval_nanos / NANOSECS_PER_MILLISEC));
   return adjust_memory_options();
 }
 
@@ -44,9 +44,11 @@ class JfrOptionSet : public AllStatic {
   static jlong _memory_size;
   static jlong _num_global_buffers;
   static jlong _old_object_queue_size;
+  static jlong _flush_interval;
   static u4 _stack_depth;
   static jboolean _sample_threads;
   static jboolean _retransform;
+  static jboolean _drop_cache;
   static jboolean _sample_protection;
 
   static bool initialize(Thread* thread);
@@ -66,12 +68,16 @@ class JfrOptionSet : public AllStatic {
   static void set_num_global_buffers(jlong value);
   static jint old_object_queue_size();
   static void set_old_object_queue_size(jlong value);
+  static jlong flush_interval();
+  static void set_flush_interval(jlong millis);
   static u4 stackdepth();
   static void set_stackdepth(u4 depth);
   static bool sample_threads();
   static void set_sample_threads(jboolean sample);
   static bool can_retransform();
   static void set_retransform(jboolean value);
+  static bool drop_cache();
+  static void set_drop_cache(jboolean value);
   static bool compressed_integers();
   static bool allow_retransforms();
   static bool allow_event_retransforms();
@@ -33,6 +33,7 @@
 #include "jfr/recorder/repository/jfrChunkRotation.hpp"
 #include "jfr/recorder/repository/jfrChunkWriter.hpp"
 #include "jfr/recorder/repository/jfrRepository.hpp"
+#include "jfr/recorder/service/jfrOptionSet.hpp"
 #include "jfr/recorder/service/jfrPostBox.hpp"
 #include "jfr/recorder/service/jfrRecorderService.hpp"
 #include "jfr/recorder/stacktrace/jfrStackTraceRepository.hpp"
@@ -226,8 +227,30 @@ class WriteStackTraceRepository : public StackObj {
   void reset() { _elements_processed = 0; }
 };
 
+class WriteDetachedStackTraces : public StackObj {
+ private:
+  JfrStackTraceRepository& _repo;
+  JfrChunkWriter& _cw;
+  size_t _elements_processed;
+
+ public:
+  WriteDetachedStackTraces(JfrStackTraceRepository& repo, JfrChunkWriter& cw) :
+    _repo(repo), _cw(cw), _elements_processed(0) {}
+  bool process() {
+    _elements_processed = _repo.write_detached(_cw);
+    return true;
+  }
+  size_t processed() const { return _elements_processed; }
+  void reset() { _elements_processed = 0; }
+};
+
 static bool recording = false;
 
+// state of the flushes into the current chunk
+static int64_t flushed_metadata_offset = 0;
+static u4 flushed_metadata_version = 0;
+static jlong last_flush_millis = 0;
+
 static void set_recording_state(bool is_recording) {
   OrderAccess::storestore();
   recording = is_recording;
@@ -345,6 +368,8 @@ void JfrRecorderService::open_new_chunk(bool vm_error) {
   assert(!JfrStream_lock->owned_by_self(), "invariant");
   JfrChunkRotation::on_rotation();
   MutexLocker stream_lock(JfrStream_lock, Mutex::_no_safepoint_check_flag);
+  flushed_metadata_offset = 0;
+  flushed_metadata_version = 0;
   if (!_repository.open_chunk(vm_error)) {
     assert(!_chunkwriter.is_valid(), "invariant");
     _storage.control().set_to_disk(false);
@@ -392,6 +417,7 @@ void JfrRecorderService::write() {
 typedef ServiceFunctor<JfrStringPool, &JfrStringPool::write> WriteStringPool;
 typedef ServiceFunctor<JfrStringPool, &JfrStringPool::write_at_safepoint> WriteStringPoolSafepoint;
 typedef WriteCheckpointEvent<WriteStackTraceRepository> WriteStackTraceCheckpoint;
+typedef WriteCheckpointEvent<WriteDetachedStackTraces> WriteDetachedStackTraceCheckpoint;
 typedef WriteCheckpointEvent<WriteStringPool> WriteStringPoolCheckpoint;
 typedef WriteCheckpointEvent<WriteStringPoolSafepoint> WriteStringPoolCheckpointSafepoint;
 
@@ -401,6 +427,12 @@ static void write_stacktrace_checkpoint(JfrStackTraceRepository& stack_trace_rep
   write_stack_trace_checkpoint.process();
 }
 
+static void write_detached_stacktrace_checkpoint(JfrStackTraceRepository& stack_trace_repo, JfrChunkWriter& chunkwriter) {
+  WriteDetachedStackTraces write_detached_stacktraces(stack_trace_repo, chunkwriter);
+  WriteDetachedStackTraceCheckpoint write_stack_trace_checkpoint(chunkwriter, TYPE_STACKTRACE, write_detached_stacktraces);
+  write_stack_trace_checkpoint.process();
+}
+
 static void write_object_sample_stacktrace(ObjectSampler* sampler, JfrStackTraceRepository& stack_trace_repository) {
   WriteObjectSampleStacktrace object_sample_stacktrace(sampler, stack_trace_repository);
   object_sample_stacktrace.process();
@@ -456,7 +488,7 @@ void JfrRecorderService::invoke_safepoint_write() {
 // safepoint write sequence
 //
 //   lock stream lock ->
-//       write stacktrace repository ->
+//       detach stacktrace repository entries ->
 //         write string pool ->
 //           write safepoint dependent types ->
 //             write storage ->
@@ -468,7 +500,7 @@ void JfrRecorderService::invoke_safepoint_write() {
 void JfrRecorderService::safepoint_write() {
   assert(SafepointSynchronize::is_at_safepoint(), "invariant");
   MutexLocker stream_lock(JfrStream_lock, Mutex::_no_safepoint_check_flag);
-  write_stacktrace_checkpoint(_stack_trace_repository, _chunkwriter, true);
+  _stack_trace_repository.detach();
   write_stringpool_checkpoint_safepoint(_string_pool, _chunkwriter);
   _checkpoint_manager.write_safepoint_types();
   _storage.write_at_safepoint();
@@ -490,11 +522,12 @@ static int64_t write_metadata_event(JfrChunkWriter& chunkwriter) {
 //   write type set ->
 //     release object sampler ->
 //       lock stream lock ->
-//         write checkpoints ->
-//           write metadata event ->
-//             write chunk header ->
-//               close chunk fd ->
-//                 release stream lock
+//         write detached stacktraces ->
+//           write checkpoints ->
+//             write metadata event ->
+//               write chunk header ->
+//                 close chunk fd ->
+//                   release stream lock
 //
 void JfrRecorderService::post_safepoint_write() {
   assert(_chunkwriter.is_valid(), "invariant");
@@ -509,6 +542,8 @@ void JfrRecorderService::post_safepoint_write() {
     ObjectSampler::release();
   }
   MutexLocker stream_lock(JfrStream_lock, Mutex::_no_safepoint_check_flag);
+  // the stack traces recorded during the previous epoch, unlinked at the safepoint
+  write_detached_stacktrace_checkpoint(_stack_trace_repository, _chunkwriter);
   // serialize any outstanding checkpoint memory
   _checkpoint_manager.write();
   // serialize the metadata descriptor event and close out the chunk
@@ -551,3 +586,47 @@ void JfrRecorderService::scavenge() {
 void JfrRecorderService::evaluate_chunk_size_for_rotation() {
   JfrChunkRotation::evaluate(_chunkwriter);
 }
+
+//
+// flush sequence
+//
+//  lock stream lock ->
+//    write stack trace checkpoint ->
+//      write string pool checkpoint ->
+//        write storage ->
+//          write metadata event, if updated since the last flush ->
+//            write chunk header ->
+//              release stream lock
+//
+// Unlike a rotation, a flush does not shift the epoch, so the type set of
+// classes and methods tagged in the current epoch is still only written
+// when the chunk is finalized.
+//
+void JfrRecorderService::flush() {
+  const jlong interval = JfrOptionSet::flush_interval();
+  if (interval == 0 || !is_recording()) {
+    return;
+  }
+  const jlong now = os::javaTimeNanos() / NANOSECS_PER_MILLISEC;
+  if (now - last_flush_millis < interval) {
+    return;
+  }
+  last_flush_millis = now;
+  ResourceMark rm;
+  HandleMark hm;
+  MutexLocker stream_lock(JfrStream_lock, Mutex::_no_safepoint_check_flag);
+  if (!_chunkwriter.is_valid()) {
+    // in-memory recording
+    return;
+  }
+  write_stacktrace_checkpoint(_stack_trace_repository, _chunkwriter, false);
+  write_stringpool_checkpoint(_string_pool, _chunkwriter);
+  _storage.write();
+  const u4 metadata_version = JfrMetadataEvent::version();
+  if (metadata_version != flushed_metadata_version) {
+    JfrMetadataEvent::lock();
+    flushed_metadata_offset = write_metadata_event(_chunkwriter);
+    flushed_metadata_version = metadata_version;
+  }
+  _chunkwriter.flush_chunk(flushed_metadata_offset);
+}
@@ -71,6 +71,7 @@ class JfrRecorderService : public StackObj {
   void process_full_buffers();
   void scavenge();
   void evaluate_chunk_size_for_rotation();
+  void flush();
   static bool is_recording();
 };
 
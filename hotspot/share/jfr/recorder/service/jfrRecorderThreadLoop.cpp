@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "jfr/recorder/jfrRecorder.hpp"
+#include "jfr/recorder/service/jfrOptionSet.hpp"
 #include "jfr/recorder/service/jfrPostBox.hpp"
 #include "jfr/recorder/service/jfrRecorderService.hpp"
 #include "jfr/recorder/service/jfrRecorderThread.hpp"
@@ -55,7 +56,8 @@ void recorderthread_entry(JavaThread* thread, Thread* unused) {
     // JFR MESSAGE LOOP PROCESSING - BEGIN
     while (!done) {
       if (post_box.is_empty()) {
-        JfrMsg_lock->wait();
+        // wakes up at least once per flush interval, if there is one
+        JfrMsg_lock->wait(JfrOptionSet::flush_interval());
       }
       msgs = post_box.collect();
       JfrMsg_lock->unlock();
@@ -72,6 +74,8 @@ void recorderthread_entry(JavaThread* thread, Thread* unused) {
         service.start();
       } else if (ROTATE) {
         service.rotate(msgs);
+      } else {
+        service.flush();
       }
       JfrMsg_lock->lock();
       post_box.notify_waiters();
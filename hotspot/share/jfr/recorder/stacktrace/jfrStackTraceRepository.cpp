@@ -29,12 +29,15 @@
 #include "jfr/recorder/service/jfrOptionSet.hpp"
 #include "jfr/recorder/stacktrace/jfrStackTraceRepository.hpp"
 #include "jfr/utilities/jfrTypes.hpp"
+#include "logging/log.hpp"
 #include "memory/allocation.inline.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.hpp"
 #include "runtime/os.inline.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/task.hpp"
 #include "runtime/vframe.inline.hpp"
+#include "utilities/globalCounter.inline.hpp"
 
 class vframeStreamSamples : public vframeStreamCommon {
  public:
@@ -100,8 +103,10 @@ void JfrStackTraceRepository::destroy() {
   _instance = NULL;
 }
 
-JfrStackTraceRepository::JfrStackTraceRepository() : _next_id(0), _entries(0) {
-  memset(_table, 0, sizeof(_table));
+JfrStackTraceRepository::JfrStackTraceRepository() : _detached(NULL), _next_id(0), _entries(0), _dropped(0) {
+  for (u4 i = 0; i < TABLE_SIZE; ++i) {
+    _table[i] = NULL;
+  }
 }
 class JfrFrameType : public JfrSerializer {
  public:
@@ -122,54 +127,106 @@ bool JfrStackTraceRepository::initialize() {
   return JfrSerializer::register_serializer(TYPE_FRAMETYPE, false, true, new JfrFrameType());
 }
 
-size_t JfrStackTraceRepository::clear() {
-  MutexLocker lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
-  if (_entries == 0) {
-    return 0;
+// Unlinks all entries from the table. The returned bucket lists must be
+// passed to delete_entries() once the lock has been released.
+JfrStackTraceRepository::StackTrace** JfrStackTraceRepository::detach_entries() {
+  assert(JfrStacktrace_lock->owned_by_self(), "invariant");
+  StackTrace** const heads = NEW_C_HEAP_ARRAY(StackTrace*, TABLE_SIZE, mtTracing);
+  for (u4 i = 0; i < TABLE_SIZE; ++i) {
+    heads[i] = _table[i];
+    OrderAccess::release_store(&_table[i], (StackTrace*)NULL);
   }
+  _entries = 0;
+  if (_dropped > 0) {
+    log_info(jfr, system)("Dropped " SIZE_FORMAT " stack traces, the stack trace repository was full", _dropped);
+    _dropped = 0;
+  }
+  return heads;
+}
+
+// Waits for the lock-free readers that may still see the detached
+// entries before deleting them.
+void JfrStackTraceRepository::delete_entries(StackTrace** heads) {
+  assert(!JfrStacktrace_lock->owned_by_self(), "invariant");
+  GlobalCounter::write_synchronize();
   for (u4 i = 0; i < TABLE_SIZE; ++i) {
-    JfrStackTraceRepository::StackTrace* stacktrace = _table[i];
+    StackTrace* stacktrace = heads[i];
     while (stacktrace != NULL) {
-      JfrStackTraceRepository::StackTrace* next = stacktrace->next();
+      StackTrace* const next = stacktrace->next();
       delete stacktrace;
       stacktrace = next;
     }
   }
-  memset(_table, 0, sizeof(_table));
-  const size_t processed = _entries;
-  _entries = 0;
-  return processed;
+  FREE_C_HEAP_ARRAY(StackTrace*, heads);
 }
 
-traceid JfrStackTraceRepository::add_trace(const JfrStackTrace& stacktrace) {
-  MutexLocker lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
-  const size_t index = stacktrace._hash % TABLE_SIZE;
-  const StackTrace* table_entry = _table[index];
+size_t JfrStackTraceRepository::clear() {
+  StackTrace** heads = NULL;
+  size_t processed = 0;
+  {
+    MutexLocker lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
+    if (_entries == 0) {
+      return 0;
+    }
+    processed = _entries;
+    heads = detach_entries();
+  }
+  delete_entries(heads);
+  return processed;
+}
 
+const JfrStackTraceRepository::StackTrace* JfrStackTraceRepository::lookup(size_t index, const JfrStackTrace& stacktrace) const {
+  const StackTrace* table_entry = OrderAccess::load_acquire(&_table[index]);
   while (table_entry != NULL) {
     if (table_entry->equals(stacktrace)) {
-      return table_entry->id();
+      return table_entry;
     }
     table_entry = table_entry->next();
   }
+  return NULL;
+}
+
+traceid JfrStackTraceRepository::add_trace(const JfrStackTrace& stacktrace) {
+  const size_t index = stacktrace._hash % TABLE_SIZE;
+  {
+    // Most stack traces are already known, look them up without the lock.
+    GlobalCounter::CriticalSection cs(Thread::current());
+    const StackTrace* const table_entry = lookup(index, stacktrace);
+    if (table_entry != NULL) {
+      return table_entry->id();
+    }
+  }
 
   if (!stacktrace.have_lineno()) {
     return 0;
   }
 
+  MutexLocker lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
+  // Another thread may have added the same stack trace in the meantime
+  const StackTrace* const table_entry = lookup(index, stacktrace);
+  if (table_entry != NULL) {
+    return table_entry->id();
+  }
+
+  if (_entries >= MAX_ENTRIES) {
+    ++_dropped;
+    return 0;
+  }
+
   traceid id = ++_next_id;
-  _table[index] = new StackTrace(id, stacktrace, _table[index]);
+  // Entries are immutable once published, lock-free readers only follow _next
+  OrderAccess::release_store(&_table[index], new StackTrace(id, stacktrace, _table[index]));
   ++_entries;
   return id;
 }
 
 traceid JfrStackTraceRepository::add(const JfrStackTrace& stacktrace) {
   traceid tid = instance().add_trace(stacktrace);
-  if (tid == 0) {
+  if (tid == 0 && !stacktrace.have_lineno()) {
     stacktrace.resolve_linenos();
     tid = instance().add_trace(stacktrace);
   }
-  assert(tid != 0, "invariant");
+  // 0 if the repository is full
   return tid;
 }
 
@@ -219,32 +276,62 @@ bool JfrStackTraceRepository::fill_stacktrace_for(JavaThread* thread, JfrStackTr
 }
 
 size_t JfrStackTraceRepository::write_impl(JfrChunkWriter& sw, bool clear) {
-  MutexLocker lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
-  assert(_entries > 0, "invariant");
-  int count = 0;
+  StackTrace** heads = NULL;
+  size_t count = 0;
+  {
+    MutexLocker lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
+    assert(_entries > 0, "invariant");
+    count = write_entries(_table, sw);
+    if (clear) {
+      heads = detach_entries();
+    }
+  }
+  if (heads != NULL) {
+    delete_entries(heads);
+  }
+  return count;
+}
+
+size_t JfrStackTraceRepository::write(JfrChunkWriter& sw, bool clear) {
+  return _entries > 0 ? write_impl(sw, clear) : 0;
+}
+
+size_t JfrStackTraceRepository::write_entries(StackTrace* const volatile* heads, JfrChunkWriter& sw) {
+  size_t count = 0;
   for (u4 i = 0; i < TABLE_SIZE; ++i) {
-    JfrStackTraceRepository::StackTrace* stacktrace = _table[i];
+    const StackTrace* stacktrace = heads[i];
     while (stacktrace != NULL) {
-      JfrStackTraceRepository::StackTrace* next = stacktrace->next();
       if (stacktrace->should_write()) {
         stacktrace->write(sw);
         ++count;
       }
-      if (clear) {
-        delete stacktrace;
-      }
-      stacktrace = next;
+      stacktrace = stacktrace->next();
     }
   }
-  if (clear) {
-    memset(_table, 0, sizeof(_table));
-    _entries = 0;
-  }
   return count;
 }
 
-size_t JfrStackTraceRepository::write(JfrChunkWriter& sw, bool clear) {
-  return _entries > 0 ? write_impl(sw, clear) : 0;
+// Chunk rotation only unlinks the entries while at the safepoint, which is
+// proportional to the table size and not to the number of stack traces.
+// Stack traces recorded after the safepoint belong to the next chunk.
+void JfrStackTraceRepository::detach() {
+  assert(SafepointSynchronize::is_at_safepoint(), "invariant");
+  assert(_detached == NULL, "invariant");
+  MutexLocker lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
+  if (_entries > 0) {
+    _detached = detach_entries();
+  }
+}
+
+size_t JfrStackTraceRepository::write_detached(JfrChunkWriter& sw) {
+  StackTrace** const heads = _detached;
+  if (heads == NULL) {
+    return 0;
+  }
+  _detached = NULL;
+  const size_t count = write_entries(heads, sw);
+  delete_entries(heads);
+  return count;
 }
 
 traceid JfrStackTraceRepository::write(JfrCheckpointWriter& writer, traceid id, unsigned int hash) {
@@ -125,10 +125,19 @@ class JfrStackTraceRepository : public JfrCHeapObj {
 
  private:
   static const u4 TABLE_SIZE = 2053;
-  StackTrace* _table[TABLE_SIZE];
+  // Bounds the memory held between two chunk rotations
+  static const u4 MAX_ENTRIES = 256 * K;
+  StackTrace* volatile _table[TABLE_SIZE];
+  // Entries unlinked at the rotation safepoint, serialized after it
+  StackTrace** _detached;
   traceid _next_id;
   u4 _entries;
+  size_t _dropped;
 
+  const StackTrace* lookup(size_t index, const JfrStackTrace& stacktrace) const;
+  StackTrace** detach_entries();
+  static void delete_entries(StackTrace** heads);
+  static size_t write_entries(StackTrace* const volatile* heads, JfrChunkWriter& cw);
   traceid add_trace(const JfrStackTrace& stacktrace);
   static traceid add(const JfrStackTrace* stacktrace, JavaThread* thread);
   traceid record_for(JavaThread* thread, int skip, JfrStackFrame* frames, u4 max_frames);
@@ -151,6 +160,8 @@ class JfrStackTraceRepository : public JfrCHeapObj {
   static traceid record(Thread* thread, int skip = 0);
   traceid write(JfrCheckpointWriter& cpw, traceid id, unsigned int hash);
   size_t write(JfrChunkWriter& cw, bool clear);
+  void detach();
+  size_t write_detached(JfrChunkWriter& cw);
   size_t clear();
 };
 
@@ -83,7 +83,8 @@ inline void JfrMemorySpace<T, RetrievalType, Callback>::release_full(T* t) {
   assert(t->empty(), "invariant");
   assert(!t->retired(), "invariant");
   assert(t->identity() == NULL, "invariant");
-  if (should_populate_cache()) {
+  // only regular sized elements are cached, larger ones are given back
+  if (t->size() == _min_elem_size && should_populate_cache()) {
     assert(!_free.in_list(t), "invariant");
     insert_free_head(t);
   } else {
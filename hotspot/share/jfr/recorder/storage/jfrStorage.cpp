@@ -98,6 +98,10 @@ static const size_t unlimited_mspace_size = 0;
 static const size_t thread_local_cache_count = 8;
 static const size_t thread_local_scavenge_threshold = thread_local_cache_count / 2;
 static const size_t transient_buffer_size_multiplier = 8; // against thread local buffer size
+static const size_t thread_local_growth_limit_multiplier = 8; // against thread local buffer size
+static const jlong hot_thread_flush_interval_nanos = 10 * NANOSECS_PER_MILLISEC;
+static const jlong idle_thread_flush_interval_nanos = NANOSECS_PER_SEC;
+static size_t thread_local_max_buffer_size = 0;
 
 template <typename Mspace>
 static Mspace* create_mspace(size_t buffer_size, size_t limit, size_t cache_count, JfrStorage* storage_instance) {
@@ -142,6 +146,8 @@ bool JfrStorage::initialize() {
     return false;
   }
   control().set_scavenge_threshold(thread_local_scavenge_threshold);
+  // a grown thread local buffer must still be promotable into a single global buffer
+  thread_local_max_buffer_size = MIN2(thread_buffer_size * thread_local_growth_limit_multiplier, global_buffer_size);
   return true;
 }
 
@@ -187,10 +193,24 @@ static BufferPtr get_lease(size_t size, JfrStorageMspace* mspace, JfrStorage& st
   }
 }
 
+// Threads start searching the global free list from either end depending on their trace id,
+// so concurrently promoting threads do not all compete for the same buffers.
+static BufferPtr get_free_for_promotion(size_t size, JfrStorageMspace* mspace, size_t retry_count, Thread* thread) {
+  const jfr_iter_direction direction = (thread->jfr_thread_local()->trace_id() & 1) == 0 ? forward : backward;
+  for (size_t i = 0; i < retry_count; ++i) {
+    JfrStorageMspace::Iterator iterator(mspace->free(), direction);
+    BufferPtr const t = JfrMspaceRetrieval<JfrStorageMspace>::get(size, mspace, iterator, thread);
+    if (t != NULL) {
+      return t;
+    }
+  }
+  return NULL;
+}
+
 static BufferPtr get_promotion_buffer(size_t size, JfrStorageMspace* mspace, JfrStorage& storage_instance, size_t retry_count, Thread* thread) {
   assert(size <= mspace->min_elem_size(), "invariant");
   while (true) {
-    BufferPtr t = mspace_get_free_with_retry(size, mspace, retry_count, thread);
+    BufferPtr t = get_free_for_promotion(size, mspace, retry_count, thread);
     if (t == NULL && storage_instance.control().should_discard()) {
       storage_instance.discard_oldest(thread);
       continue;
@@ -487,7 +507,41 @@ BufferPtr JfrStorage::flush(BufferPtr cur, size_t used, size_t req, bool native,
                           instance().flush_regular(cur, cur_pos, used, req, native, t);
 }
 
-BufferPtr JfrStorage::flush_regular(BufferPtr cur, const u1* const cur_pos, size_t used, size_t req, bool native, Thread* t) {
+static BufferPtr store_buffer_to_thread_local(BufferPtr buffer, JfrThreadLocal* jfr_thread_local, bool native) {
+  assert(buffer != NULL, "invariant");
+  if (native) {
+    jfr_thread_local->set_native_buffer(buffer);
+  } else {
+    jfr_thread_local->set_java_buffer(buffer);
+  }
+  return buffer;
+}
+
+// A thread local buffer is sized to how often its thread fills it. It doubles, up to
+// thread_local_max_buffer_size, when the thread fills it again within the hot interval,
+// and halves, down to the regular thread buffer size, when the thread took longer
+// than the idle interval to fill it. Larger buffers for high-rate threads mean fewer
+// promotions into the global buffers, while threads writing rarely give the memory back.
+static size_t adapt_thread_local_size(BufferPtr cur, bool native, Thread* t) {
+  JfrThreadLocal* const tl = t->jfr_thread_local();
+  const jlong now = os::javaTimeNanos();
+  const jlong last = tl->buffer_flush_time(native);
+  tl->set_buffer_flush_time(native, now);
+  const size_t size = cur->size();
+  if (last == 0) {
+    return size;
+  }
+  const jlong interval = now - last;
+  if (interval < hot_thread_flush_interval_nanos && size * 2 <= thread_local_max_buffer_size) {
+    return size * 2;
+  }
+  if (interval > idle_thread_flush_interval_nanos && size > (size_t)JfrOptionSet::thread_buffer_size()) {
+    return size / 2;
+  }
+  return size;
+}
+
+BufferPtr JfrStorage::flush_regular(BufferPtr cur, const u1* cur_pos, size_t used, size_t req, bool native, Thread* t) {
   debug_only(assert_flush_regular_precondition(cur, cur_pos, used, req, t);)
   // A flush is needed before memcpy since a non-large buffer is thread stable
   // (thread local). The flush will not modify memory in addresses above pos()
@@ -498,6 +552,22 @@ BufferPtr JfrStorage::flush_regular(BufferPtr cur, const u1* const cur_pos, size
     flush_regular_buffer(cur, t);
   }
   assert(t->jfr_thread_local()->shelved_buffer() == NULL, "invariant");
+  const size_t adapted_size = adapt_thread_local_size(cur, native, t);
+  if (adapted_size != cur->size()) {
+    BufferPtr const resized = acquire_thread_local(t, adapted_size);
+    if (resized != NULL) {
+      if (used > 0) {
+        memcpy(resized->pos(), (void*)cur_pos, used);
+      }
+      release_thread_local(cur, t);
+      // don't use current anymore, it is retired
+      cur = store_buffer_to_thread_local(resized, t->jfr_thread_local(), native);
+      cur_pos = cur->pos();
+      if (cur->free_size() >= req) {
+        return cur;
+      }
+    }
+  }
   if (cur->free_size() >= req) {
     // simplest case, no switching of buffers
     if (used > 0) {
@@ -512,16 +582,6 @@ BufferPtr JfrStorage::flush_regular(BufferPtr cur, const u1* const cur_pos, size
   return provision_large(cur, cur_pos, used, req, native, t);
 }
 
-static BufferPtr store_buffer_to_thread_local(BufferPtr buffer, JfrThreadLocal* jfr_thread_local, bool native) {
-  assert(buffer != NULL, "invariant");
-  if (native) {
-    jfr_thread_local->set_native_buffer(buffer);
-  } else {
-    jfr_thread_local->set_java_buffer(buffer);
-  }
-  return buffer;
-}
-
 static BufferPtr restore_shelved_buffer(bool native, Thread* t) {
   JfrThreadLocal* const tl = t->jfr_thread_local();
   BufferPtr shelved = tl->shelved_buffer();
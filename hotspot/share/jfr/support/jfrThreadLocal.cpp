@@ -52,6 +52,9 @@ JfrThreadLocal::JfrThreadLocal() :
   _user_time(0),
   _cpu_time(0),
   _wallclock_time(os::javaTimeNanos()),
+  _native_buffer_flush_time(0),
+  _java_buffer_flush_time(0),
+  _sampled_cpu_time(0),
   _stack_trace_hash(0),
   _stackdepth(0),
   _entering_suspend_flag(0),
@@ -47,6 +47,9 @@ class JfrThreadLocal {
   jlong _user_time;
   jlong _cpu_time;
   jlong _wallclock_time;
+  jlong _native_buffer_flush_time;
+  jlong _java_buffer_flush_time;
+  jlong _sampled_cpu_time;
   unsigned int _stack_trace_hash;
   mutable u4 _stackdepth;
   volatile jint _entering_suspend_flag;
@@ -93,6 +96,19 @@ class JfrThreadLocal {
     _shelved_buffer = buffer;
   }
 
+  // time of the last flush of the native or java buffer, used for adapting its size
+  jlong buffer_flush_time(bool native) const {
+    return native ? _native_buffer_flush_time : _java_buffer_flush_time;
+  }
+
+  void set_buffer_flush_time(bool native, jlong time) {
+    if (native) {
+      _native_buffer_flush_time = time;
+    } else {
+      _java_buffer_flush_time = time;
+    }
+  }
+
   bool has_java_event_writer() const {
     return _java_event_writer != NULL;
   }
@@ -191,6 +207,15 @@ class JfrThreadLocal {
     _wallclock_time = wallclock_time;
   }
 
+  // cpu time of the thread when the thread sampler last sampled it
+  jlong sampled_cpu_time() const {
+    return _sampled_cpu_time;
+  }
+
+  void set_sampled_cpu_time(jlong cpu_time) {
+    _sampled_cpu_time = cpu_time;
+  }
+
   traceid trace_id() const {
     return _trace_id;
   }
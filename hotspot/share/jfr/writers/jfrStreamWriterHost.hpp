@@ -52,6 +52,7 @@ class StreamWriterHost : public MemoryWriterHost<Adapter, AP> {
   void flush();
   void write_unbuffered(const void* src, size_t len);
   bool is_valid() const;
+  void drop_cache();
   void close_fd();
   void reset(fio_fd fd);
 };
@@ -26,7 +26,7 @@
 #define SHARE_JFR_WRITERS_JFRSTREAMWRITERHOST_INLINE_HPP
 
 #include "jfr/writers/jfrStreamWriterHost.hpp"
-#include "runtime/os.hpp"
+#include "runtime/os.inline.hpp"
 
 template <typename Adapter, typename AP>
 StreamWriterHost<Adapter, AP>::StreamWriterHost(typename Adapter::StorageType* storage, Thread* thread) :
@@ -121,6 +121,16 @@ inline bool StreamWriterHost<Adapter, AP>::is_valid() const {
   return has_valid_fd();
 }
 
+// Writes back what has been written so far and drops it from the file system cache.
+template <typename Adapter, typename AP>
+void StreamWriterHost<Adapter, AP>::drop_cache() {
+  this->flush();
+  assert(this->has_valid_fd(), "invariant");
+  // only pages that have been written back can be dropped
+  os::fsync(_fd);
+  os::drop_file_cache(_fd, 0, 0);
+}
+
 template <typename Adapter, typename AP>
 inline void StreamWriterHost<Adapter, AP>::close_fd() {
   assert(this->has_valid_fd(), "closing invalid fd!");
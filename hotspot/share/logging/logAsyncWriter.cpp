@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+#include "precompiled.hpp"
+#include "jvm.h"
+#include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
+#include "logging/logConfiguration.hpp"
+#include "logging/logFileStreamOutput.hpp"
+#include "memory/allocation.inline.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
+
+LogAsyncBuffer::LogAsyncBuffer(LogFileStreamOutput* output, size_t capacity) :
+  _output(output),
+  _capacity(capacity),
+  _active(0),
+  _dropped(0),
+  _flush_lock(1),
+  _next(NULL) {
+  for (int i = 0; i < 2; i++) {
+    _segments[i]._data = NEW_C_HEAP_ARRAY(char, capacity, mtLogging);
+    _segments[i]._top = 0;
+    _segments[i]._writers = 0;
+  }
+}
+
+LogAsyncBuffer::~LogAsyncBuffer() {
+  for (int i = 0; i < 2; i++) {
+    assert(_segments[i]._writers == 0, "must not be in use");
+    FREE_C_HEAP_ARRAY(char, _segments[i]._data);
+  }
+}
+
+int LogAsyncBuffer::reserve(size_t size, char** dest) {
+  // Each message is prefixed by its length.
+  const size_t needed = sizeof(size_t) + size;
+
+  while (true) {
+    int idx = OrderAccess::load_acquire(&_active);
+    Segment* seg = &_segments[idx];
+
+    // Announce the append before checking that the segment is still the
+    // active one; the writer flips _active before checking _writers. So
+    // either we see the flip, or the writer waits for us.
+    Atomic::inc(&seg->_writers);
+    if (OrderAccess::load_acquire(&_active) != idx) {
+      Atomic::dec(&seg->_writers);
+      continue;
+    }
+
+    size_t top = seg->_top;
+    while (true) {
+      if (needed > _capacity - top) {
+        Atomic::dec(&seg->_writers);
+        Atomic::inc(&_dropped);
+        return -1;
+      }
+      size_t prev = Atomic::cmpxchg(top + needed, &seg->_top, top);
+      if (prev == top) {
+        break;
+      }
+      top = prev;
+    }
+
+    char* record = seg->_data + top;
+    memcpy(record, &size, sizeof(size_t));
+    *dest = record + sizeof(size_t);
+
+    if (top < _capacity / 2 && top + needed >= _capacity / 2) {
+      // Crossed the half way mark, make room before messages get dropped.
+      LogAsyncWriter::notify();
+    }
+    return idx;
+  }
+}
+
+void LogAsyncBuffer::commit(int segment) {
+  assert(segment == 0 || segment == 1, "invalid segment %d", segment);
+  // Publishes the message contents to the writer.
+  Atomic::dec(&_segments[segment]._writers);
+}
+
+void LogAsyncBuffer::flush_locked() {
+  int idx = _active;
+  Segment* seg = &_segments[idx];
+  OrderAccess::release_store_fence(&_active, 1 - idx);
+
+  // Appends that reserved space in the retired segment only have a
+  // memcpy left to do.
+  while (OrderAccess::load_acquire(&seg->_writers) != 0) {
+    os::naked_yield();
+  }
+
+  size_t top = seg->_top;
+  size_t pos = 0;
+  while (pos < top) {
+    size_t len;
+    memcpy(&len, seg->_data + pos, sizeof(size_t));
+    pos += sizeof(size_t);
+    _output->write_buffered(seg->_data + pos, len);
+    pos += len;
+  }
+  OrderAccess::release_store(&seg->_top, (size_t)0);
+
+  size_t dropped = Atomic::xchg((size_t)0, &_dropped);
+  if (dropped > 0) {
+    char msg[128];
+    int len = jio_snprintf(msg, sizeof(msg),
+                           "[" SIZE_FORMAT " log messages dropped due to a full asynchronous log buffer]\n",
+                           dropped);
+    if (len > 0) {
+      _output->write_buffered(msg, (size_t)len);
+    }
+  }
+
+  if (top > 0 || dropped > 0) {
+    _output->flush_buffered();
+  }
+}
+
+void LogAsyncBuffer::flush() {
+  _flush_lock.wait();
+  flush_locked();
+  _flush_lock.signal();
+}
+
+void LogAsyncBuffer::try_flush() {
+  if (_flush_lock.trywait()) {
+    flush_locked();
+    _flush_lock.signal();
+  }
+}
+
+LogAsyncWriter*  LogAsyncWriter::_instance = NULL;
+volatile bool    LogAsyncWriter::_active = false;
+LogAsyncBuffer*  LogAsyncWriter::_buffers = NULL;
+Semaphore        LogAsyncWriter::_buffers_lock(1);
+
+LogAsyncWriter::LogAsyncWriter() : NamedThread() {
+  set_name("Async Log Writer");
+}
+
+void LogAsyncWriter::initialize() {
+  if (!AsyncLogging) {
+    return;
+  }
+  assert(_instance == NULL, "initialize only once");
+
+  LogAsyncWriter* writer = new LogAsyncWriter();
+  if (!os::create_thread(writer, os::asynclog_thread)) {
+    delete writer;
+    log_warning(logging)("Unable to create the asynchronous log writer thread, logging synchronously.");
+    return;
+  }
+  _instance = writer;
+  os::start_thread(writer);
+
+  OrderAccess::release_store(&_active, true);
+  LogConfiguration::enable_async_writing();
+}
+
+bool LogAsyncWriter::is_active() {
+  return OrderAccess::load_acquire(&_active);
+}
+
+void LogAsyncWriter::register_buffer(LogAsyncBuffer* buffer) {
+  _buffers_lock.wait();
+  buffer->_next = _buffers;
+  _buffers = buffer;
+  _buffers_lock.signal();
+}
+
+void LogAsyncWriter::unregister_buffer(LogAsyncBuffer* buffer) {
+  _buffers_lock.wait();
+  LogAsyncBuffer** link = &_buffers;
+  while (*link != NULL && *link != buffer) {
+    link = &(*link)->_next;
+  }
+  if (*link == buffer) {
+    *link = buffer->_next;
+    buffer->_next = NULL;
+  }
+  _buffers_lock.signal();
+}
+
+void LogAsyncWriter::notify() {
+  LogAsyncWriter* writer = _instance;
+  if (writer != NULL) {
+    writer->_ParkEvent->unpark();
+  }
+}
+
+void LogAsyncWriter::flush_all(bool on_error) {
+  if (on_error) {
+    // The crashing thread may be the writer itself, or may have been
+    // interrupted holding the lock. Skip rather than hang.
+    if (!_buffers_lock.trywait()) {
+      return;
+    }
+  } else {
+    _buffers_lock.wait();
+  }
+  for (LogAsyncBuffer* buffer = _buffers; buffer != NULL; buffer = buffer->_next) {
+    if (on_error) {
+      buffer->try_flush();
+    } else {
+      buffer->flush();
+    }
+  }
+  _buffers_lock.signal();
+}
+
+void LogAsyncWriter::run() {
+  while (true) {
+    if (!is_active()) {
+      // Logging is synchronous again; nothing left to do for this thread.
+      _ParkEvent->park();
+      continue;
+    }
+    _ParkEvent->park(AsyncLogFlushInterval);
+    flush_all(false /* on_error */);
+  }
+}
+
+void LogAsyncWriter::stop() {
+  if (!is_active()) {
+    return;
+  }
+  // Log outputs write synchronously from here on; whatever has been
+  // buffered so far is written out below, after in-flight appends finish.
+  OrderAccess::release_store_fence(&_active, false);
+  flush_all(false /* on_error */);
+}
+
+void LogAsyncWriter::stop_on_error() {
+  if (!is_active()) {
+    return;
+  }
+  OrderAccess::release_store_fence(&_active, false);
+  flush_all(true /* on_error */);
+}
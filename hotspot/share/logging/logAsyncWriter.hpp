@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+#ifndef SHARE_LOGGING_LOGASYNCWRITER_HPP
+#define SHARE_LOGGING_LOGASYNCWRITER_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/semaphore.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class LogFileStreamOutput;
+
+// Bounded buffer of already formatted log messages for a single log output,
+// written out to the output by the LogAsyncWriter (AsyncLogging).
+//
+// The buffer consists of two segments. Logging threads append to the active
+// segment by atomically bumping its top, so they never block. The writer
+// flips the active segment, waits for appends to the retired segment that
+// are still in progress, and writes that segment out. Messages that do not
+// fit into the active segment are dropped and counted; the count is written
+// to the output with the next flush.
+class LogAsyncBuffer : public CHeapObj<mtLogging> {
+  friend class LogAsyncWriter;
+
+ private:
+  struct Segment {
+    char*           _data;
+    volatile size_t _top;     // Bytes reserved so far.
+    volatile int    _writers; // Appends in progress.
+  };
+
+  LogFileStreamOutput* const _output;
+  const size_t _capacity;
+  Segment _segments[2];
+  volatile int _active;
+  volatile size_t _dropped;
+
+  // Serializes flushes by the writer thread with the final flushes at
+  // exit and on error.
+  Semaphore _flush_lock;
+
+  // Link in the list of buffers known to the LogAsyncWriter.
+  LogAsyncBuffer* _next;
+
+  void flush_locked();
+
+ public:
+  LogAsyncBuffer(LogFileStreamOutput* output, size_t capacity);
+  ~LogAsyncBuffer();
+
+  // Reserves size bytes for a message and returns the segment it has been
+  // reserved in, storing the destination address in *dest. Returns -1 if
+  // the message does not fit, in which case it has been counted as dropped.
+  // A successful reservation must be completed with commit().
+  int reserve(size_t size, char** dest);
+  void commit(int segment);
+
+  // Writes all messages buffered so far to the output.
+  void flush();
+  // Same as flush(), unless a flush is already in progress. Used during
+  // error reporting, where the writer thread itself may have crashed.
+  void try_flush();
+};
+
+// The dedicated thread that writes out the buffered messages of all
+// outputs, keeping file I/O out of the VM thread, GC workers and
+// application threads. It wakes up when a buffer fills up past half
+// of its capacity, and at least every AsyncLogFlushInterval ms.
+class LogAsyncWriter : public NamedThread {
+ private:
+  static LogAsyncWriter* _instance;
+  static volatile bool _active;
+
+  // Buffers to write out, protected by _buffers_lock.
+  static LogAsyncBuffer* _buffers;
+  static Semaphore _buffers_lock;
+
+  LogAsyncWriter();
+
+  static void flush_all(bool on_error);
+
+ protected:
+  virtual void run();
+
+ public:
+  // Starts the writer thread and switches all log outputs to buffered
+  // writes, if AsyncLogging is enabled.
+  static void initialize();
+
+  // True while log outputs should buffer their messages.
+  static bool is_active();
+
+  static void register_buffer(LogAsyncBuffer* buffer);
+  // Waits until the writer no longer accesses the buffer.
+  static void unregister_buffer(LogAsyncBuffer* buffer);
+
+  // Asks the writer to flush soon, without blocking.
+  static void notify();
+
+  // Writes out all buffered messages and switches log outputs back to
+  // synchronous writes. Called at VM exit.
+  static void stop();
+  // Best effort version of stop() for use during error reporting.
+  static void stop_on_error();
+};
+
+#endif // SHARE_LOGGING_LOGASYNCWRITER_HPP
@@ -24,6 +24,7 @@
 #include "precompiled.hpp"
 #include "jvm.h"
 #include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logConfiguration.hpp"
 #include "logging/logDecorations.hpp"
 #include "logging/logDecorators.hpp"
@@ -111,6 +112,8 @@ void LogConfiguration::initialize(jlong vm_start_time) {
 }
 
 void LogConfiguration::finalize() {
+  // Write out pending asynchronous messages before the outputs go away.
+  LogAsyncWriter::stop();
   for (size_t i = _n_outputs; i > 0; i--) {
     disable_output(i - 1);
   }
@@ -199,6 +202,9 @@ size_t LogConfiguration::add_output(LogOutput* output) {
   size_t idx = _n_outputs++;
   _outputs = REALLOC_C_HEAP_ARRAY(LogOutput*, _outputs, _n_outputs, mtLogging);
   _outputs[idx] = output;
+  if (LogAsyncWriter::is_active()) {
+    output->enable_async_writing();
+  }
   return idx;
 }
 
@@ -588,6 +594,13 @@ void LogConfiguration::rotate_all_outputs() {
   }
 }
 
+void LogConfiguration::enable_async_writing() {
+  ConfigurationLock cl;
+  for (size_t idx = 0; idx < _n_outputs; idx++) {
+    _outputs[idx]->enable_async_writing();
+  }
+}
+
 void LogConfiguration::register_update_listener(UpdateListenerFunction cb) {
   assert(cb != NULL, "Should not register NULL as listener");
   ConfigurationLock cl;
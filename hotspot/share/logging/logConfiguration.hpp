@@ -123,6 +123,9 @@ class LogConfiguration : public AllStatic {
 
   // Rotates all LogOutput
   static void rotate_all_outputs();
+
+  // Switches all LogOutputs to buffered writes by the LogAsyncWriter.
+  static void enable_async_writing();
 };
 
 #endif // SHARE_LOGGING_LOGCONFIGURATION_HPP
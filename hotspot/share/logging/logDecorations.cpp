@@ -33,8 +33,11 @@ jlong LogDecorations::_vm_start_time_millis = 0;
 const char* LogDecorations::_host_name = "";
 
 LogDecorations::LogDecorations(LogLevelType level, const LogTagSet &tagset, const LogDecorators &decorators)
-    : _level(level), _tagset(tagset), _millis(-1) {
-  create_decorations(decorators);
+    : _position(_decorations_buffer), _level(level), _tagset(tagset), _millis(-1), _nanos(-1), _elapsed_counter(-1) {
+  for (uint i = 0; i < LogDecorators::Count; i++) {
+    _decoration_offset[i] = NULL;
+  }
+  sample_clocks(decorators);
 }
 
 void LogDecorations::initialize(jlong vm_start_time) {
@@ -45,89 +48,136 @@ void LogDecorations::initialize(jlong vm_start_time) {
   _vm_start_time_millis = vm_start_time;
 }
 
-void LogDecorations::create_decorations(const LogDecorators &decorators) {
-  char* position = _decorations_buffer;
-  #define DECORATOR(full_name, abbr) \
-  if (decorators.is_decorator(LogDecorators::full_name##_decorator)) { \
-    _decoration_offset[LogDecorators::full_name##_decorator] = position; \
-    position = create_##full_name##_decoration(position) + 1; \
+// Read each clock at most once, and at the time of the log call, even if
+// the decorations are formatted later.
+void LogDecorations::sample_clocks(const LogDecorators& decorators) {
+  if (decorators.is_decorator(LogDecorators::time_decorator) ||
+      decorators.is_decorator(LogDecorators::utctime_decorator) ||
+      decorators.is_decorator(LogDecorators::timemillis_decorator) ||
+      decorators.is_decorator(LogDecorators::uptimemillis_decorator)) {
+    _millis = os::javaTimeMillis();
+  }
+  if (decorators.is_decorator(LogDecorators::timenanos_decorator)) {
+    _nanos = os::javaTimeNanos();
+  }
+  if (decorators.is_decorator(LogDecorators::uptime_decorator) ||
+      decorators.is_decorator(LogDecorators::uptimenanos_decorator)) {
+    _elapsed_counter = os::elapsed_counter();
   }
-  DECORATOR_LIST
-#undef DECORATOR
 }
 
-jlong LogDecorations::java_millis() {
-  if (_millis < 0) {
-    _millis = os::javaTimeMillis();
+void LogDecorations::create_decoration(LogDecorators::Decorator decorator) const {
+  char* position = _position;
+  switch (decorator) {
+#define DECORATOR(full_name, abbr) \
+  case LogDecorators::full_name##_decorator: \
+    _position = create_##full_name##_decoration(position) + 1; \
+    break;
+  DECORATOR_LIST
+#undef DECORATOR
+  default:
+    ShouldNotReachHere();
   }
-  return _millis;
+  _decoration_offset[decorator] = position;
 }
 
 #define ASSERT_AND_RETURN(written, pos) \
     assert(written >= 0, "Decorations buffer overflow"); \
     return pos + written;
 
-char* LogDecorations::create_time_decoration(char* pos) {
-  char* buf = os::iso8601_time(pos, 29);
-  int written = buf == NULL ? -1 : 29;
+static const size_t TimeDecorationSize = 29;
+
+// Formatting the time stamp requires a time zone conversion. Keep the last
+// time stamp per thread, so consecutive log lines within the same second
+// only need to patch in the milliseconds.
+static char* format_time_decoration(jlong millis, char* pos, bool utc) {
+#ifndef USE_LIBRARY_BASED_TLS_ONLY
+  static THREAD_LOCAL_DECL jlong cached_seconds[2] = { -1, -1 };
+  static THREAD_LOCAL_DECL char cached_time[2][TimeDecorationSize];
+
+  const int index = utc ? 1 : 0;
+  const jlong seconds = millis / 1000;
+  if (cached_seconds[index] != seconds) {
+    if (os::iso8601_time(millis, cached_time[index], TimeDecorationSize, utc) == NULL) {
+      return NULL;
+    }
+    cached_seconds[index] = seconds;
+  }
+
+  // "YYYY-MM-DDThh:mm:ss.mmm+zzzz", the milliseconds start at offset 20
+  const int millis_after_second = (int)(millis % 1000);
+  memcpy(pos, cached_time[index], TimeDecorationSize);
+  pos[20] = '0' + millis_after_second / 100;
+  pos[21] = '0' + (millis_after_second / 10) % 10;
+  pos[22] = '0' + millis_after_second % 10;
+  return pos;
+#else
+  return os::iso8601_time(millis, pos, TimeDecorationSize, utc);
+#endif
+}
+
+char* LogDecorations::create_time_decoration(char* pos) const {
+  char* buf = format_time_decoration(_millis, pos, false);
+  int written = buf == NULL ? -1 : (int)TimeDecorationSize;
   ASSERT_AND_RETURN(written, pos)
 }
 
-char* LogDecorations::create_utctime_decoration(char* pos) {
-  char* buf = os::iso8601_time(pos, 29, true);
-  int written = buf == NULL ? -1 : 29;
+char* LogDecorations::create_utctime_decoration(char* pos) const {
+  char* buf = format_time_decoration(_millis, pos, true);
+  int written = buf == NULL ? -1 : (int)TimeDecorationSize;
   ASSERT_AND_RETURN(written, pos)
 }
 
-char * LogDecorations::create_uptime_decoration(char* pos) {
-  int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer), "%.3fs", os::elapsedTime());
+char * LogDecorations::create_uptime_decoration(char* pos) const {
+  int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer), "%.3fs",
+                             (double)_elapsed_counter / os::elapsed_frequency());
   ASSERT_AND_RETURN(written, pos)
 }
 
-char * LogDecorations::create_timemillis_decoration(char* pos) {
-  int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer), INT64_FORMAT "ms", java_millis());
+char * LogDecorations::create_timemillis_decoration(char* pos) const {
+  int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer), INT64_FORMAT "ms", _millis);
   ASSERT_AND_RETURN(written, pos)
 }
 
-char * LogDecorations::create_uptimemillis_decoration(char* pos) {
+char * LogDecorations::create_uptimemillis_decoration(char* pos) const {
   int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer),
-                             INT64_FORMAT "ms", java_millis() - _vm_start_time_millis);
+                             INT64_FORMAT "ms", _millis - _vm_start_time_millis);
   ASSERT_AND_RETURN(written, pos)
 }
 
-char * LogDecorations::create_timenanos_decoration(char* pos) {
-  int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer), INT64_FORMAT "ns", os::javaTimeNanos());
+char * LogDecorations::create_timenanos_decoration(char* pos) const {
+  int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer), INT64_FORMAT "ns", _nanos);
   ASSERT_AND_RETURN(written, pos)
 }
 
-char * LogDecorations::create_uptimenanos_decoration(char* pos) {
-  int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer), INT64_FORMAT "ns", os::elapsed_counter());
+char * LogDecorations::create_uptimenanos_decoration(char* pos) const {
+  int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer), INT64_FORMAT "ns", _elapsed_counter);
   ASSERT_AND_RETURN(written, pos)
 }
 
-char * LogDecorations::create_pid_decoration(char* pos) {
+char * LogDecorations::create_pid_decoration(char* pos) const {
   int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer), "%d", os::current_process_id());
   ASSERT_AND_RETURN(written, pos)
 }
 
-char * LogDecorations::create_tid_decoration(char* pos) {
+char * LogDecorations::create_tid_decoration(char* pos) const {
   int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer),
                              INTX_FORMAT, os::current_thread_id());
   ASSERT_AND_RETURN(written, pos)
 }
 
-char* LogDecorations::create_level_decoration(char* pos) {
+char* LogDecorations::create_level_decoration(char* pos) const {
   // Avoid generating the level decoration because it may change.
   // The decoration() method has a special case for level decorations.
   return pos;
 }
 
-char* LogDecorations::create_tags_decoration(char* pos) {
+char* LogDecorations::create_tags_decoration(char* pos) const {
   int written = _tagset.label(pos, DecorationsBufferSize - (pos - _decorations_buffer));
   ASSERT_AND_RETURN(written, pos)
 }
 
-char* LogDecorations::create_hostname_decoration(char* pos) {
+char* LogDecorations::create_hostname_decoration(char* pos) const {
   int written = jio_snprintf(pos, DecorationsBufferSize - (pos - _decorations_buffer), "%s", _host_name);
   ASSERT_AND_RETURN(written, pos)
 }
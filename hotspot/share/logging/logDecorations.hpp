@@ -28,22 +28,27 @@
 #include "logging/logTagSet.hpp"
 
 // Temporary object containing the necessary data for a log call's decorations (timestamps, etc).
+// The clocks are sampled when the object is created, but each decoration is only
+// formatted the first time an output asks for it.
 class LogDecorations {
  public:
   static const int DecorationsBufferSize = 256;
  private:
-  char _decorations_buffer[DecorationsBufferSize];
-  char* _decoration_offset[LogDecorators::Count];
+  mutable char _decorations_buffer[DecorationsBufferSize];
+  mutable char* _decoration_offset[LogDecorators::Count];
+  mutable char* _position;
   LogLevelType _level;
   const LogTagSet& _tagset;
   jlong _millis;
+  jlong _nanos;
+  jlong _elapsed_counter;
   static jlong _vm_start_time_millis;
   static const char* _host_name;
 
-  jlong java_millis();
-  void create_decorations(const LogDecorators& decorators);
+  void sample_clocks(const LogDecorators& decorators);
+  void create_decoration(LogDecorators::Decorator decorator) const;
 
-#define DECORATOR(name, abbr) char* create_##name##_decoration(char* pos);
+#define DECORATOR(name, abbr) char* create_##name##_decoration(char* pos) const;
   DECORATOR_LIST
 #undef DECORATOR
 
@@ -60,6 +65,9 @@ class LogDecorations {
     if (decorator == LogDecorators::level_decorator) {
       return LogLevel::name(_level);
     }
+    if (_decoration_offset[decorator] == NULL) {
+      create_decoration(decorator);
+    }
     return _decoration_offset[decorator];
   }
 };
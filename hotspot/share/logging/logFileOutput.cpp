@@ -71,6 +71,7 @@ void LogFileOutput::set_file_name_parameters(jlong vm_start_time) {
 }
 
 LogFileOutput::~LogFileOutput() {
+  detach_async_buffer();
   if (_stream != NULL) {
     if (fclose(_stream) != 0) {
       jio_fprintf(defaultStream::error_stream(), "Could not close log file '%s' (%s).\n",
@@ -290,6 +291,12 @@ int LogFileOutput::write(const LogDecorations& decorations, const char* msg) {
     return 0;
   }
 
+  LogAsyncBuffer* buffer = async_buffer();
+  if (buffer != NULL) {
+    // Size accounting and rotation are done by write_buffered().
+    return write_async(buffer, decorations, msg);
+  }
+
   _rotation_semaphore.wait();
   int written = LogFileStreamOutput::write(decorations, msg);
   _current_size += written;
@@ -308,6 +315,12 @@ int LogFileOutput::write(LogMessageBuffer::Iterator msg_iterator) {
     return 0;
   }
 
+  LogAsyncBuffer* buffer = async_buffer();
+  if (buffer != NULL) {
+    // Size accounting and rotation are done by write_buffered().
+    return write_async(buffer, msg_iterator);
+  }
+
   _rotation_semaphore.wait();
   int written = LogFileStreamOutput::write(msg_iterator);
   _current_size += written;
@@ -337,6 +350,27 @@ void LogFileOutput::archive() {
   }
 }
 
+void LogFileOutput::write_buffered(const char* data, size_t len) {
+  _rotation_semaphore.wait();
+  if (_stream != NULL) {
+    LogFileStreamOutput::write_buffered(data, len);
+    _current_size += len;
+    if (should_rotate()) {
+      fflush(_stream);
+      rotate();
+    }
+  }
+  _rotation_semaphore.signal();
+}
+
+void LogFileOutput::flush_buffered() {
+  _rotation_semaphore.wait();
+  if (_stream != NULL) {
+    fflush(_stream);
+  }
+  _rotation_semaphore.signal();
+}
+
 void LogFileOutput::force_rotate() {
   if (_file_count == 0) {
     // Rotation not possible
@@ -85,6 +85,8 @@ class LogFileOutput : public LogFileStreamOutput {
   virtual bool initialize(const char* options, outputStream* errstream);
   virtual int write(const LogDecorations& decorations, const char* msg);
   virtual int write(LogMessageBuffer::Iterator msg_iterator);
+  virtual void write_buffered(const char* data, size_t len);
+  virtual void flush_buffered();
   virtual void force_rotate();
   virtual void describe(outputStream* out);
 
@@ -23,11 +23,14 @@
  */
 #include "precompiled.hpp"
 #include "jvm.h"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logDecorators.hpp"
 #include "logging/logDecorations.hpp"
 #include "logging/logFileStreamOutput.hpp"
 #include "logging/logMessageBuffer.hpp"
 #include "memory/allocation.inline.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/orderAccess.hpp"
 
 static bool initialized;
 static union {
@@ -73,6 +76,11 @@ int LogFileStreamOutput::write_decorations(const LogDecorations& decorations) {
 }
 
 int LogFileStreamOutput::write(const LogDecorations& decorations, const char* msg) {
+  LogAsyncBuffer* buffer = async_buffer();
+  if (buffer != NULL) {
+    return write_async(buffer, decorations, msg);
+  }
+
   const bool use_decorations = !_decorators.is_empty();
 
   int written = 0;
@@ -89,6 +97,11 @@ int LogFileStreamOutput::write(const LogDecorations& decorations, const char* ms
 }
 
 int LogFileStreamOutput::write(LogMessageBuffer::Iterator msg_iterator) {
+  LogAsyncBuffer* buffer = async_buffer();
+  if (buffer != NULL) {
+    return write_async(buffer, msg_iterator);
+  }
+
   const bool use_decorations = !_decorators.is_empty();
 
   int written = 0;
@@ -105,3 +118,151 @@ int LogFileStreamOutput::write(LogMessageBuffer::Iterator msg_iterator) {
 
   return written;
 }
+
+LogFileStreamOutput::~LogFileStreamOutput() {
+  detach_async_buffer();
+}
+
+size_t LogFileStreamOutput::format_decorations(char* dest,
+                                               const LogDecorations& decorations,
+                                               size_t* padding) const {
+  if (_decorators.is_empty()) {
+    return 0;
+  }
+
+  size_t total = 0;
+  for (uint i = 0; i < LogDecorators::Count; i++) {
+    LogDecorators::Decorator decorator = static_cast<LogDecorators::Decorator>(i);
+    if (!_decorators.is_decorator(decorator)) {
+      continue;
+    }
+
+    const char* decoration = decorations.decoration(decorator);
+    size_t len = strlen(decoration);
+    size_t width = MAX2(len, padding[decorator]);
+    padding[decorator] = width;
+    if (dest != NULL) {
+      char* pos = dest + total;
+      pos[0] = '[';
+      memcpy(pos + 1, decoration, len);
+      memset(pos + 1 + len, ' ', width - len);
+      pos[width + 1] = ']';
+    }
+    total += width + 2;
+  }
+  if (dest != NULL) {
+    dest[total] = ' ';
+  }
+  return total + 1;
+}
+
+void LogFileStreamOutput::update_decorator_padding(const size_t* padding) {
+  // Racy with concurrent async writes, which only affects column alignment.
+  for (uint i = 0; i < LogDecorators::Count; i++) {
+    if (padding[i] > _decorator_padding[i]) {
+      _decorator_padding[i] = padding[i];
+    }
+  }
+}
+
+LogAsyncBuffer* LogFileStreamOutput::async_buffer() const {
+  LogAsyncBuffer* buffer = OrderAccess::load_acquire(&_async_buffer);
+  if (buffer != NULL && LogAsyncWriter::is_active()) {
+    return buffer;
+  }
+  return NULL;
+}
+
+void LogFileStreamOutput::enable_async_writing() {
+  if (_async_buffer != NULL) {
+    return;
+  }
+  LogAsyncBuffer* buffer = new LogAsyncBuffer(this, AsyncLogBufferSize / 2);
+  LogAsyncWriter::register_buffer(buffer);
+  OrderAccess::release_store(&_async_buffer, buffer);
+}
+
+void LogFileStreamOutput::detach_async_buffer() {
+  LogAsyncBuffer* buffer = _async_buffer;
+  if (buffer == NULL) {
+    return;
+  }
+  // The output is no longer used by any tagset, so no new messages arrive.
+  LogAsyncWriter::unregister_buffer(buffer);
+  buffer->flush();
+  _async_buffer = NULL;
+  delete buffer;
+}
+
+int LogFileStreamOutput::write_async(LogAsyncBuffer* buffer,
+                                     const LogDecorations& decorations,
+                                     const char* msg) {
+  // Both formatting passes must see the same padding to agree on the length.
+  size_t initial_padding[LogDecorators::Count];
+  size_t padding[LogDecorators::Count];
+  memcpy(initial_padding, _decorator_padding, sizeof(initial_padding));
+  memcpy(padding, initial_padding, sizeof(padding));
+
+  size_t msg_len = strlen(msg);
+  size_t len = format_decorations(NULL, decorations, padding) + msg_len + 1;
+
+  char* dest;
+  int segment = buffer->reserve(len, &dest);
+  if (segment < 0) {
+    return 0;
+  }
+  size_t pos = format_decorations(dest, decorations, initial_padding);
+  memcpy(dest + pos, msg, msg_len);
+  dest[pos + msg_len] = '\n';
+  buffer->commit(segment);
+
+  update_decorator_padding(initial_padding);
+  return (int)len;
+}
+
+int LogFileStreamOutput::write_async(LogAsyncBuffer* buffer,
+                                     LogMessageBuffer::Iterator msg_iterator) {
+  // All lines of the message are appended as one, so that they are not
+  // interleaved with other messages.
+  size_t initial_padding[LogDecorators::Count];
+  size_t padding[LogDecorators::Count];
+  memcpy(initial_padding, _decorator_padding, sizeof(initial_padding));
+  memcpy(padding, initial_padding, sizeof(padding));
+
+  size_t len = 0;
+  for (LogMessageBuffer::Iterator it = msg_iterator; !it.is_at_end(); it++) {
+    len += format_decorations(NULL, it.decorations(), padding) + strlen(it.message()) + 1;
+  }
+  if (len == 0) {
+    return 0;
+  }
+
+  char* dest;
+  int segment = buffer->reserve(len, &dest);
+  if (segment < 0) {
+    return 0;
+  }
+  size_t pos = 0;
+  for (; !msg_iterator.is_at_end(); msg_iterator++) {
+    pos += format_decorations(dest + pos, msg_iterator.decorations(), initial_padding);
+    size_t msg_len = strlen(msg_iterator.message());
+    memcpy(dest + pos, msg_iterator.message(), msg_len);
+    pos += msg_len;
+    dest[pos++] = '\n';
+  }
+  assert(pos == len, "formatted " SIZE_FORMAT " bytes, reserved " SIZE_FORMAT, pos, len);
+  buffer->commit(segment);
+
+  update_decorator_padding(initial_padding);
+  return (int)len;
+}
+
+void LogFileStreamOutput::write_buffered(const char* data, size_t len) {
+  os::flockfile(_stream);
+  fwrite(data, 1, len, _stream);
+  os::funlockfile(_stream);
+}
+
+void LogFileStreamOutput::flush_buffered() {
+  fflush(_stream);
+}
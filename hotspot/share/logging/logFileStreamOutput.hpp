@@ -28,6 +28,7 @@
 #include "logging/logOutput.hpp"
 #include "utilities/globalDefinitions.hpp"
 
+class LogAsyncBuffer;
 class LogDecorations;
 
 class LogFileStreamInitializer {
@@ -44,7 +45,10 @@ class LogFileStreamOutput : public LogOutput {
   FILE*               _stream;
   size_t              _decorator_padding[LogDecorators::Count];
 
-  LogFileStreamOutput(FILE *stream) : _stream(stream) {
+  // Buffer for messages written by the LogAsyncWriter, see AsyncLogging.
+  LogAsyncBuffer* volatile _async_buffer;
+
+  LogFileStreamOutput(FILE *stream) : _stream(stream), _async_buffer(NULL) {
     for (size_t i = 0; i < LogDecorators::Count; i++) {
       _decorator_padding[i] = 0;
     }
@@ -52,9 +56,33 @@ class LogFileStreamOutput : public LogOutput {
 
   int write_decorations(const LogDecorations& decorations);
 
+  // Formats the decorations the same way as write_decorations(), including
+  // the separating space, into dest and returns their length. Only computes
+  // the length if dest is NULL. Uses and updates the given padding.
+  size_t format_decorations(char* dest, const LogDecorations& decorations, size_t* padding) const;
+  void update_decorator_padding(const size_t* padding);
+
+  // Returns the buffer to append messages to, or NULL if messages are
+  // to be written synchronously.
+  LogAsyncBuffer* async_buffer() const;
+  int write_async(LogAsyncBuffer* buffer, const LogDecorations& decorations, const char* msg);
+  int write_async(LogAsyncBuffer* buffer, LogMessageBuffer::Iterator msg_iterator);
+
+  // Writes out and frees the async buffer. Must be called before the stream
+  // is closed.
+  void detach_async_buffer();
+
  public:
+  virtual ~LogFileStreamOutput();
+
   virtual int write(const LogDecorations& decorations, const char* msg);
   virtual int write(LogMessageBuffer::Iterator msg_iterator);
+  virtual void enable_async_writing();
+
+  // Used by the LogAsyncWriter to write out already formatted messages.
+  // write_buffered() leaves flushing the stream to flush_buffered().
+  virtual void write_buffered(const char* data, size_t len);
+  virtual void flush_buffered();
 };
 
 class LogStdoutOutput : public LogFileStreamOutput {
@@ -93,6 +93,11 @@ class LogOutput : public CHeapObj<mtLogging> {
     // Do nothing by default.
   }
 
+  // Switch the output to buffered writes by the LogAsyncWriter, if supported.
+  virtual void enable_async_writing() {
+    // Do nothing by default.
+  }
+
   virtual void describe(outputStream *out);
 
   virtual const char* name() const = 0;
@@ -64,6 +64,7 @@
   LOG_TAG(dcmd) \
   LOG_TAG(decoder) \
   LOG_TAG(defaultmethods) \
+  LOG_TAG(deoptimization) \
   LOG_TAG(director) \
   LOG_TAG(dump) \
   LOG_TAG(dynamic) \
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "logging/log.hpp"
+#include "memory/archiveUtils.hpp"
+#include "memory/virtualspace.hpp"
+#include "utilities/align.hpp"
+#include "utilities/bitMap.inline.hpp"
+
+CHeapBitMap*  ArchivePtrMarker::_ptrmap = NULL;
+VirtualSpace* ArchivePtrMarker::_vs = NULL;
+
+void ArchivePtrMarker::initialize(VirtualSpace* vs) {
+  assert(_ptrmap == NULL, "initialize only once");
+  _vs = vs;
+  _ptrmap = new CHeapBitMap(mtClassShared);
+  expand_ptr_end();
+}
+
+address* ArchivePtrMarker::ptr_base() {
+  return (address*)_vs->low();
+}
+
+address* ArchivePtrMarker::ptr_end() {
+  return (address*)_vs->high();
+}
+
+void ArchivePtrMarker::expand_ptr_end() {
+  if (_ptrmap == NULL) {
+    return;
+  }
+  size_t size_in_bits = pointer_delta(ptr_end(), ptr_base(), sizeof(address));
+  if (size_in_bits > _ptrmap->size()) {
+    _ptrmap->resize(size_in_bits);
+  }
+}
+
+void ArchivePtrMarker::mark_pointer(address* ptr_loc) {
+  if (_ptrmap == NULL) {
+    // Not dumping the static archive; nothing to record.
+    return;
+  }
+  if (ptr_base() <= ptr_loc && ptr_loc < ptr_end()) {
+    assert(is_aligned(ptr_loc, sizeof(address)), "pointers in the archive must be aligned");
+    _ptrmap->set_bit(pointer_delta(ptr_loc, ptr_base(), sizeof(address)));
+  }
+}
+
+class ArchivePtrBitmapCleaner: public BitMapClosure {
+  CHeapBitMap* _ptrmap;
+  address* _ptr_base;
+  address  _relocatable_base;
+  address  _relocatable_end;
+  size_t   _max_non_null_offset;
+
+public:
+  ArchivePtrBitmapCleaner(CHeapBitMap* ptrmap, address* ptr_base, address relocatable_base, address relocatable_end) :
+    _ptrmap(ptrmap), _ptr_base(ptr_base),
+    _relocatable_base(relocatable_base), _relocatable_end(relocatable_end), _max_non_null_offset(0) {}
+
+  bool do_bit(size_t offset) {
+    address value = _ptr_base[offset];
+    if (_relocatable_base <= value && value < _relocatable_end) {
+      _max_non_null_offset = offset;
+    } else {
+      _ptrmap->clear_bit(offset);
+    }
+    return true;
+  }
+
+  size_t max_non_null_offset() const { return _max_non_null_offset; }
+};
+
+void ArchivePtrMarker::compact(address base, address end) {
+  assert(_ptrmap != NULL, "must be initialized");
+  size_t end_offset = pointer_delta(end, ptr_base(), sizeof(address));
+  assert(end_offset <= _ptrmap->size(), "must be committed");
+
+  ArchivePtrBitmapCleaner cleaner(_ptrmap, ptr_base(), base, end);
+  _ptrmap->iterate(&cleaner, 0, end_offset);
+  _ptrmap->resize(cleaner.max_non_null_offset() + 1);
+
+  log_info(cds)("Marked " SIZE_FORMAT " relocatable pointers in " SIZE_FORMAT " words",
+                _ptrmap->count_one_bits(), _ptrmap->size());
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_MEMORY_ARCHIVEUTILS_HPP
+#define SHARE_MEMORY_ARCHIVEUTILS_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/bitMap.hpp"
+
+class VirtualSpace;
+
+// ArchivePtrMarker records, while the static CDS archive is dumped, the
+// locations of all pointers in the archive that point into the archive
+// itself. The resulting bitmap is written into the archive (the bm region),
+// so the archive can still be used if it cannot be mapped at the address it
+// was dumped at: the marked pointers are then relocated after mapping. See
+// FileMapInfo::relocate_pointers().
+//
+// Locations outside of the archive are ignored, so callers may mark any
+// pointer that might end up in the archive.
+class ArchivePtrMarker : AllStatic {
+  static CHeapBitMap*  _ptrmap;
+  static VirtualSpace* _vs;
+
+  static address* ptr_base();
+  static address* ptr_end();
+
+public:
+  // Starts marking pointers in the committed part of vs.
+  static void initialize(VirtualSpace* vs);
+
+  static void mark_pointer(address* ptr_loc);
+
+  template <typename T>
+  static void mark_pointer(T* ptr_loc) {
+    mark_pointer((address*)ptr_loc);
+  }
+
+  // Called after more of the space has been committed.
+  static void expand_ptr_end();
+
+  // Removes the marks of all pointers that do not point into [base, end),
+  // e.g. NULL pointers, and shrinks the bitmap to cover [ptr_base(), end) only.
+  static void compact(address base, address end);
+
+  static CHeapBitMap* ptrmap() {
+    return _ptrmap;
+  }
+};
+
+#endif // SHARE_MEMORY_ARCHIVEUTILS_HPP
@@ -30,6 +30,7 @@
 #include "runtime/atomic.hpp"
 #include "runtime/os.hpp"
 #include "runtime/task.hpp"
+#include "runtime/thread.hpp"
 #include "runtime/threadCritical.hpp"
 #include "services/memTracker.hpp"
 #include "utilities/ostream.hpp"
@@ -42,8 +43,9 @@
 class ChunkPool: public CHeapObj<mtInternal> {
   Chunk*       _first;        // first cached Chunk; its first word points to next chunk
   size_t       _num_chunks;   // number of unused chunks in pool
-  size_t       _num_used;     // number of chunks currently checked out
+  size_t       _num_used;     // number of chunks currently checked out, including thread cached ones
   const size_t _size;         // size of each chunk (must be uniform)
+  const int    _index;        // index of the pool's list in a ThreadChunkCache
 
   // Our four static pools
   static ChunkPool* _large_pool;
@@ -61,19 +63,55 @@ class ChunkPool: public CHeapObj<mtInternal> {
     return c;
   }
 
+  static ThreadChunkCache* current_cache() {
+    Thread* thread = Thread::current_or_null();
+    return thread != NULL ? thread->chunk_cache() : NULL;
+  }
+
+  // Take a batch of chunks from the pool into the thread's cache,
+  // under one ThreadCritical section.
+  void refill(ThreadChunkCache* cache) {
+    assert(cache->_count[_index] == 0, "only refill an empty list");
+    ThreadCritical tc;
+    while (cache->_count[_index] < ThreadChunkCache::batch_size && _first != NULL) {
+      Chunk* c = (Chunk*)get_first();
+      c->set_next(cache->_first[_index]);
+      cache->_first[_index] = c;
+      cache->_count[_index]++;
+      _num_used++;
+    }
+    if (cache->_count[_index] == 0) {
+      // The pool is empty and the caller mallocs a new chunk
+      _num_used++;
+    }
+  }
+
  public:
   // All chunks in a ChunkPool has the same size
-   ChunkPool(size_t size) : _size(size) { _first = NULL; _num_chunks = _num_used = 0; }
+   ChunkPool(size_t size, int index) : _size(size), _index(index) { _first = NULL; _num_chunks = _num_used = 0; }
 
   // Allocate a new chunk from the pool (might expand the pool)
   NOINLINE void* allocate(size_t bytes, AllocFailType alloc_failmode) {
     assert(bytes == _size, "bad size");
     void* p = NULL;
-    // No VM lock can be taken inside ThreadCritical lock, so os::malloc
-    // should be done outside ThreadCritical lock due to NMT
-    { ThreadCritical tc;
-      _num_used++;
-      p = get_first();
+    ThreadChunkCache* cache = current_cache();
+    if (cache != NULL) {
+      if (cache->_count[_index] == 0) {
+        refill(cache);
+      }
+      Chunk* c = cache->_first[_index];
+      if (c != NULL) {
+        cache->_first[_index] = c->next();
+        cache->_count[_index]--;
+        return c;
+      }
+    } else {
+      // No VM lock can be taken inside ThreadCritical lock, so os::malloc
+      // should be done outside ThreadCritical lock due to NMT
+      { ThreadCritical tc;
+        _num_used++;
+        p = get_first();
+      }
     }
     if (p == NULL) p = os::malloc(bytes, mtChunk, CURRENT_PC);
     if (p == NULL && alloc_failmode == AllocFailStrategy::EXIT_OOM) {
@@ -85,6 +123,17 @@ class ChunkPool: public CHeapObj<mtInternal> {
   // Return a chunk to the pool
   void free(Chunk* chunk) {
     assert(chunk->length() + Chunk::aligned_overhead_size() == _size, "bad size");
+    ThreadChunkCache* cache = current_cache();
+    if (cache != NULL) {
+      if (cache->_count[_index] == ThreadChunkCache::max_cached) {
+        spill(cache, ThreadChunkCache::batch_size);
+      }
+      chunk->set_next(cache->_first[_index]);
+      cache->_first[_index] = chunk;
+      cache->_count[_index]++;
+      return;
+    }
+
     ThreadCritical tc;
     _num_used--;
 
@@ -94,6 +143,28 @@ class ChunkPool: public CHeapObj<mtInternal> {
     _num_chunks++;
   }
 
+  // Move n chunks from the thread's cache back to the pool,
+  // under one ThreadCritical section.
+  void spill(ThreadChunkCache* cache, size_t n) {
+    assert(n <= cache->_count[_index], "not enough cached chunks");
+    if (n == 0) {
+      return;
+    }
+    Chunk* first = cache->_first[_index];
+    Chunk* last = first;
+    for (size_t i = 1; i < n; i++) {
+      last = last->next();
+    }
+    cache->_first[_index] = last->next();
+    cache->_count[_index] -= n;
+
+    ThreadCritical tc;
+    last->set_next(_first);
+    _first = first;
+    _num_chunks += n;
+    _num_used -= n;
+  }
+
   // Prune the pool
   void free_all_but(size_t n) {
     Chunk* cur = NULL;
@@ -130,11 +201,20 @@ class ChunkPool: public CHeapObj<mtInternal> {
   static ChunkPool* small_pool()  { assert(_small_pool  != NULL, "must be initialized"); return _small_pool;  }
   static ChunkPool* tiny_pool()   { assert(_tiny_pool   != NULL, "must be initialized"); return _tiny_pool;   }
 
+  static ChunkPool* pool_at(int index) {
+    switch (index) {
+      case 0:  return large_pool();
+      case 1:  return medium_pool();
+      case 2:  return small_pool();
+      default: return tiny_pool();
+    }
+  }
+
   static void initialize() {
-    _large_pool  = new ChunkPool(Chunk::size        + Chunk::aligned_overhead_size());
-    _medium_pool = new ChunkPool(Chunk::medium_size + Chunk::aligned_overhead_size());
-    _small_pool  = new ChunkPool(Chunk::init_size   + Chunk::aligned_overhead_size());
-    _tiny_pool   = new ChunkPool(Chunk::tiny_size   + Chunk::aligned_overhead_size());
+    _large_pool  = new ChunkPool(Chunk::size        + Chunk::aligned_overhead_size(), 0);
+    _medium_pool = new ChunkPool(Chunk::medium_size + Chunk::aligned_overhead_size(), 1);
+    _small_pool  = new ChunkPool(Chunk::init_size   + Chunk::aligned_overhead_size(), 2);
+    _tiny_pool   = new ChunkPool(Chunk::tiny_size   + Chunk::aligned_overhead_size(), 3);
   }
 
   static void clean() {
@@ -161,6 +241,22 @@ Chunk::clean_chunk_pool() {
 }
 
 
+//--------------------------------------------------------------------------------------
+// ThreadChunkCache implementation
+
+ThreadChunkCache::ThreadChunkCache() {
+  for (int i = 0; i < nof_pools; i++) {
+    _first[i] = NULL;
+    _count[i] = 0;
+  }
+}
+
+ThreadChunkCache::~ThreadChunkCache() {
+  for (int i = 0; i < nof_pools; i++) {
+    ChunkPool::pool_at(i)->spill(this, _count[i]);
+  }
+}
+
 //--------------------------------------------------------------------------------------
 // ChunkPoolCleaner implementation
 //
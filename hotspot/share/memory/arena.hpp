@@ -88,6 +88,30 @@ class Chunk: CHeapObj<mtChunk> {
   static void clean_chunk_pool();
 };
 
+//------------------------------ThreadChunkCache-------------------------------
+// Free pool-sized chunks cached by a thread that grows and chops arenas at
+// a high rate (compiler and GC worker threads). Chunks move between the
+// cache and the shared ChunkPools in batches, so the ThreadCritical lock
+// guarding the pools is taken once per batch instead of once per chunk.
+class ThreadChunkCache : public CHeapObj<mtChunk> {
+  friend class ChunkPool;
+
+ public:
+  enum {
+    nof_pools  = 4,             // one list per ChunkPool
+    max_cached = 16,            // per pool; a full list spills a batch
+    batch_size = max_cached / 2
+  };
+
+ private:
+  Chunk* _first[nof_pools];
+  size_t _count[nof_pools];
+
+ public:
+  ThreadChunkCache();
+  ~ThreadChunkCache();          // returns the cached chunks to the shared pools
+};
+
 //------------------------------Arena------------------------------------------
 // Fast allocation of memory
 class Arena : public CHeapObj<mtNone> {
@@ -24,10 +24,13 @@
 
 #include "precompiled.hpp"
 #include "jvm.h"
+#include "classfile/classLoader.hpp"
 #include "classfile/classLoaderData.inline.hpp"
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "classfile/systemDictionaryShared.hpp"
+#include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "logging/log.hpp"
 #include "memory/metadataFactory.hpp"
 #include "memory/metaspace.hpp"
@@ -35,9 +38,11 @@
 #include "memory/metaspaceShared.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/dynamicArchive.hpp"
+#include "memory/universe.hpp"
 #include "oops/compressedOops.hpp"
 #include "oops/objArrayKlass.hpp"
 #include "prims/jvmtiRedefineClasses.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/os.inline.hpp"
 #include "runtime/sharedRuntime.hpp"
@@ -903,30 +908,109 @@ class RelocateBufferToTarget: public BitMapClosure {
 };
 
 
+// Patches the marked pointers of the buffer in parallel. Every marked
+// pointer is a distinct word of the buffer, so the bitmap can be split
+// into chunks that are processed independently.
+class ParRelocateBufferToTargetTask : public AbstractGangTask {
+  static const BitMap::idx_t ChunkSize = 64 * K; // bits
+  CHeapBitMap* _ptrmap;
+  RelocateBufferToTarget* _patcher;
+  volatile BitMap::idx_t _next_chunk;
+public:
+  ParRelocateBufferToTargetTask(CHeapBitMap* ptrmap, RelocateBufferToTarget* patcher) :
+    AbstractGangTask("Parallel Relocate Buffer To Target"),
+    _ptrmap(ptrmap), _patcher(patcher), _next_chunk(0) {}
+
+  static uint num_chunks(BitMap::idx_t size) {
+    return (uint)((size + ChunkSize - 1) / ChunkSize);
+  }
+
+  void work(uint worker_id) {
+    const BitMap::idx_t size = _ptrmap->size();
+    while (true) {
+      BitMap::idx_t chunk = Atomic::add((BitMap::idx_t)1, &_next_chunk) - 1;
+      BitMap::idx_t beg = chunk * ChunkSize;
+      if (beg >= size) {
+        return;
+      }
+      _ptrmap->iterate(_patcher, beg, MIN2(beg + ChunkSize, size));
+    }
+  }
+};
+
 void DynamicArchiveBuilder::relocate_buffer_to_target() {
   RelocateBufferToTarget patcher(this, (address*)_alloc_bottom, _buffer_to_target_delta);
-  _ptrmap.iterate(&patcher);
+  WorkGang* workers = Universe::heap()->get_safepoint_workers();
+  uint num_chunks = ParRelocateBufferToTargetTask::num_chunks(_ptrmap.size());
+  if (workers != NULL && num_chunks > 1) {
+    ParRelocateBufferToTargetTask task(&_ptrmap, &patcher);
+    workers->run_task(&task, MIN2(num_chunks, workers->total_workers()));
+  } else {
+    _ptrmap.iterate(&patcher);
+  }
 
   Array<u8>* table = _header->_shared_path_table.table();
   table = to_target(table);
  _header->_shared_path_table.set_table(table);
 }
 
-static void write_archive_info(FileMapInfo* dynamic_info, DynamicArchiveHeader *header) {
+static const int num_archive_regions = 3;
+static const int archive_regions[num_archive_regions] = {
+  MetaspaceShared::rw, MetaspaceShared::ro, MetaspaceShared::mc
+};
+
+static DumpRegion* dump_space_of(int region) {
+  switch (region) {
+  case MetaspaceShared::rw: return MetaspaceShared::read_write_dump_space();
+  case MetaspaceShared::ro: return MetaspaceShared::read_only_dump_space();
+  case MetaspaceShared::mc: return MetaspaceShared::misc_code_dump_space();
+  default: ShouldNotReachHere(); return NULL;
+  }
+}
+
+// Computes the CRCs of the archive regions, one region per worker.
+class ParComputeRegionCRCTask : public AbstractGangTask {
+  int* _crcs;
+  volatile int _next_region;
+public:
+  ParComputeRegionCRCTask(int* crcs) :
+    AbstractGangTask("Parallel Compute Region CRC"), _crcs(crcs), _next_region(0) {}
+
+  static void compute(int i, int* crcs) {
+    DumpRegion* space = dump_space_of(archive_regions[i]);
+    crcs[i] = ClassLoader::crc32(0, space->base(), (jint)space->used());
+  }
+
+  void work(uint worker_id) {
+    int i;
+    while ((i = Atomic::add(1, &_next_region) - 1) < num_archive_regions) {
+      compute(i, _crcs);
+    }
+  }
+};
+
+static void compute_region_crcs(int* crcs) {
+  WorkGang* workers = Universe::heap()->get_safepoint_workers();
+  if (workers != NULL) {
+    ParComputeRegionCRCTask task(crcs);
+    workers->run_task(&task, MIN2((uint)num_archive_regions, workers->total_workers()));
+  } else {
+    for (int i = 0; i < num_archive_regions; i++) {
+      ParComputeRegionCRCTask::compute(i, crcs);
+    }
+  }
+}
+
+static void write_archive_info(FileMapInfo* dynamic_info, DynamicArchiveHeader *header, const int* crcs) {
   dynamic_info->write_header();
   dynamic_info->align_file_position();
-  dynamic_info->write_region(MetaspaceShared::rw,
-                             MetaspaceShared::read_write_dump_space()->base(),
-                             MetaspaceShared::read_write_dump_space()->used(),
-                             /*read_only=*/false,/*allow_exec=*/false);
-  dynamic_info->write_region(MetaspaceShared::ro,
-                             MetaspaceShared::read_only_dump_space()->base(),
-                             MetaspaceShared::read_only_dump_space()->used(),
-                             /*read_only=*/true, /*allow_exec=*/false);
-  dynamic_info->write_region(MetaspaceShared::mc,
-                             MetaspaceShared::misc_code_dump_space()->base(),
-                             MetaspaceShared::misc_code_dump_space()->used(),
-                             /*read_only=*/false,/*allow_exec=*/true);
+  for (int i = 0; i < num_archive_regions; i++) {
+    int region = archive_regions[i];
+    DumpRegion* space = dump_space_of(region);
+    dynamic_info->write_region(region, space->base(), space->used(), crcs[i],
+                               /*read_only=*/region == MetaspaceShared::ro,
+                               /*allow_exec=*/region == MetaspaceShared::mc);
+  }
 }
 
 void DynamicArchiveBuilder::write_archive(char* read_only_tables_start) {
@@ -938,8 +1022,13 @@ void DynamicArchiveBuilder::write_archive(char* read_only_tables_start) {
   FileMapInfo* dynamic_info = FileMapInfo::dynamic_info();
   assert(dynamic_info != NULL, "Sanity");
 
+  // The regions do not change anymore. Compute their crcs once, they are
+  // needed for both passes below.
+  int crcs[num_archive_regions];
+  compute_region_crcs(crcs);
+
   // Populate the file offsets, region crcs, etc. No data is written out.
-  write_archive_info(dynamic_info, _header);
+  write_archive_info(dynamic_info, _header, crcs);
 
   // the header will no longer change. Compute its crc.
   dynamic_info->set_header_crc(dynamic_info->compute_header_crc());
@@ -947,7 +1036,7 @@ void DynamicArchiveBuilder::write_archive(char* read_only_tables_start) {
   // Now write the archived data including the file offsets.
   const char* archive_name = Arguments::GetSharedDynamicArchivePath();
   dynamic_info->open_for_write(archive_name);
-  write_archive_info(dynamic_info, _header);
+  write_archive_info(dynamic_info, _header, crcs);
   dynamic_info->close();
 
 
@@ -988,6 +1077,11 @@ void DynamicArchive::dump() {
     log_warning(cds, dynamic)("SharedDynamicArchivePath is not specified");
     return;
   }
+  if (FileMapInfo::current_info() != NULL && FileMapInfo::current_info()->is_relocated()) {
+    // The dynamic archive refers to the base archive by its dump time addresses.
+    log_warning(cds, dynamic)("Cannot dump the dynamic archive because the base archive has been relocated");
+    return;
+  }
 
   DynamicArchiveBuilder builder;
   _builder = &builder;
@@ -1056,6 +1150,12 @@ void DynamicArchive::map_failed(FileMapInfo* mapinfo) {
 address DynamicArchive::map() {
   assert(UseSharedSpaces, "Sanity");
 
+  if (FileMapInfo::current_info()->is_relocated()) {
+    // The dynamic archive refers to the base archive by its dump time addresses.
+    log_info(cds, dynamic)("Dynamic archive is not used because the base archive has been relocated");
+    return NULL;
+  }
+
   // Create the dynamic archive map info
   FileMapInfo* mapinfo;
   const char* filename = Arguments::GetSharedDynamicArchivePath();
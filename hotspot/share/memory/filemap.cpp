@@ -55,6 +55,7 @@
 #include "runtime/vm_version.hpp"
 #include "services/memTracker.hpp"
 #include "utilities/align.hpp"
+#include "utilities/bitMap.inline.hpp"
 #include "utilities/defaultStream.hpp"
 #if INCLUDE_G1GC
 #include "gc/g1/g1CollectedHeap.hpp"
@@ -905,6 +906,13 @@ void FileMapInfo::write_header() {
 // the archive file is open (_file_open is false) and once after.
 void FileMapInfo::write_region(int region, char* base, size_t size,
                                bool read_only, bool allow_exec) {
+  // Use the current 'base' when computing the CRC value and writing out data
+  int crc = ClassLoader::crc32(0, base, (jint)size);
+  write_region(region, base, size, crc, read_only, allow_exec);
+}
+
+void FileMapInfo::write_region(int region, char* base, size_t size, int crc,
+                               bool read_only, bool allow_exec) {
   assert(DumpSharedSpaces || DynamicDumpSharedSpaces, "Dump time only");
 
   CDSFileMapRegion* si = space_at(region);
@@ -936,8 +944,7 @@ void FileMapInfo::write_region(int region, char* base, size_t size,
   si->_read_only = read_only;
   si->_allow_exec = allow_exec;
 
-  // Use the current 'base' when computing the CRC value and writing out data
-  si->_crc = ClassLoader::crc32(0, base, (jint)size);
+  si->_crc = crc;
   if (base != NULL) {
     write_bytes_aligned(base, size);
   }
@@ -1014,6 +1021,20 @@ size_t FileMapInfo::write_archive_heap_regions(GrowableArray<MemRegion> *heap_me
   return total_size;
 }
 
+// Write the relocation bitmap of the core spaces, see ArchivePtrMarker.
+// It is only needed if the archive cannot be mapped at the address it was
+// dumped at, and is not kept mapped at runtime.
+void FileMapInfo::write_bitmap_region(const CHeapBitMap* ptrmap) {
+  assert(DumpSharedSpaces, "only the static archive can be relocated");
+  _header->_ptrmap_size_in_bits = ptrmap->size();
+  size_t size_in_bytes = ptrmap->size_in_bytes();
+  char* buffer = NEW_C_HEAP_ARRAY(char, size_in_bytes, mtInternal);
+  ptrmap->write_to((BitMap::bm_word_t*)buffer, size_in_bytes);
+  write_region(MetaspaceShared::bm, buffer, size_in_bytes,
+               true /* read_only */, false /* allow_exec */);
+  FREE_C_HEAP_ARRAY(char, buffer);
+}
+
 // Dump bytes to file -- at the current file position.
 
 void FileMapInfo::write_bytes(const void* buffer, size_t nbytes) {
@@ -1116,11 +1137,26 @@ ReservedSpace FileMapInfo::reserve_shared_memory() {
 
   // Reserve the space first, then map otherwise map will go right over some
   // other reserved memory (like the code cache).
-  ReservedSpace rs(size, os::vm_allocation_granularity(), false, requested_addr);
+  ReservedSpace rs;
+  if (ArchiveRelocationMode != 1) {
+    rs = ReservedSpace(size, os::vm_allocation_granularity(), false, requested_addr);
+  }
   if (!rs.is_reserved()) {
-    fail_continue("Unable to reserve shared space at required address "
-                  INTPTR_FORMAT, p2i(requested_addr));
-    return rs;
+    if (ArchiveRelocationMode == 2 || _header->_ptrmap_size_in_bits == 0) {
+      fail_continue("Unable to reserve shared space at required address "
+                    INTPTR_FORMAT, p2i(requested_addr));
+      return rs;
+    }
+    // Map the archive anywhere and patch the archived pointers after mapping,
+    // see relocate_pointers().
+    rs = ReservedSpace(size, Metaspace::reserve_alignment(), false);
+    if (!rs.is_reserved()) {
+      fail_continue("Unable to reserve shared space");
+      return rs;
+    }
+    log_info(cds)("Unable to use shared space at required address " INTPTR_FORMAT
+                  ", relocating to " INTPTR_FORMAT, p2i(requested_addr), p2i(rs.base()));
+    relocate_header(rs.base() - requested_addr);
   }
   // the reserved virtual memory is for mapping class data sharing archive
   MemTracker::record_virtual_memory_type((address)rs.base(), mtClassShared);
@@ -1128,9 +1164,83 @@ ReservedSpace FileMapInfo::reserve_shared_memory() {
   return rs;
 }
 
+// Adjusts the addresses recorded in the header by the distance between the
+// reserved space and the address the archive was dumped at. Everything that
+// is derived from the header afterwards uses the new addresses.
+void FileMapInfo::relocate_header(intx delta) {
+  assert(delta != 0, "sanity");
+  _relocation_delta = delta;
+  for (int i = 0; i < MetaspaceShared::num_core_spaces; i++) {
+    space_at(i)->_addr._base += delta;
+  }
+  _header->_misc_data_patching_start += delta;
+  _header->_read_only_tables_start += delta;
+  _header->_cds_i2i_entry_code_buffers += delta;
+  _header->_shared_path_table.set_table(
+      (Array<u8>*)((address)_header->_shared_path_table.table() + delta));
+  _header->_shared_base_address += delta;
+  SharedBaseAddress = (size_t)_header->_shared_base_address;
+}
+
+class ArchivedPointerPatcher : public BitMapClosure {
+  address* _patch_base;
+  intx     _delta;
+  DEBUG_ONLY(address _dumped_base;)
+  DEBUG_ONLY(address _dumped_end;)
+  size_t   _count;
+
+ public:
+  ArchivedPointerPatcher(address* patch_base, size_t size, intx delta) :
+    _patch_base(patch_base), _delta(delta), _count(0) {
+    DEBUG_ONLY(_dumped_base = (address)patch_base - delta;)
+    DEBUG_ONLY(_dumped_end = _dumped_base + size;)
+  }
+
+  bool do_bit(size_t offset) {
+    address* p = _patch_base + offset;
+    assert(_dumped_base <= *p && *p < _dumped_end,
+           "archived pointer " INTPTR_FORMAT " at " INTPTR_FORMAT " out of range",
+           p2i(*p), p2i(p));
+    *p += _delta;
+    _count++;
+    return true;
+  }
+
+  size_t count() const { return _count; }
+};
+
+// Patches all pointers recorded in the relocation bitmap (the bm region) of
+// an archive that has been mapped at a different address than it was dumped at.
+bool FileMapInfo::relocate_pointers() {
+  assert(is_relocated(), "sanity");
+  CDSFileMapRegion* si = space_at(MetaspaceShared::bm);
+  size_t size = align_up(si->_used, os::vm_allocation_granularity());
+  char* bitmap_base = os::map_memory(_fd, _full_path, si->_file_offset,
+                                     NULL, size, true /* read_only */, false /* allow_exec */);
+  if (bitmap_base == NULL) {
+    fail_continue("Unable to map the relocation bitmap");
+    return false;
+  }
+  if (VerifySharedSpaces && !region_crc_check(bitmap_base, si->_used, si->_crc)) {
+    os::unmap_memory(bitmap_base, size);
+    return false;
+  }
+
+  BitMapView ptrmap((BitMap::bm_word_t*)bitmap_base, _header->_ptrmap_size_in_bits);
+  ArchivedPointerPatcher patcher((address*)region_addr(MetaspaceShared::mc),
+                                 core_spaces_size(), _relocation_delta);
+  ptrmap.iterate(&patcher);
+  os::unmap_memory(bitmap_base, size);
+
+  log_info(cds)("Relocated " SIZE_FORMAT " archived pointers by " INTX_FORMAT " bytes",
+                patcher.count(), _relocation_delta);
+  return true;
+}
+
 // Memory map a region in the address space.
 static const char* shared_region_name[] = { "MiscData", "ReadWrite", "ReadOnly", "MiscCode",
-                                            "String1", "String2", "OpenArchive1", "OpenArchive2" };
+                                            "String1", "String2", "OpenArchive1", "OpenArchive2",
+                                            "Bitmap" };
 
 char* FileMapInfo::map_regions(int regions[], char* saved_base[], size_t len) {
   char* prev_top = NULL;
@@ -1176,6 +1286,13 @@ char* FileMapInfo::map_region(int i, char** top_ret) {
   }
 #endif // _WINDOWS
 
+  if (is_relocated()) {
+    // The archived pointers are patched in place after mapping. Remapping
+    // the region from the file, as remap_shared_readonly_as_readwrite()
+    // does, would undo that.
+    si->_read_only = false;
+  }
+
   // map the contents of the CDS archive in this memory
   char *base = os::map_memory(_fd, _full_path, si->_file_offset,
                               requested_addr, size, si->_read_only,
@@ -1191,6 +1308,8 @@ char* FileMapInfo::map_region(int i, char** top_ret) {
   MemTracker::record_virtual_memory_type((address)base, mtClassShared);
 #endif
 
+  advise_large_pages(si, base, size);
+
   if (VerifySharedSpaces && !verify_region_checksum(i)) {
     return NULL;
   }
@@ -1199,6 +1318,15 @@ char* FileMapInfo::map_region(int i, char** top_ret) {
   return base;
 }
 
+// Read-only regions are clean file-backed pages, which the page cache shares
+// between all JVMs that map the same archive. Collapsing them into huge pages
+// keeps them shared and cuts the TLB footprint of the archive.
+void FileMapInfo::advise_large_pages(CDSFileMapRegion* si, char* base, size_t size) {
+  if (UseLargePagesForSharedSpaces && UseTransparentHugePages && si->_read_only) {
+    os::realign_memory(base, size, os::large_page_size());
+  }
+}
+
 size_t FileMapInfo::read_bytes(void* buffer, size_t count) {
   assert(_file_open, "Archive file is not open");
   size_t n = os::read(_fd, buffer, (unsigned int)count);
@@ -1238,7 +1366,7 @@ MemRegion FileMapInfo::get_heap_regions_range_with_current_oop_encoding_mode() {
   address end   = NULL;
 
   for (int i = MetaspaceShared::first_closed_archive_heap_region;
-           i <= MetaspaceShared::last_valid_region;
+           i <= MetaspaceShared::last_open_archive_heap_region;
            i++) {
     CDSFileMapRegion* si = space_at(i);
     size_t size = si->_used;
@@ -1291,6 +1419,13 @@ void FileMapInfo::map_heap_regions_impl() {
     // referenced objects are replaced. See HeapShared::initialize_from_archived_subgraph().
   }
 
+  if (is_relocated()) {
+    // The archived objects refer to archived classes by their dump time
+    // addresses, which are not recorded in the relocation bitmap.
+    log_info(cds)("CDS heap data is not used because the archive has been relocated.");
+    return;
+  }
+
   MemRegion heap_reserved = Universe::heap()->reserved_region();
 
   log_info(cds)("CDS archive was created with max heap size = " SIZE_FORMAT "M, and the following configuration:",
@@ -1453,6 +1588,8 @@ bool FileMapInfo::map_heap_data(MemRegion **heap_mem, int first,
       return false;
     }
 
+    advise_large_pages(si, base, regions[i].byte_size());
+
     if (VerifySharedSpaces && !region_crc_check(addr, regions[i].byte_size(), si->_crc)) {
       // dealloc the regions from java heap
       dealloc_archive_heap_regions(regions, region_num, is_open_archive);
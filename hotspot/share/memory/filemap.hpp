@@ -32,6 +32,8 @@
 #include "oops/compressedOops.hpp"
 #include "utilities/align.hpp"
 
+class CHeapBitMap;
+
 // Layout of the file:
 //  header: dump of archive instance plus versioning info, datestamp, etc.
 //   [magic # = 0xF00BABA2]
@@ -134,6 +136,7 @@ struct FileMapHeader : public CDSFileMapHeaderBase {
   size_t  _cds_i2i_entry_code_buffers_size;
   size_t  _core_spaces_size;        // number of bytes allocated by the core spaces
                                     // (mc, md, ro, rw and od).
+  size_t  _ptrmap_size_in_bits;     // number of bits in the relocation bitmap (bm region)
   MemRegion _heap_reserved;         // reserved region for the entire heap at dump time.
   bool _base_archive_is_default;    // indicates if the base archive is the system default one
 
@@ -209,6 +212,7 @@ private:
   bool    _file_open;
   int     _fd;
   size_t  _file_offset;
+  intx    _relocation_delta;        // mapped address - dump time address of the core spaces
 
 private:
   // TODO: Probably change the following to be non-static
@@ -311,15 +315,20 @@ public:
   void  write_header();
   void  write_region(int region, char* base, size_t size,
                      bool read_only, bool allow_exec);
+  // Same as above, with the CRC of the region data already computed.
+  void  write_region(int region, char* base, size_t size, int crc,
+                     bool read_only, bool allow_exec);
   size_t write_archive_heap_regions(GrowableArray<MemRegion> *heap_mem,
                                     GrowableArray<ArchiveHeapOopmapInfo> *oopmaps,
                                     int first_region_id, int max_num_regions,
                                     bool print_log);
+  void  write_bitmap_region(const CHeapBitMap* ptrmap);
   void  write_bytes(const void* buffer, size_t count);
   void  write_bytes_aligned(const void* buffer, size_t count);
   size_t  read_bytes(void* buffer, size_t count);
   char* map_regions(int regions[], char* saved_base[], size_t len);
   char* map_region(int i, char** top_ret);
+  void  advise_large_pages(CDSFileMapRegion* si, char* base, size_t size);
   void  map_heap_regions_impl() NOT_CDS_JAVA_HEAP_RETURN;
   void  map_heap_regions() NOT_CDS_JAVA_HEAP_RETURN;
   void  fixup_mapped_heap_regions() NOT_CDS_JAVA_HEAP_RETURN;
@@ -335,6 +344,12 @@ public:
   bool  is_open() { return _file_open; }
   ReservedSpace reserve_shared_memory();
 
+  // True if the core spaces could not be mapped at the address they were
+  // dumped at. The archived pointers must then be patched by
+  // relocate_pointers() before the archive can be used.
+  bool  is_relocated() const { return _relocation_delta != 0; }
+  bool  relocate_pointers();
+
   // JVM/TI RedefineClasses() support:
   // Remap the shared readonly space to shared readwrite, private.
   bool  remap_shared_readonly_as_readwrite();
@@ -380,6 +395,7 @@ public:
                       bool is_open = false) NOT_CDS_JAVA_HEAP_RETURN_(false);
   bool  region_crc_check(char* buf, size_t size, int expected_crc) NOT_CDS_RETURN_(false);
   void  dealloc_archive_heap_regions(MemRegion* regions, int num, bool is_open) NOT_CDS_JAVA_HEAP_RETURN;
+  void  relocate_header(intx delta);
 
   CDSFileMapRegion* space_at(int i) {
     return _header->space_at(i);
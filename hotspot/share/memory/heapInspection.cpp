@@ -28,11 +28,16 @@
 #include "classfile/moduleEntry.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "memory/heapInspection.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
+#include "oops/arrayOop.hpp"
+#include "oops/instanceOop.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/reflectionAccessorImplKlassHelper.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/macros.hpp"
@@ -121,6 +126,15 @@ void KlassInfoEntry::print_on(outputStream* st) const {
   }
 }
 
+// Bytes taken by the headers of the instances: the mark word, the klass
+// pointer and, for arrays, the length.
+size_t KlassInfoEntry::header_bytes() const {
+  size_t header_size = _klass->is_array_klass() ?
+                       arrayOopDesc::length_offset_in_bytes() + sizeof(int) :
+                       (size_t)instanceOopDesc::base_offset_in_bytes();
+  return (size_t)_instance_count * header_size;
+}
+
 KlassInfoEntry* KlassInfoBucket::lookup(Klass* const k) {
   // Can happen if k is an archived class that we haven't loaded yet.
   if (k->java_mirror_no_keepalive() == NULL) {
@@ -242,6 +256,42 @@ size_t KlassInfoTable::size_of_instances_in_words() const {
   return _size_of_instances_in_words;
 }
 
+// Return false if the entry could not be recorded on account
+// of running out of space required to create a new entry.
+bool KlassInfoTable::merge_entry(const KlassInfoEntry* cie) {
+  Klass*          k = cie->klass();
+  KlassInfoEntry* elt = lookup(k);
+  // elt may be NULL if it's a new klass for which we
+  // could not allocate space for a new entry in the hashtable.
+  if (elt != NULL) {
+    elt->set_count(elt->count() + cie->count());
+    elt->set_words(elt->words() + cie->words());
+    _size_of_instances_in_words += cie->words();
+    return true;
+  }
+  return false;
+}
+
+class KlassInfoTable::MergeClosure : public KlassInfoClosure {
+ private:
+  KlassInfoTable* _dest;
+  size_t _missed_count;
+ public:
+  MergeClosure(KlassInfoTable* table) : _dest(table), _missed_count(0) {}
+  void do_cinfo(KlassInfoEntry* cie) {
+    if (!_dest->merge_entry(cie)) {
+      _missed_count += cie->count();
+    }
+  }
+  size_t missed_count() { return _missed_count; }
+};
+
+size_t KlassInfoTable::merge(KlassInfoTable* table) {
+  MergeClosure closure(this);
+  table->iterate(&closure);
+  return closure.missed_count();
+}
+
 int KlassInfoHisto::sort_helper(KlassInfoEntry** e1, KlassInfoEntry** e2) {
   return (*e1)->compare(*e1,*e2);
 }
@@ -267,14 +317,21 @@ void KlassInfoHisto::print_elements(outputStream* st) const {
   // simplify the formatting (ILP32 vs LP64) - store the sum in 64-bit
   int64_t total = 0;
   uint64_t totalw = 0;
+  uint64_t total_header_bytes = 0;
   for(int i=0; i < elements()->length(); i++) {
     st->print("%4d: ", i+1);
     elements()->at(i)->print_on(st);
     total += elements()->at(i)->count();
     totalw += elements()->at(i)->words();
+    total_header_bytes += elements()->at(i)->header_bytes();
   }
   st->print_cr("Total " INT64_FORMAT_W(13) "  " UINT64_FORMAT_W(13),
                total, totalw * HeapWordSize);
+  if (totalw > 0) {
+    st->print_cr("Object headers: " UINT64_FORMAT " bytes (%.1f%% of total)",
+                 total_header_bytes,
+                 (double)total_header_bytes * 100.0 / (double)(totalw * HeapWordSize));
+  }
 }
 
 #define MAKE_COL_NAME(field, name, help)     #name,
@@ -715,15 +772,82 @@ class RecordInstanceClosure : public ObjectClosure {
   }
 };
 
-size_t HeapInspection::populate_table(KlassInfoTable* cit, BoolObjectClosure *filter) {
+// Gang task used to populate a KlassInfoTable with the help of the GC
+// worker threads. Each worker records the objects of its part of the heap
+// in a table of its own, which is then merged into the shared table.
+class ParHeapInspectTask : public AbstractGangTask {
+ private:
+  ParallelObjectIterator* _poi;
+  KlassInfoTable*         _shared_cit;
+  BoolObjectClosure*      _filter;
+  volatile size_t         _missed_count;
+  Mutex                   _mutex;
+
+ public:
+  ParHeapInspectTask(ParallelObjectIterator* poi,
+                     KlassInfoTable* shared_cit,
+                     BoolObjectClosure* filter) :
+    AbstractGangTask("Iterating heap"),
+    _poi(poi),
+    _shared_cit(shared_cit),
+    _filter(filter),
+    _missed_count(0),
+    _mutex(Mutex::leaf, "Parallel heap iteration data merge lock", true,
+           Mutex::_safepoint_check_never) { }
+
+  size_t missed_count() const { return _missed_count; }
+
+  virtual void work(uint worker_id) {
+    KlassInfoTable cit(false);
+    if (cit.allocation_failed()) {
+      // Out of C-heap for a table of our own; record directly into the
+      // shared table instead.
+      MutexLocker x(&_mutex, Mutex::_no_safepoint_check_flag);
+      RecordInstanceClosure ric(_shared_cit, _filter);
+      _poi->object_iterate(&ric, worker_id);
+      Atomic::add(ric.missed_count(), &_missed_count);
+      return;
+    }
+
+    RecordInstanceClosure ric(&cit, _filter);
+    _poi->object_iterate(&ric, worker_id);
+
+    size_t missed_count = ric.missed_count();
+    {
+      MutexLocker x(&_mutex, Mutex::_no_safepoint_check_flag);
+      missed_count += _shared_cit->merge(&cit);
+    }
+    Atomic::add(missed_count, &_missed_count);
+  }
+};
+
+size_t HeapInspection::populate_table(KlassInfoTable* cit, BoolObjectClosure *filter,
+                                      uint parallel_thread_num) {
   ResourceMark rm;
 
+  // Try parallel first.
+  if (parallel_thread_num > 1) {
+    CollectedHeap* heap = Universe::heap();
+    WorkGang* workers = heap->get_safepoint_workers();
+    if (workers != NULL) {
+      uint num_workers = MIN2(parallel_thread_num, workers->total_workers());
+      ParallelObjectIterator* poi = heap->parallel_object_iterator(num_workers);
+      if (poi != NULL) {
+        ParHeapInspectTask task(poi, cit, filter);
+        workers->run_task(&task, num_workers);
+        delete poi;
+        return task.missed_count();
+      }
+    }
+  }
+
+  // The collector can not iterate the heap in parallel, run serially.
   RecordInstanceClosure ric(cit, filter);
   Universe::heap()->safe_object_iterate(&ric);
   return ric.missed_count();
 }
 
-void HeapInspection::heap_inspection(outputStream* st) {
+void HeapInspection::heap_inspection(outputStream* st, uint parallel_thread_num) {
   ResourceMark rm;
 
   if (_print_help) {
@@ -747,7 +871,7 @@ void HeapInspection::heap_inspection(outputStream* st) {
   KlassInfoTable cit(_print_class_stats);
   if (!cit.allocation_failed()) {
     // populate table with object allocation info
-    size_t missed_count = populate_table(&cit);
+    size_t missed_count = populate_table(&cit, NULL, parallel_thread_num);
     if (missed_count != 0) {
       st->print_cr("WARNING: Ran out of C-heap; undercounted " SIZE_FORMAT
                    " total instances in data below",
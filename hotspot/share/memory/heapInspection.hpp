@@ -203,6 +203,7 @@ class KlassInfoEntry: public CHeapObj<mtInternal> {
   void set_count(long ct)    { _instance_count = ct; }
   size_t words()  const      { return _instance_words; }
   void set_words(size_t wds) { _instance_words = wds; }
+  size_t header_bytes() const;
   void set_index(long index) { _index = index; }
   long index()    const      { return _index; }
   GrowableArray<KlassInfoEntry*>* subclasses() const { return _subclasses; }
@@ -245,8 +246,10 @@ class KlassInfoTable: public StackObj {
   KlassInfoBucket* _buckets;
   uint hash(const Klass* p);
   KlassInfoEntry* lookup(Klass* k); // allocates if not found!
+  bool merge_entry(const KlassInfoEntry* cie);
 
   class AllClassesFinder;
+  class MergeClosure;
 
  public:
   KlassInfoTable(bool add_all_classes);
@@ -255,6 +258,9 @@ class KlassInfoTable: public StackObj {
   void iterate(KlassInfoClosure* cic);
   bool allocation_failed() { return _buckets == NULL; }
   size_t size_of_instances_in_words() const;
+  // Adds the counts of the given table to this table. Returns the number
+  // of instances that could not be recorded for lack of C-heap.
+  size_t merge(KlassInfoTable* table);
 
   friend class KlassInfoHisto;
   friend class KlassHierarchy;
@@ -358,8 +364,9 @@ class HeapInspection : public StackObj {
                  bool print_class_stats, const char *columns) :
       _csv_format(csv_format), _print_help(print_help),
       _print_class_stats(print_class_stats), _columns(columns) {}
-  void heap_inspection(outputStream* st) NOT_SERVICES_RETURN;
-  size_t populate_table(KlassInfoTable* cit, BoolObjectClosure* filter = NULL) NOT_SERVICES_RETURN_(0);
+  void heap_inspection(outputStream* st, uint parallel_thread_num = 1) NOT_SERVICES_RETURN;
+  size_t populate_table(KlassInfoTable* cit, BoolObjectClosure* filter = NULL,
+                        uint parallel_thread_num = 1) NOT_SERVICES_RETURN_(0);
   static void find_instances_at_safepoint(Klass* k, GrowableArray<oop>* result) NOT_SERVICES_RETURN;
  private:
   void iterate_over_heap(KlassInfoTable* cit, BoolObjectClosure* filter = NULL);
@@ -26,10 +26,12 @@
 #include "classfile/javaClasses.inline.hpp"
 #include "classfile/stringTable.hpp"
 #include "classfile/symbolTable.hpp"
+#include "classfile/systemDictionaryShared.hpp"
 #include "classfile/vmSymbols.hpp"
 #include "logging/log.hpp"
 #include "logging/logMessage.hpp"
 #include "logging/logStream.hpp"
+#include "memory/archiveUtils.hpp"
 #include "memory/filemap.hpp"
 #include "memory/heapShared.inline.hpp"
 #include "memory/iterator.inline.hpp"
@@ -86,6 +88,10 @@ const static int num_closed_archive_subgraph_entry_fields =
 const static int num_open_archive_subgraph_entry_fields =
   sizeof(open_archive_subgraph_entry_fields) / sizeof(ArchivableStaticFieldInfo);
 
+// Entry fields of application classes, read from ArchivedStaticFieldList.
+// Archived in the open archive heap region.
+static GrowableArray<ArchivableStaticFieldInfo>* app_subgraph_entry_fields = NULL;
+
 ////////////////////////////////////////////////////////////////
 //
 // Java heap object archiving support
@@ -248,6 +254,8 @@ void HeapShared::copy_open_archive_heap_objects(
                            false /* is_closed_archive */,
                            THREAD);
 
+  archive_app_object_subgraphs(THREAD);
+
   G1CollectedHeap::heap()->end_archive_alloc_range(open_archive,
                                                    os::vm_allocation_granularity());
 }
@@ -292,7 +300,9 @@ void KlassSubGraphInfo::add_subgraph_entry_field(
 }
 
 // Add the Klass* for an object in the current KlassSubGraphInfo's subgraphs.
-// Only objects of boot classes can be included in sub-graph.
+// Only objects of boot classes can be included in the JDK's sub-graphs. The
+// sub-graphs of application classes may also include objects of archived
+// platform and app classes.
 void KlassSubGraphInfo::add_subgraph_object_klass(Klass* orig_k, Klass *relocated_k) {
   assert(DumpSharedSpaces, "dump time only");
   assert(relocated_k == MetaspaceShared::get_relocated_klass(orig_k),
@@ -312,8 +322,8 @@ void KlassSubGraphInfo::add_subgraph_object_klass(Klass* orig_k, Klass *relocate
   }
 
   if (relocated_k->is_instance_klass()) {
-    assert(InstanceKlass::cast(relocated_k)->is_shared_boot_class(),
-          "must be boot class");
+    assert(HeapShared::is_builtin_shared_class(InstanceKlass::cast(relocated_k)),
+          "must be boot, platform or app class");
     // SystemDictionary::xxx_klass() are not updated, need to check
     // the original Klass*
     if (orig_k == SystemDictionary::String_klass() ||
@@ -325,8 +335,8 @@ void KlassSubGraphInfo::add_subgraph_object_klass(Klass* orig_k, Klass *relocate
   } else if (relocated_k->is_objArray_klass()) {
     Klass* abk = ObjArrayKlass::cast(relocated_k)->bottom_klass();
     if (abk->is_instance_klass()) {
-      assert(InstanceKlass::cast(abk)->is_shared_boot_class(),
-            "must be boot class");
+      assert(HeapShared::is_builtin_shared_class(InstanceKlass::cast(abk)),
+            "must be boot, platform or app class");
     }
     if (relocated_k == Universe::objectArrayKlassObj()) {
       // Initialized early during Universe::genesis. No need to be added
@@ -354,6 +364,7 @@ void ArchivedKlassSubGraphInfoRecord::init(KlassSubGraphInfo* info) {
   _k = info->klass();
   _entry_field_records = NULL;
   _subgraph_object_klasses = NULL;
+  ArchivePtrMarker::mark_pointer(&_k);
 
   // populate the entry fields
   GrowableArray<juint>* entry_fields = info->subgraph_entry_fields();
@@ -365,6 +376,7 @@ void ArchivedKlassSubGraphInfoRecord::init(KlassSubGraphInfo* info) {
     for (int i = 0 ; i < num_entry_fields; i++) {
       _entry_field_records->at_put(i, entry_fields->at(i));
     }
+    ArchivePtrMarker::mark_pointer(&_entry_field_records);
   }
 
   // the Klasses of the objects in the sub-graphs
@@ -382,7 +394,9 @@ void ArchivedKlassSubGraphInfoRecord::init(KlassSubGraphInfo* info) {
           _k->external_name(), i, subgraph_k->external_name());
       }
       _subgraph_object_klasses->at_put(i, subgraph_k);
+      ArchivePtrMarker::mark_pointer(_subgraph_object_klasses->adr_at(i));
     }
+    ArchivePtrMarker::mark_pointer(&_subgraph_object_klasses);
   }
 }
 
@@ -438,26 +452,33 @@ void HeapShared::initialize_from_archived_subgraph(Klass* k) {
   unsigned int hash = primitive_hash<Klass*>(k);
   const ArchivedKlassSubGraphInfoRecord* record = _run_time_subgraph_info_table.lookup(k, hash, 0);
 
-  // Initialize from archived data. Currently this is done only
-  // during VM initialization time. No lock is needed.
+  // Initialize from archived data. This is done by the thread that
+  // initializes k, so no lock is needed.
   if (record != NULL) {
     Thread* THREAD = Thread::current();
+    Handle class_loader(THREAD, k->class_loader());
+    Handle protection_domain(THREAD, k->protection_domain());
 
     int i;
     // Load/link/initialize the klasses of the objects in the subgraph.
-    // NULL class loader is used.
+    // The class loader of k is used, which is the NULL class loader for
+    // the JDK's own subgraphs.
     Array<Klass*>* klasses = record->subgraph_object_klasses();
     if (klasses != NULL) {
       for (i = 0; i < klasses->length(); i++) {
         Klass* obj_k = klasses->at(i);
         Klass* resolved_k = SystemDictionary::resolve_or_null(
-                                              (obj_k)->name(), THREAD);
+                                              (obj_k)->name(), class_loader,
+                                              protection_domain, THREAD);
+        if (HAS_PENDING_EXCEPTION) {
+          break;
+        }
         if (resolved_k != obj_k) {
-          assert(!SystemDictionary::is_well_known_klass(resolved_k),
+          assert(resolved_k == NULL || !SystemDictionary::is_well_known_klass(resolved_k),
                  "shared well-known classes must not be replaced by JVMTI ClassFileLoadHook");
           ResourceMark rm(THREAD);
           log_info(cds, heap)("Failed to load subgraph because %s was not loaded from archive",
-                              resolved_k->external_name());
+                              obj_k->external_name());
           return;
         }
         if ((obj_k)->is_instance_klass()) {
@@ -671,7 +692,9 @@ oop HeapShared::archive_reachable_objects_from(int level,
 // Sub-graph archiving restrictions (current):
 //
 // - All classes of objects in the archived sub-graph (including the
-//   entry class) must be boot class only.
+//   entry class) must be boot class only. Application sub-graphs from
+//   ArchivedStaticFieldList may also use archived platform and app
+//   classes, see is_archivable_app_subgraph().
 // - No java.lang.Class instance (java mirror) can be included inside
 //   an archived sub-graph. Mirror can only be the sub-graph entry object.
 //
@@ -705,7 +728,7 @@ void HeapShared::archive_reachable_objects_from_static_field(InstanceKlass *k,
                                                              bool is_closed_archive,
                                                              TRAPS) {
   assert(DumpSharedSpaces, "dump time only");
-  assert(k->is_shared_boot_class(), "must be boot class");
+  assert(is_builtin_shared_class(k), "must be boot, platform or app class");
 
   oop m = k->java_mirror();
 
@@ -763,7 +786,7 @@ class VerifySharedOopClosure: public BasicOopIterateClosure {
 
 void HeapShared::verify_subgraph_from_static_field(InstanceKlass* k, int field_offset) {
   assert(DumpSharedSpaces, "dump time only");
-  assert(k->is_shared_boot_class(), "must be boot class");
+  assert(is_builtin_shared_class(k), "must be boot, platform or app class");
 
   oop m = k->java_mirror();
   oop f = m->obj_field(field_offset);
@@ -863,20 +886,22 @@ class ArchivableStaticFieldFinder: public FieldClosure {
   Symbol* _field_name;
   bool _found;
   int _offset;
+  BasicType _type;
 public:
   ArchivableStaticFieldFinder(InstanceKlass* ik, Symbol* field_name) :
-    _ik(ik), _field_name(field_name), _found(false), _offset(-1) {}
+    _ik(ik), _field_name(field_name), _found(false), _offset(-1), _type(T_ILLEGAL) {}
 
   virtual void do_field(fieldDescriptor* fd) {
     if (fd->name() == _field_name) {
       assert(!_found, "fields cannot be overloaded");
-      assert(fd->field_type() == T_OBJECT || fd->field_type() == T_ARRAY, "can archive only obj or array fields");
       _found = true;
       _offset = fd->offset();
+      _type = fd->field_type();
     }
   }
   bool found()     { return _found;  }
   int offset()     { return _offset; }
+  BasicType type() { return _type;   }
 };
 
 void HeapShared::init_subgraph_entry_fields(ArchivableStaticFieldInfo fields[],
@@ -897,12 +922,80 @@ void HeapShared::init_subgraph_entry_fields(ArchivableStaticFieldInfo fields[],
     ArchivableStaticFieldFinder finder(ik, field_name);
     ik->do_local_static_fields(&finder);
     assert(finder.found(), "field must exist");
+    assert(finder.type() == T_OBJECT || finder.type() == T_ARRAY, "can archive only obj or array fields");
 
     info->klass = ik;
     info->offset = finder.offset();
   }
 }
 
+// Reads ArchivedStaticFieldList and initializes the listed classes, so that
+// their static fields hold the objects to archive. Entries that do not name
+// a static reference field of an archived platform or app class are skipped.
+void HeapShared::init_app_subgraph_entry_fields(Thread* THREAD) {
+  FILE* file = fopen(ArchivedStaticFieldList, "rt");
+  if (file == NULL) {
+    log_warning(cds, heap)("Could not open ArchivedStaticFieldList %s", ArchivedStaticFieldList);
+    return;
+  }
+  app_subgraph_entry_fields =
+    new (ResourceObj::C_HEAP, mtClass) GrowableArray<ArchivableStaticFieldInfo>(10, true, mtClass);
+
+  Handle loader(THREAD, SystemDictionary::java_system_loader());
+  char line[1024];
+  while (fgets(line, sizeof(line), file) != NULL) {
+    char klass_buf[512], field_buf[512];
+    if (line[0] == '#' || sscanf(line, "%511s %511s", klass_buf, field_buf) != 2) {
+      continue;
+    }
+    TempNewSymbol klass_name = SymbolTable::new_symbol(klass_buf);
+    TempNewSymbol field_name = SymbolTable::new_symbol(field_buf);
+
+    Klass* k = SystemDictionary::resolve_or_null(klass_name, loader, Handle(), THREAD);
+    if (HAS_PENDING_EXCEPTION) {
+      CLEAR_PENDING_EXCEPTION;
+      k = NULL;
+    }
+    if (k == NULL || !k->is_instance_klass() || k->class_loader() == NULL ||
+        !SystemDictionaryShared::is_builtin(InstanceKlass::cast(k))) {
+      log_warning(cds, heap)("Skipping %s::%s: not an archived platform or app class",
+                             klass_buf, field_buf);
+      continue;
+    }
+    InstanceKlass* ik = InstanceKlass::cast(k);
+    ArchivableStaticFieldFinder finder(ik, field_name);
+    ik->do_local_static_fields(&finder);
+    if (!finder.found() || (finder.type() != T_OBJECT && finder.type() != T_ARRAY)) {
+      log_warning(cds, heap)("Skipping %s::%s: not a static reference field", klass_buf, field_buf);
+      continue;
+    }
+
+    ik->initialize(THREAD);
+    if (HAS_PENDING_EXCEPTION) {
+      CLEAR_PENDING_EXCEPTION;
+      log_warning(cds, heap)("Skipping %s::%s: class initialization failed", klass_buf, field_buf);
+      continue;
+    }
+
+    ArchivableStaticFieldInfo info;
+    // Consecutive fields of the same class share the klass_name pointer, so
+    // that archive_object_subgraphs() records them in one pass.
+    int len = app_subgraph_entry_fields->length();
+    if (len > 0 && app_subgraph_entry_fields->at(len - 1).klass == ik) {
+      info.klass_name = app_subgraph_entry_fields->at(len - 1).klass_name;
+    } else {
+      info.klass_name = os::strdup_check_oom(klass_buf, mtClass);
+    }
+    info.field_name = os::strdup_check_oom(field_buf, mtClass);
+    info.klass = ik;
+    info.offset = finder.offset();
+    info.type = finder.type();
+    app_subgraph_entry_fields->append(info);
+  }
+  fclose(file);
+  log_info(cds, heap)("Application static fields to archive: %d", app_subgraph_entry_fields->length());
+}
+
 void HeapShared::init_subgraph_entry_fields(Thread* THREAD) {
   _dump_time_subgraph_info_table = new (ResourceObj::C_HEAP, mtClass)DumpTimeKlassSubGraphInfoTable();
 
@@ -912,6 +1005,9 @@ void HeapShared::init_subgraph_entry_fields(Thread* THREAD) {
   init_subgraph_entry_fields(open_archive_subgraph_entry_fields,
                              num_open_archive_subgraph_entry_fields,
                              THREAD);
+  if (ArchivedStaticFieldList != NULL && is_heap_object_archiving_allowed()) {
+    init_app_subgraph_entry_fields(THREAD);
+  }
 }
 
 void HeapShared::archive_object_subgraphs(ArchivableStaticFieldInfo fields[],
@@ -967,6 +1063,92 @@ void HeapShared::archive_object_subgraphs(ArchivableStaticFieldInfo fields[],
 #endif
 }
 
+// Pushes the referents of an object onto the worklist of
+// is_archivable_app_subgraph().
+class AppSubgraphWalker: public BasicOopIterateClosure {
+  GrowableArray<oop>* _stack;
+ public:
+  AppSubgraphWalker(GrowableArray<oop>* stack) : _stack(stack) {}
+
+  void do_oop(narrowOop *p) { AppSubgraphWalker::do_oop_work(p); }
+  void do_oop(      oop *p) { AppSubgraphWalker::do_oop_work(p); }
+
+ protected:
+  template <class T> void do_oop_work(T *p) {
+    oop obj = RawAccess<>::oop_load(p);
+    if (!CompressedOops::is_null(obj)) {
+      _stack->push(obj);
+    }
+  }
+};
+
+bool HeapShared::is_builtin_shared_class(InstanceKlass* ik) {
+  return ik->is_shared_boot_class() || ik->is_shared_platform_class() ||
+         ik->is_shared_app_class();
+}
+
+static bool is_archivable_app_object_klass(Klass* k) {
+  if (k->is_objArray_klass()) {
+    k = ObjArrayKlass::cast(k)->bottom_klass();
+  }
+  if (!k->is_instance_klass()) {
+    return true; // type arrays
+  }
+  InstanceKlass* ik = InstanceKlass::cast(k);
+  if (!HeapShared::is_builtin_shared_class(ik) ||
+      SystemDictionaryShared::is_excluded_class(ik)) {
+    return false;
+  }
+  // These hold VM state that cannot be restored from the archive.
+  return !ik->is_subclass_of(SystemDictionary::Reference_klass()) &&
+         !ik->is_subclass_of(SystemDictionary::ClassLoader_klass()) &&
+         !ik->is_subclass_of(SystemDictionary::Thread_klass());
+}
+
+// Unlike the JDK's sub-graphs, the application's are not known to be
+// archivable, and archive_reachable_objects_from() exits the VM on
+// objects it cannot handle. So walk the sub-graph up front.
+bool HeapShared::is_archivable_app_subgraph(oop root) {
+  ResourceMark rm;
+  ResourceHashtable<oop, bool, HeapShared::oop_hash, HeapShared::oop_equals> seen;
+  GrowableArray<oop> stack;
+  AppSubgraphWalker walker(&stack);
+  stack.push(root);
+  while (stack.is_nonempty()) {
+    oop obj = stack.pop();
+    if (!seen.put(obj, true)) {
+      continue;
+    }
+    if (java_lang_Class::is_instance(obj) || !is_archivable_app_object_klass(obj->klass())) {
+      log_info(cds, heap)("Cannot archive object of %s", obj->klass()->external_name());
+      return false;
+    }
+    obj->oop_iterate(&walker);
+  }
+  return true;
+}
+
+void HeapShared::archive_app_object_subgraphs(Thread* THREAD) {
+  if (app_subgraph_entry_fields == NULL) {
+    return;
+  }
+  GrowableArray<ArchivableStaticFieldInfo> fields(app_subgraph_entry_fields->length());
+  for (int i = 0; i < app_subgraph_entry_fields->length(); i++) {
+    ArchivableStaticFieldInfo info = app_subgraph_entry_fields->at(i);
+    oop f = info.klass->java_mirror()->obj_field(info.offset);
+    if (!CompressedOops::is_null(f) && !is_archivable_app_subgraph(f)) {
+      log_warning(cds, heap)("Skipping %s::%s: its object graph cannot be archived",
+                             info.klass_name, info.field_name);
+      continue;
+    }
+    fields.append(info);
+  }
+  if (fields.length() > 0) {
+    archive_object_subgraphs(fields.adr_at(0), fields.length(),
+                             false /* is_closed_archive */, THREAD);
+  }
+}
+
 // At dump-time, find the location of all the non-null oop pointers in an archived heap
 // region. This way we can quickly relocate all the pointers without using
 // BasicOopIterateClosure at runtime.
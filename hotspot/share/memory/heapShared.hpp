@@ -195,6 +195,11 @@ private:
   static void init_subgraph_entry_fields(ArchivableStaticFieldInfo fields[],
                                          int num, Thread* THREAD);
 
+  // Entry fields of application classes, see ArchivedStaticFieldList.
+  static void init_app_subgraph_entry_fields(Thread* THREAD);
+  static bool is_archivable_app_subgraph(oop root);
+  static void archive_app_object_subgraphs(Thread* THREAD);
+
   // Used by decode_from_archive
   static address _narrow_oop_base;
   static int     _narrow_oop_shift;
@@ -266,6 +271,9 @@ private:
   static void copy_closed_archive_heap_objects(GrowableArray<MemRegion> * closed_archive);
   static void copy_open_archive_heap_objects(GrowableArray<MemRegion> * open_archive);
 
+  // Objects of these classes may be part of an archived sub-graph.
+  static bool is_builtin_shared_class(InstanceKlass* ik);
+
   static oop archive_reachable_objects_from(int level,
                                             KlassSubGraphInfo* subgraph_info,
                                             oop orig_obj,
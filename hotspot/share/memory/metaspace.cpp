@@ -977,19 +977,25 @@ void Metaspace::set_narrow_klass_base_and_shift(address metaspace_base, address
   } else {
     CompressedKlassPointers::set_shift(LogKlassAlignmentInBytes);
   }
+  // The range covers everything a narrow klass may decode to, which with
+  // the shift can be more than 4G.
+  CompressedKlassPointers::set_range(MAX2((uint64_t)(higher_address - lower_base),
+                                          UnscaledClassSpaceMax));
   AOTLoader::set_narrow_klass_shift();
 }
 
 #if INCLUDE_CDS
 // Return TRUE if the specified metaspace_base and cds_base are close enough
-// to work with compressed klass pointers.
+// to work with compressed klass pointers. With CDS the narrow klass shift is
+// always LogKlassAlignmentInBytes, so the archive and the class space may
+// span the whole shifted encoding range.
 bool Metaspace::can_use_cds_with_metaspace_addr(char* metaspace_base, address cds_base) {
   assert(cds_base != 0 && UseSharedSpaces, "Only use with CDS");
   assert(UseCompressedClassPointers, "Only use with CompressedKlassPtrs");
   address lower_base = MIN2((address)metaspace_base, cds_base);
   address higher_address = MAX2((address)(cds_base + MetaspaceShared::core_spaces_size()),
                                 (address)(metaspace_base + compressed_class_space_size()));
-  return ((uint64_t)(higher_address - lower_base) <= UnscaledClassSpaceMax);
+  return ((uint64_t)(higher_address - lower_base) <= KlassEncodingMetaspaceMax);
 }
 #endif
 
@@ -1154,6 +1160,15 @@ void Metaspace::ergo_initialize() {
     // Using large pages when dumping the shared archive is currently not implemented.
     FLAG_SET_ERGO(UseLargePagesInMetaspace, false);
   }
+#ifdef LINUX
+  // Transparent huge pages are requested with madvise() for the ranges that
+  // are committed with a large page alignment, so metaspace needs the large
+  // commit granularity to get them.
+  if (UseLargePages && UseTransparentHugePages && !DumpSharedSpaces &&
+      FLAG_IS_DEFAULT(UseLargePagesInMetaspace)) {
+    FLAG_SET_ERGO(UseLargePagesInMetaspace, true);
+  }
+#endif
 
   size_t page_size = os::vm_page_size();
   if (UseLargePages && UseLargePagesInMetaspace) {
@@ -34,7 +34,9 @@
 #include "memory/metaspace/metaspaceStatistics.hpp"
 #include "memory/metaspace/occupancyMap.hpp"
 #include "memory/metaspace/virtualSpaceNode.hpp"
+#include "runtime/globals.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/ostream.hpp"
@@ -132,6 +134,10 @@ bool ChunkManager::attempt_to_coalesce_around_chunk(Metachunk* chunk, ChunkIndex
   // should have changed.
   p_new_chunk->set_is_tagged_free(true);
 
+  if (target_chunk_type == MediumIndex) {
+    uncommit_free_chunk(p_new_chunk);
+  }
+
   // Add new chunk to its freelist.
   ChunkList* const list = free_chunks(target_chunk_type);
   list->return_chunk_at_head(p_new_chunk);
@@ -160,6 +166,21 @@ bool ChunkManager::attempt_to_coalesce_around_chunk(Metachunk* chunk, ChunkIndex
   return true;
 }
 
+void ChunkManager::uncommit_free_chunk(Metachunk* chunk) {
+  if (!MetaspaceUncommitFreeChunks || UseLargePagesInMetaspace) {
+    return;
+  }
+  // Humongous chunks keep their tree node right after the chunk header.
+  const size_t header_size = MAX2(sizeof(Metachunk), sizeof(TreeChunk<Metachunk, FreeList<Metachunk> >));
+  char* const start = align_up((char*)chunk + header_size, os::vm_page_size());
+  char* const end = align_down((char*)chunk + chunk->word_size() * BytesPerWord, os::vm_page_size());
+  if (start < end) {
+    os::free_memory(start, end - start, os::vm_page_size());
+    log_trace(gc, metaspace, freelist)("%s: uncommitted " SIZE_FORMAT " bytes of free chunk " PTR_FORMAT ".",
+        (is_class() ? "class space" : "metaspace"), (size_t)(end - start), p2i(chunk));
+  }
+}
+
 // Remove all chunks in the given area - the chunks are supposed to be free -
 // from their corresponding freelists. Mark them as invalid.
 // - This does not correct the occupancy map.
@@ -554,6 +575,12 @@ void ChunkManager::return_single_chunk(Metachunk* chunk) {
   // may need node for verification later after chunk may have been merged away.
   DEBUG_ONLY(VirtualSpaceNode* vsn = chunk->container(); )
 
+  // Specialized and small chunks are given back once they have been merged
+  // into a medium chunk, see attempt_to_coalesce_around_chunk().
+  if (index == MediumIndex || index == HumongousIndex) {
+    uncommit_free_chunk(chunk);
+  }
+
   if (index != HumongousIndex) {
     // Return non-humongous chunk to freelist.
     ChunkList* list = free_chunks(index);
@@ -79,6 +79,11 @@ class ChunkManager : public CHeapObj<mtInternal> {
   // free chunks to form a bigger chunk. Returns true if successful.
   bool attempt_to_coalesce_around_chunk(Metachunk* chunk, ChunkIndex target_chunk_type);
 
+  // Gives the pages of a free chunk back to the operating system, except
+  // for the page(s) holding the chunk header. The chunk stays committed
+  // and is faulted in again when it is handed out.
+  void uncommit_free_chunk(Metachunk* chunk);
+
   // Helper for chunk merging:
   //  Given an address range with 1-n chunks which are all supposed to be
   //  free and hence currently managed by this ChunkManager, remove them
@@ -257,6 +257,10 @@ public:
   // returns true if we want to keep iterating the pointers embedded inside <ref>
   virtual bool do_ref(Ref* ref, bool read_only) = 0;
 
+  // Method entry points (such as Method::_i2i_entry) are not MetaspaceObj
+  // pointers, but may point into the mc region of the archive.
+  virtual void push_method_entry(address* entry_loc) {}
+
   // When you do:
   //     void MyType::metaspace_pointers_do(MetaspaceClosure* it) {
   //       it->push(_my_field)
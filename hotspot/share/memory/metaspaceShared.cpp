@@ -41,6 +41,7 @@
 #include "interpreter/bytecodes.hpp"
 #include "logging/log.hpp"
 #include "logging/logMessage.hpp"
+#include "memory/archiveUtils.hpp"
 #include "memory/filemap.hpp"
 #include "memory/heapShared.inline.hpp"
 #include "memory/metaspace.hpp"
@@ -239,7 +240,6 @@ void MetaspaceShared::initialize_runtime_shared_and_meta_spaces() {
       // with the archived ones, so it must be done after all encodings are determined.
       mapinfo->map_heap_regions();
     }
-    CompressedKlassPointers::set_range(CompressedClassSpaceSize);
 #endif // _LP64
   } else {
     assert(!mapinfo->is_open() && !UseSharedSpaces,
@@ -344,6 +344,7 @@ void MetaspaceShared::initialize_dumptime_shared_and_meta_spaces() {
 #endif
 
   init_shared_dump_space(&_mc_region);
+  ArchivePtrMarker::initialize(&_shared_vs);
   SharedBaseAddress = (size_t)_shared_rs.base();
   tty->print_cr("Allocated shared space: " SIZE_FORMAT " bytes at " PTR_FORMAT,
                 _shared_rs.size(), p2i(_shared_rs.base()));
@@ -447,6 +448,8 @@ void MetaspaceShared::commit_shared_space_to(char* newtop) {
                                           need_committed_size));
   }
 
+  ArchivePtrMarker::expand_ptr_end();
+
   log_info(cds)("Expanding shared spaces by " SIZE_FORMAT_W(7) " bytes [total " SIZE_FORMAT_W(9)  " bytes ending at %p]",
                 commit, _shared_vs.actual_committed_size(), _shared_vs.high());
 }
@@ -707,6 +710,7 @@ public:
   static void patch(Metadata* obj) {
     assert(DumpSharedSpaces, "dump-time only");
     *(void**)obj = (void*)(_info->cloned_vtable());
+    ArchivePtrMarker::mark_pointer((address*)obj);
   }
 
   static bool is_valid_shared_object(const T* obj) {
@@ -800,7 +804,8 @@ int CppVtableCloner<T>::get_vtable_length(const char* name) {
 }
 
 #define ALLOC_CPP_VTABLE_CLONE(c) \
-  _cloned_cpp_vtptrs[c##_Kind] = CppVtableCloner<c>::allocate(#c);
+  _cloned_cpp_vtptrs[c##_Kind] = CppVtableCloner<c>::allocate(#c); \
+  ArchivePtrMarker::mark_pointer(&_cloned_cpp_vtptrs[c##_Kind]);
 
 #define CLONE_CPP_VTABLE(c) \
   p = CppVtableCloner<c>::clone_vtable(#c, (CppVtableInfo*)p);
@@ -950,6 +955,11 @@ bool MetaspaceShared::is_valid_shared_method(const Method* m) {
   return CppVtableCloner<Method>::is_valid_shared_object(m);
 }
 
+void WriteClosure::do_ptr(void** p) {
+  ArchivePtrMarker::mark_pointer((address*)_dump_region->top());
+  _dump_region->append_intptr_t((intptr_t)*p);
+}
+
 void WriteClosure::do_oop(oop* o) {
   if (*o == NULL) {
     _dump_region->append_intptr_t(0);
@@ -966,7 +976,8 @@ void WriteClosure::do_region(u_char* start, size_t size) {
   assert(size % sizeof(intptr_t) == 0, "bad size");
   do_tag((int)size);
   while (size > 0) {
-    _dump_region->append_intptr_t(*(intptr_t*)start);
+    // The serialized regions are arrays of Symbol*.
+    do_ptr((void**)start);
     start += sizeof(intptr_t);
     size -= sizeof(intptr_t);
   }
@@ -1283,9 +1294,15 @@ private:
     virtual bool do_ref(Ref* ref, bool read_only) {
       if (ref->not_null()) {
         ref->update(get_new_loc(ref));
+        ArchivePtrMarker::mark_pointer(ref->addr());
       }
       return false; // Do not recurse.
     }
+
+    // The method entries already point to their final location in the mc region.
+    virtual void push_method_entry(address* entry_loc) {
+      ArchivePtrMarker::mark_pointer(entry_loc);
+    }
   };
 
 #ifdef ASSERT
@@ -1539,6 +1556,10 @@ void VM_PopulateDumpSharedSpace::doit() {
   // We don't want to write these addresses into the archive.
   MetaspaceShared::zero_cpp_vtable_clones_for_writing();
 
+  // All pointers into the archive have been written now. Keep only the marks
+  // of those that need to be relocated if the archive is mapped elsewhere.
+  ArchivePtrMarker::compact((address)_mc_region.base(), (address)_md_region.end());
+
   // Create and write the archive file that maps the shared spaces.
 
   FileMapInfo* mapinfo = new FileMapInfo(true);
@@ -1582,6 +1603,8 @@ void VM_PopulateDumpSharedSpace::doit() {
                                         MetaspaceShared::first_open_archive_heap_region,
                                         MetaspaceShared::max_open_archive_heap_region,
                                         print_archive_log);
+
+    mapinfo->write_bitmap_region(ArchivePtrMarker::ptrmap());
   }
 
   mapinfo->close();
@@ -2013,6 +2036,7 @@ bool MetaspaceShared::map_shared_spaces(FileMapInfo* mapinfo) {
   char* top = mapinfo->map_regions(regions, saved_base, len );
 
   if (top != NULL &&
+      (!mapinfo->is_relocated() || mapinfo->relocate_pointers()) &&
       (image_alignment == (size_t)os::vm_allocation_granularity()) &&
       mapinfo->validate_shared_path_table()) {
     // Success -- set up MetaspaceObj::_shared_metaspace_{base,top} for
@@ -116,18 +116,14 @@ public:
     _dump_region = r;
   }
 
-  void do_ptr(void** p) {
-    _dump_region->append_intptr_t((intptr_t)*p);
-  }
+  void do_ptr(void** p);
 
   void do_u4(u4* p) {
-    void* ptr = (void*)(uintx(*p));
-    do_ptr(&ptr);
+    _dump_region->append_intptr_t((intptr_t)(uintx(*p)));
   }
 
   void do_bool(bool *p) {
-    void* ptr = (void*)(uintx(*p));
-    do_ptr(&ptr);
+    _dump_region->append_intptr_t((intptr_t)(uintx(*p)));
   }
 
   void do_tag(int tag) {
@@ -205,7 +201,10 @@ class MetaspaceShared : AllStatic {
     max_open_archive_heap_region = 2,
     last_open_archive_heap_region = first_open_archive_heap_region + max_open_archive_heap_region - 1,
 
-    last_valid_region = last_open_archive_heap_region,
+    // relocation bitmap of the core spaces, see ArchivePtrMarker
+    bm = last_open_archive_heap_region + 1,
+
+    last_valid_region = bm,
     n_regions =  last_valid_region + 1 // total number of regions
   };
 
@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "gc/shared/pretouchTask.hpp"
 #include "logging/log.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/virtualspace.hpp"
@@ -801,17 +802,17 @@ bool VirtualSpace::contains(const void* p) const {
   return low() <= (const char*) p && (const char*) p < high();
 }
 
-static void pretouch_expanded_memory(void* start, void* end) {
+static void pretouch_expanded_memory(char* start, char* end, size_t page_size) {
   assert(is_aligned(start, os::vm_page_size()), "Unexpected alignment");
   assert(is_aligned(end,   os::vm_page_size()), "Unexpected alignment");
 
-  os::pretouch_memory(start, end);
+  PretouchTask::pretouch("PreTouch", start, end, page_size, PretouchTask::default_gang());
 }
 
 static bool commit_expanded(char* start, size_t size, size_t alignment, bool pre_touch, bool executable) {
   if (os::commit_memory(start, size, alignment, executable)) {
     if (pre_touch || AlwaysPreTouch) {
-      pretouch_expanded_memory(start, start + size);
+      pretouch_expanded_memory(start, start + size, alignment);
     }
     return true;
   }
@@ -223,6 +223,12 @@ namespace AccessInternal {
       HasDecorator<ds, INTERNAL_VALUE_IS_OOP>::value,
       FunctionPointerT>::type
     resolve_barrier_gc() {
+#ifdef ACCESS_HARDWIRED_BARRIER_SET
+      assert(BarrierSet::barrier_set() != NULL, "GC barriers invoked before BarrierSet is set");
+      assert(BarrierSet::barrier_set()->kind() == BarrierSet::GetName<ACCESS_HARDWIRED_BARRIER_SET>::value,
+             "must be the only barrier set in the build");
+      return PostRuntimeDispatch<ACCESS_HARDWIRED_BARRIER_SET::AccessBarrier<ds>, barrier_type, ds>::oop_access_barrier;
+#else
       BarrierSet* bs = BarrierSet::barrier_set();
       assert(bs != NULL, "GC barriers invoked before BarrierSet is set");
       switch (bs->kind()) {
@@ -239,6 +245,7 @@ namespace AccessInternal {
         fatal("BarrierSet AccessBarrier resolving not implemented");
         return NULL;
       };
+#endif
     }
 
     template <DecoratorSet ds>
@@ -246,6 +253,12 @@ namespace AccessInternal {
       !HasDecorator<ds, INTERNAL_VALUE_IS_OOP>::value,
       FunctionPointerT>::type
     resolve_barrier_gc() {
+#ifdef ACCESS_HARDWIRED_BARRIER_SET
+      assert(BarrierSet::barrier_set() != NULL, "GC barriers invoked before BarrierSet is set");
+      assert(BarrierSet::barrier_set()->kind() == BarrierSet::GetName<ACCESS_HARDWIRED_BARRIER_SET>::value,
+             "must be the only barrier set in the build");
+      return PostRuntimeDispatch<ACCESS_HARDWIRED_BARRIER_SET::AccessBarrier<ds>, barrier_type, ds>::access_barrier;
+#else
       BarrierSet* bs = BarrierSet::barrier_set();
       assert(bs != NULL, "GC barriers invoked before BarrierSet is set");
       switch (bs->kind()) {
@@ -262,6 +275,7 @@ namespace AccessInternal {
         fatal("BarrierSet AccessBarrier resolving not implemented");
         return NULL;
       };
+#endif
     }
 
     static FunctionPointerT resolve_barrier_rt() {
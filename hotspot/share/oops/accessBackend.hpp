@@ -463,6 +463,22 @@ namespace AccessInternal {
   // it resolves which accessor to be used in future invocations and patches the
   // function pointer to this new accessor.
 
+  template <DecoratorSet decorators, typename FunctionPointerT, BarrierType barrier_type>
+  struct BarrierResolver;
+
+  // With a single barrier set in the build, only compressed oops remain to be
+  // resolved at runtime, and that is a plain branch to a direct call.
+#ifdef ACCESS_HARDWIRED_BARRIER_SET
+#define ACCESS_RUNTIME_DISPATCH(barrier_type, func, args)                               \
+  (UseCompressedOops                                                                    \
+   ? BarrierResolver<decorators, func_t, barrier_type>::template                        \
+       resolve_barrier_gc<decorators | INTERNAL_RT_USE_COMPRESSED_OOPS>() args          \
+   : BarrierResolver<decorators, func_t, barrier_type>::template                        \
+       resolve_barrier_gc<decorators>() args)
+#else
+#define ACCESS_RUNTIME_DISPATCH(barrier_type, func, args) func args
+#endif
+
   template <DecoratorSet decorators, typename T, BarrierType type>
   struct RuntimeDispatch: AllStatic {};
 
@@ -474,7 +490,7 @@ namespace AccessInternal {
     static void store_init(void* addr, T value);
 
     static inline void store(void* addr, T value) {
-      _store_func(addr, value);
+      ACCESS_RUNTIME_DISPATCH(BARRIER_STORE, _store_func, (addr, value));
     }
   };
 
@@ -486,7 +502,7 @@ namespace AccessInternal {
     static void store_at_init(oop base, ptrdiff_t offset, T value);
 
     static inline void store_at(oop base, ptrdiff_t offset, T value) {
-      _store_at_func(base, offset, value);
+      ACCESS_RUNTIME_DISPATCH(BARRIER_STORE_AT, _store_at_func, (base, offset, value));
     }
   };
 
@@ -498,7 +514,7 @@ namespace AccessInternal {
     static T load_init(void* addr);
 
     static inline T load(void* addr) {
-      return _load_func(addr);
+      return ACCESS_RUNTIME_DISPATCH(BARRIER_LOAD, _load_func, (addr));
     }
   };
 
@@ -510,7 +526,7 @@ namespace AccessInternal {
     static T load_at_init(oop base, ptrdiff_t offset);
 
     static inline T load_at(oop base, ptrdiff_t offset) {
-      return _load_at_func(base, offset);
+      return ACCESS_RUNTIME_DISPATCH(BARRIER_LOAD_AT, _load_at_func, (base, offset));
     }
   };
 
@@ -522,7 +538,7 @@ namespace AccessInternal {
     static T atomic_cmpxchg_init(T new_value, void* addr, T compare_value);
 
     static inline T atomic_cmpxchg(T new_value, void* addr, T compare_value) {
-      return _atomic_cmpxchg_func(new_value, addr, compare_value);
+      return ACCESS_RUNTIME_DISPATCH(BARRIER_ATOMIC_CMPXCHG, _atomic_cmpxchg_func, (new_value, addr, compare_value));
     }
   };
 
@@ -534,7 +550,7 @@ namespace AccessInternal {
     static T atomic_cmpxchg_at_init(T new_value, oop base, ptrdiff_t offset, T compare_value);
 
     static inline T atomic_cmpxchg_at(T new_value, oop base, ptrdiff_t offset, T compare_value) {
-      return _atomic_cmpxchg_at_func(new_value, base, offset, compare_value);
+      return ACCESS_RUNTIME_DISPATCH(BARRIER_ATOMIC_CMPXCHG_AT, _atomic_cmpxchg_at_func, (new_value, base, offset, compare_value));
     }
   };
 
@@ -546,7 +562,7 @@ namespace AccessInternal {
     static T atomic_xchg_init(T new_value, void* addr);
 
     static inline T atomic_xchg(T new_value, void* addr) {
-      return _atomic_xchg_func(new_value, addr);
+      return ACCESS_RUNTIME_DISPATCH(BARRIER_ATOMIC_XCHG, _atomic_xchg_func, (new_value, addr));
     }
   };
 
@@ -558,7 +574,7 @@ namespace AccessInternal {
     static T atomic_xchg_at_init(T new_value, oop base, ptrdiff_t offset);
 
     static inline T atomic_xchg_at(T new_value, oop base, ptrdiff_t offset) {
-      return _atomic_xchg_at_func(new_value, base, offset);
+      return ACCESS_RUNTIME_DISPATCH(BARRIER_ATOMIC_XCHG_AT, _atomic_xchg_at_func, (new_value, base, offset));
     }
   };
 
@@ -574,9 +590,10 @@ namespace AccessInternal {
     static inline bool arraycopy(arrayOop src_obj, size_t src_offset_in_bytes, T* src_raw,
                                  arrayOop dst_obj, size_t dst_offset_in_bytes, T* dst_raw,
                                  size_t length) {
-      return _arraycopy_func(src_obj, src_offset_in_bytes, src_raw,
-                             dst_obj, dst_offset_in_bytes, dst_raw,
-                             length);
+      return ACCESS_RUNTIME_DISPATCH(BARRIER_ARRAYCOPY, _arraycopy_func,
+                                     (src_obj, src_offset_in_bytes, src_raw,
+                                      dst_obj, dst_offset_in_bytes, dst_raw,
+                                      length));
     }
   };
 
@@ -588,7 +605,7 @@ namespace AccessInternal {
     static void clone_init(oop src, oop dst, size_t size);
 
     static inline void clone(oop src, oop dst, size_t size) {
-      _clone_func(src, dst, size);
+      ACCESS_RUNTIME_DISPATCH(BARRIER_CLONE, _clone_func, (src, dst, size));
     }
   };
 
@@ -600,7 +617,7 @@ namespace AccessInternal {
     static oop resolve_init(oop obj);
 
     static inline oop resolve(oop obj) {
-      return _resolve_func(obj);
+      return ACCESS_RUNTIME_DISPATCH(BARRIER_RESOLVE, _resolve_func, (obj));
     }
   };
 
@@ -612,10 +629,12 @@ namespace AccessInternal {
     static bool equals_init(oop o1, oop o2);
 
     static inline bool equals(oop o1, oop o2) {
-      return _equals_func(o1, o2);
+      return ACCESS_RUNTIME_DISPATCH(BARRIER_EQUALS, _equals_func, (o1, o2));
     }
   };
 
+#undef ACCESS_RUNTIME_DISPATCH
+
   // Initialize the function pointers to point to the resolving function.
   template <DecoratorSet decorators, typename T>
   typename AccessFunction<decorators, T, BARRIER_STORE>::type
@@ -408,6 +408,8 @@ void ConstMethod::metaspace_pointers_do(MetaspaceClosure* it) {
 
   it->push(&_constants);
   it->push(&_stackmap_data);
+  // Only meaningful for archived methods; see Method::unlink_method().
+  it->push_method_entry((address*)&_adapter_trampoline);
   if (has_method_annotations()) {
     it->push(method_annotations_addr());
   }
@@ -47,6 +47,7 @@
 #include "logging/logStream.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/heapInspection.hpp"
+#include "memory/heapShared.hpp"
 #include "memory/iterator.inline.hpp"
 #include "memory/metadataFactory.hpp"
 #include "memory/metaspaceClosure.hpp"
@@ -805,7 +806,8 @@ bool InstanceKlass::link_class_impl(TRAPS) {
                              ClassLoader::perf_classes_linked(),
                              jt->get_thread_stat()->perf_recursion_counts_addr(),
                              jt->get_thread_stat()->perf_timers_addr(),
-                             PerfClassTraceTime::CLASS_LINK);
+                             PerfClassTraceTime::CLASS_LINK,
+                             class_loader_data());
 
   // verification & rewriting
   {
@@ -1019,6 +1021,15 @@ void InstanceKlass::initialize_impl(TRAPS) {
   // Look for aot compiled methods for this klass, including class initializer.
   AOTLoader::load_for_klass(this, THREAD);
 
+#if INCLUDE_CDS_JAVA_HEAP
+  // Restore the static fields of application classes that were archived
+  // with ArchivedStaticFieldList. Like the JDK's archived fields, they are
+  // expected to be non-final and only computed by <clinit> when still null.
+  if (is_shared() && class_loader() != NULL) {
+    HeapShared::initialize_from_archived_subgraph(this);
+  }
+#endif
+
   // Step 8
   {
     DTRACE_CLASSINIT_PROBE_WAIT(clinit, -1, wait);
@@ -1029,7 +1040,8 @@ void InstanceKlass::initialize_impl(TRAPS) {
                              ClassLoader::perf_classes_inited(),
                              jt->get_thread_stat()->perf_recursion_counts_addr(),
                              jt->get_thread_stat()->perf_timers_addr(),
-                             PerfClassTraceTime::CLASS_CLINIT);
+                             PerfClassTraceTime::CLASS_CLINIT,
+                             class_loader_data());
     call_class_initializer(THREAD);
   }
 
@@ -1368,7 +1380,7 @@ void InstanceKlass::mask_for(const methodHandle& method, int bci,
     MutexLocker x(OopMapCacheAlloc_lock);
     // Check if _oop_map_cache was allocated while we were waiting for this lock
     if ((oop_map_cache = _oop_map_cache) == NULL) {
-      oop_map_cache = new OopMapCache();
+      oop_map_cache = new OopMapCache(methods()->length());
       // Ensure _oop_map_cache is stable, since it is examined without a lock
       OrderAccess::release_store(&_oop_map_cache, oop_map_cache);
     }
@@ -2238,6 +2250,11 @@ bool InstanceKlass::should_store_fingerprint(bool is_unsafe_anonymous) {
     return true;
   }
 #endif
+  if (VerificationCacheFile != NULL && !is_unsafe_anonymous &&
+      !DumpSharedSpaces && !DynamicDumpSharedSpaces) {
+    // (4) The verification cache identifies classes by their fingerprint
+    return true;
+  }
 
   // In all other cases we might set the _misc_has_passed_fingerprint_check bit,
   // but do not store the 64-bit fingerprint to save space.
@@ -2248,7 +2265,8 @@ bool InstanceKlass::has_stored_fingerprint() const {
 #if INCLUDE_AOT
   return should_store_fingerprint() || is_shared();
 #else
-  return false;
+  // Archived classes were dumped without the fingerprint.
+  return should_store_fingerprint() && !is_shared();
 #endif
 }
 
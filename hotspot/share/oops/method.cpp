@@ -28,6 +28,7 @@
 #include "classfile/systemDictionary.hpp"
 #include "code/codeCache.hpp"
 #include "code/debugInfoRec.hpp"
+#include "compiler/profileSnapshot.hpp"
 #include "gc/shared/collectedHeap.inline.hpp"
 #include "interpreter/bytecodeStream.hpp"
 #include "interpreter/bytecodeTracer.hpp"
@@ -336,6 +337,9 @@ void Method::metaspace_pointers_do(MetaspaceClosure* it) {
   it->push(&_constMethod);
   it->push(&_method_data);
   it->push(&_method_counters);
+  it->push_method_entry(&_i2i_entry);
+  it->push_method_entry((address*)&_from_compiled_entry);
+  it->push_method_entry((address*)&_from_interpreted_entry);
 }
 
 // Attempt to return method oop to original state.  Clear any pointers
@@ -471,6 +475,8 @@ MethodCounters* Method::build_method_counters(Method* m, TRAPS) {
   }
   if (!mh->init_method_counters(counters)) {
     MetadataFactory::free_metadata(mh->method_holder()->class_loader_data(), counters);
+  } else {
+    ProfileSnapshot::apply(mh(), counters);
   }
 
   if (LogTouchedMethods) {
@@ -2377,6 +2377,13 @@ public:
     }
   }
 
+  // Makes trap_count() return (uint)-1, so that the compilers consider
+  // there were too many traps for the reason.
+  void saturate_trap_count(int reason) {
+    assert((uint)reason < JVMCI_ONLY(2*) _trap_hist_limit, "oob");
+    _trap_hist._array[reason] = _trap_hist_mask;
+  }
+
   uint overflow_trap_count() const {
     return _nof_overflow_traps;
   }
@@ -333,12 +333,17 @@
   product(bool, UseSuperWord, true,                                         \
           "Transform scalar operations into superword operations")          \
                                                                             \
-  develop(bool, SuperWordRTDepCheck, false,                                 \
-          "Enable runtime dependency checks.")                              \
+  product(bool, SuperWordRTDepCheck, true,                                  \
+          "Vectorize loops over arrays that may be the same array, "        \
+          "guarded by a runtime check that they are different arrays")      \
                                                                             \
   product(bool, SuperWordReductions, true,                                  \
           "Enable reductions support in superword.")                        \
                                                                             \
+  product(bool, SuperWordUnorderedFPReductions, false,                      \
+          "Allow superword to reassociate floating-point add and multiply " \
+          "reductions, which may change the rounding of the result")        \
+                                                                            \
   product(bool, UseCMoveUnconditionally, false,                             \
           "Use CMove (scalar and vector) ignoring profitability test.")     \
                                                                             \
@@ -535,6 +540,10 @@
   product(bool, EliminateAllocations, true,                                 \
           "Use escape analysis to eliminate allocations")                   \
                                                                             \
+  product(bool, ReduceAllocationMerges, true,                               \
+          "Split field loads through phis merging new objects, so that "    \
+          "escape analysis can scalar replace the objects")                 \
+                                                                            \
   notproduct(bool, PrintEliminateAllocations, false,                        \
           "Print out when allocations are eliminated")                      \
                                                                             \
@@ -701,6 +710,18 @@
           "max number of live nodes in a method")                           \
           range(0, max_juint / 8)                                           \
                                                                             \
+  product(intx, C2OptimizationTimeBudget, 0,                                \
+          "Milliseconds after which a compilation skips optional "          \
+          "optimizations such as loop opts and escape analysis; "           \
+          "0 means no limit")                                               \
+          range(0, max_jint)                                                \
+                                                                            \
+  product(intx, C2OptimizationNodeBudget, 0,                                \
+          "Number of live nodes above which a compilation skips optional "  \
+          "optimizations such as loop opts and escape analysis; "           \
+          "0 means no limit")                                               \
+          range(0, max_jint)                                                \
+                                                                            \
   diagnostic(bool, OptimizeExpensiveOps, true,                              \
           "Find best control for expensive operations")                     \
                                                                             \
@@ -749,11 +770,15 @@
                                                                             \
   product(uintx, LoopStripMiningIter, 0,                                    \
           "Number of iterations in strip mined loop")                       \
-          range(0, max_juint)                                               \
+          range(0, max_jint)                                                \
                                                                             \
   product(uintx, LoopStripMiningIterShortLoop, 0,                           \
           "Loop with fewer iterations are not strip mined")                 \
-          range(0, max_juint)                                               \
+          range(0, max_jint)                                                \
+                                                                            \
+  product(bool, UseProfiledLoopStripMining, true,                           \
+          "Use the profiled trip count of a strip mined loop for the "      \
+          "branch profile of its outer loop")                               \
                                                                             \
   product(bool, UseProfiledLoopPredicate, true,                             \
           "move predicates out of loops based on profiling data")           \
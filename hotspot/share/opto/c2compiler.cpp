@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "compiler/compileTask.hpp"
 #include "runtime/handles.inline.hpp"
 #include "jfr/support/jfrIntrinsics.hpp"
 #include "opto/c2compiler.hpp"
@@ -150,6 +151,10 @@ void C2Compiler::compile_method(ciEnv* env, ciMethod* target, int entry_bci, Dir
       }
     }
 
+    if (env->task() != NULL) {
+      env->task()->set_optimizations_skipped(C.optimizations_skipped());
+    }
+
     // print inlining for last compilation only
     C.dump_print_inlining();
 
@@ -453,6 +458,11 @@ bool C2Compiler::is_intrinsic_supported(const methodHandle& method, bool is_virt
   case vmIntrinsics::_minD:
     if (!Matcher::match_rule_supported(Op_MinD)) return false;
     break;
+  case vmIntrinsics::_indexOfL_char:
+    // Only x86 has a match rule for Latin1 StrIndexOfChar nodes.
+    NOT_X86(return false;)
+    if (!Matcher::match_rule_supported(Op_StrIndexOfChar)) return false;
+    break;
   case vmIntrinsics::_hashCode:
   case vmIntrinsics::_identityHashCode:
   case vmIntrinsics::_getClass:
@@ -613,6 +623,7 @@ bool C2Compiler::is_intrinsic_supported(const methodHandle& method, bool is_virt
   case vmIntrinsics::_montgomeryMultiply:
   case vmIntrinsics::_montgomerySquare:
   case vmIntrinsics::_vectorizedMismatch:
+  case vmIntrinsics::_vectorizedHashCode:
   case vmIntrinsics::_ghash_processBlocks:
   case vmIntrinsics::_base64_encodeBlock:
   case vmIntrinsics::_updateCRC32:
@@ -559,8 +559,9 @@ void PhaseChaitin::Register_Allocate() {
     _ifg->SquareUp();
     _ifg->Compute_Effective_Degree();
 
-    // Only do conservative coalescing if requested
-    if (OptoCoalesce) {
+    // Only do conservative coalescing if requested, and skip it on
+    // further rounds once the compilation is over its budget.
+    if (OptoCoalesce && !C->over_optimization_budget()) {
       Compile::TracePhase tp("chaitinCoalesce3", &timers[_t_chaitinCoalesce3]);
       // Conservative (and pessimistic) copy coalescing
       PhaseConservativeCoalesce coalesce(*this);
@@ -411,6 +411,11 @@ macro(ExtractI)
 macro(ExtractL)
 macro(ExtractF)
 macro(ExtractD)
+macro(VectorCastB2X)
+macro(VectorUCastB2X)
+macro(VectorCastS2X)
+macro(VectorUCastS2X)
+macro(VectorCastI2X)
 macro(Digit)
 macro(LowerCase)
 macro(UpperCase)
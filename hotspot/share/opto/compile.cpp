@@ -655,6 +655,8 @@ Compile::Compile( ciEnv* ci_env, C2Compiler* compiler, ciMethod* target, int osr
 #endif
                   _has_method_handle_invokes(false),
                   _clinit_barrier_on_entry(false),
+                  _start_ticks(os::elapsed_counter()),
+                  _over_optimization_budget(false),
                   _comp_arena(mtCompiler),
                   _barrier_set_state(BarrierSet::barrier_set()->barrier_set_c2()->create_barrier_state(comp_arena())),
                   _env(ci_env),
@@ -990,6 +992,8 @@ Compile::Compile( ciEnv* ci_env,
 #endif
     _has_method_handle_invokes(false),
     _clinit_barrier_on_entry(false),
+    _start_ticks(os::elapsed_counter()),
+    _over_optimization_budget(false),
     _comp_arena(mtCompiler),
     _env(ci_env),
     _directive(directive),
@@ -2116,6 +2120,9 @@ void Compile::inline_incrementally(PhaseIterGVN& igvn) {
   uint low_live_nodes = 0;
 
   while (_late_inlines.length() > 0) {
+    if (over_optimization_budget()) {
+      break; // leave the remaining calls as they are
+    }
     if (live_nodes() > (uint)LiveNodeCountInliningCutoff) {
       if (low_live_nodes < (uint)LiveNodeCountInliningCutoff * 8 / 10) {
         TracePhase tp("incrementalInline_ideal", &timers[_t_incrInline_ideal]);
@@ -2164,10 +2171,40 @@ void Compile::inline_incrementally(PhaseIterGVN& igvn) {
 }
 
 
+bool Compile::over_optimization_budget() {
+  if (_over_optimization_budget) {
+    return true;
+  }
+  jlong elapsed_ms = (os::elapsed_counter() - _start_ticks) * 1000 / os::elapsed_frequency();
+  const char* reason = NULL;
+  if (C2OptimizationNodeBudget > 0 && live_nodes() > (uint)C2OptimizationNodeBudget) {
+    reason = "nodes";
+  } else if (C2OptimizationTimeBudget > 0 && elapsed_ms > C2OptimizationTimeBudget) {
+    reason = "time";
+  }
+  if (reason == NULL) {
+    return false;
+  }
+  _over_optimization_budget = true;
+  // No more loop optimization rounds.
+  _loop_opts_cnt = 0;
+  if (log() != NULL) {
+    log()->elem("optimization_budget reason='%s' elapsed_ms='" JLONG_FORMAT "' live_nodes='%u'",
+                reason, elapsed_ms, live_nodes());
+  }
+#ifndef PRODUCT
+  if (PrintOpto) {
+    tty->print_cr("Optimization budget exceeded (%s): " JLONG_FORMAT " ms, %u live nodes",
+                  reason, elapsed_ms, live_nodes());
+  }
+#endif
+  return true;
+}
+
 bool Compile::optimize_loops(PhaseIterGVN& igvn, LoopOptsMode mode) {
   if(_loop_opts_cnt > 0) {
     debug_only( int cnt = 0; );
-    while(major_progress() && (_loop_opts_cnt > 0)) {
+    while(major_progress() && !over_optimization_budget() && (_loop_opts_cnt > 0)) {
       TracePhase tp("idealLoop", &timers[_t_idealLoop]);
       assert( cnt++ < 40, "infinite cycle in loop optimization" );
       PhaseIdealLoop::optimize(igvn, mode);
@@ -2288,7 +2325,8 @@ void Compile::Optimize() {
   }
 
   // Perform escape analysis
-  if (_do_escape_analysis && ConnectionGraph::has_candidates(this)) {
+  if (_do_escape_analysis && !over_optimization_budget() &&
+      ConnectionGraph::has_candidates(this)) {
     if (has_loops()) {
       // Cleanup graph (remove dead nodes).
       TracePhase tp("idealLoop", &timers[_t_idealLoop]);
@@ -2323,7 +2361,7 @@ void Compile::Optimize() {
   // peeling, unrolling, etc.
 
   // Set loop opts counter
-  if((_loop_opts_cnt > 0) && (has_loops() || has_split_ifs())) {
+  if(!over_optimization_budget() && (_loop_opts_cnt > 0) && (has_loops() || has_split_ifs())) {
     {
       TracePhase tp("idealLoop", &timers[_t_idealLoop]);
       PhaseIdealLoop::optimize(igvn, LoopOptsDefault);
@@ -2332,7 +2370,7 @@ void Compile::Optimize() {
       if (failing())  return;
     }
     // Loop opts pass if partial peeling occurred in previous pass
-    if(PartialPeelLoop && major_progress() && (_loop_opts_cnt > 0)) {
+    if(PartialPeelLoop && major_progress() && !over_optimization_budget() && (_loop_opts_cnt > 0)) {
       TracePhase tp("idealLoop", &timers[_t_idealLoop]);
       PhaseIdealLoop::optimize(igvn, LoopOptsSkipSplitIf);
       _loop_opts_cnt--;
@@ -2340,7 +2378,7 @@ void Compile::Optimize() {
       if (failing())  return;
     }
     // Loop opts pass for loop-unrolling before CCP
-    if(major_progress() && (_loop_opts_cnt > 0)) {
+    if(major_progress() && !over_optimization_budget() && (_loop_opts_cnt > 0)) {
       TracePhase tp("idealLoop", &timers[_t_idealLoop]);
       PhaseIdealLoop::optimize(igvn, LoopOptsSkipSplitIf);
       _loop_opts_cnt--;
@@ -418,6 +418,8 @@ class Compile : public Phase {
   RTMState              _rtm_state;             // State of Restricted Transactional Memory usage
   int                   _loop_opts_cnt;         // loop opts round
   bool                  _clinit_barrier_on_entry; // True if clinit barrier is needed on nmethod entry
+  jlong                 _start_ticks;           // os::elapsed_counter() when the compilation started
+  bool                  _over_optimization_budget; // True once optional optimizations are skipped
 
   // Compilation environment.
   Arena                 _comp_arena;            // Arena with lifetime equivalent to Compile
@@ -720,6 +722,13 @@ class Compile : public Phase {
   bool              clinit_barrier_on_entry()       { return _clinit_barrier_on_entry; }
   void          set_clinit_barrier_on_entry(bool z) { _clinit_barrier_on_entry = z; }
 
+  // True once this compilation has used up its time or node budget
+  // (C2OptimizationTimeBudget, C2OptimizationNodeBudget). From then on,
+  // optional and expensive optimizations are skipped rather than bailing
+  // out of the compilation.
+  bool              over_optimization_budget();
+  bool              optimizations_skipped() const { return _over_optimization_budget; }
+
   // check the CompilerOracle for special behaviours for this compile
   bool          method_has_option(const char * option) {
     return method() != NULL && method()->has_option(option);
@@ -217,7 +217,7 @@ class LibraryCallKit : public GraphKit {
   bool inline_string_indexOfI(StrIntrinsicNode::ArgEnc ae);
   Node* make_indexOf_node(Node* src_start, Node* src_count, Node* tgt_start, Node* tgt_count,
                           RegionNode* region, Node* phi, StrIntrinsicNode::ArgEnc ae);
-  bool inline_string_indexOfChar();
+  bool inline_string_indexOfChar(StrIntrinsicNode::ArgEnc ae);
   bool inline_string_equals(StrIntrinsicNode::ArgEnc ae);
   bool inline_string_toBytesU();
   bool inline_string_getCharsU();
@@ -324,6 +324,7 @@ class LibraryCallKit : public GraphKit {
   bool inline_montgomeryMultiply();
   bool inline_montgomerySquare();
   bool inline_vectorizedMismatch();
+  bool inline_vectorizedHashCode();
   bool inline_fma(vmIntrinsics::ID id);
   bool inline_character_compare(vmIntrinsics::ID id);
   bool inline_fp_min_max(vmIntrinsics::ID id);
@@ -578,7 +579,8 @@ bool LibraryCallKit::try_to_inline(int predicate) {
   case vmIntrinsics::_indexOfIL:                return inline_string_indexOfI(StrIntrinsicNode::LL);
   case vmIntrinsics::_indexOfIU:                return inline_string_indexOfI(StrIntrinsicNode::UU);
   case vmIntrinsics::_indexOfIUL:               return inline_string_indexOfI(StrIntrinsicNode::UL);
-  case vmIntrinsics::_indexOfU_char:            return inline_string_indexOfChar();
+  case vmIntrinsics::_indexOfU_char:            return inline_string_indexOfChar(StrIntrinsicNode::U);
+  case vmIntrinsics::_indexOfL_char:            return inline_string_indexOfChar(StrIntrinsicNode::L);
 
   case vmIntrinsics::_equalsL:                  return inline_string_equals(StrIntrinsicNode::LL);
   case vmIntrinsics::_equalsU:                  return inline_string_equals(StrIntrinsicNode::UU);
@@ -835,6 +837,9 @@ bool LibraryCallKit::try_to_inline(int predicate) {
   case vmIntrinsics::_vectorizedMismatch:
     return inline_vectorizedMismatch();
 
+  case vmIntrinsics::_vectorizedHashCode:
+    return inline_vectorizedHashCode();
+
   case vmIntrinsics::_ghash_processBlocks:
     return inline_ghash_processBlocks();
   case vmIntrinsics::_base64_encodeBlock:
@@ -1416,7 +1421,7 @@ Node* LibraryCallKit::make_indexOf_node(Node* src_start, Node* src_count, Node*
 }
 
 //-----------------------------inline_string_indexOfChar-----------------------
-bool LibraryCallKit::inline_string_indexOfChar() {
+bool LibraryCallKit::inline_string_indexOfChar(StrIntrinsicNode::ArgEnc ae) {
   if (too_many_traps(Deoptimization::Reason_intrinsic)) {
     return false;
   }
@@ -1432,12 +1437,12 @@ bool LibraryCallKit::inline_string_indexOfChar() {
   src = must_be_not_null(src, true);
   src = access_resolve(src, ACCESS_READ);
 
-  Node* src_offset = _gvn.transform(new LShiftINode(from_index, intcon(1)));
+  Node* src_offset = ae == StrIntrinsicNode::L ? from_index : _gvn.transform(new LShiftINode(from_index, intcon(1)));
   Node* src_start = array_element_address(src, src_offset, T_BYTE);
   Node* src_count = _gvn.transform(new SubINode(max, from_index));
 
   // Range checks
-  generate_string_range_check(src, src_offset, src_count, true);
+  generate_string_range_check(src, src_offset, src_count, ae == StrIntrinsicNode::U);
   if (stopped()) {
     return true;
   }
@@ -1445,7 +1450,7 @@ bool LibraryCallKit::inline_string_indexOfChar() {
   RegionNode* region = new RegionNode(3);
   Node* phi = new PhiNode(region, TypeInt::INT);
 
-  Node* result = new StrIndexOfCharNode(control(), memory(TypeAryPtr::BYTES), src_start, src_count, tgt, StrIntrinsicNode::none);
+  Node* result = new StrIndexOfCharNode(control(), memory(TypeAryPtr::BYTES), src_start, src_count, tgt, ae);
   C->set_has_split_ifs(true); // Has chance for split-if optimization
   _gvn.transform(result);
 
@@ -5404,6 +5409,52 @@ bool LibraryCallKit::inline_vectorizedMismatch() {
   return true;
 }
 
+//-------------inline_vectorizedHashCode------------------------------
+bool LibraryCallKit::inline_vectorizedHashCode() {
+  assert(UseVectorizedHashCodeIntrinsic, "not implementated on this platform");
+  assert(callee()->signature()->size() == 5, "vectorizedHashCode has 5 parameters");
+
+  Node* array = argument(0);
+  Node* offset = argument(1);
+  Node* length = argument(2);
+  Node* initial = argument(3);
+  Node* basic_type = argument(4);
+
+  // The stub is specialized for the element type.
+  const TypeInt* bt_type = basic_type->Value(&_gvn)->isa_int();
+  if (bt_type == NULL || !bt_type->is_con()) {
+    return false;
+  }
+  BasicType bt = (BasicType)bt_type->get_con();
+  address stubAddr = StubRoutines::vectorizedHashCode(bt);
+  if (stubAddr == NULL) {
+    return false; // Intrinsic's stub is not implemented on this platform
+  }
+  const char* stubName = "vectorizedHashCode";
+
+  // T_BOOLEAN hashes the bytes of a byte[] as unsigned values.
+  BasicType elem_bt = (bt == T_BOOLEAN) ? T_BYTE : bt;
+  const TypeAryPtr* top = array->Value(&_gvn)->isa_aryptr();
+  if (top == NULL || top->klass() == NULL || top->elem() == Type::BOTTOM ||
+      top->klass()->as_array_klass()->element_type()->basic_type() != elem_bt) {
+    // failed array check
+    return false;
+  }
+
+  // The caller has checked the range.
+  array = must_be_not_null(array, true);
+  array = access_resolve(array, ACCESS_READ);
+  Node* array_start = array_element_address(array, offset, elem_bt);
+
+  Node* call = make_runtime_call(RC_LEAF|RC_NO_FP,
+                                 OptoRuntime::vectorizedHashCode_Type(),
+                                 stubAddr, stubName, TypePtr::BOTTOM,
+                                 array_start, length, initial);
+  Node* result = _gvn.transform(new ProjNode(call, TypeFunc::Parms));
+  set_result(result);
+  return true;
+}
+
 /**
  * Calculate CRC32 for byte.
  * int java.util.zip.CRC32.update(int crc, int b)
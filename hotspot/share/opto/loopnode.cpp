@@ -1360,6 +1360,43 @@ Node* CountedLoopNode::skip_predicates() {
   return in(LoopNode::EntryControl);
 }
 
+// iv_range is the estimated range of the induction variable.
+static void log_strip_mined_loop(Compile* C, CountedLoopNode* inner_cl, jlong iv_range, const char* action) {
+  CompileLog* log = C->log();
+  if (log != NULL) {
+    log->begin_elem("strip_mined_loop idx='%d' stride='%d' iv_range='" JLONG_FORMAT "' action='%s'",
+                    inner_cl->_idx, inner_cl->stride_con(), iv_range, action);
+    if (inner_cl->profile_trip_cnt() != COUNT_UNKNOWN && !inner_cl->is_profile_trip_failed()) {
+      log->print(" profile_trip_cnt='%.0f'", inner_cl->profile_trip_cnt());
+    }
+    log->end_elem();
+  }
+}
+
+// The outer loop end is created with the probability of the inner loop
+// backedge, as if the outer loop iterated as often as the inner loop. It
+// only iterates once per strip of LoopStripMiningIter iterations though,
+// so most loops, short ones in particular, go through it only once per
+// execution. Use the profiled trip count so the code around the inner
+// loop is not considered hotter than it is.
+static void set_outer_loop_end_profile(OuterStripMinedLoopEndNode* outer_le, CountedLoopNode* inner_cl) {
+  float trip_cnt = inner_cl->profile_trip_cnt();
+  if (!UseProfiledLoopStripMining || trip_cnt == COUNT_UNKNOWN || inner_cl->is_profile_trip_failed() ||
+      trip_cnt < 1.0f) {
+    return;
+  }
+  // The profiled trip count is in iterations of the loop before unrolling.
+  float strip_iters = (float)LoopStripMiningIter * inner_cl->unrolled_count();
+  float outer_iters = MAX2(trip_cnt / strip_iters, 1.0f);
+  float prob = 1.0f - 1.0f / outer_iters;
+  outer_le->_prob = MIN2(MAX2(prob, PROB_MIN), PROB_MAX);
+  CountedLoopEndNode* inner_cle = inner_cl->loopexit_or_null();
+  if (inner_cle != NULL && inner_cle->_fcnt != COUNT_UNKNOWN) {
+    // The inner loop exit test runs trip_cnt times per execution.
+    outer_le->_fcnt = inner_cle->_fcnt / trip_cnt * outer_iters;
+  }
+}
+
 void OuterStripMinedLoopNode::adjust_strip_mined_loop(PhaseIterGVN* igvn) {
   // Look for the outer & inner strip mined loop, reduce number of
   // iterations of the inner loop, set exit condition of outer loop,
@@ -1385,6 +1422,7 @@ void OuterStripMinedLoopNode::adjust_strip_mined_loop(PhaseIterGVN* igvn) {
   assert(iter_estimate > 0, "broken");
   if ((jlong)scaled_iters != scaled_iters_long || iter_estimate <= short_scaled_iters) {
     // Remove outer loop and safepoint (too few iterations)
+    log_strip_mined_loop(igvn->C, inner_cl, iter_estimate, "no_safepoint");
     Node* outer_sfpt = outer_safepoint();
     Node* outer_out = outer_loop_exit();
     igvn->replace_node(outer_out, outer_sfpt->in(0));
@@ -1397,6 +1435,7 @@ void OuterStripMinedLoopNode::adjust_strip_mined_loop(PhaseIterGVN* igvn) {
     // the outer loop: drop the outer loop but
     // keep the safepoint so we don't run for
     // too long without a safepoint
+    log_strip_mined_loop(igvn->C, inner_cl, iter_estimate, "single_strip");
     IfNode* outer_le = outer_loop_end();
     Node* iff = igvn->transform(new IfNode(outer_le->in(0), outer_le->in(1), outer_le->_prob, outer_le->_fcnt));
     igvn->replace_node(outer_le, iff);
@@ -1404,6 +1443,9 @@ void OuterStripMinedLoopNode::adjust_strip_mined_loop(PhaseIterGVN* igvn) {
     return;
   }
 
+  log_strip_mined_loop(igvn->C, inner_cl, iter_estimate, "strip_mined");
+  set_outer_loop_end_profile(outer_loop_end(), inner_cl);
+
   Node* cle_tail = inner_cle->proj_out(true);
   ResourceMark rm;
   Node_List old_new;
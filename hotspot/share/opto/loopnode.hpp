@@ -1550,6 +1550,8 @@ class CountedLoopReserveKit {
     void use_new()                {_use_new = true;}
     void set_iff(IfNode* x)       {_iff = x;}
     bool has_reserved()     const { return _active && _has_reserved;}
+    IfNode* iff()           const { return _iff;}
+    LoopNode* reserved()    const { return _lp_reserved;}
   private:
     bool create_reserve();
 };// class CountedLoopReserveKit
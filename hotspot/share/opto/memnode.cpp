@@ -1371,16 +1371,61 @@ static bool stable_phi(PhiNode* phi, PhaseGVN *phase) {
   }
   return true;
 }
+//------------------------------is_allocation_merge----------------------------
+// Is phi only merging newly allocated objects?
+static bool is_allocation_merge(PhiNode* phi, PhaseGVN* phase) {
+  if (phi->in(0) == NULL || !phase->type(phi)->higher_equal(TypePtr::NOTNULL)) {
+    return false;
+  }
+  for (uint i = 1; i < phi->req(); i++) {
+    Node* in = phi->in(i);
+    if (in == NULL || phase->type(in) == Type::TOP) {
+      continue; // dead path
+    }
+    if (AllocateNode::Ideal_allocation(in, phase) == NULL) {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------load_from_allocation_merge---------------------
+// Is this a plain field load whose base merges newly allocated objects?
+// Splitting such a load through the merge gives each path a load from a
+// single allocation, which can then be hooked up to the initializing store.
+// Once the merge has no other users left, escape analysis no longer sees
+// the allocations merged and can scalar replace them.
+bool LoadNode::load_from_allocation_merge(PhaseGVN* phase) const {
+  if (!ReduceAllocationMerges || !is_unordered() ||
+      is_mismatched_access() || is_unaligned_access()) {
+    return false;
+  }
+  Node* address = in(Address);
+  const TypeOopPtr* t_oop = phase->type(address)->isa_oopptr();
+  if (t_oop == NULL || t_oop->is_known_instance_field() ||
+      t_oop->is_ptr_to_boxed_value() || !address->is_AddP()) {
+    return false;
+  }
+  intptr_t ignore = 0;
+  Node* base = AddPNode::Ideal_base_and_offset(address, phase, ignore);
+  return base != NULL && base->is_Phi() &&
+         base == address->in(AddPNode::Base) &&
+         is_allocation_merge(base->as_Phi(), phase);
+}
+
 //------------------------------split_through_phi------------------------------
-// Split instance or boxed field load through Phi.
+// Split instance or boxed field load, or a load from a merge of
+// allocations, through Phi.
 Node *LoadNode::split_through_phi(PhaseGVN *phase) {
   Node* mem     = in(Memory);
   Node* address = in(Address);
   const TypeOopPtr *t_oop = phase->type(address)->isa_oopptr();
+  bool load_allocation_merge = load_from_allocation_merge(phase);
 
   assert((t_oop != NULL) &&
          (t_oop->is_known_instance_field() ||
-          t_oop->is_ptr_to_boxed_value()), "invalide conditions");
+          t_oop->is_ptr_to_boxed_value() ||
+          load_allocation_merge), "invalide conditions");
 
   Compile* C = phase->C;
   intptr_t ignore = 0;
@@ -1391,7 +1436,8 @@ Node *LoadNode::split_through_phi(PhaseGVN *phase) {
                            phase->type(base)->higher_equal(TypePtr::NOTNULL);
 
   if (!((mem->is_Phi() || base_is_phi) &&
-        (load_boxed_values || t_oop->is_known_instance_field()))) {
+        (load_boxed_values || t_oop->is_known_instance_field() ||
+         load_allocation_merge))) {
     return NULL; // memory is not Phi
   }
 
@@ -1472,13 +1518,16 @@ Node *LoadNode::split_through_phi(PhaseGVN *phase) {
     assert(base->in(0) == mem->in(0), "sanity");
     region = mem->in(0);
   }
+  if (load_allocation_merge && region != base->in(0)) {
+    return NULL; // must split through the merge of the allocations
+  }
 
   const Type* this_type = this->bottom_type();
   int this_index  = C->get_alias_index(t_oop);
   int this_offset = t_oop->offset();
   int this_iid    = t_oop->instance_id();
-  if (!t_oop->is_known_instance() && load_boxed_values) {
-    // Use _idx of address base for boxed values.
+  if (!t_oop->is_known_instance() && (load_boxed_values || load_allocation_merge)) {
+    // Use _idx of address base for boxed values and merged allocations.
     this_iid = base->_idx;
   }
   PhaseIterGVN* igvn = phase->is_IterGVN();
@@ -1504,7 +1553,7 @@ Node *LoadNode::split_through_phi(PhaseGVN *phase) {
         x->set_req(Address, address->in(i)); // Use pre-Phi input for the clone
       }
       if (base_is_phi && (base->in(0) == region)) {
-        Node* base_x = base->in(i); // Clone address for loads from boxed objects.
+        Node* base_x = base->in(i); // Clone address for loads from boxed or merged objects.
         Node* adr_x = phase->transform(new AddPNode(base_x,base_x,address->in(AddPNode::Offset)));
         x->set_req(Address, adr_x);
       }
@@ -1613,7 +1662,8 @@ Node *LoadNode::Ideal(PhaseGVN *phase, bool can_reshape) {
     const TypeOopPtr *t_oop = addr_t->isa_oopptr();
     if ((t_oop != NULL) &&
         (t_oop->is_known_instance_field() ||
-         t_oop->is_ptr_to_boxed_value())) {
+         t_oop->is_ptr_to_boxed_value() ||
+         load_from_allocation_merge(phase))) {
       PhaseIterGVN *igvn = phase->is_IterGVN();
       if (igvn != NULL && igvn->_worklist.member(opt_mem)) {
         // Delay this transformation until memory Phi is processed.
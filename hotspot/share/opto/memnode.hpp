@@ -228,6 +228,9 @@ public:
   // Split instance field load through Phi.
   Node* split_through_phi(PhaseGVN *phase);
 
+  // Is the address base a Phi merging newly allocated objects only?
+  bool load_from_allocation_merge(PhaseGVN* phase) const;
+
   // Recover original value from boxed values
   Node *eliminate_autobox(PhaseGVN *phase);
 
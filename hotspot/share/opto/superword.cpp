@@ -36,6 +36,7 @@
 #include "opto/mulnode.hpp"
 #include "opto/opcodes.hpp"
 #include "opto/opaquenode.hpp"
+#include "opto/rootnode.hpp"
 #include "opto/superword.hpp"
 #include "opto/vectornode.hpp"
 #include "opto/movenode.hpp"
@@ -1054,12 +1055,13 @@ void SuperWord::dependence_graph() {
         SWPointer p2(s2->as_Mem(), this, NULL, false);
 
         int cmp = p1.cmp(p2);
-        if (SuperWordRTDepCheck &&
-            p1.base() != p2.base() && p1.valid() && p2.valid()) {
+        if (SWPointer::not_equal(cmp)) {
+          // Independent
+        } else if (SuperWordRTDepCheck && can_check_disjoint_at_runtime(p1, p2)) {
           // Create a runtime check to disambiguate
           OrderedPair pp(p1.base(), p2.base());
           _disjoint_ptrs.append_if_missing(pp);
-        } else if (!SWPointer::not_equal(cmp)) {
+        } else {
           // Possibly same address
           _dg.make_edge(s1, s2);
           sink_dependent = false;
@@ -1092,6 +1094,36 @@ void SuperWord::dependence_graph() {
 
 }
 
+//------------------------can_check_disjoint_at_runtime------------------------
+// Different arrays never overlap, so memory references with different array
+// bases only depend on each other if the bases are the same array at runtime.
+// This is checked once before the main loop, see insert_disjoint_check().
+bool SuperWord::can_check_disjoint_at_runtime(SWPointer& p1, SWPointer& p2) {
+  const int max_disjoint_ptrs = 4; // Bounds the size of the runtime check
+  CountedLoopNode* cl = lpt()->_head->as_CountedLoop();
+  // The scalar fallback is the reserved copy of the main loop.
+  if (!cl->is_main_loop() || !do_reserve_copy()) {
+    return false;
+  }
+  if (!p1.valid() || !p2.valid() || p1.base() == p2.base()) {
+    return false;
+  }
+  Node* entry = cl->skip_strip_mined()->in(LoopNode::EntryControl);
+  Node* bases[] = { p1.base(), p2.base() };
+  for (uint i = 0; i < ARRAY_SIZE(bases); i++) {
+    // Off-heap (unsafe) addresses may alias anything.
+    if (bases[i]->is_top() || _igvn.type(bases[i])->isa_aryptr() == NULL) {
+      return false;
+    }
+    // The check is placed at the loop entry.
+    if (!_phase->is_dominator(_phase->get_ctrl(bases[i]), entry)) {
+      return false;
+    }
+  }
+  OrderedPair pp(p1.base(), p2.base());
+  return _disjoint_ptrs.contains(pp) || _disjoint_ptrs.length() < max_disjoint_ptrs;
+}
+
 //---------------------------mem_slice_preds---------------------------
 // Return a memory slice (node list) in predecessor order starting at "start"
 void SuperWord::mem_slice_preds(Node* start, Node* stop, GrowableArray<Node*> &preds) {
@@ -1391,8 +1423,8 @@ bool SuperWord::follow_use_defs(Node_List* p) {
 
   if (s1->is_Load()) return false;
 
-  int align = alignment(s1);
-  NOT_PRODUCT(if(is_trace_alignment()) tty->print_cr("SuperWord::follow_use_defs: s1 %d, align %d", s1->_idx, align);)
+  int s1_align = alignment(s1);
+  NOT_PRODUCT(if(is_trace_alignment()) tty->print_cr("SuperWord::follow_use_defs: s1 %d, align %d", s1->_idx, s1_align);)
   bool changed = false;
   int start = s1->is_Store() ? MemNode::ValueIn   : 1;
   int end   = s1->is_Store() ? MemNode::ValueIn+1 : s1->req();
@@ -1401,6 +1433,9 @@ bool SuperWord::follow_use_defs(Node_List* p) {
     Node* t2 = s2->in(j);
     if (!in_bb(t1) || !in_bb(t2))
       continue;
+    int align = adjust_alignment_for_type_conversion(s1, t1, s1_align);
+    if (align == bottom_align)
+      continue;
     if (stmts_can_pack(t1, t2, align)) {
       if (est_savings(t1, t2) >= 0) {
         Node_List* pair = new Node_List();
@@ -1434,6 +1469,7 @@ bool SuperWord::follow_def_uses(Node_List* p) {
   int num_s1_uses = 0;
   Node* u1 = NULL;
   Node* u2 = NULL;
+  int u_align = align;
   for (DUIterator_Fast imax, i = s1->fast_outs(imax); i < imax; i++) {
     Node* t1 = s1->fast_out(i);
     num_s1_uses++;
@@ -1444,12 +1480,16 @@ bool SuperWord::follow_def_uses(Node_List* p) {
       if (t2->Opcode() == Op_AddI && t2 == _lp->as_CountedLoop()->incr()) continue; // don't mess with the iv
       if (!opnd_positions_match(s1, t1, s2, t2))
         continue;
-      if (stmts_can_pack(t1, t2, align)) {
+      int t_align = adjust_alignment_for_type_conversion(s1, t1, align);
+      if (t_align == bottom_align)
+        continue;
+      if (stmts_can_pack(t1, t2, t_align)) {
         int my_savings = est_savings(t1, t2);
         if (my_savings > savings) {
           savings = my_savings;
           u1 = t1;
           u2 = t2;
+          u_align = t_align;
         }
       }
     }
@@ -1462,8 +1502,8 @@ bool SuperWord::follow_def_uses(Node_List* p) {
     pair->push(u1);
     pair->push(u2);
     _packset.append(pair);
-    NOT_PRODUCT(if(is_trace_alignment()) tty->print_cr("SuperWord::follow_def_uses: set_alignment(%d, %d, %d)", u1->_idx, u2->_idx, align);)
-    set_alignment(u1, u2, align);
+    NOT_PRODUCT(if(is_trace_alignment()) tty->print_cr("SuperWord::follow_def_uses: set_alignment(%d, %d, %d)", u1->_idx, u2->_idx, u_align);)
+    set_alignment(u1, u2, u_align);
     changed = true;
   }
   return changed;
@@ -1642,8 +1682,7 @@ void SuperWord::combine_packs() {
   for (int i = 0; i < _packset.length(); i++) {
     Node_List* p1 = _packset.at(i);
     if (p1 != NULL) {
-      BasicType bt = velt_basic_type(p1->at(0));
-      uint max_vlen = Matcher::max_vector_size(bt); // Max elements in vector
+      uint max_vlen = max_vector_size_in_def_use_chain(p1->at(0)); // Max elements in vector
       assert(is_power_of_2(max_vlen), "sanity");
       uint psize = p1->size();
       if (!is_power_of_2(psize)) {
@@ -2572,6 +2611,10 @@ void SuperWord::output() {
     }
   }//for (int i = 0; i < _block.length(); i++)
 
+  if (cl->is_main_loop() && cl->is_reduction_loop()) {
+    move_reductions_out_of_loop();
+  }
+
   if (max_vlen_in_bytes > C->max_vector_size()) {
     C->set_max_vector_size(max_vlen_in_bytes);
   }
@@ -2622,6 +2665,10 @@ void SuperWord::output() {
     }
   }
 
+  if (_disjoint_ptrs.length() > 0) {
+    insert_disjoint_check(make_reversable);
+  }
+
   if (do_reserve_copy()) {
     make_reversable.use_new();
   }
@@ -2629,6 +2676,219 @@ void SuperWord::output() {
   return;
 }
 
+//------------------------------insert_disjoint_check---------------------------
+// Replace the constant condition selecting between the vectorized loop and
+// its reserved copy with a check that all pairs of bases in _disjoint_ptrs
+// are different arrays:
+//
+//   If (Bool ne (CmpI (AndI (CMoveI (Bool ne (CmpP b1 b2)) 0 1) ...) 0))
+//
+// The reserved copy stays the scalar loop for the aliasing case.
+void SuperWord::insert_disjoint_check(CountedLoopReserveKit& kit) {
+  assert(kit.has_reserved(), "need the scalar loop as fallback");
+  IfNode* iff = kit.iff();
+  Node* ctrl = iff->in(0);
+  Node* zero = _igvn.intcon(0);
+  Node* one  = _igvn.intcon(1);
+  _phase->set_ctrl(zero, _phase->C->root());
+  _phase->set_ctrl(one, _phase->C->root());
+
+  Node* all_disjoint = NULL;
+  for (int i = 0; i < _disjoint_ptrs.length(); i++) {
+    OrderedPair& pp = _disjoint_ptrs.at(i);
+    Node* cmp = new CmpPNode(pp.p1(), pp.p2());
+    _phase->register_new_node(cmp, ctrl);
+    Node* bol = new BoolNode(cmp, BoolTest::ne);
+    _phase->register_new_node(bol, ctrl);
+    Node* disjoint = CMoveNode::make(ctrl, bol, zero, one, TypeInt::BOOL);
+    _phase->register_new_node(disjoint, ctrl);
+    if (all_disjoint == NULL) {
+      all_disjoint = disjoint;
+    } else {
+      all_disjoint = new AndINode(all_disjoint, disjoint);
+      _phase->register_new_node(all_disjoint, ctrl);
+    }
+  }
+  Node* cmp = new CmpINode(all_disjoint, zero);
+  _phase->register_new_node(cmp, ctrl);
+  Node* bol = new BoolNode(cmp, BoolTest::ne);
+  _phase->register_new_node(bol, ctrl);
+  _igvn.replace_input_of(iff, 1, bol);
+
+  // The scalar loop is what vectorization would produce for the aliasing
+  // case, don't try again.
+  CountedLoopNode* cl = lpt()->_head->as_CountedLoop();
+  kit.reserved()->as_CountedLoop()->mark_do_unroll_only();
+  // The vectorized loop exit is merged with the scalar one, which the
+  // vector drain loop insertion does not expect.
+  cl->mark_has_atomic_post_loop();
+
+#ifndef PRODUCT
+  if (TraceSuperWord || TraceLoopOpts) {
+    tty->print("SuperWord::output: loop %d vectorized under runtime disjointness check", cl->_idx);
+    for (int i = 0; i < _disjoint_ptrs.length(); i++) {
+      _disjoint_ptrs.at(i).print();
+    }
+    tty->cr();
+  }
+#endif
+}
+
+//------------------------------move_reductions_out_of_loop---------------------
+// A reduction vectorized in place still folds every vector into the scalar
+// phi, so each iteration waits for the previous one to finish reducing.  For
+// operations that may be reassociated, accumulate into a vector phi instead
+// and reduce the accumulated vector once after the loop:
+//
+//   phi = Phi(init, r_k)              vphi = Phi(identity, v'_k)
+//   r_1 = Reduction(phi, v_1)         v'_1 = OpV(vphi, v_1)
+//   ...                         ==>   ...
+//   r_k = Reduction(r_k-1, v_k)       v'_k = OpV(v'_k-1, v_k)
+//   use(r_k) after the loop           use(Reduction(init, v'_k))
+void SuperWord::move_reductions_out_of_loop() {
+  CountedLoopNode* cl = lpt()->_head->as_CountedLoop();
+  Node_List phis;
+  for (DUIterator_Fast imax, i = cl->fast_outs(imax); i < imax; i++) {
+    Node* n = cl->fast_out(i);
+    if (n->is_Phi() && n->outcnt() == 1 && n->bottom_type()->isa_vect() == NULL) {
+      phis.push(n);
+    }
+  }
+
+  for (uint i = 0; i < phis.size(); i++) {
+    Node* phi = phis.at(i);
+    Node* last = phi->in(LoopNode::LoopBackControl);
+    Node* first = phi->unique_out();
+    const TypeVect* vt = NULL;
+    int opc = 0;
+
+    // Check that phi starts a chain of reductions of the same kind, each
+    // used only by the next one, that ends with the backedge value.
+    bool ok = true;
+    Node* prev = phi;
+    for (Node* r = first; ; r = r->unique_out()) {
+      if (r->req() != 3 || r->in(1) != prev ||
+          r->in(2)->bottom_type()->isa_vect() == NULL) {
+        ok = false;
+        break;
+      }
+      const TypeVect* r_vt = r->in(2)->bottom_type()->is_vect();
+      int r_opc = reassociable_reduction_opcode(r, r_vt->element_basic_type());
+      if (r_opc == 0 || (vt != NULL && (r_opc != opc || r_vt != vt))) {
+        ok = false;
+        break;
+      }
+      vt = r_vt;
+      opc = r_opc;
+      if (r == last) {
+        break;
+      }
+      if (r->outcnt() != 1) {
+        ok = false;
+        break;
+      }
+      prev = r;
+    }
+    if (!ok) {
+      continue;
+    }
+    // Apart from the backedge, the result may only be used after the loop.
+    for (DUIterator_Fast jmax, j = last->fast_outs(jmax); j < jmax && ok; j++) {
+      Node* use = last->fast_out(j);
+      if (use != phi && lpt()->is_member(_phase->get_loop(_phase->ctrl_or_self(use)))) {
+        ok = false;
+      }
+    }
+    BasicType bt = vt->element_basic_type();
+    uint vlen = vt->length();
+    if (!ok || !VectorNode::implemented(opc, vlen, bt)) {
+      continue;
+    }
+
+    Node* entry = cl->skip_strip_mined()->in(LoopNode::EntryControl);
+    Node* init = phi->in(LoopNode::EntryControl);
+    Node* identity = reduction_identity(opc, bt);
+    Node* vinit = VectorNode::scalar2vector(identity, vlen, Type::get_const_basic_type(bt));
+    _phase->register_new_node(vinit, entry);
+    PhiNode* vphi = new PhiNode(cl, vt);
+    vphi->init_req(LoopNode::EntryControl, vinit);
+    _phase->register_new_node(vphi, cl);
+
+    Node* acc = vphi;
+    for (Node* r = first; ; r = r->unique_out()) {
+      Node* v = VectorNode::make(opc, acc, r->in(2), vlen, bt);
+      _phase->register_new_node(v, _phase->get_ctrl(r));
+      acc = v;
+      if (r == last) {
+        break;
+      }
+    }
+    vphi->set_req(LoopNode::LoopBackControl, acc);
+
+    Node* exit = cl->is_strip_mined() ? cl->outer_loop_exit() : cl->loopexit()->proj_out(false);
+    Node* result = ReductionNode::make(opc, NULL, init, acc, bt);
+    _phase->register_new_node(result, exit);
+    for (DUIterator_Last jmin, j = last->last_outs(jmin); j >= jmin; ) {
+      Node* use = last->last_out(j);
+      if (use == phi) {
+        --j;
+        continue;
+      }
+      _igvn.rehash_node_delayed(use);
+      j -= use->replace_edge(last, result);
+    }
+    // The scalar reduction chain is dead now.
+    _igvn.replace_input_of(phi, LoopNode::LoopBackControl, init);
+
+#ifndef PRODUCT
+    if (TraceSuperWord) {
+      tty->print_cr("SuperWord::move_reductions_out_of_loop: phi %d replaced by vector phi %d", phi->_idx, vphi->_idx);
+    }
+#endif
+  }
+}
+
+int SuperWord::reassociable_reduction_opcode(Node* red, BasicType bt) {
+  bool fp_ok = SuperWordUnorderedFPReductions;
+  switch (red->Opcode()) {
+    case Op_AddReductionVI: return Op_AddI;
+    case Op_AddReductionVL: return Op_AddL;
+    case Op_MulReductionVI: return Op_MulI;
+    case Op_MulReductionVL: return Op_MulL;
+    case Op_AddReductionVF: return fp_ok ? Op_AddF : 0;
+    case Op_AddReductionVD: return fp_ok ? Op_AddD : 0;
+    case Op_MulReductionVF: return fp_ok ? Op_MulF : 0;
+    case Op_MulReductionVD: return fp_ok ? Op_MulD : 0;
+    // Java min and max are exact, including NaN and signed zero handling.
+    case Op_MinReductionV:  return bt == T_FLOAT ? Op_MinF : Op_MinD;
+    case Op_MaxReductionV:  return bt == T_FLOAT ? Op_MaxF : Op_MaxD;
+    default:                return 0;
+  }
+}
+
+Node* SuperWord::reduction_identity(int opc, BasicType bt) {
+  const Type* t = NULL;
+  switch (opc) {
+    case Op_AddI: t = TypeInt::ZERO;          break;
+    case Op_AddL: t = TypeLong::ZERO;         break;
+    case Op_MulI: t = TypeInt::ONE;           break;
+    case Op_MulL: t = TypeLong::ONE;          break;
+    // -0.0 rather than 0.0, so that a sum of negative zeros stays -0.0.
+    case Op_AddF: t = TypeF::make(-0.0f);     break;
+    case Op_AddD: t = TypeD::make(-0.0);      break;
+    case Op_MulF: t = TypeF::ONE;             break;
+    case Op_MulD: t = TypeD::ONE;             break;
+    case Op_MinF: t = TypeF::POS_INF;         break;
+    case Op_MinD: t = TypeD::POS_INF;         break;
+    case Op_MaxF: t = TypeF::NEG_INF;         break;
+    case Op_MaxD: t = TypeD::NEG_INF;         break;
+    default:      ShouldNotReachHere();
+  }
+  Node* con = _igvn.makecon(t);
+  _phase->set_ctrl(con, _phase->C->root());
+  return con;
+}
+
 //------------------------------vector_opd---------------------------
 // Create a vector operand for the nodes in pack p for operand: in(opd_idx)
 Node* SuperWord::vector_opd(Node_List* p, int opd_idx) {
@@ -2649,6 +2909,27 @@ Node* SuperWord::vector_opd(Node_List* p, int opd_idx) {
         NOT_PRODUCT(if(is_trace_loop_reverse() || TraceLoopOpts) {tty->print_cr("shift's count can't be vector");})
         return NULL;
       }
+      BasicType opd_bt = opd->bottom_type()->is_vect()->element_basic_type();
+      BasicType p0_bt = velt_basic_type(p0);
+      if (type2aelembytes(opd_bt) != type2aelembytes(p0_bt) && !VectorNode::is_muladds2i(p0)) {
+        // Widen the loaded bytes or shorts to ints, or narrow ints to be stored.
+        int vopc = VectorCastNode::opcode(opd_bt, p0_bt);
+        assert(vopc > 0, "%s to %s vector cast expected", type2name(opd_bt), type2name(p0_bt));
+        if (vopc == 0) {
+          NOT_PRODUCT(if(is_trace_loop_reverse() || TraceLoopOpts) {tty->print_cr("vector cast not supported");})
+          return NULL;
+        }
+        VectorNode* vn = VectorCastNode::make(vopc, opd, p0_bt, vlen);
+        _igvn.register_new_node_with_optimizer(vn);
+        _phase->set_ctrl(vn, _phase->get_ctrl(opd));
+#ifdef ASSERT
+        if (TraceNewVectors) {
+          tty->print("new Vector node: ");
+          vn->dump();
+        }
+#endif
+        return vn;
+      }
       return opd; // input is matching vector
     }
     if ((opd_idx == 2) && VectorNode::is_shift(p0)) {
@@ -2825,6 +3106,16 @@ bool SuperWord::is_vector_use(Node* use, int u_idx) {
   }
   if (u_pk->size() != d_pk->size())
     return false;
+  if (is_vector_cast(def, use)) {
+    // The alignments are in units of different element sizes, only
+    // check that the elements line up.
+    for (uint i = 0; i < u_pk->size(); i++) {
+      if (u_pk->at(i)->in(u_idx) != d_pk->at(i)) {
+        return false;
+      }
+    }
+    return VectorCastNode::implemented(velt_basic_type(def), velt_basic_type(use), u_pk->size());
+  }
   for (uint i = 0; i < u_pk->size(); i++) {
     Node* ui = u_pk->at(i);
     Node* di = d_pk->at(i);
@@ -2834,6 +3125,61 @@ bool SuperWord::is_vector_use(Node* use, int u_idx) {
   return true;
 }
 
+//------------------------------is_vector_cast---------------------------
+bool SuperWord::is_vector_cast(Node* def, Node* use) {
+  if (!in_bb(def) || !in_bb(use) || VectorNode::is_muladds2i(use)) {
+    return false;
+  }
+  BasicType def_bt = velt_basic_type(def);
+  BasicType use_bt = velt_basic_type(use);
+  if (def->is_Load()) {
+    // The loaded bytes or shorts are used as ints.
+    return is_subword_type(def_bt) && use_bt == T_INT;
+  }
+  if (use->is_Store() && use->in(MemNode::ValueIn) == def) {
+    // Ints that could not be narrowed are stored as bytes or shorts.
+    return def_bt == T_INT && is_subword_type(use_bt);
+  }
+  return false;
+}
+
+//------------------------------adjust_alignment_for_type_conversion---------------------------
+int SuperWord::adjust_alignment_for_type_conversion(Node* s, Node* t, int align) {
+  if (align == top_align || align == bottom_align ||
+      !(is_vector_cast(s, t) || is_vector_cast(t, s))) {
+    return align;
+  }
+  int t_size = data_size(t);
+  int vw = vector_width_in_bytes(t);
+  int t_align = align / data_size(s) * t_size;
+  if (vw > 0) {
+    t_align = t_align % vw;
+    if (t_align + t_size >= vw) {
+      return bottom_align;
+    }
+  }
+  return t_align;
+}
+
+//------------------------------max_vector_size_in_def_use_chain---------------------------
+uint SuperWord::max_vector_size_in_def_use_chain(Node* n) {
+  uint max_vlen = Matcher::max_vector_size(velt_basic_type(n));
+  if (n->is_Load()) {
+    for (DUIterator_Fast imax, i = n->fast_outs(imax); i < imax; i++) {
+      Node* use = n->fast_out(i);
+      if (is_vector_cast(n, use)) {
+        max_vlen = MIN2(max_vlen, (uint)Matcher::max_vector_size(velt_basic_type(use)));
+      }
+    }
+  } else if (n->is_Store()) {
+    Node* in = n->in(MemNode::ValueIn);
+    if (is_vector_cast(in, n)) {
+      max_vlen = MIN2(max_vlen, (uint)Matcher::max_vector_size(velt_basic_type(in)));
+    }
+  }
+  return max_vlen;
+}
+
 //------------------------------construct_bb---------------------------
 // Construct reverse postorder list of block members
 bool SuperWord::construct_bb() {
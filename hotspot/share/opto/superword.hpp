@@ -239,6 +239,8 @@ class OrderedPair {
   bool operator==(const OrderedPair &rhs) {
     return _p1 == rhs._p1 && _p2 == rhs._p2;
   }
+  Node* p1() const { return _p1; }
+  Node* p2() const { return _p2; }
   void print() { tty->print("  (%d, %d)", _p1->_idx, _p2->_idx); }
 
   static const OrderedPair initial;
@@ -431,6 +433,12 @@ class SuperWord : public ResourceObj {
   bool pack_parallel();
   // Construct dependency graph.
   void dependence_graph();
+  // Can a possible dependence between p1 and p2 be resolved by a runtime
+  // check that their bases are different arrays?
+  bool can_check_disjoint_at_runtime(SWPointer& p1, SWPointer& p2);
+  // Make the vectorized loop execute only if all _disjoint_ptrs are
+  // different arrays, and the reserved copy of the loop otherwise.
+  void insert_disjoint_check(CountedLoopReserveKit& kit);
   // Return a memory slice (node list) in predecessor order starting at "start"
   void mem_slice_preds(Node* start, Node* stop, GrowableArray<Node*> &preds);
   // Can s1 and s2 be in a pack with s1 immediately preceding s2 and  s1 aligned at "align"
@@ -483,6 +491,13 @@ class SuperWord : public ResourceObj {
   void co_locate_pack(Node_List* p);
   // Convert packs into vector node operations
   void output();
+  // Accumulate reductions of a main loop in a vector phi, and reduce
+  // that vector once after the loop.
+  void move_reductions_out_of_loop();
+  // The scalar operation and its identity for a reduction that may be
+  // reassociated, 0 if it may not.
+  int reassociable_reduction_opcode(Node* red, BasicType bt);
+  Node* reduction_identity(int opc, BasicType bt);
   // Create a vector operand for the nodes in pack p for operand: in(opd_idx)
   Node* vector_opd(Node_List* p, int opd_idx);
   // Can code be generated for pack p?
@@ -493,6 +508,15 @@ class SuperWord : public ResourceObj {
   void insert_extracts(Node_List* p);
   // Is use->in(u_idx) a vector use?
   bool is_vector_use(Node* use, int u_idx);
+  // Is def a subword load whose value use widens to int, or use a subword
+  // store of an int def? The vectors are then bridged with a VectorCastNode.
+  bool is_vector_cast(Node* def, Node* use);
+  // Alignment of t, an operand or use of s across a vector cast, given the
+  // alignment of s. bottom_align if a pair of t would span two vectors.
+  int adjust_alignment_for_type_conversion(Node* s, Node* t, int align);
+  // Max elements in a pack of n, limited by the widest type its value is
+  // converted to or from.
+  uint max_vector_size_in_def_use_chain(Node* n);
   // Construct reverse postorder list of block members
   bool construct_bb();
   // Initialize per node info
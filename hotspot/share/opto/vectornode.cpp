@@ -669,3 +669,43 @@ bool ReductionNode::implemented(int opc, uint vlen, BasicType bt) {
   }
   return false;
 }
+
+int VectorCastNode::opcode(BasicType in_bt, BasicType bt) {
+  if (bt == T_INT) {
+    switch (in_bt) {
+    case T_BYTE:    return Op_VectorCastB2X;
+    case T_BOOLEAN: return Op_VectorUCastB2X;
+    case T_SHORT:   return Op_VectorCastS2X;
+    case T_CHAR:    return Op_VectorUCastS2X;
+    default:        return 0;
+    }
+  }
+  if (in_bt == T_INT && is_subword_type(bt)) {
+    return Op_VectorCastI2X;
+  }
+  return 0;
+}
+
+bool VectorCastNode::implemented(BasicType in_bt, BasicType bt, uint vlen) {
+  if ((vlen > 1) && is_power_of_2(vlen) &&
+      Matcher::vector_size_supported(in_bt, vlen) &&
+      Matcher::vector_size_supported(bt, vlen)) {
+    int vopc = VectorCastNode::opcode(in_bt, bt);
+    return vopc > 0 && Matcher::match_rule_supported_vector(vopc, vlen);
+  }
+  return false;
+}
+
+VectorCastNode* VectorCastNode::make(int vopc, Node* n, BasicType bt, uint vlen) {
+  const TypeVect* vt = TypeVect::make(bt, vlen);
+  switch (vopc) {
+  case Op_VectorCastB2X:  return new VectorCastB2XNode(n, vt);
+  case Op_VectorUCastB2X: return new VectorUCastB2XNode(n, vt);
+  case Op_VectorCastS2X:  return new VectorCastS2XNode(n, vt);
+  case Op_VectorUCastS2X: return new VectorUCastS2XNode(n, vt);
+  case Op_VectorCastI2X:  return new VectorCastI2XNode(n, vt);
+  default:
+    fatal("Missed vector creation for '%s'", NodeClassNames[vopc]);
+    return NULL;
+  }
+}
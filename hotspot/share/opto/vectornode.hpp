@@ -960,6 +960,60 @@ class ExtractDNode : public ExtractNode {
   virtual uint ideal_reg() const { return Op_RegD; }
 };
 
+//========================Vector_Cast==========================================
+
+//------------------------------VectorCastNode---------------------------------
+// Convert between vectors of the same length with elements of different size
+class VectorCastNode : public VectorNode {
+ public:
+  VectorCastNode(Node* in, const TypeVect* vt) : VectorNode(in, vt) {}
+
+  // Opcode converting in_bt to bt elements, 0 if there is none.
+  static int opcode(BasicType in_bt, BasicType bt);
+  static bool implemented(BasicType in_bt, BasicType bt, uint vlen);
+  static VectorCastNode* make(int vopc, Node* n, BasicType bt, uint vlen);
+};
+
+//------------------------------VectorCastB2XNode------------------------------
+// Sign extend bytes
+class VectorCastB2XNode : public VectorCastNode {
+ public:
+  VectorCastB2XNode(Node* in, const TypeVect* vt) : VectorCastNode(in, vt) {}
+  virtual int Opcode() const;
+};
+
+//------------------------------VectorUCastB2XNode-----------------------------
+// Zero extend bytes (booleans)
+class VectorUCastB2XNode : public VectorCastNode {
+ public:
+  VectorUCastB2XNode(Node* in, const TypeVect* vt) : VectorCastNode(in, vt) {}
+  virtual int Opcode() const;
+};
+
+//------------------------------VectorCastS2XNode------------------------------
+// Sign extend shorts
+class VectorCastS2XNode : public VectorCastNode {
+ public:
+  VectorCastS2XNode(Node* in, const TypeVect* vt) : VectorCastNode(in, vt) {}
+  virtual int Opcode() const;
+};
+
+//------------------------------VectorUCastS2XNode-----------------------------
+// Zero extend shorts (chars)
+class VectorUCastS2XNode : public VectorCastNode {
+ public:
+  VectorUCastS2XNode(Node* in, const TypeVect* vt) : VectorCastNode(in, vt) {}
+  virtual int Opcode() const;
+};
+
+//------------------------------VectorCastI2XNode------------------------------
+// Truncate ints to bytes or shorts
+class VectorCastI2XNode : public VectorCastNode {
+ public:
+  VectorCastI2XNode(Node* in, const TypeVect* vt) : VectorCastNode(in, vt) {}
+  virtual int Opcode() const;
+};
+
 //------------------------------SetVectMaskINode-------------------------------
 // Provide a mask for a vector predicate machine
 class SetVectMaskINode : public Node {
@@ -2553,6 +2553,10 @@ JNI_QUICK_ENTRY(jsize, jni_GetArrayLength(JNIEnv *env, jarray array))
   return ret;
 JNI_END
 
+address jni_GetArrayLength_addr() {
+  return (address)jni_GetArrayLength;
+}
+
 
 //
 // Object Array Operations
@@ -3153,8 +3157,8 @@ JNI_ENTRY(void, jni_GetStringUTFRegion(JNIEnv *env, jstring string, jsize start,
 JNI_END
 
 static oop lock_gc_or_pin_object(JavaThread* thread, jobject obj) {
-  if (Universe::heap()->supports_object_pinning()) {
-    const oop o = JNIHandles::resolve_non_null(obj);
+  const oop o = JNIHandles::resolve_non_null(obj);
+  if (Universe::heap()->can_pin_object(o)) {
     return Universe::heap()->pin_object(thread, o);
   } else {
     GCLocker::lock_critical(thread);
@@ -3163,8 +3167,8 @@ static oop lock_gc_or_pin_object(JavaThread* thread, jobject obj) {
 }
 
 static void unlock_gc_or_unpin_object(JavaThread* thread, jobject obj) {
-  if (Universe::heap()->supports_object_pinning()) {
-    const oop o = JNIHandles::resolve_non_null(obj);
+  const oop o = JNIHandles::resolve_non_null(obj);
+  if (Universe::heap()->can_pin_object(o)) {
     return Universe::heap()->unpin_object(thread, o);
   } else {
     GCLocker::unlock_critical(thread);
@@ -3812,6 +3816,13 @@ void quicken_jni_functions() {
       jni_NativeInterface.GetDoubleField = (GetDoubleField_t)func;
     }
   }
+  // Replace GetArrayLength with a fast version, same logic as for the fields
+  if (UseFastJNIAccessors && !CountJNICalls && !CheckJNICalls) {
+    address func = JNI_FastGetField::generate_fast_get_array_length();
+    if (func != (address)-1) {
+      jni_NativeInterface.GetArrayLength = (GetArrayLength_t)func;
+    }
+  }
 }
 
 // Returns the function structure
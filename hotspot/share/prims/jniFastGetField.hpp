@@ -53,6 +53,10 @@
 //
 // There is a hypothetical safepoint counter wraparound. But it's not
 // a practical concern.
+//
+// jni_GetArrayLength uses the same logic, loading the length field of the
+// array. Setters and array region copies have no fast versions since a
+// store cannot be undone when the safepoint counter changes.
 
 class JNI_FastGetField : AllStatic {
  private:
@@ -85,6 +89,7 @@ class JNI_FastGetField : AllStatic {
   static address generate_fast_get_long_field();
   static address generate_fast_get_float_field();
   static address generate_fast_get_double_field();
+  static address generate_fast_get_array_length();
 
   // If pc is in speculative_load_pclist, return the corresponding
   // slow case entry pc. Otherwise, return -1.
@@ -66,6 +66,8 @@ extern "C" {
       (JNIEnv *env, jobject obj, jfieldID fieldID);
   typedef jdouble (JNICALL *GetDoubleField_t)
     (JNIEnv *env, jobject obj, jfieldID fieldID);
+  typedef jsize (JNICALL *GetArrayLength_t)
+    (JNIEnv *env, jarray array);
 }
 
 void    quicken_jni_functions();
@@ -77,5 +79,6 @@ address jni_GetIntField_addr();
 address jni_GetLongField_addr();
 address jni_GetFloatField_addr();
 address jni_GetDoubleField_addr();
+address jni_GetArrayLength_addr();
 
 #endif // SHARE_PRIMS_JVM_MISC_HPP
@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/javaClasses.inline.hpp"
+#include "jvmtifiles/jvmtiEnv.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/oop.inline.hpp"
+#include "prims/jvmtiAllocationSampleBuffer.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/jniHandles.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/vframe.inline.hpp"
+#include "utilities/growableArray.hpp"
+
+JvmtiAllocationSampleBuffer::Stack::Stack(Stack* next, unsigned int hash, jint id,
+                                          const jvmtiFrameInfo* frames, jint depth) :
+  _next(next), _hash(hash), _id(id), _depth(depth) {
+  _frames = NEW_C_HEAP_ARRAY(jvmtiFrameInfo, depth, mtInternal);
+  memcpy(_frames, frames, depth * sizeof(jvmtiFrameInfo));
+}
+
+JvmtiAllocationSampleBuffer::Stack::~Stack() {
+  FREE_C_HEAP_ARRAY(jvmtiFrameInfo, _frames);
+}
+
+bool JvmtiAllocationSampleBuffer::Stack::equals(unsigned int hash, const jvmtiFrameInfo* frames, jint depth) const {
+  if (_hash != hash || _depth != depth) {
+    return false;
+  }
+  for (jint i = 0; i < depth; i++) {
+    if (_frames[i].method != frames[i].method || _frames[i].location != frames[i].location) {
+      return false;
+    }
+  }
+  return true;
+}
+
+JvmtiAllocationSampleBuffer::JvmtiAllocationSampleBuffer() :
+  _lock(Mutex::leaf, "JvmtiAllocationSampleBuffer._lock", true, Monitor::_safepoint_check_never),
+  _enabled(false),
+  _epoch(0),
+  _aggregate_count(0) {
+  memset(_stacks, 0, sizeof(_stacks));
+  memset(_aggregates, 0, sizeof(_aggregates));
+  _stacks_by_id = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<Stack*>(64, true, mtInternal);
+}
+
+JvmtiAllocationSampleBuffer::~JvmtiAllocationSampleBuffer() {
+  Aggregate* detached[aggregate_table_size];
+  {
+    MutexLocker ml(&_lock, Mutex::_no_safepoint_check_flag);
+    clear_locked(detached);
+  }
+  delete_aggregates(detached);
+  delete _stacks_by_id;
+}
+
+void JvmtiAllocationSampleBuffer::set_enabled(bool enabled) {
+  Aggregate* detached[aggregate_table_size];
+  {
+    MutexLocker ml(&_lock, Mutex::_no_safepoint_check_flag);
+    _enabled = enabled;
+    if (enabled) {
+      return;
+    }
+    clear_locked(detached);
+  }
+  delete_aggregates(detached);
+}
+
+// Unlinks the aggregates into detached_aggregates and deletes the stacks,
+// the aggregates hold JNI weak handles which are destroyed without the lock.
+void JvmtiAllocationSampleBuffer::clear_locked(Aggregate** detached_aggregates) {
+  assert(_lock.owned_by_self(), "invariant");
+  memcpy(detached_aggregates, _aggregates, sizeof(_aggregates));
+  memset(_aggregates, 0, sizeof(_aggregates));
+  _aggregate_count = 0;
+  for (int i = 0; i < _stacks_by_id->length(); i++) {
+    delete _stacks_by_id->at(i);
+  }
+  _stacks_by_id->clear();
+  memset(_stacks, 0, sizeof(_stacks));
+  _epoch++;
+}
+
+void JvmtiAllocationSampleBuffer::delete_aggregates(Aggregate** heads) {
+  for (int i = 0; i < aggregate_table_size; i++) {
+    Aggregate* entry = heads[i];
+    while (entry != NULL) {
+      Aggregate* next = entry->_next;
+      JNIHandles::destroy_weak_global(entry->_mirror);
+      delete entry;
+      entry = next;
+    }
+  }
+}
+
+unsigned int JvmtiAllocationSampleBuffer::hash_frames(const jvmtiFrameInfo* frames, jint depth) {
+  unsigned int hash = 1;
+  for (jint i = 0; i < depth; i++) {
+    hash = 31 * hash + (unsigned int)(uintptr_t)frames[i].method;
+    hash = 31 * hash + (unsigned int)frames[i].location;
+  }
+  return hash;
+}
+
+// Returns -1 once the table is full
+jint JvmtiAllocationSampleBuffer::lookup_or_add_stack(const jvmtiFrameInfo* frames, jint depth) {
+  assert(_lock.owned_by_self(), "invariant");
+  const unsigned int hash = hash_frames(frames, depth);
+  const unsigned int index = hash % stack_table_size;
+  for (const Stack* stack = _stacks[index]; stack != NULL; stack = stack->_next) {
+    if (stack->equals(hash, frames, depth)) {
+      return stack->_id;
+    }
+  }
+  if (_stacks_by_id->length() >= max_stacks) {
+    return -1;
+  }
+  const jint id = _stacks_by_id->length();
+  Stack* const stack = new Stack(_stacks[index], hash, id, frames, depth);
+  _stacks[index] = stack;
+  _stacks_by_id->append(stack);
+  return id;
+}
+
+JvmtiAllocationSampleBuffer::Aggregate*
+JvmtiAllocationSampleBuffer::lookup_aggregate(jint stack_id, Klass* klass, unsigned int index) const {
+  assert(_lock.owned_by_self(), "invariant");
+  for (Aggregate* entry = _aggregates[index]; entry != NULL; entry = entry->_next) {
+    // A cleared mirror means the class was unloaded and the Klass* may
+    // have been reused for another class.
+    if (entry->_stack_id == stack_id && entry->_klass == klass &&
+        JNIHandles::resolve(entry->_mirror) == klass->java_mirror()) {
+      return entry;
+    }
+  }
+  return NULL;
+}
+
+void JvmtiAllocationSampleBuffer::record(JavaThread* thread, oop obj, jlong size) {
+  assert(thread->thread_state() == _thread_in_vm, "must be in vm state");
+  jvmtiFrameInfo frames[max_frames];
+  jint depth = 0;
+  // The jmethodIDs are resolved before taking the lock, creating one may block.
+  for (vframeStream vfst(thread); !vfst.at_end() && depth < max_frames; vfst.next()) {
+    Method* const method = vfst.method();
+    frames[depth].method = method->jmethod_id();
+    frames[depth].location = method->is_native() ? -1 : vfst.bci();
+    depth++;
+  }
+  Klass* const klass = obj->klass();
+  jint stack_id;
+  unsigned int index;
+  uint epoch;
+  {
+    MutexLocker ml(&_lock, Mutex::_no_safepoint_check_flag);
+    if (!_enabled) {
+      return;
+    }
+    epoch = _epoch;
+    stack_id = lookup_or_add_stack(frames, depth);
+    index = ((unsigned int)stack_id * 31 + (unsigned int)((uintptr_t)klass >> LogHeapWordSize)) % aggregate_table_size;
+    Aggregate* const entry = lookup_aggregate(stack_id, klass, index);
+    if (entry != NULL) {
+      entry->_count++;
+      entry->_bytes += size;
+      return;
+    }
+  }
+  // First sample for this stack trace and class, the weak handle is
+  // allocated without holding the lock.
+  HandleMark hm(thread);
+  Handle mirror(thread, klass->java_mirror());
+  Aggregate* const entry = new Aggregate();
+  entry->_stack_id = stack_id;
+  entry->_klass = klass;
+  entry->_mirror = JNIHandles::make_weak_global(mirror);
+  entry->_count = 1;
+  entry->_bytes = size;
+  {
+    MutexLocker ml(&_lock, Mutex::_no_safepoint_check_flag);
+    if (_enabled && _epoch == epoch) {
+      Aggregate* const existing = lookup_aggregate(stack_id, klass, index);
+      if (existing == NULL) {
+        entry->_next = _aggregates[index];
+        _aggregates[index] = entry;
+        _aggregate_count++;
+        return;
+      }
+      existing->_count++;
+      existing->_bytes += size;
+    }
+  }
+  JNIHandles::destroy_weak_global(entry->_mirror);
+  delete entry;
+}
+
+jvmtiError JvmtiAllocationSampleBuffer::drain(JvmtiEnv* env, jint* count_ptr, jclass** classes_ptr,
+                                              jint** stack_ids_ptr, jlong** counts_ptr, jlong** bytes_ptr) {
+  Aggregate* detached[aggregate_table_size];
+  jint count;
+  {
+    MutexLocker ml(&_lock, Mutex::_no_safepoint_check_flag);
+    memcpy(detached, _aggregates, sizeof(_aggregates));
+    memset(_aggregates, 0, sizeof(_aggregates));
+    count = _aggregate_count;
+    _aggregate_count = 0;
+  }
+  jclass* classes = NULL;
+  jint* stack_ids = NULL;
+  jlong* counts = NULL;
+  jlong* bytes = NULL;
+  jvmtiError err = env->allocate(count * sizeof(jclass), (unsigned char**)&classes);
+  if (err == JVMTI_ERROR_NONE) {
+    err = env->allocate(count * sizeof(jint), (unsigned char**)&stack_ids);
+  }
+  if (err == JVMTI_ERROR_NONE) {
+    err = env->allocate(count * sizeof(jlong), (unsigned char**)&counts);
+  }
+  if (err == JVMTI_ERROR_NONE) {
+    err = env->allocate(count * sizeof(jlong), (unsigned char**)&bytes);
+  }
+  if (err != JVMTI_ERROR_NONE) {
+    // The drained samples are lost
+    env->deallocate((unsigned char*)classes);
+    env->deallocate((unsigned char*)stack_ids);
+    env->deallocate((unsigned char*)counts);
+    delete_aggregates(detached);
+    return err;
+  }
+  jint n = 0;
+  for (int i = 0; i < aggregate_table_size; i++) {
+    for (Aggregate* entry = detached[i]; entry != NULL; entry = entry->_next) {
+      assert(n < count, "invariant");
+      oop mirror = JNIHandles::resolve(entry->_mirror);
+      classes[n] = mirror == NULL ? NULL : (jclass)JNIHandles::make_local(mirror);
+      stack_ids[n] = entry->_stack_id;
+      counts[n] = entry->_count;
+      bytes[n] = entry->_bytes;
+      n++;
+    }
+  }
+  delete_aggregates(detached);
+  *count_ptr = n;
+  *classes_ptr = classes;
+  *stack_ids_ptr = stack_ids;
+  *counts_ptr = counts;
+  *bytes_ptr = bytes;
+  return JVMTI_ERROR_NONE;
+}
+
+jvmtiError JvmtiAllocationSampleBuffer::get_stack(jint stack_id, jint max_frame_count,
+                                                  jvmtiFrameInfo* frame_buffer, jint* count_ptr) {
+  MutexLocker ml(&_lock, Mutex::_no_safepoint_check_flag);
+  if (stack_id < 0 || stack_id >= _stacks_by_id->length()) {
+    return JVMTI_ERROR_ILLEGAL_ARGUMENT;
+  }
+  const Stack* const stack = _stacks_by_id->at(stack_id);
+  const jint count = MIN2(max_frame_count, stack->_depth);
+  memcpy(frame_buffer, stack->_frames, count * sizeof(jvmtiFrameInfo));
+  *count_ptr = count;
+  return JVMTI_ERROR_NONE;
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_PRIMS_JVMTIALLOCATIONSAMPLEBUFFER_HPP
+#define SHARE_PRIMS_JVMTIALLOCATIONSAMPLEBUFFER_HPP
+
+#include "jvmtifiles/jvmti.h"
+#include "memory/allocation.hpp"
+#include "oops/oopsHierarchy.hpp"
+#include "runtime/mutex.hpp"
+
+template <class E> class GrowableArray;
+class JavaThread;
+class JvmtiEnv;
+class Klass;
+
+// Buffers the sampled object allocations of one environment when the agent
+// prefers to poll for them over receiving a SampledObjectAlloc callback per
+// sample. The stack traces are captured by the VM and deduplicated, the
+// samples are aggregated per stack trace and class until they are drained.
+class JvmtiAllocationSampleBuffer : public CHeapObj<mtInternal> {
+ private:
+  enum {
+    stack_table_size     = 1021,
+    aggregate_table_size = 1021,
+    max_frames           = 64,
+    max_stacks           = 64 * K
+  };
+
+  // A deduplicated stack trace, identified by its index in _stacks_by_id
+  class Stack : public CHeapObj<mtInternal> {
+   public:
+    Stack* _next;
+    unsigned int _hash;
+    jint _id;
+    jint _depth;
+    jvmtiFrameInfo* _frames;
+
+    Stack(Stack* next, unsigned int hash, jint id, const jvmtiFrameInfo* frames, jint depth);
+    ~Stack();
+    bool equals(unsigned int hash, const jvmtiFrameInfo* frames, jint depth) const;
+  };
+
+  // The samples with the same stack trace and class
+  class Aggregate : public CHeapObj<mtInternal> {
+   public:
+    Aggregate* _next;
+    jint _stack_id;
+    Klass* _klass;
+    jweak _mirror;
+    jlong _count;
+    jlong _bytes;
+  };
+
+  Mutex _lock;
+  volatile bool _enabled;
+  // Incremented when the stack traces are deleted, invalidating their ids
+  uint _epoch;
+  Stack* _stacks[stack_table_size];
+  GrowableArray<Stack*>* _stacks_by_id;
+  Aggregate* _aggregates[aggregate_table_size];
+  jint _aggregate_count;
+
+  static unsigned int hash_frames(const jvmtiFrameInfo* frames, jint depth);
+  jint lookup_or_add_stack(const jvmtiFrameInfo* frames, jint depth);
+  Aggregate* lookup_aggregate(jint stack_id, Klass* klass, unsigned int index) const;
+  void clear_locked(Aggregate** detached_aggregates);
+  static void delete_aggregates(Aggregate** heads);
+
+ public:
+  JvmtiAllocationSampleBuffer();
+  ~JvmtiAllocationSampleBuffer();
+
+  bool is_enabled() const { return _enabled; }
+  // Disabling drops the buffered samples and stack traces
+  void set_enabled(bool enabled);
+
+  // Called in the allocating thread instead of posting SampledObjectAlloc
+  void record(JavaThread* thread, oop obj, jlong size);
+
+  // Hands out the aggregated samples, with local references to the classes,
+  // in arrays allocated with the environment, and empties the buffer.
+  jvmtiError drain(JvmtiEnv* env, jint* count_ptr, jclass** classes_ptr, jint** stack_ids_ptr,
+                   jlong** counts_ptr, jlong** bytes_ptr);
+
+  jvmtiError get_stack(jint stack_id, jint max_frame_count, jvmtiFrameInfo* frame_buffer, jint* count_ptr);
+};
+
+#endif // SHARE_PRIMS_JVMTIALLOCATIONSAMPLEBUFFER_HPP
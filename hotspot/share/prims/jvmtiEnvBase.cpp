@@ -32,6 +32,7 @@
 #include "oops/objArrayOop.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/oopHandle.inline.hpp"
+#include "prims/jvmtiAllocationSampleBuffer.hpp"
 #include "prims/jvmtiEnvBase.hpp"
 #include "prims/jvmtiEventController.inline.hpp"
 #include "prims/jvmtiExtensions.hpp"
@@ -39,6 +40,7 @@
 #include "prims/jvmtiManageCapabilities.hpp"
 #include "prims/jvmtiTagMap.hpp"
 #include "prims/jvmtiThreadState.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/biasedLocking.hpp"
 #include "runtime/deoptimization.hpp"
 #include "runtime/frame.inline.hpp"
@@ -193,6 +195,7 @@ JvmtiEnvBase::JvmtiEnvBase(jint version) : _env_event_enable() {
   _version = version;
   _env_local_storage = NULL;
   _tag_map = NULL;
+  _allocation_sample_buffer = NULL;
   _native_method_prefix_count = 0;
   _native_method_prefixes = NULL;
   _next = NULL;
@@ -262,6 +265,12 @@ JvmtiEnvBase::env_dispose() {
     delete tag_map_to_deallocate;
   }
 
+  JvmtiAllocationSampleBuffer* buffer_to_deallocate = _allocation_sample_buffer;
+  _allocation_sample_buffer = NULL;
+  if (buffer_to_deallocate != NULL) {
+    delete buffer_to_deallocate;
+  }
+
   _needs_clean_up = true;
 }
 
@@ -279,9 +288,28 @@ JvmtiEnvBase::~JvmtiEnvBase() {
     delete tag_map_to_deallocate;
   }
 
+  if (_allocation_sample_buffer != NULL) {
+    delete _allocation_sample_buffer;
+    _allocation_sample_buffer = NULL;
+  }
+
   _magic = BAD_MAGIC;
 }
 
+JvmtiAllocationSampleBuffer* JvmtiEnvBase::allocation_sample_buffer() {
+  JvmtiAllocationSampleBuffer* buffer = allocation_sample_buffer_acquire();
+  if (buffer == NULL) {
+    JvmtiAllocationSampleBuffer* new_buffer = new JvmtiAllocationSampleBuffer();
+    buffer = Atomic::cmpxchg(new_buffer, &_allocation_sample_buffer, (JvmtiAllocationSampleBuffer*)NULL);
+    if (buffer == NULL) {
+      buffer = new_buffer;
+    } else {
+      delete new_buffer;
+    }
+  }
+  return buffer;
+}
+
 
 void
 JvmtiEnvBase::periodic_clean_up() {
@@ -47,6 +47,7 @@ class JvmtiThreadState;
 class JvmtiRawMonitor; // for jvmtiEnv.hpp
 class JvmtiEventControllerPrivate;
 class JvmtiTagMap;
+class JvmtiAllocationSampleBuffer;
 
 
 
@@ -100,6 +101,7 @@ class JvmtiEnvBase : public CHeapObj<mtInternal> {
   jvmtiEventCallbacks _event_callbacks;
   jvmtiExtEventCallbacks _ext_event_callbacks;
   JvmtiTagMap* volatile _tag_map;
+  JvmtiAllocationSampleBuffer* volatile _allocation_sample_buffer;
   JvmtiEnvEventEnable _env_event_enable;
   jvmtiCapabilities _current_capabilities;
   jvmtiCapabilities _prohibited_capabilities;
@@ -262,6 +264,13 @@ class JvmtiEnvBase : public CHeapObj<mtInternal> {
     OrderAccess::release_store(&_tag_map, tag_map);
   }
 
+  JvmtiAllocationSampleBuffer* allocation_sample_buffer_acquire() {
+    return OrderAccess::load_acquire(&_allocation_sample_buffer);
+  }
+
+  // Creates the buffer on first use
+  JvmtiAllocationSampleBuffer* allocation_sample_buffer();
+
   // return true if event is enabled globally or for any thread
   // True only if there is a callback for it.
   bool is_enabled(jvmtiEvent event_type) {
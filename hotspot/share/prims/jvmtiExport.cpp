@@ -39,6 +39,7 @@
 #include "oops/objArrayKlass.hpp"
 #include "oops/objArrayOop.hpp"
 #include "oops/oop.inline.hpp"
+#include "prims/jvmtiAllocationSampleBuffer.hpp"
 #include "prims/jvmtiCodeBlobEvents.hpp"
 #include "prims/jvmtiEventController.hpp"
 #include "prims/jvmtiEventController.inline.hpp"
@@ -2572,6 +2573,12 @@ void JvmtiExport::post_sampled_object_alloc(JavaThread *thread, oop object) {
                  object == NULL ? "NULL" : object->klass()->external_name()));
 
       JvmtiEnv *env = ets->get_env();
+      JvmtiAllocationSampleBuffer* buffer = env->allocation_sample_buffer_acquire();
+      if (buffer != NULL && buffer->is_enabled()) {
+        // The agent polls for the samples instead of the callback
+        buffer->record(thread, h(), (jlong)h()->size() * wordSize);
+        continue;
+      }
       JvmtiObjectAllocEventMark jem(thread, h());
       JvmtiJavaThreadEventTransition jet(thread);
       jvmtiEventSampledObjectAlloc callback = env->callbacks()->SampledObjectAlloc;
@@ -23,8 +23,20 @@
  */
 
 #include "precompiled.hpp"
+#include "classfile/javaClasses.inline.hpp"
+#include "memory/resourceArea.hpp"
+#include "prims/jvmtiAllocationSampleBuffer.hpp"
 #include "prims/jvmtiExport.hpp"
 #include "prims/jvmtiExtensions.hpp"
+#include "prims/jvmtiTagMap.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/handshake.hpp"
+#include "runtime/interfaceSupport.inline.hpp"
+#include "runtime/jniHandles.inline.hpp"
+#include "runtime/thread.inline.hpp"
+#include "runtime/threadSMR.hpp"
+#include "runtime/timerTrace.hpp"
+#include "runtime/vframe.hpp"
 
 // the list of extension functions
 GrowableArray<jvmtiExtensionFunctionInfo*>* JvmtiExtensions::_ext_functions;
@@ -42,14 +54,229 @@ static jvmtiError JNICALL IsClassUnloadingEnabled(const jvmtiEnv* env, jboolean*
   return JVMTI_ERROR_NONE;
 }
 
+// Walks the Java frames of the thread that executes it, which is either the
+// thread itself or the VM thread on behalf of a thread that is blocked or
+// in native; in both cases the stack does not change during the walk.
+class GetStackTraceAtPollClosure : public ThreadClosure {
+ private:
+  jint _max_frame_count;
+  jvmtiFrameInfo* _frame_buffer;
+  jint _count;
+
+ public:
+  GetStackTraceAtPollClosure(jint max_frame_count, jvmtiFrameInfo* frame_buffer) :
+    _max_frame_count(max_frame_count), _frame_buffer(frame_buffer), _count(0) {}
+
+  void do_thread(Thread* thread) {
+    JavaThread* jt = (JavaThread*)thread;
+    _count = 0;
+    if (!jt->has_last_Java_frame()) {
+      return;
+    }
+    ResourceMark rm;
+    RegisterMap reg_map(jt, false);
+    for (javaVFrame* jvf = jt->last_java_vframe(&reg_map);
+         jvf != NULL && _count < _max_frame_count;
+         jvf = jvf->java_sender()) {
+      Method* method = jvf->method();
+      _frame_buffer[_count].method = method->jmethod_id();
+      _frame_buffer[_count].location = method->is_native() ? -1 : jvf->bci();
+      _count++;
+    }
+  }
+
+  jint count() const { return _count; }
+};
+
+// extension function
+// Same result as GetStackTrace with a start depth of 0, but the target is
+// walked at its next safepoint poll through a thread-local handshake, so
+// neither a safepoint nor suspending the target is needed.
+static jvmtiError JNICALL GetStackTraceAtPoll(const jvmtiEnv* env, jthread thread, jint max_frame_count,
+                                              jvmtiFrameInfo* frame_buffer, jint* count_ptr, ...) {
+  if (frame_buffer == NULL || count_ptr == NULL) {
+    return JVMTI_ERROR_NULL_POINTER;
+  }
+  if (max_frame_count < 0) {
+    return JVMTI_ERROR_ILLEGAL_ARGUMENT;
+  }
+  Thread* current = Thread::current_or_null();
+  if (current == NULL || !current->is_Java_thread()) {
+    return JVMTI_ERROR_UNATTACHED_THREAD;
+  }
+  JavaThread* current_thread = (JavaThread*)current;
+  ThreadInVMfromNative tiv(current_thread);
+  HandleMark hm(current_thread);
+
+  ThreadsListHandle tlh(current_thread);
+  JavaThread* java_thread = NULL;
+  jvmtiError err = JvmtiExport::cv_external_thread_to_JavaThread(tlh.list(), thread, &java_thread, NULL);
+  if (err != JVMTI_ERROR_NONE) {
+    return err;
+  }
+
+  GetStackTraceAtPollClosure cl(max_frame_count, frame_buffer);
+  if (java_thread == current_thread) {
+    cl.do_thread(java_thread);
+  } else if (!Handshake::execute(&cl, java_thread)) {
+    return JVMTI_ERROR_THREAD_NOT_ALIVE;
+  }
+  *count_ptr = cl.count();
+  return JVMTI_ERROR_NONE;
+}
+
+// extension function
+// Same as IterateThroughHeap, but the heap is iterated by up to worker_count
+// GC worker threads in parallel. The callbacks run concurrently on those
+// threads and worker i passes user_data[i]; the number of workers used is
+// returned in worker_count_ptr. Primitive field callbacks, and collectors
+// without a parallel object iterator, fall back to one worker. Tag changes
+// made by the callbacks take effect once the iteration is complete.
+static jvmtiError JNICALL ParallelIterateThroughHeap(jvmtiEnv* env, jint heap_filter, jclass klass,
+                                                     const jvmtiHeapCallbacks* callbacks, jint worker_count,
+                                                     void* const* user_data, jint* worker_count_ptr, ...) {
+  if (callbacks == NULL || user_data == NULL || worker_count_ptr == NULL) {
+    return JVMTI_ERROR_NULL_POINTER;
+  }
+  if (worker_count < 1) {
+    return JVMTI_ERROR_ILLEGAL_ARGUMENT;
+  }
+  JvmtiEnv* jvmti_env = JvmtiEnv::JvmtiEnv_from_jvmti_env(env);
+  if (!jvmti_env->is_valid()) {
+    return JVMTI_ERROR_INVALID_ENVIRONMENT;
+  }
+  if (jvmti_env->phase() != JVMTI_PHASE_LIVE) {
+    return JVMTI_ERROR_WRONG_PHASE;
+  }
+  if (jvmti_env->get_capabilities()->can_tag_objects == 0) {
+    return JVMTI_ERROR_MUST_POSSESS_CAPABILITY;
+  }
+  Thread* current = Thread::current_or_null();
+  if (current == NULL || !current->is_Java_thread()) {
+    return JVMTI_ERROR_UNATTACHED_THREAD;
+  }
+  JavaThread* current_thread = (JavaThread*)current;
+  ThreadInVMfromNative tiv(current_thread);
+  HandleMark hm(current_thread);
+
+  // check klass if provided
+  Klass* k = NULL;
+  if (klass != NULL) {
+    oop k_mirror = JNIHandles::resolve_external_guard(klass);
+    if (k_mirror == NULL) {
+      return JVMTI_ERROR_INVALID_CLASS;
+    }
+    if (java_lang_Class::is_primitive(k_mirror)) {
+      *worker_count_ptr = 0;
+      return JVMTI_ERROR_NONE;
+    }
+    k = java_lang_Class::as_Klass(k_mirror);
+    if (k == NULL) {
+      return JVMTI_ERROR_INVALID_CLASS;
+    }
+  }
+
+  TraceTime t("ParallelIterateThroughHeap", TRACETIME_LOG(Debug, jvmti, objecttagging));
+  *worker_count_ptr = JvmtiTagMap::tag_map_for(jvmti_env)->parallel_iterate_through_heap(heap_filter, k, callbacks,
+                                                                                         worker_count, user_data);
+  return JVMTI_ERROR_NONE;
+}
+
+// Checks shared by the allocation sample buffer functions
+static jvmtiError check_allocation_sampling_env(jvmtiEnv* env, JvmtiEnv** jvmti_env_ptr) {
+  JvmtiEnv* jvmti_env = JvmtiEnv::JvmtiEnv_from_jvmti_env(env);
+  if (!jvmti_env->is_valid()) {
+    return JVMTI_ERROR_INVALID_ENVIRONMENT;
+  }
+  if (jvmti_env->get_capabilities()->can_generate_sampled_object_alloc_events == 0) {
+    return JVMTI_ERROR_MUST_POSSESS_CAPABILITY;
+  }
+  Thread* current = Thread::current_or_null();
+  if (current == NULL || !current->is_Java_thread()) {
+    return JVMTI_ERROR_UNATTACHED_THREAD;
+  }
+  *jvmti_env_ptr = jvmti_env;
+  return JVMTI_ERROR_NONE;
+}
+
+// extension function
+// While enabled, the SampledObjectAlloc events of the environment are not
+// posted; the VM captures the stack trace of each sample and aggregates the
+// samples per deduplicated stack trace and class until they are drained.
+// The event still has to be enabled with SetEventNotificationMode.
+// Disabling drops the samples and stack traces not drained yet.
+static jvmtiError JNICALL SetAllocationSampleBuffering(jvmtiEnv* env, jboolean enable, ...) {
+  JvmtiEnv* jvmti_env = NULL;
+  jvmtiError err = check_allocation_sampling_env(env, &jvmti_env);
+  if (err != JVMTI_ERROR_NONE) {
+    return err;
+  }
+  ThreadInVMfromNative tiv((JavaThread*)Thread::current());
+  if (enable) {
+    jvmti_env->allocation_sample_buffer()->set_enabled(true);
+  } else {
+    JvmtiAllocationSampleBuffer* buffer = jvmti_env->allocation_sample_buffer_acquire();
+    if (buffer != NULL) {
+      buffer->set_enabled(false);
+    }
+  }
+  return JVMTI_ERROR_NONE;
+}
+
+// extension function
+// Returns the aggregated samples since the last drain in arrays allocated
+// with Allocate: the class (a local reference, NULL if it was unloaded), the
+// stack trace id, the number of samples and their total size in bytes.
+static jvmtiError JNICALL DrainAllocationSamples(jvmtiEnv* env, jint* count_ptr, jclass** classes_ptr,
+                                                 jint** stack_ids_ptr, jlong** counts_ptr,
+                                                 jlong** bytes_ptr, ...) {
+  if (count_ptr == NULL || classes_ptr == NULL || stack_ids_ptr == NULL ||
+      counts_ptr == NULL || bytes_ptr == NULL) {
+    return JVMTI_ERROR_NULL_POINTER;
+  }
+  JvmtiEnv* jvmti_env = NULL;
+  jvmtiError err = check_allocation_sampling_env(env, &jvmti_env);
+  if (err != JVMTI_ERROR_NONE) {
+    return err;
+  }
+  JavaThread* current_thread = (JavaThread*)Thread::current();
+  ThreadInVMfromNative tiv(current_thread);
+  HandleMark hm(current_thread);
+  return jvmti_env->allocation_sample_buffer()->drain(jvmti_env, count_ptr, classes_ptr, stack_ids_ptr,
+                                                      counts_ptr, bytes_ptr);
+}
+
+// extension function
+// Resolves a stack trace id returned by DrainAllocationSamples, the frames
+// are in the same form as returned by GetStackTrace.
+static jvmtiError JNICALL GetAllocationSampleStackTrace(jvmtiEnv* env, jint stack_id, jint max_frame_count,
+                                                        jvmtiFrameInfo* frame_buffer, jint* count_ptr, ...) {
+  if (frame_buffer == NULL || count_ptr == NULL) {
+    return JVMTI_ERROR_NULL_POINTER;
+  }
+  if (max_frame_count < 0) {
+    return JVMTI_ERROR_ILLEGAL_ARGUMENT;
+  }
+  JvmtiEnv* jvmti_env = NULL;
+  jvmtiError err = check_allocation_sampling_env(env, &jvmti_env);
+  if (err != JVMTI_ERROR_NONE) {
+    return err;
+  }
+  ThreadInVMfromNative tiv((JavaThread*)Thread::current());
+  return jvmti_env->allocation_sample_buffer()->get_stack(stack_id, max_frame_count, frame_buffer, count_ptr);
+}
+
 // register extension functions and events. In this implementation we
-// have a single extension function (to prove the API) that tests if class
-// unloading is enabled or disabled. We also have a single extension event
+// have an extension function (to prove the API) that tests if class
+// unloading is enabled or disabled, one that takes the stack trace of
+// a thread with a handshake, one that iterates the heap with
+// multiple threads, and three to poll for sampled allocations.
+// We also have a single extension event We also have a single extension event
 // EXT_EVENT_CLASS_UNLOAD which is used to provide the JVMDI_EVENT_CLASS_UNLOAD
 // event. The function and the event are registered here.
 //
 void JvmtiExtensions::register_extensions() {
-  _ext_functions = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<jvmtiExtensionFunctionInfo*>(1,true);
+  _ext_functions = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<jvmtiExtensionFunctionInfo*>(6,true);
   _ext_events = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<jvmtiExtensionEventInfo*>(1,true);
 
   // register our extension function
@@ -67,6 +294,111 @@ void JvmtiExtensions::register_extensions() {
   };
   _ext_functions->append(&ext_func);
 
+  static jvmtiParamInfo stack_trace_params[] = {
+    { (char*)"thread", JVMTI_KIND_IN, JVMTI_TYPE_JTHREAD, JNI_FALSE },
+    { (char*)"max_frame_count", JVMTI_KIND_IN, JVMTI_TYPE_JINT, JNI_FALSE },
+    { (char*)"frame_buffer", JVMTI_KIND_OUT_BUF, JVMTI_TYPE_CVOID, JNI_FALSE },
+    { (char*)"count_ptr", JVMTI_KIND_OUT, JVMTI_TYPE_JINT, JNI_FALSE }
+  };
+  static jvmtiError stack_trace_errors[] = {
+    JVMTI_ERROR_INVALID_THREAD,
+    JVMTI_ERROR_THREAD_NOT_ALIVE,
+    JVMTI_ERROR_ILLEGAL_ARGUMENT
+  };
+  static jvmtiExtensionFunctionInfo stack_trace_func = {
+    (jvmtiExtensionFunction)GetStackTraceAtPoll,
+    (char*)"com.sun.hotspot.functions.GetStackTraceAtPoll",
+    (char*)"Get the stack trace of a thread at its next safepoint poll, with a thread-local handshake",
+    sizeof(stack_trace_params)/sizeof(stack_trace_params[0]),
+    stack_trace_params,
+    sizeof(stack_trace_errors)/sizeof(stack_trace_errors[0]),
+    stack_trace_errors
+  };
+  _ext_functions->append(&stack_trace_func);
+
+  static jvmtiParamInfo heap_iterate_params[] = {
+    { (char*)"heap_filter", JVMTI_KIND_IN, JVMTI_TYPE_JINT, JNI_FALSE },
+    { (char*)"klass", JVMTI_KIND_IN, JVMTI_TYPE_JCLASS, JNI_TRUE },
+    { (char*)"callbacks", JVMTI_KIND_IN_PTR, JVMTI_TYPE_CVOID, JNI_FALSE },
+    { (char*)"worker_count", JVMTI_KIND_IN, JVMTI_TYPE_JINT, JNI_FALSE },
+    { (char*)"user_data", JVMTI_KIND_IN_BUF, JVMTI_TYPE_CVOID, JNI_FALSE },
+    { (char*)"worker_count_ptr", JVMTI_KIND_OUT, JVMTI_TYPE_JINT, JNI_FALSE }
+  };
+  static jvmtiError heap_iterate_errors[] = {
+    JVMTI_ERROR_MUST_POSSESS_CAPABILITY,
+    JVMTI_ERROR_INVALID_CLASS,
+    JVMTI_ERROR_ILLEGAL_ARGUMENT
+  };
+  static jvmtiExtensionFunctionInfo heap_iterate_func = {
+    (jvmtiExtensionFunction)ParallelIterateThroughHeap,
+    (char*)"com.sun.hotspot.functions.ParallelIterateThroughHeap",
+    (char*)"Iterate through the heap with multiple threads, with one user data pointer per thread",
+    sizeof(heap_iterate_params)/sizeof(heap_iterate_params[0]),
+    heap_iterate_params,
+    sizeof(heap_iterate_errors)/sizeof(heap_iterate_errors[0]),
+    heap_iterate_errors
+  };
+  _ext_functions->append(&heap_iterate_func);
+
+  static jvmtiParamInfo sample_buffering_params[] = {
+    { (char*)"enable", JVMTI_KIND_IN, JVMTI_TYPE_JBOOLEAN, JNI_FALSE }
+  };
+  static jvmtiError sample_buffering_errors[] = {
+    JVMTI_ERROR_MUST_POSSESS_CAPABILITY
+  };
+  static jvmtiExtensionFunctionInfo sample_buffering_func = {
+    (jvmtiExtensionFunction)SetAllocationSampleBuffering,
+    (char*)"com.sun.hotspot.functions.SetAllocationSampleBuffering",
+    (char*)"Buffer the sampled allocations with their stack traces instead of posting SampledObjectAlloc",
+    sizeof(sample_buffering_params)/sizeof(sample_buffering_params[0]),
+    sample_buffering_params,
+    sizeof(sample_buffering_errors)/sizeof(sample_buffering_errors[0]),
+    sample_buffering_errors
+  };
+  _ext_functions->append(&sample_buffering_func);
+
+  static jvmtiParamInfo drain_samples_params[] = {
+    { (char*)"count_ptr", JVMTI_KIND_OUT, JVMTI_TYPE_JINT, JNI_FALSE },
+    { (char*)"classes_ptr", JVMTI_KIND_ALLOC_BUF, JVMTI_TYPE_JCLASS, JNI_FALSE },
+    { (char*)"stack_ids_ptr", JVMTI_KIND_ALLOC_BUF, JVMTI_TYPE_JINT, JNI_FALSE },
+    { (char*)"counts_ptr", JVMTI_KIND_ALLOC_BUF, JVMTI_TYPE_JLONG, JNI_FALSE },
+    { (char*)"bytes_ptr", JVMTI_KIND_ALLOC_BUF, JVMTI_TYPE_JLONG, JNI_FALSE }
+  };
+  static jvmtiError drain_samples_errors[] = {
+    JVMTI_ERROR_MUST_POSSESS_CAPABILITY
+  };
+  static jvmtiExtensionFunctionInfo drain_samples_func = {
+    (jvmtiExtensionFunction)DrainAllocationSamples,
+    (char*)"com.sun.hotspot.functions.DrainAllocationSamples",
+    (char*)"Get and clear the buffered allocation samples, aggregated per stack trace and class",
+    sizeof(drain_samples_params)/sizeof(drain_samples_params[0]),
+    drain_samples_params,
+    sizeof(drain_samples_errors)/sizeof(drain_samples_errors[0]),
+    drain_samples_errors
+  };
+  _ext_functions->append(&drain_samples_func);
+
+  static jvmtiParamInfo sample_stack_params[] = {
+    { (char*)"stack_id", JVMTI_KIND_IN, JVMTI_TYPE_JINT, JNI_FALSE },
+    { (char*)"max_frame_count", JVMTI_KIND_IN, JVMTI_TYPE_JINT, JNI_FALSE },
+    { (char*)"frame_buffer", JVMTI_KIND_OUT_BUF, JVMTI_TYPE_CVOID, JNI_FALSE },
+    { (char*)"count_ptr", JVMTI_KIND_OUT, JVMTI_TYPE_JINT, JNI_FALSE }
+  };
+  static jvmtiError sample_stack_errors[] = {
+    JVMTI_ERROR_MUST_POSSESS_CAPABILITY,
+    JVMTI_ERROR_ILLEGAL_ARGUMENT
+  };
+  static jvmtiExtensionFunctionInfo sample_stack_func = {
+    (jvmtiExtensionFunction)GetAllocationSampleStackTrace,
+    (char*)"com.sun.hotspot.functions.GetAllocationSampleStackTrace",
+    (char*)"Get the frames of a stack trace id returned by DrainAllocationSamples",
+    sizeof(sample_stack_params)/sizeof(sample_stack_params[0]),
+    sample_stack_params,
+    sizeof(sample_stack_errors)/sizeof(sample_stack_errors[0]),
+    sample_stack_errors
+  };
+  _ext_functions->append(&sample_stack_func);
+
   // register our extension event
 
   static jvmtiParamInfo event_params[] = {
@@ -28,6 +28,7 @@
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "classfile/vmSymbols.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "jvmtifiles/jvmtiEnv.hpp"
 #include "logging/log.hpp"
 #include "memory/allocation.inline.hpp"
@@ -132,6 +133,11 @@ class JvmtiTagHashmapEntry : public CHeapObj<mtInternal> {
 // A hashmap provides functions for adding, removing, and finding
 // entries. It also provides a function to iterate over all entries
 // in the hashmap.
+//
+// When the GC moves tagged objects their entries are left at their old
+// positions and the hashmap is flagged as needing a rehash. The rehash
+// is done by the next operation that hashes a key, so that the GC pause
+// only pays for updating the oops and removing the dead entries.
 
 class JvmtiTagHashmap : public CHeapObj<mtInternal> {
  private:
@@ -153,6 +159,7 @@ class JvmtiTagHashmap : public CHeapObj<mtInternal> {
   float _load_factor;                   // load factor as a % of the size
   int _resize_threshold;                // computed threshold to trigger resizing.
   bool _resizing_enabled;               // indicates if hashmap can resize
+  bool _needs_rehashing;                // entries moved by the GC are at stale positions
 
   int _trace_threshold;                 // threshold for trace messages
 
@@ -172,6 +179,7 @@ class JvmtiTagHashmap : public CHeapObj<mtInternal> {
     _load_factor = load_factor;
     _resize_threshold = (int)(_load_factor * _size);
     _resizing_enabled = true;
+    _needs_rehashing = false;
     size_t s = initial_size * sizeof(JvmtiTagHashmapEntry*);
     _table = (JvmtiTagHashmapEntry**)os::malloc(s, mtInternal);
     if (_table == NULL) {
@@ -248,8 +256,60 @@ class JvmtiTagHashmap : public CHeapObj<mtInternal> {
 
     // compute new resize threshold
     _resize_threshold = (int)(_load_factor * _size);
+
+    // all entries have been hashed with their current addresses
+    _needs_rehashing = false;
   }
 
+  // move the entries of objects relocated by the GC to their new positions
+  void rehash() {
+    int moved = 0;
+    JvmtiTagHashmapEntry* delayed_add = NULL;
+
+    for (int pos = 0; pos < _size; ++pos) {
+      JvmtiTagHashmapEntry* entry = _table[pos];
+      JvmtiTagHashmapEntry* prev = NULL;
+
+      while (entry != NULL) {
+        JvmtiTagHashmapEntry* next = entry->next();
+        unsigned int new_pos = hash(entry->object_peek());
+        if (new_pos != (unsigned int)pos) {
+          if (prev == NULL) {
+            _table[pos] = next;
+          } else {
+            prev->set_next(next);
+          }
+          if (new_pos < (unsigned int)pos) {
+            entry->set_next(_table[new_pos]);
+            _table[new_pos] = entry;
+          } else {
+            // Delay adding this entry to it's new position as we'd end up
+            // hitting it again during this iteration.
+            entry->set_next(delayed_add);
+            delayed_add = entry;
+          }
+          moved++;
+        } else {
+          prev = entry;
+        }
+        entry = next;
+      }
+    }
+
+    // Re-add all the entries which were kept aside
+    while (delayed_add != NULL) {
+      JvmtiTagHashmapEntry* next = delayed_add->next();
+      unsigned int pos = hash(delayed_add->object_peek());
+      delayed_add->set_next(_table[pos]);
+      _table[pos] = delayed_add;
+      delayed_add = next;
+    }
+
+    _needs_rehashing = false;
+    log_debug(jvmti, objecttagging)("(%d entries, %d moved by rehash)", _entry_count, moved);
+  }
+
+
 
   // internal remove function - remove an entry at a given position in the
   // table.
@@ -268,6 +328,9 @@ class JvmtiTagHashmap : public CHeapObj<mtInternal> {
   bool is_resizing_enabled() const          { return _resizing_enabled; }
   void set_resizing_enabled(bool enable)    { _resizing_enabled = enable; }
 
+  // set by the GC when entries are no longer at their hash positions
+  void set_needs_rehashing()                { _needs_rehashing = true; }
+
   // debugging
   void print_memory_usage();
   void compute_next_trace_threshold();
@@ -313,8 +376,16 @@ class JvmtiTagHashmap : public CHeapObj<mtInternal> {
   JvmtiTagHashmapEntry** table() const          { return _table; }
   int entry_count() const                       { return _entry_count; }
 
+  // rehash before the first use of the hash positions after a GC
+  inline void check_rehash() {
+    if (_needs_rehashing) {
+      rehash();
+    }
+  }
+
   // find an entry in the hashmap, returns NULL if not found.
   inline JvmtiTagHashmapEntry* find(oop key) {
+    check_rehash();
     unsigned int h = hash(key);
     JvmtiTagHashmapEntry* entry = _table[h];
     while (entry != NULL) {
@@ -330,6 +401,7 @@ class JvmtiTagHashmap : public CHeapObj<mtInternal> {
   // add a new entry to hashmap
   inline void add(oop key, JvmtiTagHashmapEntry* entry) {
     assert(key != NULL, "checking");
+    check_rehash();
     assert(find(key) == NULL, "duplicate detected");
     unsigned int h = hash(key);
     JvmtiTagHashmapEntry* anchor = _table[h];
@@ -355,6 +427,7 @@ class JvmtiTagHashmap : public CHeapObj<mtInternal> {
 
   // remove an entry with the given key.
   inline JvmtiTagHashmapEntry* remove(oop key) {
+    check_rehash();
     unsigned int h = hash(key);
     JvmtiTagHashmapEntry* entry = _table[h];
     JvmtiTagHashmapEntry* prev = NULL;
@@ -553,10 +626,33 @@ static inline jlong tag_for(JvmtiTagMap* tag_map, oop o) {
 }
 
 
+// A tag change made by a heap callback that runs on a parallel worker
+// thread. The workers only read the hashmap; the changes are applied by
+// the VM thread once all workers are done.
+class DeferredTagUpdate {
+ private:
+  oop _o;
+  JvmtiTagHashmapEntry* _entry;
+  jlong _tag;
+
+ public:
+  DeferredTagUpdate() : _o(NULL), _entry(NULL), _tag(0) {}
+  DeferredTagUpdate(oop o, JvmtiTagHashmapEntry* entry, jlong tag) :
+    _o(o), _entry(entry), _tag(tag) {}
+
+  oop o() const                         { return _o; }
+  JvmtiTagHashmapEntry* entry() const   { return _entry; }
+  jlong tag() const                     { return _tag; }
+};
+
+typedef GrowableArray<DeferredTagUpdate> DeferredTagUpdates;
+
 // A CallbackWrapper is a support class for querying and tagging an object
 // around a callback to a profiler. The constructor does pre-callback
 // work to get the tag value, klass tag value, ... and the destructor
 // does the post-callback work of tagging or untagging the object.
+// When a list of deferred updates is given the destructor records the
+// change in that list instead.
 //
 // {
 //   CallbackWrapper wrapper(tag_map, o);
@@ -576,6 +672,7 @@ class CallbackWrapper : public StackObj {
   jlong _obj_size;
   jlong _obj_tag;
   jlong _klass_tag;
+  DeferredTagUpdates* _deferred_updates;
 
  protected:
   JvmtiTagMap* tag_map() const      { return _tag_map; }
@@ -584,8 +681,9 @@ class CallbackWrapper : public StackObj {
   void inline post_callback_tag_update(oop o, JvmtiTagHashmap* hashmap,
                                        JvmtiTagHashmapEntry* entry, jlong obj_tag);
  public:
-  CallbackWrapper(JvmtiTagMap* tag_map, oop o) {
-    assert(Thread::current()->is_VM_thread() || tag_map->is_locked(),
+  CallbackWrapper(JvmtiTagMap* tag_map, oop o, DeferredTagUpdates* deferred_updates = NULL) {
+    assert(Thread::current()->is_VM_thread() || tag_map->is_locked() ||
+           (deferred_updates != NULL && SafepointSynchronize::is_at_safepoint()),
            "MT unsafe or must be VM thread");
 
     // object to tag
@@ -606,12 +704,21 @@ class CallbackWrapper : public StackObj {
     assert(SystemDictionary::Class_klass()->is_mirror_instance_klass(), "Is not?");
 
     _klass_tag = tag_for(tag_map, _o->klass()->java_mirror());
+
+    _deferred_updates = deferred_updates;
   }
 
   ~CallbackWrapper() {
-    post_callback_tag_update(_o, _hashmap, _entry, _obj_tag);
+    if (_deferred_updates == NULL) {
+      post_callback_tag_update(_o, _hashmap, _entry, _obj_tag);
+    } else if (_entry == NULL ? _obj_tag != 0 : _obj_tag != _entry->tag()) {
+      _deferred_updates->append(DeferredTagUpdate(_o, _entry, _obj_tag));
+    }
   }
 
+  // apply a tag change recorded by a parallel worker
+  static void apply(JvmtiTagMap* tag_map, const DeferredTagUpdate& update);
+
   inline jlong* obj_tag_p()                     { return &_obj_tag; }
   inline jlong obj_size() const                 { return _obj_size; }
   inline jlong obj_tag() const                  { return _obj_tag; }
@@ -620,16 +727,17 @@ class CallbackWrapper : public StackObj {
 
 
 
-// callback post-callback to tag, untag, or update the tag of an object
-void inline CallbackWrapper::post_callback_tag_update(oop o,
-                                                      JvmtiTagHashmap* hashmap,
-                                                      JvmtiTagHashmapEntry* entry,
-                                                      jlong obj_tag) {
+// tag, untag, or update the tag of an object after a callback
+static inline void update_tag(JvmtiTagMap* tag_map,
+                              oop o,
+                              JvmtiTagHashmap* hashmap,
+                              JvmtiTagHashmapEntry* entry,
+                              jlong obj_tag) {
   if (entry == NULL) {
     if (obj_tag != 0) {
       // callback has tagged the object
       assert(Thread::current()->is_VM_thread(), "must be VMThread");
-      entry = tag_map()->create_entry(o, obj_tag);
+      entry = tag_map->create_entry(o, obj_tag);
       hashmap->add(o, entry);
     }
   } else {
@@ -639,7 +747,7 @@ void inline CallbackWrapper::post_callback_tag_update(oop o,
 
       JvmtiTagHashmapEntry* entry_removed = hashmap->remove(o);
       assert(entry_removed == entry, "checking");
-      tag_map()->destroy_entry(entry);
+      tag_map->destroy_entry(entry);
 
     } else {
       if (obj_tag != entry->tag()) {
@@ -649,6 +757,19 @@ void inline CallbackWrapper::post_callback_tag_update(oop o,
   }
 }
 
+// callback post-callback to tag, untag, or update the tag of an object
+void inline CallbackWrapper::post_callback_tag_update(oop o,
+                                                      JvmtiTagHashmap* hashmap,
+                                                      JvmtiTagHashmapEntry* entry,
+                                                      jlong obj_tag) {
+  update_tag(tag_map(), o, hashmap, entry, obj_tag);
+}
+
+void CallbackWrapper::apply(JvmtiTagMap* tag_map, const DeferredTagUpdate& update) {
+  assert(Thread::current()->is_VM_thread(), "must be VMThread");
+  update_tag(tag_map, update.o(), tag_map->hashmap(), update.entry(), update.tag());
+}
+
 // An extended CallbackWrapper used when reporting an object reference
 // to the agent.
 //
@@ -1362,6 +1483,7 @@ class IterateThroughHeapObjectClosure: public ObjectClosure {
   int _heap_filter;
   const jvmtiHeapCallbacks* _callbacks;
   const void* _user_data;
+  DeferredTagUpdates* _deferred_updates;
 
   // accessor functions
   JvmtiTagMap* tag_map() const                     { return _tag_map; }
@@ -1369,10 +1491,15 @@ class IterateThroughHeapObjectClosure: public ObjectClosure {
   const jvmtiHeapCallbacks* callbacks() const      { return _callbacks; }
   Klass* klass() const                             { return _klass; }
   const void* user_data() const                    { return _user_data; }
+  DeferredTagUpdates* deferred_updates() const     { return _deferred_updates; }
 
-  // indicates if the iteration has been aborted
+  // indicates if the iteration has been aborted, by this closure or,
+  // when iterating in parallel, by the closure of another worker
   bool _iteration_aborted;
-  bool is_iteration_aborted() const                { return _iteration_aborted; }
+  volatile bool* _shared_iteration_aborted;
+  bool is_iteration_aborted() const {
+    return _iteration_aborted || (_shared_iteration_aborted != NULL && *_shared_iteration_aborted);
+  }
 
   // used to check the visit control flags. If the abort flag is set
   // then we set the iteration aborted flag so that the iteration completes
@@ -1381,6 +1508,9 @@ class IterateThroughHeapObjectClosure: public ObjectClosure {
     bool is_abort = (flags & JVMTI_VISIT_ABORT) != 0;
     if (is_abort) {
       _iteration_aborted = true;
+      if (_shared_iteration_aborted != NULL) {
+        *_shared_iteration_aborted = true;
+      }
     }
     return is_abort;
   }
@@ -1390,13 +1520,17 @@ class IterateThroughHeapObjectClosure: public ObjectClosure {
                                   Klass* klass,
                                   int heap_filter,
                                   const jvmtiHeapCallbacks* heap_callbacks,
-                                  const void* user_data) :
+                                  const void* user_data,
+                                  DeferredTagUpdates* deferred_updates = NULL,
+                                  volatile bool* shared_iteration_aborted = NULL) :
     _tag_map(tag_map),
     _klass(klass),
     _heap_filter(heap_filter),
     _callbacks(heap_callbacks),
     _user_data(user_data),
-    _iteration_aborted(false)
+    _deferred_updates(deferred_updates),
+    _iteration_aborted(false),
+    _shared_iteration_aborted(shared_iteration_aborted)
   {
   }
 
@@ -1412,7 +1546,7 @@ void IterateThroughHeapObjectClosure::do_object(oop obj) {
   if (is_filtered_by_klass_filter(obj, klass())) return;
 
   // prepare for callback
-  CallbackWrapper wrapper(tag_map(), obj);
+  CallbackWrapper wrapper(tag_map(), obj, deferred_updates());
 
   // check if filtered by the heap filter
   if (is_filtered_by_heap_filter(wrapper.obj_tag(), wrapper.klass_tag(), heap_filter())) {
@@ -1511,6 +1645,169 @@ void JvmtiTagMap::iterate_through_heap(jint heap_filter,
   VMThread::execute(&op);
 }
 
+// Runs IterateThroughHeapObjectClosure on the workers of a parallel
+// object iteration. Each worker passes its own user data to the callbacks
+// and records its tag changes in its own list.
+class ParIterateThroughHeapTask : public AbstractGangTask {
+ private:
+  ParallelObjectIterator* _poi;
+  JvmtiTagMap* _tag_map;
+  Klass* _klass;
+  int _heap_filter;
+  const jvmtiHeapCallbacks* _callbacks;
+  void* const* _user_data;
+  DeferredTagUpdates** _deferred_updates;
+  volatile bool _iteration_aborted;
+
+ public:
+  ParIterateThroughHeapTask(ParallelObjectIterator* poi,
+                            JvmtiTagMap* tag_map,
+                            Klass* klass,
+                            int heap_filter,
+                            const jvmtiHeapCallbacks* callbacks,
+                            void* const* user_data,
+                            DeferredTagUpdates** deferred_updates) :
+    AbstractGangTask("JVMTI heap iteration"),
+    _poi(poi),
+    _tag_map(tag_map),
+    _klass(klass),
+    _heap_filter(heap_filter),
+    _callbacks(callbacks),
+    _user_data(user_data),
+    _deferred_updates(deferred_updates),
+    _iteration_aborted(false) { }
+
+  virtual void work(uint worker_id) {
+    IterateThroughHeapObjectClosure blk(_tag_map,
+                                        _klass,
+                                        _heap_filter,
+                                        _callbacks,
+                                        _user_data[worker_id],
+                                        _deferred_updates[worker_id],
+                                        &_iteration_aborted);
+    _poi->object_iterate(&blk, worker_id);
+  }
+};
+
+// Iterates over the heap with the collector's parallel object iterator,
+// falls back to a serial iteration with the first user data when the
+// collector has no parallel iterator or no safepoint workers.
+class VM_ParallelHeapIterateOperation: public VM_Operation {
+ private:
+  JvmtiTagMap* _tag_map;
+  Klass* _klass;
+  int _heap_filter;
+  const jvmtiHeapCallbacks* _callbacks;
+  void* const* _user_data;
+  uint _requested_workers;
+  uint _used_workers;
+
+  uint iterate_in_parallel();
+  void iterate_serially();
+
+ public:
+  VM_ParallelHeapIterateOperation(JvmtiTagMap* tag_map,
+                                  Klass* klass,
+                                  int heap_filter,
+                                  const jvmtiHeapCallbacks* callbacks,
+                                  void* const* user_data,
+                                  uint requested_workers) :
+    _tag_map(tag_map),
+    _klass(klass),
+    _heap_filter(heap_filter),
+    _callbacks(callbacks),
+    _user_data(user_data),
+    _requested_workers(requested_workers),
+    _used_workers(0) { }
+
+  VMOp_Type type() const { return VMOp_HeapIterateOperation; }
+  uint used_workers() const { return _used_workers; }
+
+  void doit() {
+    // make sure that heap is parsable (fills TLABs with filler objects)
+    Universe::heap()->ensure_parsability(false);  // no need to retire TLABs
+
+    // Verify heap before iteration - if the heap gets corrupted then
+    // the iteration will crash.
+    if (VerifyBeforeIteration) {
+      Universe::verify();
+    }
+
+    _used_workers = iterate_in_parallel();
+    if (_used_workers == 0) {
+      iterate_serially();
+      _used_workers = 1;
+    }
+  }
+};
+
+uint VM_ParallelHeapIterateOperation::iterate_in_parallel() {
+  // The class field maps used for primitive field callbacks are cached
+  // in a list that is not safe for concurrent use.
+  if (_requested_workers < 2 || _callbacks->primitive_field_callback != NULL) {
+    return 0;
+  }
+  CollectedHeap* heap = Universe::heap();
+  WorkGang* workers = heap->get_safepoint_workers();
+  if (workers == NULL) {
+    return 0;
+  }
+  uint num_workers = MIN2(_requested_workers, workers->total_workers());
+  ParallelObjectIterator* poi = heap->parallel_object_iterator(num_workers);
+  if (poi == NULL) {
+    return 0;
+  }
+
+  // The workers look up tags concurrently, the hashmap must not be
+  // rehashed or otherwise modified while they run.
+  JvmtiTagHashmap* hashmap = _tag_map->hashmap();
+  hashmap->check_rehash();
+
+  DeferredTagUpdates** deferred_updates = NEW_C_HEAP_ARRAY(DeferredTagUpdates*, num_workers, mtInternal);
+  for (uint i = 0; i < num_workers; i++) {
+    deferred_updates[i] = new (ResourceObj::C_HEAP, mtInternal) DeferredTagUpdates(16, true);
+  }
+
+  ParIterateThroughHeapTask task(poi, _tag_map, _klass, _heap_filter, _callbacks, _user_data, deferred_updates);
+  workers->run_task(&task, num_workers);
+  delete poi;
+
+  for (uint i = 0; i < num_workers; i++) {
+    DeferredTagUpdates* updates = deferred_updates[i];
+    for (int j = 0; j < updates->length(); j++) {
+      CallbackWrapper::apply(_tag_map, updates->at(j));
+    }
+    delete updates;
+  }
+  FREE_C_HEAP_ARRAY(DeferredTagUpdates*, deferred_updates);
+  return num_workers;
+}
+
+void VM_ParallelHeapIterateOperation::iterate_serially() {
+  // allows class files maps to be cached during iteration
+  ClassFieldMapCacheMark cm;
+  IterateThroughHeapObjectClosure blk(_tag_map,
+                                      _klass,
+                                      _heap_filter,
+                                      _callbacks,
+                                      _user_data[0]);
+  Universe::heap()->object_iterate(&blk);
+}
+
+// Iterates over all objects in the heap using up to worker_count
+// worker threads, returns the number of workers used
+jint JvmtiTagMap::parallel_iterate_through_heap(jint heap_filter,
+                                               Klass* klass,
+                                               const jvmtiHeapCallbacks* callbacks,
+                                               jint worker_count,
+                                               void* const* user_data)
+{
+  MutexLocker ml(Heap_lock);
+  VM_ParallelHeapIterateOperation op(this, klass, heap_filter, callbacks, user_data, (uint)worker_count);
+  VMThread::execute(&op);
+  return (jint)op.used_workers();
+}
+
 // support class for get_objects_with_tags
 
 class TagObjectCollector : public JvmtiTagHashmapEntryClosure {
@@ -3351,8 +3648,6 @@ void JvmtiTagMap::do_weak_oops(BoolObjectClosure* is_alive, OopClosure* f) {
   JvmtiTagHashmapEntry** table = hashmap->table();
   int size = hashmap->size();
 
-  JvmtiTagHashmapEntry* delayed_add = NULL;
-
   for (int pos = 0; pos < size; ++pos) {
     JvmtiTagHashmapEntry* entry = table[pos];
     JvmtiTagHashmapEntry* prev = NULL;
@@ -3378,45 +3673,23 @@ void JvmtiTagMap::do_weak_oops(BoolObjectClosure* is_alive, OopClosure* f) {
 
         ++freed;
       } else {
+        oop old_oop = entry->object_peek();
         f->do_oop(entry->object_addr());
-        oop new_oop = entry->object_peek();
 
-        // if the object has moved then re-hash it and move its
-        // entry to its new location.
-        unsigned int new_pos = JvmtiTagHashmap::hash(new_oop, size);
-        if (new_pos != (unsigned int)pos) {
-          if (prev == NULL) {
-            table[pos] = next;
-          } else {
-            prev->set_next(next);
-          }
-          if (new_pos < (unsigned int)pos) {
-            entry->set_next(table[new_pos]);
-            table[new_pos] = entry;
-          } else {
-            // Delay adding this entry to it's new position as we'd end up
-            // hitting it again during this iteration.
-            entry->set_next(delayed_add);
-            delayed_add = entry;
-          }
+        // if the object has moved its entry is now at a stale position,
+        // it is re-hashed lazily by the next lookup
+        if (entry->object_peek() != old_oop) {
           moved++;
-        } else {
-          // object didn't move
-          prev = entry;
         }
+        prev = entry;
       }
 
       entry = next;
     }
   }
 
-  // Re-add all the entries which were kept aside
-  while (delayed_add != NULL) {
-    JvmtiTagHashmapEntry* next = delayed_add->next();
-    unsigned int pos = JvmtiTagHashmap::hash(delayed_add->object_peek(), size);
-    delayed_add->set_next(table[pos]);
-    table[pos] = delayed_add;
-    delayed_add = next;
+  if (moved > 0) {
+    hashmap->set_needs_rehashing();
   }
 
   log_debug(jvmti, objecttagging)("(%d->%d, %d freed, %d total moves)",
@@ -109,6 +109,14 @@ class JvmtiTagMap :  public CHeapObj<mtInternal> {
                             const jvmtiHeapCallbacks* callbacks,
                             const void* user_data);
 
+  // IterateThroughHeap with the collector's parallel object iterator,
+  // used by the ParallelIterateThroughHeap extension function
+  jint parallel_iterate_through_heap(jint heap_filter,
+                                     Klass* klass,
+                                     const jvmtiHeapCallbacks* callbacks,
+                                     jint worker_count,
+                                     void* const* user_data);
+
   void follow_references(jint heap_filter,
                          Klass* klass,
                          jobject initial_object,
@@ -38,6 +38,7 @@
 #include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/safepointVerifiers.hpp"
+#include "runtime/serviceThread.hpp"
 #include "runtime/timerTrace.hpp"
 #include "utilities/concurrentHashTable.inline.hpp"
 #include "utilities/concurrentHashTableTasks.inline.hpp"
@@ -262,20 +263,36 @@ void ResolvedMethodTable::do_concurrent_work(JavaThread* jt) {
   }
 }
 
+struct ResolvedMethodTableGrowWorker : StackObj {
+  bool do_task(Thread* thread, ResolvedMethodTableHash::GrowTask* gt) {
+    return gt->do_task(thread);
+  }
+  void done() {}
+};
+
 void ResolvedMethodTable::grow(JavaThread* jt) {
-  ResolvedMethodTableHash::GrowTask gt(_local_table);
+  WorkGang* workers = ServiceThread::table_workers(_current_size);
+  ResolvedMethodTableHash::GrowTask gt(_local_table, workers != NULL);
   if (!gt.prepare(jt)) {
     return;
   }
   log_trace(membername, table)("Started to grow");
   {
     TraceTime timer("Grow", TRACETIME_LOG(Debug, membername, table, perf));
-    while (gt.do_task(jt)) {
-      gt.pause(jt);
-      {
-        ThreadBlockInVM tbivm(jt);
+    if (workers != NULL) {
+      ResolvedMethodTableGrowWorker prototype;
+      ConcurrentHashTableGangTask<ResolvedMethodTableHash::GrowTask,
+                                  ResolvedMethodTableGrowWorker>
+        task("ResolvedMethodTable Grow", &gt, prototype);
+      task.run(jt, workers);
+    } else {
+      while (gt.do_task(jt)) {
+        gt.pause(jt);
+        {
+          ThreadBlockInVM tbivm(jt);
+        }
+        gt.cont(jt);
       }
-      gt.cont(jt);
     }
   }
   gt.done(jt);
@@ -305,25 +322,50 @@ struct ResolvedMethodTableDeleteCheck : StackObj {
   }
 };
 
+struct ResolvedMethodTableDeleteWorker : StackObj {
+  ResolvedMethodTableDeleteCheck _stdc;
+  ResolvedMethodTableDoDelete _stdd;
+  long* _count;
+  long* _item;
+  ResolvedMethodTableDeleteWorker(long* count, long* item) : _count(count), _item(item) {}
+  bool do_task(Thread* thread, ResolvedMethodTableHash::BulkDeleteTask* bdt) {
+    return bdt->do_task(thread, _stdc, _stdd);
+  }
+  void done() {
+    Atomic::add(_stdc._count, _count);
+    Atomic::add(_stdc._item, _item);
+  }
+};
+
 void ResolvedMethodTable::clean_dead_entries(JavaThread* jt) {
-  ResolvedMethodTableHash::BulkDeleteTask bdt(_local_table);
+  WorkGang* workers = ServiceThread::table_workers(_current_size);
+  ResolvedMethodTableHash::BulkDeleteTask bdt(_local_table, workers != NULL);
   if (!bdt.prepare(jt)) {
     return;
   }
-  ResolvedMethodTableDeleteCheck stdc;
-  ResolvedMethodTableDoDelete stdd;
+  long count = 0;
+  long item = 0;
+  ResolvedMethodTableDeleteWorker stdw(&count, &item);
   {
     TraceTime timer("Clean", TRACETIME_LOG(Debug, membername, table, perf));
-    while(bdt.do_task(jt, stdc, stdd)) {
-      bdt.pause(jt);
-      {
-        ThreadBlockInVM tbivm(jt);
+    if (workers != NULL) {
+      ConcurrentHashTableGangTask<ResolvedMethodTableHash::BulkDeleteTask,
+                                  ResolvedMethodTableDeleteWorker>
+        task("ResolvedMethodTable Clean", &bdt, stdw);
+      task.run(jt, workers);
+    } else {
+      while(stdw.do_task(jt, &bdt)) {
+        bdt.pause(jt);
+        {
+          ThreadBlockInVM tbivm(jt);
+        }
+        bdt.cont(jt);
       }
-      bdt.cont(jt);
+      stdw.done();
     }
     bdt.done(jt);
   }
-  log_info(membername, table)("Cleaned %ld of %ld", stdc._count, stdc._item);
+  log_info(membername, table)("Cleaned %ld of %ld", count, item);
 }
 void ResolvedMethodTable::reset_dead_counter() {
   _uncleaned_items_count = 0;
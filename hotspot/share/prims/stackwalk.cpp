@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "classfile/javaClasses.hpp"
 #include "classfile/javaClasses.inline.hpp"
+#include "classfile/systemDictionary.hpp"
 #include "classfile/vmSymbols.hpp"
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
@@ -64,6 +65,9 @@ bool BaseFrameStream::cleanup_magic_on_exit(objArrayHandle frames_array) {
 JavaFrameStream::JavaFrameStream(JavaThread* thread, int mode)
   : BaseFrameStream(thread), _vfst(thread) {
   _need_method_info = StackWalk::need_method_info(mode);
+  for (int i = 0; i < filled_cache_size; i++) {
+    _filled_indices[i] = -1;
+  }
 }
 
 void JavaFrameStream::next() { _vfst.next();}
@@ -176,12 +180,38 @@ void JavaFrameStream::fill_frame(int index, objArrayHandle  frames_array,
   if (_need_method_info) {
     HandleMark hm(THREAD);
     Handle stackFrame(THREAD, frames_array->obj_at(index));
-    fill_stackframe(stackFrame, method, CHECK);
+    int filled_index;
+    if (find_filled_frame(frames_array, method(), &filled_index)) {
+      Handle filled_frame(THREAD, frames_array->obj_at(filled_index));
+      java_lang_StackFrameInfo::set_method_and_bci_from(stackFrame, filled_frame, bci());
+    } else {
+      fill_stackframe(stackFrame, method, CHECK);
+    }
+    _filled_indices[filled_cache_slot(method())] = index;
   } else {
     frames_array->obj_at_put(index, method->method_holder()->java_mirror());
   }
 }
 
+// The remembered frame is only used if it still describes method, since
+// later batches may be filled into another frames array.
+bool JavaFrameStream::find_filled_frame(objArrayHandle frames_array, Method* method, int* index) {
+  int filled_index = _filled_indices[filled_cache_slot(method)];
+  if (filled_index < 0 || filled_index >= frames_array->length()) {
+    return false;
+  }
+  oop filled_frame = frames_array->obj_at(filled_index);
+  if (filled_frame == NULL || !filled_frame->is_a(SystemDictionary::StackFrameInfo_klass())) {
+    return false;
+  }
+  oop mname = filled_frame->obj_field(java_lang_StackFrameInfo::memberName_offset_in_bytes());
+  if (mname == NULL || java_lang_invoke_MemberName::vmtarget(mname) != method) {
+    return false;
+  }
+  *index = filled_index;
+  return true;
+}
+
 // Create and return a LiveStackFrame.PrimitiveSlot (if needed) for the
 // StackValue at the given index. 'type' is expected to be T_INT, T_LONG,
 // T_OBJECT, or T_CONFLICT.
@@ -75,8 +75,22 @@ public:
 
 class JavaFrameStream : public BaseFrameStream {
 private:
+  enum {
+    filled_cache_size = 8
+  };
+
   vframeStream          _vfst;
   bool                  _need_method_info;
+
+  // Recursive and looping code repeats the same methods within a batch.
+  // Remembers where a method was last filled in so that its frames can
+  // share the resolved MemberName rather than looking it up again.
+  int                   _filled_indices[filled_cache_size];
+
+  static int filled_cache_slot(Method* method) {
+    return (int)(((uintptr_t)method >> LogBytesPerWord) & (filled_cache_size - 1));
+  }
+  bool find_filled_frame(objArrayHandle frames_array, Method* method, int* index);
 public:
   JavaFrameStream(JavaThread* thread, int mode);
 
@@ -563,6 +563,9 @@ static SpecialFlag const special_jvm_flags[] = {
   { "ProfilerNumberOfRuntimeStubNodes", JDK_Version::undefined(), JDK_Version::jdk(13), JDK_Version::jdk(14) },
   { "UseImplicitStableValues",       JDK_Version::undefined(), JDK_Version::jdk(13), JDK_Version::jdk(14) },
   { "NeedsDeoptSuspend",             JDK_Version::undefined(), JDK_Version::jdk(13), JDK_Version::jdk(14) },
+  { "BindGCTaskThreadsToCPUs",       JDK_Version::undefined(), JDK_Version::jdk(13), JDK_Version::jdk(14) },
+  { "UseGCTaskAffinity",             JDK_Version::undefined(), JDK_Version::jdk(13), JDK_Version::jdk(14) },
+  { "GCTaskTimeStampEntries",        JDK_Version::undefined(), JDK_Version::jdk(13), JDK_Version::jdk(14) },
 
 #ifdef TEST_VERIFY_SPECIAL_JVM_FLAGS
   // These entries will generate build errors.  Their purpose is to test the macros.
@@ -1978,13 +1981,6 @@ jint Arguments::set_aggressive_heap_flags() {
     return JNI_EINVAL;
   }
 
-  // Get around early Solaris scheduling bug
-  // (affinity vs other jobs on system)
-  // but disallow DR and offlining (5008695).
-  if (FLAG_SET_CMDLINE(BindGCTaskThreadsToCPUs, true) != JVMFlag::SUCCESS) {
-    return JNI_EINVAL;
-  }
-
   return JNI_OK;
 }
 
@@ -4127,6 +4123,12 @@ jint Arguments::apply_ergo() {
     log_info(ergo)("ThreadLocalHandshakes %s", ThreadLocalHandshakes ? "enabled." : "disabled.");
   }
 
+  // Without thread-local handshakes every handshake is a safepoint, which
+  // defeats the purpose of deflating idle monitors outside of safepoints.
+  if (AsyncDeflateIdleMonitors && !ThreadLocalHandshakes) {
+    FLAG_SET_ERGO(AsyncDeflateIdleMonitors, false);
+  }
+
   return JNI_OK;
 }
 
@@ -4143,8 +4145,9 @@ jint Arguments::adjust_after_os() {
     // platforms when UseNUMA is set to ON. NUMA-aware collectors
     // such as the parallel collector for Linux and Solaris will
     // interleave old gen and survivor spaces on top of NUMA
-    // allocation policy for the eden space.
-    // Non NUMA-aware collectors such as CMS, G1 and Serial-GC on
+    // allocation policy for the eden space. G1 binds each heap
+    // region to a single node on top of the interleaving instead.
+    // Non NUMA-aware collectors such as CMS and Serial-GC on
     // all platforms and ParallelGC on Windows will interleave all
     // of the heap spaces across NUMA nodes.
     if (FLAG_IS_DEFAULT(UseNUMAInterleaving)) {
@@ -35,6 +35,7 @@
 #include "runtime/basicLock.hpp"
 #include "runtime/biasedLocking.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/task.hpp"
 #include "runtime/threadSMR.hpp"
 #include "runtime/vframe.hpp"
@@ -598,6 +599,66 @@ public:
   }
 };
 
+// Revokes the bias of a single object in a handshake with the thread it is
+// biased toward, instead of bringing all threads to a safepoint. Only that
+// thread can lock the object, or otherwise change its mark, while the bias
+// is valid; so stopping it is enough to walk its stack and fix up its locks.
+class RevokeOneBias : public ThreadClosure {
+private:
+  Handle _obj;
+  JavaThread* _requesting_thread;
+  JavaThread* _biased_locker;
+  BiasedLocking::Condition _status_code;
+  traceid _biased_locker_id;
+  bool _revoked;
+
+public:
+  RevokeOneBias(Handle obj, JavaThread* requesting_thread, JavaThread* biased_locker)
+    : _obj(obj)
+    , _requesting_thread(requesting_thread)
+    , _biased_locker(biased_locker)
+    , _status_code(BiasedLocking::NOT_BIASED)
+    , _biased_locker_id(0)
+    , _revoked(false) {}
+
+  void do_thread(Thread* target) {
+    assert(target == _biased_locker, "wrong thread");
+    oop o = _obj();
+    markOop mark = o->mark();
+    if (!mark->has_bias_pattern()) {
+      _revoked = true;
+      return;
+    }
+    markOop prototype = o->klass()->prototype_header();
+    if (mark->biased_locker() != _biased_locker || !prototype->has_bias_pattern() ||
+        mark->bias_epoch() != prototype->bias_epoch()) {
+      // The bias changed since the handshake was requested, and other
+      // threads may race for the mark. Leave it to the safepoint.
+      return;
+    }
+    ResourceMark rm;
+    HandleMark hm;
+    log_info(biasedlocking)("Revoking bias with a handshake with the biased locker:");
+    _status_code = revoke_bias(o, false, false, _requesting_thread, NULL);
+    _biased_locker->set_cached_monitor_info(NULL);
+    _biased_locker_id = JFR_THREAD_ID(_biased_locker);
+    _revoked = true;
+  }
+
+  // False if the object has to be revoked at a safepoint after all.
+  bool revoked() const {
+    return _revoked;
+  }
+
+  BiasedLocking::Condition status_code() const {
+    return _status_code;
+  }
+
+  traceid biased_locker() const {
+    return _biased_locker_id;
+  }
+};
+
 static void post_self_revocation_event(EventBiasedLockSelfRevocation* event, Klass* k) {
   assert(event != NULL, "invariant");
   assert(k != NULL, "invariant");
@@ -617,6 +678,17 @@ static void post_revocation_event(EventBiasedLockRevocation* event, Klass* k, VM
   event->commit();
 }
 
+static void post_revocation_event(EventBiasedLockRevocation* event, Klass* k, RevokeOneBias* op) {
+  assert(event != NULL, "invariant");
+  assert(k != NULL, "invariant");
+  assert(op != NULL, "invariant");
+  assert(event->should_commit(), "invariant");
+  event->set_lockClass(k);
+  event->set_safepointId(0); // revoked without a safepoint
+  event->set_previousOwner(op->biased_locker());
+  event->commit();
+}
+
 static void post_class_revocation_event(EventBiasedLockClassRevocation* event, Klass* k, VM_BulkRevokeBias* op) {
   assert(event != NULL, "invariant");
   assert(k != NULL, "invariant");
@@ -719,6 +791,19 @@ BiasedLocking::Condition BiasedLocking::revoke_and_rebias(Handle obj, bool attem
       return cond;
     } else {
       EventBiasedLockRevocation event;
+      JavaThread* biased_locker = mark->biased_locker();
+      if (biased_locker != NULL &&
+          prototype_header->bias_epoch() == mark->bias_epoch()) {
+        RevokeOneBias revoke(obj, (JavaThread*) THREAD, biased_locker);
+        if (Handshake::execute(&revoke, biased_locker) && revoke.revoked()) {
+          if (event.should_commit() && revoke.status_code() != NOT_BIASED) {
+            post_revocation_event(&event, k, &revoke);
+          }
+          return revoke.status_code();
+        }
+        // The biased locker exited, or the bias changed, before the
+        // handshake; revoke_bias() copes with both at a safepoint.
+      }
       VM_RevokeBias revoke(&obj, (JavaThread*) THREAD);
       VMThread::execute(&revoke);
       if (event.should_commit() && revoke.status_code() != NOT_BIASED) {
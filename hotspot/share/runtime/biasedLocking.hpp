@@ -88,6 +88,12 @@
 // formerly-biased thread and all other threads revert back to
 // HotSpot's CAS-based locking.
 //
+// Only the thread toward which an object is biased can change its
+// header while the bias is valid. Revoking the bias of a single object
+// therefore only stops that thread with a handshake; a safepoint is
+// still used when the bias changes hands while the handshake is being
+// set up, and for the bulk operations below, which walk all stacks.
+//
 // This scheme can not handle transfers of biases of single objects
 // from thread to thread efficiently, but it can handle bulk transfers
 // of such biases, which is a usage pattern showing up in some
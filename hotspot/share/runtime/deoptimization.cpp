@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "jvm.h"
+#include "classfile/classLoaderDataGraph.hpp"
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "code/codeCache.hpp"
@@ -34,6 +35,8 @@
 #include "interpreter/bytecode.hpp"
 #include "interpreter/interpreter.hpp"
 #include "interpreter/oopMapCache.hpp"
+#include "jfr/jfrEvents.hpp"
+#include "logging/log.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/oopFactory.hpp"
 #include "memory/resourceArea.hpp"
@@ -56,6 +59,7 @@
 #include "runtime/jniHandles.inline.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/safepointVerifiers.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/signature.hpp"
@@ -1865,6 +1869,7 @@ JRT_ENTRY(void, Deoptimization::uncommon_trap_inner(JavaThread* thread, jint tra
 
     bool update_trap_state = (reason != Reason_tenured) && !injected_profile_trap;
     bool make_not_entrant = false;
+    bool storm = false;
     bool make_not_compilable = false;
     bool reprofile = false;
     switch (action) {
@@ -2026,6 +2031,27 @@ JRT_ENTRY(void, Deoptimization::uncommon_trap_inner(JavaThread* thread, jint tra
       if (reason == Reason_tenured && trap_mdo != NULL) {
         trap_mdo->inc_tenure_traps();
       }
+
+      // make_not_entrant() counted the decompile in the root method's MDO.
+      // A method that keeps getting deoptimized speculates on something that
+      // does not hold: stop speculating on this reason in the trapping method
+      // altogether, rather than recompiling until PerMethodRecompilationCutoff
+      // gives up on it. The policy backs off its recompilation as well.
+      MethodData* root_mdo = nm->method()->method_data();
+      if (DeoptStormThreshold > 0 && root_mdo != NULL &&
+          root_mdo->decompile_count() >= (uint)DeoptStormThreshold) {
+        storm = true;
+        if (trap_mdo != NULL && (uint)reason < MethodData::trap_reason_limit() &&
+            trap_mdo->trap_count(reason) != (uint)-1) {
+          trap_mdo->saturate_trap_count(reason);
+          ResourceMark rm;
+          log_info(deoptimization)("Deoptimization storm in %s (%u decompiles): no longer speculating on %s in %s",
+                                   nm->method()->name_and_sig_as_C_string(), root_mdo->decompile_count(),
+                                   trap_reason_name(reason), trap_method->name_and_sig_as_C_string());
+          Events::log_deopt_message(thread, "Deoptimization storm: disabled %s in %s",
+                                    trap_reason_name(reason), trap_method->name_and_sig_as_C_string());
+        }
+      }
     }
 
     if (inc_recompile_count) {
@@ -2053,11 +2079,71 @@ JRT_ENTRY(void, Deoptimization::uncommon_trap_inner(JavaThread* thread, jint tra
       nm->method()->set_not_compilable("give up compiling", CompLevel_full_optimization);
     }
 
+    EventDeoptimization event;
+    if (event.should_commit()) {
+      MethodData* root_mdo = nm->method()->method_data();
+      event.set_compileId(nm->compile_id());
+      event.set_method(trap_method());
+      event.set_lineNumber(trap_method->line_number_from_bci(trap_bci));
+      event.set_bci(trap_bci);
+      event.set_instruction(Bytecodes::name(trap_bc));
+      event.set_reason(trap_reason_name(reason));
+      event.set_action(trap_action_name(action));
+      event.set_decompileCount(root_mdo != NULL ? root_mdo->decompile_count() : 0);
+      event.set_storm(storm);
+      event.commit();
+    }
+
   } // Free marked resources
 
 }
 JRT_END
 
+// ClassLoaderDataGraph::methods_do() only takes a function. Protected by
+// the ClassLoaderDataGraph_lock.
+static outputStream* _deopt_print_stream = NULL;
+static bool _deopt_print_only_storms = false;
+
+static void print_deoptimized_method(Method* m) {
+  MethodData* mdo = m->method_data();
+  if (mdo == NULL || mdo->decompile_count() == 0) {
+    return;
+  }
+  bool storm = DeoptStormThreshold > 0 && mdo->decompile_count() >= (uint)DeoptStormThreshold;
+  if (_deopt_print_only_storms && !storm) {
+    return;
+  }
+  outputStream* st = _deopt_print_stream;
+  ResourceMark rm;
+  st->print_cr("%s: %u decompiles, %u overflow recompiles%s",
+               m->name_and_sig_as_C_string(), mdo->decompile_count(),
+               mdo->overflow_recompile_count(), storm ? ", storm" : "");
+  for (int reason = 0; reason < Deoptimization::Reason_LIMIT; reason++) {
+    uint count = mdo->trap_count(reason);
+    if (count == (uint)-1) {
+      st->print_cr("  %s: saturated", Deoptimization::trap_reason_name(reason));
+    } else if (count > 0) {
+      st->print_cr("  %s: %u", Deoptimization::trap_reason_name(reason), count);
+    }
+  }
+  for (ProfileData* pd = mdo->first_data(); mdo->is_valid(pd); pd = mdo->next_data(pd)) {
+    int trap_state = pd->trap_state();
+    if (trap_state != 0) {
+      char buf[100];
+      st->print_cr("  @%d %s", pd->bci(),
+                   Deoptimization::format_trap_state(buf, sizeof(buf), trap_state));
+    }
+  }
+}
+
+void Deoptimization::print_deoptimized_methods(outputStream* st, bool only_storms) {
+  MutexLocker ml(ClassLoaderDataGraph_lock);
+  _deopt_print_stream = st;
+  _deopt_print_only_storms = only_storms;
+  ClassLoaderDataGraph::methods_do(print_deoptimized_method);
+  _deopt_print_stream = NULL;
+}
+
 ProfileData*
 Deoptimization::query_update_method_data(MethodData* trap_mdo,
                                          int trap_bci,
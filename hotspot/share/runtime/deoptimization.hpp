@@ -298,6 +298,10 @@ JVMCI_ONLY(public:)
                                 Bytecodes::Code bc = Bytecodes::_illegal);
   static void print_statistics();
 
+  // Lists the trap history of the methods that were deoptimized, for the
+  // Compiler.deoptimizations diagnostic command.
+  static void print_deoptimized_methods(outputStream* st, bool only_storms);
+
   // How much room to adjust the last frame's SP by, to make space for
   // the callee's interpreter frame (which expects locals to be next to
   // incoming arguments)
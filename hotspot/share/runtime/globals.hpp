@@ -373,6 +373,9 @@ const size_t minimumSymbolTableSize = 1024;
   diagnostic(bool, UseVectorizedMismatchIntrinsic, false,                   \
           "Enables intrinsification of ArraysSupport.vectorizedMismatch()") \
                                                                             \
+  diagnostic(bool, UseVectorizedHashCodeIntrinsic, false,                   \
+          "Enables intrinsification of ArraysSupport.vectorizedHashCode()") \
+                                                                            \
   diagnostic(ccstrlist, DisableIntrinsic, "",                               \
          "do not expand intrinsics whose (internal) names appear here")     \
                                                                             \
@@ -408,6 +411,10 @@ const size_t minimumSymbolTableSize = 1024;
   product(bool, FailOverToOldVerifier, true,                                \
           "Fail over to old verifier when split verifier fails")            \
                                                                             \
+  product(ccstr, VerificationCacheFile, NULL,                               \
+          "Remember the classes that passed the split verifier in this "    \
+          "file, and do not verify them again in later runs")               \
+                                                                            \
   product(bool, SafepointTimeout, false,                                    \
           "Time out and warn or fail after SafepointTimeoutDelay "          \
           "milliseconds if failed to reach safepoint")                      \
@@ -415,6 +422,11 @@ const size_t minimumSymbolTableSize = 1024;
   diagnostic(bool, AbortVMOnSafepointTimeout, false,                        \
           "Abort upon failure to reach safepoint (see SafepointTimeout)")   \
                                                                             \
+  product(uintx, ParallelSafepointSyncThreshold, 1000,                      \
+          "Examine the states of the Java threads in parallel, with the "   \
+          "safepoint workers of the GC, when there are at least this "      \
+          "many at the start of a safepoint (0=>never)")                    \
+                                                                            \
   diagnostic(bool, AbortVMOnVMOperationTimeout, false,                      \
           "Abort upon failure to complete VM operation promptly")           \
                                                                             \
@@ -555,12 +567,24 @@ const size_t minimumSymbolTableSize = 1024;
           "directory) of the dump file (defaults to java_pid<pid>.hprof "   \
           "in the working directory)")                                      \
                                                                             \
+  manageable(intx, HeapDumpGzipLevel, 0,                                    \
+          "When HeapDumpOnOutOfMemoryError is on, the gzip compression "    \
+          "level of the dump file. 0 (the default) disables gzip "          \
+          "compression. Otherwise the level must be between 1 and 9.")      \
+          range(0, 9)                                                       \
+                                                                            \
   develop(bool, BreakAtWarning, false,                                      \
           "Execute breakpoint upon encountering VM warning")                \
                                                                             \
   product(ccstr, NativeMemoryTracking, "off",                               \
           "Native memory tracking options")                                 \
                                                                             \
+  product(uintx, NMTDetailSampleInterval, 1,                                \
+          "With detail native memory tracking, record the call stack of "  \
+          "only one in this many allocations per thread. Malloc sites "     \
+          "are reported scaled by the interval")                            \
+          range(1, max_juint)                                               \
+                                                                            \
   diagnostic(bool, PrintNMTStatistics, false,                               \
           "Print native memory tracking summary data if it is on")          \
                                                                             \
@@ -699,6 +723,26 @@ const size_t minimumSymbolTableSize = 1024;
   diagnostic(bool, DynamicallyResizeSystemDictionaries, true,               \
           "Dynamically resize system dictionaries as needed")               \
                                                                             \
+  product(ccstr, PrefetchClassList, NULL,                                   \
+          "File in class list format naming boot classes whose class "      \
+          "files are read ahead of time by background threads")             \
+                                                                            \
+  product(uintx, PrefetchClassThreads, 2,                                   \
+          "Number of threads reading the classes in PrefetchClassList")     \
+          range(1, 16)                                                      \
+                                                                            \
+  product(bool, PrefaultJImageIndex, false,                                 \
+          "Read in the whole resource index of the modules image at "       \
+          "startup instead of page by page on lookup")                      \
+                                                                            \
+  product(size_t, JImageResourceCacheSize, 0,                               \
+          "Number of bytes of decompressed resources of the modules "       \
+          "image kept in memory. 0 disables the cache")                     \
+                                                                            \
+  product(bool, PrefetchJImageResources, false,                             \
+          "Decompress the classes of the CDS class list ahead of time on "  \
+          "a background thread. Requires JImageResourceCacheSize")          \
+                                                                            \
   product(bool, AlwaysLockClassLoader, false,                               \
           "Require the VM to acquire the class loader lock before calling " \
           "loadClass() even for class loaders registering "                 \
@@ -732,6 +776,17 @@ const size_t minimumSymbolTableSize = 1024;
                 "The check is performed on GuaranteedSafepointInterval.")   \
                 range(0, 100)                                               \
                                                                             \
+  diagnostic(bool, AsyncDeflateIdleMonitors, true,                          \
+          "Deflate idle monitors concurrently in the ServiceThread "        \
+          "instead of in safepoint cleanup (requires "                      \
+          "ThreadLocalHandshakes)")                                         \
+                                                                            \
+  diagnostic(intx, AsyncDeflationInterval, 250,                             \
+          "Minimum time in ms between concurrent idle monitor deflation "   \
+          "cycles (0 only deflates when requested by a safepoint or "       \
+          "by MonitorBound)")                                               \
+          range(0, max_jint)                                                \
+                                                                            \
   experimental(intx, hashCode, 5,                                           \
                "(Unstable) select hashCode generation algorithm")           \
                                                                             \
@@ -1021,6 +1076,19 @@ const size_t minimumSymbolTableSize = 1024;
   product(bool, UseDynamicNumberOfCompilerThreads, true,                    \
           "Dynamically choose the number of parallel compiler threads")     \
                                                                             \
+  product(uintx, CompileLatencyTarget, 0,                                   \
+          "With UseDynamicNumberOfCompilerThreads, only add compiler "      \
+          "threads while compile tasks wait longer than this many "         \
+          "milliseconds in the queue on average. 0 means no target")        \
+          range(0, max_juint)                                               \
+                                                                            \
+  product(uintx, CompilerThreadsCPUThreshold, 0,                            \
+          "With UseDynamicNumberOfCompilerThreads, do not add compiler "    \
+          "threads while the process uses more than this percentage of "    \
+          "the CPUs available to it, including the container CPU quota. "   \
+          "0 means no threshold")                                           \
+          range(0, 100)                                                     \
+                                                                            \
   diagnostic(bool, ReduceNumberOfCompilerThreads, true,                     \
              "Reduce the number of parallel compiler threads when they "    \
              "are not used")                                                \
@@ -1115,6 +1183,11 @@ const size_t minimumSymbolTableSize = 1024;
   product(bool, UseCodeAging, true,                                         \
           "Insert counter to detect warm methods")                          \
                                                                             \
+  experimental(bool, SweepUsingEntryBarriers, false,                        \
+          "Detect the use of nmethods with entry barriers that the "        \
+          "sweeper arms, instead of scanning stacks at every safepoint. "   \
+          "Adds entry barriers for all collectors (x86_64 only)")           \
+                                                                            \
   diagnostic(bool, StressCodeAging, false,                                  \
           "Start with counters compiled in")                                \
                                                                             \
@@ -1160,6 +1233,22 @@ const size_t minimumSymbolTableSize = 1024;
           "If LogVMOutput or LogCompilation is on, save VM output to "      \
           "this file [default: ./hotspot_pid%p.log] (%p replaced with pid)")\
                                                                             \
+  product(bool, AsyncLogging, false,                                        \
+          "Buffer unified logging output in memory and write it to the "    \
+          "log outputs from a dedicated thread, so that logging never "     \
+          "blocks on I/O")                                                  \
+                                                                            \
+  product(size_t, AsyncLogBufferSize, 2 * M,                                \
+          "Size in bytes of the buffer of each asynchronously written "     \
+          "log output (AsyncLogging); messages that do not fit are "        \
+          "dropped")                                                        \
+          range(16 * K, 1 * G)                                              \
+                                                                            \
+  diagnostic(uintx, AsyncLogFlushInterval, 100,                             \
+          "Maximum time in milliseconds a message stays buffered before "   \
+          "the asynchronous log writer writes it out")                      \
+          range(1, max_jint)                                                \
+                                                                            \
   product(ccstr, ErrorFile, NULL,                                           \
           "If an error occurs, save the error data to this file "           \
           "[default: ./hs_err_pid%p.log] (%p replaced with pid)")           \
@@ -1577,6 +1666,12 @@ const size_t minimumSymbolTableSize = 1024;
           "Per-BCI limit on repeated recompilation (-1=>'Inf')")            \
           range(-1, max_intx)                                               \
                                                                             \
+  product(intx, DeoptStormThreshold, 16,                                    \
+          "After N deoptimizations of a method, back off its "              \
+          "recompilation exponentially and stop speculating on the "        \
+          "trap reasons that deoptimize it (0=>off)")                       \
+          range(0, max_jint)                                                \
+                                                                            \
   product(intx, PerMethodTrapLimit,  100,                                   \
           "Limit on traps (of one kind) in a method (includes inlines)")    \
           range(0, max_jint)                                                \
@@ -1625,8 +1720,8 @@ const size_t minimumSymbolTableSize = 1024;
                                                                             \
   product(size_t, CompressedClassSpaceSize, 1*G,                            \
           "Maximum size of class area in Metaspace when compressed "        \
-          "class pointers are used")                                        \
-          range(1*M, 3*G)                                                   \
+          "class pointers are used. Only the used part is committed")       \
+          range(1*M, LP64_ONLY(30*G) NOT_LP64(3*G))                         \
                                                                             \
   manageable(uintx, MinHeapFreeRatio, 40,                                   \
           "The minimum percentage of heap free after GC to avoid expansion."\
@@ -1660,6 +1755,10 @@ const size_t minimumSymbolTableSize = 1024;
           "The minimum expansion of Metaspace (in bytes)")                  \
           range(0, max_uintx)                                               \
                                                                             \
+  product(bool, MetaspaceUncommitFreeChunks, true,                          \
+          "Give the memory of free medium and humongous Metaspace chunks "  \
+          "back to the operating system")                                   \
+                                                                            \
   product(uintx, MaxMetaspaceFreeRatio,    70,                              \
           "The maximum percentage of Metaspace free after GC to avoid "     \
           "shrinking")                                                      \
@@ -1760,6 +1859,17 @@ const size_t minimumSymbolTableSize = 1024;
           "Size of code heap with non-nmethods (in bytes)")                 \
           range(os::vm_page_size(), max_uintx)                              \
                                                                             \
+  product(uintx, HotCodeHeapSize, 0,                                        \
+          "Size of code heap with the tier 4 code of the hottest methods "  \
+          "(in bytes), taken from the non-profiled code heap. 0 means no "  \
+          "hot code heap")                                                  \
+          range(0, max_uintx)                                               \
+                                                                            \
+  product(uintx, HotCodeHeapThreshold, 100000,                              \
+          "Number of invocations and backedges after which the tier 4 "     \
+          "code of a method goes into the hot code heap")                   \
+          range(0, max_juint)                                               \
+                                                                            \
   product_pd(uintx, CodeCacheExpansionSize,                                 \
           "Code cache expansion size (in bytes)")                           \
           range(32*K, max_uintx)                                            \
@@ -1854,6 +1964,14 @@ const size_t minimumSymbolTableSize = 1024;
           "File containing inlining replay information"                     \
           "[default: ./inline_pid%p.log] (%p replaced with pid)")           \
                                                                             \
+  product(ccstr, DumpProfileSnapshot, NULL,                                 \
+          "Write the invocation and backedge counts of compiled methods "   \
+          "to this file at exit")                                           \
+                                                                            \
+  product(ccstr, LoadProfileSnapshot, NULL,                                 \
+          "Seed method counters from a file written with "                  \
+          "DumpProfileSnapshot, to compile hot methods earlier")            \
+                                                                            \
   develop(intx, ReplaySuppressInitializers, 2,                              \
           "Control handling of class initialization during replay: "        \
           "0 - don't do anything special; "                                 \
@@ -2115,6 +2233,25 @@ const size_t minimumSymbolTableSize = 1024;
           "reaches this amount per compiler thread")                        \
           range(0, max_jint)                                                \
                                                                             \
+  product(bool, TieredScaleThresholdsByCPU, false,                          \
+          "Scale the thresholds of the tiered policy up while the "         \
+          "container is CPU throttled and down while the VM is idle")       \
+                                                                            \
+  product(double, TieredThrottledThresholdScale, 4.0,                       \
+          "Threshold scale while the container is CPU throttled, "          \
+          "with TieredScaleThresholdsByCPU")                                \
+          range(1.0, 1000.0)                                                \
+                                                                            \
+  product(double, TieredIdleThresholdScale, 0.5,                            \
+          "Threshold scale while the VM is idle, "                          \
+          "with TieredScaleThresholdsByCPU")                                \
+          range(0.01, 1.0)                                                  \
+                                                                            \
+  product(uintx, TieredIdleCPUThreshold, 10,                                \
+          "The VM is idle while it uses less than this percentage of "      \
+          "its CPUs, with TieredScaleThresholdsByCPU")                      \
+          range(0, 100)                                                     \
+                                                                            \
   product(intx, TieredCompileTaskTimeout, 50,                               \
           "Kill compile task if method was not used within "                \
           "given timeout in milliseconds")                                  \
@@ -2243,6 +2380,12 @@ const size_t minimumSymbolTableSize = 1024;
   product(bool, StartAttachListener, false,                                 \
           "Always start Attach Listener at VM startup")                     \
                                                                             \
+  product(uintx, AttachListenerWorkers, 2,                                  \
+          "Number of threads that run diagnostic attach operations "        \
+          "concurrently with the Attach Listener. 0 runs all operations "   \
+          "on the Attach Listener thread")                                  \
+          range(0, 16)                                                      \
+                                                                            \
   product(bool, EnableDynamicAgentLoading, true,                            \
           "Allow tools to load agents with the attach mechanism")           \
                                                                             \
@@ -2268,6 +2411,12 @@ const size_t minimumSymbolTableSize = 1024;
   product(bool, DynamicDumpSharedSpaces, false,                             \
           "Dynamic archive")                                                \
                                                                             \
+  product(bool, UseLargePagesForSharedSpaces, false,                        \
+          "Ask the kernel to back the read-only regions of the CDS archive "\
+          "with transparent huge pages in the page cache, so they are "     \
+          "shared between JVMs mapping the same archive. Requires "         \
+          "UseTransparentHugePages")                                        \
+                                                                            \
   product(bool, PrintSharedArchiveAndExit, false,                           \
           "Print shared archive file contents")                             \
                                                                             \
@@ -2280,6 +2429,13 @@ const size_t minimumSymbolTableSize = 1024;
           "Address to allocate shared memory region for class data")        \
           range(0, SIZE_MAX)                                                \
                                                                             \
+  diagnostic(int, ArchiveRelocationMode, 0,                                 \
+          "(0) first map at the address the CDS archive was dumped at, "    \
+          "and relocate the archive if that is not possible; "              \
+          "(1) always map at a different address and relocate (for "        \
+          "testing); (2) never relocate, disable sharing instead")          \
+          range(0, 2)                                                       \
+                                                                            \
   product(ccstr, SharedArchiveConfigFile, NULL,                             \
           "Data to add to the CDS archive file")                            \
                                                                             \
@@ -2302,6 +2458,11 @@ const size_t minimumSymbolTableSize = 1024;
   diagnostic(bool, ShowHiddenFrames, false,                                 \
           "show method handle implementation frames (usually hidden)")      \
                                                                             \
+  product(bool, ShareStringConcatCallSites, true,                           \
+          "Link the invokedynamic string concatenations of a class that "   \
+          "share a bootstrap specifier to the same target, invoking "       \
+          "StringConcatFactory only once")                                  \
+                                                                            \
   experimental(bool, TrustFinalNonStaticFields, false,                      \
           "trust final non-static declarations for constant folding")       \
                                                                             \
@@ -2354,6 +2515,19 @@ const size_t minimumSymbolTableSize = 1024;
           "Number of buckets in the JVM internal Symbol table")             \
           range(minimumSymbolTableSize, 111*defaultSymbolTableSize)         \
                                                                             \
+  product(uintx, ResourceLimitWatchInterval, 5000,                         \
+          "Milliseconds between checks of the active processor count and "  \
+          "the physical memory, which follow the container limits, so "     \
+          "that a resized container is used without a restart "             \
+          "(0 disables the checks)")                                        \
+          range(0, 10000)                                                   \
+                                                                            \
+  product(uint, ServiceThreadWorkers, 0,                                    \
+          "Number of threads used to grow and clean the String, Symbol "    \
+          "and ResolvedMethod tables in parallel (0 means chosen "          \
+          "ergonomically, 1 leaves the work to the ServiceThread)")         \
+          range(0, 64)                                                      \
+                                                                            \
   product(bool, UseStringDeduplication, false,                              \
           "Use string deduplication")                                       \
                                                                             \
@@ -2391,6 +2565,11 @@ const size_t minimumSymbolTableSize = 1024;
   product(ccstr, ExtraSharedClassListFile, NULL,                            \
           "Extra classlist for building the CDS archive file")              \
                                                                             \
+  product(ccstr, ArchivedStaticFieldList, NULL,                             \
+          "File with one <class> <field> line per static field of an "      \
+          "application class whose object graph is archived in the CDS "    \
+          "archive after the class is initialized at dump time")            \
+                                                                            \
   experimental(size_t, ArrayAllocatorMallocLimit,                           \
           SOLARIS_ONLY(64*K) NOT_SOLARIS((size_t)-1),                       \
           "Allocation less than this value will be allocated "              \
@@ -2463,6 +2642,16 @@ const size_t minimumSymbolTableSize = 1024;
   JFR_ONLY(product(ccstr, StartFlightRecording, NULL,                       \
           "Start flight recording with options"))                           \
                                                                             \
+  JFR_ONLY(product(bool, JfrSampleWithHandshakes, false,                    \
+          "Take the execution samples of Flight Recorder with a "           \
+          "thread-local handshake at the next safepoint poll of the "       \
+          "sampled thread, instead of suspending it with a signal"))        \
+                                                                            \
+  JFR_ONLY(product(bool, JfrSampleByCPUTime, false,                         \
+          "Pick the threads for the execution samples of Flight Recorder "  \
+          "by the CPU time they used since they were last sampled, "        \
+          "instead of in turn"))                                            \
+                                                                            \
   experimental(bool, UseFastUnorderedTimeStamps, false,                     \
           "Use platform unstable time where supported for timestamps only")
 
@@ -59,6 +59,9 @@ void management_init();
 void bytecodes_init();
 void classLoader_init1();
 void compilationPolicy_init();
+void profileSnapshot_init();
+void verificationCache_init();
+void jimagePrefetcher_init();
 void codeCache_init();
 void VM_Version_init();
 void os_init_globals();        // depends on VM_Version_init, before universe_init
@@ -119,9 +122,11 @@ jint init_globals() {
   if (status != JNI_OK)
     return status;
 
+  jimagePrefetcher_init();   // after the CDS archive is mapped, before classes are loaded
   gc_barrier_stubs_init();   // depends on universe_init, must be before interpreter_init
   interpreter_init();        // before any methods loaded
   invocationCounter_init();  // before any methods loaded
+  profileSnapshot_init();    // after the CDS archive is mapped, before any methods run
   accessFlags_init();
   templateTable_init();
   InterfaceSupport_init();
@@ -129,6 +134,7 @@ jint init_globals() {
   SharedRuntime::generate_stubs();
   universe2_init();  // dependent on codeCache_init and stubRoutines_init1
   javaClasses_init();// must happen after vtable initialization, before referenceProcessor_init
+  verificationCache_init(); // before any classes are verified
   referenceProcessor_init();
   jni_handles_init();
 #if INCLUDE_VM_STRUCTS
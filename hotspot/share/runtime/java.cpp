@@ -30,9 +30,11 @@
 #include "classfile/stringTable.hpp"
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
+#include "classfile/verificationCache.hpp"
 #include "code/codeCache.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/compilerOracle.hpp"
+#include "compiler/profileSnapshot.hpp"
 #include "interpreter/bytecodeHistogram.hpp"
 #include "jfr/jfrEvents.hpp"
 #include "jfr/support/jfrThreadId.hpp"
@@ -64,6 +66,7 @@
 #include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/java.hpp"
 #include "runtime/memprofiler.hpp"
+#include "runtime/resourceLimitWatcher.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/statSampler.hpp"
 #include "runtime/sweeper.hpp"
@@ -465,6 +468,7 @@ void before_exit(JavaThread* thread) {
   // shut down the StatSampler task
   StatSampler::disengage();
   StatSampler::destroy();
+  ResourceLimitWatcher::disengage();
 
   // Stop concurrent GC threads
   Universe::heap()->stop();
@@ -505,6 +509,9 @@ void before_exit(JavaThread* thread) {
   }
 #endif
 
+  ProfileSnapshot::dump_at_exit();
+  VerificationCache::dump_at_exit();
+
   print_statistics();
   Universe::heap()->print_tracing_info();
 
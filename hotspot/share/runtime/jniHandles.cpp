@@ -106,7 +106,7 @@ jobject JNIHandles::make_global(Handle obj, AllocFailType alloc_failmode) {
   if (!obj.is_null()) {
     // ignore null handles
     assert(oopDesc::is_oop(obj()), "not an oop");
-    oop* ptr = global_handles()->allocate();
+    oop* ptr = Thread::current()->global_handle_cache()->allocate(global_handles());
     // Return NULL on allocation failure.
     if (ptr != NULL) {
       assert(*ptr == NULL, "invariant");
@@ -130,7 +130,7 @@ jobject JNIHandles::make_weak_global(Handle obj, AllocFailType alloc_failmode) {
   if (!obj.is_null()) {
     // ignore null handles
     assert(oopDesc::is_oop(obj()), "not an oop");
-    oop* ptr = weak_global_handles()->allocate();
+    oop* ptr = Thread::current()->weak_global_handle_cache()->allocate(weak_global_handles());
     // Return NULL on allocation failure.
     if (ptr != NULL) {
       assert(*ptr == NULL, "invariant");
@@ -146,6 +146,58 @@ jobject JNIHandles::make_weak_global(Handle obj, AllocFailType alloc_failmode) {
   return res;
 }
 
+void JNIHandles::flush_handle_caches(Thread* thread) {
+  // The storages may not exist yet if the VM failed early in startup.
+  if (_global_handles != NULL) {
+    thread->global_handle_cache()->flush(_global_handles);
+  }
+  if (_weak_global_handles != NULL) {
+    thread->weak_global_handle_cache()->flush(_weak_global_handles);
+  }
+}
+
+oop* JNIHandleCache::allocate(OopStorage* storage) {
+  if (_count == 0) {
+    _count = (uint)storage->allocate(_entries, refill_size);
+    if (_count == 0) {
+      return NULL;              // Allocation failed.
+    }
+  }
+  oop* entry = _entries[--_count];
+  assert(*entry == NULL, "invariant");
+  return entry;
+}
+
+void JNIHandleCache::release(OopStorage* storage, oop* entry) {
+  assert(*entry == NULL, "must be cleared");
+  assert(!contains(entry), "entry released twice");
+  // A cached entry is still allocated in storage, so the checks of
+  // -Xcheck:jni would take a deleted handle for a live one.
+  if (_count < capacity && !CheckJNICalls) {
+    _entries[_count++] = entry;
+  } else {
+    storage->release(entry);
+  }
+}
+
+#ifdef ASSERT
+bool JNIHandleCache::contains(oop* entry) const {
+  for (uint i = 0; i < _count; i++) {
+    if (_entries[i] == entry) {
+      return true;
+    }
+  }
+  return false;
+}
+#endif // ASSERT
+
+void JNIHandleCache::flush(OopStorage* storage) {
+  if (_count > 0) {
+    storage->release(_entries, _count);
+    _count = 0;
+  }
+}
+
 // Resolve some erroneous cases to NULL, rather than treating them as
 // possibly unchecked errors.  In particular, deleted handles are
 // treated as NULL (though a deleted and later reallocated handle
@@ -171,7 +223,12 @@ void JNIHandles::destroy_global(jobject handle) {
     assert(!is_jweak(handle), "wrong method for detroying jweak");
     oop* oop_ptr = jobject_ptr(handle);
     NativeAccess<>::oop_store(oop_ptr, (oop)NULL);
-    global_handles()->release(oop_ptr);
+    Thread* thread = Thread::current_or_null();
+    if (thread != NULL) {
+      thread->global_handle_cache()->release(global_handles(), oop_ptr);
+    } else {
+      global_handles()->release(oop_ptr);
+    }
   }
 }
 
@@ -181,7 +238,12 @@ void JNIHandles::destroy_weak_global(jobject handle) {
     assert(is_jweak(handle), "JNI handle not jweak");
     oop* oop_ptr = jweak_ptr(handle);
     NativeAccess<ON_PHANTOM_OOP_REF>::oop_store(oop_ptr, (oop)NULL);
-    weak_global_handles()->release(oop_ptr);
+    Thread* thread = Thread::current_or_null();
+    if (thread != NULL) {
+      thread->weak_global_handle_cache()->release(weak_global_handles(), oop_ptr);
+    } else {
+      weak_global_handles()->release(oop_ptr);
+    }
   }
 }
 
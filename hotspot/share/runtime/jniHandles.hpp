@@ -92,6 +92,10 @@ class JNIHandles : AllStatic {
   static void destroy_weak_global(jobject handle);
   static bool is_global_weak_cleared(jweak handle); // Test jweak without resolution
 
+  // Returns the entries cached by thread to the handle storages.  Called
+  // when the thread is destroyed.
+  static void flush_handle_caches(Thread* thread);
+
   // Initialization
   static void initialize();
 
@@ -127,6 +131,38 @@ class JNIHandles : AllStatic {
   static OopStorage* weak_global_handles();
 };
 
+// Thread local cache of free entries of the global or weak global handle
+// storage.  Entries are taken from the storage in bulk, and destroyed
+// handles are recycled through the cache, so that most handle creations
+// and deletions do not need the storage's allocation lock.  The cached
+// entries remain allocated in the storage, holding NULL.
+
+class JNIHandleCache {
+ private:
+  enum SomeConstants {
+    capacity    = 32,           // Max number of cached entries
+    refill_size = capacity / 2  // Entries taken from the storage at once
+  };
+
+  oop* _entries[capacity];
+  uint _count;
+
+  DEBUG_ONLY(bool contains(oop* entry) const;)
+
+ public:
+  JNIHandleCache() : _count(0) {}
+
+  // Returns a free entry of storage, or NULL if allocation failed.
+  // postcondition: *result == NULL.
+  oop* allocate(OopStorage* storage);
+  // Caches entry, or releases it to storage if the cache is full or
+  // CheckJNICalls is set.
+  // precondition: *entry == NULL.
+  void release(OopStorage* storage, oop* entry);
+  // Releases all the cached entries to storage.
+  void flush(OopStorage* storage);
+};
+
 
 
 // JNI handle blocks holding local/global JNI handles
@@ -109,6 +109,12 @@ static int Knob_Penalty             = 200;     // spin failure penalty
 static int Knob_Poverty             = 1000;
 static int Knob_FixedSpin           = 0;
 static int Knob_PreSpin             = 10;      // 20-100 likely better
+static int Knob_SpinHoldLimit       = 50;      // microseconds, about two context switches
+
+// Knob_SpinHoldLimit in elapsed counter ticks, and the number of CPUs this
+// process may run on, including any CPU quota of its container.
+static jlong SpinHoldLimitTicks     = 0;
+static int   SpinCPUs               = 1;
 
 DEBUG_ONLY(static volatile bool InitDone = false;)
 
@@ -238,7 +244,7 @@ void ObjectMonitor::operator delete[] (void *p) {
 // -----------------------------------------------------------------------------
 // Enter support
 
-void ObjectMonitor::enter(TRAPS) {
+bool ObjectMonitor::enter(TRAPS) {
   // The following code is ordered to check the most common cases first
   // and to reduce RTS->RTO cache line upgrades on SPARC and IA32 processors.
   Thread * const Self = THREAD;
@@ -246,13 +252,13 @@ void ObjectMonitor::enter(TRAPS) {
   void * cur = Atomic::cmpxchg(Self, &_owner, (void*)NULL);
   if (cur == NULL) {
     assert(_recursions == 0, "invariant");
-    return;
+    return true;
   }
 
   if (cur == Self) {
     // TODO-FIXME: check for integer overflow!  BUGID 6557169.
     _recursions++;
-    return;
+    return true;
   }
 
   if (Self->is_lock_owned ((address)cur)) {
@@ -261,7 +267,7 @@ void ObjectMonitor::enter(TRAPS) {
     // Commute owner from a thread-specific on-stack BasicLockObject address to
     // a full-fledged "Thread *".
     _owner = Self;
-    return;
+    return true;
   }
 
   // We've encountered genuine contention.
@@ -282,7 +288,8 @@ void ObjectMonitor::enter(TRAPS) {
            ", encoded this=" INTPTR_FORMAT, p2i(((oop)object())->mark()),
            p2i(markOopDesc::encode(this)));
     Self->_Stalled = 0;
-    return;
+    record_contended_enter();
+    return true;
   }
 
   assert(_owner != Self, "invariant");
@@ -291,12 +298,20 @@ void ObjectMonitor::enter(TRAPS) {
   JavaThread * jt = (JavaThread *) Self;
   assert(!SafepointSynchronize::is_at_safepoint(), "invariant");
   assert(jt->thread_state() != _thread_blocked, "invariant");
-  assert(this->object() != NULL, "invariant");
-  assert(_contentions >= 0, "invariant");
 
   // Prevent deflation at STW-time.  See deflate_idle_monitors() and is_busy().
   // Ensure the object-monitor relationship remains stable while there's contention.
-  Atomic::inc(&_contentions);
+  // If the ServiceThread has already claimed the monitor for deflation, the
+  // increment leaves _contentions non-positive. Make sure the object's header
+  // is restored and let the caller retry with a freshly inflated monitor.
+  // See deflate_monitor_using_JT().
+  if (Atomic::add(1, &_contentions) <= 0) {
+    install_displaced_markword_in_object();
+    Atomic::dec(&_contentions);
+    Self->_Stalled = 0;
+    return false;
+  }
+  assert(this->object() != NULL, "invariant");
 
   JFR_ONLY(JfrConditionalFlushWithStacktrace<EventJavaMonitorEnter> flush(jt);)
   EventJavaMonitorEnter event;
@@ -360,6 +375,7 @@ void ObjectMonitor::enter(TRAPS) {
   Atomic::dec(&_contentions);
   assert(_contentions >= 0, "invariant");
   Self->_Stalled = 0;
+  record_contended_enter();
 
   // Must either set _recursions = 0 or ASSERT _recursions == 0.
   assert(_recursions == 0, "invariant");
@@ -394,6 +410,29 @@ void ObjectMonitor::enter(TRAPS) {
     event.commit();
   }
   OM_PERFDATA_OP(ContendedLockAttempts, inc());
+  return true;
+}
+
+// Restore the object's header from the displaced header if the object
+// still refers to this monitor. Called by the ServiceThread when it
+// deflates the monitor, and by any thread that finds the monitor being
+// deflated, so that such a thread never has to wait for the deflater
+// before it can re-inflate the object.
+void ObjectMonitor::install_displaced_markword_in_object() {
+  assert(is_being_async_deflated(), "must be: contentions=%d", _contentions);
+  // Order the read of _contentions before the reads of _object and
+  // _header below; the deflater clears _object only after it restored
+  // the header.
+  OrderAccess::loadload();
+  oop obj = (oop)object();
+  if (obj == NULL) {
+    // The deflater has already restored the header.
+    return;
+  }
+  markOop dmw = header();
+  assert(dmw->is_neutral(), "invariant: header=" INTPTR_FORMAT, p2i(dmw));
+  // A failed CAS means that another thread restored the header first.
+  obj->cas_set_mark(dmw, markOopDesc::encode(this));
 }
 
 // Caveat: TryLock() is not necessarily serializing if it returns failure.
@@ -891,6 +930,8 @@ void ObjectMonitor::exit(bool not_suspended, TRAPS) {
     return;
   }
 
+  record_contended_exit(Self);
+
   // Invariant: after setting Responsible=null an thread must execute
   // a MEMBAR or other serializing instruction before fetching EntryList|cxq.
   _Responsible = NULL;
@@ -1131,16 +1172,19 @@ intptr_t ObjectMonitor::complete_exit(TRAPS) {
 
 // reenter() enters a lock and sets recursion count
 // complete_exit/reenter operate as a wait without waiting
-void ObjectMonitor::reenter(intptr_t recursions, TRAPS) {
+bool ObjectMonitor::reenter(intptr_t recursions, TRAPS) {
   Thread * const Self = THREAD;
   assert(Self->is_Java_thread(), "Must be Java thread!");
   JavaThread *jt = (JavaThread *)THREAD;
 
   guarantee(_owner != Self, "reenter already owner");
-  enter(THREAD);       // enter the monitor
+  if (!enter(THREAD)) {  // enter the monitor
+    // The monitor was deflated concurrently; the caller must retry.
+    return false;
+  }
   guarantee(_recursions == 0, "reenter recursion");
   _recursions = recursions;
-  return;
+  return true;
 }
 
 
@@ -1368,7 +1412,11 @@ void ObjectMonitor::wait(jlong millis, bool interruptible, TRAPS) {
     assert(_owner != Self, "invariant");
     ObjectWaiter::TStates v = node.TState;
     if (v == ObjectWaiter::TS_RUN) {
-      enter(Self);
+      // _waiters is still non-zero, so the monitor can't have been
+      // deflated and enter() can't fail.
+      if (!enter(Self)) {
+        ShouldNotReachHere();
+      }
     } else {
       guarantee(v == ObjectWaiter::TS_ENTER || v == ObjectWaiter::TS_CXQ, "invariant");
       ReenterI(Self, &node);
@@ -1576,6 +1624,43 @@ void ObjectMonitor::notifyAll(TRAPS) {
 // hysteresis control to damp the transition rate between spinning and
 // not spinning.
 
+// Besides the outcome of recent spins, admission to the adaptive spin
+// considers two signals that predict a failed spin before it is tried:
+// - the number of threads already contending for the monitor.  Once there
+//   are as many of them as CPUs we may run on, the owner competes with the
+//   spinners for a CPU and spinning only delays it; fall back to parking.
+// - the recent hold times of the monitor, measured from a contended enter
+//   to the matching exit.  A critical section that is held longer than a
+//   couple of context switches is not worth spinning for.
+
+// The owner measures its own hold time, so _hold_ticks and
+// _contended_enter_time are only updated by the owner.  An owner that
+// exits in the compiled fast path leaves the enter time behind, which may
+// then be taken for a longer hold of the same thread; the decaying average
+// absorbs such outliers.
+void ObjectMonitor::record_contended_enter() {
+  _contended_enter_time = Ticks::now();
+}
+
+void ObjectMonitor::record_contended_exit(Thread * Self) {
+  if (_contended_enter_time.value() == 0) {
+    return;
+  }
+  const Ticks now = Ticks::now();
+  const Tickspan held = now - _contended_enter_time;
+  _hold_ticks = _hold_ticks - (_hold_ticks >> 3) + (held.value() >> 3);
+
+  EventJavaMonitorHold event(UNTIMED);
+  if (event.should_commit()) {
+    event.set_starttime(_contended_enter_time);
+    event.set_endtime(now);
+    event.set_monitorClass(((oop)this->object())->klass());
+    event.set_address((uintptr_t)(this->object_addr()));
+    event.commit();
+  }
+  _contended_enter_time = Ticks();
+}
+
 // Spinning: Fixed frequency (100%), vary duration
 int ObjectMonitor::TrySpin(Thread * Self) {
   // Dumb, brutal spin.  Good for comparative measurements against adaptive spinning.
@@ -1620,6 +1705,10 @@ int ObjectMonitor::TrySpin(Thread * Self) {
   ctr = _SpinDuration;
   if (ctr <= 0) return 0;
 
+  if (_contentions >= SpinCPUs || _hold_ticks > SpinHoldLimitTicks) {
+    return 0;
+  }
+
   if (NotRunnable(Self, (Thread *) _owner)) {
     return 0;
   }
@@ -1905,6 +1994,8 @@ void ObjectMonitor::Initialize() {
     Knob_PreSpin   = 0;
     Knob_FixedSpin = -1;
   }
+  SpinHoldLimitTicks = os::elapsed_frequency() / 1000000 * Knob_SpinHoldLimit;
+  SpinCPUs = MAX2(os::active_processor_count(), 1);
 
   if (UsePerfData) {
     EXCEPTION_MARK;
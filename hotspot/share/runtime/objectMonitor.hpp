@@ -30,6 +30,7 @@
 #include "runtime/os.hpp"
 #include "runtime/park.hpp"
 #include "runtime/perfData.hpp"
+#include "utilities/ticks.hpp"
 
 class ObjectMonitor;
 
@@ -166,12 +167,16 @@ class ObjectMonitor {
 
   volatile jint  _contentions;      // Number of active contentions in enter(). It is used by is_busy()
                                     // along with other fields to determine if an ObjectMonitor can be
-                                    // deflated. See ObjectSynchronizer::deflate_monitor().
+                                    // deflated. See ObjectSynchronizer::deflate_monitor(). A negative
+                                    // value marks a monitor that is being deflated concurrently. See
+                                    // ObjectSynchronizer::deflate_monitor_using_JT().
  protected:
   ObjectWaiter * volatile _WaitSet; // LL of threads wait()ing on the monitor
   volatile jint  _waiters;          // number of waiting threads
  private:
   volatile int _WaitSetLock;        // protects Wait Queue - simple spinlock
+  Ticks _contended_enter_time;      // when the owner acquired the monitor after contention, or 0
+  jlong _hold_ticks;                // decaying average of the contended hold times, see TrySpin()
 
  public:
   static void Initialize();
@@ -245,6 +250,8 @@ class ObjectMonitor {
   jint      waiters() const;
 
   jint      contentions() const;
+  // True if the ServiceThread has claimed this monitor for deflation.
+  bool      is_being_async_deflated() const                            { return _contentions < 0; }
   intptr_t  recursions() const                                         { return _recursions; }
 
   // JVM/TI GetObjectMonitorUsage() needs this:
@@ -277,6 +284,8 @@ class ObjectMonitor {
     _cxq           = NULL;
     _WaitSet       = NULL;
     _recursions    = 0;
+    _contended_enter_time = Ticks();
+    _hold_ticks    = 0;
   }
 
  public:
@@ -288,8 +297,11 @@ class ObjectMonitor {
   bool      check(TRAPS);       // true if the thread owns the monitor.
   void      check_slow(TRAPS);
   void      clear();
+  void      install_displaced_markword_in_object();
 
-  void      enter(TRAPS);
+  // Returns false if the monitor was deflated concurrently; the caller
+  // must then re-inflate the object and retry.
+  bool      enter(TRAPS);
   void      exit(bool not_suspended, TRAPS);
   void      wait(jlong millis, bool interruptable, TRAPS);
   void      notify(TRAPS);
@@ -300,7 +312,7 @@ class ObjectMonitor {
 
 // Use the following at your own risk
   intptr_t  complete_exit(TRAPS);
-  void      reenter(intptr_t recursions, TRAPS);
+  bool      reenter(intptr_t recursions, TRAPS);
 
  private:
   void      AddWaiter(ObjectWaiter * waiter);
@@ -314,6 +326,8 @@ class ObjectMonitor {
   int       NotRunnable(Thread * Self, Thread * Owner);
   int       TrySpin(Thread * Self);
   void      ExitEpilog(Thread * Self, ObjectWaiter * Wakee);
+  void      record_contended_enter();
+  void      record_contended_exit(Thread * Self);
   bool      ExitSuspendEquivalent(JavaThread * Self);
 };
 
@@ -222,6 +222,9 @@ class os: AllStatic {
   // E.g., YYYY-MM-DDThh:mm:ss.mmm+zzzz.
   // Returns buffer, or NULL if it failed.
   static char* iso8601_time(char* buffer, size_t buffer_length, bool utc = false);
+  // Same as above, for the given time instead of the current time.
+  static char* iso8601_time(jlong milliseconds_since_19700101, char* buffer,
+                            size_t buffer_length, bool utc = false);
 
   // Interface for detecting multiprocessor system
   static inline bool is_MP() {
@@ -435,6 +438,7 @@ class os: AllStatic {
     java_thread,       // Java, CodeCacheSweeper, JVMTIAgent and Service threads.
     compiler_thread,
     watcher_thread,
+    asynclog_thread,   // dedicated to flushing logs
     os_thread
   };
 
@@ -537,6 +541,10 @@ class os: AllStatic {
   static char* native_path(char *path);
   static int ftruncate(int fd, jlong length);
   static int fsync(int fd);
+  // Advises that the cached pages of the file range starting at offset are
+  // not needed anymore, length 0 meaning up to the end of the file. Only pages
+  // already written back are dropped. A no-op where not supported.
+  static void drop_file_cache(int fd, jlong offset, jlong length);
   static int available(int fd, jlong *bytes);
   static int get_fileno(FILE* fp);
   static void flockfile(FILE* fp);
@@ -614,6 +622,19 @@ class os: AllStatic {
 
   static int get_loaded_modules_info(LoadedModulesCallbackFunc callback, void *param);
 
+  // Callback for memory mapping information
+  // Input parameters:
+  //    address   mapping_base_addr,
+  //    address   mapping_top_addr,
+  //    size_t    resident_size,
+  //    bool      file_backed,
+  //    void*     param
+  typedef void (*MemoryMappingsCallbackFunc)(address, address, size_t, bool, void *);
+
+  // Reports the memory mappings of this process in address order.
+  // Returns false if the platform does not provide them.
+  static bool get_memory_mappings_info(MemoryMappingsCallbackFunc callback, void *param);
+
   // Return the handle of this process
   static void* get_default_process_handle();
 
@@ -27,11 +27,14 @@
 #include "classfile/vmSymbols.hpp"
 #include "logging/log.hpp"
 #include "memory/allocation.inline.hpp"
+#include "memory/resourceArea.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/java.hpp"
 #include "runtime/mutex.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.hpp"
 #include "runtime/os.hpp"
 #include "runtime/perfData.inline.hpp"
 #include "utilities/exceptions.hpp"
@@ -568,6 +571,87 @@ PerfLongCounter* PerfDataManager::create_long_counter(CounterNS ns,
   return p;
 }
 
+PerfLongHistogram* PerfDataManager::create_long_histogram(CounterNS ns,
+                                                          const char* name,
+                                                          PerfData::Units u,
+                                                          jlong base,
+                                                          int nof_buckets,
+                                                          TRAPS) {
+  assert(base > 0, "histogram base must be positive");
+  assert(nof_buckets > 1 && nof_buckets < BitsPerJavaLong, "invalid number of buckets");
+
+  ResourceMark rm;
+  PerfLongHistogram* h = new PerfLongHistogram(base, nof_buckets);
+
+  create_long_constant(ns, counter_name(name, "base"), u, base, CHECK_NULL);
+  h->_count = create_long_counter(ns, counter_name(name, "count"),
+                                  PerfData::U_Events, CHECK_NULL);
+  h->_sum = create_long_counter(ns, counter_name(name, "sum"), u, CHECK_NULL);
+  for (int i = 0; i < nof_buckets; i++) {
+    char index[8];
+    jio_snprintf(index, sizeof(index), "%d", i);
+    h->_buckets[i] = create_long_counter(ns, counter_name(name, index),
+                                         PerfData::U_Events, CHECK_NULL);
+  }
+  return h;
+}
+
+PerfLongRing* PerfDataManager::create_long_ring(CounterNS ns,
+                                                const char* name,
+                                                PerfData::Units u,
+                                                int size, TRAPS) {
+  assert(size > 0, "ring must have at least one slot");
+
+  ResourceMark rm;
+  PerfLongRing* r = new PerfLongRing(size);
+
+  create_long_constant(ns, counter_name(name, "size"), PerfData::U_None,
+                       (jlong)size, CHECK_NULL);
+  r->_position = create_long_counter(ns, counter_name(name, "position"),
+                                     PerfData::U_Events, CHECK_NULL);
+  for (int i = 0; i < size; i++) {
+    char index[8];
+    jio_snprintf(index, sizeof(index), "%d", i);
+    r->_slots[i] = create_long_variable(ns, counter_name(name, index), u,
+                                        CHECK_NULL);
+  }
+  return r;
+}
+
+void PerfLongVariant::atomic_inc(jlong val) {
+  Atomic::add(val, (volatile jlong*)_valuep);
+}
+
+PerfLongHistogram::PerfLongHistogram(jlong base, int nof_buckets) :
+  _base(base), _nof_buckets(nof_buckets), _count(NULL), _sum(NULL) {
+  _buckets = NEW_C_HEAP_ARRAY(PerfLongCounter*, nof_buckets, mtInternal);
+}
+
+int PerfLongHistogram::bucket_for(jlong value) const {
+  int bucket = 0;
+  for (jlong limit = _base; bucket < _nof_buckets - 1 && value >= limit; limit <<= 1) {
+    bucket++;
+  }
+  return bucket;
+}
+
+void PerfLongHistogram::record(jlong value) {
+  _buckets[bucket_for(value)]->atomic_inc(1);
+  _sum->atomic_inc(value);
+  _count->atomic_inc(1);
+}
+
+PerfLongRing::PerfLongRing(int size) : _size(size), _position(NULL) {
+  _slots = NEW_C_HEAP_ARRAY(PerfLongVariable*, size, mtInternal);
+}
+
+void PerfLongRing::record(jlong value) {
+  jlong position = _position->get_value();
+  _slots[position % _size]->set_value(value);
+  OrderAccess::storestore();
+  _position->inc();
+}
+
 PerfDataList::PerfDataList(int length) {
 
   _set = new(ResourceObj::C_HEAP, mtInternal) PerfDataArray(length, true);
@@ -115,6 +115,10 @@ enum CounterNS {
  *
  * The String type is derived from the ByteArray type.
  *
+ * Distributions and recent sample histories are published with the
+ * PerfLongHistogram and PerfLongRing helpers, which group several Long
+ * items under a common name prefix rather than adding new entry types.
+ *
  * A PerfData subtype is not required to provide an implementation for
  * each variability classification. For example, the String type provides
  * Variable and Constant variability classifications in the PerfStringVariable
@@ -428,6 +432,8 @@ class PerfLongVariant : public PerfLong {
     inline void inc(jlong val) { (*(jlong*)_valuep) += val; }
     inline void dec(jlong val) { inc(-val); }
     inline void add(jlong val) { (*(jlong*)_valuep) += val; }
+    // lock-free increment, for counters updated by several threads
+    void atomic_inc(jlong val);
     void clear_sample_helper() { _sample_helper = NULL; }
 };
 
@@ -575,6 +581,67 @@ class PerfStringVariable : public PerfString {
 };
 
 
+/*
+ * The PerfLongHistogram class publishes the distribution of a jlong
+ * sample as a group of scalar Long items, so that clients reading the
+ * PerfData memory region need no support for a new entry type:
+ *
+ *   <name>.base    constant, upper bound of bucket 0
+ *   <name>.count   number of recorded samples
+ *   <name>.sum     sum of the recorded samples
+ *   <name>.<i>     number of samples in [base << (i-1), base << i);
+ *                  bucket 0 holds all samples below base and the
+ *                  last bucket all samples at or above its lower bound.
+ *
+ * record() uses atomic adds, so threads may record concurrently without
+ * a lock. A reader may see the counters of a sample in flight out of
+ * step with each other, which is harmless for a distribution.
+ */
+class PerfLongHistogram : public CHeapObj<mtInternal> {
+
+  friend class PerfDataManager; // for access to private constructor
+
+  private:
+    const jlong       _base;
+    const int         _nof_buckets;
+    PerfLongCounter*  _count;
+    PerfLongCounter*  _sum;
+    PerfLongCounter** _buckets;
+
+    PerfLongHistogram(jlong base, int nof_buckets);
+
+  public:
+    int bucket_for(jlong value) const;
+    void record(jlong value);
+};
+
+/*
+ * The PerfLongRing class publishes the most recent jlong samples:
+ *
+ *   <name>.size      constant, number of slots
+ *   <name>.position  number of samples recorded so far
+ *   <name>.<i>       slot i, holding sample n where n % size == i
+ *
+ * record() writes the slot before it advances the position, so a reader
+ * that loads the position, copies the slots and loads the position again
+ * can tell which slots may have been overwritten meanwhile. Calls to
+ * record() must be serialized by the caller.
+ */
+class PerfLongRing : public CHeapObj<mtInternal> {
+
+  friend class PerfDataManager; // for access to private constructor
+
+  private:
+    const int          _size;
+    PerfLongCounter*   _position;
+    PerfLongVariable** _slots;
+
+    PerfLongRing(int size);
+
+  public:
+    void record(jlong value);
+};
+
 /*
  * The PerfDataList class is a container class for managing lists
  * of PerfData items. The intention of this class is to allow for
@@ -872,6 +939,17 @@ class PerfDataManager : AllStatic {
       return create_long_counter(ns, name, u, sh, THREAD);
     }
 
+    // Composite Types, built from the Long types above
+    static PerfLongHistogram* create_long_histogram(CounterNS ns,
+                                                    const char* name,
+                                                    PerfData::Units u,
+                                                    jlong base,
+                                                    int nof_buckets, TRAPS);
+
+    static PerfLongRing* create_long_ring(CounterNS ns, const char* name,
+                                          PerfData::Units u, int size,
+                                          TRAPS);
+
     static void destroy();
     static bool has_PerfData() { return _has_PerfData; }
 };
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/gcArguments.hpp"
+#include "gc/shared/gc_globals.hpp"
+#include "logging/log.hpp"
+#include "runtime/globals_extension.hpp"
+#include "runtime/os.hpp"
+#include "runtime/resourceLimitWatcher.hpp"
+#include "runtime/task.hpp"
+#include "utilities/align.hpp"
+
+class ResourceLimitWatcherTask : public PeriodicTask {
+ public:
+  ResourceLimitWatcherTask(size_t interval_time) : PeriodicTask(interval_time) {}
+  void task() { ResourceLimitWatcher::check_limits(); }
+};
+
+ResourceLimitWatcherTask* ResourceLimitWatcher::_task = NULL;
+volatile int ResourceLimitWatcher::_active_processor_count = 0;
+volatile julong ResourceLimitWatcher::_physical_memory = 0;
+
+void ResourceLimitWatcher::engage() {
+  _active_processor_count = os::initial_active_processor_count();
+  _physical_memory = os::physical_memory();
+  if (ResourceLimitWatchInterval == 0) {
+    return;
+  }
+  size_t interval = MAX2(align_down(ResourceLimitWatchInterval, (uintx)PeriodicTask::interval_gran),
+                         (uintx)PeriodicTask::min_interval);
+  _task = new ResourceLimitWatcherTask(interval);
+  _task->enroll();
+}
+
+void ResourceLimitWatcher::disengage() {
+  if (_task != NULL) {
+    _task->disenroll();
+    delete _task;
+    _task = NULL;
+  }
+}
+
+int ResourceLimitWatcher::active_processor_count() {
+  int count = _active_processor_count;
+  return count > 0 ? count : os::initial_active_processor_count();
+}
+
+void ResourceLimitWatcher::check_limits() {
+  int processors = os::active_processor_count();
+  if (processors != _active_processor_count) {
+    log_info(os, container)("Active processor count changed from %d to %d",
+                            _active_processor_count, processors);
+    _active_processor_count = processors;
+  }
+
+  julong memory = os::physical_memory();
+  if (memory != _physical_memory) {
+    log_info(os, container)("Physical memory changed from " JULONG_FORMAT "M to " JULONG_FORMAT "M",
+                            _physical_memory / M, memory / M);
+    _physical_memory = memory;
+    update_soft_max_heap_size(memory);
+  }
+}
+
+// Keep the heap the GCs aim for within the share of the memory that the
+// heap would have been given had the VM been started with this limit.
+// SoftMaxHeapSize set on the command line or through management is left
+// alone.
+void ResourceLimitWatcher::update_soft_max_heap_size(julong physical_memory) {
+  if (!FLAG_IS_ERGO(SoftMaxHeapSize)) {
+    return;
+  }
+  julong target = (julong)((double)physical_memory * MaxRAMPercentage / 100);
+  size_t soft_max = (size_t)MIN2(target, (julong)MaxHeapSize);
+  soft_max = MAX2(align_down(soft_max, HeapAlignment), MinHeapSize);
+  if (soft_max != SoftMaxHeapSize) {
+    log_info(os, container)("SoftMaxHeapSize changed from " SIZE_FORMAT "M to " SIZE_FORMAT "M",
+                            SoftMaxHeapSize / M, soft_max / M);
+    FLAG_SET_ERGO(SoftMaxHeapSize, soft_max);
+  }
+}
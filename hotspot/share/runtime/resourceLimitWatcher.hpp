@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_RUNTIME_RESOURCELIMITWATCHER_HPP
+#define SHARE_RUNTIME_RESOURCELIMITWATCHER_HPP
+
+#include "memory/allocation.hpp"
+
+class ResourceLimitWatcherTask;
+
+// The ResourceLimitWatcher periodically re-reads the number of active
+// processors and the size of the physical memory. Inside a container these
+// follow the cgroup limits, which an orchestrator may change while the VM
+// runs. Thread pools size their active part from the last observed processor
+// count and the soft heap target follows the memory limit.
+class ResourceLimitWatcher : AllStatic {
+ private:
+  static ResourceLimitWatcherTask* _task;
+  static volatile int _active_processor_count;
+  static volatile julong _physical_memory;
+
+  static void update_soft_max_heap_size(julong physical_memory);
+
+ public:
+  // Registers the periodic task, called from Threads::create_vm().
+  static void engage();
+  static void disengage();
+
+  // Re-reads the limits and applies the changes.
+  static void check_limits();
+
+  // Processor count as of the last check. Cheap enough to be used on every
+  // sizing decision, unlike os::active_processor_count().
+  static int active_processor_count();
+};
+
+#endif // SHARE_RUNTIME_RESOURCELIMITWATCHER_HPP
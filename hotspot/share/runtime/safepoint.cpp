@@ -24,7 +24,6 @@
 
 #include "precompiled.hpp"
 #include "classfile/classLoaderDataGraph.inline.hpp"
-#include "classfile/dictionary.hpp"
 #include "classfile/stringTable.hpp"
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
@@ -40,6 +39,7 @@
 #include "gc/shared/workgroup.hpp"
 #include "interpreter/interpreter.hpp"
 #include "jfr/jfrEvents.hpp"
+#include "jfr/support/jfrThreadId.hpp"
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
 #include "memory/resourceArea.hpp"
@@ -65,6 +65,7 @@
 #include "runtime/thread.inline.hpp"
 #include "runtime/threadSMR.hpp"
 #include "runtime/timerTrace.hpp"
+#include "runtime/vframe.hpp"
 #include "services/runtimeService.hpp"
 #include "utilities/events.hpp"
 #include "utilities/macros.hpp"
@@ -154,15 +155,15 @@ void SafepointSynchronize::init(Thread* vmthread) {
   SafepointTracing::init();
 }
 
+// Called by the VM thread, or by the safepoint workers examining the
+// thread states in parallel.
 void SafepointSynchronize::increment_jni_active_count() {
-  assert(Thread::current()->is_VM_thread(), "Only VM thread may increment");
-  ++_current_jni_active_count;
+  Atomic::inc(&_current_jni_active_count);
 }
 
 void SafepointSynchronize::decrement_waiting_to_block() {
   assert(_waiting_to_block > 0, "sanity check");
-  assert(Thread::current()->is_VM_thread(), "Only VM thread may decrement");
-  --_waiting_to_block;
+  Atomic::dec(&_waiting_to_block);
 }
 
 bool SafepointSynchronize::thread_not_running(ThreadSafepointState *cur_state) {
@@ -195,6 +196,68 @@ static void assert_list_is_valid(const ThreadSafepointState* tss_head, int still
 }
 #endif // ASSERT
 
+// The threads that took the longest to reach the current safepoint, slowest
+// first. Only used by the VM thread.
+struct SafepointStraggler {
+  JavaThread* _thread;
+  jlong       _time_to_safepoint;
+};
+static const int SafepointStragglerLimit = 4;
+static SafepointStraggler _stragglers[SafepointStragglerLimit];
+static int _nof_stragglers = 0;
+
+static void record_straggler(JavaThread* thread, jlong time_to_safepoint) {
+  int i = MIN2(_nof_stragglers, SafepointStragglerLimit - 1);
+  if (_nof_stragglers == SafepointStragglerLimit &&
+      _stragglers[i]._time_to_safepoint >= time_to_safepoint) {
+    return;
+  }
+  // Threads reach the safepoint in order of time, so the newest is
+  // usually the slowest.
+  for (; i > 0 && _stragglers[i - 1]._time_to_safepoint < time_to_safepoint; i--) {
+    _stragglers[i] = _stragglers[i - 1];
+  }
+  _stragglers[i]._thread = thread;
+  _stragglers[i]._time_to_safepoint = time_to_safepoint;
+  _nof_stragglers = MIN2(_nof_stragglers + 1, SafepointStragglerLimit);
+}
+
+// Examines the states of all threads for the first pass of
+// synchronize_threads(), in chunks claimed by the workers.
+class ParallelSafepointSyncTask : public AbstractGangTask {
+private:
+  ThreadsList* _list;
+  volatile uint _claimed;
+
+public:
+  ParallelSafepointSyncTask(ThreadsList* list) :
+    AbstractGangTask("Parallel Safepoint Synchronization"),
+    _list(list),
+    _claimed(0) {}
+
+  void work(uint worker_id) {
+    const uint chunk = 32;
+    const uint length = _list->length();
+    while (true) {
+      uint start = Atomic::add(chunk, &_claimed) - chunk;
+      if (start >= length) {
+        break;
+      }
+      uint end = MIN2(start + chunk, length);
+      for (uint i = start; i < end; i++) {
+        SafepointSynchronize::thread_not_running(_list->thread_at(i)->safepoint_state());
+      }
+    }
+  }
+};
+
+static WorkGang* parallel_sync_workers(int nof_threads) {
+  if (ParallelSafepointSyncThreshold == 0 || (uintx)nof_threads < ParallelSafepointSyncThreshold) {
+    return NULL;
+  }
+  return Universe::heap()->get_safepoint_workers();
+}
+
 static void back_off(int64_t start_time) {
   // We start with fine-grained nanosleeping until a millisecond has
   // passed, at which point we resort to plain naked_short_sleep.
@@ -216,6 +279,17 @@ int SafepointSynchronize::synchronize_threads(jlong safepoint_limit_time, int no
   jtiwh.rewind();
 #endif // ASSERT
 
+  _nof_stragglers = 0;
+
+  // With many threads, most of the time goes to examining the ones that
+  // are already safe. Let the safepoint workers do that first, the pass
+  // below then only has to re-examine the threads they found running.
+  WorkGang* sync_workers = parallel_sync_workers(nof_threads);
+  if (sync_workers != NULL) {
+    ParallelSafepointSyncTask task(jtiwh.list());
+    sync_workers->run_task(&task);
+  }
+
   // Iterate through all threads until it has been determined how to stop them all at a safepoint.
   int still_running = nof_threads;
   ThreadSafepointState *tss_head = NULL;
@@ -260,10 +334,12 @@ int SafepointSynchronize::synchronize_threads(jlong safepoint_limit_time, int no
 
     p_prev = &tss_head;
     ThreadSafepointState *cur_tss = tss_head;
+    const jlong time_to_safepoint = os::javaTimeNanos() - SafepointTracing::start_of_safepoint();
     while (cur_tss != NULL) {
       assert(cur_tss->is_running(), "Illegal initial state");
       if (thread_not_running(cur_tss)) {
         --still_running;
+        record_straggler(cur_tss->thread(), time_to_safepoint);
         *p_prev = NULL;
         ThreadSafepointState *tmp = cur_tss;
         cur_tss = cur_tss->get_next();
@@ -289,6 +365,45 @@ int SafepointSynchronize::synchronize_threads(jlong safepoint_limit_time, int no
   return iterations;
 }
 
+// Names the threads that were slowest to reach the safepoint, and where
+// they stopped. A thread that keeps showing up with a large time is
+// usually running a loop without a safepoint poll ending near that frame.
+void SafepointSynchronize::report_stragglers() {
+  LogTarget(Info, safepoint) lt;
+  if (_nof_stragglers == 0 || (!lt.is_enabled() && !EventSafepointStraggler::is_enabled())) {
+    return;
+  }
+  ResourceMark rm;
+  LogStream ls(lt);
+  for (int i = 0; i < _nof_stragglers; i++) {
+    JavaThread* thread = _stragglers[i]._thread;
+    Method* method = NULL;
+    int bci = -1;
+    if (thread->has_last_Java_frame()) {
+      RegisterMap map(thread, false);
+      javaVFrame* jvf = thread->last_java_vframe(&map);
+      if (jvf != NULL) {
+        method = jvf->method();
+        bci = jvf->bci();
+      }
+    }
+    if (lt.is_enabled()) {
+      ls.print_cr("Time to safepoint of \"%s\": " JLONG_FORMAT " ns, at %s @ %d",
+                  thread->get_thread_name(), _stragglers[i]._time_to_safepoint,
+                  method != NULL ? method->name_and_sig_as_C_string() : "<no Java frame>", bci);
+    }
+    EventSafepointStraggler event;
+    if (event.should_commit()) {
+      event.set_safepointId(_safepoint_id);
+      event.set_javaThread(JFR_THREAD_ID(thread));
+      event.set_timeToSafepoint(_stragglers[i]._time_to_safepoint);
+      event.set_method(method);
+      event.set_bci(bci);
+      event.commit();
+    }
+  }
+}
+
 void SafepointSynchronize::arm_safepoint() {
   // Begin the process of bringing the system to a safepoint.
   // Java threads can be in several different states and are
@@ -439,6 +554,8 @@ void SafepointSynchronize::begin() {
 
   SafepointTracing::synchronized(nof_threads, initial_running, _nof_threads_hit_polling_page);
 
+  report_stragglers();
+
   // We do the safepoint cleanup first since a GC related safepoint
   // needs cleanup to be completed before running the GC op.
   EventSafepointCleanup cleanup_event;
@@ -568,9 +685,10 @@ public:
 
   void work(uint worker_id) {
     uint64_t safepoint_id = SafepointSynchronize::safepoint_id();
-    // All threads deflate monitors and mark nmethods (if necessary).
-    Threads::possibly_parallel_threads_do(true, &_cleanup_threads_cl);
 
+    // The subtasks below each run on a single worker, and some of them
+    // can take long. Claim them first, so that they overlap with the
+    // other workers walking the threads instead of starting after it.
     if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_DEFLATE_MONITORS)) {
       const char* name = "deflating global idle monitors";
       EventSafepointCleanupTask event;
@@ -633,23 +751,15 @@ public:
       }
     }
 
-    if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_SYSTEM_DICTIONARY_RESIZE)) {
-      if (Dictionary::does_any_dictionary_needs_resizing()) {
-        const char* name = "resizing system dictionaries";
-        EventSafepointCleanupTask event;
-        TraceTime timer(name, TRACETIME_LOG(Info, safepoint, cleanup));
-        ClassLoaderDataGraph::resize_dictionaries();
-
-        post_safepoint_cleanup_task_event(event, safepoint_id, name);
-      }
-    }
-
     if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_REQUEST_OOPSTORAGE_CLEANUP)) {
       // Don't bother reporting event or time for this very short operation.
       // To have any utility we'd also want to report whether needed.
       OopStorage::trigger_cleanup_if_needed();
     }
 
+    // All threads deflate monitors and mark nmethods (if necessary).
+    Threads::possibly_parallel_threads_do(true, &_cleanup_threads_cl);
+
     _subtasks.all_tasks_completed(_num_workers);
   }
 };
@@ -1172,6 +1282,7 @@ VM_Operation::VMOp_Type SafepointTracing::_current_type;
 jlong     SafepointTracing::_max_sync_time = 0;
 jlong     SafepointTracing::_max_vmop_time = 0;
 uint64_t  SafepointTracing::_op_count[VM_Operation::VMOp_Terminating] = {0};
+SafepointTracing::OpStatistics SafepointTracing::_op_stats[VM_Operation::VMOp_Terminating];
 
 void SafepointTracing::init() {
   // Application start
@@ -1248,6 +1359,74 @@ void SafepointTracing::statistics_exit_log() {
                               (int64_t)(_max_vmop_time));
 }
 
+int SafepointTracing::time_bucket(jlong ns) {
+  jlong limit = 10 * (NANOUNITS / MICROUNITS);
+  int bucket = 0;
+  while (bucket < nof_time_buckets - 1 && ns >= limit) {
+    limit *= 10;
+    bucket++;
+  }
+  return bucket;
+}
+
+const char* SafepointTracing::time_bucket_name(int bucket) {
+  static const char* const names[nof_time_buckets] = {
+    "lt10us", "lt100us", "lt1ms", "lt10ms", "lt100ms", "lt1s", "ge1s"
+  };
+  assert(bucket >= 0 && bucket < nof_time_buckets, "invalid bucket %d", bucket);
+  return names[bucket];
+}
+
+void SafepointTracing::PhaseStatistics::record(jlong ns) {
+  _count++;
+  _total_ns += ns;
+  if (_max_ns < ns) {
+    _max_ns = ns;
+  }
+  _histogram[time_bucket(ns)]++;
+}
+
+void SafepointTracing::PhaseStatistics::print_on(outputStream* st, const char* op_name, const char* phase) const {
+  if (_count == 0) {
+    return;
+  }
+  const jlong ns_per_us = NANOUNITS / MICROUNITS;
+  st->print("%-28s %-12s " UINT64_FORMAT_W(8) " " INT64_FORMAT_W(12) " " INT64_FORMAT_W(10) " " INT64_FORMAT_W(10),
+            op_name, phase, _count,
+            (int64_t)(_total_ns / ns_per_us),
+            (int64_t)(_total_ns / (jlong)_count / ns_per_us),
+            (int64_t)(_max_ns / ns_per_us));
+  for (int i = 0; i < nof_time_buckets; i++) {
+    st->print(" " UINT64_FORMAT_W(8), _histogram[i]);
+  }
+  st->cr();
+}
+
+void SafepointTracing::record_vm_operation(VM_Operation::VMOp_Type type, jlong vmop_ns) {
+  _op_stats[type]._no_safepoint.record(vmop_ns);
+}
+
+void SafepointTracing::print_statistics(outputStream* st) {
+  st->print("%-28s %-12s %8s %12s %10s %10s", "VM Operation", "phase", "count",
+            "total(us)", "avg(us)", "max(us)");
+  for (int i = 0; i < nof_time_buckets; i++) {
+    st->print(" %8s", time_bucket_name(i));
+  }
+  st->cr();
+
+  for (int index = 0; index < VM_Operation::VMOp_Terminating; index++) {
+    // Copy first, the VM thread keeps updating the live table.
+    const OpStatistics stats = _op_stats[index];
+    const char* name = VM_Operation::name(index);
+    stats._sync.print_on(st, name, "sync");
+    stats._cleanup.print_on(st, name, "cleanup");
+    stats._vmop.print_on(st, name, "vmop");
+    stats._no_safepoint.print_on(st, name, "no_safepoint");
+  }
+  st->print_cr("VM operations coalesced during safepoint " INT64_FORMAT,
+               VMThread::get_coalesced_count());
+}
+
 void SafepointTracing::begin(VM_Operation::VMOp_Type type) {
   _op_count[type]++;
   _current_type = type;
@@ -1286,6 +1465,11 @@ void SafepointTracing::end() {
   if (_max_vmop_time < (_last_safepoint_end_time_ns - _last_safepoint_sync_time_ns)) {
     _max_vmop_time = _last_safepoint_end_time_ns - _last_safepoint_sync_time_ns;
   }
+
+  OpStatistics& stats = _op_stats[_current_type];
+  stats._sync.record(_last_safepoint_sync_time_ns - _last_safepoint_begin_time_ns);
+  stats._cleanup.record(_last_safepoint_cleanup_time_ns - _last_safepoint_sync_time_ns);
+  stats._vmop.record(_last_safepoint_end_time_ns - _last_safepoint_cleanup_time_ns);
   if (log_is_enabled(Info, safepoint, stats)) {
     statistics_log();
   }
@@ -1304,4 +1488,6 @@ void SafepointTracing::end() {
      );
 
   RuntimeService::record_safepoint_end(_last_safepoint_end_time_ns - _last_safepoint_cleanup_time_ns);
+  RuntimeService::record_safepoint_pause(_last_safepoint_cleanup_time_ns - _last_safepoint_sync_time_ns,
+                                         _last_safepoint_end_time_ns - _last_safepoint_begin_time_ns);
 }
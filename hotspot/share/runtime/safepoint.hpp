@@ -76,7 +76,6 @@ class SafepointSynchronize : AllStatic {
     SAFEPOINT_CLEANUP_SYMBOL_TABLE_REHASH,
     SAFEPOINT_CLEANUP_STRING_TABLE_REHASH,
     SAFEPOINT_CLEANUP_CLD_PURGE,
-    SAFEPOINT_CLEANUP_SYSTEM_DICTIONARY_RESIZE,
     SAFEPOINT_CLEANUP_REQUEST_OOPSTORAGE_CLEANUP,
     // Leave this one last.
     SAFEPOINT_CLEANUP_NUM_TASKS
@@ -87,6 +86,7 @@ class SafepointSynchronize : AllStatic {
   friend class ThreadSafepointState;
   friend class HandshakeState;
   friend class SafepointStateTracker;
+  friend class ParallelSafepointSyncTask;
 
   // Threads might read this flag directly, without acquiring the Threads_lock:
   static volatile SynchronizeState _state;
@@ -126,6 +126,7 @@ class SafepointSynchronize : AllStatic {
   // Helper methods for safepoint procedure:
   static void arm_safepoint();
   static int synchronize_threads(jlong safepoint_limit_time, int nof_threads, int* initial_running);
+  static void report_stragglers();
   static void disarm_safepoint();
   static void increment_jni_active_count();
   static void decrement_waiting_to_block();
@@ -221,7 +222,7 @@ class ThreadSafepointState: public CHeapObj<mtThread> {
 
   void account_safe_thread();
 
- public:
+public:
   ThreadSafepointState(JavaThread *thread);
 
   // Linked list support:
@@ -279,6 +280,30 @@ private:
   static jlong     _max_vmop_time;
   static uint64_t  _op_count[VM_Operation::VMOp_Terminating];
 
+public:
+  // Pause times are bucketed by decade, starting at 10 us.
+  enum { nof_time_buckets = 7 };
+
+private:
+  struct PhaseStatistics {
+    uint64_t _count;
+    jlong    _total_ns;
+    jlong    _max_ns;
+    uint64_t _histogram[nof_time_buckets];
+
+    void record(jlong ns);
+    void print_on(outputStream* st, const char* op_name, const char* phase) const;
+  };
+
+  // Per VM operation type costs, reported by the VM.safepoint_stats diagnostic command.
+  struct OpStatistics {
+    PhaseStatistics _sync;
+    PhaseStatistics _cleanup;
+    PhaseStatistics _vmop;
+    PhaseStatistics _no_safepoint;  // operations evaluated without a safepoint
+  };
+  static OpStatistics _op_stats[VM_Operation::VMOp_Terminating];
+
   static void statistics_log();
 
 public:
@@ -291,6 +316,15 @@ public:
 
   static void statistics_exit_log();
 
+  // Records a VM operation that was evaluated without bringing the VM to a safepoint.
+  static void record_vm_operation(VM_Operation::VMOp_Type type, jlong vmop_ns);
+  // Prints the per VM operation type time histograms. Called outside of a safepoint,
+  // so the numbers of an operation recorded concurrently may be slightly skewed.
+  static void print_statistics(outputStream* st);
+
+  static int time_bucket(jlong ns);
+  static const char* time_bucket_name(int bucket);
+
   static jlong time_since_last_safepoint_ms() {
     return (os::javaTimeNanos() - _last_safepoint_end_time_ns) / (NANOUNITS / MILLIUNITS);
   }
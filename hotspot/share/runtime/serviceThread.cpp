@@ -27,6 +27,7 @@
 #include "classfile/stringTable.hpp"
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "memory/universe.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
@@ -35,6 +36,7 @@
 #include "runtime/serviceThread.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
+#include "runtime/synchronizer.hpp"
 #include "prims/jvmtiImpl.hpp"
 #include "prims/resolvedMethodTable.hpp"
 #include "services/diagnosticArgument.hpp"
@@ -43,6 +45,7 @@
 #include "services/lowMemoryDetector.hpp"
 
 ServiceThread* ServiceThread::_instance = NULL;
+WorkGang* ServiceThread::_workers = NULL;
 
 void ServiceThread::initialize() {
   EXCEPTION_MARK;
@@ -108,6 +111,7 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
     bool resolved_method_table_work = false;
     bool protection_domain_table_work = false;
     bool oopstorage_work = false;
+    bool async_deflate_work = false;
     JvmtiDeferredEvent jvmti_event;
     {
       // Need state transition ThreadBlockInVM so that this thread
@@ -133,10 +137,13 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
               (symboltable_work = SymbolTable::has_work()) |
               (resolved_method_table_work = ResolvedMethodTable::has_work()) |
               (protection_domain_table_work = SystemDictionary::pd_cache_table()->has_work()) |
-              (oopstorage_work = OopStorage::has_cleanup_work_and_reset()))
+              (oopstorage_work = OopStorage::has_cleanup_work_and_reset()) |
+              (async_deflate_work = ObjectSynchronizer::is_async_deflation_needed()))
              == 0) {
-        // Wait until notified that there is some work to do.
-        ml.wait();
+        // Wait until notified that there is some work to do. With concurrent
+        // monitor deflation, also wake up periodically to check whether the
+        // monitor usage or MonitorBound calls for a deflation cycle.
+        ml.wait(AsyncDeflateIdleMonitors ? ObjectSynchronizer::async_deflation_wait_ms() : 0);
       }
 
       if (has_jvmti_events) {
@@ -179,9 +186,38 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
     if (oopstorage_work) {
       cleanup_oopstorages(oopstorages, oopstorage_count);
     }
+
+    if (async_deflate_work) {
+      ObjectSynchronizer::deflate_idle_monitors_using_JT();
+    }
   }
 }
 
 bool ServiceThread::is_service_thread(Thread* thread) {
   return thread == _instance;
 }
+
+WorkGang* ServiceThread::table_workers(size_t table_size) {
+  assert(is_service_thread(Thread::current()), "only the service thread uses its workers");
+  // Tables are split into ranges of 4096 buckets, smaller tables are done
+  // faster than the workers can be woken up.
+  if (table_size < 16 * K) {
+    return NULL;
+  }
+  if (_workers == NULL) {
+    uint num_workers = ServiceThreadWorkers;
+    if (num_workers == 0) {
+      // One worker per four processors, a little parallelism is enough to
+      // keep up with the mutators filling the tables.
+      num_workers = MIN2(MAX2(1u, (uint)os::initial_active_processor_count() / 4), 8u);
+    }
+    if (num_workers <= 1) {
+      return NULL;
+    }
+    _workers = new WorkGang("Service Worker", num_workers,
+                            false /* are_GC_task_threads */,
+                            false /* are_ConcurrentGC_threads */);
+    _workers->initialize_workers();
+  }
+  return _workers;
+}
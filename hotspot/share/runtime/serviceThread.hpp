@@ -27,6 +27,8 @@
 
 #include "runtime/thread.hpp"
 
+class WorkGang;
+
 // A JavaThread for low memory detection support and JVMTI
 // compiled-method-load events.
 class ServiceThread : public JavaThread {
@@ -34,6 +36,7 @@ class ServiceThread : public JavaThread {
  private:
 
   static ServiceThread* _instance;
+  static WorkGang* _workers;
 
   static void service_thread_entry(JavaThread* thread, TRAPS);
   ServiceThread(ThreadFunction entry_point) : JavaThread(entry_point) {};
@@ -46,6 +49,11 @@ class ServiceThread : public JavaThread {
 
   // Returns true if the passed thread is the service thread.
   static bool is_service_thread(Thread* thread);
+
+  // Workers the service thread uses to grow and clean a concurrent hash
+  // table of table_size buckets in parallel, created on first use. Returns
+  // NULL if the work should be done by the service thread alone.
+  static WorkGang* table_workers(size_t table_size);
 };
 
 #endif // SHARE_RUNTIME_SERVICETHREAD_HPP
@@ -151,6 +151,12 @@ address StubRoutines::_montgomerySquare = NULL;
 
 address StubRoutines::_vectorizedMismatch = NULL;
 
+address StubRoutines::_vectorizedHashCode_boolean = NULL;
+address StubRoutines::_vectorizedHashCode_byte = NULL;
+address StubRoutines::_vectorizedHashCode_char = NULL;
+address StubRoutines::_vectorizedHashCode_short = NULL;
+address StubRoutines::_vectorizedHashCode_int = NULL;
+
 address StubRoutines::_dexp = NULL;
 address StubRoutines::_dlog = NULL;
 address StubRoutines::_dlog10 = NULL;
@@ -496,6 +502,18 @@ address StubRoutines::select_fill_function(BasicType t, bool aligned, const char
 #undef RETURN_STUB
 }
 
+// T_BOOLEAN stands for bytes hashed as unsigned values, as in Latin1 strings.
+address StubRoutines::vectorizedHashCode(BasicType elem_type) {
+  switch (elem_type) {
+  case T_BOOLEAN: return _vectorizedHashCode_boolean;
+  case T_BYTE:    return _vectorizedHashCode_byte;
+  case T_CHAR:    return _vectorizedHashCode_char;
+  case T_SHORT:   return _vectorizedHashCode_short;
+  case T_INT:     return _vectorizedHashCode_int;
+  default:        return NULL;
+  }
+}
+
 // constants for computing the copy function
 enum {
   COPYFUNC_UNALIGNED = 0,
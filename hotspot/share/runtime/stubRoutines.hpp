@@ -191,6 +191,13 @@ class StubRoutines: AllStatic {
 
   static address _vectorizedMismatch;
 
+  // Polynomial hash code stubs, by element type
+  static address _vectorizedHashCode_boolean; // unsigned bytes
+  static address _vectorizedHashCode_byte;
+  static address _vectorizedHashCode_char;
+  static address _vectorizedHashCode_short;
+  static address _vectorizedHashCode_int;
+
   static address _dexp;
   static address _dlog;
   static address _dlog10;
@@ -352,6 +359,7 @@ class StubRoutines: AllStatic {
   static address montgomerySquare()    { return _montgomerySquare; }
 
   static address vectorizedMismatch()  { return _vectorizedMismatch; }
+  static address vectorizedHashCode(BasicType elem_type);
 
   static address dexp()                { return _dexp; }
   static address dlog()                { return _dlog; }
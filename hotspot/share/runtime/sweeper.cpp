@@ -28,6 +28,8 @@
 #include "code/icBuffer.hpp"
 #include "code/nmethod.hpp"
 #include "compiler/compileBroker.hpp"
+#include "gc/shared/barrierSet.hpp"
+#include "gc/shared/barrierSetNMethod.hpp"
 #include "gc/shared/collectedHeap.hpp"
 #include "gc/shared/workgroup.hpp"
 #include "jfr/jfrEvents.hpp"
@@ -298,6 +300,13 @@ CodeBlobClosure* NMethodSweeper::prepare_reset_hotness_counters() {
   // Increase time so that we can estimate when to invoke the sweeper again.
   _time_counter++;
 
+  // The entry barriers reset the hotness counters of the nmethods that are
+  // used, see possibly_flush(). Only the stack scans of the sweeper itself
+  // are still needed, to find the activations of not-entrant nmethods.
+  if (SweepUsingEntryBarriers) {
+    return NULL;
+  }
+
   // Check for restart
   if (_current.method() != NULL) {
     if (_current.method()->is_nmethod()) {
@@ -755,6 +764,10 @@ void NMethodSweeper::possibly_flush(nmethod* nm) {
 
       // Do not make native methods not-entrant
       nm->dec_hotness_counter();
+      if (SweepUsingEntryBarriers) {
+        // The next entry disarms the nmethod again and resets its hotness counter.
+        BarrierSet::barrier_set()->barrier_set_nmethod()->arm(nm);
+      }
       // Get the initial value of the hotness counter. This value depends on the
       // ReservedCodeCacheSize
       int reset_val = hotness_counter_reset_val();
@@ -56,6 +56,10 @@ class CodeBlobClosure;
 //     cleared. After that, the nmethod can be evicted from the code cache. Each nmethod's
 //     state change happens during separate sweeps. It may take at least 3 sweeps before an
 //     nmethod's space is freed.
+// The hotness counters of the nmethods are reset when they are found on a stack at a
+// safepoint. With SweepUsingEntryBarriers, the sweeper instead arms the entry barrier
+// of each nmethod it visits, and the next entry resets the counter, so that safepoints
+// do not have to scan the stacks.
 
 class NMethodSweeper : public AllStatic {
  private:
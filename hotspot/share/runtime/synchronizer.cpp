@@ -37,12 +37,15 @@
 #include "runtime/atomic.hpp"
 #include "runtime/biasedLocking.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/objectMonitor.hpp"
 #include "runtime/objectMonitor.inline.hpp"
 #include "runtime/osThread.hpp"
+#include "runtime/safepointMechanism.inline.hpp"
 #include "runtime/safepointVerifiers.hpp"
+#include "runtime/serviceThread.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/stubRoutines.hpp"
 #include "runtime/synchronizer.hpp"
@@ -126,10 +129,15 @@ ObjectMonitor * volatile ObjectSynchronizer::gOmInUseList  = NULL;
 // count of entries in gOmInUseList
 int ObjectSynchronizer::gOmInUseCount = 0;
 
-static volatile intptr_t gListLock = 0;      // protects global monitor lists
+static volatile intptr_t gListLock = 0;      // serializes removal from gFreeList
+                                             // and protects gOmInUseList
 static volatile int gMonitorFreeCount  = 0;  // # on gFreeList
 static volatile int gMonitorPopulation = 0;  // # Extant -- in circulation
 
+// Concurrent deflation by the ServiceThread, see deflate_idle_monitors_using_JT()
+static volatile bool gAsyncDeflationRequested = false;
+static jlong gLastAsyncDeflationTimeNs = 0;  // only used by the ServiceThread
+
 #define CHAINMARKER (cast_to_oop<intptr_t>(-1))
 
 
@@ -171,7 +179,8 @@ bool ObjectSynchronizer::quick_notify(oopDesc * obj, Thread * self, bool all) {
 
   if (mark->has_monitor()) {
     ObjectMonitor * const mon = mark->monitor();
-    assert(oopDesc::equals((oop) mon->object(), obj), "invariant");
+    assert(oopDesc::equals((oop) mon->object(), obj) ||
+           mon->is_being_async_deflated(), "invariant");
     if (mon->owner() != self) return false;  // slow-path for IMS exception
 
     if (mon->first_waiter() != NULL) {
@@ -215,7 +224,10 @@ bool ObjectSynchronizer::quick_enter(oop obj, Thread * Self,
 
   if (mark->has_monitor()) {
     ObjectMonitor * const m = mark->monitor();
-    assert(oopDesc::equals((oop) m->object(), obj), "invariant");
+    // A monitor that is being deflated concurrently is owned by the
+    // ServiceThread, so we take the slow-path below.
+    assert(oopDesc::equals((oop) m->object(), obj) ||
+           m->is_being_async_deflated(), "invariant");
     Thread * const owner = (Thread *) m->_owner;
 
     // Lock contention and Transactional Lock Elision (TLE) diagnostics
@@ -359,7 +371,10 @@ void ObjectSynchronizer::slow_enter(Handle obj, BasicLock* lock, TRAPS) {
   // must be non-zero to avoid looking like a re-entrant lock,
   // and must not look locked either.
   lock->set_displaced_header(markOopDesc::unused_mark());
-  inflate(THREAD, obj(), inflate_cause_monitor_enter)->enter(THREAD);
+  // enter() fails if the monitor was deflated concurrently; retry
+  // with the monitor that inflate() installs next.
+  while (!inflate(THREAD, obj(), inflate_cause_monitor_enter)->enter(THREAD)) {
+  }
 }
 
 // This routine is used to handle interpreter/compiler slow case
@@ -400,9 +415,10 @@ void ObjectSynchronizer::reenter(Handle obj, intptr_t recursion, TRAPS) {
     assert(!obj->mark()->has_bias_pattern(), "biases should be revoked by now");
   }
 
-  ObjectMonitor* monitor = inflate(THREAD, obj(), inflate_cause_vm_internal);
-
-  monitor->reenter(recursion, THREAD);
+  // reenter() fails if the monitor was deflated concurrently; retry
+  // with the monitor that inflate() installs next.
+  while (!inflate(THREAD, obj(), inflate_cause_vm_internal)->reenter(recursion, THREAD)) {
+  }
 }
 // -----------------------------------------------------------------------------
 // JNI locks on java objects
@@ -414,7 +430,8 @@ void ObjectSynchronizer::jni_enter(Handle obj, TRAPS) {
     assert(!obj->mark()->has_bias_pattern(), "biases should be revoked by now");
   }
   THREAD->set_current_pending_monitor_is_from_java(false);
-  inflate(THREAD, obj(), inflate_cause_jni_enter)->enter(THREAD);
+  while (!inflate(THREAD, obj(), inflate_cause_jni_enter)->enter(THREAD)) {
+  }
   THREAD->set_current_pending_monitor_is_from_java(true);
 }
 
@@ -737,7 +754,16 @@ intptr_t ObjectSynchronizer::FastHashCode(Thread * Self, oop obj) {
     assert(temp->is_neutral(), "invariant: header=" INTPTR_FORMAT, p2i(temp));
     hash = temp->hash();
     if (hash != 0) {
-      return hash;
+      // The hash might have just been merged into the header of a monitor
+      // that is being deflated concurrently, after the deflater restored
+      // the object's header. Order the read of the header before the
+      // check; see the async deflation check below.
+      OrderAccess::loadload();
+      if (!monitor->is_being_async_deflated()) {
+        return hash;
+      }
+      monitor->install_displaced_markword_in_object();
+      return FastHashCode(Self, obj);
     }
     // Skip to the following code to reduce code size
   } else if (Self->is_lock_owned((address)mark->locker())) {
@@ -777,6 +803,14 @@ intptr_t ObjectSynchronizer::FastHashCode(Thread * Self, oop obj) {
       assert(hash != 0, "Trivial unexpected object/monitor header usage.");
     }
   }
+  // The monitor may have been deflated by the ServiceThread while we were
+  // using it, in which case the hash may not have made it into the object's
+  // restored header. Retry from the object's header.
+  OrderAccess::loadload();
+  if (monitor->is_being_async_deflated()) {
+    monitor->install_displaced_markword_in_object();
+    return FastHashCode(Self, obj);
+  }
   // We finally get the hash
   return hash;
 }
@@ -936,6 +970,10 @@ static bool monitors_used_above_threshold() {
 }
 
 bool ObjectSynchronizer::is_cleanup_needed() {
+  if (AsyncDeflateIdleMonitors) {
+    // Idle monitors are deflated by the ServiceThread without a safepoint.
+    return false;
+  }
   if (MonitorUsedDeflationThreshold > 0) {
     return monitors_used_above_threshold();
   }
@@ -973,12 +1011,17 @@ void ObjectSynchronizer::list_oops_do(ObjectMonitor* list, OopClosure* f) {
 // ObjectMonitor Lifecycle
 // -----------------------
 // Inflation unlinks monitors from the global gFreeList and
-// associates them with objects.  Deflation -- which occurs at
-// STW-time -- disassociates idle monitors from objects.  Such
-// scavenged monitors are returned to the gFreeList.
+// associates them with objects.  Deflation disassociates idle monitors
+// from objects.  Such scavenged monitors are returned to the gFreeList.
+// Deflation occurs at STW-time or, with AsyncDeflateIdleMonitors,
+// concurrently in the ServiceThread; see deflate_idle_monitors_using_JT().
 //
-// The global list is protected by gListLock.  All the critical sections
-// are short and operate in constant-time.
+// Monitors are prepended to the global free list with a lock-free CAS,
+// so deflation and omFlush() never wait for gListLock.  Removal from the
+// free list is serialized by gListLock: with a single remover at a time
+// the head of the list can not be popped and pushed back between reading
+// it and the CAS that unlinks it, which rules out ABA.  The critical
+// sections are short and operate in constant-time.
 //
 // ObjectMonitors reside in type-stable memory (TSM) and are immortal.
 //
@@ -1013,6 +1056,14 @@ static void InduceScavenge(Thread * Self, const char * Whence) {
   // TODO: assert thread state is reasonable
 
   if (ForceMonitorScavenge == 0 && Atomic::xchg (1, &ForceMonitorScavenge) == 0) {
+    if (AsyncDeflateIdleMonitors) {
+      // No safepoint needed; the ServiceThread picks up the request on
+      // its next periodic check, see async_deflation_wait_ms().  We don't
+      // notify Service_lock here as callers of omAlloc() may hold locks of
+      // arbitrary rank.
+      gAsyncDeflationRequested = true;
+      return;
+    }
     // Induce a 'null' safepoint to scavenge monitors
     // Must VM_Operation instance be heap allocated as the op will be enqueue and posted
     // to the VMthread and have a lifespan longer than that of this activation record.
@@ -1021,6 +1072,50 @@ static void InduceScavenge(Thread * Self, const char * Whence) {
   }
 }
 
+// Prepend the null-terminated list [head, tail] of 'count' free monitors
+// to gFreeList.  Lock-free, see the ObjectMonitor Lifecycle comment above.
+void ObjectSynchronizer::prepend_to_free_list(ObjectMonitor* head,
+                                              ObjectMonitor* tail,
+                                              int count) {
+  assert(tail->FreeNext == NULL, "list must be null-terminated");
+  for (;;) {
+    ObjectMonitor* cur = OrderAccess::load_acquire(&gFreeList);
+    tail->FreeNext = cur;
+    if (Atomic::cmpxchg(head, &gFreeList, cur) == cur) {
+      break;
+    }
+  }
+  Atomic::add(count, &gMonitorFreeCount);
+}
+
+// Unlink up to 'max' monitors from the front of gFreeList and return them
+// as a null-terminated list; the number of monitors is returned in 'count'.
+// The caller must hold gListLock.
+ObjectMonitor* ObjectSynchronizer::take_from_free_list(int max, int* count) {
+  for (;;) {
+    ObjectMonitor* head = OrderAccess::load_acquire(&gFreeList);
+    if (head == NULL) {
+      *count = 0;
+      return NULL;
+    }
+    // Only the holder of gListLock unlinks monitors, so the monitors
+    // following the head are stable; concurrent prepends only ever
+    // change the head itself.
+    ObjectMonitor* tail = head;
+    int n = 1;
+    while (n < max && tail->FreeNext != NULL) {
+      tail = tail->FreeNext;
+      n++;
+    }
+    if (Atomic::cmpxchg(tail->FreeNext, &gFreeList, head) == head) {
+      tail->FreeNext = NULL;
+      Atomic::sub(n, &gMonitorFreeCount);
+      *count = n;
+      return head;
+    }
+  }
+}
+
 ObjectMonitor* ObjectSynchronizer::omAlloc(Thread * Self) {
   // A large MAXPRIVATE value reduces both list lock contention
   // and list coherency traffic, but also tends to increase the
@@ -1050,24 +1145,24 @@ ObjectMonitor* ObjectSynchronizer::omAlloc(Thread * Self) {
     }
 
     // 2: try to allocate from the global gFreeList
-    // CONSIDER: use muxTry() instead of muxAcquire().
-    // If the muxTry() fails then drop immediately into case 3.
     // If we're using thread-local free lists then try
     // to reprovision the caller's free list.
     if (gFreeList != NULL) {
       // Reprovision the thread's omFreeList.
       // Use bulk transfers to reduce the allocation rate and heat
-      // on various locks.
+      // on various locks.  The batch is unlinked with a single CAS and
+      // moved to the thread's list after gListLock has been dropped.
+      int count;
       Thread::muxAcquire(&gListLock, "omAlloc(1)");
-      for (int i = Self->omFreeProvision; --i >= 0 && gFreeList != NULL;) {
-        gMonitorFreeCount--;
-        ObjectMonitor * take = gFreeList;
-        gFreeList = take->FreeNext;
+      ObjectMonitor * list = take_from_free_list(Self->omFreeProvision, &count);
+      Thread::muxRelease(&gListLock);
+      while (list != NULL) {
+        ObjectMonitor * take = list;
+        list = take->FreeNext;
         guarantee(take->object() == NULL, "invariant");
         take->Recycle();
         omRelease(Self, take, false);
       }
-      Thread::muxRelease(&gListLock);
       Self->omFreeProvision += 1 + (Self->omFreeProvision/2);
       if (Self->omFreeProvision > MAXPRIVATE) Self->omFreeProvision = MAXPRIVATE;
 
@@ -1125,28 +1220,35 @@ ObjectMonitor* ObjectSynchronizer::omAlloc(Thread * Self) {
     // Element [0] is reserved for global list linkage
     temp[0].set_object(CHAINMARKER);
 
-    // Consider carving out this thread's current request from the
-    // block in hand.  This avoids some lock traffic and redundant
-    // list activity.
-
-    // Acquire the gListLock to manipulate gBlockList and gFreeList.
-    // An Oyama-Taura-Yonezawa scheme might be more efficient.
-    Thread::muxAcquire(&gListLock, "omAlloc(2)");
-    gMonitorPopulation += _BLOCKSIZE-1;
-    gMonitorFreeCount += _BLOCKSIZE-1;
+    Atomic::add(_BLOCKSIZE - 1, &gMonitorPopulation);
 
     // Add the new block to the list of extant blocks (gBlockList).
     // The very first objectMonitor in a block is reserved and dedicated.
-    // It serves as blocklist "next" linkage.
-    temp[0].FreeNext = gBlockList;
-    // There are lock-free uses of gBlockList so make sure that
-    // the previous stores happen before we update gBlockList.
-    OrderAccess::release_store(&gBlockList, temp);
-
-    // Add the new string of objectMonitors to the global free list
-    temp[_BLOCKSIZE - 1].FreeNext = gFreeList;
-    gFreeList = temp + 1;
-    Thread::muxRelease(&gListLock);
+    // It serves as blocklist "next" linkage.  Blocks are only ever
+    // added, so a plain CAS push is sufficient.  The CAS also makes
+    // sure that the previous stores happen before gBlockList is updated,
+    // as there are lock-free uses of gBlockList.
+    for (;;) {
+      PaddedEnd<ObjectMonitor> * cur = OrderAccess::load_acquire(&gBlockList);
+      temp[0].FreeNext = cur;
+      if (Atomic::cmpxchg(temp, &gBlockList, cur) == cur) {
+        break;
+      }
+    }
+
+    // Carve out this thread's provision from the block in hand, which
+    // avoids a round trip through the global free list, and make the
+    // rest of the new objectMonitors available to other threads.
+    int carve = MIN2(Self->omFreeProvision, _BLOCKSIZE - 1);
+    ObjectMonitor * rest = (ObjectMonitor *)&temp[carve + 1];
+    temp[carve].FreeNext = NULL;
+    if (carve < _BLOCKSIZE - 1) {
+      prepend_to_free_list(rest, (ObjectMonitor *)&temp[_BLOCKSIZE - 1],
+                           _BLOCKSIZE - 1 - carve);
+    }
+    for (int i = 1; i <= carve; i++) {
+      omRelease(Self, (ObjectMonitor *)&temp[i], false);
+    }
   }
 }
 
@@ -1236,39 +1338,11 @@ void ObjectSynchronizer::omFlush(Thread * Self) {
     Self->omFreeCount = 0;
   }
 
-  ObjectMonitor * inUseList = Self->omInUseList;
-  ObjectMonitor * inUseTail = NULL;
-  int inUseTally = 0;
-  if (inUseList != NULL) {
-    ObjectMonitor *cur_om;
-    // The thread is going away, however the omInUseList inflated
-    // monitors may still be in-use by other threads.
-    // Link them to inUseTail, which will be linked into the global in-use list
-    // gOmInUseList below, under the gListLock
-    for (cur_om = inUseList; cur_om != NULL; cur_om = cur_om->FreeNext) {
-      inUseTail = cur_om;
-      inUseTally++;
-    }
-    guarantee(inUseTail != NULL, "invariant");
-    assert(Self->omInUseCount == inUseTally, "in-use count off");
-    Self->omInUseList = NULL;
-    Self->omInUseCount = 0;
-  }
-
-  Thread::muxAcquire(&gListLock, "omFlush");
   if (tail != NULL) {
-    tail->FreeNext = gFreeList;
-    gFreeList = list;
-    gMonitorFreeCount += tally;
-  }
-
-  if (inUseTail != NULL) {
-    inUseTail->FreeNext = gOmInUseList;
-    gOmInUseList = inUseList;
-    gOmInUseCount += inUseTally;
+    prepend_to_free_list(list, tail, tally);
   }
 
-  Thread::muxRelease(&gListLock);
+  int inUseTally = omTransferInUseList(Self);
 
   LogStreamHandle(Debug, monitorinflation) lsh_debug;
   LogStreamHandle(Info, monitorinflation) lsh_info;
@@ -1286,6 +1360,37 @@ void ObjectSynchronizer::omFlush(Thread * Self) {
   }
 }
 
+// Move the monitors on 'thread's omInUseList to gOmInUseList under the
+// gListLock, and return the number of monitors moved.  This is done by
+// a moribund thread itself (see omFlush()), and on behalf of a live
+// thread in a handshake before concurrent deflation, since only the
+// owning thread otherwise changes its omInUseList.
+int ObjectSynchronizer::omTransferInUseList(Thread * thread) {
+  ObjectMonitor * inUseList = thread->omInUseList;
+  if (inUseList == NULL) {
+    return 0;
+  }
+  // The monitors may still be in-use by other threads.  Link them to
+  // inUseTail, which will be linked into gOmInUseList below.
+  ObjectMonitor * inUseTail = NULL;
+  int inUseTally = 0;
+  for (ObjectMonitor * cur_om = inUseList; cur_om != NULL; cur_om = cur_om->FreeNext) {
+    inUseTail = cur_om;
+    inUseTally++;
+  }
+  guarantee(inUseTail != NULL, "invariant");
+  assert(thread->omInUseCount == inUseTally, "in-use count off");
+  thread->omInUseList = NULL;
+  thread->omInUseCount = 0;
+
+  Thread::muxAcquire(&gListLock, "omTransferInUseList");
+  inUseTail->FreeNext = gOmInUseList;
+  gOmInUseList = inUseList;
+  gOmInUseCount += inUseTally;
+  Thread::muxRelease(&gListLock);
+  return inUseTally;
+}
+
 static void post_monitor_inflate_event(EventJavaMonitorInflate* event,
                                        const oop obj,
                                        ObjectSynchronizer::InflateCause cause) {
@@ -1332,6 +1437,12 @@ ObjectMonitor* ObjectSynchronizer::inflate(Thread * Self,
     // CASE: inflated
     if (mark->has_monitor()) {
       ObjectMonitor * inf = mark->monitor();
+      if (inf->is_being_async_deflated()) {
+        // The ServiceThread is deflating this monitor. Restore the
+        // object's header on its behalf and inflate the object anew.
+        inf->install_displaced_markword_in_object();
+        continue;
+      }
       markOop dmw = inf->header();
       assert(dmw->is_neutral(), "invariant: header=" INTPTR_FORMAT, p2i(dmw));
       assert(oopDesc::equals((oop) inf->object(), object), "invariant");
@@ -1623,11 +1734,15 @@ void ObjectSynchronizer::prepare_deflate_idle_monitors(DeflateMonitorCounters* c
   counters->nInCirculation = 0;      // extant
   counters->nScavenged = 0;          // reclaimed (global and per-thread)
   counters->perThreadScavenged = 0;  // per-thread scavenge total
-  counters->perThreadTimes = 0.0;    // per-thread scavenge times
+  counters->perThreadTicks = 0;      // per-thread scavenge times
 }
 
 void ObjectSynchronizer::deflate_idle_monitors(DeflateMonitorCounters* counters) {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  if (AsyncDeflateIdleMonitors) {
+    // gOmInUseList is deflated by the ServiceThread.
+    return;
+  }
   bool deflated = false;
 
   ObjectMonitor * freeHeadp = NULL;  // Local SLL of scavenged monitors
@@ -1638,9 +1753,9 @@ void ObjectSynchronizer::deflate_idle_monitors(DeflateMonitorCounters* counters)
     timer.start();
   }
 
-  // Prevent omFlush from changing mids in Thread dtor's during deflation
-  // And in case the vm thread is acquiring a lock during a safepoint
-  // See e.g. 6320749
+  // Prevent omFlush from changing gOmInUseList in Thread dtor's during
+  // deflation.  And in case the vm thread is acquiring a lock during a
+  // safepoint.  See e.g. 6320749
   Thread::muxAcquire(&gListLock, "deflate_idle_monitors");
 
   // Note: the thread-local monitors lists get deflated in
@@ -1649,22 +1764,22 @@ void ObjectSynchronizer::deflate_idle_monitors(DeflateMonitorCounters* counters)
   // For moribund threads, scan gOmInUseList
   int deflated_count = 0;
   if (gOmInUseList) {
-    counters->nInCirculation += gOmInUseCount;
+    // The per-thread lists may be deflated in parallel with this, so
+    // the counters are updated atomically.
+    Atomic::add(gOmInUseCount, &counters->nInCirculation);
     deflated_count = deflate_monitor_list((ObjectMonitor **)&gOmInUseList, &freeHeadp, &freeTailp);
     gOmInUseCount -= deflated_count;
-    counters->nScavenged += deflated_count;
-    counters->nInuse += gOmInUseCount;
+    Atomic::add(deflated_count, &counters->nScavenged);
+    Atomic::add(gOmInUseCount, &counters->nInuse);
   }
+  Thread::muxRelease(&gListLock);
 
   // Move the scavenged monitors back to the global free list.
   if (freeHeadp != NULL) {
-    guarantee(freeTailp != NULL && counters->nScavenged > 0, "invariant");
-    assert(freeTailp->FreeNext == NULL, "invariant");
+    guarantee(freeTailp != NULL && deflated_count > 0, "invariant");
     // constant-time list splice - prepend scavenged segment to gFreeList
-    freeTailp->FreeNext = gFreeList;
-    gFreeList = freeHeadp;
+    prepend_to_free_list(freeHeadp, freeTailp, deflated_count);
   }
-  Thread::muxRelease(&gListLock);
   timer.stop();
 
   LogStreamHandle(Debug, monitorinflation) lsh_debug;
@@ -1685,9 +1800,9 @@ void ObjectSynchronizer::finish_deflate_idle_monitors(DeflateMonitorCounters* co
   // monitors. Note: if the work is split among more than one
   // worker thread, then the reported time will likely be more
   // than a beginning to end measurement of the phase.
-  log_info(safepoint, cleanup)("deflating per-thread idle monitors, %3.7f secs, monitors=%d", counters->perThreadTimes, counters->perThreadScavenged);
-
-  gMonitorFreeCount += counters->nScavenged;
+  log_info(safepoint, cleanup)("deflating per-thread idle monitors, %3.7f secs, monitors=%d",
+                               TimeHelper::counter_to_seconds(counters->perThreadTicks),
+                               counters->perThreadScavenged);
 
   if (log_is_enabled(Debug, monitorinflation)) {
     // exit_globals()'s call to audit_and_print_stats() is done
@@ -1701,10 +1816,21 @@ void ObjectSynchronizer::finish_deflate_idle_monitors(DeflateMonitorCounters* co
     Thread::muxRelease(&gListLock);
   }
 
-  ForceMonitorScavenge = 0;    // Reset
-
   OM_PERFDATA_OP(Deflations, inc(counters->nScavenged));
-  OM_PERFDATA_OP(MonExtant, set_value(counters->nInCirculation));
+
+  if (AsyncDeflateIdleMonitors) {
+    // Only the monitors of non-Java threads were deflated above; have the
+    // ServiceThread take care of the rest if there is anything to do.
+    // ForceMonitorScavenge and MonExtant are maintained by the ServiceThread.
+    if (gMonitorPopulation - gMonitorFreeCount > 0) {
+      MutexLocker ml(Service_lock, Mutex::_no_safepoint_check_flag);
+      gAsyncDeflationRequested = true;
+      Service_lock->notify_all();
+    }
+  } else {
+    ForceMonitorScavenge = 0;    // Reset
+    OM_PERFDATA_OP(MonExtant, set_value(counters->nInCirculation));
+  }
 
   GVars.stwRandom = os::random();
   GVars.stwCycle++;
@@ -1712,6 +1838,10 @@ void ObjectSynchronizer::finish_deflate_idle_monitors(DeflateMonitorCounters* co
 
 void ObjectSynchronizer::deflate_thread_local_monitors(Thread* thread, DeflateMonitorCounters* counters) {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  if (AsyncDeflateIdleMonitors && thread->is_Java_thread()) {
+    // The ServiceThread deflates the monitors of Java threads.
+    return;
+  }
 
   ObjectMonitor * freeHeadp = NULL;  // Local SLL of scavenged monitors
   ObjectMonitor * freeTailp = NULL;
@@ -1724,33 +1854,262 @@ void ObjectSynchronizer::deflate_thread_local_monitors(Thread* thread, DeflateMo
 
   int deflated_count = deflate_monitor_list(thread->omInUseList_addr(), &freeHeadp, &freeTailp);
 
-  Thread::muxAcquire(&gListLock, "deflate_thread_local_monitors");
-
-  // Adjust counters
-  counters->nInCirculation += thread->omInUseCount;
+  // Adjust counters.  The per-thread lists may be processed by several
+  // worker threads in parallel, so the shared counters are updated
+  // atomically rather than under gListLock.
+  int in_circulation = thread->omInUseCount;
   thread->omInUseCount -= deflated_count;
-  counters->nScavenged += deflated_count;
-  counters->nInuse += thread->omInUseCount;
-  counters->perThreadScavenged += deflated_count;
+  Atomic::add(in_circulation, &counters->nInCirculation);
+  Atomic::add(deflated_count, &counters->nScavenged);
+  Atomic::add(thread->omInUseCount, &counters->nInuse);
+  Atomic::add(deflated_count, &counters->perThreadScavenged);
 
   // Move the scavenged monitors back to the global free list.
   if (freeHeadp != NULL) {
     guarantee(freeTailp != NULL && deflated_count > 0, "invariant");
-    assert(freeTailp->FreeNext == NULL, "invariant");
 
     // constant-time list splice - prepend scavenged segment to gFreeList
-    freeTailp->FreeNext = gFreeList;
-    gFreeList = freeHeadp;
+    prepend_to_free_list(freeHeadp, freeTailp, deflated_count);
   }
 
   timer.stop();
-  // Safepoint logging cares about cumulative perThreadTimes and
-  // we'll capture most of the cost, but not the muxRelease() which
-  // should be cheap.
-  counters->perThreadTimes += timer.seconds();
+  // Safepoint logging cares about cumulative perThreadTicks.
+  Atomic::add(timer.ticks(), &counters->perThreadTicks);
+
+  LogStreamHandle(Debug, monitorinflation) lsh_debug;
+  LogStreamHandle(Info, monitorinflation) lsh_info;
+  LogStream * ls = NULL;
+  if (log_is_enabled(Debug, monitorinflation)) {
+    ls = &lsh_debug;
+  } else if (deflated_count != 0 && log_is_enabled(Info, monitorinflation)) {
+    ls = &lsh_info;
+  }
+  if (ls != NULL) {
+    ls->print_cr("jt=" INTPTR_FORMAT ": deflating per-thread idle monitors, %3.7f secs, %d monitors", p2i(thread), timer.seconds(), deflated_count);
+  }
+}
+
+// Concurrent deflation of idle monitors
+//
+// With AsyncDeflateIdleMonitors the ServiceThread deflates the monitors
+// of Java threads while the mutators keep running, and safepoint cleanup
+// only deflates the few monitors on the lists of non-Java threads.
+//
+// A deflation cycle:
+// 1. Moves every Java thread's omInUseList to gOmInUseList in a handshake.
+//    A thread's omInUseList is otherwise only changed by the thread itself.
+// 2. Walks gOmInUseList and deflates the idle monitors, see
+//    deflate_monitor_using_JT().
+// 3. Handshakes with all Java threads.  A thread that read an object's
+//    mark before the header was restored can still refer to a deflated
+//    monitor, but only until it reaches the next safepoint or handshake
+//    poll.  After the handshake the deflated monitors can be reused.
+// 4. Resets the deflated monitors and prepends them to gFreeList.
+//
+// The monitors on gOmInUseList are scanned by GC only at safepoints, so
+// the list is detached only while the ServiceThread can not reach one.
+
+bool ObjectSynchronizer::is_async_deflation_needed() {
+  if (!AsyncDeflateIdleMonitors) {
+    return false;
+  }
+  if (gAsyncDeflationRequested) {
+    return true;
+  }
+  jlong elapsed_ms = (os::javaTimeNanos() - gLastAsyncDeflationTimeNs) / NANOSECS_PER_MILLISEC;
+  if (elapsed_ms < AsyncDeflationInterval) {
+    return false;
+  }
+  if (AsyncDeflationInterval > 0 && MonitorUsedDeflationThreshold > 0) {
+    return monitors_used_above_threshold();
+  }
+  return false;
+}
+
+// A request from InduceScavenge() is not notified, so the ServiceThread
+// must wake up on its own to see it, even if AsyncDeflationInterval is 0.
+jlong ObjectSynchronizer::async_deflation_wait_ms() {
+  if (AsyncDeflationInterval > 0) {
+    return AsyncDeflationInterval;
+  }
+  return GuaranteedSafepointInterval > 0 ? GuaranteedSafepointInterval : 1000;
+}
+
+// Deflate a single monitor if it is idle, while other threads may be
+// using it.  Return true if deflated, false if in-use.
+//
+// The ServiceThread first takes ownership of the monitor, which keeps
+// other threads from entering it: quick_enter() and the compiled fast
+// paths only swing _owner from NULL.  It then backs out if the monitor
+// has waiters, or if it can't swing _contentions from 0 to -max_jint.
+// Once _contentions is negative, a thread that increments it in enter()
+// sees a non-positive value and retries with a freshly inflated monitor.
+// The deflated monitor stays owned by the ServiceThread until it is
+// reset in deflate_idle_monitors_using_JT().
+bool ObjectSynchronizer::deflate_monitor_using_JT(ObjectMonitor* mid,
+                                                  ObjectMonitor** freeHeadp,
+                                                  ObjectMonitor** freeTailp) {
+  assert(AsyncDeflateIdleMonitors, "sanity check");
+  Thread* self = Thread::current();
+  assert(ServiceThread::is_service_thread(self), "must be the ServiceThread");
+
+  if (mid->is_busy()) {
+    return false;
+  }
+  if (!Atomic::replace_if_null(self, &(mid->_owner))) {
+    // The monitor was entered after the is_busy() check.
+    return false;
+  }
+  if (mid->_waiters != 0 || mid->_cxq != NULL || mid->_EntryList != NULL ||
+      Atomic::cmpxchg((jint)-max_jint, &mid->_contentions, (jint)0) != 0) {
+    // In use after all; exit() hands the monitor on to a successor, if any.
+    mid->exit(true, self);
+    return false;
+  }
+
+  oop obj = (oop) mid->object();
+  if (log_is_enabled(Trace, monitorinflation)) {
+    ResourceMark rm(self);
+    log_trace(monitorinflation)("deflate_monitor_using_JT: "
+                                "object=" INTPTR_FORMAT ", mark="
+                                INTPTR_FORMAT ", type='%s'", p2i(obj),
+                                p2i(obj->mark()), obj->klass()->external_name());
+  }
+
+  // Restore the header back to obj; a thread that came across the
+  // monitor in the meantime may have done so already.  _object is
+  // cleared only after the header is restored, see
+  // ObjectMonitor::install_displaced_markword_in_object().
+  mid->install_displaced_markword_in_object();
+  mid->set_object(NULL);
+
+  // Move the object to the working free list defined by freeHeadp, freeTailp
+  if (*freeHeadp == NULL) *freeHeadp = mid;
+  if (*freeTailp != NULL) {
+    ObjectMonitor * prevtail = *freeTailp;
+    assert(prevtail->FreeNext == NULL, "cleaned up deflated?");
+    prevtail->FreeNext = mid;
+  }
+  *freeTailp = mid;
+  return true;
+}
+
+class TransferInUseListClosure : public ThreadClosure {
+ public:
+  void do_thread(Thread* thread) {
+    ObjectSynchronizer::omTransferInUseList(thread);
+  }
+};
+
+// Nothing to do; completing the handshake is what matters.
+class DeflationSyncClosure : public ThreadClosure {
+ public:
+  void do_thread(Thread* thread) {}
+};
+
+void ObjectSynchronizer::deflate_idle_monitors_using_JT() {
+  assert(AsyncDeflateIdleMonitors, "sanity check");
+  JavaThread* self = JavaThread::current();
+  assert(ServiceThread::is_service_thread(self), "must be the ServiceThread");
 
+  // The walk below is cut short to let a pending safepoint proceed; check
+  // for one after every 'poll_interval' monitors.
+  const int poll_interval = 1024;
+
+  EventJavaMonitorDeflation event;
+  elapsedTimer timer;
+  timer.start();
+  gAsyncDeflationRequested = false;
+
+  TransferInUseListClosure tiulc;
+  Handshake::execute(&tiulc);
+
+  // Detach gOmInUseList so gListLock isn't held during the walk.  omFlush()
+  // can still add the monitors of exiting threads to the list meanwhile.
+  Thread::muxAcquire(&gListLock, "deflate_idle_monitors_using_JT(1)");
+  ObjectMonitor * list = gOmInUseList;
+  int in_circulation = gOmInUseCount;
+  gOmInUseList = NULL;
+  gOmInUseCount = 0;
   Thread::muxRelease(&gListLock);
 
+  ObjectMonitor * freeHeadp = NULL;   // Local SLL of scavenged monitors
+  ObjectMonitor * freeTailp = NULL;
+  ObjectMonitor * inUseHead = NULL;   // Local SLL of monitors still in use
+  ObjectMonitor * inUseTail = NULL;
+  int deflated_count = 0;
+  int examined = 0;
+  while (list != NULL) {
+    ObjectMonitor * mid = list;
+    list = mid->FreeNext;
+    mid->FreeNext = NULL;
+    if (mid->object() != NULL &&
+        deflate_monitor_using_JT(mid, &freeHeadp, &freeTailp)) {
+      deflated_count++;
+    } else {
+      if (inUseTail == NULL) {
+        inUseTail = mid;
+      }
+      mid->FreeNext = inUseHead;
+      inUseHead = mid;
+    }
+    if (++examined % poll_interval == 0 &&
+        SafepointMechanism::should_block(self)) {
+      break;
+    }
+  }
+  int in_use_count = in_circulation - deflated_count;
+
+  // Put the monitors that weren't examined, followed by the ones that are
+  // still in use, back on gOmInUseList so that a cycle that was cut short
+  // is resumed where it left off.
+  ObjectMonitor * head = inUseHead;
+  ObjectMonitor * tail = inUseTail;
+  if (list != NULL) {
+    ObjectMonitor * rest_tail = list;
+    while (rest_tail->FreeNext != NULL) {
+      rest_tail = rest_tail->FreeNext;
+    }
+    rest_tail->FreeNext = inUseHead;
+    head = list;
+    if (tail == NULL) {
+      tail = rest_tail;
+    }
+  }
+  if (head != NULL) {
+    Thread::muxAcquire(&gListLock, "deflate_idle_monitors_using_JT(2)");
+    tail->FreeNext = gOmInUseList;
+    gOmInUseList = head;
+    gOmInUseCount += in_use_count;
+    Thread::muxRelease(&gListLock);
+  }
+
+  if (freeHeadp != NULL) {
+    guarantee(freeTailp != NULL && deflated_count > 0, "invariant");
+    DeflationSyncClosure dsc;
+    Handshake::execute(&dsc);
+
+    // No thread refers to the deflated monitors anymore; reset them
+    // so they can be reused.
+    for (ObjectMonitor * mid = freeHeadp; mid != NULL; mid = mid->FreeNext) {
+      assert(mid->_owner == self, "must be owned by the deflater: owner="
+             INTPTR_FORMAT, p2i(mid->_owner));
+      assert(mid->_contentions == -max_jint, "must be unchanged: contentions=%d",
+             mid->_contentions);
+      mid->set_header(NULL);
+      mid->_contentions = 0;
+      mid->set_owner(NULL);
+    }
+    prepend_to_free_list(freeHeadp, freeTailp, deflated_count);
+  }
+  timer.stop();
+
+  gLastAsyncDeflationTimeNs = os::javaTimeNanos();
+  ForceMonitorScavenge = 0;    // Reset
+
+  OM_PERFDATA_OP(Deflations, inc(deflated_count));
+  OM_PERFDATA_OP(MonExtant, set_value(in_circulation));
+
   LogStreamHandle(Debug, monitorinflation) lsh_debug;
   LogStreamHandle(Info, monitorinflation) lsh_info;
   LogStream * ls = NULL;
@@ -1760,7 +2119,17 @@ void ObjectSynchronizer::deflate_thread_local_monitors(Thread* thread, DeflateMo
     ls = &lsh_info;
   }
   if (ls != NULL) {
-    ls->print_cr("jt=" INTPTR_FORMAT ": deflating per-thread idle monitors, %3.7f secs, %d monitors", p2i(thread), timer.seconds(), deflated_count);
+    ls->print_cr("async deflating idle monitors, %3.7f secs, deflated=%d"
+                 ", in_use=%d, in_circulation=%d%s", timer.seconds(),
+                 deflated_count, in_use_count, in_circulation,
+                 list != NULL ? " (cut short by safepoint)" : "");
+  }
+
+  if (event.should_commit()) {
+    event.set_deflatedCount(deflated_count);
+    event.set_inUseCount(in_use_count);
+    event.set_inCirculationCount(in_circulation);
+    event.commit();
   }
 }
 
@@ -1801,9 +2170,10 @@ void ObjectSynchronizer::release_monitors_owned_by_thread(TRAPS) {
   assert(THREAD == JavaThread::current(), "must be current Java thread");
   NoSafepointVerifier nsv;
   ReleaseJavaMonitorsClosure rjmc(THREAD);
-  Thread::muxAcquire(&gListLock, "release_monitors_owned_by_thread");
+  // monitors_iterate() walks gBlockList lock-free and the monitors owned
+  // by THREAD can not be deflated under the NoSafepointVerifier, so there
+  // is no need to hold up other threads' omAlloc() with gListLock here.
   ObjectSynchronizer::monitors_iterate(&rjmc);
-  Thread::muxRelease(&gListLock);
   THREAD->clear_pending_exception();
 }
 
@@ -35,11 +35,11 @@ class ObjectMonitor;
 class ThreadsList;
 
 struct DeflateMonitorCounters {
-  int nInuse;              // currently associated with objects
-  int nInCirculation;      // extant
-  int nScavenged;          // reclaimed (global and per-thread)
-  int perThreadScavenged;  // per-thread scavenge total
-  double perThreadTimes;   // per-thread scavenge times
+  volatile int nInuse;              // currently associated with objects
+  volatile int nInCirculation;      // extant
+  volatile int nScavenged;          // reclaimed (global and per-thread)
+  volatile int perThreadScavenged;  // per-thread scavenge total
+  volatile jlong perThreadTicks;    // per-thread scavenge times (elapsed counter ticks)
 };
 
 class ObjectSynchronizer : AllStatic {
@@ -111,6 +111,7 @@ class ObjectSynchronizer : AllStatic {
   static void omRelease(Thread * Self, ObjectMonitor * m,
                         bool FromPerThreadAlloc);
   static void omFlush(Thread * Self);
+  static int  omTransferInUseList(Thread * thread);
 
   // Inflate light weight monitor to heavy weight monitor
   static ObjectMonitor* inflate(Thread * Self, oop obj, const InflateCause cause);
@@ -149,6 +150,16 @@ class ObjectSynchronizer : AllStatic {
                               ObjectMonitor** freeHeadp,
                               ObjectMonitor** freeTailp);
   static bool is_cleanup_needed();
+
+  // Concurrent deflation of idle monitors by the ServiceThread, used
+  // instead of deflation in safepoint cleanup if AsyncDeflateIdleMonitors
+  static bool is_async_deflation_needed();
+  // Longest time in ms the ServiceThread may wait before checking again
+  static jlong async_deflation_wait_ms();
+  static void deflate_idle_monitors_using_JT();
+  static bool deflate_monitor_using_JT(ObjectMonitor* mid,
+                                       ObjectMonitor** freeHeadp,
+                                       ObjectMonitor** freeTailp);
   static void oops_do(OopClosure* f);
   // Process oops in thread local used monitors
   static void thread_local_used_oops_do(Thread* thread, OopClosure* f);
@@ -187,6 +198,11 @@ class ObjectSynchronizer : AllStatic {
   // count of entries in gOmInUseList
   static int gOmInUseCount;
 
+  // Lock-free prepend to and batch removal from gFreeList
+  static void prepend_to_free_list(ObjectMonitor* head, ObjectMonitor* tail,
+                                   int count);
+  static ObjectMonitor* take_from_free_list(int max, int* count);
+
   // Process oops in all global used monitors (i.e. moribund thread's monitors)
   static void global_used_oops_do(OopClosure* f);
   // Process oops in monitors on the given list
@@ -26,6 +26,7 @@
 #include "jvm.h"
 #include "aot/aotLoader.hpp"
 #include "classfile/classLoader.hpp"
+#include "classfile/classPrefetcher.hpp"
 #include "classfile/javaClasses.hpp"
 #include "classfile/moduleEntry.hpp"
 #include "classfile/systemDictionary.hpp"
@@ -44,6 +45,7 @@
 #include "jfr/jfrEvents.hpp"
 #include "jvmtifiles/jvmtiEnv.hpp"
 #include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logConfiguration.hpp"
 #include "logging/logStream.hpp"
 #include "memory/allocation.inline.hpp"
@@ -84,6 +86,7 @@
 #include "runtime/orderAccess.hpp"
 #include "runtime/osThread.hpp"
 #include "runtime/prefetch.inline.hpp"
+#include "runtime/resourceLimitWatcher.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/safepointMechanism.inline.hpp"
 #include "runtime/safepointVerifiers.hpp"
@@ -226,9 +229,11 @@ Thread::Thread() {
   set_self_raw_id(0);
   set_lgrp_id(-1);
   DEBUG_ONLY(clear_suspendible_thread();)
+  _nmethod_disarmed_value = 0;
 
   // allocated data structures
   set_osthread(NULL);
+  _chunk_cache = NULL;
   set_resource_area(new (mtThread)ResourceArea());
   DEBUG_ONLY(_current_resource_mark = NULL;)
   set_handle_area(new (mtThread) HandleArea(NULL));
@@ -464,6 +469,8 @@ Thread::~Thread() {
   delete handle_area();
   delete metadata_handles();
 
+  JNIHandles::flush_handle_caches(this);
+
   // SR_handler uses this as a termination indicator -
   // needs to happen before os::free_thread()
   delete _SR_lock;
@@ -472,6 +479,11 @@ Thread::~Thread() {
   // osthread() can be NULL, if creation of thread failed.
   if (osthread() != NULL) os::free_thread(osthread());
 
+  // All arenas of this thread are gone, return its cached chunks
+  ThreadChunkCache* chunk_cache = _chunk_cache;
+  _chunk_cache = NULL;
+  delete chunk_cache;
+
   // Clear Thread::current if thread is deleting itself and it has not
   // already been done. This must be done before the memory is deallocated.
   // Needed to ensure JNI correctly detects non-attached threads.
@@ -482,6 +494,13 @@ Thread::~Thread() {
   CHECK_UNHANDLED_OOPS_ONLY(if (CheckUnhandledOops) delete unhandled_oops();)
 }
 
+// Threads that grow and chop arenas at a high rate cache free chunks locally,
+// to keep the ThreadCritical lock of the shared ChunkPools out of their way.
+void Thread::enable_chunk_cache() {
+  assert(_chunk_cache == NULL, "already enabled");
+  _chunk_cache = new ThreadChunkCache();
+}
+
 #ifdef ASSERT
 // A JavaThread is considered "dangling" if it is not the current
 // thread, has been added the Threads list, the system is not at a
@@ -1714,6 +1733,7 @@ void JavaThread::initialize() {
   _is_method_handle_return = 0;
   _jvmti_thread_state= NULL;
   _should_post_on_exceptions_flag = JNI_FALSE;
+  _profile_sample_seed = os::random();
   _interp_only_mode    = 0;
   _special_runtime_exit_condition = _no_async_condition;
   _pending_async_exception = NULL;
@@ -3467,6 +3487,7 @@ CompilerThread::CompilerThread(CompileQueue* queue,
 
   // Compiler uses resource area for compilation, let's bias it to mtCompiler
   resource_area()->bias_to(mtCompiler);
+  enable_chunk_cache();
 
 #ifndef PRODUCT
   _ideal_graph_printer = NULL;
@@ -3893,6 +3914,9 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   // real raw monitor. VM is setup enough here for raw monitor enter.
   JvmtiExport::transition_pending_onload_raw_monitors();
 
+  // Start buffering log messages, if requested with AsyncLogging.
+  LogAsyncWriter::initialize();
+
   // Create the VMThread
   { TraceTime timer("Start VMThread", TRACETIME_LOG(Info, startuptime));
 
@@ -4017,6 +4041,9 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   // loaded until phase 2 completes
   call_initPhase2(CHECK_JNI_ERR);
 
+  // Start reading the class files of PrefetchClassList in the background.
+  ClassPrefetcher::initialize(CHECK_JNI_ERR);
+
   // Always call even when there are not JVMTI environments yet, since environments
   // may be attached late and JVMTI must track phases of VM execution
   JvmtiExport::enter_start_phase();
@@ -4067,6 +4094,7 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
 
   if (MemProfiling)                   MemProfiler::engage();
   StatSampler::engage();
+  ResourceLimitWatcher::engage();
   if (CheckJNICalls)                  JniPeriodicChecker::engage();
 
   BiasedLocking::init();
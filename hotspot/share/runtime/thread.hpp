@@ -83,7 +83,6 @@ class javaVFrame;
 class DeoptResourceMark;
 class jvmtiDeferredLocalVariableSet;
 
-class GCTaskQueue;
 class ThreadClosure;
 class ICRefillVerifier;
 class IdealGraphPrinter;
@@ -93,6 +92,7 @@ class JVMCIPrimitiveArray;
 
 class Metadata;
 class ResourceArea;
+class ThreadChunkCache;
 
 DEBUG_ONLY(class ResourceMark;)
 
@@ -108,7 +108,6 @@ class WorkerThread;
 //       - ConcurrentGCThread
 //       - WorkerThread
 //         - GangWorker
-//         - GCTaskThread
 //     - WatcherThread
 //     - JfrThreadSampler
 //
@@ -152,11 +151,19 @@ class Thread: public ThreadShadow {
   // Only GC and GC barrier code should access this data area.
   GCThreadLocalData _gc_data;
 
+  // Compared against by the nmethod entry barriers of collectors that have
+  // none of their own, see SweeperBarrierSetNMethod. Always zero.
+  int _nmethod_disarmed_value;
+
  public:
   static ByteSize gc_data_offset() {
     return byte_offset_of(Thread, _gc_data);
   }
 
+  static ByteSize nmethod_disarmed_value_offset() {
+    return byte_offset_of(Thread, _nmethod_disarmed_value);
+  }
+
   template <typename T> T* gc_data() {
     STATIC_ASSERT(sizeof(T) <= sizeof(_gc_data));
     return reinterpret_cast<T*>(&_gc_data);
@@ -337,6 +344,10 @@ class Thread: public ThreadShadow {
   // One-element thread local free list
   JNIHandleBlock* _free_handle_block;
 
+  // Free entries of the global and weak global handle storages
+  JNIHandleCache _global_handle_cache;
+  JNIHandleCache _weak_global_handle_cache;
+
   // Point to the last handle mark
   HandleMark* _last_handle_mark;
 
@@ -578,6 +589,10 @@ class Thread: public ThreadShadow {
   ResourceArea* resource_area() const            { return _resource_area; }
   void set_resource_area(ResourceArea* area)     { _resource_area = area; }
 
+  // Free arena chunks cached by this thread, if enabled
+  ThreadChunkCache* chunk_cache() const          { return _chunk_cache; }
+  void enable_chunk_cache();
+
   OSThread* osthread() const                     { return _osthread;   }
   void set_osthread(OSThread* thread)            { _osthread = thread; }
 
@@ -586,6 +601,8 @@ class Thread: public ThreadShadow {
   void set_active_handles(JNIHandleBlock* block) { _active_handles = block; }
   JNIHandleBlock* free_handle_block() const      { return _free_handle_block; }
   void set_free_handle_block(JNIHandleBlock* block) { _free_handle_block = block; }
+  JNIHandleCache* global_handle_cache()          { return &_global_handle_cache; }
+  JNIHandleCache* weak_global_handle_cache()     { return &_weak_global_handle_cache; }
 
   // Internal handle support
   HandleArea* handle_area() const                { return _handle_area; }
@@ -693,6 +710,7 @@ protected:
 
   // Thread local resource area for temporary allocation within the VM
   ResourceArea* _resource_area;
+  ThreadChunkCache* _chunk_cache;
 
   DEBUG_ONLY(ResourceMark* _current_resource_mark;)
 
@@ -1794,6 +1812,7 @@ class JavaThread: public Thread {
   static ByteSize should_post_on_exceptions_flag_offset() {
     return byte_offset_of(JavaThread, _should_post_on_exceptions_flag);
   }
+  static ByteSize profile_sample_seed_offset() { return byte_offset_of(JavaThread, _profile_sample_seed); }
 
   // Returns the jni environment for this thread
   JNIEnv* jni_environment()                      { return &_jni_environment; }
@@ -2040,6 +2059,10 @@ class JavaThread: public Thread {
   void  set_should_post_on_exceptions_flag(int val)  { _should_post_on_exceptions_flag = val; }
 
  private:
+  // state of the random number generator that samples the profiling of
+  // tier 3 code, see C1ProfileSampleShift
+  jint   _profile_sample_seed;
+
   ThreadStatistics *_thread_stat;
 
  public:
@@ -558,28 +558,102 @@ void SafeThreadsListPtr::verify_hazard_ptr_scanned() {
 #endif
 }
 
+// The backing array of one or more ThreadsLists. Each list only reads its
+// first length() entries, so the list that uses all of the entries in use
+// can be extended by appending into the rest of the array. The entries past
+// the ones in use are NULL. Only accessed with the Threads_lock held, except
+// for the array of the bootstrap list, which is never shared.
+class ThreadsListStorage : public CHeapObj<mtThread> {
+  JavaThread** const _threads;
+  const uint _capacity;
+  uint _used;
+  uint _ref_count;
+
+ public:
+  ThreadsListStorage(uint capacity, uint used) :
+    _threads(NEW_C_HEAP_ARRAY(JavaThread*, capacity, mtThread)),
+    _capacity(capacity),
+    _used(used),
+    _ref_count(0)
+  {
+    assert(used < capacity, "must have a NULL entry after the ones in use");
+    Copy::zero_to_words((HeapWord*)_threads, capacity);
+  }
+
+  ~ThreadsListStorage() {
+    FREE_C_HEAP_ARRAY(JavaThread*, _threads);
+  }
+
+  JavaThread** threads() const { return _threads; }
+
+  // A list of length entries can be extended in place if it uses all of
+  // the entries in use. DO_JAVA_THREADS loads the entry after the last one
+  // of a list, so there must still be an entry after the appended one.
+  bool can_append(uint length) const {
+    return length == _used && _used + 1 < _capacity;
+  }
+
+  void append(JavaThread* java_thread) {
+    _threads[_used++] = java_thread;
+  }
+
+  void retain() {
+    _ref_count++;
+  }
+
+  void release() {
+    assert(_ref_count > 0, "sanity");
+    if (--_ref_count == 0) {
+      delete this;
+    }
+  }
+};
+
 // 'entries + 1' so we always have at least one entry.
-ThreadsList::ThreadsList(int entries) :
+ThreadsList::ThreadsList(int entries, uint spare_entries) :
+  _length(entries),
+  _next_list(NULL),
+  _storage(new ThreadsListStorage(entries + 1 + spare_entries, entries)),
+  _threads(_storage->threads()),
+  _nested_handle_cnt(0)
+{
+  _storage->retain();
+}
+
+ThreadsList::ThreadsList(ThreadsListStorage* storage, uint entries) :
   _length(entries),
   _next_list(NULL),
-  _threads(NEW_C_HEAP_ARRAY(JavaThread*, entries + 1, mtThread)),
+  _storage(storage),
+  _threads(storage->threads()),
   _nested_handle_cnt(0)
 {
-  *(JavaThread**)(_threads + entries) = NULL;  // Make sure the extra entry is NULL.
+  _storage->retain();
 }
 
 ThreadsList::~ThreadsList() {
-  FREE_C_HEAP_ARRAY(JavaThread*, _threads);
+  _storage->release();
 }
 
-// Add a JavaThread to a ThreadsList. The returned ThreadsList is a
-// new copy of the specified ThreadsList with the specified JavaThread
-// appended to the end.
+// Room for the lists that follow a newly allocated array to grow in place.
+static uint spare_entries_for(uint length) {
+  return MAX2(length / 2, 8u);
+}
+
+// Add a JavaThread to a ThreadsList. The returned ThreadsList has the
+// specified JavaThread appended to the end of the specified ThreadsList.
+// It shares the array of the specified ThreadsList when it can, and is
+// a new copy otherwise.
 ThreadsList *ThreadsList::add_thread(ThreadsList *list, JavaThread *java_thread) {
   const uint index = list->_length;
   const uint new_length = index + 1;
   const uint head_length = index;
-  ThreadsList *const new_list = new ThreadsList(new_length);
+
+  if (list->_storage->can_append(index)) {
+    list->_storage->append(java_thread);
+    return new ThreadsList(list->_storage, new_length);
+  }
+
+  ThreadsList *const new_list = new ThreadsList(new_length, spare_entries_for(new_length));
 
   if (head_length > 0) {
     Copy::disjoint_words((HeapWord*)list->_threads, (HeapWord*)new_list->_threads, head_length);
@@ -652,7 +726,7 @@ ThreadsList *ThreadsList::remove_thread(ThreadsList* list, JavaThread* java_thre
   const uint new_length = list->_length - 1;
   const uint head_length = index;
   const uint tail_length = (new_length >= index) ? (new_length - index) : 0;
-  ThreadsList *const new_list = new ThreadsList(new_length);
+  ThreadsList *const new_list = new ThreadsList(new_length, spare_entries_for(new_length));
 
   if (head_length > 0) {
     Copy::disjoint_words((HeapWord*)list->_threads, (HeapWord*)new_list->_threads, head_length);
@@ -156,8 +156,16 @@ class ThreadsSMRSupport : AllStatic {
   static void print_info_on(const Thread* thread, outputStream* st);
 };
 
+class ThreadsListStorage;
+
 // A fast list of JavaThreads.
 //
+// A ThreadsList is immutable once published, but successive lists share
+// their backing array when threads are only added: the new list appends
+// into the unused tail of the array of the current list, which the older
+// lists do not look at. So adding a thread is O(1) amortized rather than a
+// copy of the whole list. Removing a thread still copies the list.
+//
 class ThreadsList : public CHeapObj<mtThread> {
   friend class VMStructs;
   friend class SafeThreadsListPtr;  // for {dec,inc}_nested_handle_cnt() access
@@ -165,6 +173,7 @@ class ThreadsList : public CHeapObj<mtThread> {
 
   const uint _length;
   ThreadsList* _next_list;
+  ThreadsListStorage* const _storage;
   JavaThread *const *const _threads;
   volatile intx _nested_handle_cnt;
 
@@ -180,8 +189,11 @@ class ThreadsList : public CHeapObj<mtThread> {
   static ThreadsList* add_thread(ThreadsList* list, JavaThread* java_thread);
   static ThreadsList* remove_thread(ThreadsList* list, JavaThread* java_thread);
 
+  // Shares the first entries of the array of storage.
+  ThreadsList(ThreadsListStorage* storage, uint entries);
+
 public:
-  ThreadsList(int entries);
+  ThreadsList(int entries, uint spare_entries = 0);
   ~ThreadsList();
 
   template <class T>
@@ -27,7 +27,9 @@
 #include "compiler/compilerOracle.hpp"
 #include "memory/resourceArea.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/os.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/safepointVerifiers.hpp"
 #include "runtime/tieredThresholdPolicy.hpp"
@@ -36,6 +38,9 @@
 #if INCLUDE_JVMCI
 #include "jvmci/jvmci.hpp"
 #endif
+#ifdef LINUX
+#include "osContainer_linux.hpp"
+#endif
 
 #ifdef TIERED
 
@@ -300,54 +305,88 @@ void TieredThresholdPolicy::handle_counter_overflow(Method* method) {
   }
 }
 
+// If a method was unloaded or has been stale for some time, remove its task
+// from the queue. Blocking tasks and tasks submitted from whitebox API don't
+// become stale.
+bool TieredThresholdPolicy::remove_if_stale(CompileQueue* compile_queue, CompileTask* task, jlong t) {
+  if (task->is_unloaded()) {
+    compile_queue->remove_and_mark_stale(task);
+    return true;
+  }
+  Method* method = task->method();
+  if (task->can_become_stale() && is_stale(t, TieredCompileTaskTimeout, method) && !is_old(method)) {
+    if (PrintTieredEvents) {
+      print_event(REMOVE_FROM_QUEUE, method, method, task->osr_bci(), (CompLevel) task->comp_level());
+    }
+    method->clear_queued_for_compilation();
+    compile_queue->remove_and_mark_stale(task);
+    return true;
+  }
+  return false;
+}
+
+// Refresh the rate of the method and the position of the task in the queue.
+void TieredThresholdPolicy::prioritize(CompileQueue* compile_queue, CompileTask* task, jlong t) {
+  Method* method = task->method();
+  update_rate(t, method);
+  // Recompilations after deopt come first.
+  int priority_class = method->highest_comp_level();
+  if (task->is_blocking()) {
+    // In blocking compilation mode, the CompileBroker will make
+    // compilations submitted by a JVMCI compiler thread non-blocking. These
+    // compilations should be scheduled after all blocking compilations
+    // to service non-compiler related compilations sooner and reduce the
+    // chance of such compilations timing out.
+    priority_class += CompLevel_full_optimization + 1;
+  }
+  compile_queue->prioritize(task, priority_class, weight(method));
+}
+
 // Called with the queue locked and with at least one element
 CompileTask* TieredThresholdPolicy::select_task(CompileQueue* compile_queue) {
-  CompileTask *max_blocking_task = NULL;
-  CompileTask *max_task = NULL;
-  Method* max_method = NULL;
+  // The queue keeps the tasks in a heap ordered by the weights they had when
+  // they were last prioritized, which saves scanning the whole queue. Rates
+  // change while tasks wait, so a few tasks are revisited with every call.
+  const int tasks_to_sweep = 16;
+  const int max_refreshes = 8;
   jlong t = os::javaTimeMillis();
-  // Iterate through the queue and find a method with a maximum rate.
-  for (CompileTask* task = compile_queue->first(); task != NULL;) {
+
+  // Prioritize the tasks added since the last call.
+  for (CompileTask* task = compile_queue->first_unprioritized(); task != NULL;) {
     CompileTask* next_task = task->next();
-    Method* method = task->method();
-    // If a method was unloaded or has been stale for some time, remove it from the queue.
-    // Blocking tasks and tasks submitted from whitebox API don't become stale
-    if (task->is_unloaded() || (task->can_become_stale() && is_stale(t, TieredCompileTaskTimeout, method) && !is_old(method))) {
-      if (!task->is_unloaded()) {
-        if (PrintTieredEvents) {
-          print_event(REMOVE_FROM_QUEUE, method, method, task->osr_bci(), (CompLevel) task->comp_level());
-        }
-        method->clear_queued_for_compilation();
-      }
-      compile_queue->remove_and_mark_stale(task);
-      task = next_task;
-      continue;
-    }
-    update_rate(t, method);
-    if (max_task == NULL || compare_methods(method, max_method)) {
-      // Select a method with the highest rate
-      max_task = task;
-      max_method = method;
+    if (!remove_if_stale(compile_queue, task, t)) {
+      prioritize(compile_queue, task, t);
     }
+    task = next_task;
+  }
 
-    if (task->is_blocking()) {
-      if (max_blocking_task == NULL || compare_methods(method, max_blocking_task->method())) {
-        max_blocking_task = task;
-      }
+  // Refresh older tasks, and evict the ones that became stale.
+  int to_sweep = MIN2(tasks_to_sweep, compile_queue->size());
+  for (int i = 0; i < to_sweep; i++) {
+    CompileTask* task = compile_queue->next_to_sweep();
+    if (task == NULL) {
+      break;
+    }
+    if (!remove_if_stale(compile_queue, task, t)) {
+      prioritize(compile_queue, task, t);
     }
-
-    task = next_task;
   }
 
-  if (max_blocking_task != NULL) {
-    // In blocking compilation mode, the CompileBroker will make
-    // compilations submitted by a JVMCI compiler thread non-blocking. These
-    // compilations should be scheduled after all blocking compilations
-    // to service non-compiler related compilations sooner and reduce the
-    // chance of such compilations timing out.
-    max_task = max_blocking_task;
-    max_method = max_task->method();
+  // Take the task with the highest priority, once its priority is up to date.
+  CompileTask* max_task = NULL;
+  for (int refreshes = 0; (max_task = compile_queue->top()) != NULL; refreshes++) {
+    if (remove_if_stale(compile_queue, max_task, t)) {
+      continue;
+    }
+    if (refreshes == max_refreshes) {
+      break;
+    }
+    prioritize(compile_queue, max_task, t);
+    if (compile_queue->top() == max_task) {
+      break;
+    }
   }
+  Method* max_method = (max_task != NULL) ? max_task->method() : NULL;
 
   if (max_task != NULL && max_task->comp_level() == CompLevel_full_profile &&
       TieredStopAtLevel > CompLevel_full_profile &&
@@ -564,20 +603,6 @@ double TieredThresholdPolicy::weight(Method* method) {
     (method->invocation_count() + 1) * (method->backedge_count() + 1);
 }
 
-// Apply heuristics and return true if x should be compiled before y
-bool TieredThresholdPolicy::compare_methods(Method* x, Method* y) {
-  if (x->highest_comp_level() > y->highest_comp_level()) {
-    // recompilation after deopt
-    return true;
-  } else
-    if (x->highest_comp_level() == y->highest_comp_level()) {
-      if (weight(x) > weight(y)) {
-        return true;
-      }
-    }
-  return false;
-}
-
 // Is method profiled enough?
 bool TieredThresholdPolicy::is_method_profiled(Method* method) {
   MethodData* mdo = method->method_data();
@@ -589,11 +614,57 @@ bool TieredThresholdPolicy::is_method_profiled(Method* method) {
   return false;
 }
 
+// Samples the CPU use of the VM and the throttling of its container at most
+// every 200ms. The first thread that finds the sample out of date takes the
+// next one, the others go on with the current scale.
+void TieredThresholdPolicy::update_cpu_scale() {
+  jlong now = os::javaTimeMillis();
+  jlong prev = _cpu_sample_time;
+  if (now - prev < 200 || Atomic::cmpxchg(now, &_cpu_sample_time, prev) != prev) {
+    return;
+  }
+  double real_time, user_time, system_time;
+  if (!os::getTimesSecs(&real_time, &user_time, &system_time)) {
+    return;
+  }
+  double cpu_time = user_time + system_time;
+  jlong throttled_time = -1;
+#ifdef LINUX
+  if (OSContainer::is_containerized()) {
+    throttled_time = OSContainer::cpu_throttled_time();
+    if (throttled_time < 0) {
+      throttled_time = -1; // no CPU quota, or not supported
+    }
+  }
+#endif
+  if (prev != 0) {
+    double elapsed = (now - prev) / 1000.0;
+    // os::active_processor_count() is limited by the CPU quota of the container
+    double load = (cpu_time - _cpu_sample_cpu_time) / (elapsed * os::active_processor_count());
+    double scale = 1.0;
+    if (_cpu_sample_throttled_time >= 0 && throttled_time > _cpu_sample_throttled_time) {
+      // The application has used up its quota, compiling now only makes it wait longer.
+      scale = TieredThrottledThresholdScale;
+    } else if (load * 100 < TieredIdleCPUThreshold) {
+      // Get the compilations done while nobody is waiting for the CPU.
+      scale = TieredIdleThresholdScale;
+    }
+    _cpu_scale = scale;
+  }
+  _cpu_sample_cpu_time = cpu_time;
+  _cpu_sample_throttled_time = throttled_time;
+}
+
 double TieredThresholdPolicy::threshold_scale(CompLevel level, int feedback_k) {
   double queue_size = CompileBroker::queue_size(level);
   int comp_count = compiler_count(level);
   double k = queue_size / (feedback_k * comp_count) + 1;
 
+  if (TieredScaleThresholdsByCPU) {
+    update_cpu_scale();
+    k *= _cpu_scale;
+  }
+
   // Increase C1 compile threshold when the code cache is filled more
   // than specified by IncreaseFirstTierCompileThresholdAt percentage.
   // The main intention is to keep enough free space for C2 compiled code
@@ -607,6 +678,21 @@ double TieredThresholdPolicy::threshold_scale(CompLevel level, int feedback_k) {
   return k;
 }
 
+// Each deoptimization of a method past DeoptStormThreshold doubles the
+// thresholds for recompiling it with C2, so that a method caught in a
+// deoptimization storm spends longer in profiled code between attempts.
+static double deopt_backoff(Method* method) {
+  MethodData* mdo = method->method_data();
+  if (DeoptStormThreshold == 0 || mdo == NULL) {
+    return 1.0;
+  }
+  int excess = (int)mdo->decompile_count() - (int)DeoptStormThreshold + 1;
+  if (excess <= 0) {
+    return 1.0;
+  }
+  return (double)((julong)1 << MIN2(excess, 10));
+}
+
 // Call and loop predicates determine whether a transition to a higher
 // compilation level should be performed (pointers to predicate functions
 // are passed to common()).
@@ -625,7 +711,7 @@ bool TieredThresholdPolicy::loop_predicate(int i, int b, CompLevel cur_level, Me
     return loop_predicate_helper<CompLevel_none>(i, b, k, method);
   }
   case CompLevel_full_profile: {
-    double k = threshold_scale(CompLevel_full_optimization, Tier4LoadFeedback);
+    double k = threshold_scale(CompLevel_full_optimization, Tier4LoadFeedback) * deopt_backoff(method);
     return loop_predicate_helper<CompLevel_full_profile>(i, b, k, method);
   }
   default:
@@ -645,7 +731,7 @@ bool TieredThresholdPolicy::call_predicate(int i, int b, CompLevel cur_level, Me
     return call_predicate_helper<CompLevel_none>(i, b, k, method);
   }
   case CompLevel_full_profile: {
-    double k = threshold_scale(CompLevel_full_optimization, Tier4LoadFeedback);
+    double k = threshold_scale(CompLevel_full_optimization, Tier4LoadFeedback) * deopt_backoff(method);
     return call_predicate_helper<CompLevel_full_profile>(i, b, k, method);
   }
   default:
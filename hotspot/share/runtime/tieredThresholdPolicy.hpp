@@ -166,6 +166,14 @@ class TieredThresholdPolicy : public CompilationPolicy {
   jlong _start_time;
   int _c1_count, _c2_count;
 
+  // With TieredScaleThresholdsByCPU, the scale of all thresholds for the CPU
+  // use of the VM and the throttling of its container in the last sample.
+  volatile double _cpu_scale;
+  volatile jlong _cpu_sample_time;   // milliseconds
+  double _cpu_sample_cpu_time;       // seconds
+  jlong _cpu_sample_throttled_time;  // nanoseconds, -1 if unknown
+  void update_cpu_scale();
+
   // Check if the counter is big enough and set carry (effectively infinity).
   inline void set_carry_if_necessary(InvocationCounter *counter);
   // Set carry flags in the counters (in Method* and MDO).
@@ -195,8 +203,10 @@ class TieredThresholdPolicy : public CompilationPolicy {
   inline bool is_stale(jlong t, jlong timeout, Method* m);
   // Compute the weight of the method for the compilation scheduling
   inline double weight(Method* method);
-  // Apply heuristics and return true if x should be compiled before y
-  inline bool compare_methods(Method* x, Method* y);
+  // Updates the rate of the method of the task and its priority in the queue.
+  void prioritize(CompileQueue* compile_queue, CompileTask* task, jlong t);
+  // Removes the task if its method was unloaded or became stale.
+  bool remove_if_stale(CompileQueue* compile_queue, CompileTask* task, jlong t);
   // Compute event rate for a given method. The rate is the number of event (invocations + backedges)
   // per millisecond.
   inline void update_rate(jlong t, Method* m);
@@ -252,7 +262,8 @@ protected:
   jlong start_time() const     { return _start_time; }
 
 public:
-  TieredThresholdPolicy() : _start_time(0), _c1_count(0), _c2_count(0) { }
+  TieredThresholdPolicy() : _start_time(0), _c1_count(0), _c2_count(0),
+    _cpu_scale(1.0), _cpu_sample_time(0), _cpu_sample_cpu_time(0), _cpu_sample_throttled_time(-1) { }
   virtual int compiler_count(CompLevel comp_level) {
     if (is_c1_compile(comp_level)) return c1_count();
     if (is_c2_compile(comp_level)) return c2_count();
@@ -29,6 +29,7 @@
 #include "compiler/compileBroker.hpp"
 #include "gc/shared/collectedHeap.hpp"
 #include "gc/shared/isGCActiveMark.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
 #include "logging/logConfiguration.hpp"
@@ -37,8 +38,10 @@
 #include "memory/universe.hpp"
 #include "oops/symbol.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/deoptimization.hpp"
 #include "runtime/frame.inline.hpp"
+#include "runtime/handles.inline.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/sweeper.hpp"
 #include "runtime/thread.inline.hpp"
@@ -322,6 +325,9 @@ void VM_ThreadDump::doit() {
     concurrent_locks.dump_at_safepoint();
   }
 
+  GrowableArray<ThreadSnapshot*>* snapshots =
+    new GrowableArray<ThreadSnapshot*>(_num_threads == 0 ? (int)_result->t_list()->length() : _num_threads);
+
   if (_num_threads == 0) {
     // Snapshot all live threads
 
@@ -336,7 +342,7 @@ void VM_ThreadDump::doit() {
       if (_with_locked_synchronizers) {
         tcl = concurrent_locks.thread_concurrent_locks(jt);
       }
-      snapshot_thread(jt, tcl);
+      snapshots->append(snapshot_thread(jt, tcl));
     }
   } else {
     // Snapshot threads in the given _threads array
@@ -371,15 +377,59 @@ void VM_ThreadDump::doit() {
       if (_with_locked_synchronizers) {
         tcl = concurrent_locks.thread_concurrent_locks(jt);
       }
-      snapshot_thread(jt, tcl);
+      snapshots->append(snapshot_thread(jt, tcl));
     }
   }
+
+  dump_stacks(snapshots);
 }
 
-void VM_ThreadDump::snapshot_thread(JavaThread* java_thread, ThreadConcurrentLocks* tcl) {
+ThreadSnapshot* VM_ThreadDump::snapshot_thread(JavaThread* java_thread, ThreadConcurrentLocks* tcl) {
   ThreadSnapshot* snapshot = _result->add_thread_snapshot(java_thread);
-  snapshot->dump_stack_at_safepoint(_max_depth, _with_locked_monitors);
   snapshot->set_concurrent_locks(tcl);
+  return snapshot;
+}
+
+// Walks the stacks of the given snapshots. The snapshots are created and
+// linked by the VM thread; workers only fill in the stack traces of the
+// snapshots they claim.
+class ParallelStackDumpTask : public AbstractGangTask {
+ private:
+  GrowableArray<ThreadSnapshot*>* _snapshots;
+  int                             _max_depth;
+  bool                            _with_locked_monitors;
+  volatile int                    _claimed;
+
+ public:
+  ParallelStackDumpTask(GrowableArray<ThreadSnapshot*>* snapshots, int max_depth, bool with_locked_monitors) :
+    AbstractGangTask("Thread Dump Stacks"),
+    _snapshots(snapshots),
+    _max_depth(max_depth),
+    _with_locked_monitors(with_locked_monitors),
+    _claimed(0) {}
+
+  void work(uint worker_id) {
+    for (int i = Atomic::add(1, &_claimed) - 1; i < _snapshots->length(); i = Atomic::add(1, &_claimed) - 1) {
+      ResourceMark rm;
+      HandleMark hm;
+      _snapshots->at(i)->dump_stack_at_safepoint(_max_depth, _with_locked_monitors);
+    }
+  }
+};
+
+void VM_ThreadDump::dump_stacks(GrowableArray<ThreadSnapshot*>* snapshots) {
+  // Below this many threads the workers cost more to start than they save.
+  const int min_parallel_threads = 64;
+
+  WorkGang* workers = Universe::heap()->get_safepoint_workers();
+  if (workers != NULL && snapshots->length() >= min_parallel_threads) {
+    ParallelStackDumpTask task(snapshots, _max_depth, _with_locked_monitors);
+    workers->run_task(&task);
+  } else {
+    for (int i = 0; i < snapshots->length(); i++) {
+      snapshots->at(i)->dump_stack_at_safepoint(_max_depth, _with_locked_monitors);
+    }
+  }
 }
 
 volatile bool VM_Exit::_vm_exited = false;
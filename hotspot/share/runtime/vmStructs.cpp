@@ -164,8 +164,6 @@
 
 typedef HashtableEntry<intptr_t, mtInternal>  IntptrHashtableEntry;
 typedef Hashtable<intptr_t, mtInternal>       IntptrHashtable;
-typedef Hashtable<InstanceKlass*, mtClass>       KlassHashtable;
-typedef HashtableEntry<InstanceKlass*, mtClass>  KlassHashtableEntry;
 
 typedef PaddedEnd<ObjectMonitor>              PaddedObjectMonitor;
 
@@ -526,6 +524,19 @@ typedef PaddedEnd<ObjectMonitor>              PaddedObjectMonitor;
   nonstatic_field(ClassLoaderData,             _is_unsafe_anonymous,                          bool)                                  \
   volatile_nonstatic_field(ClassLoaderData,    _dictionary,                                   Dictionary*)                           \
                                                                                                                                      \
+  /**************/                                                                                                                   \
+  /* Dictionary */                                                                                                                   \
+  /**************/                                                                                                                   \
+  nonstatic_field(Dictionary,                  _table,                                        DictionaryTable*)                      \
+  nonstatic_field(DictionaryTable,             _table,                                        DictionaryTable::InternalTable*)       \
+  nonstatic_field(DictionaryTable,             _new_table,                                    DictionaryTable::InternalTable*)       \
+  nonstatic_field(DictionaryTable::InternalTable, _buckets,                                   DictionaryTable::Bucket*)              \
+  nonstatic_field(DictionaryTable::InternalTable, _size,                                      const size_t)                          \
+  volatile_nonstatic_field(DictionaryTable::Bucket, _first,                                   DictionaryTable::Node*)                \
+  volatile_nonstatic_field(DictionaryTable::Node, _next,                                      DictionaryTable::Node*)                \
+  nonstatic_field(DictionaryTable::Node,       _value,                                        DictionaryEntry*)                      \
+  nonstatic_field(DictionaryEntry,             _instance_klass,                               InstanceKlass*)                        \
+                                                                                                                                     \
   static_ptr_volatile_field(ClassLoaderDataGraph, _head,                                      ClassLoaderData*)                      \
                                                                                                                                      \
   /**********/                                                                                                                       \
@@ -1343,10 +1354,14 @@ typedef PaddedEnd<ObjectMonitor>              PaddedObjectMonitor;
   declare_toplevel_type(BasicHashtable<mtInternal>)                       \
     declare_type(IntptrHashtable, BasicHashtable<mtInternal>)             \
   declare_toplevel_type(BasicHashtable<mtSymbol>)                         \
-    declare_type(Dictionary, KlassHashtable)                              \
+  declare_toplevel_type(Dictionary)                                       \
+  declare_toplevel_type(DictionaryEntry)                                  \
+  declare_toplevel_type(DictionaryTable)                                  \
+  declare_toplevel_type(DictionaryTable::InternalTable)                   \
+  declare_toplevel_type(DictionaryTable::Bucket)                          \
+  declare_toplevel_type(DictionaryTable::Node)                            \
   declare_toplevel_type(BasicHashtableEntry<mtInternal>)                  \
   declare_type(IntptrHashtableEntry, BasicHashtableEntry<mtInternal>)     \
-    declare_type(DictionaryEntry, KlassHashtableEntry)                    \
   declare_toplevel_type(HashtableBucket<mtInternal>)                      \
   declare_toplevel_type(SystemDictionary)                                 \
   declare_toplevel_type(vmSymbols)                                        \
@@ -2314,6 +2329,13 @@ typedef PaddedEnd<ObjectMonitor>              PaddedObjectMonitor;
                                                                           \
   declare_constant(Symbol::max_symbol_length)                             \
                                                                           \
+  /******************************************/                            \
+  /* DictionaryTable::Bucket embedded state */                            \
+  /******************************************/                            \
+                                                                          \
+  declare_constant(DictionaryTable::Bucket::STATE_REDIRECT_BIT)           \
+  declare_constant(DictionaryTable::Bucket::STATE_MASK)                   \
+                                                                          \
   /***********************************************/                       \
   /* ConstantPool* layout enum for InvokeDynamic */                       \
   /***********************************************/                       \
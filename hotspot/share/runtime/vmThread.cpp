@@ -402,7 +402,11 @@ void VMThread::evaluate_operation(VM_Operation* op) {
                      op->evaluation_mode());
 
     EventExecuteVMOperation event;
+    const jlong start = op->evaluate_at_safepoint() ? 0 : os::javaTimeNanos();
     op->evaluate();
+    if (!op->evaluate_at_safepoint()) {
+      SafepointTracing::record_vm_operation(op->type(), os::javaTimeNanos() - start);
+    }
     if (event.should_commit()) {
       post_vm_operation_event(&event, op);
     }
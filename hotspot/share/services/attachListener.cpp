@@ -37,6 +37,8 @@
 #include "runtime/handles.inline.hpp"
 #include "runtime/java.hpp"
 #include "runtime/javaCalls.hpp"
+#include "runtime/mutex.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "services/attachListener.hpp"
 #include "services/diagnosticCommand.hpp"
@@ -44,6 +46,7 @@
 #include "services/writeableFlags.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/formatBuffer.hpp"
+#include "utilities/growableArray.hpp"
 
 volatile bool AttachListener::_initialized;
 
@@ -360,9 +363,124 @@ static AttachOperationFunctionInfo funcs[] = {
 
 
 
+// Examines the operation name (command), dispatches to the corresponding
+// function to perform the operation and completes the operation.
+static void execute_operation(AttachOperation* op) {
+  ResourceMark rm;
+  bufferedStream st;
+  jint res = JNI_OK;
+
+  // handle special detachall operation
+  if (strcmp(op->name(), AttachOperation::detachall_operation_name()) == 0) {
+    AttachListener::detachall();
+  } else if (!EnableDynamicAgentLoading && strcmp(op->name(), "load") == 0) {
+    st.print("Dynamic agent loading is not enabled. "
+             "Use -XX:+EnableDynamicAgentLoading to launch target VM.");
+    res = JNI_ERR;
+  } else {
+    // find the function to dispatch too
+    AttachOperationFunctionInfo* info = NULL;
+    for (int i=0; funcs[i].name != NULL; i++) {
+      const char* name = funcs[i].name;
+      assert(strlen(name) <= AttachOperation::name_length_max, "operation <= name_length_max");
+      if (strcmp(op->name(), name) == 0) {
+        info = &(funcs[i]);
+        break;
+      }
+    }
+
+    // check for platform dependent attach operation
+    if (info == NULL) {
+      info = AttachListener::pd_find_operation(op->name());
+    }
+
+    if (info != NULL) {
+      // dispatch to the function that implements this operation
+      res = (info->func)(op, &st);
+    } else {
+      st.print("Operation %s not recognized!", op->name());
+      res = JNI_ERR;
+    }
+  }
+
+  // operation complete - send result and output to client
+  op->complete(res, &st);
+}
+
+// Diagnostic operations can take long, for example a class histogram of a
+// large heap. They are handed to a small pool of worker threads so that
+// they do not hold up the clients queued behind them. Diagnostic commands
+// already support concurrent callers through the DiagnosticCommand MBean.
+static const char* concurrent_operations[] = {
+  "agentProperties",
+  "inspectheap",
+  "jcmd",
+  "printflag",
+  "properties",
+  "threaddump",
+  NULL
+};
+
+static Monitor* _worker_lock = NULL;
+static GrowableArray<AttachOperation*>* _worker_queue = NULL;
+static uint _num_workers = 0;
+static uint _idle_workers = 0;
+
+static bool is_concurrent_operation(AttachOperation* op) {
+  for (int i = 0; concurrent_operations[i] != NULL; i++) {
+    if (strcmp(op->name(), concurrent_operations[i]) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void attach_worker_thread_entry(JavaThread* thread, TRAPS) {
+  for (;;) {
+    AttachOperation* op;
+    {
+      MonitorLocker ml(_worker_lock);
+      _idle_workers++;
+      while (_worker_queue->is_empty()) {
+        ml.wait();
+      }
+      _idle_workers--;
+      op = _worker_queue->at(0);
+      _worker_queue->remove_at(0);
+    }
+    execute_operation(op);
+  }
+}
+
+// Hands the operation to a worker, starting one if all are busy. Returns
+// false if there is no worker to run it.
+static bool dispatch_to_worker(AttachOperation* op, TRAPS) {
+  if (_worker_lock == NULL) {
+    _worker_lock = new Monitor(Mutex::leaf, "Attach Listener worker lock", false,
+                               Monitor::_safepoint_check_always);
+    _worker_queue = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<AttachOperation*>(AttachListenerWorkers, true);
+  }
+
+  bool start_worker;
+  {
+    MutexLocker ml(_worker_lock);
+    start_worker = _idle_workers <= (uint)_worker_queue->length() && _num_workers < AttachListenerWorkers;
+  }
+  if (start_worker && AttachListener::start_thread("Attach Listener Worker", &attach_worker_thread_entry, THREAD)) {
+    _num_workers++;
+  }
+
+  MonitorLocker ml(_worker_lock);
+  if (_num_workers == 0) {
+    return false;
+  }
+  _worker_queue->append(op);
+  ml.notify();
+  return true;
+}
+
 // The Attach Listener threads services a queue. It dequeues an operation
-// from the queue, examines the operation name (command), and dispatches
-// to the corresponding function to perform the operation.
+// from the queue and executes it, or hands it to a worker thread.
 
 static void attach_listener_thread_entry(JavaThread* thread, TRAPS) {
   os::set_priority(thread, NearMaxPriority);
@@ -382,45 +500,11 @@ static void attach_listener_thread_entry(JavaThread* thread, TRAPS) {
       return;   // dequeue failed or shutdown
     }
 
-    ResourceMark rm;
-    bufferedStream st;
-    jint res = JNI_OK;
-
-    // handle special detachall operation
-    if (strcmp(op->name(), AttachOperation::detachall_operation_name()) == 0) {
-      AttachListener::detachall();
-    } else if (!EnableDynamicAgentLoading && strcmp(op->name(), "load") == 0) {
-      st.print("Dynamic agent loading is not enabled. "
-               "Use -XX:+EnableDynamicAgentLoading to launch target VM.");
-      res = JNI_ERR;
-    } else {
-      // find the function to dispatch too
-      AttachOperationFunctionInfo* info = NULL;
-      for (int i=0; funcs[i].name != NULL; i++) {
-        const char* name = funcs[i].name;
-        assert(strlen(name) <= AttachOperation::name_length_max, "operation <= name_length_max");
-        if (strcmp(op->name(), name) == 0) {
-          info = &(funcs[i]);
-          break;
-        }
-      }
-
-      // check for platform dependent attach operation
-      if (info == NULL) {
-        info = AttachListener::pd_find_operation(op->name());
-      }
-
-      if (info != NULL) {
-        // dispatch to the function that implements this operation
-        res = (info->func)(op, &st);
-      } else {
-        st.print("Operation %s not recognized!", op->name());
-        res = JNI_ERR;
-      }
+    if (AttachListenerWorkers > 0 && is_concurrent_operation(op) &&
+        dispatch_to_worker(op, THREAD)) {
+      continue;
     }
-
-    // operation complete - send result and output to client
-    op->complete(res, &st);
+    execute_operation(op);
   }
 }
 
@@ -442,10 +526,18 @@ bool AttachListener::has_init_error(TRAPS) {
 void AttachListener::init() {
   EXCEPTION_MARK;
 
-  const char thread_name[] = "Attach Listener";
+  if (!start_thread("Attach Listener", &attach_listener_thread_entry, THREAD)) {
+    vm_exit_during_initialization("java.lang.OutOfMemoryError",
+                                  os::native_thread_creation_failed_msg());
+  }
+}
+
+// Starts a daemon thread in the system thread group. Returns false if the
+// thread could not be created.
+bool AttachListener::start_thread(const char* thread_name, void (*entry)(JavaThread*, TRAPS), TRAPS) {
   Handle string = java_lang_String::create_from_str(thread_name, THREAD);
   if (has_init_error(THREAD)) {
-    return;
+    return false;
   }
 
   // Initialize thread_oop to put it into the system threadGroup
@@ -456,7 +548,7 @@ void AttachListener::init() {
                        string,
                        THREAD);
   if (has_init_error(THREAD)) {
-    return;
+    return false;
   }
 
   Klass* group = SystemDictionary::ThreadGroup_klass();
@@ -469,25 +561,25 @@ void AttachListener::init() {
                         thread_oop,
                         THREAD);
   if (has_init_error(THREAD)) {
-    return;
+    return false;
   }
 
   { MutexLocker mu(Threads_lock);
-    JavaThread* listener_thread = new JavaThread(&attach_listener_thread_entry);
+    JavaThread* new_thread = new JavaThread(entry);
 
     // Check that thread and osthread were created
-    if (listener_thread == NULL || listener_thread->osthread() == NULL) {
-      vm_exit_during_initialization("java.lang.OutOfMemoryError",
-                                    os::native_thread_creation_failed_msg());
+    if (new_thread == NULL || new_thread->osthread() == NULL) {
+      return false;
     }
 
-    java_lang_Thread::set_thread(thread_oop(), listener_thread);
+    java_lang_Thread::set_thread(thread_oop(), new_thread);
     java_lang_Thread::set_daemon(thread_oop());
 
-    listener_thread->set_threadObj(thread_oop());
-    Threads::add(listener_thread);
-    Thread::start(listener_thread);
+    new_thread->set_threadObj(thread_oop());
+    Threads::add(new_thread);
+    Thread::start(new_thread);
   }
+  return true;
 }
 
 // Performs clean-up tasks on platforms where we can detect that the last
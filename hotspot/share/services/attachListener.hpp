@@ -94,6 +94,9 @@ class AttachListener: AllStatic {
 
   // dequeue the next operation
   static AttachOperation* dequeue();
+
+  // starts a daemon JavaThread in the system thread group
+  static bool start_thread(const char* thread_name, void (*entry)(JavaThread*, TRAPS), TRAPS);
 #endif // !INCLUDE_SERVICES
 
  private:
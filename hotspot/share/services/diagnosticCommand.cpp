@@ -28,6 +28,7 @@
 #include "classfile/classLoaderStats.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/directivesParser.hpp"
+#include "compiler/profileSnapshot.hpp"
 #include "gc/shared/gcVMOperations.hpp"
 #include "memory/metaspace/metaspaceDCmd.hpp"
 #include "memory/resourceArea.hpp"
@@ -35,12 +36,14 @@
 #include "oops/objArrayOop.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/typeArrayOop.inline.hpp"
+#include "runtime/deoptimization.hpp"
 #include "runtime/fieldDescriptor.inline.hpp"
 #include "runtime/flags/jvmFlag.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/javaCalls.hpp"
 #include "runtime/os.hpp"
+#include "runtime/safepoint.hpp"
 #include "services/diagnosticArgument.hpp"
 #include "services/diagnosticCommand.hpp"
 #include "services/diagnosticFramework.hpp"
@@ -82,6 +85,7 @@ void DCmdRegistrant::register_dcmds(){
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<SetVMFlagDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<VMDynamicLibrariesDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<VMUptimeDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<SafepointStatsDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<VMInfoDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<SystemGCDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<RunFinalizationDCmd>(full_export, true, false));
@@ -112,6 +116,8 @@ void DCmdRegistrant::register_dcmds(){
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeCacheDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<TouchedMethodsDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeHeapAnalyticsDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ProfileSnapshotDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<DeoptimizationsDCmd>(full_export, true, false));
 
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CompilerDirectivesPrintDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CompilerDirectivesAddDCmd>(full_export, true, false));
@@ -506,17 +512,37 @@ HeapDumpDCmd::HeapDumpDCmd(outputStream* output, bool heap) :
                            DCmdWithParser(output, heap),
   _filename("filename","Name of the dump file", "STRING",true),
   _all("-all", "Dump all objects, including unreachable objects",
-       "BOOLEAN", false, "false") {
+       "BOOLEAN", false, "false"),
+  _parallel("-parallel", "Number of GC worker threads used to iterate the heap "
+            "(requires collector support, otherwise the heap is dumped serially)",
+            "INT", false, "1"),
+  _gzip("-gz", "If specified, the heap dump is written in gzipped format "
+        "using the given compression level. 1 (recommended) is the fastest, "
+        "9 the strongest compression.", "INT", false, "0") {
   _dcmdparser.add_dcmd_option(&_all);
+  _dcmdparser.add_dcmd_option(&_parallel);
+  _dcmdparser.add_dcmd_option(&_gzip);
   _dcmdparser.add_dcmd_argument(&_filename);
 }
 
 void HeapDumpDCmd::execute(DCmdSource source, TRAPS) {
+  jlong parallel = _parallel.value();
+  if (parallel < 1 || parallel > max_juint) {
+    output()->print_cr("Invalid number of parallel dump threads.");
+    return;
+  }
+
+  jlong level = _gzip.value();
+  if (level < 0 || level > 9) {
+    output()->print_cr("Compression level out of range (1-9): " JLONG_FORMAT, level);
+    return;
+  }
+
   // Request a full GC before heap dump if _all is false
   // This helps reduces the amount of unreachable objects in the dump
   // and makes it easier to browse.
   HeapDumper dumper(!_all.value() /* request GC if _all is false*/);
-  int res = dumper.dump(_filename.value());
+  int res = dumper.dump(_filename.value(), (uint)parallel, (int)level);
   if (res == 0) {
     output()->print_cr("Heap dump file created");
   } else {
@@ -545,13 +571,24 @@ int HeapDumpDCmd::num_arguments() {
 ClassHistogramDCmd::ClassHistogramDCmd(outputStream* output, bool heap) :
                                        DCmdWithParser(output, heap),
   _all("-all", "Inspect all objects, including unreachable objects",
-       "BOOLEAN", false, "false") {
+       "BOOLEAN", false, "false"),
+  _parallel("-parallel", "Number of GC worker threads used to iterate the heap "
+            "(requires collector support, otherwise the heap is inspected serially)",
+            "INT", false, "1") {
   _dcmdparser.add_dcmd_option(&_all);
+  _dcmdparser.add_dcmd_option(&_parallel);
 }
 
 void ClassHistogramDCmd::execute(DCmdSource source, TRAPS) {
+  jlong parallel = _parallel.value();
+  if (parallel < 1 || parallel > max_juint) {
+    output()->print_cr("Invalid number of parallel inspection threads.");
+    return;
+  }
+
   VM_GC_HeapInspection heapop(output(),
-                              !_all.value() /* request full gc if false */);
+                              !_all.value() /* request full gc if false */,
+                              (uint)parallel);
   VMThread::execute(&heapop);
 }
 
@@ -929,6 +966,10 @@ void VMDynamicLibrariesDCmd::execute(DCmdSource source, TRAPS) {
   output()->cr();
 }
 
+void SafepointStatsDCmd::execute(DCmdSource source, TRAPS) {
+  SafepointTracing::print_statistics(output());
+}
+
 void CompileQueueDCmd::execute(DCmdSource source, TRAPS) {
   VM_PrintCompileQueue printCompileQueueOp(output());
   VMThread::execute(&printCompileQueueOp);
@@ -1017,6 +1058,50 @@ void CompilerDirectivesPrintDCmd::execute(DCmdSource source, TRAPS) {
   DirectivesStack::print(output());
 }
 
+ProfileSnapshotDCmd::ProfileSnapshotDCmd(outputStream* output, bool heap) :
+                     DCmdWithParser(output, heap),
+  _filename("filename", "Name of the profile snapshot file", "STRING", true) {
+  _dcmdparser.add_dcmd_argument(&_filename);
+}
+
+void ProfileSnapshotDCmd::execute(DCmdSource source, TRAPS) {
+  if (ProfileSnapshot::dump(_filename.value(), output())) {
+    output()->print_cr("Profile snapshot written to %s", _filename.value());
+  }
+}
+
+int ProfileSnapshotDCmd::num_arguments() {
+  ResourceMark rm;
+  ProfileSnapshotDCmd* dcmd = new ProfileSnapshotDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
+DeoptimizationsDCmd::DeoptimizationsDCmd(outputStream* output, bool heap) :
+                     DCmdWithParser(output, heap),
+  _storms("storms", "Only list the methods in a deoptimization storm", "BOOLEAN", false, "false") {
+  _dcmdparser.add_dcmd_option(&_storms);
+}
+
+void DeoptimizationsDCmd::execute(DCmdSource source, TRAPS) {
+  Deoptimization::print_deoptimized_methods(output(), _storms.value());
+}
+
+int DeoptimizationsDCmd::num_arguments() {
+  ResourceMark rm;
+  DeoptimizationsDCmd* dcmd = new DeoptimizationsDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
 CompilerDirectivesAddDCmd::CompilerDirectivesAddDCmd(outputStream* output, bool heap) :
                            DCmdWithParser(output, heap),
   _filename("filename","Name of the directives file", "STRING",true) {
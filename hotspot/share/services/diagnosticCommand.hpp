@@ -223,6 +223,29 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class SafepointStatsDCmd : public DCmd {
+public:
+  SafepointStatsDCmd(outputStream* output, bool heap) : DCmd(output, heap) { }
+  static const char* name() {
+    return "VM.safepoint_stats";
+  }
+  static const char* description() {
+    return "Print sync, cleanup and operation time histograms per VM operation type.";
+  }
+  static const char* impact() {
+    return "Low";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments() {
+    return 0;
+  };
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 class VMUptimeDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<bool> _date;
@@ -330,6 +353,8 @@ class HeapDumpDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<char*> _filename;
   DCmdArgument<bool>  _all;
+  DCmdArgument<jlong> _parallel;
+  DCmdArgument<jlong> _gzip;
 public:
   HeapDumpDCmd(outputStream* output, bool heap);
   static const char* name() {
@@ -356,6 +381,7 @@ public:
 class ClassHistogramDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<bool> _all;
+  DCmdArgument<jlong> _parallel;
 public:
   ClassHistogramDCmd(outputStream* output, bool heap);
   static const char* name() {
@@ -668,6 +694,52 @@ public:
 };
 //---<  END  >--- CodeHeap State Analytics.
 
+class ProfileSnapshotDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<char*> _filename;
+public:
+  ProfileSnapshotDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "Compiler.profile_snapshot";
+  }
+  static const char* description() {
+    return "Write the counters of compiled methods to a file for LoadProfileSnapshot.";
+  }
+  static const char* impact() {
+    return "Medium: Depends on the number of loaded methods.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
+class DeoptimizationsDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<bool> _storms;
+public:
+  DeoptimizationsDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "Compiler.deoptimizations";
+  }
+  static const char* description() {
+    return "Print the trap history of deoptimized methods.";
+  }
+  static const char* impact() {
+    return "Medium: Depends on the number of loaded methods.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 class CompilerDirectivesPrintDCmd : public DCmd {
 public:
   CompilerDirectivesPrintDCmd(outputStream* output, bool heap) : DCmd(output, heap) {}
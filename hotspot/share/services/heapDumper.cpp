@@ -32,6 +32,7 @@
 #include "classfile/vmSymbols.hpp"
 #include "gc/shared/gcLocker.hpp"
 #include "gc/shared/gcVMOperations.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
@@ -39,6 +40,7 @@
 #include "oops/objArrayOop.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/typeArrayOop.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/frame.inline.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/javaCalls.hpp"
@@ -51,6 +53,7 @@
 #include "runtime/vmThread.hpp"
 #include "runtime/vmOperations.hpp"
 #include "services/heapDumper.hpp"
+#include "services/heapDumperCompression.hpp"
 #include "services/threadService.hpp"
 #include "utilities/macros.hpp"
 #include "utilities/ostream.hpp"
@@ -376,12 +379,24 @@ enum {
   INITIAL_CLASS_COUNT = 200
 };
 
-// Supports I/O operations on a dump file
+// Supports I/O operations on a dump file.
+//
+// The sub-records of the heap dump are collected in HPROF_HEAP_DUMP_SEGMENT
+// records which are assembled in the I/O buffer, so that the segment length
+// can be fixed up before the buffer is written and the dump file is written
+// strictly sequentially. A sub-record which does not fit into the buffer
+// gets a segment of its own, for which the length is known up front.
+//
+// If a CompressionBackend is given, every buffer is compressed by the backend
+// before it is written. The buffers are written in the order they were filled.
 
 class DumpWriter : public StackObj {
  private:
   enum {
-    io_buffer_size  = 8*M
+    io_buffer_max_size = 8*M,
+    io_buffer_min_size = 64*K,
+    dump_segment_header_size = 9,   // u1 tag, u4 timestamp, u4 length
+    default_max_in_flight = 4       // compressed blocks in flight by default
   };
 
   int _fd;              // file descriptor (-1 if dump file not open)
@@ -391,7 +406,18 @@ class DumpWriter : public StackObj {
   size_t _size;
   size_t _pos;
 
-  jlong _dump_start;
+  bool _in_dump_segment;     // are we currently in a dump segment?
+  bool _is_huge_sub_record;  // is the current sub-record larger than the buffer?
+  DEBUG_ONLY(size_t _sub_record_left;)  // bytes not yet written of the current sub-record
+  DEBUG_ONLY(bool _sub_record_ended;)   // has end_sub_record() been called?
+
+  CompressionBackend* _backend;       // NULL if the dump is not compressed
+  CompressionWork* _work;             // the block _buffer belongs to
+  CompressionWork* _first_in_flight;  // submitted blocks, oldest first
+  CompressionWork* _last_in_flight;
+  CompressionWork* _free_works;       // blocks available for reuse
+  uint _num_in_flight;
+  uint _max_in_flight;
 
   char* _error;   // error message when I/O fails
 
@@ -403,37 +429,44 @@ class DumpWriter : public StackObj {
   size_t position() const                       { return _pos; }
   void set_position(size_t pos)                 { _pos = pos; }
 
-  void set_error(const char* error)             { _error = (char*)os::strdup(error); }
+  void set_error(const char* error) {
+    if (_error == NULL) {
+      _error = (char*)os::strdup(error);
+    }
+  }
 
   // all I/O go through this function
   void write_internal(void* s, size_t len);
 
+  // writes the buffer (or hands it to the compression backend) and
+  // continues with an empty buffer
+  void write_buffer();
+
+  // waits for the oldest compressed block and writes it to the file
+  void write_oldest_work();
+
  public:
-  DumpWriter(const char* path);
+  DumpWriter(const char* path, CompressionBackend* backend = NULL);
   ~DumpWriter();
 
   void close();
   bool is_open() const                  { return file_descriptor() >= 0; }
-  void flush();
 
-  jlong dump_start() const                      { return _dump_start; }
-  void set_dump_start(jlong pos);
-  julong current_record_length();
+  // writes all buffered bytes to the dump file; must not be called
+  // within a dump segment
+  void flush();
 
   // total number of bytes written to the disk
   julong bytes_written() const          { return _bytes_written; }
 
-  // adjust the number of bytes written to disk (used to keep the count
-  // of the number of bytes written in case of rewrites)
-  void adjust_bytes_written(jlong n)    { _bytes_written += n; }
-
-  // number of (buffered) bytes as yet unwritten to the dump file
-  size_t bytes_unwritten() const        { return position(); }
-
   char* error() const                   { return _error; }
 
-  jlong current_offset();
-  void seek_to_offset(jlong pos);
+  // maximum number of blocks handed to the compression backend and not
+  // yet written to the file
+  void set_max_in_flight(uint n)        { _max_in_flight = MAX2(n, (uint)default_max_in_flight); }
+
+  // copies the content of the given file to the dump file
+  void append_file(const char* path);
 
   // writer functions
   void write_raw(void* s, size_t len);
@@ -445,28 +478,63 @@ class DumpWriter : public StackObj {
   void write_symbolID(Symbol* o);
   void write_classID(Klass* k);
   void write_id(u4 x);
+
+  // starts a new sub-record of the given type and total length (including
+  // the tag) in the current dump segment, starting a new segment if needed
+  void start_sub_record(u1 tag, u4 len);
+  // ends the current sub-record
+  void end_sub_record();
+  // finishes the current dump segment, if any
+  void finish_dump_segment();
 };
 
-DumpWriter::DumpWriter(const char* path) {
-  // try to allocate an I/O buffer of io_buffer_size. If there isn't
-  // sufficient memory then reduce size until we can allocate something.
-  _size = io_buffer_size;
-  do {
-    _buffer = (char*)os::malloc(_size, mtInternal);
-    if (_buffer == NULL) {
-      _size = _size >> 1;
-    }
-  } while (_buffer == NULL && _size > 0);
-  assert((_size > 0 && _buffer != NULL) || (_size == 0 && _buffer == NULL), "sanity check");
+DumpWriter::DumpWriter(const char* path, CompressionBackend* backend) {
+  _fd = -1;
+  _bytes_written = 0L;
+  _buffer = NULL;
+  _size = 0;
   _pos = 0;
+  _in_dump_segment = false;
+  _is_huge_sub_record = false;
+  DEBUG_ONLY(_sub_record_left = 0);
+  DEBUG_ONLY(_sub_record_ended = false);
+  _backend = backend;
+  _work = NULL;
+  _first_in_flight = NULL;
+  _last_in_flight = NULL;
+  _free_works = NULL;
+  _num_in_flight = 0;
+  _max_in_flight = default_max_in_flight;
   _error = NULL;
-  _bytes_written = 0L;
-  _dump_start = (jlong)-1;
+
+  if (_backend != NULL) {
+    // the buffer is provided by the compression backend
+    _work = _backend->allocate_work();
+    if (_work != NULL) {
+      _buffer = _work->in();
+      _size = _backend->block_size();
+    }
+  } else {
+    // try to allocate an I/O buffer of io_buffer_max_size. If there isn't
+    // sufficient memory then reduce size until we can allocate something.
+    _size = io_buffer_max_size;
+    do {
+      _buffer = (char*)os::malloc(_size, mtInternal);
+      if (_buffer == NULL) {
+        _size = _size >> 1;
+      }
+    } while (_buffer == NULL && _size >= io_buffer_min_size);
+  }
+  if (_buffer == NULL) {
+    set_error("Could not allocate buffer memory for heap dump");
+    return;
+  }
+
   _fd = os::create_binary_file(path, false);    // don't replace existing file
 
   // if the open failed we record the error
   if (_fd < 0) {
-    _error = (char*)os::strdup(os::strerror(errno));
+    set_error(os::strerror(errno));
   }
 }
 
@@ -475,7 +543,20 @@ DumpWriter::~DumpWriter() {
   if (is_open()) {
     close();
   }
-  if (_buffer != NULL) os::free(_buffer);
+  if (_backend != NULL) {
+    // wait for blocks still in flight after an I/O error
+    while (_first_in_flight != NULL) {
+      write_oldest_work();
+    }
+    _backend->free_work(_work);
+    while (_free_works != NULL) {
+      CompressionWork* next = _free_works->next();
+      _backend->free_work(_free_works);
+      _free_works = next;
+    }
+  } else if (_buffer != NULL) {
+    os::free(_buffer);
+  }
   if (_error != NULL) os::free(_error);
 }
 
@@ -489,22 +570,6 @@ void DumpWriter::close() {
   }
 }
 
-// sets the dump starting position
-void DumpWriter::set_dump_start(jlong pos) {
-  _dump_start = pos;
-}
-
-julong DumpWriter::current_record_length() {
-  if (is_open()) {
-    // calculate the size of the dump record
-    julong dump_end = bytes_written() + bytes_unwritten();
-    assert(dump_end == (size_t)current_offset(), "checking");
-    julong dump_len = dump_end - dump_start() - 4;
-    return dump_len;
-  }
-  return 0;
-}
-
 // write directly to the file
 void DumpWriter::write_internal(void* s, size_t len) {
   if (is_open()) {
@@ -529,55 +594,131 @@ void DumpWriter::write_internal(void* s, size_t len) {
   }
 }
 
-// write raw bytes
-void DumpWriter::write_raw(void* s, size_t len) {
-  if (is_open()) {
-    // flush buffer to make room
-    if ((position() + len) >= buffer_size()) {
-      flush();
-    }
+void DumpWriter::write_buffer() {
+  if (position() == 0) {
+    return;
+  }
+  if (_backend == NULL) {
+    write_internal(buffer(), position());
+    set_position(0);
+    return;
+  }
 
-    // buffer not available or too big to buffer it
-    if ((buffer() == NULL) || (len >= buffer_size())) {
-      write_internal(s, len);
+  // hand the block to the backend and queue it for writing
+  _work->set_in_used(position());
+  _work->set_next(NULL);
+  _backend->submit(_work);
+  if (_last_in_flight == NULL) {
+    _first_in_flight = _work;
+  } else {
+    _last_in_flight->set_next(_work);
+  }
+  _last_in_flight = _work;
+  _num_in_flight++;
+
+  // bound the memory used by the blocks in flight
+  while (_num_in_flight >= _max_in_flight) {
+    write_oldest_work();
+  }
+
+  // continue with a free block
+  if (_free_works == NULL) {
+    CompressionWork* work = _backend->allocate_work();
+    if (work != NULL) {
+      work->set_next(NULL);
+      _free_works = work;
     } else {
-      // Should optimize this for u1/u2/u4/u8 sizes.
-      memcpy(buffer() + position(), s, len);
-      set_position(position() + len);
+      // out of memory, reuse a block in flight
+      write_oldest_work();
     }
   }
+  _work = _free_works;
+  _free_works = _work->next();
+  _buffer = _work->in();
+  set_position(0);
+}
+
+void DumpWriter::write_oldest_work() {
+  CompressionWork* work = _first_in_flight;
+  assert(work != NULL, "no block in flight");
+  _first_in_flight = work->next();
+  if (_first_in_flight == NULL) {
+    _last_in_flight = NULL;
+  }
+  _num_in_flight--;
+
+  _backend->wait_for(work);
+  if (work->out_used() > 0) {
+    write_internal(work->out(), work->out_used());
+  } else if (is_open()) {
+    // the block could not be compressed, the dump is incomplete
+    set_error(_backend->error() != NULL ? _backend->error() : "Compression failed");
+    os::close(file_descriptor());
+    set_file_descriptor(-1);
+  }
+
+  work->set_next(_free_works);
+  _free_works = work;
 }
 
 // flush any buffered bytes to the file
 void DumpWriter::flush() {
-  if (is_open() && position() > 0) {
-    write_internal(buffer(), position());
-    set_position(0);
+  assert(!_in_dump_segment, "must not be in a dump segment");
+  write_buffer();
+  while (_first_in_flight != NULL) {
+    write_oldest_work();
   }
 }
 
-jlong DumpWriter::current_offset() {
-  if (is_open()) {
-    // the offset is the file offset plus whatever we have buffered
-    jlong offset = os::current_file_offset(file_descriptor());
-    assert(offset >= 0, "lseek failed");
-    return offset + position();
-  } else {
-    return (jlong)-1;
+// write raw bytes
+void DumpWriter::write_raw(void* s, size_t len) {
+  assert(!_in_dump_segment || (_sub_record_left >= len), "sub-record too large");
+  DEBUG_ONLY(_sub_record_left -= len);
+
+  if (!is_open()) {
+    return;
+  }
+
+  // write the buffer whenever it is full
+  while (len > buffer_size() - position()) {
+    assert(!_in_dump_segment || _is_huge_sub_record, "cannot overflow in non-huge sub-record");
+    size_t to_write = buffer_size() - position();
+    memcpy(buffer() + position(), s, to_write);
+    s = (void*) ((char*) s + to_write);
+    len -= to_write;
+    set_position(position() + to_write);
+    write_buffer();
   }
+
+  memcpy(buffer() + position(), s, len);
+  set_position(position() + len);
 }
 
-void DumpWriter::seek_to_offset(jlong off) {
-  assert(off >= 0, "bad offset");
+void DumpWriter::append_file(const char* path) {
+  if (!is_open()) {
+    return;
+  }
+  int fd = os::open(path, O_RDONLY, 0);
+  if (fd < 0) {
+    set_error(os::strerror(errno));
+    return;
+  }
 
-  // need to flush before seeking
+  // the buffered bytes must precede the appended content. The content
+  // of the file is copied as is, it is already compressed if needed.
   flush();
-
-  // may be closed due to I/O error
-  if (is_open()) {
-    jlong n = os::seek_to_file_offset(file_descriptor(), off);
-    assert(n >= 0, "lseek failed");
+  char tmp[4*K];
+  while (is_open()) {
+    ssize_t n = os::read(fd, tmp, (unsigned int)sizeof(tmp));
+    if (n <= 0) {
+      if (n < 0) {
+        set_error(os::strerror(errno));
+      }
+      break;
+    }
+    write_internal(tmp, (size_t)n);
   }
+  os::close(fd);
 }
 
 void DumpWriter::write_u2(u2 x) {
@@ -629,6 +770,58 @@ void DumpWriter::write_classID(Klass* k) {
   write_objectID(k->java_mirror());
 }
 
+void DumpWriter::start_sub_record(u1 tag, u4 len) {
+  if (!_in_dump_segment) {
+    if (position() > 0) {
+      write_buffer();
+    }
+    assert(position() == 0, "must be at the start of the buffer");
+
+    write_u1(HPROF_HEAP_DUMP_SEGMENT);
+    write_u4(0); // timestamp
+    // Fixed up by finish_dump_segment() if more sub-records are added. If
+    // this is a huge sub-record, this already is the correct length since
+    // the segment will not contain anything else.
+    write_u4(len);
+    _in_dump_segment = true;
+    _is_huge_sub_record = len > buffer_size() - dump_segment_header_size;
+  } else if (_is_huge_sub_record || (len > buffer_size() - position())) {
+    // The sub-record does not fit into the buffer or the last one was huge.
+    // Finish the current segment and try again.
+    finish_dump_segment();
+    start_sub_record(tag, len);
+    return;
+  }
+
+  DEBUG_ONLY(_sub_record_left = len);
+  DEBUG_ONLY(_sub_record_ended = false);
+
+  write_u1(tag);
+}
+
+void DumpWriter::end_sub_record() {
+  assert(_in_dump_segment, "must be in a dump segment");
+  assert(_sub_record_left == 0, "sub-record not written completely");
+  assert(!_sub_record_ended, "must not have ended yet");
+  DEBUG_ONLY(_sub_record_ended = true);
+}
+
+void DumpWriter::finish_dump_segment() {
+  if (_in_dump_segment) {
+    assert(_sub_record_left == 0, "last sub-record not written completely");
+    assert(_sub_record_ended, "sub-record must have ended");
+
+    // Fix up the segment length unless it holds a huge sub-record, in which
+    // case the length was already correct when the segment was started.
+    if (!_is_huge_sub_record) {
+      assert(position() > dump_segment_header_size, "dump segment should have some content");
+      Bytes::put_Java_u4((address) (buffer() + 5), (u4) (position() - dump_segment_header_size));
+    }
+
+    write_buffer();
+    _in_dump_segment = false;
+  }
+}
 
 
 // Support class with a collection of functions used when dumping the heap
@@ -644,9 +837,17 @@ class DumperSupport : AllStatic {
   // returns hprof tag for the given basic type
   static hprofTag type2tag(BasicType type);
 
+  // returns the size of a value of the type with the given signature
+  static u4 sig2size(Symbol* sig);
+
   // returns the size of the instance of the given class
   static u4 instance_size(Klass* k);
 
+  // returns the size of the static fields and sets the number of them
+  static u4 get_static_fields_size(InstanceKlass* ik, u2& field_count);
+  // returns the number of instance fields of the given class
+  static u2 get_instance_fields_count(InstanceKlass* ik);
+
   // dump a jfloat
   static void dump_float(DumpWriter* writer, jfloat f);
   // dump a jdouble
@@ -676,15 +877,9 @@ class DumperSupport : AllStatic {
   static void dump_stack_frame(DumpWriter* writer, int frame_serial_num, int class_serial_num, Method* m, int bci);
 
   // check if we need to truncate an array
-  static int calculate_array_max_length(DumpWriter* writer, arrayOop array, short header_size);
-
-  // writes a HPROF_HEAP_DUMP_SEGMENT record
-  static void write_dump_header(DumpWriter* writer);
-
-  // fixes up the length of the current dump record
-  static void write_current_dump_record_length(DumpWriter* writer);
+  static int calculate_array_max_length(arrayOop array, short header_size);
 
-  // fixes up the current dump record and writes HPROF_HEAP_DUMP_END record
+  // finishes the current dump segment and writes HPROF_HEAP_DUMP_END record
   static void end_of_dump(DumpWriter* writer);
 };
 
@@ -812,6 +1007,28 @@ void DumperSupport::dump_field_value(DumpWriter* writer, char type, oop obj, int
   }
 }
 
+// returns the size of a value of the type with the given signature
+u4 DumperSupport::sig2size(Symbol* sig) {
+  switch (sig->char_at(0)) {
+    case JVM_SIGNATURE_CLASS   :
+    case JVM_SIGNATURE_ARRAY   : return sizeof(address);
+
+    case JVM_SIGNATURE_BYTE    :
+    case JVM_SIGNATURE_BOOLEAN : return 1;
+
+    case JVM_SIGNATURE_CHAR    :
+    case JVM_SIGNATURE_SHORT   : return 2;
+
+    case JVM_SIGNATURE_INT     :
+    case JVM_SIGNATURE_FLOAT   : return 4;
+
+    case JVM_SIGNATURE_LONG    :
+    case JVM_SIGNATURE_DOUBLE  : return 8;
+
+    default : ShouldNotReachHere(); /* to shut up compiler */ return 0;
+  }
+}
+
 // returns the size of the instance of the given class
 u4 DumperSupport::instance_size(Klass* k) {
   HandleMark hm;
@@ -821,39 +1038,24 @@ u4 DumperSupport::instance_size(Klass* k) {
 
   for (FieldStream fld(ik, false, false); !fld.eos(); fld.next()) {
     if (!fld.access_flags().is_static()) {
-      Symbol* sig = fld.signature();
-      switch (sig->char_at(0)) {
-        case JVM_SIGNATURE_CLASS   :
-        case JVM_SIGNATURE_ARRAY   : size += oopSize; break;
-
-        case JVM_SIGNATURE_BYTE    :
-        case JVM_SIGNATURE_BOOLEAN : size += 1; break;
-
-        case JVM_SIGNATURE_CHAR    :
-        case JVM_SIGNATURE_SHORT   : size += 2; break;
-
-        case JVM_SIGNATURE_INT     :
-        case JVM_SIGNATURE_FLOAT   : size += 4; break;
-
-        case JVM_SIGNATURE_LONG    :
-        case JVM_SIGNATURE_DOUBLE  : size += 8; break;
-
-        default : ShouldNotReachHere();
-      }
+      size += sig2size(fld.signature());
     }
   }
   return size;
 }
 
-// dumps static fields of the given class
-void DumperSupport::dump_static_fields(DumpWriter* writer, Klass* k) {
+// returns the size of the static field records of the given class and sets
+// field_count to the number of them
+u4 DumperSupport::get_static_fields_size(InstanceKlass* ik, u2& field_count) {
   HandleMark hm;
-  InstanceKlass* ik = InstanceKlass::cast(k);
+  field_count = 0;
+  u4 size = 0;
 
-  // pass 1 - count the static fields
-  u2 field_count = 0;
   for (FieldStream fldc(ik, true, true); !fldc.eos(); fldc.next()) {
-    if (fldc.access_flags().is_static()) field_count++;
+    if (fldc.access_flags().is_static()) {
+      field_count++;
+      size += sig2size(fldc.signature());
+    }
   }
 
   // Add in resolved_references which is referenced by the cpCache
@@ -862,12 +1064,14 @@ void DumperSupport::dump_static_fields(DumpWriter* writer, Klass* k) {
   oop resolved_references = ik->constants()->resolved_references_or_null();
   if (resolved_references != NULL) {
     field_count++;
+    size += sizeof(address);
 
     // Add in the resolved_references of the used previous versions of the class
     // in the case of RedefineClasses
     InstanceKlass* prev = ik->previous_versions();
     while (prev != NULL && prev->constants()->resolved_references_or_null() != NULL) {
       field_count++;
+      size += sizeof(address);
       prev = prev->previous_versions();
     }
   }
@@ -877,8 +1081,24 @@ void DumperSupport::dump_static_fields(DumpWriter* writer, Klass* k) {
   oop init_lock = ik->init_lock();
   if (init_lock != NULL) {
     field_count++;
+    size += sizeof(address);
   }
 
+  // We write the value itself plus a name and a one byte type tag per field.
+  return size + field_count * (sizeof(address) + 1);
+}
+
+// dumps static fields of the given class
+void DumperSupport::dump_static_fields(DumpWriter* writer, Klass* k) {
+  HandleMark hm;
+  InstanceKlass* ik = InstanceKlass::cast(k);
+
+  // pass 1 - count the static fields
+  u2 field_count = 0;
+  get_static_fields_size(ik, field_count);
+  oop resolved_references = ik->constants()->resolved_references_or_null();
+  oop init_lock = ik->init_lock();
+
   writer->write_u2(field_count);
 
   // pass 2 - dump the field descriptors and raw values
@@ -931,16 +1151,25 @@ void DumperSupport::dump_instance_fields(DumpWriter* writer, oop o) {
   }
 }
 
+// returns the number of instance fields of the given class
+u2 DumperSupport::get_instance_fields_count(InstanceKlass* ik) {
+  HandleMark hm;
+  u2 field_count = 0;
+
+  for (FieldStream fldc(ik, true, true); !fldc.eos(); fldc.next()) {
+    if (!fldc.access_flags().is_static()) field_count++;
+  }
+
+  return field_count;
+}
+
 // dumps the definition of the instance fields for a given class
 void DumperSupport::dump_instance_field_descriptors(DumpWriter* writer, Klass* k) {
   HandleMark hm;
   InstanceKlass* ik = InstanceKlass::cast(k);
 
   // pass 1 - count the instance fields
-  u2 field_count = 0;
-  for (FieldStream fldc(ik, true, true); !fldc.eos(); fldc.next()) {
-    if (!fldc.access_flags().is_static()) field_count++;
-  }
+  u2 field_count = get_instance_fields_count(ik);
 
   writer->write_u2(field_count);
 
@@ -964,7 +1193,10 @@ void DumperSupport::dump_instance(DumpWriter* writer, oop o) {
     return;
   }
 
-  writer->write_u1(HPROF_GC_INSTANCE_DUMP);
+  u4 is = instance_size(k);
+  u4 size = 1 + sizeof(address) + 4 + sizeof(address) + 4 + is;
+
+  writer->start_sub_record(HPROF_GC_INSTANCE_DUMP, size);
   writer->write_objectID(o);
   writer->write_u4(STACK_TRACE_ID);
 
@@ -972,10 +1204,12 @@ void DumperSupport::dump_instance(DumpWriter* writer, oop o) {
   writer->write_classID(k);
 
   // number of bytes that follow
-  writer->write_u4(instance_size(k) );
+  writer->write_u4(is);
 
   // field values
   dump_instance_fields(writer, o);
+
+  writer->end_sub_record();
 }
 
 // creates HPROF_GC_CLASS_DUMP record for the given class and each of
@@ -990,7 +1224,13 @@ void DumperSupport::dump_class_and_array_classes(DumpWriter* writer, Klass* k) {
     return;
   }
 
-  writer->write_u1(HPROF_GC_CLASS_DUMP);
+  u2 static_fields_count = 0;
+  u4 static_size = get_static_fields_size(ik, static_fields_count);
+  u2 instance_fields_count = get_instance_fields_count(ik);
+  u4 instance_fields_size = instance_fields_count * (sizeof(address) + 1);
+  u4 size = 1 + sizeof(address) + 4 + 6 * sizeof(address) + 4 + 2 + 2 + static_size + 2 + instance_fields_size;
+
+  writer->start_sub_record(HPROF_GC_CLASS_DUMP, size);
 
   // class ID
   writer->write_classID(ik);
@@ -1024,13 +1264,16 @@ void DumperSupport::dump_class_and_array_classes(DumpWriter* writer, Klass* k) {
   // description of instance fields
   dump_instance_field_descriptors(writer, k);
 
+  writer->end_sub_record();
+
   // array classes
   k = k->array_klass_or_null();
   while (k != NULL) {
     Klass* klass = k;
     assert(klass->is_objArray_klass(), "not an ObjArrayKlass");
 
-    writer->write_u1(HPROF_GC_CLASS_DUMP);
+    u4 size = 1 + sizeof(address) + 4 + 6 * sizeof(address) + 4 + 2 + 2 + 2;
+    writer->start_sub_record(HPROF_GC_CLASS_DUMP, size);
     writer->write_classID(klass);
     writer->write_u4(STACK_TRACE_ID);
 
@@ -1050,6 +1293,8 @@ void DumperSupport::dump_class_and_array_classes(DumpWriter* writer, Klass* k) {
     writer->write_u2(0);             // static fields
     writer->write_u2(0);             // instance fields
 
+    writer->end_sub_record();
+
     // get the array class for the next rank
     k = klass->array_klass_or_null();
   }
@@ -1062,7 +1307,8 @@ void DumperSupport::dump_basic_type_array_class(DumpWriter* writer, Klass* k) {
  while (k != NULL) {
     Klass* klass = k;
 
-    writer->write_u1(HPROF_GC_CLASS_DUMP);
+    u4 size = 1 + sizeof(address) + 4 + 6 * sizeof(address) + 4 + 2 + 2 + 2;
+    writer->start_sub_record(HPROF_GC_CLASS_DUMP, size);
     writer->write_classID(klass);
     writer->write_u4(STACK_TRACE_ID);
 
@@ -1082,6 +1328,8 @@ void DumperSupport::dump_basic_type_array_class(DumpWriter* writer, Klass* k) {
     writer->write_u2(0);             // static fields
     writer->write_u2(0);             // instance fields
 
+    writer->end_sub_record();
+
     // get the array class for the next rank
     k = klass->array_klass_or_null();
   }
@@ -1089,7 +1337,7 @@ void DumperSupport::dump_basic_type_array_class(DumpWriter* writer, Klass* k) {
 
 // Hprof uses an u4 as record length field,
 // which means we need to truncate arrays that are too long.
-int DumperSupport::calculate_array_max_length(DumpWriter* writer, arrayOop array, short header_size) {
+int DumperSupport::calculate_array_max_length(arrayOop array, short header_size) {
   BasicType type = ArrayKlass::cast(array->klass())->element_type();
   assert(type >= T_BOOLEAN && type <= T_OBJECT, "invalid array element type");
 
@@ -1104,19 +1352,9 @@ int DumperSupport::calculate_array_max_length(DumpWriter* writer, arrayOop array
 
   size_t length_in_bytes = (size_t)length * type_size;
 
-  // Create a new record if the current record is non-empty and the array can't fit.
-  julong current_record_length = writer->current_record_length();
-  if (current_record_length > 0 &&
-      (current_record_length + header_size + length_in_bytes) > max_juint) {
-    write_current_dump_record_length(writer);
-    write_dump_header(writer);
-
-    // We now have an empty record.
-    current_record_length = 0;
-  }
-
-  // Calculate max bytes we can use.
-  uint max_bytes = max_juint - (header_size + current_record_length);
+  // Calculate max bytes we can use. The sub-record is put into a dump
+  // segment of its own if it does not fit into the current one.
+  uint max_bytes = max_juint - header_size;
 
   // Array too long for the record?
   // Calculate max length and return it.
@@ -1135,9 +1373,10 @@ void DumperSupport::dump_object_array(DumpWriter* writer, objArrayOop array) {
   // sizeof(u1) + 2 * sizeof(u4) + sizeof(objectID) + sizeof(classID)
   short header_size = 1 + 2 * 4 + 2 * sizeof(address);
 
-  int length = calculate_array_max_length(writer, array, header_size);
+  int length = calculate_array_max_length(array, header_size);
+  u4 size = header_size + length * sizeof(address);
 
-  writer->write_u1(HPROF_GC_OBJ_ARRAY_DUMP);
+  writer->start_sub_record(HPROF_GC_OBJ_ARRAY_DUMP, size);
   writer->write_objectID(array);
   writer->write_u4(STACK_TRACE_ID);
   writer->write_u4(length);
@@ -1150,6 +1389,8 @@ void DumperSupport::dump_object_array(DumpWriter* writer, objArrayOop array) {
     oop o = array->obj_at(index);
     writer->write_objectID(o);
   }
+
+  writer->end_sub_record();
 }
 
 #define WRITE_ARRAY(Array, Type, Size, Length) \
@@ -1162,11 +1403,12 @@ void DumperSupport::dump_prim_array(DumpWriter* writer, typeArrayOop array) {
   // 2 * sizeof(u1) + 2 * sizeof(u4) + sizeof(objectID)
   short header_size = 2 * 1 + 2 * 4 + sizeof(address);
 
-  int length = calculate_array_max_length(writer, array, header_size);
+  int length = calculate_array_max_length(array, header_size);
   int type_size = type2aelembytes(type);
   u4 length_in_bytes = (u4)length * type_size;
+  u4 size = header_size + length_in_bytes;
 
-  writer->write_u1(HPROF_GC_PRIM_ARRAY_DUMP);
+  writer->start_sub_record(HPROF_GC_PRIM_ARRAY_DUMP, size);
   writer->write_objectID(array);
   writer->write_u4(STACK_TRACE_ID);
   writer->write_u4(length);
@@ -1174,6 +1416,7 @@ void DumperSupport::dump_prim_array(DumpWriter* writer, typeArrayOop array) {
 
   // nothing to copy
   if (length == 0) {
+    writer->end_sub_record();
     return;
   }
 
@@ -1243,6 +1486,8 @@ void DumperSupport::dump_prim_array(DumpWriter* writer, typeArrayOop array) {
     }
     default : ShouldNotReachHere();
   }
+
+  writer->end_sub_record();
 }
 
 // create a HPROF_FRAME record of the given Method* and bci
@@ -1318,10 +1563,12 @@ void JNILocalsDumper::do_oop(oop* obj_p) {
   // ignore null handles
   oop o = *obj_p;
   if (o != NULL) {
-    writer()->write_u1(HPROF_GC_ROOT_JNI_LOCAL);
+    u4 size = 1 + sizeof(address) + 4 + 4;
+    writer()->start_sub_record(HPROF_GC_ROOT_JNI_LOCAL, size);
     writer()->write_objectID(o);
     writer()->write_u4(_thread_serial_num);
     writer()->write_u4((u4)_frame_num);
+    writer()->end_sub_record();
   }
 }
 
@@ -1349,9 +1596,11 @@ void JNIGlobalsDumper::do_oop(oop* obj_p) {
 
   // we ignore global ref to symbols and other internal objects
   if (o->is_instance() || o->is_objArray() || o->is_typeArray()) {
-    writer()->write_u1(HPROF_GC_ROOT_JNI_GLOBAL);
+    u4 size = 1 + 2 * sizeof(address);
+    writer()->start_sub_record(HPROF_GC_ROOT_JNI_GLOBAL, size);
     writer()->write_objectID(o);
     writer()->write_objectID((oopDesc*)obj_p);      // global ref ID
+    writer()->end_sub_record();
   }
 };
 
@@ -1367,8 +1616,10 @@ class MonitorUsedDumper : public OopClosure {
     _writer = writer;
   }
   void do_oop(oop* obj_p) {
-    writer()->write_u1(HPROF_GC_ROOT_MONITOR_USED);
+    u4 size = 1 + sizeof(address);
+    writer()->start_sub_record(HPROF_GC_ROOT_MONITOR_USED, size);
     writer()->write_objectID(*obj_p);
+    writer()->end_sub_record();
   }
   void do_oop(narrowOop* obj_p) { ShouldNotReachHere(); }
 };
@@ -1387,31 +1638,25 @@ class StickyClassDumper : public KlassClosure {
   void do_klass(Klass* k) {
     if (k->is_instance_klass()) {
       InstanceKlass* ik = InstanceKlass::cast(k);
-        writer()->write_u1(HPROF_GC_ROOT_STICKY_CLASS);
+        u4 size = 1 + sizeof(address);
+        writer()->start_sub_record(HPROF_GC_ROOT_STICKY_CLASS, size);
         writer()->write_classID(ik);
+        writer()->end_sub_record();
       }
     }
 };
 
 
-class VM_HeapDumper;
-
 // Support class using when iterating over the heap.
 
 class HeapObjectDumper : public ObjectClosure {
  private:
-  VM_HeapDumper* _dumper;
   DumpWriter* _writer;
 
-  VM_HeapDumper* dumper()               { return _dumper; }
   DumpWriter* writer()                  { return _writer; }
 
-  // used to indicate that a record has been writen
-  void mark_end_of_record();
-
  public:
-  HeapObjectDumper(VM_HeapDumper* dumper, DumpWriter* writer) {
-    _dumper = dumper;
+  HeapObjectDumper(DumpWriter* writer) {
     _writer = writer;
   }
 
@@ -1430,30 +1675,126 @@ void HeapObjectDumper::do_object(oop o) {
   if (o->is_instance()) {
     // create a HPROF_GC_INSTANCE record for each object
     DumperSupport::dump_instance(writer(), o);
-    mark_end_of_record();
   } else if (o->is_objArray()) {
     // create a HPROF_GC_OBJ_ARRAY_DUMP record for each object array
     DumperSupport::dump_object_array(writer(), objArrayOop(o));
-    mark_end_of_record();
   } else if (o->is_typeArray()) {
     // create a HPROF_GC_PRIM_ARRAY_DUMP record for each type array
     DumperSupport::dump_prim_array(writer(), typeArrayOop(o));
-    mark_end_of_record();
   }
 }
 
+// Size of the blocks compressed independently in a compressed heap dump
+static const size_t compression_block_size = 1 * M;
+
+// Returns the name of the segment file written by the given worker of a
+// parallel heap dump to the given dump file.
+static void segment_file_path(char* buf, size_t len, const char* path, uint worker_id) {
+  jio_snprintf(buf, len, "%s.p%u", path, worker_id);
+}
+
+// Gang task used to dump the heap objects with the help of the GC worker
+// threads. The first workers are dumpers which iterate over the heap. A
+// single dumper writes the objects to the dump file directly. Otherwise each
+// dumper writes its share of the heap as HPROF_HEAP_DUMP_SEGMENT records to a
+// segment file of its own, and the segment files are appended to the dump
+// file once the VM operation has completed. The remaining workers compress
+// the blocks written by the dumpers if the dump is compressed.
+class HeapDumpTask : public AbstractGangTask {
+ private:
+  ParallelObjectIterator* _poi;        // NULL for a single dumper
+  DumpWriter*             _writer;     // writer of the dump file
+  CompressionBackend*     _backend;    // NULL if the dump is not compressed
+  const char*             _path;
+  uint                    _num_dumpers;
+  uint                    _max_in_flight;
+  volatile uint           _dumpers_left;
+  char* volatile          _error;      // first error reported by a dumper
+
+  void set_error(const char* error) {
+    char* e = os::strdup(error);
+    if (Atomic::cmpxchg(e, &_error, (char*)NULL) != NULL) {
+      os::free(e);
+    }
+  }
+
+  void dump_segment_file(uint worker_id) {
+    char path[JVM_MAXPATHLEN];
+    segment_file_path(path, sizeof(path), _path, worker_id);
+
+    DumpWriter writer(path, _backend);
+    if (!writer.is_open()) {
+      set_error(writer.error());
+      return;
+    }
+    writer.set_max_in_flight(_max_in_flight);
+    HeapObjectDumper obj_dumper(&writer);
+    _poi->object_iterate(&obj_dumper, worker_id);
+    writer.finish_dump_segment();
+
+    writer.close();
+    if (writer.error() != NULL) {
+      set_error(writer.error());
+    }
+  }
+
+ public:
+  HeapDumpTask(ParallelObjectIterator* poi, DumpWriter* writer, CompressionBackend* backend,
+               const char* path, uint num_dumpers, uint max_in_flight) :
+    AbstractGangTask("Heap Dump"),
+    _poi(poi),
+    _writer(writer),
+    _backend(backend),
+    _path(path),
+    _num_dumpers(num_dumpers),
+    _max_in_flight(max_in_flight),
+    _dumpers_left(num_dumpers),
+    _error(NULL) { }
+
+  ~HeapDumpTask() {
+    if (_error != NULL) os::free(_error);
+  }
+
+  char* error() const { return _error; }
+
+  virtual void work(uint worker_id) {
+    if (worker_id >= _num_dumpers) {
+      assert(_backend != NULL, "compression workers need a backend");
+      _backend->thread_loop();
+      return;
+    }
+
+    if (_poi == NULL) {
+      HeapObjectDumper obj_dumper(_writer);
+      Universe::heap()->safe_object_iterate(&obj_dumper);
+    } else {
+      dump_segment_file(worker_id);
+    }
+
+    // the last dumper lets the compression workers go
+    if (Atomic::sub(1u, &_dumpers_left) == 0 && _backend != NULL) {
+      _backend->deactivate();
+    }
+  }
+};
+
 // The VM operation that performs the heap dump
 class VM_HeapDumper : public VM_GC_Operation {
  private:
   static VM_HeapDumper* _global_dumper;
   static DumpWriter*    _global_writer;
   DumpWriter*           _local_writer;
+  CompressionBackend*   _backend;
   JavaThread*           _oome_thread;
   Method*               _oome_constructor;
   bool _gc_before_heap_dump;
   GrowableArray<Klass*>* _klass_map;
   ThreadStackTrace** _stack_traces;
   int _num_threads;
+  const char* _path;
+  uint _num_dump_threads;    // requested number of heap dump threads
+  uint _num_segments;        // number of segment files written
+  char* _segment_error;      // error writing the segment files
 
   // accessors and setters
   static VM_HeapDumper* dumper()         {  assert(_global_dumper != NULL, "Error"); return _global_dumper; }
@@ -1494,17 +1835,27 @@ class VM_HeapDumper : public VM_GC_Operation {
   // HPROF_TRACE and HPROF_FRAME records
   void dump_stack_traces();
 
+  // HPROF_GC_INSTANCE_DUMP, HPROF_GC_OBJ_ARRAY_DUMP and
+  // HPROF_GC_PRIM_ARRAY_DUMP records
+  void dump_heap_objects();
+
  public:
-  VM_HeapDumper(DumpWriter* writer, bool gc_before_heap_dump, bool oome) :
+  VM_HeapDumper(DumpWriter* writer, CompressionBackend* backend, bool gc_before_heap_dump,
+                bool oome, const char* path, uint num_dump_threads) :
     VM_GC_Operation(0 /* total collections,      dummy, ignored */,
                     GCCause::_heap_dump /* GC Cause */,
                     0 /* total full collections, dummy, ignored */,
                     gc_before_heap_dump) {
     _local_writer = writer;
+    _backend = backend;
     _gc_before_heap_dump = gc_before_heap_dump;
     _klass_map = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<Klass*>(INITIAL_CLASS_COUNT, true);
     _stack_traces = NULL;
     _num_threads = 0;
+    _path = path;
+    _num_dump_threads = num_dump_threads;
+    _num_segments = 0;
+    _segment_error = NULL;
     if (oome) {
       assert(!Thread::current()->is_VM_thread(), "Dump from OutOfMemoryError cannot be called by the VMThread");
       // get OutOfMemoryError zero-parameter constructor
@@ -1526,11 +1877,16 @@ class VM_HeapDumper : public VM_GC_Operation {
       FREE_C_HEAP_ARRAY(ThreadStackTrace*, _stack_traces);
     }
     delete _klass_map;
+    if (_segment_error != NULL) {
+      os::free(_segment_error);
+    }
   }
 
+  // number of segment files written by a parallel heap dump
+  uint num_segments() const   { return _num_segments; }
+  char* segment_error() const { return _segment_error; }
+
   VMOp_Type type() const { return VMOp_HeapDumper; }
-  // used to mark sub-record boundary
-  void check_segment_length();
   void doit();
 };
 
@@ -1541,72 +1897,13 @@ bool VM_HeapDumper::skip_operation() const {
   return false;
 }
 
- // writes a HPROF_HEAP_DUMP_SEGMENT record
-void DumperSupport::write_dump_header(DumpWriter* writer) {
-  if (writer->is_open()) {
-    writer->write_u1(HPROF_HEAP_DUMP_SEGMENT);
-    writer->write_u4(0); // current ticks
-
-    // record the starting position for the dump (its length will be fixed up later)
-    writer->set_dump_start(writer->current_offset());
-    writer->write_u4(0);
-  }
-}
-
-// fixes up the length of the current dump record
-void DumperSupport::write_current_dump_record_length(DumpWriter* writer) {
-  if (writer->is_open()) {
-    julong dump_end = writer->bytes_written() + writer->bytes_unwritten();
-    julong dump_len = writer->current_record_length();
-
-    // record length must fit in a u4
-    if (dump_len > max_juint) {
-      warning("record is too large");
-    }
-
-    // seek to the dump start and fix-up the length
-    assert(writer->dump_start() >= 0, "no dump start recorded");
-    writer->seek_to_offset(writer->dump_start());
-    writer->write_u4((u4)dump_len);
-
-    // adjust the total size written to keep the bytes written correct.
-    writer->adjust_bytes_written(-((jlong) sizeof(u4)));
-
-    // seek to dump end so we can continue
-    writer->seek_to_offset(dump_end);
-
-    // no current dump record
-    writer->set_dump_start((jlong)-1);
-  }
-}
-
-// used on a sub-record boundary to check if we need to start a
-// new segment.
-void VM_HeapDumper::check_segment_length() {
-  if (writer()->is_open()) {
-    julong dump_len = writer()->current_record_length();
-
-    if (dump_len > 2UL*G) {
-      DumperSupport::write_current_dump_record_length(writer());
-      DumperSupport::write_dump_header(writer());
-    }
-  }
-}
-
-// fixes up the current dump record and writes HPROF_HEAP_DUMP_END record
+// finishes the current dump segment and writes HPROF_HEAP_DUMP_END record
 void DumperSupport::end_of_dump(DumpWriter* writer) {
-  if (writer->is_open()) {
-    write_current_dump_record_length(writer);
+  writer->finish_dump_segment();
 
-    writer->write_u1(HPROF_HEAP_DUMP_END);
-    writer->write_u4(0);
-    writer->write_u4(0);
-  }
-}
-
-// marks sub-record boundary
-void HeapObjectDumper::mark_end_of_record() {
-  dumper()->check_segment_length();
+  writer->write_u1(HPROF_HEAP_DUMP_END);
+  writer->write_u4(0);
+  writer->write_u4(0);
 }
 
 // writes a HPROF_LOAD_CLASS record for the class (and each of its
@@ -1696,10 +1993,12 @@ int VM_HeapDumper::do_thread(JavaThread* java_thread, u4 thread_serial_num) {
               oop o = locals->obj_at(slot)();
 
               if (o != NULL) {
-                writer()->write_u1(HPROF_GC_ROOT_JAVA_FRAME);
+                u4 size = 1 + sizeof(address) + 4 + 4;
+                writer()->start_sub_record(HPROF_GC_ROOT_JAVA_FRAME, size);
                 writer()->write_objectID(o);
                 writer()->write_u4(thread_serial_num);
                 writer()->write_u4((u4) (stack_depth + extra_frames));
+                writer()->end_sub_record();
               }
             }
           }
@@ -1708,10 +2007,12 @@ int VM_HeapDumper::do_thread(JavaThread* java_thread, u4 thread_serial_num) {
             if (exprs->at(index)->type() == T_OBJECT) {
                oop o = exprs->obj_at(index)();
                if (o != NULL) {
-                 writer()->write_u1(HPROF_GC_ROOT_JAVA_FRAME);
+                 u4 size = 1 + sizeof(address) + 4 + 4;
+                 writer()->start_sub_record(HPROF_GC_ROOT_JAVA_FRAME, size);
                  writer()->write_objectID(o);
                  writer()->write_u4(thread_serial_num);
                  writer()->write_u4((u4) (stack_depth + extra_frames));
+                 writer()->end_sub_record();
                }
              }
           }
@@ -1759,10 +2060,12 @@ void VM_HeapDumper::do_threads() {
     oop threadObj = thread->threadObj();
     u4 thread_serial_num = i+1;
     u4 stack_serial_num = thread_serial_num + STACK_TRACE_ID;
-    writer()->write_u1(HPROF_GC_ROOT_THREAD_OBJ);
+    u4 size = 1 + sizeof(address) + 4 + 4;
+    writer()->start_sub_record(HPROF_GC_ROOT_THREAD_OBJ, size);
     writer()->write_objectID(threadObj);
     writer()->write_u4(thread_serial_num);  // thread number
     writer()->write_u4(stack_serial_num);   // stack trace serial number
+    writer()->end_sub_record();
     int num_frames = do_thread(thread, thread_serial_num);
     assert(num_frames == _stack_traces[i]->get_stack_depth(),
            "total number of Java frames not matched");
@@ -1781,18 +2084,28 @@ void VM_HeapDumper::do_threads() {
 //  [HPROF_HEAP_DUMP_SEGMENT]*
 //  HPROF_HEAP_DUMP_END
 //
+// The HPROF_HEAP_DUMP_END record is written by HeapDumper::dump once
+// the VM operation has completed.
+//
 // The HPROF_TRACE records represent the stack traces where the heap dump
 // is generated and a "dummy trace" record which does not include
 // any frames. The dummy trace record is used to be referenced as the
 // unknown object alloc site.
 //
 // Each HPROF_HEAP_DUMP_SEGMENT record has a length followed by sub-records.
-// To allow the heap dump be generated in a single pass we remember the position
-// of the dump length and fix it up after all sub-records have been written.
+// To allow the heap dump be generated in a single pass, the DumpWriter
+// assembles each segment in its buffer and fixes up the length before the
+// buffer is written out (see DumpWriter::start_sub_record).
 // To generate the sub-records we iterate over the heap, writing
 // HPROF_GC_INSTANCE_DUMP, HPROF_GC_OBJ_ARRAY_DUMP, and HPROF_GC_PRIM_ARRAY_DUMP
 // records as we go. Once that is done we write records for some of the GC
 // roots.
+//
+// In a parallel heap dump the heap iteration is split across the GC worker
+// threads. Each worker writes complete HPROF_HEAP_DUMP_SEGMENT records to a
+// segment file of its own, and the segment files are appended to the dump
+// file after the GC roots by HeapDumper::dump. In a compressed heap dump the
+// GC worker threads not iterating the heap compress the written blocks.
 
 void VM_HeapDumper::doit() {
 
@@ -1840,41 +2153,31 @@ void VM_HeapDumper::doit() {
   // this must be called after _klass_map is built when iterating the classes above.
   dump_stack_traces();
 
-  // write HPROF_HEAP_DUMP_SEGMENT
-  DumperSupport::write_dump_header(writer());
-
-  // Writes HPROF_GC_CLASS_DUMP records
+  // Writes HPROF_GC_CLASS_DUMP records. The sub-records are written to
+  // HPROF_HEAP_DUMP_SEGMENT records started by the writer as needed.
   {
     LockedClassesDo locked_dump_class(&do_class_dump);
     ClassLoaderDataGraph::classes_do(&locked_dump_class);
   }
   Universe::basic_type_classes_do(&do_basic_type_array_class_dump);
-  check_segment_length();
 
   // writes HPROF_GC_INSTANCE_DUMP records.
-  // After each sub-record is written check_segment_length will be invoked
-  // to check if the current segment exceeds a threshold. If so, a new
-  // segment is started.
   // The HPROF_GC_CLASS_DUMP and HPROF_GC_INSTANCE_DUMP are the vast bulk
   // of the heap dump.
-  HeapObjectDumper obj_dumper(this, writer());
-  Universe::heap()->safe_object_iterate(&obj_dumper);
+  dump_heap_objects();
 
   // HPROF_GC_ROOT_THREAD_OBJ + frames + jni locals
   do_threads();
-  check_segment_length();
 
   // HPROF_GC_ROOT_MONITOR_USED
   MonitorUsedDumper mon_dumper(writer());
   ObjectSynchronizer::oops_do(&mon_dumper);
-  check_segment_length();
 
   // HPROF_GC_ROOT_JNI_GLOBAL
   JNIGlobalsDumper jni_dumper(writer());
   JNIHandles::oops_do(&jni_dumper);
   Universe::oops_do(&jni_dumper);  // technically not jni roots, but global roots
                                    // for things like preallocated throwable backtraces
-  check_segment_length();
 
   // HPROF_GC_ROOT_STICKY_CLASS
   // These should be classes in the NULL class loader data, and not all classes
@@ -1882,14 +2185,55 @@ void VM_HeapDumper::doit() {
   StickyClassDumper class_dumper(writer());
   ClassLoaderData::the_null_class_loader_data()->classes_do(&class_dumper);
 
-  // fixes up the length of the dump record and writes the HPROF_HEAP_DUMP_END record.
-  DumperSupport::end_of_dump(writer());
+  // finishes the current dump segment. The HPROF_HEAP_DUMP_END record is
+  // written after the segment files of a parallel dump have been merged.
+  writer()->finish_dump_segment();
 
   // Now we clear the global variables, so that a future dumper might run.
   clear_global_dumper();
   clear_global_writer();
 }
 
+void VM_HeapDumper::dump_heap_objects() {
+  CollectedHeap* ch = Universe::heap();
+  WorkGang* workers = ch->get_safepoint_workers();
+  uint total_workers = (workers != NULL) ? workers->total_workers() : 1;
+
+  ParallelObjectIterator* poi = NULL;
+  uint num_dumpers = MIN2(_num_dump_threads, total_workers);
+  if (num_dumpers > 1) {
+    poi = ch->parallel_object_iterator(num_dumpers);
+    if (poi == NULL) {
+      // the collector can not iterate the heap in parallel
+      num_dumpers = 1;
+    }
+  }
+  uint num_compressors = (_backend != NULL) ? total_workers - num_dumpers : 0;
+
+  if (num_dumpers == 1 && num_compressors == 0) {
+    HeapObjectDumper obj_dumper(writer());
+    ch->safe_object_iterate(&obj_dumper);
+    return;
+  }
+
+  // keep enough blocks in flight for the compression workers
+  uint max_in_flight = num_compressors / num_dumpers + 2;
+  if (num_dumpers == 1) {
+    writer()->set_max_in_flight(max_in_flight);
+  }
+
+  HeapDumpTask task(poi, writer(), _backend, _path, num_dumpers, max_in_flight);
+  workers->run_task(&task, num_dumpers + num_compressors);
+
+  if (poi != NULL) {
+    delete poi;
+    _num_segments = num_dumpers;
+  }
+  if (task.error() != NULL) {
+    _segment_error = os::strdup(task.error());
+  }
+}
+
 void VM_HeapDumper::dump_stack_traces() {
   // write a HPROF_TRACE record without any frames to be referenced as object alloc sites
   DumperSupport::write_header(writer(), HPROF_TRACE, 3*sizeof(u4));
@@ -1945,7 +2289,7 @@ void VM_HeapDumper::dump_stack_traces() {
 }
 
 // dump the heap to given path.
-int HeapDumper::dump(const char* path) {
+int HeapDumper::dump(const char* path, uint parallel_thread_num, int compression) {
   assert(path != NULL && strlen(path) > 0, "path missing");
 
   // print message in interactive case
@@ -1954,8 +2298,29 @@ int HeapDumper::dump(const char* path) {
     timer()->start();
   }
 
+  // the compression backend must outlive the dump writer
+  CompressionBackend* backend = NULL;
+  if (compression > 0) {
+    backend = new CompressionBackend(new GZipCompressor(compression), compression_block_size);
+    if (backend->error() != NULL) {
+      set_error((char*)backend->error());
+      if (print_to_tty()) {
+        tty->print_cr("Unable to initialize compression: %s", error());
+      }
+      delete backend;
+      return -1;
+    }
+  }
+
+  int res = dump_with_backend(path, backend, parallel_thread_num);
+  delete backend;
+  return res;
+}
+
+int HeapDumper::dump_with_backend(const char* path, CompressionBackend* backend,
+                                  uint parallel_thread_num) {
   // create the dump writer. If the file can be opened then bail
-  DumpWriter writer(path);
+  DumpWriter writer(path, backend);
   if (!writer.is_open()) {
     set_error(writer.error());
     if (print_to_tty()) {
@@ -1966,7 +2331,7 @@ int HeapDumper::dump(const char* path) {
   }
 
   // generate the dump
-  VM_HeapDumper dumper(&writer, _gc_before_heap_dump, _oome);
+  VM_HeapDumper dumper(&writer, backend, _gc_before_heap_dump, _oome, path, parallel_thread_num);
   if (Thread::current()->is_VM_thread()) {
     assert(SafepointSynchronize::is_at_safepoint(), "Expected to be called at a safepoint");
     dumper.doit();
@@ -1974,9 +2339,20 @@ int HeapDumper::dump(const char* path) {
     VMThread::execute(&dumper);
   }
 
+  // append the segment files of a parallel dump, outside of the safepoint
+  for (uint i = 0; i < dumper.num_segments(); i++) {
+    char segment_path[JVM_MAXPATHLEN];
+    segment_file_path(segment_path, sizeof(segment_path), path, i);
+    writer.append_file(segment_path);
+    remove(segment_path);
+  }
+
+  // writes the HPROF_HEAP_DUMP_END record
+  DumperSupport::end_of_dump(&writer);
+
   // close dump file and record any error that the writer may have encountered
   writer.close();
-  set_error(writer.error());
+  set_error(dumper.segment_error() != NULL ? dumper.segment_error() : writer.error());
 
   // print message in interactive case
   if (print_to_tty()) {
@@ -1985,11 +2361,11 @@ int HeapDumper::dump(const char* path) {
       tty->print_cr("Heap dump file created [" JULONG_FORMAT " bytes in %3.3f secs]",
                     writer.bytes_written(), timer()->seconds());
     } else {
-      tty->print_cr("Dump file is incomplete: %s", writer.error());
+      tty->print_cr("Dump file is incomplete: %s", error());
     }
   }
 
-  return (writer.error() == NULL) ? 0 : -1;
+  return (error() == NULL) ? 0 : -1;
 }
 
 // stop timer (if still active), and free any error string we might be holding
@@ -2115,6 +2491,6 @@ void HeapDumper::dump_heap(bool oome) {
   HeapDumper dumper(false /* no GC before heap dump */,
                     true  /* send to tty */,
                     oome  /* pass along out-of-memory-error flag */);
-  dumper.dump(my_path);
+  dumper.dump(my_path, 1 /* serial heap iteration */, (int)HeapDumpGzipLevel);
   os::free(my_path);
 }
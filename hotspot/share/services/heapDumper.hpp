@@ -29,6 +29,8 @@
 #include "oops/oop.hpp"
 #include "runtime/os.hpp"
 
+class CompressionBackend;
+
 // HeapDumper is used to dump the java heap to file in HPROF binary format:
 //
 //  { HeapDumper dumper(true /* full GC before heap dump */);
@@ -64,6 +66,9 @@ class HeapDumper : public StackObj {
 
   static void dump_heap(bool oome);
 
+  int dump_with_backend(const char* path, CompressionBackend* backend,
+                        uint parallel_thread_num);
+
  public:
   HeapDumper(bool gc_before_heap_dump) :
     _error(NULL), _print_to_tty(false), _gc_before_heap_dump(gc_before_heap_dump), _oome(false) { }
@@ -71,7 +76,12 @@ class HeapDumper : public StackObj {
   ~HeapDumper();
 
   // dumps the heap to the specified file, returns 0 if success.
-  int dump(const char* path);
+  // If parallel_thread_num is greater than one and the collector supports
+  // parallel object iteration, the heap is iterated by up to that many
+  // GC worker threads. If compression is between 1 and 9, the dump file is
+  // gzip compressed with that level, in blocks which can be decompressed
+  // independently.
+  int dump(const char* path, uint parallel_thread_num = 1, int compression = 0);
 
   // returns error message (resource allocated), or NULL if no error
   char* error_as_C_string() const;
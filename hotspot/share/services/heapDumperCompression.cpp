@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "jvm.h"
+#include "runtime/arguments.hpp"
+#include "runtime/mutex.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "services/heapDumperCompression.hpp"
+
+typedef char const* (*GzipInitFunc)(size_t, size_t*, size_t*, int);
+typedef size_t(*GzipCompressFunc)(char*, size_t, char*, size_t, char*, size_t,
+                                  int, char*, char const**);
+
+static GzipInitFunc gzip_init_func = NULL;
+static GzipCompressFunc gzip_compress_func = NULL;
+
+static void* load_gzip_func(char const* name) {
+  char path[JVM_MAXPATHLEN];
+  char ebuf[1024];
+  void* handle;
+
+  // make sure the native java library is loaded first
+  os::native_java_library();
+  if (os::dll_locate_lib(path, sizeof(path), Arguments::get_dll_dir(), "zip")) {
+    handle = os::dll_load(path, ebuf, sizeof ebuf);
+
+    if (handle != NULL) {
+      return os::dll_lookup(handle, name);
+    }
+  }
+
+  return NULL;
+}
+
+char const* GZipCompressor::init(size_t block_size, size_t* needed_out_size,
+                                 size_t* needed_tmp_size) {
+  _block_size = block_size;
+
+  if (gzip_init_func == NULL) {
+    gzip_init_func = (GzipInitFunc) load_gzip_func("ZIP_GZip_InitParams");
+  }
+  if (gzip_compress_func == NULL) {
+    gzip_compress_func = (GzipCompressFunc) load_gzip_func("ZIP_GZip_Fully");
+  }
+  if (gzip_init_func == NULL || gzip_compress_func == NULL) {
+    return "Cannot get gzip functions";
+  }
+
+  return gzip_init_func(block_size, needed_out_size, needed_tmp_size, _level);
+}
+
+char const* GZipCompressor::compress(char* in, size_t in_size, char* out, size_t out_size,
+                                     char* tmp, size_t tmp_size, size_t* compressed_size) {
+  char const* msg = NULL;
+  char buf[128];
+
+  // Record the block size in every gzip header, so that a parser can
+  // start decompressing at any block.
+  jio_snprintf(buf, sizeof(buf), "HPROF BLOCKSIZE=" SIZE_FORMAT, _block_size);
+  *compressed_size = gzip_compress_func(in, in_size, out, out_size, tmp, tmp_size, _level,
+                                        buf, &msg);
+
+  return msg;
+}
+
+CompressionBackend::CompressionBackend(AbstractCompressor* compressor, size_t block_size) :
+  _lock(new Monitor(Mutex::leaf, "HProf Compression Backend", true,
+                    Mutex::_safepoint_check_never)),
+  _compressor(compressor),
+  _in_size(block_size),
+  _out_size(0),
+  _tmp_size(0),
+  _pending_head(NULL),
+  _pending_tail(NULL),
+  _active_workers(0),
+  _deactivated(false),
+  _error(NULL) {
+  _error = _compressor->init(_in_size, &_out_size, &_tmp_size);
+}
+
+CompressionBackend::~CompressionBackend() {
+  assert(_pending_head == NULL, "all blocks must have been written");
+  assert(_active_workers == 0, "all workers must have left");
+  delete _compressor;
+  delete _lock;
+}
+
+CompressionWork* CompressionBackend::allocate_work() {
+  CompressionWork* work = new (std::nothrow) CompressionWork();
+  if (work == NULL) {
+    return NULL;
+  }
+  work->_in = (char*) os::malloc(_in_size, mtInternal);
+  work->_out = (char*) os::malloc(_out_size, mtInternal);
+  work->_tmp = _tmp_size > 0 ? (char*) os::malloc(_tmp_size, mtInternal) : NULL;
+  if (work->_in == NULL || work->_out == NULL || (_tmp_size > 0 && work->_tmp == NULL)) {
+    free_work(work);
+    return NULL;
+  }
+  return work;
+}
+
+void CompressionBackend::free_work(CompressionWork* work) {
+  if (work != NULL) {
+    os::free(work->_in);
+    os::free(work->_out);
+    os::free(work->_tmp);
+    delete work;
+  }
+}
+
+// Removes the first block not yet claimed from the queue and claims it.
+// Must be called with the lock held.
+CompressionWork* CompressionBackend::claim_pending() {
+  while (_pending_head != NULL) {
+    CompressionWork* work = _pending_head;
+    _pending_head = work->_next_pending;
+    if (_pending_head == NULL) {
+      _pending_tail = NULL;
+    }
+    work->_next_pending = NULL;
+    // blocks claimed by their writer are left in the queue
+    if (work->_state == CompressionWork::Pending) {
+      work->_state = CompressionWork::Compressing;
+      return work;
+    }
+  }
+  return NULL;
+}
+
+void CompressionBackend::do_compress(CompressionWork* work) {
+  assert(work->_state == CompressionWork::Compressing, "must be claimed");
+  size_t compressed_size = 0;
+  char const* msg = _compressor->compress(work->_in, work->_in_used, work->_out, _out_size,
+                                          work->_tmp, _tmp_size, &compressed_size);
+
+  MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+  if (msg != NULL) {
+    if (_error == NULL) {
+      _error = msg;
+    }
+    compressed_size = 0;
+  }
+  work->_out_used = compressed_size;
+  work->_state = CompressionWork::Done;
+  ml.notify_all();
+}
+
+void CompressionBackend::submit(CompressionWork* work) {
+  assert(work->_state == CompressionWork::Idle, "must not be submitted twice");
+  {
+    MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+    if (_active_workers > 0 && !_deactivated) {
+      work->_state = CompressionWork::Pending;
+      if (_pending_tail == NULL) {
+        _pending_head = work;
+      } else {
+        _pending_tail->_next_pending = work;
+      }
+      _pending_tail = work;
+      ml.notify_all();
+      return;
+    }
+    work->_state = CompressionWork::Compressing;
+  }
+  // no worker thread available
+  do_compress(work);
+}
+
+void CompressionBackend::wait_for(CompressionWork* work) {
+  {
+    MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+    if (work->_state == CompressionWork::Pending) {
+      // claim the block; the workers skip it when taking it off the queue
+      work->_state = CompressionWork::Compressing;
+    } else {
+      while (work->_state != CompressionWork::Done) {
+        ml.wait();
+      }
+      work->_state = CompressionWork::Idle;
+      return;
+    }
+  }
+  do_compress(work);
+  MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+  work->_state = CompressionWork::Idle;
+}
+
+void CompressionBackend::thread_loop() {
+  {
+    MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+    _active_workers++;
+  }
+
+  while (true) {
+    CompressionWork* work = NULL;
+    {
+      MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+      while ((work = claim_pending()) == NULL && !_deactivated) {
+        ml.wait();
+      }
+      if (work == NULL) {
+        _active_workers--;
+        ml.notify_all();
+        return;
+      }
+    }
+    do_compress(work);
+  }
+}
+
+void CompressionBackend::deactivate() {
+  MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+  _deactivated = true;
+  ml.notify_all();
+}
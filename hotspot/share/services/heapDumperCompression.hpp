@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_SERVICES_HEAPDUMPERCOMPRESSION_HPP
+#define SHARE_SERVICES_HEAPDUMPERCOMPRESSION_HPP
+
+#include "memory/allocation.hpp"
+
+class Monitor;
+
+// Interface for a compression implementation.
+class AbstractCompressor : public CHeapObj<mtInternal> {
+ public:
+  virtual ~AbstractCompressor() { }
+
+  // Initializes the compressor. Returns a static error message in case of an
+  // error. Otherwise sets the needed out and tmp size for the given block size.
+  virtual char const* init(size_t block_size, size_t* needed_out_size,
+                           size_t* needed_tmp_size) = 0;
+
+  // Compresses a single block. Returns NULL on success and a static error
+  // message otherwise. Sets compressed_size on success. Must be thread-safe,
+  // since the blocks of a dump are compressed by several threads.
+  virtual char const* compress(char* in, size_t in_size, char* out, size_t out_size,
+                               char* tmp, size_t tmp_size, size_t* compressed_size) = 0;
+};
+
+// Compresses the blocks using gzip, with the zlib bundled in libzip. Each
+// block is written as a gzip member of its own, so every block can be
+// decompressed independently. The block size is recorded in the comment of
+// each gzip header, which lets parsers access the dump randomly.
+class GZipCompressor : public AbstractCompressor {
+ private:
+  int _level;
+  size_t _block_size;
+
+ public:
+  GZipCompressor(int level) : _level(level), _block_size(0) { }
+
+  virtual char const* init(size_t block_size, size_t* needed_out_size,
+                           size_t* needed_tmp_size);
+
+  virtual char const* compress(char* in, size_t in_size, char* out, size_t out_size,
+                               char* tmp, size_t tmp_size, size_t* compressed_size);
+};
+
+// A block of the dump which is compressed by the CompressionBackend. The
+// block is filled by its DumpWriter, compressed by either a worker thread or
+// the writer itself, and then written out by the writer.
+class CompressionWork : public CHeapObj<mtInternal> {
+  friend class CompressionBackend;
+
+ private:
+  enum State {
+    Idle,           // being filled by the writer
+    Pending,        // queued for compression
+    Compressing,    // claimed by a thread for compression
+    Done            // compressed (or failed to)
+  };
+
+  char* _in;
+  size_t _in_used;
+  char* _out;
+  size_t _out_used;
+  char* _tmp;
+  State _state;                    // protected by the backend lock
+  CompressionWork* _next_pending;  // next work in the queue of the backend
+  CompressionWork* _next;          // owned by the writer
+
+  CompressionWork() : _in(NULL), _in_used(0), _out(NULL), _out_used(0), _tmp(NULL),
+                      _state(Idle), _next_pending(NULL), _next(NULL) { }
+
+ public:
+  char* in() const                      { return _in; }
+  size_t in_used() const                { return _in_used; }
+  void set_in_used(size_t used)         { _in_used = used; }
+  char* out() const                     { return _out; }
+  size_t out_used() const               { return _out_used; }
+
+  CompressionWork* next() const         { return _next; }
+  void set_next(CompressionWork* next)  { _next = next; }
+};
+
+// Compresses the blocks of a heap dump, possibly in several threads.
+//
+// The backend is shared by all DumpWriters of a dump. A writer submits each
+// filled block and stays responsible for writing the compressed blocks to
+// its file in submission order. While worker threads run thread_loop(),
+// submitted blocks are compressed in the background; otherwise, or when the
+// writer needs a block that has not been claimed yet, the writer compresses
+// it itself.
+class CompressionBackend : public CHeapObj<mtInternal> {
+ private:
+  Monitor* _lock;
+  AbstractCompressor* _compressor;
+  size_t _in_size;
+  size_t _out_size;
+  size_t _tmp_size;
+  CompressionWork* _pending_head;
+  CompressionWork* _pending_tail;
+  uint _active_workers;     // number of threads in thread_loop()
+  bool _deactivated;        // no more background compression
+  char const* _error;       // first compression error
+
+  CompressionWork* claim_pending();
+  void do_compress(CompressionWork* work);
+
+ public:
+  // Takes ownership of the compressor.
+  CompressionBackend(AbstractCompressor* compressor, size_t block_size);
+  ~CompressionBackend();
+
+  // Returns a static error message if the backend could not be initialized
+  // or a block failed to compress, NULL otherwise.
+  char const* error() const             { return _error; }
+
+  size_t block_size() const             { return _in_size; }
+
+  // Allocates a new block, returns NULL if out of memory.
+  CompressionWork* allocate_work();
+  void free_work(CompressionWork* work);
+
+  // Hands a filled block to the backend. The block is compressed right away
+  // if there is no worker thread to do it.
+  void submit(CompressionWork* work);
+
+  // Waits until the given block has been compressed, compressing it in the
+  // calling thread if no other thread has claimed it yet.
+  void wait_for(CompressionWork* work);
+
+  // Run by worker threads: compresses submitted blocks until deactivate() is
+  // called and no block is pending.
+  void thread_loop();
+
+  // Makes the worker threads leave thread_loop() once the pending blocks have
+  // been claimed. Blocks submitted afterwards are compressed by the writers.
+  void deactivate();
+};
+
+#endif // SHARE_SERVICES_HEAPDUMPERCOMPRESSION_HPP
@@ -47,6 +47,8 @@ class MallocSite : public AllocationSite<MemoryCounter> {
 
   void allocate(size_t size)      { data()->allocate(size);   }
   void deallocate(size_t size)    { data()->deallocate(size); }
+  // Estimate for all allocations from the sampled ones
+  void scale(size_t factor)       { data()->scale(factor);    }
 
   // Memory allocated from this code path
   size_t size()  const { return peek()->size(); }
@@ -77,6 +77,12 @@ class MemoryCounter {
     }
   }
 
+  // Scales a copy of a counter that is not updated concurrently
+  inline void scale(size_t factor) {
+    _count *= factor;
+    _size *= factor;
+  }
+
   inline size_t count() const { return _count; }
   inline size_t size()  const { return _size;  }
   DEBUG_ONLY(inline size_t peak_count() const { return _peak_count; })
@@ -250,6 +256,7 @@ class MallocHeader {
   size_t           _bucket_idx: 40;
 #define MAX_MALLOCSITE_TABLE_SIZE right_n_bits(40)
 #define MAX_BUCKET_LENGTH         right_n_bits(16)
+#define UNSAMPLED_BUCKET_IDX      right_n_bits(40)
 #else
   size_t           _size      : 32;
   size_t           _flags     : 8;
@@ -257,6 +264,7 @@ class MallocHeader {
   size_t           _bucket_idx: 16;
 #define MAX_MALLOCSITE_TABLE_SIZE  right_n_bits(16)
 #define MAX_BUCKET_LENGTH          right_n_bits(8)
+#define UNSAMPLED_BUCKET_IDX       right_n_bits(16)
 #endif  // _LP64
 
  public:
@@ -273,7 +281,11 @@ class MallocHeader {
     if (level == NMT_detail) {
       size_t bucket_idx;
       size_t pos_idx;
-      if (record_malloc_site(stack, size, &bucket_idx, &pos_idx, flags)) {
+      if (stack.is_empty() && NMTDetailSampleInterval > 1) {
+        // not sampled, the allocation is only counted in the summary
+        _bucket_idx = UNSAMPLED_BUCKET_IDX;
+        _pos_idx = 0;
+      } else if (record_malloc_site(stack, size, &bucket_idx, &pos_idx, flags)) {
         assert(bucket_idx <= MAX_MALLOCSITE_TABLE_SIZE, "Overflow bucket index");
         assert(pos_idx <= MAX_BUCKET_LENGTH, "Overflow bucket position index");
         _bucket_idx = bucket_idx;
@@ -287,6 +299,7 @@ class MallocHeader {
 
   inline size_t   size()  const { return _size; }
   inline MEMFLAGS flags() const { return (MEMFLAGS)_flags; }
+  inline bool     is_sampled() const { return _bucket_idx != UNSAMPLED_BUCKET_IDX; }
   bool get_stack(NativeCallStack& stack) const;
 
   // Cleanup tracking information before the memory is released.
@@ -82,21 +82,29 @@ class MallocAllocationSiteWalker : public MallocSiteWalker {
  private:
   SortedLinkedList<MallocSite, compare_malloc_size> _malloc_sites;
   size_t         _count;
+  size_t         _scale;
 
   // Entries in MallocSiteTable with size = 0 and count = 0,
   // when the malloc site is not longer there.
  public:
-  MallocAllocationSiteWalker() : _count(0) { }
+  MallocAllocationSiteWalker() : _count(0), _scale(1) { }
 
   inline size_t count() const { return _count; }
 
+  // Factor applied to the sites walked next, for sampled call stacks
+  void set_scale(size_t scale) { _scale = scale; }
+
   LinkedList<MallocSite>* malloc_sites() {
     return &_malloc_sites;
   }
 
   bool do_malloc_site(const MallocSite* site) {
-    if (site->size() >= MemBaseline::SIZE_THRESHOLD) {
-      if (_malloc_sites.add(*site) != NULL) {
+    MallocSite scaled_site(*site);
+    if (_scale > 1) {
+      scaled_site.scale(_scale);
+    }
+    if (scaled_site.size() >= MemBaseline::SIZE_THRESHOLD) {
+      if (_malloc_sites.add(scaled_site) != NULL) {
         _count++;
         return true;
       } else {
@@ -152,11 +160,13 @@ bool MemBaseline::baseline_summary() {
 bool MemBaseline::baseline_allocation_sites() {
   // Malloc allocation sites
   MallocAllocationSiteWalker malloc_walker;
+  malloc_walker.set_scale(MemTracker::sampling_scale());
   if (!MallocSiteTable::walk_malloc_site(&malloc_walker)) {
     return false;
   }
 
-  // Walk simple thread stacks
+  // Walk simple thread stacks, they are always recorded
+  malloc_walker.set_scale(1);
   if (!ThreadStackTracker::walk_simple_thread_stack_site(&malloc_walker)) {
     return false;
   }
@@ -26,6 +26,7 @@
 #include "memory/allocation.hpp"
 #include "services/mallocTracker.hpp"
 #include "services/memReporter.hpp"
+#include "services/memTracker.hpp"
 #include "services/threadStackTracker.hpp"
 #include "services/virtualMemoryTracker.hpp"
 #include "utilities/globalDefinitions.hpp"
@@ -240,6 +241,10 @@ void MemDetailReporter::report_detail() {
   // Start detail report
   outputStream* out = output();
   out->print_cr("Details:\n");
+  if (MemTracker::sampling_scale() > 1) {
+    out->print_cr("Malloc sites sampled at one in " SIZE_FORMAT " allocations, scaled estimates\n",
+                  MemTracker::sampling_scale());
+  }
 
   report_malloc_sites();
   report_virtual_memory_allocation_sites();
@@ -801,3 +806,28 @@ void MemDetailDiffReporter::diff_virtual_memory_site(const NativeCallStack* stac
 
   out->print_cr(")\n");
  }
+
+void MemMappingReporter::print_mapping_line(const char* type, size_t size, size_t rss) const {
+  const char* scale = current_scale();
+  output()->print_cr("%-28s mapped=" SIZE_FORMAT "%s, rss=" SIZE_FORMAT "%s", type,
+    amount_in_current_scale(size), scale, amount_in_current_scale(rss), scale);
+}
+
+void MemMappingReporter::report() const {
+  outputStream* out = output();
+  out->print_cr("\nNative Memory Tracking (process mappings):\n");
+  print_mapping_line("Tracked virtual memory:", _snapshot.tracked_size(), _snapshot.tracked_rss());
+  print_mapping_line("Untracked anonymous memory:", _snapshot.untracked_anon_size(), _snapshot.untracked_anon_rss());
+  out->print_cr("%28s (" SIZE_FORMAT " mappings)", "", _snapshot.untracked_anon_count());
+  print_mapping_line("Untracked file mappings:", _snapshot.untracked_file_size(), _snapshot.untracked_file_rss());
+
+  // The C heap is part of the untracked anonymous memory, the difference
+  // between its resident size and the tracked malloc total approximates
+  // the memory allocated outside of the JVM (plus allocator overhead).
+  const size_t malloc_total = MallocMemorySummary::as_snapshot()->total();
+  out->print_cr("\nTracked malloc total: " SIZE_FORMAT "%s", amount_in_current_scale(malloc_total), current_scale());
+  if (_snapshot.untracked_anon_rss() > malloc_total) {
+    out->print_cr("Estimated untracked native memory: " SIZE_FORMAT "%s",
+      amount_in_current_scale(_snapshot.untracked_anon_rss() - malloc_total), current_scale());
+  }
+}
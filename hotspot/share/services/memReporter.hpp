@@ -233,6 +233,24 @@ class MemDetailDiffReporter : public MemSummaryDiffReporter {
     size_t current_committed, size_t early_reserved, size_t early_committed, MEMFLAGS flag) const;
 };
 
+/*
+ * The class is for reporting process memory mappings that are not
+ * tracked by NMT, e.g. mmap'd by JNI libraries or by the C library.
+ */
+class MemMappingReporter : public MemReporterBase {
+ private:
+  const ProcessMappingSnapshot& _snapshot;
+
+ public:
+  MemMappingReporter(const ProcessMappingSnapshot& snapshot, outputStream* output,
+    size_t scale = K) : MemReporterBase(output, scale), _snapshot(snapshot) { }
+
+  void report() const;
+
+ private:
+  void print_mapping_line(const char* type, size_t size, size_t rss) const;
+};
+
 #endif // INCLUDE_NMT
 
 #endif // SHARE_SERVICES_MEMREPORTER_HPP
@@ -24,6 +24,7 @@
 #include "precompiled.hpp"
 #include "jvm.h"
 
+#include "runtime/globals.hpp"
 #include "runtime/orderAccess.hpp"
 #include "runtime/vmThread.hpp"
 #include "runtime/vmOperations.hpp"
@@ -152,6 +153,29 @@ void MemTracker::shutdown() {
   }
 }
 
+#ifndef USE_LIBRARY_BASED_TLS_ONLY
+static THREAD_LOCAL_DECL uintx _sample_countdown = 0;
+#else
+// Shared by all threads, lost updates only make the interval less exact
+static volatile uintx _sample_countdown = 0;
+#endif
+
+bool MemTracker::sample_call_stack() {
+  if (NMTDetailSampleInterval <= 1) {
+    return true;
+  }
+  if (_sample_countdown == 0) {
+    _sample_countdown = NMTDetailSampleInterval - 1;
+    return true;
+  }
+  _sample_countdown--;
+  return false;
+}
+
+size_t MemTracker::sampling_scale() {
+  return NMTDetailSampleInterval;
+}
+
 bool MemTracker::transition_to(NMT_TrackingLevel level) {
   NMT_TrackingLevel current_level = tracking_level();
 
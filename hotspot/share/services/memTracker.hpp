@@ -87,9 +87,11 @@ class MemTracker : AllStatic {
 
 extern volatile bool NMT_stack_walkable;
 
-#define CURRENT_PC ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable) ? \
+#define CURRENT_PC ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable && \
+                     MemTracker::sample_call_stack()) ?                                \
                     NativeCallStack(0, true) : NativeCallStack::empty_stack())
-#define CALLER_PC  ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable) ?  \
+#define CALLER_PC  ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable && \
+                     MemTracker::sample_call_stack()) ?                                \
                     NativeCallStack(1, true) : NativeCallStack::empty_stack())
 
 class MemBaseline;
@@ -155,6 +157,14 @@ class MemTracker : AllStatic {
   // Transition the tracking level to specified level
   static bool transition_to(NMT_TrackingLevel level);
 
+  // Decides if the call stack of the current allocation is walked, true
+  // for one in NMTDetailSampleInterval allocations of the current thread.
+  static bool sample_call_stack();
+
+  // Factor for the malloc site statistics, which only include the
+  // allocations that had their call stack walked.
+  static size_t sampling_scale();
+
   static inline void* record_malloc(void* mem_base, size_t size, MEMFLAGS flag,
     const NativeCallStack& stack, NMT_TrackingLevel level) {
     return MallocTracker::record_malloc(mem_base, size, flag, stack, level);
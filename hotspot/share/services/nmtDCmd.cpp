@@ -55,6 +55,10 @@ NMTDCmd::NMTDCmd(outputStream* output,
             "BOOLEAN", false, "false"),
   _statistics("statistics", "print tracker statistics for tuning purpose.", \
             "BOOLEAN", false, "false"),
+  _mappings("mappings", "request runtime to reconcile the process memory " \
+            "mappings with tracked memory and report the untracked part, " \
+            "e.g. memory mapped by JNI libraries. Linux only.",
+            "BOOLEAN", false, "false"),
   _scale("scale", "Memory usage in which scale, KB, MB or GB",
        "STRING", false, "KB") {
   _dcmdparser.add_dcmd_option(&_summary);
@@ -64,6 +68,7 @@ NMTDCmd::NMTDCmd(outputStream* output,
   _dcmdparser.add_dcmd_option(&_detail_diff);
   _dcmdparser.add_dcmd_option(&_shutdown);
   _dcmdparser.add_dcmd_option(&_statistics);
+  _dcmdparser.add_dcmd_option(&_mappings);
   _dcmdparser.add_dcmd_option(&_scale);
 }
 
@@ -99,10 +104,11 @@ void NMTDCmd::execute(DCmdSource source, TRAPS) {
   if (_detail_diff.is_set() && _detail_diff.value()) { ++nopt; }
   if (_shutdown.is_set() && _shutdown.value()) { ++nopt; }
   if (_statistics.is_set() && _statistics.value()) { ++nopt; }
+  if (_mappings.is_set() && _mappings.value()) { ++nopt; }
 
   if (nopt > 1) {
       output()->print_cr("At most one of the following option can be specified: " \
-        "summary, detail, metadata, baseline, summary.diff, detail.diff, shutdown");
+        "summary, detail, metadata, baseline, summary.diff, detail.diff, shutdown, mappings");
       return;
   } else if (nopt == 0) {
     if (_summary.is_set()) {
@@ -154,6 +160,8 @@ void NMTDCmd::execute(DCmdSource source, TRAPS) {
     if (check_detail_tracking_level(output())) {
       MemTracker::tuning_statistics(output());
     }
+  } else if (_mappings.value()) {
+    report_mappings(scale_unit);
   } else {
     ShouldNotReachHere();
     output()->print_cr("Unknown command");
@@ -203,6 +211,16 @@ void NMTDCmd::report_diff(bool summaryOnly, size_t scale_unit) {
   }
 }
 
+void NMTDCmd::report_mappings(size_t scale_unit) {
+  ProcessMappingSnapshot snapshot;
+  if (snapshot.take()) {
+    MemMappingReporter rpt(snapshot, output(), scale_unit);
+    rpt.report();
+  } else {
+    output()->print_cr("Process memory mappings are not available on this platform");
+  }
+}
+
 bool NMTDCmd::check_detail_tracking_level(outputStream* out) {
   if (MemTracker::tracking_level() == NMT_detail) {
     return true;
@@ -39,6 +39,9 @@ PerfCounter*  RuntimeService::_sync_time_ticks = NULL;
 PerfCounter*  RuntimeService::_total_safepoints = NULL;
 PerfCounter*  RuntimeService::_safepoint_time_ticks = NULL;
 PerfCounter*  RuntimeService::_application_time_ticks = NULL;
+PerfCounter*  RuntimeService::_cleanup_time_ticks = NULL;
+PerfLongHistogram* RuntimeService::_pause_histogram = NULL;
+PerfLongRing* RuntimeService::_recent_pauses = NULL;
 
 void RuntimeService::init() {
   if (UsePerfData) {
@@ -60,6 +63,19 @@ void RuntimeService::init() {
               PerfDataManager::create_counter(SUN_RT, "applicationTime",
                                               PerfData::U_Ticks, CHECK);
 
+    _cleanup_time_ticks =
+              PerfDataManager::create_counter(SUN_RT, "safepointCleanupTime",
+                                              PerfData::U_Ticks, CHECK);
+
+    // 10 us (the safepoint times are kept in ns) up to 2.6 s and beyond
+    _pause_histogram =
+              PerfDataManager::create_long_histogram(SUN_RT, "safepointPauseHistogram",
+                                                     PerfData::U_Ticks, 10 * (NANOUNITS / MICROUNITS),
+                                                     20, CHECK);
+
+    _recent_pauses =
+              PerfDataManager::create_long_ring(SUN_RT, "safepointPauseRecent",
+                                                PerfData::U_Ticks, 32, CHECK);
 
     // create performance counters for jvm_version and its capabilities
     PerfDataManager::create_constant(SUN_RT, "jvmVersion", PerfData::U_None,
@@ -102,6 +118,14 @@ void RuntimeService::record_safepoint_end(jlong safepoint_ticks) {
   }
 }
 
+void RuntimeService::record_safepoint_pause(jlong cleanup_ticks, jlong pause_ticks) {
+  if (UsePerfData) {
+    _cleanup_time_ticks->inc(cleanup_ticks);
+    _pause_histogram->record(pause_ticks);
+    _recent_pauses->record(pause_ticks);
+  }
+}
+
 jlong RuntimeService::safepoint_sync_time_ms() {
   return UsePerfData ?
     Management::ticks_to_ms(_sync_time_ticks->get_value()) : -1;
@@ -34,6 +34,9 @@ private:
   static PerfCounter* _total_safepoints;
   static PerfCounter* _safepoint_time_ticks;   // Accumulated time at safepoints
   static PerfCounter* _application_time_ticks; // Accumulated time not at safepoints
+  static PerfCounter* _cleanup_time_ticks;     // Accumulated time in safepoint cleanup
+  static PerfLongHistogram* _pause_histogram; // Distribution of total safepoint pause times
+  static PerfLongRing* _recent_pauses;         // Most recent total safepoint pause times
 
 public:
   static void init();
@@ -47,6 +50,7 @@ public:
   static void record_safepoint_begin(jlong app_ticks) NOT_MANAGEMENT_RETURN;
   static void record_safepoint_synchronized(jlong sync_ticks) NOT_MANAGEMENT_RETURN;
   static void record_safepoint_end(jlong safepoint_ticks) NOT_MANAGEMENT_RETURN;
+  static void record_safepoint_pause(jlong cleanup_ticks, jlong pause_ticks) NOT_MANAGEMENT_RETURN;
 };
 
 #endif // SHARE_SERVICES_RUNTIMESERVICE_HPP
@@ -25,9 +25,11 @@
 
 #include "logging/log.hpp"
 #include "memory/metaspace.hpp"
+#include "memory/resourceArea.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/os.hpp"
 #include "runtime/threadCritical.hpp"
+#include "utilities/growableArray.hpp"
 #include "services/memTracker.hpp"
 #include "services/threadStackTracker.hpp"
 #include "services/virtualMemoryTracker.hpp"
@@ -631,3 +633,88 @@ void MetaspaceSnapshot::snapshot(MetaspaceSnapshot& mss) {
     snapshot(Metaspace::NonClassType, mss);
   }
 }
+
+// Collects the reserved regions, they are kept sorted by base address.
+class ReservedRegionCollector : public VirtualMemoryWalker {
+ private:
+  GrowableArray<address>* _bases;
+  GrowableArray<address>* _tops;
+
+ public:
+  ReservedRegionCollector(GrowableArray<address>* bases, GrowableArray<address>* tops) :
+    _bases(bases), _tops(tops) { }
+
+  bool do_allocation_site(const ReservedMemoryRegion* rgn) {
+    _bases->append(rgn->base());
+    _tops->append(rgn->end());
+    return true;
+  }
+};
+
+ProcessMappingSnapshot::ProcessMappingSnapshot() :
+  _tracked_size(0), _tracked_rss(0),
+  _untracked_anon_size(0), _untracked_anon_rss(0),
+  _untracked_file_size(0), _untracked_file_rss(0),
+  _untracked_anon_count(0),
+  _region_bases(NULL), _region_tops(NULL), _region_index(0) {
+}
+
+bool ProcessMappingSnapshot::take() {
+  if (MemTracker::tracking_level() < NMT_summary) {
+    return false;
+  }
+  ResourceMark rm;
+  _region_bases = new GrowableArray<address>(64);
+  _region_tops = new GrowableArray<address>(64);
+  _region_index = 0;
+  ReservedRegionCollector collector(_region_bases, _region_tops);
+  if (!VirtualMemoryTracker::walk_virtual_memory(&collector)) {
+    return false;
+  }
+  // Regions reserved or released while the mappings are read may be
+  // attributed to the wrong side, the snapshot is only an estimate.
+  bool result = os::get_memory_mappings_info(do_mapping, this);
+  _region_bases = NULL;
+  _region_tops = NULL;
+  return result;
+}
+
+void ProcessMappingSnapshot::do_mapping(address base, address top, size_t rss, bool file_backed, void* param) {
+  ((ProcessMappingSnapshot*)param)->add_mapping(base, top, rss, file_backed);
+}
+
+void ProcessMappingSnapshot::add_mapping(address base, address top, size_t rss, bool file_backed) {
+  if (top <= base) {
+    return;
+  }
+  // Both the mappings and the regions are sorted by address, skip the
+  // regions that end below this mapping.
+  while (_region_index < _region_bases->length() && _region_tops->at(_region_index) <= base) {
+    _region_index++;
+  }
+  size_t tracked = 0;
+  for (int i = _region_index; i < _region_bases->length() && _region_bases->at(i) < top; i++) {
+    address from = MAX2(base, _region_bases->at(i));
+    address to = MIN2(top, _region_tops->at(i));
+    if (to > from) {
+      tracked += pointer_delta(to, from, 1);
+    }
+  }
+  const size_t size = pointer_delta(top, base, 1);
+  assert(tracked <= size, "regions must not overlap");
+  // The kernel reports the resident size per mapping only, split it
+  // proportionally between the tracked and untracked parts.
+  const size_t tracked_rss = (size_t)((double)rss * tracked / size);
+  _tracked_size += tracked;
+  _tracked_rss += tracked_rss;
+  if (tracked < size) {
+    if (file_backed) {
+      _untracked_file_size += size - tracked;
+      _untracked_file_rss += rss - tracked_rss;
+    } else {
+      _untracked_anon_size += size - tracked;
+      _untracked_anon_rss += rss - tracked_rss;
+      _untracked_anon_count++;
+    }
+  }
+}
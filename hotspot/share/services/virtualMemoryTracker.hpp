@@ -35,6 +35,7 @@
 #include "utilities/nativeCallStack.hpp"
 #include "utilities/ostream.hpp"
 
+template <class E> class GrowableArray;
 
 /*
  * Virtual memory counter
@@ -443,6 +444,44 @@ private:
   }
 };
 
+// Reconciles the process memory mappings reported by the OS with the
+// virtual memory regions reserved through NMT. Mappings, or the parts of
+// them, that NMT does not know about were created outside of the JVM's
+// allocators, e.g. by JNI libraries calling mmap directly, by the C
+// library's malloc arenas or by mapped files.
+class ProcessMappingSnapshot : public StackObj {
+ private:
+  size_t _tracked_size;
+  size_t _tracked_rss;
+  size_t _untracked_anon_size;
+  size_t _untracked_anon_rss;
+  size_t _untracked_file_size;
+  size_t _untracked_file_rss;
+  size_t _untracked_anon_count;
+
+  GrowableArray<address>* _region_bases;
+  GrowableArray<address>* _region_tops;
+  int _region_index;
+
+  static void do_mapping(address base, address top, size_t rss, bool file_backed, void* param);
+  void add_mapping(address base, address top, size_t rss, bool file_backed);
+
+ public:
+  ProcessMappingSnapshot();
+
+  // Takes the snapshot, returns false if NMT is off or the platform
+  // does not report its memory mappings.
+  bool take();
+
+  size_t tracked_size()         const { return _tracked_size; }
+  size_t tracked_rss()          const { return _tracked_rss; }
+  size_t untracked_anon_size()  const { return _untracked_anon_size; }
+  size_t untracked_anon_rss()   const { return _untracked_anon_rss; }
+  size_t untracked_anon_count() const { return _untracked_anon_count; }
+  size_t untracked_file_size()  const { return _untracked_file_size; }
+  size_t untracked_file_rss()   const { return _untracked_file_rss; }
+};
+
 #endif // INCLUDE_NMT
 
 #endif // SHARE_SERVICES_VIRTUALMEMORYTRACKER_HPP
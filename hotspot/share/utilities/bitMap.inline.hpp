@@ -189,6 +189,17 @@ inline BitMap::idx_t BitMap::get_next_bit_impl(idx_t l_index, idx_t r_index) con
       idx_t limit = aligned_right
         ? word_index(r_index)
         : (word_index(r_index - 1) + 1); // Align up, knowing r_index > 0.
+      // Searched bitmaps are often sparse. Once the next word is known
+      // to be uninteresting too, skip the run four words at a time; the
+      // or-reduction compiles into a few wide loads and a single branch.
+      while (index + 4 < limit && (map(index + 1) ^ flip) == 0) {
+        bm_word_t any = (map(index + 1) ^ flip) | (map(index + 2) ^ flip) |
+                        (map(index + 3) ^ flip) | (map(index + 4) ^ flip);
+        if (any != 0) {
+          break;
+        }
+        index += 4;
+      }
       while (++index < limit) {
         cword = map(index) ^ flip;
         if (cword != 0) {
@@ -26,6 +26,7 @@
 #define SHARE_UTILITIES_CONCURRENTHASHTABLE_HPP
 
 #include "memory/allocation.hpp"
+#include "runtime/mutex.hpp"
 #include "utilities/globalCounter.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/tableStatistics.hpp"
@@ -36,15 +37,16 @@
 // A CALLBACK_FUNC and LOOKUP_FUNC needs to be provided for get and insert.
 
 class Thread;
-class Mutex;
 
 template <typename VALUE, typename CONFIG, MEMFLAGS F>
 class ConcurrentHashTable : public CHeapObj<F> {
+  friend class VMStructs;
  private:
   // This is the internal node structure.
   // Only constructed with placement new from memory allocated with MEMFLAGS of
   // the InternalTable or user-defined memory.
   class Node {
+    friend class VMStructs;
    private:
     Node * volatile _next;
     VALUE _value;
@@ -77,6 +79,7 @@ class ConcurrentHashTable : public CHeapObj<F> {
   // Only constructed with placement new from an array allocated with MEMFLAGS
   // of InternalTable.
   class Bucket {
+    friend class VMStructs;
    private:
 
     // Embedded state in two low bits in first pointer is a spinlock with 3
@@ -172,6 +175,7 @@ class ConcurrentHashTable : public CHeapObj<F> {
   //   (any pow 2 would also be possible).
   // - Use masking of hash for bucket index.
   class InternalTable : public CHeapObj<F> {
+    friend class VMStructs;
    private:
     Bucket* _buckets;        // Bucket array.
    public:
@@ -299,13 +303,15 @@ class ConcurrentHashTable : public CHeapObj<F> {
   void internal_shrink_range(Thread* thread, size_t start, size_t stop);
   bool internal_shrink(Thread* thread, size_t size_limit_log2);
 
-  // Methods for growing.
+  // Methods for growing. With is_mt the range may be unzipped by a thread
+  // other than the resize lock owner, concurrently with other ranges.
   bool unzip_bucket(Thread* thread, InternalTable* old_table,
                     InternalTable* new_table, size_t even_index,
-                    size_t odd_index);
+                    size_t odd_index, bool is_mt);
   bool internal_grow_prolog(Thread* thread, size_t log2_size);
   void internal_grow_epilog(Thread* thread);
-  void internal_grow_range(Thread* thread, size_t start, size_t stop);
+  void internal_grow_range(Thread* thread, size_t start, size_t stop,
+                           bool is_mt = false);
   bool internal_grow(Thread* thread, size_t log2_size);
 
   // Get a value.
@@ -334,6 +340,13 @@ class ConcurrentHashTable : public CHeapObj<F> {
   template <typename FUNC>
   void do_scan_locked(Thread* thread, FUNC& scan_f);
 
+  // Visits the buckets start_idx -> (stop_idx-1) with FUNC. The resize lock
+  // must be held, but not necessarily by this thread. Returns false if FUNC
+  // stopped the scan.
+  template <typename FUNC>
+  bool do_scan_for_range(Thread* thread, size_t start_idx, size_t stop_idx,
+                         FUNC& scan_f);
+
   // Check for dead items in a bucket.
   template <typename EVALUATE_FUNC>
   size_t delete_check_nodes(Bucket* bucket, EVALUATE_FUNC& eval_f,
@@ -377,7 +390,8 @@ class ConcurrentHashTable : public CHeapObj<F> {
  public:
   ConcurrentHashTable(size_t log2size = DEFAULT_START_SIZE_LOG2,
                       size_t log2size_limit = DEFAULT_MAX_SIZE_LOG2,
-                      size_t grow_hint = DEFAULT_GROW_HINT);
+                      size_t grow_hint = DEFAULT_GROW_HINT,
+                      int resize_lock_rank = Mutex::leaf);
 
   ~ConcurrentHashTable();
 
@@ -507,6 +521,7 @@ class ConcurrentHashTable : public CHeapObj<F> {
  public:
   class BulkDeleteTask;
   class GrowTask;
+  class ScanTask;
 };
 
 #endif // SHARE_UTILITIES_CONCURRENTHASHTABLE_HPP
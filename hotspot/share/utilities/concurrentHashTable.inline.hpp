@@ -418,8 +418,10 @@ ConcurrentHashTable<VALUE, CONFIG, F>::
 
 template <typename VALUE, typename CONFIG, MEMFLAGS F>
 inline void ConcurrentHashTable<VALUE, CONFIG, F>::
-  internal_grow_range(Thread* thread, size_t start, size_t stop)
+  internal_grow_range(Thread* thread, size_t start, size_t stop, bool is_mt)
 {
+  assert((is_mt && _resize_lock_owner != NULL) ||
+         (!is_mt && _resize_lock_owner == thread), "Re-size lock not held");
   assert(stop <= _table->_size, "Outside backing array");
   assert(_new_table != NULL, "Grow not proper setup before start");
   // The state is also copied here. Hence all buckets in new table will be
@@ -439,7 +441,8 @@ inline void ConcurrentHashTable<VALUE, CONFIG, F>::
 
     // When this is done we have separated the nodes into corresponding buckets
     // in new table.
-    if (!unzip_bucket(thread, _table, _new_table, even_index, odd_index)) {
+    if (!unzip_bucket(thread, _table, _new_table, even_index, odd_index,
+                      is_mt)) {
       // If bucket is empty, unzip does nothing.
       // We must make sure readers go to new table before we poison the bucket.
       DEBUG_ONLY(GlobalCounter::write_synchronize();)
@@ -653,7 +656,8 @@ ConcurrentHashTable<VALUE, CONFIG, F>::
 template <typename VALUE, typename CONFIG, MEMFLAGS F>
 inline bool ConcurrentHashTable<VALUE, CONFIG, F>::
   unzip_bucket(Thread* thread, InternalTable* old_table,
-               InternalTable* new_table, size_t even_index, size_t odd_index)
+               InternalTable* new_table, size_t even_index, size_t odd_index,
+               bool is_mt)
 {
   Node* aux = old_table->get_bucket(even_index)->first();
   if (aux == NULL) {
@@ -698,8 +702,13 @@ inline bool ConcurrentHashTable<VALUE, CONFIG, F>::
 
     // We can only move 1 pointer otherwise a reader might be moved to the wrong
     // chain. E.g. looking for even hash value but got moved to the odd bucket
-    // chain.
-    write_synchonize_on_visible_epoch(thread);
+    // chain. The visible epoch belongs to the resize lock owner, other
+    // threads must always do a full write_synchronize.
+    if (is_mt) {
+      GlobalCounter::write_synchronize();
+    } else {
+      write_synchonize_on_visible_epoch(thread);
+    }
     if (delete_me != NULL) {
       Node::destroy_node(delete_me);
       delete_me = NULL;
@@ -977,6 +986,25 @@ inline void ConcurrentHashTable<VALUE, CONFIG, F>::
   } /* ends critical section */
 }
 
+template <typename VALUE, typename CONFIG, MEMFLAGS F>
+template <typename FUNC>
+inline bool ConcurrentHashTable<VALUE, CONFIG, F>::
+  do_scan_for_range(Thread* thread, size_t start_idx, size_t stop_idx,
+                    FUNC& scan_f)
+{
+  assert(_resize_lock_owner != NULL, "Re-size lock not held");
+  InternalTable* table = get_table();
+  assert(start_idx < stop_idx, "Must be");
+  assert(stop_idx <= table->_size, "Must be");
+  for (size_t bucket_it = start_idx; bucket_it < stop_idx; bucket_it++) {
+    ScopedCS cs(thread, this);
+    if (!visit_nodes(table->get_bucket(bucket_it), scan_f)) {
+      return false; /* ends critical section */
+    }
+  } /* ends critical section */
+  return true;
+}
+
 template <typename VALUE, typename CONFIG, MEMFLAGS F>
 template <typename EVALUATE_FUNC>
 inline size_t ConcurrentHashTable<VALUE, CONFIG, F>::
@@ -1006,7 +1034,8 @@ inline size_t ConcurrentHashTable<VALUE, CONFIG, F>::
 // Constructor
 template <typename VALUE, typename CONFIG, MEMFLAGS F>
 inline ConcurrentHashTable<VALUE, CONFIG, F>::
-  ConcurrentHashTable(size_t log2size, size_t log2size_limit, size_t grow_hint)
+  ConcurrentHashTable(size_t log2size, size_t log2size_limit, size_t grow_hint,
+                      int resize_lock_rank)
     : _new_table(NULL), _log2_size_limit(log2size_limit),
        _log2_start_size(log2size), _grow_hint(grow_hint),
        _size_limit_reached(false), _resize_lock_owner(NULL),
@@ -1014,7 +1043,7 @@ inline ConcurrentHashTable<VALUE, CONFIG, F>::
 {
   _stats_rate = TableRateStatistics();
   _resize_lock =
-    new Mutex(Mutex::leaf, "ConcurrentHashTable", false,
+    new Mutex(resize_lock_rank, "ConcurrentHashTable", false,
               Monitor::_safepoint_check_never);
   _table = new InternalTable(log2size);
   assert(log2size_limit >= log2size, "bad ergo");
@@ -25,11 +25,17 @@
 #ifndef SHARE_UTILITIES_CONCURRENTHASHTABLETASKS_INLINE_HPP
 #define SHARE_UTILITIES_CONCURRENTHASHTABLETASKS_INLINE_HPP
 
+#include "gc/shared/workgroup.hpp"
+#include "runtime/interfaceSupport.inline.hpp"
+#include "runtime/safepoint.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/concurrentHashTable.inline.hpp"
 
-// This inline file contains BulkDeleteTask and GrowTasks which are both bucket
-// operations, which they are serialized with each other.
+// This inline file contains BulkDeleteTask, GrowTask and ScanTask which are all
+// bucket operations, which they are serialized with each other. Created with
+// is_mt, the ranges of a prepared task may be claimed by several threads at
+// once, e.g. by the workers of a ConcurrentHashTableGangTask, while the
+// preparing thread keeps owning the resize lock.
 
 // Base class for pause and/or parallel bulk operations.
 template <typename VALUE, typename CONFIG, MEMFLAGS F>
@@ -165,7 +171,8 @@ class ConcurrentHashTable<VALUE, CONFIG, F>::GrowTask :
   public BucketsOperation
 {
  public:
-  GrowTask(ConcurrentHashTable<VALUE, CONFIG, F>* cht) : BucketsOperation(cht) {
+  GrowTask(ConcurrentHashTable<VALUE, CONFIG, F>* cht, bool is_mt = false)
+    : BucketsOperation(cht, is_mt) {
   }
   // Before start prepare must be called.
   bool prepare(Thread* thread) {
@@ -185,7 +192,8 @@ class ConcurrentHashTable<VALUE, CONFIG, F>::GrowTask :
     if (!this->claim(&start, &stop)) {
       return false;
     }
-    BucketsOperation::_cht->internal_grow_range(thread, start, stop);
+    BucketsOperation::_cht->internal_grow_range(thread, start, stop,
+                                                BucketsOperation::_is_mt);
     assert(BucketsOperation::_cht->_resize_lock_owner != NULL,
            "Should be locked");
     return true;
@@ -199,4 +207,98 @@ class ConcurrentHashTable<VALUE, CONFIG, F>::GrowTask :
   }
 };
 
+// For doing pausable/parallel scans. Visiting is done per range, so unlike
+// do_scan() a SCAN_FUNC returning false only stops the current range.
+template <typename VALUE, typename CONFIG, MEMFLAGS F>
+class ConcurrentHashTable<VALUE, CONFIG, F>::ScanTask :
+  public BucketsOperation
+{
+ public:
+  ScanTask(ConcurrentHashTable<VALUE, CONFIG, F>* cht, bool is_mt = false)
+    : BucketsOperation(cht, is_mt) {
+  }
+  // Before start prepare must be called.
+  bool prepare(Thread* thread) {
+    bool lock = BucketsOperation::_cht->try_resize_lock(thread);
+    if (!lock) {
+      return false;
+    }
+    this->setup(thread);
+    return true;
+  }
+
+  // Visits one range with SCAN_FUNC. Returns true if there is more work.
+  template <typename SCAN_FUNC>
+  bool do_task(Thread* thread, SCAN_FUNC& scan_f) {
+    size_t start, stop;
+    assert(BucketsOperation::_cht->_resize_lock_owner != NULL,
+           "Should be locked");
+    if (!this->claim(&start, &stop)) {
+      return false;
+    }
+    BucketsOperation::_cht->do_scan_for_range(thread, start, stop, scan_f);
+    assert(BucketsOperation::_cht->_resize_lock_owner != NULL,
+           "Should be locked");
+    return true;
+  }
+
+  // Must be called after ranges are done.
+  void done(Thread* thread) {
+    this->thread_owns_resize_lock(thread);
+    BucketsOperation::_cht->unlock_resize_lock(thread);
+    this->thread_do_not_own_resize_lock(thread);
+  }
+};
+
+// Runs the ranges of a task prepared with is_mt on the workers of a WorkGang.
+// Each worker copies the WORKER_CL prototype onto its stack and calls
+// do_task(thread, task) on it until no range is left, then done() to publish
+// its per-worker results. Workers stop claiming when a safepoint is pending,
+// run() then lets the safepoint pass before handing out the remaining ranges.
+template <typename TASK, typename WORKER_CL>
+class ConcurrentHashTableGangTask : public AbstractGangTask {
+  TASK* _task;
+  const WORKER_CL& _prototype;
+  volatile bool _has_more_work;
+
+ public:
+  ConcurrentHashTableGangTask(const char* name, TASK* task,
+                              const WORKER_CL& prototype)
+    : AbstractGangTask(name), _task(task), _prototype(prototype),
+      _has_more_work(true) {}
+
+  void work(uint worker_id) {
+    Thread* thread = Thread::current();
+    WORKER_CL cl(_prototype);
+    bool more = true;
+    while (!SafepointSynchronize::is_synchronizing() &&
+           (more = cl.do_task(thread, _task))) {
+      /* claim next range */
+    }
+    if (!more) {
+      _has_more_work = false;
+    }
+    cl.done();
+  }
+
+  // Returns false when some worker found all ranges claimed.
+  bool has_more_work() const { return _has_more_work; }
+
+  // Runs all ranges on the workers. The calling thread must have prepared
+  // the task and blocks for safepoints between rounds.
+  void run(JavaThread* jt, WorkGang* workers) {
+    while (true) {
+      workers->run_task(this, workers->total_workers());
+      if (!has_more_work()) {
+        return;
+      }
+      _task->pause(jt);
+      {
+        ThreadBlockInVM tbivm(jt);
+      }
+      _task->cont(jt);
+    }
+  }
+};
+
 #endif // SHARE_UTILITIES_CONCURRENTHASHTABLETASKS_INLINE_HPP
@@ -30,10 +30,14 @@
 #include <stdio.h>
 #include <limits.h>
 #include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "logging/log.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/resourceArea.hpp"
+#include "runtime/os.hpp"
+#include "utilities/align.hpp"
 #include "utilities/decoder.hpp"
 #include "utilities/elfFile.hpp"
 #include "utilities/elfFuncDescTable.hpp"
@@ -44,16 +48,46 @@
 // For test only, disable elf section cache and force to read from file directly.
 bool ElfFile::_do_not_cache_elf_section = false;
 
-ElfSection::ElfSection(FILE* fd, const Elf_Shdr& hdr) : _section_data(NULL) {
+ElfSection::ElfSection(FILE* fd, const Elf_Shdr& hdr) :
+  _section_data(NULL), _mapped_base(NULL), _mapped_size(0) {
   _stat = load_section(fd, hdr);
 }
 
 ElfSection::~ElfSection() {
-  if (_section_data != NULL) {
+  if (_mapped_base != NULL) {
+    ::munmap(_mapped_base, _mapped_size);
+  } else if (_section_data != NULL) {
     os::free(_section_data);
   }
 }
 
+// Mapping avoids copying large symbol and string tables into the C heap,
+// pages that are never looked at are never read from the file. Plain
+// mmap is used since decoding may happen during error reporting, where
+// taking the locks of os::map_memory() is not safe.
+bool ElfSection::map_section(FILE* const fd, const Elf_Shdr& shdr) {
+  if (shdr.sh_type == SHT_NOBITS || shdr.sh_size == 0) {
+    return false;
+  }
+  // Touching a mapping past the end of the file raises SIGBUS.
+  struct stat st;
+  if (fstat(fileno(fd), &st) != 0 ||
+      (julong)st.st_size < (julong)shdr.sh_offset + (julong)shdr.sh_size) {
+    return false;
+  }
+  size_t page_size = os::vm_page_size();
+  size_t map_offset = align_down((size_t)shdr.sh_offset, page_size);
+  size_t map_size = (size_t)shdr.sh_offset - map_offset + (size_t)shdr.sh_size;
+  void* base = ::mmap(NULL, map_size, PROT_READ, MAP_PRIVATE, fileno(fd), (off_t)map_offset);
+  if (base == MAP_FAILED) {
+    return false;
+  }
+  _mapped_base = base;
+  _mapped_size = map_size;
+  _section_data = (char*)base + ((size_t)shdr.sh_offset - map_offset);
+  return true;
+}
+
 NullDecoder::decoder_status ElfSection::load_section(FILE* const fd, const Elf_Shdr& shdr) {
   memcpy((void*)&_section_hdr, (const void*)&shdr, sizeof(shdr));
 
@@ -62,6 +96,10 @@ NullDecoder::decoder_status ElfSection::load_section(FILE* const fd, const Elf_S
     return NullDecoder::no_error;
   }
 
+  if (map_section(fd, shdr)) {
+    return NullDecoder::no_error;
+  }
+
   _section_data = os::malloc(shdr.sh_size, mtInternal);
   // No enough memory for caching. It is okay, we can try to read from
   // file instead.
@@ -80,6 +80,9 @@ class ElfSection {
 private:
   Elf_Shdr      _section_hdr;
   void*         _section_data;
+  // page aligned mapping that holds _section_data, if the section is mapped
+  void*         _mapped_base;
+  size_t        _mapped_size;
   NullDecoder::decoder_status _stat;
 public:
   ElfSection(FILE* fd, const Elf_Shdr& hdr);
@@ -93,6 +96,8 @@ private:
   // load this section.
   // it return no_error, when it fails to cache the section data due to lack of memory
   NullDecoder::decoder_status load_section(FILE* const file, const Elf_Shdr& hdr);
+  // map this section read-only, returns false if it cannot be mapped
+  bool map_section(FILE* const file, const Elf_Shdr& hdr);
 };
 
 class FileReader : public StackObj {
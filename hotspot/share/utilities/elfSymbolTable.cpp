@@ -29,9 +29,11 @@
 #include "memory/allocation.inline.hpp"
 #include "utilities/elfFuncDescTable.hpp"
 #include "utilities/elfSymbolTable.hpp"
+#include "utilities/quickSort.hpp"
 
 ElfSymbolTable::ElfSymbolTable(FILE* const file, Elf_Shdr& shdr) :
-  _next(NULL), _fd(file), _section(file, shdr) {
+  _next(NULL), _fd(file), _section(file, shdr),
+  _index(NULL), _index_length(0), _index_built(false) {
   assert(file != NULL, "null file handle");
   _status = _section.status();
 
@@ -41,22 +43,28 @@ ElfSymbolTable::ElfSymbolTable(FILE* const file, Elf_Shdr& shdr) :
 }
 
 ElfSymbolTable::~ElfSymbolTable() {
+  if (_index != NULL) {
+    FREE_C_HEAP_ARRAY(IndexEntry, _index);
+  }
   if (_next != NULL) {
     delete _next;
   }
 }
 
+address ElfSymbolTable::symbol_address(const Elf_Sym* sym, ElfFuncDescTable* funcDescTable) {
+  if (funcDescTable != NULL && funcDescTable->get_index() == sym->st_shndx) {
+    // We need to go another step trough the function descriptor table (currently PPC64 only)
+    return funcDescTable->lookup(sym->st_value);
+  } else {
+    return (address)sym->st_value;
+  }
+}
+
 bool ElfSymbolTable::compare(const Elf_Sym* sym, address addr, int* stringtableIndex, int* posIndex, int* offset, ElfFuncDescTable* funcDescTable) {
   if (STT_FUNC == ELF_ST_TYPE(sym->st_info)) {
     Elf_Word st_size = sym->st_size;
     const Elf_Shdr* shdr = _section.section_header();
-    address sym_addr;
-    if (funcDescTable != NULL && funcDescTable->get_index() == sym->st_shndx) {
-      // We need to go another step trough the function descriptor table (currently PPC64 only)
-      sym_addr = funcDescTable->lookup(sym->st_value);
-    } else {
-      sym_addr = (address)sym->st_value;
-    }
+    address sym_addr = symbol_address(sym, funcDescTable);
     if (sym_addr <= addr && (Elf_Word)(addr - sym_addr) < st_size) {
       *offset = (int)(addr - sym_addr);
       *posIndex = sym->st_name;
@@ -81,6 +89,12 @@ bool ElfSymbolTable::lookup(address addr, int* stringtableIndex, int* posIndex,
   Elf_Sym* symbols = (Elf_Sym*)_section.section_data();
 
   if (symbols != NULL) {
+    if (!_index_built) {
+      build_index(symbols, count, funcDescTable);
+    }
+    if (_index != NULL) {
+      return lookup_in_index(addr, stringtableIndex, posIndex, offset);
+    }
     for (int index = 0; index < count; index ++) {
       if (compare(&symbols[index], addr, stringtableIndex, posIndex, offset, funcDescTable)) {
         return true;
@@ -109,4 +123,80 @@ bool ElfSymbolTable::lookup(address addr, int* stringtableIndex, int* posIndex,
   return false;
 }
 
+int ElfSymbolTable::compare_entries(const IndexEntry& e1, const IndexEntry& e2) {
+  if (e1._addr < e2._addr) {
+    return -1;
+  } else if (e1._addr > e2._addr) {
+    return 1;
+  }
+  return 0;
+}
+
+// Symbolizing a native stack looks up every frame; a linear walk over
+// tens of thousands of symbols per frame made that take minutes.
+void ElfSymbolTable::build_index(const Elf_Sym* symbols, int count, ElfFuncDescTable* funcDescTable) {
+  _index_built = true;
+  int functions = 0;
+  for (int index = 0; index < count; index ++) {
+    if (STT_FUNC == ELF_ST_TYPE(symbols[index].st_info) && symbols[index].st_size > 0) {
+      functions++;
+    }
+  }
+  if (functions == 0) {
+    return;
+  }
+  // If there is no memory for the index, lookups walk the symbols instead.
+  _index = NEW_C_HEAP_ARRAY_RETURN_NULL(IndexEntry, functions, mtInternal);
+  if (_index == NULL) {
+    return;
+  }
+  for (int index = 0; index < count; index ++) {
+    const Elf_Sym* sym = &symbols[index];
+    if (STT_FUNC == ELF_ST_TYPE(sym->st_info) && sym->st_size > 0) {
+      IndexEntry* entry = &_index[_index_length++];
+      entry->_addr = symbol_address(sym, funcDescTable);
+      entry->_size = sym->st_size;
+      entry->_name = sym->st_name;
+    }
+  }
+  QuickSort::sort(_index, _index_length, compare_entries, false);
+  address max_end = NULL;
+  for (int index = 0; index < _index_length; index ++) {
+    IndexEntry* entry = &_index[index];
+    address end = entry->_addr + entry->_size;
+    if (end > max_end) {
+      max_end = end;
+    }
+    entry->_max_end = max_end;
+  }
+}
+
+bool ElfSymbolTable::lookup_in_index(address addr, int* stringtableIndex, int* posIndex, int* offset) {
+  // Find the last symbol starting at or below addr.
+  int low = 0;
+  int high = _index_length - 1;
+  int found = -1;
+  while (low <= high) {
+    int mid = low + (high - low) / 2;
+    if (_index[mid]._addr <= addr) {
+      found = mid;
+      low = mid + 1;
+    } else {
+      high = mid - 1;
+    }
+  }
+  // Symbols may nest, so check the ones starting further below as well,
+  // but only as long as some symbol at or below the index reaches addr.
+  for (int index = found; index >= 0 && _index[index]._max_end > addr; index --) {
+    const IndexEntry* entry = &_index[index];
+    if ((size_t)(addr - entry->_addr) < (size_t)entry->_size) {
+      *offset = (int)(addr - entry->_addr);
+      *posIndex = entry->_name;
+      *stringtableIndex = _section.section_header()->sh_link;
+      return true;
+    }
+  }
+  return false;
+}
+
 #endif // !_WINDOWS && !__APPLE__
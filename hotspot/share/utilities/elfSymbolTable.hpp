@@ -35,12 +35,21 @@
 /*
  * symbol table object represents a symbol section in an elf file.
  * Whenever possible, it will load all symbols from the corresponding section
- * of the elf file into memory. Otherwise, it will walk the section in file
- * to look up the symbol that nearest the given address.
+ * of the elf file into memory and, on the first lookup, index the function
+ * symbols by address so lookups are binary searches. Otherwise, it will walk
+ * the section in file to look up the symbol that nearest the given address.
  */
 class ElfSymbolTable: public CHeapObj<mtInternal> {
   friend class ElfFile;
 private:
+  // A function symbol in the address index.
+  struct IndexEntry {
+    address   _addr;
+    Elf_Word  _size;
+    Elf_Word  _name;
+    address   _max_end;   // highest end address of this and all preceding entries
+  };
+
   ElfSymbolTable*  _next;
 
   // file contains string table
@@ -49,6 +58,11 @@ private:
   // corresponding section
   ElfSection      _section;
 
+  // function symbols sorted by address, built on first lookup
+  IndexEntry*     _index;
+  int             _index_length;
+  bool            _index_built;
+
   NullDecoder::decoder_status _status;
 public:
   ElfSymbolTable(FILE* const file, Elf_Shdr& shdr);
@@ -63,6 +77,11 @@ private:
   void set_next(ElfSymbolTable* next) { _next = next; }
 
   bool compare(const Elf_Sym* sym, address addr, int* stringtableIndex, int* posIndex, int* offset, ElfFuncDescTable* funcDescTable);
+
+  address symbol_address(const Elf_Sym* sym, ElfFuncDescTable* funcDescTable);
+  void build_index(const Elf_Sym* symbols, int count, ElfFuncDescTable* funcDescTable);
+  bool lookup_in_index(address addr, int* stringtableIndex, int* posIndex, int* offset);
+  static int compare_entries(const IndexEntry& e1, const IndexEntry& e2);
 };
 
 #endif // !_WINDOWS and !__APPLE__
@@ -28,6 +28,7 @@
 #include "compiler/compileBroker.hpp"
 #include "compiler/disassembler.hpp"
 #include "gc/shared/gcConfig.hpp"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logConfiguration.hpp"
 #include "jfr/jfrEvents.hpp"
 #include "memory/resourceArea.hpp"
@@ -1402,6 +1403,10 @@ void VMError::report_and_die(int id, const char* message, const char* detail_fmt
 
     JFR_ONLY(Jfr::on_vm_shutdown(true);)
 
+    // Write out log messages still buffered for asynchronous logging;
+    // they may explain the crash.
+    LogAsyncWriter::stop_on_error();
+
   } else {
     // If UseOsErrorReporting we call this for each level of the call stack
     // while searching for the exception handler.  Only the first level needs
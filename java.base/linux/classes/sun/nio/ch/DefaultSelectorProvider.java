@@ -26,6 +26,7 @@
 package sun.nio.ch;
 
 import java.nio.channels.spi.SelectorProvider;
+import sun.security.action.GetPropertyAction;
 
 /**
  * Creates this platform's default SelectorProvider
@@ -39,9 +40,17 @@ public class DefaultSelectorProvider {
     private DefaultSelectorProvider() { }
 
     /**
-     * Returns the default SelectorProvider.
+     * Returns the default SelectorProvider. The io_uring based provider is
+     * used when enabled with {@code -Djdk.nio.useIOUring=true} and supported
+     * by the kernel, the epoll based provider otherwise.
      */
     public static SelectorProvider create() {
+        String prop = GetPropertyAction
+                .privilegedGetProperty("jdk.nio.useIOUring", "false");
+        if ((prop.isEmpty() || Boolean.parseBoolean(prop))
+                && IOUring.isAvailable()) {
+            return new IOUringSelectorProvider();
+        }
         return new EPollSelectorProvider();
     }
 }
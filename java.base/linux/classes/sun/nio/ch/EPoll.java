@@ -64,8 +64,18 @@ class EPoll {
     static final int EPOLLOUT  = 0x4;
 
     // flags
+    static final int EPOLLEXCLUSIVE = (1 << 28);
     static final int EPOLLONESHOT   = (1 << 30);
 
+    /**
+     * struct {
+     *     jint opcode;
+     *     jint fd;
+     *     jint events;
+     * }
+     */
+    private static final int SIZEOF_UPDATE = 12;
+
     /**
      * Allocates a poll array to handle up to {@code count} events.
      */
@@ -80,6 +90,30 @@ class EPoll {
         unsafe.freeMemory(address);
     }
 
+    /**
+     * Allocates an update array to hold up to {@code count} updates.
+     */
+    static long allocateUpdateArray(int count) {
+        return unsafe.allocateMemory(count * SIZEOF_UPDATE);
+    }
+
+    /**
+     * Free an update array
+     */
+    static void freeUpdateArray(long address) {
+        unsafe.freeMemory(address);
+    }
+
+    /**
+     * Sets update[i] to the given opcode, file descriptor and events.
+     */
+    static void putUpdate(long address, int i, int opcode, int fd, int events) {
+        long update = address + (SIZEOF_UPDATE*i);
+        unsafe.putInt(update, opcode);
+        unsafe.putInt(update + 4, fd);
+        unsafe.putInt(update + 8, events);
+    }
+
     /**
      * Returns event[i];
      */
@@ -113,6 +147,12 @@ class EPoll {
 
     static native int ctl(int epfd, int opcode, int fd, int events);
 
+    /**
+     * Applies {@code count} updates from the update array with one JNI
+     * transition. Returns the number of updates that failed.
+     */
+    static native int ctlBatch(int epfd, long updateAddress, int count);
+
     static native int wait(int epfd, long pollAddress, int numfds, int timeout)
         throws IOException;
 
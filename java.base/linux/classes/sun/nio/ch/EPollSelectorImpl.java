@@ -36,7 +36,9 @@ import java.util.HashMap;
 import java.util.Map;
 import java.util.concurrent.TimeUnit;
 import java.util.function.Consumer;
+import sun.security.action.GetPropertyAction;
 
+import static sun.nio.ch.EPoll.EPOLLEXCLUSIVE;
 import static sun.nio.ch.EPoll.EPOLLIN;
 import static sun.nio.ch.EPoll.EPOLL_CTL_ADD;
 import static sun.nio.ch.EPoll.EPOLL_CTL_DEL;
@@ -52,12 +54,27 @@ class EPollSelectorImpl extends SelectorImpl {
     // maximum number of events to poll in one call to epoll_wait
     private static final int NUM_EPOLLEVENTS = Math.min(IOUtil.fdLimit(), 1024);
 
+    // maximum number of interest updates applied in one call to ctlBatch
+    private static final int NUM_UPDATES = 256;
+
+    // register server sockets polled for OP_ACCEPT with EPOLLEXCLUSIVE so
+    // that a connection wakes up only one of the selectors polling the
+    // socket
+    private static final boolean EXCLUSIVE_ACCEPT = Boolean.parseBoolean(
+        GetPropertyAction.privilegedGetProperty("jdk.nio.epollExclusiveAccept",
+                                                "false"));
+
     // epoll file descriptor
     private final int epfd;
 
     // address of poll array when polling with epoll_wait
     private final long pollArrayAddress;
 
+    // address of the update array and the number of updates queued in it,
+    // synchronize on selector
+    private final long updateArrayAddress;
+    private int numUpdates;
+
     // file descriptors used for interrupt
     private final int fd0;
     private final int fd1;
@@ -78,6 +95,7 @@ class EPollSelectorImpl extends SelectorImpl {
 
         this.epfd = EPoll.create();
         this.pollArrayAddress = EPoll.allocatePollArray(NUM_EPOLLEVENTS);
+        this.updateArrayAddress = EPoll.allocateUpdateArray(NUM_UPDATES);
 
         try {
             long fds = IOUtil.makePipe(false);
@@ -85,6 +103,7 @@ class EPollSelectorImpl extends SelectorImpl {
             this.fd1 = (int) fds;
         } catch (IOException ioe) {
             EPoll.freePollArray(pollArrayAddress);
+            EPoll.freeUpdateArray(updateArrayAddress);
             FileDispatcherImpl.closeIntFD(epfd);
             throw ioe;
         }
@@ -138,7 +157,8 @@ class EPollSelectorImpl extends SelectorImpl {
     }
 
     /**
-     * Process changes to the interest ops.
+     * Process changes to the interest ops. The epoll_ctl calls are queued in
+     * the update array and applied in batches.
      */
     private void processUpdateQueue() {
         assert Thread.holdsLock(this);
@@ -157,14 +177,20 @@ class EPollSelectorImpl extends SelectorImpl {
                     if (newEvents != registeredEvents) {
                         if (newEvents == 0) {
                             // remove from epoll
-                            EPoll.ctl(epfd, EPOLL_CTL_DEL, fd, 0);
+                            queueUpdate(EPOLL_CTL_DEL, fd, 0);
+                        } else if (isExclusive(ski)) {
+                            // EPOLLEXCLUSIVE cannot be modified
+                            if (registeredEvents != 0)
+                                queueUpdate(EPOLL_CTL_DEL, fd, 0);
+                            queueUpdate(EPOLL_CTL_ADD, fd,
+                                        newEvents | EPOLLEXCLUSIVE);
                         } else {
                             if (registeredEvents == 0) {
                                 // add to epoll
-                                EPoll.ctl(epfd, EPOLL_CTL_ADD, fd, newEvents);
+                                queueUpdate(EPOLL_CTL_ADD, fd, newEvents);
                             } else {
                                 // modify events
-                                EPoll.ctl(epfd, EPOLL_CTL_MOD, fd, newEvents);
+                                queueUpdate(EPOLL_CTL_MOD, fd, newEvents);
                             }
                         }
                         ski.registeredEvents(newEvents);
@@ -172,6 +198,24 @@ class EPollSelectorImpl extends SelectorImpl {
                 }
             }
         }
+        flushUpdates();
+    }
+
+    private boolean isExclusive(SelectionKeyImpl ski) {
+        return EXCLUSIVE_ACCEPT && (ski.channel() instanceof ServerSocketChannelImpl);
+    }
+
+    private void queueUpdate(int opcode, int fd, int events) {
+        if (numUpdates == NUM_UPDATES)
+            flushUpdates();
+        EPoll.putUpdate(updateArrayAddress, numUpdates++, opcode, fd, events);
+    }
+
+    private void flushUpdates() {
+        if (numUpdates > 0) {
+            EPoll.ctlBatch(epfd, updateArrayAddress, numUpdates);
+            numUpdates = 0;
+        }
     }
 
     /**
@@ -217,6 +261,7 @@ class EPollSelectorImpl extends SelectorImpl {
 
         FileDispatcherImpl.closeIntFD(epfd);
         EPoll.freePollArray(pollArrayAddress);
+        EPoll.freeUpdateArray(updateArrayAddress);
 
         FileDispatcherImpl.closeIntFD(fd0);
         FileDispatcherImpl.closeIntFD(fd1);
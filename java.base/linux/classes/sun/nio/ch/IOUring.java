@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package sun.nio.ch;
+
+import java.io.IOException;
+import jdk.internal.misc.Unsafe;
+
+/**
+ * Provides access to the Linux io_uring facility. Only the poll and timeout
+ * operations used by {@link IOUringSelectorImpl} are supported. Operations
+ * are queued in the submission queue and handed to the kernel together by
+ * the next call to {@link #enter}.
+ */
+
+class IOUring {
+    private IOUring() { }
+
+    private static final Unsafe unsafe = Unsafe.getUnsafe();
+
+    /**
+     * struct io_uring_cqe {
+     *     __u64 user_data;
+     *     __s32 res;
+     *     __u32 flags;
+     * }
+     */
+    private static final int SIZEOF_CQE          = cqeSize();
+    private static final int OFFSETOF_USER_DATA  = userDataOffset();
+    private static final int OFFSETOF_RES        = resOffset();
+
+    // poll events, the same values as epoll
+    static final int POLLIN   = 0x1;
+    static final int POLLOUT  = 0x4;
+
+    // errno values reported in the completion result
+    static final int ECANCELED = 125;
+
+    private static final boolean AVAILABLE = probe();
+
+    private static boolean probe() {
+        try {
+            close(create(2));
+            return true;
+        } catch (IOException ioe) {
+            return false;
+        }
+    }
+
+    /**
+     * Returns true if the kernel provides io_uring with the features the
+     * selector relies on.
+     */
+    static boolean isAvailable() {
+        return AVAILABLE;
+    }
+
+    /**
+     * Allocates a completion array to handle up to {@code count} entries.
+     */
+    static long allocateCompletionArray(int count) {
+        return unsafe.allocateMemory(count * SIZEOF_CQE);
+    }
+
+    /**
+     * Free a completion array
+     */
+    static void freeCompletionArray(long address) {
+        unsafe.freeMemory(address);
+    }
+
+    /**
+     * Returns cqe[i];
+     */
+    static long getCompletion(long address, int i) {
+        return address + (SIZEOF_CQE*i);
+    }
+
+    /**
+     * Returns cqe->user_data
+     */
+    static long getUserData(long cqeAddress) {
+        return unsafe.getLong(cqeAddress + OFFSETOF_USER_DATA);
+    }
+
+    /**
+     * Returns cqe->res
+     */
+    static int getResult(long cqeAddress) {
+        return unsafe.getInt(cqeAddress + OFFSETOF_RES);
+    }
+
+    // -- Native methods --
+
+    private static native int cqeSize();
+
+    private static native int userDataOffset();
+
+    private static native int resOffset();
+
+    static native long create(int entries) throws IOException;
+
+    static native void pollAdd(long ring, int fd, int events, long userData)
+        throws IOException;
+
+    static native void pollRemove(long ring, long target, long userData)
+        throws IOException;
+
+    static native void timeout(long ring, long millis, long userData)
+        throws IOException;
+
+    static native int enter(long ring, int minComplete) throws IOException;
+
+    static native int reap(long ring, long cqArrayAddress, int max);
+
+    static native void close(long ring);
+
+    static {
+        IOUtil.load();
+    }
+}
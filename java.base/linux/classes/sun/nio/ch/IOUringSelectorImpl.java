@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package sun.nio.ch;
+
+import java.io.IOException;
+import java.nio.channels.ClosedSelectorException;
+import java.nio.channels.SelectionKey;
+import java.nio.channels.Selector;
+import java.nio.channels.spi.SelectorProvider;
+import java.util.ArrayDeque;
+import java.util.Deque;
+import java.util.HashMap;
+import java.util.Map;
+import java.util.function.Consumer;
+
+import static sun.nio.ch.IOUring.ECANCELED;
+import static sun.nio.ch.IOUring.POLLIN;
+
+
+/**
+ * Linux io_uring based Selector implementation.
+ *
+ * Each registered file descriptor with a non-empty interest set has one
+ * one-shot poll operation armed in the ring. Interest updates, the re-arming
+ * of polls that completed in the previous selection operation and the
+ * timeout are queued in the submission queue and submitted together with
+ * the wait, so that a selection operation needs a single system call no
+ * matter how many keys changed.
+ *
+ * The user data of a poll operation encodes the file descriptor and a
+ * sequence number. A completion is only delivered if its user data matches
+ * the poll currently armed for the file descriptor; completions of polls
+ * that were replaced or cancelled are ignored.
+ */
+
+class IOUringSelectorImpl extends SelectorImpl {
+
+    // number of submission queue entries, the completion queue is twice
+    // the size and does not drop completions when it overflows
+    private static final int RING_ENTRIES = 1024;
+
+    // maximum number of completions to copy in one call to reap
+    private static final int NUM_CQES = 1024;
+
+    // user data of operations that are not polls
+    private static final long REMOVE_TAG  = 1L << 63;
+    private static final long TIMEOUT_TAG = 1L << 62;
+
+    // address of the ring
+    private final long ring;
+
+    // address of the array that completions are copied to
+    private final long cqArrayAddress;
+
+    // file descriptors used for interrupt
+    private final int fd0;
+    private final int fd1;
+
+    // maps file descriptor to selection key, synchronize on selector
+    private final Map<Integer, SelectionKeyImpl> fdToKey = new HashMap<>();
+
+    // maps file descriptor to the user data of its armed poll, synchronize
+    // on selector
+    private final Map<Integer, Long> fdToPoll = new HashMap<>();
+
+    // user data of the poll armed for the interrupt fd
+    private long wakeupPoll;
+
+    // sequence numbers for polls and timeouts
+    private int pollSequence;
+    private long timeoutSequence;
+
+    // pending new registrations/updates, queued by setEventOps and by
+    // processEvents to re-arm polls that completed
+    private final Object updateLock = new Object();
+    private final Deque<SelectionKeyImpl> updateKeys = new ArrayDeque<>();
+
+    // interrupt triggering and clearing
+    private final Object interruptLock = new Object();
+    private boolean interruptTriggered;
+
+    IOUringSelectorImpl(SelectorProvider sp) throws IOException {
+        super(sp);
+
+        this.ring = IOUring.create(RING_ENTRIES);
+        this.cqArrayAddress = IOUring.allocateCompletionArray(NUM_CQES);
+
+        try {
+            long fds = IOUtil.makePipe(false);
+            this.fd0 = (int) (fds >>> 32);
+            this.fd1 = (int) fds;
+        } catch (IOException ioe) {
+            IOUring.freeCompletionArray(cqArrayAddress);
+            IOUring.close(ring);
+            throw ioe;
+        }
+
+        // poll one end of the pipe for wakeups
+        armWakeup();
+    }
+
+    private void ensureOpen() {
+        if (!isOpen())
+            throw new ClosedSelectorException();
+    }
+
+    private long nextPollId(int fd) {
+        pollSequence = (pollSequence + 1) & 0x3fffffff;
+        return ((long) pollSequence << 32) | (fd & 0xffffffffL);
+    }
+
+    private void armWakeup() throws IOException {
+        wakeupPoll = nextPollId(fd0);
+        IOUring.pollAdd(ring, fd0, POLLIN, wakeupPoll);
+    }
+
+    @Override
+    protected int doSelect(Consumer<SelectionKey> action, long timeout)
+        throws IOException
+    {
+        assert Thread.holdsLock(this);
+
+        int to = (int) Math.min(timeout, Integer.MAX_VALUE);
+        boolean blocking = (to != 0);
+        boolean timedPoll = (to > 0);
+
+        int numEntries;
+        processUpdateQueue();
+        processDeregisterQueue();
+
+        // the timeout also completes when any other completion is posted
+        long timeoutId = 0;
+        if (timedPoll) {
+            timeoutId = TIMEOUT_TAG | (++timeoutSequence & 0x3fffffffffffffffL);
+            IOUring.timeout(ring, to, timeoutId);
+        }
+
+        try {
+            begin(blocking);
+
+            do {
+                // submits the queued operations, then waits; an interrupted
+                // wait just goes round again as the timeout is in the ring
+                int res = IOUring.enter(ring, blocking ? 1 : 0);
+                assert IOStatus.check(res);
+                numEntries = IOUring.reap(ring, cqArrayAddress, NUM_CQES);
+            } while (blocking && !hasResult(numEntries, timeoutId));
+
+        } finally {
+            end(blocking);
+        }
+        processDeregisterQueue();
+        return processEvents(numEntries, action);
+    }
+
+    /**
+     * Returns true if the reaped completions end the selection operation,
+     * false if they are all for cancelled polls or earlier timeouts.
+     */
+    private boolean hasResult(int numEntries, long timeoutId) {
+        for (int i=0; i<numEntries; i++) {
+            long cqe = IOUring.getCompletion(cqArrayAddress, i);
+            long userData = IOUring.getUserData(cqe);
+            if (userData == timeoutId || userData == wakeupPoll) {
+                return true;
+            }
+            if ((userData & (REMOVE_TAG | TIMEOUT_TAG)) == 0) {
+                Long armed = fdToPoll.get((int) userData);
+                if (armed != null && armed == userData) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Process changes to the interest ops. This only queues operations in
+     * the ring, they are submitted by the next call to enter.
+     */
+    private void processUpdateQueue() throws IOException {
+        assert Thread.holdsLock(this);
+
+        synchronized (updateLock) {
+            SelectionKeyImpl ski;
+            while ((ski = updateKeys.pollFirst()) != null) {
+                if (ski.isValid()) {
+                    int fd = ski.getFDVal();
+                    // add to fdToKey if needed
+                    SelectionKeyImpl previous = fdToKey.putIfAbsent(fd, ski);
+                    assert (previous == null) || (previous == ski);
+
+                    int newEvents = ski.translateInterestOps();
+                    int registeredEvents = ski.registeredEvents();
+                    if (newEvents != registeredEvents) {
+                        if (registeredEvents != 0) {
+                            // cancel the poll armed with the old events
+                            long id = fdToPoll.remove(fd);
+                            IOUring.pollRemove(ring, id, REMOVE_TAG);
+                        }
+                        if (newEvents != 0) {
+                            long id = nextPollId(fd);
+                            fdToPoll.put(fd, id);
+                            IOUring.pollAdd(ring, fd, newEvents, id);
+                        }
+                        ski.registeredEvents(newEvents);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Process the completions, reaping again while the completion array
+     * fills up. A poll completes once so the key is queued to re-arm it
+     * with the next selection operation.
+     * If the interrupt fd has been selected, drain it and clear the interrupt.
+     */
+    private int processEvents(int numEntries, Consumer<SelectionKey> action)
+        throws IOException
+    {
+        assert Thread.holdsLock(this);
+
+        boolean interrupted = false;
+        int numKeysUpdated = 0;
+        while (true) {
+            for (int i=0; i<numEntries; i++) {
+                long cqe = IOUring.getCompletion(cqArrayAddress, i);
+                long userData = IOUring.getUserData(cqe);
+                if (userData == wakeupPoll) {
+                    interrupted = true;
+                    continue;
+                }
+                if ((userData & (REMOVE_TAG | TIMEOUT_TAG)) != 0) {
+                    continue;
+                }
+                int fd = (int) userData;
+                Long armed = fdToPoll.get(fd);
+                if (armed == null || armed != userData) {
+                    // poll was replaced or cancelled
+                    continue;
+                }
+                SelectionKeyImpl ski = fdToKey.get(fd);
+                fdToPoll.remove(fd);
+                if (ski != null) {
+                    ski.registeredEvents(0);
+                    synchronized (updateLock) {
+                        updateKeys.addLast(ski);
+                    }
+                    int res = IOUring.getResult(cqe);
+                    if (res == -ECANCELED)
+                        continue;
+                    int rOps = (res < 0) ? Net.POLLERR : res;
+                    numKeysUpdated += processReadyEvents(rOps, ski, action);
+                }
+            }
+            if (numEntries < NUM_CQES)
+                break;
+            numEntries = IOUring.reap(ring, cqArrayAddress, NUM_CQES);
+        }
+
+        if (interrupted) {
+            clearInterrupt();
+            armWakeup();
+        }
+
+        return numKeysUpdated;
+    }
+
+    @Override
+    protected void implClose() throws IOException {
+        assert Thread.holdsLock(this);
+
+        // prevent further wakeup
+        synchronized (interruptLock) {
+            interruptTriggered = true;
+        }
+
+        // closing the ring cancels the armed polls
+        IOUring.close(ring);
+        IOUring.freeCompletionArray(cqArrayAddress);
+
+        FileDispatcherImpl.closeIntFD(fd0);
+        FileDispatcherImpl.closeIntFD(fd1);
+    }
+
+    @Override
+    protected void implDereg(SelectionKeyImpl ski) throws IOException {
+        assert !ski.isValid();
+        assert Thread.holdsLock(this);
+
+        int fd = ski.getFDVal();
+        if (fdToKey.remove(fd) != null) {
+            Long id = fdToPoll.remove(fd);
+            if (id != null) {
+                IOUring.pollRemove(ring, id, REMOVE_TAG);
+                // submit now, the armed poll holds a reference to the file
+                IOUring.enter(ring, 0);
+            }
+            ski.registeredEvents(0);
+        } else {
+            assert ski.registeredEvents() == 0;
+        }
+    }
+
+    @Override
+    public void setEventOps(SelectionKeyImpl ski) {
+        ensureOpen();
+        synchronized (updateLock) {
+            updateKeys.addLast(ski);
+        }
+    }
+
+    @Override
+    public Selector wakeup() {
+        synchronized (interruptLock) {
+            if (!interruptTriggered) {
+                try {
+                    IOUtil.write1(fd1, (byte)0);
+                } catch (IOException ioe) {
+                    throw new InternalError(ioe);
+                }
+                interruptTriggered = true;
+            }
+        }
+        return this;
+    }
+
+    private void clearInterrupt() throws IOException {
+        synchronized (interruptLock) {
+            IOUtil.drain(fd0);
+            interruptTriggered = false;
+        }
+    }
+}
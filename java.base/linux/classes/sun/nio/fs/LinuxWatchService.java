@@ -170,8 +170,10 @@ class LinuxWatchService
         private static final int IN_Q_OVERFLOW      = 0x00004000;
         private static final int IN_IGNORED         = 0x00008000;
 
-        // sizeof buffer for when polling inotify
-        private static final int BUFFER_SIZE = 8192;
+        // sizeof buffer for when polling inotify, large enough to drain a
+        // burst of events on a big tree with one read rather than one read
+        // per poll wakeup
+        private static final int BUFFER_SIZE = 64 * 1024;
 
         private final UnixFileSystem fs;
         private final LinuxWatchService watcher;
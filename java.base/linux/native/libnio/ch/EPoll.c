@@ -79,6 +79,26 @@ Java_sun_nio_ch_EPoll_ctl(JNIEnv *env, jclass clazz, jint epfd,
     return (res == 0) ? 0 : errno;
 }
 
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_EPoll_ctlBatch(JNIEnv *env, jclass clazz, jint epfd,
+                               jlong address, jint count)
+{
+    jint* updates = jlong_to_ptr(address);
+    struct epoll_event event;
+    int failures = 0;
+    int i;
+
+    for (i = 0; i < count; i++) {
+        jint* update = updates + (i * 3);
+        event.events = update[2];
+        event.data.fd = update[1];
+        if (epoll_ctl(epfd, (int)update[0], (int)update[1], &event) != 0) {
+            failures++;
+        }
+    }
+    return failures;
+}
+
 JNIEXPORT jint JNICALL
 Java_sun_nio_ch_EPoll_wait(JNIEnv *env, jclass clazz, jint epfd,
                            jlong address, jint numfds, jint timeout)
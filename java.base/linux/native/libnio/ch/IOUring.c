@@ -0,0 +1,427 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+
+#include "jni.h"
+#include "jni_util.h"
+#include "jvm.h"
+#include "jlong.h"
+#include "nio.h"
+#include "nio_util.h"
+
+#include "sun_nio_ch_IOUring.h"
+
+/*
+ * The io_uring interface is used through the raw system calls and the
+ * kernel ABI is described here so that the library builds against system
+ * headers that predate io_uring. Only the operations needed by the
+ * selector are defined.
+ */
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup     425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter     426
+#endif
+
+#define RING_OFF_SQ_RING        0ULL
+#define RING_OFF_CQ_RING        0x8000000ULL
+#define RING_OFF_SQES           0x10000000ULL
+
+#define RING_ENTER_GETEVENTS    (1U << 0)
+
+#define RING_FEAT_SINGLE_MMAP   (1U << 0)
+#define RING_FEAT_NODROP        (1U << 1)
+
+#define RING_OP_POLL_ADD        6
+#define RING_OP_POLL_REMOVE     7
+#define RING_OP_TIMEOUT         11
+
+struct ring_sqe {
+    uint8_t  opcode;
+    uint8_t  flags;
+    uint16_t ioprio;
+    int32_t  fd;
+    uint64_t off;
+    uint64_t addr;
+    uint32_t len;
+    uint32_t op_flags;          /* poll_events, timeout_flags, ... */
+    uint64_t user_data;
+    uint64_t pad[3];
+};
+
+struct ring_cqe {
+    uint64_t user_data;
+    int32_t  res;
+    uint32_t flags;
+};
+
+struct ring_sq_offsets {
+    uint32_t head;
+    uint32_t tail;
+    uint32_t ring_mask;
+    uint32_t ring_entries;
+    uint32_t flags;
+    uint32_t dropped;
+    uint32_t array;
+    uint32_t resv1;
+    uint64_t resv2;
+};
+
+struct ring_cq_offsets {
+    uint32_t head;
+    uint32_t tail;
+    uint32_t ring_mask;
+    uint32_t ring_entries;
+    uint32_t overflow;
+    uint32_t cqes;
+    uint32_t flags;
+    uint32_t resv1;
+    uint64_t resv2;
+};
+
+struct ring_params {
+    uint32_t sq_entries;
+    uint32_t cq_entries;
+    uint32_t flags;
+    uint32_t sq_thread_cpu;
+    uint32_t sq_thread_idle;
+    uint32_t features;
+    uint32_t wq_fd;
+    uint32_t resv[3];
+    struct ring_sq_offsets sq_off;
+    struct ring_cq_offsets cq_off;
+};
+
+struct ring_timespec {
+    int64_t tv_sec;
+    int64_t tv_nsec;
+};
+
+/*
+ * A ring instance. The submission queue tail is only written by the
+ * selector thread, the heads are written by the kernel (submission) and
+ * by the selector thread (completion).
+ */
+typedef struct {
+    int fd;
+
+    void* sq_ptr;
+    size_t sq_size;
+    void* cq_ptr;
+    size_t cq_size;
+    struct ring_sqe* sqes;
+    size_t sqes_size;
+
+    uint32_t* sq_khead;
+    uint32_t* sq_ktail;
+    uint32_t sq_mask;
+    uint32_t sq_entries;
+    uint32_t sq_tail;
+
+    uint32_t* cq_khead;
+    uint32_t* cq_ktail;
+    uint32_t cq_mask;
+    struct ring_cqe* cqes;
+
+    /* copied by the kernel when the timeout is submitted */
+    struct ring_timespec ts;
+} ring_t;
+
+static int ring_setup(unsigned int entries, struct ring_params* p) {
+    return (int) syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int ring_enter(int fd, unsigned int to_submit,
+                      unsigned int min_complete, unsigned int flags) {
+    return (int) syscall(__NR_io_uring_enter, fd, to_submit, min_complete,
+                         flags, NULL, 0);
+}
+
+static void ring_unmap(ring_t* ring) {
+    if (ring->sqes != NULL && ring->sqes != MAP_FAILED) {
+        munmap(ring->sqes, ring->sqes_size);
+    }
+    if (ring->cq_ptr != NULL && ring->cq_ptr != MAP_FAILED &&
+        ring->cq_ptr != ring->sq_ptr) {
+        munmap(ring->cq_ptr, ring->cq_size);
+    }
+    if (ring->sq_ptr != NULL && ring->sq_ptr != MAP_FAILED) {
+        munmap(ring->sq_ptr, ring->sq_size);
+    }
+}
+
+/*
+ * Number of entries queued by the selector but not yet consumed by the
+ * kernel.
+ */
+static unsigned int ring_pending(ring_t* ring) {
+    return ring->sq_tail - __atomic_load_n(ring->sq_khead, __ATOMIC_ACQUIRE);
+}
+
+/*
+ * Returns the next free submission queue entry, submitting the queued
+ * entries first if the queue is full. Returns NULL with errno set if the
+ * queued entries could not be submitted.
+ */
+static struct ring_sqe* ring_get_sqe(ring_t* ring) {
+    while (ring_pending(ring) >= ring->sq_entries) {
+        int res = ring_enter(ring->fd, ring_pending(ring), 0, 0);
+        if (res < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            return NULL;
+        }
+    }
+    struct ring_sqe* sqe = &ring->sqes[ring->sq_tail & ring->sq_mask];
+    memset(sqe, 0, sizeof(struct ring_sqe));
+    return sqe;
+}
+
+static void ring_publish(ring_t* ring) {
+    ring->sq_tail++;
+    __atomic_store_n(ring->sq_ktail, ring->sq_tail, __ATOMIC_RELEASE);
+}
+
+JNIEXPORT jlong JNICALL
+Java_sun_nio_ch_IOUring_create(JNIEnv *env, jclass clazz, jint entries)
+{
+    struct ring_params p;
+    ring_t* ring;
+    uint32_t* array;
+    uint32_t i;
+
+    memset(&p, 0, sizeof(p));
+    int fd = ring_setup((unsigned int) entries, &p);
+    if (fd < 0) {
+        JNU_ThrowIOExceptionWithLastError(env, "io_uring_setup failed");
+        return 0;
+    }
+    if ((p.features & RING_FEAT_NODROP) == 0) {
+        /* completions could be lost when the queue overflows */
+        close(fd);
+        JNU_ThrowIOException(env, "io_uring does not support IORING_FEAT_NODROP");
+        return 0;
+    }
+
+    ring = (ring_t*) calloc(1, sizeof(ring_t));
+    if (ring == NULL) {
+        close(fd);
+        JNU_ThrowOutOfMemoryError(env, NULL);
+        return 0;
+    }
+    ring->fd = fd;
+
+    ring->sq_size = p.sq_off.array + p.sq_entries * sizeof(uint32_t);
+    ring->cq_size = p.cq_off.cqes + p.cq_entries * sizeof(struct ring_cqe);
+    if ((p.features & RING_FEAT_SINGLE_MMAP) != 0) {
+        if (ring->cq_size > ring->sq_size) {
+            ring->sq_size = ring->cq_size;
+        }
+        ring->cq_size = ring->sq_size;
+    }
+
+    ring->sq_ptr = mmap(NULL, ring->sq_size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, fd, RING_OFF_SQ_RING);
+    if (ring->sq_ptr == MAP_FAILED) {
+        goto fail;
+    }
+    if ((p.features & RING_FEAT_SINGLE_MMAP) != 0) {
+        ring->cq_ptr = ring->sq_ptr;
+    } else {
+        ring->cq_ptr = mmap(NULL, ring->cq_size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, fd, RING_OFF_CQ_RING);
+        if (ring->cq_ptr == MAP_FAILED) {
+            goto fail;
+        }
+    }
+    ring->sqes_size = p.sq_entries * sizeof(struct ring_sqe);
+    ring->sqes = (struct ring_sqe*) mmap(NULL, ring->sqes_size,
+                                         PROT_READ | PROT_WRITE,
+                                         MAP_SHARED | MAP_POPULATE,
+                                         fd, RING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        goto fail;
+    }
+
+    ring->sq_khead = (uint32_t*) ((char*) ring->sq_ptr + p.sq_off.head);
+    ring->sq_ktail = (uint32_t*) ((char*) ring->sq_ptr + p.sq_off.tail);
+    ring->sq_mask = *(uint32_t*) ((char*) ring->sq_ptr + p.sq_off.ring_mask);
+    ring->sq_entries = p.sq_entries;
+    ring->sq_tail = *ring->sq_ktail;
+
+    /* the submission queue indirection array is an identity mapping */
+    array = (uint32_t*) ((char*) ring->sq_ptr + p.sq_off.array);
+    for (i = 0; i < p.sq_entries; i++) {
+        array[i] = i;
+    }
+
+    ring->cq_khead = (uint32_t*) ((char*) ring->cq_ptr + p.cq_off.head);
+    ring->cq_ktail = (uint32_t*) ((char*) ring->cq_ptr + p.cq_off.tail);
+    ring->cq_mask = *(uint32_t*) ((char*) ring->cq_ptr + p.cq_off.ring_mask);
+    ring->cqes = (struct ring_cqe*) ((char*) ring->cq_ptr + p.cq_off.cqes);
+
+    return ptr_to_jlong(ring);
+
+ fail:
+    JNU_ThrowIOExceptionWithLastError(env, "mmap of io_uring queues failed");
+    ring_unmap(ring);
+    close(fd);
+    free(ring);
+    return 0;
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_cqeSize(JNIEnv* env, jclass clazz)
+{
+    return sizeof(struct ring_cqe);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_userDataOffset(JNIEnv* env, jclass clazz)
+{
+    return offsetof(struct ring_cqe, user_data);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_resOffset(JNIEnv* env, jclass clazz)
+{
+    return offsetof(struct ring_cqe, res);
+}
+
+JNIEXPORT void JNICALL
+Java_sun_nio_ch_IOUring_pollAdd(JNIEnv *env, jclass clazz, jlong address,
+                                jint fd, jint events, jlong userData)
+{
+    ring_t* ring = jlong_to_ptr(address);
+    struct ring_sqe* sqe = ring_get_sqe(ring);
+    if (sqe == NULL) {
+        JNU_ThrowIOExceptionWithLastError(env, "io_uring_enter failed");
+        return;
+    }
+    sqe->opcode = RING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->op_flags = (uint32_t) (events & 0xffff);
+    sqe->user_data = (uint64_t) userData;
+    ring_publish(ring);
+}
+
+JNIEXPORT void JNICALL
+Java_sun_nio_ch_IOUring_pollRemove(JNIEnv *env, jclass clazz, jlong address,
+                                   jlong target, jlong userData)
+{
+    ring_t* ring = jlong_to_ptr(address);
+    struct ring_sqe* sqe = ring_get_sqe(ring);
+    if (sqe == NULL) {
+        JNU_ThrowIOExceptionWithLastError(env, "io_uring_enter failed");
+        return;
+    }
+    sqe->opcode = RING_OP_POLL_REMOVE;
+    sqe->fd = -1;
+    sqe->addr = (uint64_t) target;
+    sqe->user_data = (uint64_t) userData;
+    ring_publish(ring);
+}
+
+JNIEXPORT void JNICALL
+Java_sun_nio_ch_IOUring_timeout(JNIEnv *env, jclass clazz, jlong address,
+                                jlong millis, jlong userData)
+{
+    ring_t* ring = jlong_to_ptr(address);
+    struct ring_sqe* sqe = ring_get_sqe(ring);
+    if (sqe == NULL) {
+        JNU_ThrowIOExceptionWithLastError(env, "io_uring_enter failed");
+        return;
+    }
+    ring->ts.tv_sec = millis / 1000;
+    ring->ts.tv_nsec = (millis % 1000) * 1000000;
+    sqe->opcode = RING_OP_TIMEOUT;
+    sqe->fd = -1;
+    sqe->addr = (uint64_t) (uintptr_t) &ring->ts;
+    sqe->len = 1;
+    /* also complete as soon as any other completion is posted */
+    sqe->off = 1;
+    sqe->user_data = (uint64_t) userData;
+    ring_publish(ring);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_enter(JNIEnv *env, jclass clazz, jlong address,
+                              jint minComplete)
+{
+    ring_t* ring = jlong_to_ptr(address);
+    unsigned int flags = (minComplete > 0) ? RING_ENTER_GETEVENTS : 0;
+    unsigned int pending = ring_pending(ring);
+    if (pending == 0 && flags == 0) {
+        return 0;
+    }
+    int res = ring_enter(ring->fd, pending, (unsigned int) minComplete, flags);
+    if (res < 0) {
+        if (errno == EINTR) {
+            return IOS_INTERRUPTED;
+        } else if (errno == EAGAIN || errno == EBUSY) {
+            /* completion queue backlog, the caller reaps and retries */
+            return 0;
+        } else {
+            JNU_ThrowIOExceptionWithLastError(env, "io_uring_enter failed");
+            return IOS_THROWN;
+        }
+    }
+    return res;
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IOUring_reap(JNIEnv *env, jclass clazz, jlong address,
+                             jlong cqArrayAddress, jint max)
+{
+    ring_t* ring = jlong_to_ptr(address);
+    struct ring_cqe* out = jlong_to_ptr(cqArrayAddress);
+    uint32_t head = *ring->cq_khead;
+    uint32_t tail = __atomic_load_n(ring->cq_ktail, __ATOMIC_ACQUIRE);
+    int n = 0;
+    while (head != tail && n < max) {
+        out[n++] = ring->cqes[head & ring->cq_mask];
+        head++;
+    }
+    __atomic_store_n(ring->cq_khead, head, __ATOMIC_RELEASE);
+    return n;
+}
+
+JNIEXPORT void JNICALL
+Java_sun_nio_ch_IOUring_close(JNIEnv *env, jclass clazz, jlong address)
+{
+    ring_t* ring = jlong_to_ptr(address);
+    int fd = ring->fd;
+    ring_unmap(ring);
+    free(ring);
+    close(fd);
+}
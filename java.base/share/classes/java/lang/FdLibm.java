@@ -746,4 +746,377 @@ class FdLibm {
             }
         }
     }
+
+    /**
+     * Returns exp(x)-1, the exponential of x minus 1.
+     *
+     * Method
+     *   1. Argument reduction:
+     *      Given x, find r and integer k such that
+     *
+     *               x = k*ln2 + r,  |r| <= 0.5*ln2 ~ 0.34658
+     *
+     *      Here a correction term c will be computed to compensate
+     *      the error in r when rounded to a floating-point number.
+     *
+     *   2. Approximating expm1(r) by a special rational function on
+     *      the interval [0,0.34658], see s_expm1.c for the details of
+     *      the Remez approximation R1(r*r) and its error bound.
+     *
+     *   3. Scale back to obtain expm1(x):
+     *      From step 1, we have
+     *         expm1(x) = either 2^k*[expm1(r)+1] - 1
+     *                  = or     2^k*[expm1(r) + (1-2^-k)]
+     *
+     * Special cases:
+     *      expm1(INF) is INF, expm1(NaN) is NaN;
+     *      expm1(-INF) is -1, and
+     *      for finite argument, only expm1(0)=0 is exact.
+     *
+     * Accuracy:
+     *      according to an error analysis, the error is always less than
+     *      1 ulp (unit in the last place).
+     */
+    static class Expm1 {
+        private static final double one         = 1.0;
+        private static final double huge        = 1.0e+300;
+        private static final double tiny        = 1.0e-300;
+        private static final double o_threshold =  0x1.62e42fefa39efp9;   //  7.09782712893383973096e+02
+        private static final double ln2_hi      =  0x1.62e42feep-1;       //  6.93147180369123816490e-01
+        private static final double ln2_lo      =  0x1.a39ef35793c76p-33; //  1.90821492927058770002e-10
+        private static final double invln2      =  0x1.71547652b82fep0;   //  1.44269504088896338700e+00
+
+        // scaled coefficients related to expm1
+        private static final double Q1 = -0x1.11111111110f4p-5;  // -3.33333333333331316428e-02
+        private static final double Q2 =  0x1.a01a019fe5585p-10; //  1.58730158725481460165e-03
+        private static final double Q3 = -0x1.4ce199eaadbb7p-14; // -7.93650757867487942473e-05
+        private static final double Q4 =  0x1.0cfca86e65239p-18; //  4.00821782732936239552e-06
+        private static final double Q5 = -0x1.afdb76e09c32dp-23; // -2.01099218183624371326e-07
+
+        private Expm1() {
+            throw new UnsupportedOperationException();
+        }
+
+        public static strictfp double compute(double x) {
+            double y;
+            double hi;
+            double lo;
+            double c = 0.0;
+            double t;
+            double e;
+            double hxs;
+            double hfx;
+            double r1;
+            int k;
+            int xsb;
+            /*unsigned*/ int hx;
+
+            hx  = __HI(x);                  /* high word of x */
+            xsb = hx & 0x80000000;          /* sign bit of x */
+            y = (xsb == 0) ? x : -x;        /* y = |x| */
+            hx &= 0x7fffffff;               /* high word of |x| */
+
+            /* filter out huge and non-finite argument */
+            if (hx >= 0x4043687A) {                  /* if |x| >= 56*ln2 */
+                if (hx >= 0x40862E42) {              /* if |x| >= 709.78... */
+                    if (hx >= 0x7ff00000) {
+                        if (((hx & 0xfffff) | __LO(x)) != 0)
+                            return x + x;            /* NaN */
+                        else
+                            return (xsb == 0) ? x : -1.0; /* exp(+-inf) = {inf, -1} */
+                    }
+                    if (x > o_threshold)
+                        return INFINITY;             /* overflow */
+                }
+                if (xsb != 0) {         /* x < -56*ln2, return -1.0 */
+                    if (x + tiny < 0.0)
+                        return tiny - one;      /* return -1 */
+                }
+            }
+
+            /* argument reduction */
+            if (hx > 0x3fd62e42) {           /* if  |x| > 0.5 ln2 */
+                if (hx < 0x3FF0A2B2) {       /* and |x| < 1.5 ln2 */
+                    if (xsb == 0) {
+                        hi = x - ln2_hi;
+                        lo =  ln2_lo;
+                        k =  1;
+                    } else {
+                        hi = x + ln2_hi;
+                        lo = -ln2_lo;
+                        k = -1;
+                    }
+                } else {
+                    k  = (int)(invln2 * x + ((xsb == 0) ? 0.5 : -0.5));
+                    t  = k;
+                    hi = x - t*ln2_hi;      /* t*ln2_hi is exact here */
+                    lo = t*ln2_lo;
+                }
+                x  = hi - lo;
+                c  = (hi - x) - lo;
+            } else if (hx < 0x3c900000) {   /* when |x| < 2**-54, return x */
+                t = huge + x;
+                return x - (t - (huge + x));
+            } else {
+                k = 0;
+            }
+
+            /* x is now in primary range */
+            hfx = 0.5*x;
+            hxs = x*hfx;
+            r1 = one + hxs*(Q1 + hxs*(Q2 + hxs*(Q3 + hxs*(Q4 + hxs*Q5))));
+            t  = 3.0 - r1*hfx;
+            e  = hxs*((r1 - t)/(6.0 - x*t));
+            if (k == 0) {
+                return x - (x*e - hxs);             /* c is 0 */
+            } else {
+                e  = (x*(e - c) - c);
+                e -= hxs;
+                if (k == -1)
+                    return 0.5*(x - e) - 0.5;
+                if (k == 1) {
+                    if (x < -0.25)
+                        return -2.0*(e - (x + 0.5));
+                    else
+                        return  one + 2.0*(x - e);
+                }
+                if (k <= -2 || k > 56) {   /* suffice to return exp(x)-1 */
+                    y = one - (e - x);
+                    y = __HI(y, __HI(y) + (k << 20)); /* add k to y's exponent */
+                    return y - one;
+                }
+                t = one;
+                if (k < 20) {
+                    t = __HI(t, 0x3ff00000 - (0x200000 >> k));  /* t = 1-2^-k */
+                    y = t - (e - x);
+                    y = __HI(y, __HI(y) + (k << 20)); /* add k to y's exponent */
+                } else {
+                    t = __HI(t, ((0x3ff - k) << 20));  /* 2^-k */
+                    y = x - (e + t);
+                    y += one;
+                    y = __HI(y, __HI(y) + (k << 20)); /* add k to y's exponent */
+                }
+            }
+            return y;
+        }
+    }
+
+    /**
+     * Returns the hyperbolic sine of x.
+     *
+     * Method
+     *   mathematically sinh(x) if defined to be (exp(x)-exp(-x))/2
+     *   1. Replace x by |x| (sinh(-x) = -sinh(x)).
+     *   2.
+     *                                               E + E/(E+1)
+     *       0        <= x <= 22     :  sinh(x) := --------------, E=expm1(x)
+     *                                                   2
+     *
+     *       22       <= x <= lnovft :  sinh(x) := exp(x)/2
+     *       lnovft   <= x <= ln2ovft:  sinh(x) := exp(x/2)/2 * exp(x/2)
+     *       ln2ovft  <  x           :  sinh(x) := x*shuge (overflow)
+     *
+     * Special cases:
+     *      sinh(x) is |x| if x is +INF, -INF, or NaN.
+     *      only sinh(0)=0 is exact for finite x.
+     */
+    static class Sinh {
+        private static final double one = 1.0;
+        private static final double shuge = 1.0e307;
+
+        private Sinh() {
+            throw new UnsupportedOperationException();
+        }
+
+        public static strictfp double compute(double x) {
+            double t;
+            double w;
+            double h;
+            int ix;
+            int jx;
+            /*unsigned*/ int lx;
+
+            /* High word of |x|. */
+            jx = __HI(x);
+            ix = jx & 0x7fffffff;
+
+            /* x is INF or NaN */
+            if (ix >= 0x7ff00000)
+                return x + x;
+
+            h = 0.5;
+            if (jx < 0)
+                h = -h;
+            /* |x| in [0,22], return sign(x)*0.5*(E+E/(E+1))) */
+            if (ix < 0x40360000) {          /* |x| < 22 */
+                if (ix < 0x3e300000)        /* |x| < 2**-28 */
+                    if (shuge + x > one)
+                        return x;           /* sinh(tiny) = tiny */
+                t = Expm1.compute(Math.abs(x));
+                if (ix < 0x3ff00000)
+                    return h*(2.0*t - t*t/(t + one));
+                return h*(t + t/(t + one));
+            }
+
+            /* |x| in [22, log(maxdouble)] return 0.5*exp(|x|) */
+            if (ix < 0x40862E42)
+                return h*Exp.compute(Math.abs(x));
+
+            /* |x| in [log(maxdouble), overflowthresold] */
+            lx = __LO(x);
+            if (ix < 0x408633CE ||
+                ((ix == 0x408633ce) && (Integer.compareUnsigned(lx, 0x8fb9f87d) <= 0))) {
+                w = Exp.compute(0.5*Math.abs(x));
+                t = h*w;
+                return t*w;
+            }
+
+            /* |x| > overflowthresold, sinh(x) overflow */
+            return x*shuge;
+        }
+    }
+
+    /**
+     * Returns the hyperbolic cosine of x.
+     *
+     * Method
+     *   mathematically cosh(x) if defined to be (exp(x)+exp(-x))/2
+     *   1. Replace x by |x| (cosh(x) = cosh(-x)).
+     *   2.
+     *                                                   [ exp(x) - 1 ]^2
+     *       0        <= x <= ln2/2  :  cosh(x) := 1 + -------------------
+     *                                                      2*exp(x)
+     *
+     *                                             exp(x) +  1/exp(x)
+     *       ln2/2    <= x <= 22     :  cosh(x) := -------------------
+     *                                                    2
+     *       22       <= x <= lnovft :  cosh(x) := exp(x)/2
+     *       lnovft   <= x <= ln2ovft:  cosh(x) := exp(x/2)/2 * exp(x/2)
+     *       ln2ovft  <  x           :  cosh(x) := huge*huge (overflow)
+     *
+     * Special cases:
+     *      cosh(x) is |x| if x is +INF, -INF, or NaN.
+     *      only cosh(0)=1 is exact for finite x.
+     */
+    static class Cosh {
+        private static final double one = 1.0;
+        private static final double half = 0.5;
+
+        private Cosh() {
+            throw new UnsupportedOperationException();
+        }
+
+        public static strictfp double compute(double x) {
+            double t;
+            double w;
+            int ix;
+            /*unsigned*/ int lx;
+
+            /* High word of |x|. */
+            ix = __HI(x);
+            ix &= 0x7fffffff;
+
+            /* x is INF or NaN */
+            if (ix >= 0x7ff00000)
+                return x*x;
+
+            /* |x| in [0,0.5*ln2], return 1+expm1(|x|)^2/(2*exp(|x|)) */
+            if (ix < 0x3fd62e43) {
+                t = Expm1.compute(Math.abs(x));
+                w = one + t;
+                if (ix < 0x3c800000)
+                    return w;                /* cosh(tiny) = 1 */
+                return one + (t*t)/(w + w);
+            }
+
+            /* |x| in [0.5*ln2,22], return (exp(|x|)+1/exp(|x|)/2; */
+            if (ix < 0x40360000) {
+                t = Exp.compute(Math.abs(x));
+                return half*t + half/t;
+            }
+
+            /* |x| in [22, log(maxdouble)] return half*exp(|x|) */
+            if (ix < 0x40862E42)
+                return half*Exp.compute(Math.abs(x));
+
+            /* |x| in [log(maxdouble), overflowthresold] */
+            lx = __LO(x);
+            if (ix < 0x408633CE ||
+                ((ix == 0x408633ce) && (Integer.compareUnsigned(lx, 0x8fb9f87d) <= 0))) {
+                w = Exp.compute(half*Math.abs(x));
+                t = half*w;
+                return t*w;
+            }
+
+            /* |x| > overflowthresold, cosh(x) overflow */
+            return INFINITY;
+        }
+    }
+
+    /**
+     * Returns the hyperbolic tangent of x.
+     *
+     * Method
+     *                                     x    -x
+     *                                    e  - e
+     *   0. tanh(x) is defined to be -----------
+     *                                     x    -x
+     *                                    e  + e
+     *   1. reduce x to non-negative by tanh(-x) = -tanh(x).
+     *   2.  0      <= x <= 2**-55 : tanh(x) := x*(one+x)
+     *                                          -t
+     *       2**-55 <  x <=  1     : tanh(x) := -----; t = expm1(-2x)
+     *                                         t + 2
+     *                                               2
+     *       1      <= x <=  22.0  : tanh(x) := 1-  ----- ; t=expm1(2x)
+     *                                             t + 2
+     *       22.0   <  x <= INF    : tanh(x) := 1.
+     *
+     * Special cases:
+     *      tanh(NaN) is NaN;
+     *      only tanh(0)=0 is exact for finite argument.
+     */
+    static class Tanh {
+        private static final double one  = 1.0;
+        private static final double two  = 2.0;
+        private static final double tiny = 1.0e-300;
+
+        private Tanh() {
+            throw new UnsupportedOperationException();
+        }
+
+        public static strictfp double compute(double x) {
+            double t;
+            double z;
+            int jx;
+            int ix;
+
+            /* High word of |x|. */
+            jx = __HI(x);
+            ix = jx & 0x7fffffff;
+
+            /* x is INF or NaN */
+            if (ix >= 0x7ff00000) {
+                if (jx >= 0)
+                    return one/x + one;    /* tanh(+-inf) = +-1 */
+                else
+                    return one/x - one;    /* tanh(NaN) = NaN */
+            }
+
+            if (ix < 0x40360000) {          /* |x| < 22 */
+                if (ix < 0x3c800000)        /* |x| < 2**-55 */
+                    return x*(one + x);     /* tanh(small) = small */
+                if (ix >= 0x3ff00000) {     /* |x| >= 1  */
+                    t = Expm1.compute(two*Math.abs(x));
+                    z = one - two/(t + two);
+                } else {
+                    t = Expm1.compute(-two*Math.abs(x));
+                    z = -t/(t + two);
+                }
+            } else {                        /* |x| > 22, return +-1 */
+                z = one - tiny;
+            }
+            return (jx >= 0) ? z : -z;
+        }
+    }
 }
@@ -739,6 +739,16 @@ public abstract class Buffer {
                 public JavaNioAccess.BufferPool getDirectBufferPool() {
                     return Bits.BUFFER_POOL;
                 }
+
+                @Override
+                public void advise(MappedByteBuffer mbb, int index, int length, int advice) {
+                    mbb.advise(index, length, advice);
+                }
+
+                @Override
+                public void forceAsync(MappedByteBuffer mbb, int index, int length) {
+                    mbb.forceAsync(index, length);
+                }
             });
     }
 
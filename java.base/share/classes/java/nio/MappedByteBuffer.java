@@ -309,9 +309,46 @@ public abstract class MappedByteBuffer
         return this;
     }
 
+    /**
+     * Gives the operating system advice about the expected use of a region
+     * of this buffer's content. The advice values are those documented by
+     * {@link jdk.internal.access.JavaNioAccess#advise}. Does nothing if
+     * this buffer is not mapped to a file.
+     */
+    final void advise(int index, int length, int advice) {
+        if (fd == null) {
+            return;
+        }
+        if ((address != 0) && (limit() != 0)) {
+            // check inputs
+            Objects.checkFromIndexSize(index, length, limit());
+            long offset = mappingOffset(index);
+            advise0(mappingAddress(offset, index), mappingLength(offset, length), advice);
+        }
+    }
+
+    /**
+     * Initiates writing back a region of this buffer's content to the
+     * storage device without waiting for it to complete. Does nothing if
+     * this buffer is not mapped to a file.
+     */
+    final void forceAsync(int index, int length) {
+        if (fd == null) {
+            return;
+        }
+        if ((address != 0) && (limit() != 0)) {
+            // check inputs
+            Objects.checkFromIndexSize(index, length, limit());
+            long offset = mappingOffset(index);
+            forceAsync0(fd, mappingAddress(offset, index), mappingLength(offset, length));
+        }
+    }
+
     private native boolean isLoaded0(long address, long length, int pageCount);
     private native void load0(long address, long length);
     private native void force0(FileDescriptor fd, long address, long length);
+    private native void advise0(long address, long length, int advice);
+    private native void forceAsync0(FileDescriptor fd, long address, long length);
 
     // -- Covariant return type overrides
 
@@ -4505,11 +4505,7 @@ public class Arrays {
         if (a == null)
             return 0;
 
-        int result = 1;
-        for (int element : a)
-            result = 31 * result + element;
-
-        return result;
+        return ArraysSupport.vectorizedHashCode(a, 0, a.length, 1, ArraysSupport.T_INT);
     }
 
     /**
@@ -4532,11 +4528,7 @@ public class Arrays {
         if (a == null)
             return 0;
 
-        int result = 1;
-        for (short element : a)
-            result = 31 * result + element;
-
-        return result;
+        return ArraysSupport.vectorizedHashCode(a, 0, a.length, 1, ArraysSupport.T_SHORT);
     }
 
     /**
@@ -4559,11 +4551,7 @@ public class Arrays {
         if (a == null)
             return 0;
 
-        int result = 1;
-        for (char element : a)
-            result = 31 * result + element;
-
-        return result;
+        return ArraysSupport.vectorizedHashCode(a, 0, a.length, 1, ArraysSupport.T_CHAR);
     }
 
     /**
@@ -4586,11 +4574,7 @@ public class Arrays {
         if (a == null)
             return 0;
 
-        int result = 1;
-        for (byte element : a)
-            result = 31 * result + element;
-
-        return result;
+        return ArraysSupport.vectorizedHashCode(a, 0, a.length, 1, ArraysSupport.T_BYTE);
     }
 
     /**
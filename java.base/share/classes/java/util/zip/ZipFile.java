@@ -1118,7 +1118,17 @@ class ZipFile implements ZipConstants, Closeable {
         private static final int ZIP_ENDCHAIN  = -1;
         private int total;                   // total number of entries
         private int[] table;                 // Hash chain heads: indexes into entries
-        private int tablelen;                // number of hash heads
+        private int tablelen;                // number of hash heads, a power of two
+
+        // The table has a head per entry, rounded up to a power of two, so
+        // chains are short and the head is found with a mask, not a division
+        private static int tableSize(int total) {
+            return (total <= 1) ? 1 : Integer.highestOneBit(total - 1) << 1;
+        }
+
+        private int tableIndex(int hash) {
+            return (hash ^ (hash >>> 16)) & (tablelen - 1);
+        }
 
         private static class Key {
             BasicFileAttributes attrs;
@@ -1403,7 +1413,7 @@ class ZipFile implements ZipConstants, Closeable {
             }
             // hash table for entries
             entries  = new int[total * 3];
-            tablelen = ((total/2) | 1); // Odd -> fewer collisions
+            tablelen = tableSize(total);
             table    =  new int[tablelen];
             Arrays.fill(table, ZIP_ENDCHAIN);
             int idx = 0;
@@ -1440,7 +1450,7 @@ class ZipFile implements ZipConstants, Closeable {
                     zerror("invalid CEN header (bad header size)");
                 // Record the CEN offset and the name hash in our hash cell.
                 hash = hashN(cen, pos + CENHDR, nlen);
-                hsh = (hash & 0x7fffffff) % tablelen;
+                hsh = tableIndex(hash);
                 next = table[hsh];
                 table[hsh] = idx;
                 idx = addEntry(idx, hash, next, pos);
@@ -1479,7 +1489,7 @@ class ZipFile implements ZipConstants, Closeable {
                 return -1;
             }
             int hsh = hashN(name, 0, name.length);
-            int idx = table[(hsh & 0x7fffffff) % tablelen];
+            int idx = table[tableIndex(hsh)];
             /*
              * This while loop is an optimization where a double lookup
              * for name and name+/ is being performed. The name char
@@ -1495,19 +1505,12 @@ class ZipFile implements ZipConstants, Closeable {
                     if (getEntryHash(idx) == hsh) {
                         // The CEN name must match the specfied one
                         int pos = getEntryPos(idx);
-                        if (name.length == CENNAM(cen, pos)) {
-                            boolean matched = true;
-                            int nameoff = pos + CENHDR;
-                            for (int i = 0; i < name.length; i++) {
-                                if (name[i] != cen[nameoff++]) {
-                                    matched = false;
-                                    break;
-                                }
-                            }
-                            if (matched) {
-                                return pos;
-                            }
-                         }
+                        int nameoff = pos + CENHDR;
+                        if (name.length == CENNAM(cen, pos) &&
+                            Arrays.equals(name, 0, name.length,
+                                          cen, nameoff, nameoff + name.length)) {
+                            return pos;
+                        }
                     }
                     idx = getEntryNext(idx);
                 }
@@ -1519,8 +1522,7 @@ class ZipFile implements ZipConstants, Closeable {
                 name = Arrays.copyOf(name, name.length + 1);
                 name[name.length - 1] = '/';
                 hsh = hash_append(hsh, (byte)'/');
-                //idx = table[hsh % tablelen];
-                idx = table[(hsh & 0x7fffffff) % tablelen];
+                idx = table[tableIndex(hsh)];
                 addSlash = false;
             }
         }
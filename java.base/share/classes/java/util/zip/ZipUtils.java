@@ -39,6 +39,7 @@ import java.util.concurrent.TimeUnit;
 import static java.util.zip.ZipConstants.ENDHDR;
 
 import jdk.internal.misc.Unsafe;
+import sun.security.action.GetPropertyAction;
 
 class ZipUtils {
 
@@ -285,8 +286,36 @@ class ZipUtils {
             PrivilegedAction<Void> pa = () -> { System.loadLibrary("zip"); return null; };
             AccessController.doPrivileged(pa);
         }
+        ZlibBackend.select();
     }
 
+    /**
+     * Selects the zlib used by Inflater and Deflater once, before any
+     * stream is created. The jdk.zip.zlib system property names a zlib
+     * compatible library, for example zlib-ng built in compat mode, to use
+     * in place of the zlib libzip is built with. The built-in zlib is kept
+     * if the library cannot be loaded or is not compatible.
+     */
+    private static class ZlibBackend {
+        static {
+            String path = GetPropertyAction.privilegedGetProperty("jdk.zip.zlib");
+            if (path != null && !path.isEmpty()) {
+                PrivilegedAction<Boolean> pa = () -> {
+                    try {
+                        return loadZlib(path);
+                    } catch (UnsatisfiedLinkError e) {
+                        return false;
+                    }
+                };
+                AccessController.doPrivileged(pa);
+            }
+        }
+
+        static void select() { }
+    }
+
+    private static native boolean loadZlib(String path);
+
     private static final Unsafe unsafe = Unsafe.getUnsafe();
 
     private static final long byteBufferArrayOffset = unsafe.objectFieldOffset(ByteBuffer.class, "hb");
@@ -27,6 +27,7 @@ package jdk.internal.access;
 
 import java.nio.Buffer;
 import java.nio.ByteBuffer;
+import java.nio.MappedByteBuffer;
 
 public interface JavaNioAccess {
     /**
@@ -39,4 +40,19 @@ public interface JavaNioAccess {
         long getMemoryUsed();
     }
     BufferPool getDirectBufferPool();
+
+    /**
+     * Advises the operating system about the expected use of the pages
+     * backing a region of a mapped buffer. The advice is one of 0 (normal),
+     * 1 (random), 2 (sequential), 3 (will need) or 4 (don't need).
+     * Does nothing if the buffer is not mapped to a file.
+     */
+    void advise(MappedByteBuffer mbb, int index, int length, int advice);
+
+    /**
+     * Initiates writing back a region of a mapped buffer without waiting
+     * for the write to complete. Does nothing if the buffer is not mapped
+     * to a file.
+     */
+    void forceAsync(MappedByteBuffer mbb, int index, int length);
 }
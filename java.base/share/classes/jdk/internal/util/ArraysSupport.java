@@ -160,6 +160,78 @@ public class ArraysSupport {
         }
     }
 
+    // Element types for vectorizedHashCode, with the values of the VM's
+    // BasicType.  T_BOOLEAN denotes the bytes of a byte[] taken as unsigned
+    // values, as in Latin1 strings.
+    public static final int T_BOOLEAN = 4;
+    public static final int T_CHAR = 5;
+    public static final int T_BYTE = 8;
+    public static final int T_SHORT = 9;
+    public static final int T_INT = 10;
+
+    /**
+     * Calculates the polynomial hash code of a range of array elements,
+     * continuing from an initial value:
+     * {@code 31^length * initialValue + a[fromIndex] * 31^(length - 1) + ...
+     * + a[fromIndex + length - 1]}.
+     *
+     * <p>This method does not perform bounds checks.  It is the responsibility
+     * of the caller to perform such checks before calling this method.
+     *
+     * @param array the array, a {@code byte[]} for {@code T_BOOLEAN} and
+     * {@code T_BYTE}, otherwise an array of the given element type
+     * @param fromIndex the index of the first element to hash
+     * @param length the number of elements to hash
+     * @param initialValue the hash value to continue from
+     * @param basicType the element type, one of the {@code T_*} constants
+     * @return the hash code
+     */
+    @HotSpotIntrinsicCandidate
+    public static int vectorizedHashCode(Object array, int fromIndex, int length,
+                                         int initialValue, int basicType) {
+        int end = fromIndex + length;
+        int h = initialValue;
+        switch (basicType) {
+            case T_BOOLEAN: {
+                byte[] a = (byte[]) array;
+                for (int i = fromIndex; i < end; i++) {
+                    h = 31 * h + (a[i] & 0xff);
+                }
+                return h;
+            }
+            case T_BYTE: {
+                byte[] a = (byte[]) array;
+                for (int i = fromIndex; i < end; i++) {
+                    h = 31 * h + a[i];
+                }
+                return h;
+            }
+            case T_CHAR: {
+                char[] a = (char[]) array;
+                for (int i = fromIndex; i < end; i++) {
+                    h = 31 * h + a[i];
+                }
+                return h;
+            }
+            case T_SHORT: {
+                short[] a = (short[]) array;
+                for (int i = fromIndex; i < end; i++) {
+                    h = 31 * h + a[i];
+                }
+                return h;
+            }
+            case T_INT: {
+                int[] a = (int[]) array;
+                for (int i = fromIndex; i < end; i++) {
+                    h = 31 * h + a[i];
+                }
+                return h;
+            }
+            default:
+                throw new IllegalArgumentException("unrecognized basic type: " + basicType);
+        }
+    }
+
     // Booleans
     // Each boolean element takes up one byte
 
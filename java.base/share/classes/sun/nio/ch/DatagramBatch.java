@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package sun.nio.ch;
+
+import java.io.IOException;
+import java.net.SocketAddress;
+import java.nio.ByteBuffer;
+import java.nio.channels.DatagramChannel;
+
+/**
+ * Batched receive and send for the JDK's DatagramChannel implementation,
+ * used by the jdk.net module. Other DatagramChannel implementations are
+ * served one datagram at a time.
+ */
+
+public final class DatagramBatch {
+    private DatagramBatch() { }
+
+    /**
+     * Returns the maximum number of datagrams handled in one call.
+     */
+    public static int maxBatchSize() {
+        return DatagramChannelImpl.MAX_BATCH;
+    }
+
+    public static int receive(DatagramChannel dc,
+                              ByteBuffer[] dsts,
+                              SocketAddress[] senders)
+        throws IOException
+    {
+        if (dc instanceof DatagramChannelImpl)
+            return ((DatagramChannelImpl)dc).receive(dsts, senders);
+
+        if (dsts.length == 0 || senders.length == 0)
+            return 0;
+        SocketAddress sa = dc.receive(dsts[0]);
+        if (sa == null)
+            return 0;
+        senders[0] = sa;
+        return 1;
+    }
+
+    public static int send(DatagramChannel dc,
+                           ByteBuffer[] srcs,
+                           SocketAddress target)
+        throws IOException
+    {
+        if (dc instanceof DatagramChannelImpl)
+            return ((DatagramChannelImpl)dc).send(srcs, target);
+
+        if (srcs.length == 0)
+            return 0;
+        int rem = srcs[0].remaining();
+        return (dc.send(srcs[0], target) == rem) ? 1 : 0;
+    }
+}
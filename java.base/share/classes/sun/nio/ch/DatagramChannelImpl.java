@@ -610,6 +610,187 @@ class DatagramChannelImpl
         return written;
     }
 
+    // Maximum number of datagrams received or sent in one batch
+    static final int MAX_BATCH = 64;
+
+    // true if receiveBatch0 and sendBatch0 are implemented
+    private static final boolean BATCH_SUPPORTED;
+
+    /**
+     * Receives up to {@code dsts.length} datagrams, one into each buffer,
+     * with a single system call where supported. The source address of the
+     * i-th datagram is stored in {@code senders[i]}. In blocking mode this
+     * method waits for the first datagram only.
+     *
+     * @return the number of datagrams received, 0 if none is immediately
+     *         available in non-blocking mode
+     */
+    int receive(ByteBuffer[] dsts, SocketAddress[] senders) throws IOException {
+        int count = Math.min(Math.min(dsts.length, senders.length), MAX_BATCH);
+        for (int i = 0; i < count; i++) {
+            if (dsts[i].isReadOnly())
+                throw new IllegalArgumentException("Read-only buffer");
+        }
+        if (count == 0)
+            return 0;
+
+        // Without batching, or when each sender must be checked by the
+        // security manager, receive one datagram
+        if (!BATCH_SUPPORTED ||
+            (System.getSecurityManager() != null && !isConnected())) {
+            SocketAddress sa = receive(dsts[0]);
+            if (sa == null)
+                return 0;
+            senders[0] = sa;
+            return 1;
+        }
+
+        readLock.lock();
+        try {
+            boolean blocking = isBlocking();
+            long[] addresses = new long[count];
+            int[] lengths = new int[count];
+            ByteBuffer[] shadows = new ByteBuffer[count];
+            int n = 0;
+            try {
+                SocketAddress remote = beginRead(blocking, false);
+                boolean connected = (remote != null);
+                for (int i = 0; i < count; i++) {
+                    ByteBuffer dst = dsts[i];
+                    int rem = dst.remaining();
+                    if (dst instanceof DirectBuffer) {
+                        addresses[i] = ((DirectBuffer)dst).address() + dst.position();
+                    } else {
+                        ByteBuffer bb = Util.getTemporaryDirectBuffer(rem);
+                        shadows[i] = bb;
+                        addresses[i] = ((DirectBuffer)bb).address();
+                    }
+                    lengths[i] = rem;
+                }
+                SocketAddress[] sa = connected ? null : senders;
+                n = receiveBatch0(fd, addresses, lengths, count, sa);
+                if (blocking) {
+                    while (IOStatus.okayToRetry(n) && isOpen()) {
+                        park(Net.POLLIN);
+                        n = receiveBatch0(fd, addresses, lengths, count, sa);
+                    }
+                }
+                for (int i = 0; i < n; i++) {
+                    ByteBuffer dst = dsts[i];
+                    // a datagram longer than the buffer is truncated
+                    int len = Math.min(lengths[i], dst.remaining());
+                    if (shadows[i] != null) {
+                        ByteBuffer bb = shadows[i];
+                        bb.limit(len);
+                        dst.put(bb);
+                    } else {
+                        dst.position(dst.position() + len);
+                    }
+                    if (connected)
+                        senders[i] = remote;
+                }
+            } finally {
+                for (ByteBuffer bb : shadows) {
+                    if (bb != null)
+                        Util.releaseTemporaryDirectBuffer(bb);
+                }
+                endRead(blocking, n > 0);
+                assert IOStatus.check(n);
+            }
+            return IOStatus.normalize(n);
+        } finally {
+            readLock.unlock();
+        }
+    }
+
+    /**
+     * Sends up to {@code srcs.length} datagrams, one from each buffer, to
+     * the given target with a single system call where supported. The
+     * position of each buffer whose datagram was sent is advanced to its
+     * limit.
+     *
+     * @return the number of datagrams sent, 0 if none could be sent
+     *         immediately in non-blocking mode
+     */
+    int send(ByteBuffer[] srcs, SocketAddress target) throws IOException {
+        int count = Math.min(srcs.length, MAX_BATCH);
+        if (count == 0)
+            return 0;
+        if (!BATCH_SUPPORTED)
+            return (send(srcs[0], target) > 0 || !srcs[0].hasRemaining()) ? 1 : 0;
+
+        InetSocketAddress isa = Net.checkAddress(target, family);
+
+        writeLock.lock();
+        try {
+            boolean blocking = isBlocking();
+            long[] addresses = new long[count];
+            int[] lengths = new int[count];
+            ByteBuffer[] shadows = new ByteBuffer[count];
+            int n = 0;
+            try {
+                SocketAddress remote = beginWrite(blocking, false);
+                if (remote != null) {
+                    // connected
+                    if (!target.equals(remote)) {
+                        throw new AlreadyConnectedException();
+                    }
+                    isa = null;
+                } else {
+                    // not connected
+                    SecurityManager sm = System.getSecurityManager();
+                    InetAddress ia = isa.getAddress();
+                    if (sm != null) {
+                        if (ia.isMulticastAddress()) {
+                            sm.checkMulticast(ia);
+                        } else {
+                            sm.checkConnect(ia.getHostAddress(), isa.getPort());
+                        }
+                    }
+                    if (ia.isLinkLocalAddress())
+                        isa = IPAddressUtil.toScopedAddress(isa);
+                }
+                for (int i = 0; i < count; i++) {
+                    ByteBuffer src = srcs[i];
+                    int rem = src.remaining();
+                    if (src instanceof DirectBuffer) {
+                        addresses[i] = ((DirectBuffer)src).address() + src.position();
+                    } else {
+                        ByteBuffer bb = Util.getTemporaryDirectBuffer(rem);
+                        bb.put(src.duplicate());
+                        shadows[i] = bb;
+                        addresses[i] = ((DirectBuffer)bb).address();
+                    }
+                    lengths[i] = rem;
+                }
+                boolean preferIPv6 = (family != StandardProtocolFamily.INET);
+                InetAddress ia = (isa != null) ? isa.getAddress() : null;
+                int port = (isa != null) ? isa.getPort() : 0;
+                n = sendBatch0(preferIPv6, fd, addresses, lengths, count, ia, port);
+                if (blocking) {
+                    while (IOStatus.okayToRetry(n) && isOpen()) {
+                        park(Net.POLLOUT);
+                        n = sendBatch0(preferIPv6, fd, addresses, lengths, count,
+                                       ia, port);
+                    }
+                }
+                for (int i = 0; i < n; i++) {
+                    srcs[i].position(srcs[i].limit());
+                }
+            } finally {
+                for (ByteBuffer bb : shadows) {
+                    if (bb != null)
+                        Util.releaseTemporaryDirectBuffer(bb);
+                }
+                endWrite(blocking, n > 0);
+                assert IOStatus.check(n);
+            }
+            return IOStatus.normalize(n);
+        } finally {
+            writeLock.unlock();
+        }
+    }
+
     @Override
     public int read(ByteBuffer buf) throws IOException {
         Objects.requireNonNull(buf);
@@ -1375,8 +1556,21 @@ class DatagramChannelImpl
                              int len, InetAddress addr, int port)
         throws IOException;
 
+    private static native boolean batchSupported0();
+
+    private native int receiveBatch0(FileDescriptor fd, long[] addresses,
+                                     int[] lengths, int count,
+                                     SocketAddress[] senders)
+        throws IOException;
+
+    private native int sendBatch0(boolean preferIPv6, FileDescriptor fd,
+                                  long[] addresses, int[] lengths, int count,
+                                  InetAddress addr, int port)
+        throws IOException;
+
     static {
         IOUtil.load();
         initIDs();
+        BATCH_SUPPORTED = batchSupported0();
     }
 }
@@ -482,6 +482,16 @@ public class FileChannelImpl
     //
     private static volatile boolean fileSupported = true;
 
+    // Assume at first that the underlying kernel supports copy_file_range();
+    // set this to false if we find out later that it doesn't
+    //
+    private static volatile boolean fileRangeSupported = true;
+
+    // Assume at first that the underlying kernel supports splice(); set
+    // this to false if we find out later that it doesn't
+    //
+    private static volatile boolean spliceSupported = true;
+
     private long transferToDirectlyInternal(long position, int icount,
                                             WritableByteChannel target,
                                             FileDescriptor targetFD)
@@ -497,6 +507,17 @@ public class FileChannelImpl
             ti = threads.add();
             if (!isOpen())
                 return -1;
+            if ((target instanceof FileChannelImpl) && fileRangeSupported) {
+                // copies at, and advances, the target's position as
+                // sendfile does
+                do {
+                    n = nd.copyFileRange(fd, position, targetFD, -1, icount);
+                } while ((n == IOStatus.INTERRUPTED) && isOpen());
+                if (n == IOStatus.UNSUPPORTED)
+                    fileRangeSupported = false;
+                if (n >= 0)
+                    return n;
+            }
             do {
                 n = transferTo0(fd, position, icount, targetFD);
             } while ((n == IOStatus.INTERRUPTED) && isOpen());
@@ -686,6 +707,41 @@ public class FileChannelImpl
         return transferToArbitraryChannel(position, icount, target);
     }
 
+    /**
+     * Copies up to count bytes from src at srcPosition to this channel at
+     * position with copy_file_range. Returns the number of bytes copied,
+     * or a negative value if nothing could be copied this way.
+     */
+    private long copyFileRange(FileChannelImpl src, long srcPosition,
+                               long position, long count)
+        throws IOException
+    {
+        long tw = 0;
+        long n = -1;
+        int ti = -1;
+        try {
+            beginBlocking();
+            ti = threads.add();
+            if (!isOpen())
+                return -1;
+            while (tw < count) {
+                do {
+                    n = nd.copyFileRange(src.fd, srcPosition + tw,
+                                         fd, position + tw, count - tw);
+                } while ((n == IOStatus.INTERRUPTED) && isOpen());
+                if (n == IOStatus.UNSUPPORTED)
+                    fileRangeSupported = false;
+                if (n <= 0)
+                    break;
+                tw += n;
+            }
+            return (tw > 0 || n == 0) ? tw : n;
+        } finally {
+            threads.remove(ti);
+            end (tw > 0 || n > -1);
+        }
+    }
+
     private long transferFromFileChannel(FileChannelImpl src,
                                          long position, long count)
         throws IOException
@@ -696,6 +752,14 @@ public class FileChannelImpl
             long pos = src.position();
             long max = Math.min(count, src.size() - pos);
 
+            if (fileRangeSupported && max > 0) {
+                long n = copyFileRange(src, pos, position, max);
+                if (n >= 0) {
+                    src.position(pos + n);
+                    return n;
+                }
+            }
+
             long remaining = max;
             long p = pos;
             while (remaining > 0L) {
@@ -723,6 +787,36 @@ public class FileChannelImpl
         }
     }
 
+    private long transferFromSocketChannel(SocketChannelImpl src,
+                                           long position, long count)
+        throws IOException
+    {
+        long tw = 0;                    // Total bytes written
+        long pos = position;
+        try {
+            while (tw < count) {
+                ensureOpen();
+                long n = src.transferTo(nd, fd, pos, count - tw);
+                if (n == IOStatus.UNSUPPORTED ||
+                    n == IOStatus.UNSUPPORTED_CASE) {
+                    if (n == IOStatus.UNSUPPORTED)
+                        spliceSupported = false;
+                    return tw + transferFromArbitraryChannel(src, pos,
+                                                             count - tw);
+                }
+                if (n <= 0)
+                    break;
+                tw += n;
+                pos += n;
+            }
+            return tw;
+        } catch (IOException x) {
+            if (tw > 0)
+                return tw;
+            throw x;
+        }
+    }
+
     private static final int TRANSFER_SIZE = 8192;
 
     private long transferFromArbitraryChannel(ReadableByteChannel src,
@@ -774,6 +868,9 @@ public class FileChannelImpl
         if (src instanceof FileChannelImpl)
            return transferFromFileChannel((FileChannelImpl)src,
                                           position, count);
+        if ((src instanceof SocketChannelImpl) && spliceSupported)
+            return transferFromSocketChannel((SocketChannelImpl)src,
+                                             position, count);
 
         return transferFromArbitraryChannel(src, position, count);
     }
@@ -857,6 +954,196 @@ public class FileChannelImpl
         }
     }
 
+    /**
+     * Reads a sequence of bytes from this channel into a subsequence of the
+     * given buffers, starting at the given file position. The file position
+     * of the channel is not changed.
+     */
+    public long read(ByteBuffer[] dsts, int offset, int length, long position)
+        throws IOException
+    {
+        if ((offset < 0) || (length < 0) || (offset > dsts.length - length))
+            throw new IndexOutOfBoundsException();
+        if (position < 0)
+            throw new IllegalArgumentException("Negative position");
+        if (!readable)
+            throw new NonReadableChannelException();
+        if (direct)
+            Util.checkChannelPositionAligned(position, alignment);
+        ensureOpen();
+        if (!nd.supportsPositionalVectoredIO()) {
+            long total = 0;
+            for (int i = offset; i < offset + length; i++) {
+                ByteBuffer dst = dsts[i];
+                int rem = dst.remaining();
+                int n = read(dst, position + total);
+                if (n < 0)
+                    return (total > 0) ? total : -1;
+                total += n;
+                if (n < rem)
+                    break;
+            }
+            return total;
+        }
+        if (nd.needsPositionLock()) {
+            synchronized (positionLock) {
+                return readInternal(dsts, offset, length, position);
+            }
+        } else {
+            return readInternal(dsts, offset, length, position);
+        }
+    }
+
+    private long readInternal(ByteBuffer[] dsts, int offset, int length,
+                              long position)
+        throws IOException
+    {
+        assert !nd.needsPositionLock() || Thread.holdsLock(positionLock);
+        long n = 0;
+        int ti = -1;
+        try {
+            beginBlocking();
+            ti = threads.add();
+            if (!isOpen())
+                return -1;
+            do {
+                n = IOUtil.read(fd, dsts, offset, length, position,
+                                direct, alignment, nd);
+            } while ((n == IOStatus.INTERRUPTED) && isOpen());
+            return IOStatus.normalize(n);
+        } finally {
+            threads.remove(ti);
+            endBlocking(n > 0);
+            assert IOStatus.check(n);
+        }
+    }
+
+    /**
+     * Writes a sequence of bytes to this channel from a subsequence of the
+     * given buffers, starting at the given file position. The file position
+     * of the channel is not changed.
+     */
+    public long write(ByteBuffer[] srcs, int offset, int length, long position)
+        throws IOException
+    {
+        if ((offset < 0) || (length < 0) || (offset > srcs.length - length))
+            throw new IndexOutOfBoundsException();
+        if (position < 0)
+            throw new IllegalArgumentException("Negative position");
+        if (!writable)
+            throw new NonWritableChannelException();
+        if (direct)
+            Util.checkChannelPositionAligned(position, alignment);
+        ensureOpen();
+        if (!nd.supportsPositionalVectoredIO()) {
+            long total = 0;
+            for (int i = offset; i < offset + length; i++) {
+                ByteBuffer src = srcs[i];
+                int rem = src.remaining();
+                int n = write(src, position + total);
+                total += n;
+                if (n < rem)
+                    break;
+            }
+            return total;
+        }
+        if (nd.needsPositionLock()) {
+            synchronized (positionLock) {
+                return writeInternal(srcs, offset, length, position);
+            }
+        } else {
+            return writeInternal(srcs, offset, length, position);
+        }
+    }
+
+    private long writeInternal(ByteBuffer[] srcs, int offset, int length,
+                               long position)
+        throws IOException
+    {
+        assert !nd.needsPositionLock() || Thread.holdsLock(positionLock);
+        long n = 0;
+        int ti = -1;
+        try {
+            beginBlocking();
+            ti = threads.add();
+            if (!isOpen())
+                return -1;
+            do {
+                n = IOUtil.write(fd, srcs, offset, length, position,
+                                 direct, alignment, nd);
+            } while ((n == IOStatus.INTERRUPTED) && isOpen());
+            return IOStatus.normalize(n);
+        } finally {
+            threads.remove(ti);
+            endBlocking(n > 0);
+            assert IOStatus.check(n);
+        }
+    }
+
+    /**
+     * Reads into each of the given buffers from the file position in the
+     * corresponding element of {@code positions}. The ranges are submitted
+     * to the operating system in batches rather than one call per buffer.
+     * The file position of the channel is not changed.
+     *
+     * @return the total number of bytes read, which may be less than the
+     *         total remaining in the buffers if ranges extend past the end
+     *         of the file
+     */
+    public long readRanges(ByteBuffer[] dsts, long[] positions)
+        throws IOException
+    {
+        if (dsts.length != positions.length)
+            throw new IllegalArgumentException("Mismatched array lengths");
+        if (!readable)
+            throw new NonReadableChannelException();
+        ensureOpen();
+        if (!nd.supportsPositionalVectoredIO()) {
+            long total = 0;
+            for (int i = 0; i < dsts.length; i++) {
+                int n = read(dsts[i], positions[i]);
+                if (n > 0)
+                    total += n;
+            }
+            return total;
+        }
+        if (nd.needsPositionLock()) {
+            synchronized (positionLock) {
+                return readRangesInternal(dsts, positions);
+            }
+        } else {
+            return readRangesInternal(dsts, positions);
+        }
+    }
+
+    private long readRangesInternal(ByteBuffer[] dsts, long[] positions)
+        throws IOException
+    {
+        assert !nd.needsPositionLock() || Thread.holdsLock(positionLock);
+        long before = 0;
+        for (ByteBuffer dst : dsts)
+            before += dst.remaining();
+        int done = 0;
+        int ti = -1;
+        try {
+            beginBlocking();
+            ti = threads.add();
+            while (done < dsts.length && isOpen()) {
+                int n = IOUtil.readRanges(fd, dsts, positions, done,
+                                          direct, alignment, nd);
+                if (n > 0)
+                    done += n;
+            }
+        } finally {
+            threads.remove(ti);
+            endBlocking(done == dsts.length);
+        }
+        long after = 0;
+        for (ByteBuffer dst : dsts)
+            after += dst.remaining();
+        return before - after;
+    }
+
 
     // -- Memory-mapped buffers --
 
@@ -67,5 +67,30 @@ abstract class FileDispatcher extends NativeDispatcher {
 
     abstract boolean transferToDirectlyNeedsPositionLock();
 
+    /**
+     * Copies up to count bytes from one file to another without copying
+     * through user space. A negative position means that the file's current
+     * position is used and updated. Returns the number of bytes copied or
+     * IOStatus.UNSUPPORTED if the platform has no support for this.
+     */
+    long copyFileRange(FileDescriptor src, long srcPosition,
+                       FileDescriptor dst, long dstPosition, long count)
+        throws IOException
+    {
+        return IOStatus.UNSUPPORTED;
+    }
+
+    /**
+     * Moves up to count bytes from a socket to a file at the given position
+     * without copying through user space. Returns the number of bytes moved
+     * or IOStatus.UNSUPPORTED if the platform has no support for this.
+     */
+    long splice(FileDescriptor src, FileDescriptor dst, long position,
+                long count)
+        throws IOException
+    {
+        return IOStatus.UNSUPPORTED;
+    }
+
     abstract int setDirectIO(FileDescriptor fd, String path);
 }
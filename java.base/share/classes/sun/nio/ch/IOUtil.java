@@ -133,16 +133,51 @@ public class IOUtil {
     static long write(FileDescriptor fd, ByteBuffer[] bufs, int offset, int length,
                       boolean directIO, int alignment, NativeDispatcher nd)
         throws IOException
+    {
+        return write(fd, bufs, offset, length, -1, directIO, alignment, nd);
+    }
+
+    static long write(FileDescriptor fd, ByteBuffer[] bufs, int offset, int length,
+                      long position, boolean directIO, int alignment,
+                      NativeDispatcher nd)
+        throws IOException
     {
         IOVecWrapper vec = IOVecWrapper.get(length);
 
         boolean completed = false;
         int iov_len = 0;
+        ByteBuffer heapShadow = null;
+        boolean shadowRecorded = false;
         try {
-
-            // Iterate over buffers to populate native iovec array.
             int count = offset + length;
+
+            // Size a single shadow buffer for all the heap buffers that
+            // will be in the iovec array, rather than one shadow each.
+            long shadowSize = 0;
             int i = offset;
+            int entries = 0;
+            while (i < count && entries < IOV_MAX) {
+                ByteBuffer buf = bufs[i];
+                int rem = buf.remaining();
+                if (rem > 0) {
+                    if (!(buf instanceof DirectBuffer))
+                        shadowSize += rem;
+                    entries++;
+                }
+                i++;
+            }
+            long shadowAddress = 0;
+            if (shadowSize > 0 && shadowSize <= Integer.MAX_VALUE) {
+                int size = (int)shadowSize;
+                if (directIO)
+                    heapShadow = Util.getTemporaryAlignedDirectBuffer(size, alignment);
+                else
+                    heapShadow = Util.getTemporaryDirectBuffer(size);
+                shadowAddress = ((DirectBuffer)heapShadow).address() + heapShadow.position();
+            }
+
+            // Iterate over buffers to populate native iovec array.
+            i = offset;
             while (i < count && iov_len < IOV_MAX) {
                 ByteBuffer buf = bufs[i];
                 int pos = buf.position();
@@ -155,22 +190,35 @@ public class IOUtil {
                 if (rem > 0) {
                     vec.setBuffer(iov_len, buf, pos, rem);
 
-                    // allocate shadow buffer to ensure I/O is done with direct buffer
-                    if (!(buf instanceof DirectBuffer)) {
-                        ByteBuffer shadow;
+                    long address;
+                    if (buf instanceof DirectBuffer) {
+                        address = ((DirectBuffer)buf).address() + pos;
+                    } else if (heapShadow != null) {
+                        // copy into the shared shadow buffer, which is
+                        // recorded with the first entry that uses it
+                        address = shadowAddress;
+                        heapShadow.put(buf);
+                        shadowAddress += rem;
+                        if (!shadowRecorded) {
+                            vec.setShadow(iov_len, heapShadow);
+                            shadowRecorded = true;
+                        }
+                        buf.position(pos);  // temporarily restore position in user buffer
+                    } else {
+                        // allocate shadow buffer to ensure I/O is done with direct buffer
+                        ByteBuffer bb;
                         if (directIO)
-                            shadow = Util.getTemporaryAlignedDirectBuffer(rem, alignment);
+                            bb = Util.getTemporaryAlignedDirectBuffer(rem, alignment);
                         else
-                            shadow = Util.getTemporaryDirectBuffer(rem);
-                        shadow.put(buf);
-                        shadow.flip();
-                        vec.setShadow(iov_len, shadow);
+                            bb = Util.getTemporaryDirectBuffer(rem);
+                        bb.put(buf);
+                        bb.flip();
+                        vec.setShadow(iov_len, bb);
                         buf.position(pos);  // temporarily restore position in user buffer
-                        buf = shadow;
-                        pos = shadow.position();
+                        address = ((DirectBuffer)bb).address() + bb.position();
                     }
 
-                    vec.putBase(iov_len, ((DirectBuffer)buf).address() + pos);
+                    vec.putBase(iov_len, address);
                     vec.putLen(iov_len, rem);
                     iov_len++;
                 }
@@ -179,7 +227,12 @@ public class IOUtil {
             if (iov_len == 0)
                 return 0L;
 
-            long bytesWritten = nd.writev(fd, vec.address, iov_len);
+            long bytesWritten;
+            if (position != -1) {
+                bytesWritten = nd.pwritev(fd, vec.address, iov_len, position);
+            } else {
+                bytesWritten = nd.writev(fd, vec.address, iov_len);
+            }
 
             // Notify the buffers how many bytes were taken
             long left = bytesWritten;
@@ -212,6 +265,8 @@ public class IOUtil {
                         Util.offerLastTemporaryDirectBuffer(shadow);
                     vec.clearRefs(j);
                 }
+                if (heapShadow != null && !shadowRecorded)
+                    Util.offerLastTemporaryDirectBuffer(heapShadow);
             }
         }
     }
@@ -296,6 +351,14 @@ public class IOUtil {
     static long read(FileDescriptor fd, ByteBuffer[] bufs, int offset, int length,
                      boolean directIO, int alignment, NativeDispatcher nd)
         throws IOException
+    {
+        return read(fd, bufs, offset, length, -1, directIO, alignment, nd);
+    }
+
+    static long read(FileDescriptor fd, ByteBuffer[] bufs, int offset, int length,
+                     long position, boolean directIO, int alignment,
+                     NativeDispatcher nd)
+        throws IOException
     {
         IOVecWrapper vec = IOVecWrapper.get(length);
 
@@ -343,7 +406,12 @@ public class IOUtil {
             if (iov_len == 0)
                 return 0L;
 
-            long bytesRead = nd.readv(fd, vec.address, iov_len);
+            long bytesRead;
+            if (position != -1) {
+                bytesRead = nd.preadv(fd, vec.address, iov_len, position);
+            } else {
+                bytesRead = nd.readv(fd, vec.address, iov_len);
+            }
 
             // Notify the buffers how many bytes were read
             long left = bytesRead;
@@ -384,6 +452,111 @@ public class IOUtil {
         }
     }
 
+    /**
+     * Reads into each of the buffers bufs[offset..] from the file position
+     * in the corresponding element of positions, using a single native call
+     * for up to IOV_MAX buffers. Each buffer's position is advanced by the
+     * number of bytes read for its range; a range at or past the end of
+     * the file reads nothing.
+     *
+     * @return the number of buffers done, or IOStatus.INTERRUPTED
+     */
+    static int readRanges(FileDescriptor fd, ByteBuffer[] bufs, long[] positions,
+                          int offset, boolean directIO, int alignment,
+                          NativeDispatcher nd)
+        throws IOException
+    {
+        int length = Math.min(bufs.length - offset, IOV_MAX);
+        IOVecWrapper vec = IOVecWrapper.get(length);
+        long[] rangePositions = new long[length];
+        int[] bufferIndex = new int[length];
+        int[] counts = new int[length];
+
+        boolean completed = false;
+        int iov_len = 0;
+        try {
+            // Empty buffers need no I/O, so the batch skips over them
+            int i = 0;
+            while (i < length) {
+                ByteBuffer buf = bufs[offset + i];
+                if (buf.isReadOnly())
+                    throw new IllegalArgumentException("Read-only buffer");
+                long position = positions[offset + i];
+                if (position < 0)
+                    throw new IllegalArgumentException("Negative position");
+                int pos = buf.position();
+                int lim = buf.limit();
+                assert (pos <= lim);
+                int rem = (pos <= lim ? lim - pos : 0);
+
+                if (directIO) {
+                    Util.checkChannelPositionAligned(position, alignment);
+                    Util.checkRemainingBufferSizeAligned(rem, alignment);
+                }
+
+                if (rem > 0) {
+                    vec.setBuffer(iov_len, buf, pos, rem);
+                    if (!(buf instanceof DirectBuffer)) {
+                        ByteBuffer shadow;
+                        if (directIO) {
+                            shadow = Util.getTemporaryAlignedDirectBuffer(rem, alignment);
+                        } else {
+                            shadow = Util.getTemporaryDirectBuffer(rem);
+                        }
+                        vec.setShadow(iov_len, shadow);
+                        buf = shadow;
+                        pos = shadow.position();
+                    }
+                    vec.putBase(iov_len, ((DirectBuffer)buf).address() + pos);
+                    vec.putLen(iov_len, rem);
+                    rangePositions[iov_len] = position;
+                    bufferIndex[iov_len] = i;
+                    iov_len++;
+                }
+                i++;
+            }
+            if (iov_len == 0)
+                return length;
+
+            int done = nd.preadRanges(fd, vec.address, rangePositions,
+                                      counts, iov_len);
+            if (done < 0)
+                return done;
+
+            // Notify the buffers how many bytes were read
+            for (int j=0; j<iov_len; j++) {
+                ByteBuffer shadow = vec.getShadow(j);
+                if (j < done && counts[j] > 0) {
+                    ByteBuffer buf = vec.getBuffer(j);
+                    int n = counts[j];
+                    if (shadow == null) {
+                        buf.position(vec.getPosition(j) + n);
+                    } else {
+                        shadow.limit(shadow.position() + n);
+                        buf.put(shadow);
+                    }
+                }
+                if (shadow != null)
+                    Util.offerLastTemporaryDirectBuffer(shadow);
+                vec.clearRefs(j);
+            }
+            completed = true;
+
+            // buffers before the first entry not done are all done
+            return (done == iov_len) ? length : bufferIndex[done];
+
+        } finally {
+            if (!completed) {
+                for (int j=0; j<iov_len; j++) {
+                    ByteBuffer shadow = vec.getShadow(j);
+                    if (shadow != null)
+                        Util.offerLastTemporaryDirectBuffer(shadow);
+                    vec.clearRefs(j);
+                }
+            }
+        }
+    }
+
     public static FileDescriptor newFD(int i) {
         FileDescriptor fd = new FileDescriptor();
         setfdVal(fd, i);
@@ -55,6 +55,31 @@ abstract class NativeDispatcher
     abstract long readv(FileDescriptor fd, long address, int len)
         throws IOException;
 
+    /**
+     * Returns {@code true} if preadv/pwritev/preadRanges are implemented.
+     */
+    boolean supportsPositionalVectoredIO() {
+        return false;
+    }
+
+    long preadv(FileDescriptor fd, long address, int len, long position)
+        throws IOException
+    {
+        throw new IOException("Operation Unsupported");
+    }
+
+    /**
+     * Reads each of the len iovec entries at address from the file position
+     * in the corresponding element of positions, storing the number of
+     * bytes read into counts. Returns the number of entries done.
+     */
+    int preadRanges(FileDescriptor fd, long address, long[] positions,
+                    int[] counts, int len)
+        throws IOException
+    {
+        throw new IOException("Operation Unsupported");
+    }
+
     abstract int write(FileDescriptor fd, long address, int len)
         throws IOException;
 
@@ -67,6 +92,12 @@ abstract class NativeDispatcher
     abstract long writev(FileDescriptor fd, long address, int len)
         throws IOException;
 
+    long pwritev(FileDescriptor fd, long address, int len, long position)
+        throws IOException
+    {
+        throw new IOException("Operation Unsupported");
+    }
+
     abstract void close(FileDescriptor fd) throws IOException;
 
     // Prepare the given fd for closing by duping it to a known internal fd
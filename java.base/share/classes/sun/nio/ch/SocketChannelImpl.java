@@ -385,6 +385,51 @@ class SocketChannelImpl
         }
     }
 
+    /**
+     * Moves up to count bytes read from this channel to the given file at
+     * the given position without copying through user space. Returns the
+     * number of bytes moved, IOStatus.EOF at end of stream,
+     * IOStatus.UNAVAILABLE if no bytes are available in non-blocking mode,
+     * or IOStatus.UNSUPPORTED/UNSUPPORTED_CASE if the bytes cannot be moved
+     * this way.
+     */
+    long transferTo(FileDispatcher fnd, FileDescriptor targetFD,
+                    long position, long count)
+        throws IOException
+    {
+        readLock.lock();
+        try {
+            boolean blocking = isBlocking();
+            long n = 0;
+            try {
+                beginRead(blocking);
+
+                // check if connection has been reset
+                if (connectionReset)
+                    throwConnectionReset();
+
+                // check if input is shutdown
+                if (isInputClosed)
+                    return IOStatus.EOF;
+
+                n = fnd.splice(fd, targetFD, position, count);
+                if (blocking) {
+                    while (IOStatus.okayToRetry(n) && isOpen()) {
+                        park(Net.POLLIN);
+                        n = fnd.splice(fd, targetFD, position, count);
+                    }
+                }
+            } finally {
+                endRead(blocking, n > 0);
+                if (n <= 0 && isInputClosed)
+                    return IOStatus.EOF;
+            }
+            return n;
+        } finally {
+            readLock.unlock();
+        }
+    }
+
     @Override
     public long read(ByteBuffer[] dsts, int offset, int length)
         throws IOException
@@ -39,6 +39,7 @@ import java.util.Set;
 
 import jdk.internal.misc.TerminatingThreadLocal;
 import jdk.internal.misc.Unsafe;
+import jdk.internal.ref.Cleaner;
 import sun.security.action.GetPropertyAction;
 
 public class Util {
@@ -260,6 +261,10 @@ public class Util {
             if (buf.alignmentOffset(0, alignment) == 0) {
                 return buf;
             }
+            // The buffer is large enough but not suitably aligned. It has
+            // already been removed from the cache so free it now rather
+            // than leaving the native memory to be reclaimed by the GC.
+            free(buf);
         } else {
             if (!cache.isEmpty()) {
                 buf = cache.removeFirst();
@@ -324,7 +329,15 @@ public class Util {
      * Frees the memory for the given direct buffer
      */
     private static void free(ByteBuffer buf) {
-        ((DirectBuffer)buf).cleaner().clean();
+        DirectBuffer db = (DirectBuffer)buf;
+        Cleaner cleaner = db.cleaner();
+        if (cleaner == null && db.attachment() instanceof DirectBuffer) {
+            // aligned temporary buffers are slices of a larger buffer
+            cleaner = ((DirectBuffer)db.attachment()).cleaner();
+        }
+        if (cleaner != null) {
+            cleaner.clean();
+        }
     }
 
 
@@ -96,32 +96,9 @@ Java_java_lang_StrictMath_IEEEremainder(JNIEnv *env, jclass unused,
     return (jdouble) jremainder(dividend, divisor);
 }
 
-JNIEXPORT jdouble JNICALL
-Java_java_lang_StrictMath_cosh(JNIEnv *env, jclass unused, jdouble d)
-{
-    return (jdouble) jcosh((double)d);
-}
-
-JNIEXPORT jdouble JNICALL
-Java_java_lang_StrictMath_sinh(JNIEnv *env, jclass unused, jdouble d)
-{
-    return (jdouble) jsinh((double)d);
-}
-
-JNIEXPORT jdouble JNICALL
-Java_java_lang_StrictMath_tanh(JNIEnv *env, jclass unused, jdouble d)
-{
-    return (jdouble) jtanh((double)d);
-}
-
 JNIEXPORT jdouble JNICALL
 Java_java_lang_StrictMath_log1p(JNIEnv *env, jclass unused, jdouble d)
 {
     return (jdouble) jlog1p((double)d);
 }
 
-JNIEXPORT jdouble JNICALL
-Java_java_lang_StrictMath_expm1(JNIEnv *env, jclass unused, jdouble d)
-{
-    return (jdouble) jexpm1((double)d);
-}
@@ -754,24 +754,120 @@ newStringJava(JNIEnv *env, const char *str)
     return newSizedStringJava(env, str, len);
 }
 
+/* Returns the length of the leading run of ASCII bytes in str[0..len),
+ * testing a machine word at a time.
+ */
+static int
+asciiPrefixLength(const char *str, int len)
+{
+    const size_t highBits = (size_t)-1 / 0xff * 0x80;
+    int i = 0;
+    while (i + (int)sizeof(size_t) <= len) {
+        size_t word;
+        memcpy(&word, str + i, sizeof(size_t));
+        if ((word & highBits) != 0) {
+            break;
+        }
+        i += (int)sizeof(size_t);
+    }
+    while (i < len && (signed char)str[i] >= 0) {
+        i++;
+    }
+    return i;
+}
+
+/* Decodes well-formed UTF-8 in str[0..len) into dst, which must have room
+ * for len chars. Returns the number of chars written, or -1 if the input is
+ * malformed, in which case the caller defers to the Java decoder so that
+ * replacement behaviour is unchanged.
+ */
+static int
+decodeUTF8(const unsigned char *str, int len, jchar *dst)
+{
+    int i = 0, n = 0;
+    while (i < len) {
+        unsigned int c = str[i];
+        if (c < 0x80) {
+            dst[n++] = (jchar)c;
+            i++;
+        } else if (c >= 0xc2 && c < 0xe0) {
+            if (i + 1 >= len || (str[i + 1] & 0xc0) != 0x80)
+                return -1;
+            dst[n++] = (jchar)(((c & 0x1f) << 6) | (str[i + 1] & 0x3f));
+            i += 2;
+        } else if (c >= 0xe0 && c < 0xf0) {
+            unsigned int cp;
+            if (i + 2 >= len ||
+                (str[i + 1] & 0xc0) != 0x80 || (str[i + 2] & 0xc0) != 0x80)
+                return -1;
+            cp = ((c & 0x0f) << 12) | ((str[i + 1] & 0x3f) << 6) |
+                 (str[i + 2] & 0x3f);
+            if (cp < 0x800 || (cp >= 0xd800 && cp < 0xe000))
+                return -1;
+            dst[n++] = (jchar)cp;
+            i += 3;
+        } else if (c >= 0xf0 && c < 0xf5) {
+            unsigned int cp;
+            if (i + 3 >= len ||
+                (str[i + 1] & 0xc0) != 0x80 || (str[i + 2] & 0xc0) != 0x80 ||
+                (str[i + 3] & 0xc0) != 0x80)
+                return -1;
+            cp = ((c & 0x07) << 18) | ((str[i + 1] & 0x3f) << 12) |
+                 ((str[i + 2] & 0x3f) << 6) | (str[i + 3] & 0x3f);
+            if (cp < 0x10000 || cp > 0x10ffff)
+                return -1;
+            cp -= 0x10000;
+            dst[n++] = (jchar)(0xd800 + (cp >> 10));
+            dst[n++] = (jchar)(0xdc00 + (cp & 0x3ff));
+            i += 4;
+        } else {
+            return -1;
+        }
+    }
+    return n;
+}
+
 /* Optimized for charset UTF-8 */
 static jstring
 newStringUTF8(JNIEnv *env, const char *str)
 {
-    int len;
-    const unsigned char *p;
-    unsigned char asciiCheck;
-    for (asciiCheck = 0, p = (const unsigned char*)str; *p != '\0'; p++) {
-        asciiCheck |= *p;
-    }
-    len = (int)((const char*)p - str);
+    jchar buf[512];
+    jchar *str1;
+    jstring result;
+    int len = (int)strlen(str);
+    int prefix = asciiPrefixLength(str, len);
+    int n;
 
-    if (asciiCheck < 0x80) {
+    if (prefix == len) {
         // ascii fast-path
         return newSizedString8859_1(env, str, len);
     }
 
-    return newSizedStringJava(env, str, len);
+    if ((*env)->EnsureLocalCapacity(env, 1) < 0)
+        return NULL;
+
+    // a UTF-8 sequence never decodes to more chars than it has bytes
+    if (len > 512) {
+        str1 = (jchar *)malloc(len * sizeof(jchar));
+        if (str1 == 0) {
+            JNU_ThrowOutOfMemoryError(env, 0);
+            return 0;
+        }
+    } else
+        str1 = buf;
+
+    for (n = 0; n < prefix; n++)
+        str1[n] = (unsigned char)str[n];
+    n = decodeUTF8((const unsigned char *)str + prefix, len - prefix,
+                   str1 + prefix);
+    if (n >= 0) {
+        result = (*env)->NewString(env, str1, prefix + n);
+    } else {
+        result = newSizedStringJava(env, str, len);
+    }
+    if (str1 != buf)
+        free(str1);
+    return result;
 }
 
 /* Initialize the fast encoding from the encoding name.
@@ -939,7 +1035,7 @@ getStringUTF8(JNIEnv *env, jstring jstr)
 
     rlen = len;
     // we need two bytes for each latin-1 char above 127 (negative jbytes)
-    for (i = 0; i < len; i++) {
+    for (i = asciiPrefixLength((const char *)str, len); i < len; i++) {
         if (str[i] < 0) {
             rlen++;
         }
@@ -952,6 +1048,14 @@ getStringUTF8(JNIEnv *env, jstring jstr)
         return NULL;
     }
 
+    if (rlen == len) {
+        // all ascii, copy verbatim
+        memcpy(result, str, len);
+        (*env)->ReleasePrimitiveArrayCritical(env, value, str, 0);
+        result[len] = '\0';
+        return result;
+    }
+
     for (ri = 0, i = 0; i < len; i++) {
         jbyte c = str[i];
         if (c < 0) {
@@ -257,6 +257,134 @@ bool ImageFileReaderTable::contains(ImageFileReader* image) {
     return false;
 }
 
+// Process-wide cache of decompressed resources.
+ImageResourceCache::Entry* ImageResourceCache::_buckets[ImageResourceCache::BUCKET_COUNT];
+ImageResourceCache::Entry* ImageResourceCache::_most_recent = NULL;
+ImageResourceCache::Entry* ImageResourceCache::_least_recent = NULL;
+u8 ImageResourceCache::_capacity = 0;
+u8 ImageResourceCache::_used = 0;
+
+SimpleCriticalSection _resource_cache_lock;
+
+u4 ImageResourceCache::bucket(const ImageFileReader* reader, u4 offset) {
+    u8 key = (u8)reader ^ offset;
+    return (u4)((key ^ (key >> 16)) % BUCKET_COUNT);
+}
+
+// Must be called with the lock held.
+ImageResourceCache::Entry* ImageResourceCache::lookup(const ImageFileReader* reader, u4 offset) {
+    for (Entry* entry = _buckets[bucket(reader, offset)]; entry != NULL; entry = entry->_hash_next) {
+        if (entry->_reader == reader && entry->_offset == offset) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+// Remove entry from the recently used list.
+void ImageResourceCache::unlink(Entry* entry) {
+    if (entry->_prev != NULL) {
+        entry->_prev->_next = entry->_next;
+    } else {
+        _most_recent = entry->_next;
+    }
+    if (entry->_next != NULL) {
+        entry->_next->_prev = entry->_prev;
+    } else {
+        _least_recent = entry->_prev;
+    }
+}
+
+// Add entry as the most recently used.
+void ImageResourceCache::link_first(Entry* entry) {
+    entry->_prev = NULL;
+    entry->_next = _most_recent;
+    if (_most_recent != NULL) {
+        _most_recent->_prev = entry;
+    } else {
+        _least_recent = entry;
+    }
+    _most_recent = entry;
+}
+
+// Unlink and free entry.
+void ImageResourceCache::remove(Entry* entry) {
+    unlink(entry);
+    Entry** link = &_buckets[bucket(entry->_reader, entry->_offset)];
+    while (*link != entry) {
+        link = &(*link)->_hash_next;
+    }
+    *link = entry->_hash_next;
+    _used -= entry->_size;
+    delete[] entry->_data;
+    delete entry;
+}
+
+// Drop the least recently used resources until at most capacity bytes are used.
+void ImageResourceCache::evict_to(u8 capacity) {
+    while (_used > capacity) {
+        assert(_least_recent != NULL && "used bytes without entries");
+        remove(_least_recent);
+    }
+}
+
+void ImageResourceCache::set_capacity(u8 capacity) {
+    SimpleCriticalSectionLock cs(&_resource_cache_lock);
+    _capacity = capacity;
+    evict_to(capacity);
+}
+
+bool ImageResourceCache::get(const ImageFileReader* reader, u4 offset, u1* data, u8 size) {
+    SimpleCriticalSectionLock cs(&_resource_cache_lock);
+    Entry* entry = lookup(reader, offset);
+    if (entry == NULL) {
+        return false;
+    }
+    assert(entry->_size == size && "cached resource size mismatch");
+    unlink(entry);
+    link_first(entry);
+    memcpy(data, entry->_data, (size_t)size);
+    return true;
+}
+
+bool ImageResourceCache::contains(const ImageFileReader* reader, u4 offset) {
+    SimpleCriticalSectionLock cs(&_resource_cache_lock);
+    return lookup(reader, offset) != NULL;
+}
+
+void ImageResourceCache::put(const ImageFileReader* reader, u4 offset, u1* data, u8 size) {
+    SimpleCriticalSectionLock cs(&_resource_cache_lock);
+    // Too large to keep, or decompressed by another thread meanwhile.
+    if (size > _capacity || lookup(reader, offset) != NULL) {
+        delete[] data;
+        return;
+    }
+    evict_to(_capacity - size);
+    Entry* entry = new Entry();
+    assert(entry != NULL && "allocation failed");
+    entry->_reader = reader;
+    entry->_offset = offset;
+    entry->_size = size;
+    entry->_data = data;
+    u4 index = bucket(reader, offset);
+    entry->_hash_next = _buckets[index];
+    _buckets[index] = entry;
+    link_first(entry);
+    _used += size;
+}
+
+void ImageResourceCache::remove_all(const ImageFileReader* reader) {
+    SimpleCriticalSectionLock cs(&_resource_cache_lock);
+    Entry* entry = _most_recent;
+    while (entry != NULL) {
+        Entry* next = entry->_next;
+        if (entry->_reader == reader) {
+            remove(entry);
+        }
+        entry = next;
+    }
+}
+
 // Table to manage multiple opens of an image file.
 ImageFileReaderTable ImageFileReader::_reader_table;
 
@@ -426,6 +554,8 @@ bool ImageFileReader::open() {
 
 // Close image file.
 void ImageFileReader::close() {
+    // Drop decompressed resources, their offsets are only valid for this file.
+    ImageResourceCache::remove_all(this);
     // Deallocate the index.
     if (_index_data) {
         osSupport::unmap_memory((char*)_index_data, (size_t)map_size());
@@ -481,6 +611,17 @@ u4 ImageFileReader::find_location_index(const char* path, u8 *size) const {
     return 0;            // not found
 }
 
+// Touch every page of the index.
+void ImageFileReader::prefault_index() const {
+    // Smallest page size of the supported platforms.
+    const size_t page_size = 4 * 1024;
+    volatile u1 sum = 0;
+    for (size_t offset = 0; offset < _index_size; offset += page_size) {
+        sum += _index_data[offset];
+    }
+    sum += _index_data[_index_size - 1];
+}
+
 // Verify that a found location matches the supplied path (without copying.)
 bool ImageFileReader::verify_location(ImageLocation& location, const char* path) const {
     // Manage the image string table.
@@ -526,10 +667,39 @@ void ImageFileReader::get_resource(u4 offset, u1* uncompressed_data) const {
         u1* data = get_location_offset_data(offset);
         // Expand location attributes.
         ImageLocation location(data);
+        // Compressed resources may already have been decompressed.
+        if (location.get_attribute(ImageLocation::ATTRIBUTE_COMPRESSED) != 0 &&
+            ImageResourceCache::is_enabled()) {
+            u8 uncompressed_size = location.get_attribute(ImageLocation::ATTRIBUTE_UNCOMPRESSED);
+            if (ImageResourceCache::get(this, offset, uncompressed_data, uncompressed_size)) {
+                return;
+            }
+            get_resource(location, uncompressed_data);
+            u1* copy = new u1[(size_t)uncompressed_size];
+            assert(copy != NULL && "allocation failed");
+            memcpy(copy, uncompressed_data, (size_t)uncompressed_size);
+            ImageResourceCache::put(this, offset, copy, uncompressed_size);
+            return;
+        }
         // Read the data
         get_resource(location, uncompressed_data);
 }
 
+// Decompress the resource for the supplied location offset into the cache.
+void ImageFileReader::prefetch_resource(u4 offset) const {
+    ImageLocation location(get_location_offset_data(offset));
+    if (location.get_attribute(ImageLocation::ATTRIBUTE_COMPRESSED) == 0 ||
+        !ImageResourceCache::is_enabled() ||
+        ImageResourceCache::contains(this, offset)) {
+        return;
+    }
+    u8 uncompressed_size = location.get_attribute(ImageLocation::ATTRIBUTE_UNCOMPRESSED);
+    u1* uncompressed_data = new u1[(size_t)uncompressed_size];
+    assert(uncompressed_data != NULL && "allocation failed");
+    get_resource(location, uncompressed_data);
+    ImageResourceCache::put(this, offset, uncompressed_data, uncompressed_size);
+}
+
 // Return the resource for the supplied location.
 void ImageFileReader::get_resource(ImageLocation& location, u1* uncompressed_data) const {
     // Retrieve the byte offset and size of the resource.
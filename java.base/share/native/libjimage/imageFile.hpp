@@ -389,6 +389,61 @@ public:
     bool contains(ImageFileReader* image);
 };
 
+// Process-wide LRU cache of decompressed resources, shared by all image
+// readers. Inflating a resource of an image built with compression is much
+// more expensive than copying it, so recently used resources, and resources
+// decompressed ahead of time (see ImageFileReader::prefetch_resource), are
+// kept up to a total number of bytes. The cache is disabled until a capacity
+// is set with JIMAGE_SetResourceCacheSize.
+class ImageResourceCache {
+private:
+    struct Entry {
+        const ImageFileReader* _reader; // Image of the resource
+        u4 _offset;                     // Location offset of the resource
+        u8 _size;                       // Uncompressed size
+        u1* _data;                      // Uncompressed bytes
+        Entry* _prev;                   // More recently used
+        Entry* _next;                   // Less recently used
+        Entry* _hash_next;              // Next in bucket
+    };
+
+    enum { BUCKET_COUNT = 1024 };
+
+    static Entry* _buckets[BUCKET_COUNT];
+    static Entry* _most_recent;
+    static Entry* _least_recent;
+    static u8 _capacity;
+    static u8 _used;
+
+    static u4 bucket(const ImageFileReader* reader, u4 offset);
+    static Entry* lookup(const ImageFileReader* reader, u4 offset);
+    static void unlink(Entry* entry);
+    static void link_first(Entry* entry);
+    static void remove(Entry* entry);
+    static void evict_to(u8 capacity);
+
+public:
+    // Set the maximum number of bytes kept. Zero disables the cache.
+    static void set_capacity(u8 capacity);
+
+    static inline bool is_enabled() {
+        return _capacity != 0;
+    }
+
+    // Copy the cached resource into data. Returns false if not cached.
+    static bool get(const ImageFileReader* reader, u4 offset, u1* data, u8 size);
+
+    // Determine if the resource is cached.
+    static bool contains(const ImageFileReader* reader, u4 offset);
+
+    // Add a resource. The cache takes ownership of data, which must have
+    // been allocated with new[].
+    static void put(const ImageFileReader* reader, u4 offset, u1* data, u8 size);
+
+    // Drop all resources of a closed reader.
+    static void remove_all(const ImageFileReader* reader);
+};
+
 // Manage the image file.
 // ImageFileReader manages the content of an image file.
 // Initially, the header of the image file is read for validation.  If valid,
@@ -564,6 +619,10 @@ public:
     // ImageFileReader::NOT_FOUND otherwise.
     u4 find_location_index(const char* path, u8 *size) const;
 
+    // Touch every page of the index (redirect, offsets, location and string
+    // tables), so that later lookups do not fault pages in one at a time.
+    void prefault_index() const;
+
     // Verify that a found location matches the supplied path.
     bool verify_location(ImageLocation& location, const char* path) const;
 
@@ -573,6 +632,12 @@ public:
     // Return the resource for the supplied path.
     void get_resource(ImageLocation& location, u1* uncompressed_data) const;
 
+    // Decompress the resource for the supplied location offset into the
+    // ImageResourceCache, so that a later get_resource only copies it.
+    // Does nothing if the resource is not compressed or the cache is
+    // disabled.
+    void prefetch_resource(u4 offset) const;
+
     // Return the ImageModuleData for this image
     ImageModuleData * get_image_module_data();
 
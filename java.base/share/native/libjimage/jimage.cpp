@@ -140,6 +140,96 @@ JIMAGE_FindResource(JImageFile* image,
     return loc;
 }
 
+/*
+ * JImageFindResources - Batched form of JImageFindResource for names in the
+ * same module. For each of the count names, stores the location, or
+ * JIMAGE_NOT_FOUND, in locations and the size of found resources in sizes.
+ * Returns the number of resources found. All strings are utf-8, zero byte
+ * terminated.
+ *
+ *  Ex.
+ *   const char* names[] = { "java/lang/String.class", "java/lang/Object.class" };
+ *   JImageLocationRef locations[2];
+ *   jlong sizes[2];
+ *   jint found = (*JImageFindResources)(image, "java.base", "9.0", names, 2,
+ *                                       locations, sizes);
+ */
+extern "C" JNIEXPORT jint
+JIMAGE_FindResources(JImageFile* image,
+        const char* module_name, const char* version, const char** names,
+        jint count, JImageLocationRef* locations, jlong* sizes) {
+    ImageFileReader* reader = (ImageFileReader*) image;
+    // The "/module/" prefix is shared by all names.
+    char fullpath[IMAGE_MAX_PATH];
+    size_t moduleNameLen = strlen(module_name);
+    if (1 + moduleNameLen + 1 + 1 > IMAGE_MAX_PATH) {
+        for (jint i = 0; i < count; i++) {
+            locations[i] = 0L;
+        }
+        return 0;
+    }
+    size_t prefixLen = 0;
+    fullpath[prefixLen++] = '/';
+    memcpy(&fullpath[prefixLen], module_name, moduleNameLen);
+    prefixLen += moduleNameLen;
+    fullpath[prefixLen++] = '/';
+
+    jint found = 0;
+    for (jint i = 0; i < count; i++) {
+        size_t nameLen = strlen(names[i]);
+        assert(nameLen > 0 && "name must non-empty");
+        locations[i] = 0L;
+        if (prefixLen + nameLen + 1 > IMAGE_MAX_PATH) {
+            continue;
+        }
+        memcpy(&fullpath[prefixLen], names[i], nameLen + 1);
+        locations[i] = (JImageLocationRef) reader->find_location_index(fullpath, (u8*) &sizes[i]);
+        if (locations[i] != 0L) {
+            found++;
+        }
+    }
+    return found;
+}
+
+/*
+ * JImagePrefaultIndex - Given an open image file (see JImageOpen), read in
+ * the whole resource index ahead of time. Worthwhile when many resources
+ * are looked up right away, e.g. during startup.
+ *
+ *  Ex.
+ *   (*JImagePrefaultIndex)(image);
+ */
+extern "C" JNIEXPORT void
+JIMAGE_PrefaultIndex(JImageFile* image) {
+    ((ImageFileReader*) image)->prefault_index();
+}
+
+/*
+ * JImageSetResourceCacheSize - Set the number of bytes of decompressed
+ * resources kept in memory, shared by all open image files. Zero, the
+ * default, disables the cache.
+ *
+ *  Ex.
+ *   (*JImageSetResourceCacheSize)(16 * 1024 * 1024);
+ */
+extern "C" JNIEXPORT void
+JIMAGE_SetResourceCacheSize(jlong size) {
+    ImageResourceCache::set_capacity(size > 0 ? (u8) size : 0);
+}
+
+/*
+ * JImagePrefetchResource - Given an open image file (see JImageOpen) and a
+ * resource's location information (see JImageFindResource), decompress the
+ * resource into the resource cache ahead of a later JImageGetResource.
+ *
+ *  Ex.
+ *   (*JImagePrefetchResource)(image, location);
+ */
+extern "C" JNIEXPORT void
+JIMAGE_PrefetchResource(JImageFile* image, JImageLocationRef location) {
+    ((ImageFileReader*) image)->prefetch_resource((u4) location);
+}
+
 /*
  * JImageGetResource - Given an open image file (see JImageOpen), a resource's
  * location information (see JImageFindResource), a buffer of appropriate
@@ -135,6 +135,71 @@ typedef JImageLocationRef(*JImageFindResource_t)(JImageFile* jimage,
         jlong* size);
 
 
+/*
+ * JImageFindResources - Batched form of JImageFindResource for names in the
+ * same module. For each of the count names, stores the location, or
+ * JIMAGE_NOT_FOUND, in locations and the size of found resources in sizes.
+ * Returns the number of resources found. All strings are utf-8, zero byte
+ * terminated.
+ *
+ *  Ex.
+ *   const char* names[] = { "java/lang/String.class", "java/lang/Object.class" };
+ *   JImageLocationRef locations[2];
+ *   jlong sizes[2];
+ *   jint found = (*JImageFindResources)(image, "java.base", "9.0", names, 2,
+ *                                       locations, sizes);
+ */
+extern "C" JNIEXPORT jint JIMAGE_FindResources(JImageFile* jimage,
+        const char* module_name, const char* version, const char** names,
+        jint count, JImageLocationRef* locations, jlong* sizes);
+
+typedef jint(*JImageFindResources_t)(JImageFile* jimage,
+        const char* module_name, const char* version, const char** names,
+        jint count, JImageLocationRef* locations, jlong* sizes);
+
+/*
+ * JImagePrefaultIndex - Given an open image file (see JImageOpen), read in
+ * the whole resource index ahead of time. Worthwhile when many resources
+ * are looked up right away, e.g. during startup.
+ *
+ *  Ex.
+ *   (*JImagePrefaultIndex)(image);
+ */
+extern "C" JNIEXPORT void JIMAGE_PrefaultIndex(JImageFile* jimage);
+
+typedef void(*JImagePrefaultIndex_t)(JImageFile* jimage);
+
+/*
+ * JImageSetResourceCacheSize - Set the number of bytes of decompressed
+ * resources kept in memory, shared by all open image files. Getting a
+ * compressed resource that is cached only copies it. Zero, the default,
+ * disables the cache.
+ *
+ *  Ex.
+ *   (*JImageSetResourceCacheSize)(16 * 1024 * 1024);
+ */
+extern "C" JNIEXPORT void JIMAGE_SetResourceCacheSize(jlong size);
+
+typedef void(*JImageSetResourceCacheSize_t)(jlong size);
+
+/*
+ * JImagePrefetchResource - Given an open image file (see JImageOpen) and a
+ * resource's location information (see JImageFindResource), decompress the
+ * resource into the resource cache (see JImageSetResourceCacheSize) ahead of
+ * a later JImageGetResource. Does nothing if the resource is not compressed
+ * or the cache is disabled.
+ *
+ *  Ex.
+ *   jlong size;
+ *   JImageLocationRef location = (*JImageFindResource)(image,
+ *                                 "java.base", "9.0", "java/lang/String.class", &size);
+ *   (*JImagePrefetchResource)(image, location);
+ */
+extern "C" JNIEXPORT void JIMAGE_PrefetchResource(JImageFile* jimage, JImageLocationRef location);
+
+typedef void(*JImagePrefetchResource_t)(JImageFile* jimage, JImageLocationRef location);
+
+
 /*
  * JImageGetResource - Given an open image file (see JImageOpen), a resource's
  * location information (see JImageFindResource), a buffer of appropriate
@@ -32,7 +32,7 @@
 #include "jlong.h"
 #include "jni.h"
 #include "jni_util.h"
-#include <zlib.h>
+#include "zlib_backend.h"
 
 #include "java_util_zip_Deflater.h"
 
@@ -49,9 +49,9 @@ Java_java_util_zip_Deflater_init(JNIEnv *env, jclass cls, jint level,
         return jlong_zero;
     } else {
         const char *msg;
-        int ret = deflateInit2(strm, level, Z_DEFLATED,
-                               nowrap ? -MAX_WBITS : MAX_WBITS,
-                               DEF_MEM_LEVEL, strategy);
+        int ret = ZLIB_deflateInit2(strm, level, Z_DEFLATED,
+                                    nowrap ? -MAX_WBITS : MAX_WBITS,
+                                    DEF_MEM_LEVEL, strategy);
         switch (ret) {
           case Z_OK:
             return ptr_to_jlong(strm);
@@ -98,7 +98,7 @@ Java_java_util_zip_Deflater_setDictionary(JNIEnv *env, jclass cls, jlong addr,
     Bytef *buf = (*env)->GetPrimitiveArrayCritical(env, b, 0);
     if (buf == NULL) /* out of memory */
         return;
-    res = deflateSetDictionary(jlong_to_ptr(addr), buf, len);
+    res = ZLIB->deflateSetDictionary(jlong_to_ptr(addr), buf, len);
     (*env)->ReleasePrimitiveArrayCritical(env, b, buf, 0);
     checkSetDictionaryResult(env, addr, res);
 }
@@ -109,7 +109,7 @@ Java_java_util_zip_Deflater_setDictionaryBuffer(JNIEnv *env, jclass cls, jlong a
 {
     int res;
     Bytef *buf = jlong_to_ptr(bufferAddr);
-    res = deflateSetDictionary(jlong_to_ptr(addr), buf, len);
+    res = ZLIB->deflateSetDictionary(jlong_to_ptr(addr), buf, len);
     checkSetDictionaryResult(env, addr, res);
 }
 
@@ -130,9 +130,9 @@ static jint doDeflate(JNIEnv *env, jlong addr,
     if (setParams) {
         int strategy = (params >> 1) & 3;
         int level = params >> 3;
-        res = deflateParams(strm, level, strategy);
+        res = ZLIB->deflateParams(strm, level, strategy);
     } else {
-        res = deflate(strm, flush);
+        res = ZLIB->deflate(strm, flush);
     }
     return res;
 }
@@ -288,7 +288,7 @@ Java_java_util_zip_Deflater_getAdler(JNIEnv *env, jclass cls, jlong addr)
 JNIEXPORT void JNICALL
 Java_java_util_zip_Deflater_reset(JNIEnv *env, jclass cls, jlong addr)
 {
-    if (deflateReset((z_stream *)jlong_to_ptr(addr)) != Z_OK) {
+    if (ZLIB->deflateReset((z_stream *)jlong_to_ptr(addr)) != Z_OK) {
         JNU_ThrowInternalError(env, 0);
     }
 }
@@ -296,7 +296,7 @@ Java_java_util_zip_Deflater_reset(JNIEnv *env, jclass cls, jlong addr)
 JNIEXPORT void JNICALL
 Java_java_util_zip_Deflater_end(JNIEnv *env, jclass cls, jlong addr)
 {
-    if (deflateEnd((z_stream *)jlong_to_ptr(addr)) == Z_STREAM_ERROR) {
+    if (ZLIB->deflateEnd((z_stream *)jlong_to_ptr(addr)) == Z_STREAM_ERROR) {
         JNU_ThrowInternalError(env, 0);
     } else {
         free((z_stream *)jlong_to_ptr(addr));
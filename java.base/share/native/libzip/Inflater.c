@@ -36,7 +36,7 @@
 #include "jni.h"
 #include "jvm.h"
 #include "jni_util.h"
-#include <zlib.h>
+#include "zlib_backend.h"
 #include "java_util_zip_Inflater.h"
 
 #define ThrowDataFormatException(env, msg) \
@@ -45,6 +45,59 @@
 static jfieldID inputConsumedID;
 static jfieldID outputConsumedID;
 
+/*
+ * Ended streams are kept on a per-mode free list, already reset, so that a
+ * subsequent init can reuse both the z_stream and the inflate state and
+ * window that zlib allocated for it. The z_stream must be the first member
+ * as the Java side only ever sees it as a z_stream pointer.
+ */
+typedef struct pooled_stream {
+    z_stream strm;
+    jboolean nowrap;
+    struct pooled_stream *next;
+} pooled_stream;
+
+#define MAX_POOLED_STREAMS 16
+
+static void *pool_lock = 0;
+static pooled_stream *pool[2];      /* indexed by nowrap */
+static int pool_size[2];
+
+static pooled_stream *
+poolTake(jboolean nowrap)
+{
+    pooled_stream *ps = NULL;
+    int i = nowrap ? 1 : 0;
+    if (pool_lock == 0)
+        return NULL;
+    JVM_RawMonitorEnter(pool_lock);
+    if (pool[i] != NULL) {
+        ps = pool[i];
+        pool[i] = ps->next;
+        pool_size[i]--;
+    }
+    JVM_RawMonitorExit(pool_lock);
+    return ps;
+}
+
+static jboolean
+poolReturn(pooled_stream *ps)
+{
+    jboolean pooled = JNI_FALSE;
+    int i = ps->nowrap ? 1 : 0;
+    if (pool_lock == 0)
+        return JNI_FALSE;
+    JVM_RawMonitorEnter(pool_lock);
+    if (pool_size[i] < MAX_POOLED_STREAMS) {
+        ps->next = pool[i];
+        pool[i] = ps;
+        pool_size[i]++;
+        pooled = JNI_TRUE;
+    }
+    JVM_RawMonitorExit(pool_lock);
+    return pooled;
+}
+
 JNIEXPORT void JNICALL
 Java_java_util_zip_Inflater_initIDs(JNIEnv *env, jclass cls)
 {
@@ -52,24 +105,36 @@ Java_java_util_zip_Inflater_initIDs(JNIEnv *env, jclass cls)
     outputConsumedID = (*env)->GetFieldID(env, cls, "outputConsumed", "I");
     CHECK_NULL(inputConsumedID);
     CHECK_NULL(outputConsumedID);
+    /* Without the lock streams are simply never pooled */
+    pool_lock = JVM_RawMonitorCreate();
 }
 
 JNIEXPORT jlong JNICALL
 Java_java_util_zip_Inflater_init(JNIEnv *env, jclass cls, jboolean nowrap)
 {
-    z_stream *strm = calloc(1, sizeof(z_stream));
+    pooled_stream *ps = poolTake(nowrap);
+    z_stream *strm;
 
-    if (strm == NULL) {
+    if (ps != NULL) {
+        ps->next = NULL;
+        return ptr_to_jlong(&ps->strm);
+    }
+
+    ps = calloc(1, sizeof(pooled_stream));
+    if (ps == NULL) {
         JNU_ThrowOutOfMemoryError(env, 0);
         return jlong_zero;
     } else {
         const char *msg;
-        int ret = inflateInit2(strm, nowrap ? -MAX_WBITS : MAX_WBITS);
+        int ret;
+        strm = &ps->strm;
+        ps->nowrap = nowrap;
+        ret = ZLIB_inflateInit2(strm, nowrap ? -MAX_WBITS : MAX_WBITS);
         switch (ret) {
           case Z_OK:
             return ptr_to_jlong(strm);
           case Z_MEM_ERROR:
-            free(strm);
+            free(ps);
             JNU_ThrowOutOfMemoryError(env, 0);
             return jlong_zero;
           default:
@@ -80,7 +145,7 @@ Java_java_util_zip_Inflater_init(JNIEnv *env, jclass cls, jboolean nowrap)
                    (ret == Z_STREAM_ERROR) ?
                    "inflateInit2 returned Z_STREAM_ERROR" :
                    "unknown error initializing zlib library");
-            free(strm);
+            free(ps);
             JNU_ThrowInternalError(env, msg);
             return jlong_zero;
         }
@@ -110,7 +175,7 @@ Java_java_util_zip_Inflater_setDictionary(JNIEnv *env, jclass cls, jlong addr,
     Bytef *buf = (*env)->GetPrimitiveArrayCritical(env, b, 0);
     if (buf == NULL) /* out of memory */
         return;
-    res = inflateSetDictionary(jlong_to_ptr(addr), buf + off, len);
+    res = ZLIB->inflateSetDictionary(jlong_to_ptr(addr), buf + off, len);
     (*env)->ReleasePrimitiveArrayCritical(env, b, buf, 0);
     checkSetDictionaryResult(env, addr, res);
 }
@@ -121,7 +186,7 @@ Java_java_util_zip_Inflater_setDictionaryBuffer(JNIEnv *env, jclass cls, jlong a
 {
     jint res;
     Bytef *buf = jlong_to_ptr(bufferAddr);
-    res = inflateSetDictionary(jlong_to_ptr(addr), buf, len);
+    res = ZLIB->inflateSetDictionary(jlong_to_ptr(addr), buf, len);
     checkSetDictionaryResult(env, addr, res);
 }
 
@@ -137,7 +202,7 @@ static jint doInflate(jlong addr,
     strm->avail_in  = inputLen;
     strm->avail_out = outputLen;
 
-    ret = inflate(strm, Z_PARTIAL_FLUSH);
+    ret = ZLIB->inflate(strm, Z_PARTIAL_FLUSH);
     return ret;
 }
 
@@ -289,7 +354,7 @@ Java_java_util_zip_Inflater_getAdler(JNIEnv *env, jclass cls, jlong addr)
 JNIEXPORT void JNICALL
 Java_java_util_zip_Inflater_reset(JNIEnv *env, jclass cls, jlong addr)
 {
-    if (inflateReset(jlong_to_ptr(addr)) != Z_OK) {
+    if (ZLIB->inflateReset(jlong_to_ptr(addr)) != Z_OK) {
         JNU_ThrowInternalError(env, 0);
     }
 }
@@ -297,9 +362,15 @@ Java_java_util_zip_Inflater_reset(JNIEnv *env, jclass cls, jlong addr)
 JNIEXPORT void JNICALL
 Java_java_util_zip_Inflater_end(JNIEnv *env, jclass cls, jlong addr)
 {
-    if (inflateEnd(jlong_to_ptr(addr)) == Z_STREAM_ERROR) {
+    pooled_stream *ps = jlong_to_ptr(addr);
+
+    /* A stream that resets cleanly keeps its window for the next user */
+    if (ZLIB->inflateReset(&ps->strm) == Z_OK && poolReturn(ps)) {
+        return;
+    }
+    if (ZLIB->inflateEnd(&ps->strm) == Z_STREAM_ERROR) {
         JNU_ThrowInternalError(env, 0);
     } else {
-        free(jlong_to_ptr(addr));
+        free(ps);
     }
 }
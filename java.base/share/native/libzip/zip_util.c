@@ -417,6 +417,29 @@ findEND64(jzfile *zip, void *end64buf, jlong endpos)
     return end64pos;
 }
 
+/*
+ * Returns the size of the hash table for the given number of entries: one
+ * chain head per entry rounded up to a power of two, so that chains are
+ * short and the head is found with a mask rather than a division.
+ */
+static jint
+tableSize(jint total)
+{
+    jint size = 1;
+    while (size < total && size < (1 << 30))
+        size <<= 1;
+    return size;
+}
+
+/*
+ * Returns the hash table index for a 32 bit name hash.
+ */
+static jint
+tableIndex(jzfile *zip, unsigned int hsh)
+{
+    return (jint)((hsh ^ (hsh >> 16)) & (unsigned int)(zip->tablelen - 1));
+}
+
 /*
  * Returns a hash code value for a C-style NUL-terminated string.
  */
@@ -682,7 +705,7 @@ readCEN(jzfile *zip, jint knownTotal)
      */
     total = (knownTotal != -1) ? knownTotal : total;
     entries  = zip->entries  = calloc(total, sizeof(entries[0]));
-    tablelen = zip->tablelen = ((total/2) | 1); // Odd -> fewer collisions
+    tablelen = zip->tablelen = tableSize(total);
     table    = zip->table    = malloc(tablelen * sizeof(table[0]));
     /* According to ISO C it is perfectly legal for malloc to return zero
      * if called with a zero argument. We check this for 'entries' but not
@@ -730,7 +753,7 @@ readCEN(jzfile *zip, jint knownTotal)
         entries[i].hash = hashN((char *)cp+CENHDR, nlen);
 
         /* Add the entry to the hash table */
-        hsh = entries[i].hash % tablelen;
+        hsh = tableIndex(zip, entries[i].hash);
         entries[i].next = table[hsh];
         table[hsh] = i;
     }
@@ -1180,7 +1203,7 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
         goto Finally;
     }
 
-    idx = zip->table[hsh % zip->tablelen];
+    idx = zip->table[tableIndex(zip, hsh)];
 
     /*
      * This while loop is an optimization where a double lookup
@@ -1251,7 +1274,7 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
         name[ulen++] = '/';
         name[ulen] = '\0';
         hsh = hash_append(hsh, '/');
-        idx = zip->table[hsh % zip->tablelen];
+        idx = zip->table[tableIndex(zip, hsh)];
         addSlash = JNI_FALSE;
     }
 
@@ -1589,3 +1612,82 @@ ZIP_InflateFully(void *inBuf, jlong inLen, void *outBuf, jlong outLen, char **pm
     inflateEnd(&strm);
     return JNI_TRUE;
 }
+
+/*
+ * Computes the size of the output buffer needed to gzip a block of
+ * inLen bytes with the given compression level. No temporary buffer is
+ * needed, so *tmpLen is always set to 0. Returns NULL on success or a
+ * static error message otherwise.
+ */
+JNIEXPORT char*
+ZIP_GZip_InitParams(size_t inLen, size_t* outLen, size_t* tmpLen, int level)
+{
+    z_stream strm;
+    int err;
+
+    *tmpLen = 0;
+    *outLen = 0;
+    memset(&strm, 0, sizeof(z_stream));
+
+    /* windowBits of 31 selects the gzip format */
+    err = deflateInit2(&strm, level, Z_DEFLATED, 31, 8, Z_DEFAULT_STRATEGY);
+    if (err == Z_MEM_ERROR) {
+        return "Out of memory in deflateInit2";
+    }
+    if (err != Z_OK) {
+        return "Internal error in deflateInit2";
+    }
+
+    *outLen = (size_t) deflateBound(&strm, (uLong) inLen);
+    deflateEnd(&strm);
+
+    return NULL;
+}
+
+/*
+ * Compresses the given block as a complete gzip member, so that the member
+ * can be decompressed without any of the preceding data. The optional
+ * comment is stored in the gzip header. Returns the size of the compressed
+ * data, or 0 and sets *pmsg to a static error message on failure.
+ */
+JNIEXPORT size_t
+ZIP_GZip_Fully(char* inBuf, size_t inLen, char* outBuf, size_t outLen, char* tmp,
+               size_t tmpLen, int level, char* comment, char** pmsg)
+{
+    z_stream strm;
+    gz_header hdr;
+    int err;
+    size_t result = 0;
+
+    *pmsg = NULL;
+    memset(&strm, 0, sizeof(z_stream));
+
+    err = deflateInit2(&strm, level, Z_DEFLATED, 31, 8, Z_DEFAULT_STRATEGY);
+    if (err != Z_OK) {
+        *pmsg = "Internal error in deflateInit2";
+        return 0;
+    }
+
+    if (comment != NULL) {
+        memset(&hdr, 0, sizeof(hdr));
+        hdr.comment = (Bytef*) comment;
+        deflateSetHeader(&strm, &hdr);
+    }
+
+    strm.next_out = (Bytef *) outBuf;
+    strm.avail_out = (uInt) outLen;
+    strm.next_in = (Bytef *) inBuf;
+    strm.avail_in = (uInt) inLen;
+
+    err = deflate(&strm, Z_FINISH);
+    if (err == Z_OK || err == Z_BUF_ERROR) {
+        *pmsg = "Buffer too small";
+    } else if (err != Z_STREAM_END) {
+        *pmsg = "Internal deflate error";
+    } else {
+        result = (size_t) strm.total_out;
+    }
+
+    deflateEnd(&strm);
+    return result;
+}
@@ -225,7 +225,7 @@ typedef struct jzfile {   /* Zip file */
     jzcell *entries;      /* array of hash cells */
     jint total;           /* total number of entries */
     jint *table;          /* Hash chain heads: indexes into entries */
-    jint tablelen;        /* number of hash heads */
+    jint tablelen;        /* number of hash heads, a power of two */
     struct jzfile *next;  /* next zip file in search list */
     jzentry *cache;       /* we cache the most recently freed jzentry */
     /* Information on metadata names in META-INF directory */
@@ -284,4 +284,11 @@ jzentry * ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash);
 JNIEXPORT jboolean
 ZIP_InflateFully(void *inBuf, jlong inLen, void *outBuf, jlong outLen, char **pmsg);
 
+JNIEXPORT char*
+ZIP_GZip_InitParams(size_t inLen, size_t* outLen, size_t* tmpLen, int level);
+
+JNIEXPORT size_t
+ZIP_GZip_Fully(char* inBuf, size_t inLen, char* outBuf, size_t outLen, char* tmp,
+               size_t tmpLen, int level, char* comment, char** pmsg);
+
 #endif /* !_ZIP_H_ */
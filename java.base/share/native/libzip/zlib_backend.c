@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Native method support for selecting the zlib used by Inflater and Deflater
+ */
+
+#include <string.h>
+
+#include "jni.h"
+#include "jni_util.h"
+#include "jvm.h"
+#include "zlib_backend.h"
+
+#include "java_util_zip_ZipUtils.h"
+
+static const zlib_backend bundled = {
+    zlibVersion,
+    deflateInit2_,
+    deflate,
+    deflateEnd,
+    deflateParams,
+    deflateReset,
+    deflateSetDictionary,
+    inflateInit2_,
+    inflate,
+    inflateEnd,
+    inflateReset,
+    inflateSetDictionary
+};
+
+static zlib_backend loaded;
+
+const zlib_backend *ZLIB = &bundled;
+
+#define LOOKUP(handle, name)                                            \
+    if ((*(void **)&loaded.name = JVM_FindLibraryEntry(handle, #name)) == NULL) \
+        return JNI_FALSE
+
+/*
+ * Switches Inflater and Deflater to the zlib compatible library at the
+ * given path. Returns false, leaving the bundled zlib selected, if the
+ * library lacks an entry point or its major version differs from the
+ * zlib headers libzip is built with, as the z_stream layout could differ.
+ * Must be called before any stream is created.
+ */
+JNIEXPORT jboolean JNICALL
+Java_java_util_zip_ZipUtils_loadZlib(JNIEnv *env, jclass cls, jstring path)
+{
+    const char *cpath;
+    const char *version;
+    void *handle;
+
+    cpath = JNU_GetStringPlatformChars(env, path, 0);
+    if (cpath == NULL) {
+        return JNI_FALSE;
+    }
+    handle = JVM_LoadLibrary(cpath);
+    JNU_ReleaseStringPlatformChars(env, path, cpath);
+    if (handle == NULL) {
+        /* UnsatisfiedLinkError pending */
+        return JNI_FALSE;
+    }
+
+    LOOKUP(handle, zlibVersion);
+    LOOKUP(handle, deflateInit2_);
+    LOOKUP(handle, deflate);
+    LOOKUP(handle, deflateEnd);
+    LOOKUP(handle, deflateParams);
+    LOOKUP(handle, deflateReset);
+    LOOKUP(handle, deflateSetDictionary);
+    LOOKUP(handle, inflateInit2_);
+    LOOKUP(handle, inflate);
+    LOOKUP(handle, inflateEnd);
+    LOOKUP(handle, inflateReset);
+    LOOKUP(handle, inflateSetDictionary);
+
+    version = loaded.zlibVersion();
+    if (version == NULL || version[0] != ZLIB_VERSION[0]) {
+        return JNI_FALSE;
+    }
+    ZLIB = &loaded;
+    return JNI_TRUE;
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * The zlib entry points used by Inflater and Deflater. By default these
+ * are the functions of the zlib that libzip is built with. A compatible
+ * library, such as zlib-ng built in compat mode, can be selected at run
+ * time with the jdk.zip.zlib system property.
+ */
+
+#ifndef _ZLIB_BACKEND_H_
+#define _ZLIB_BACKEND_H_
+
+#include <zlib.h>
+
+typedef struct {
+    const char * (*zlibVersion)(void);
+    int (*deflateInit2_)(z_streamp strm, int level, int method,
+                         int windowBits, int memLevel, int strategy,
+                         const char *version, int stream_size);
+    int (*deflate)(z_streamp strm, int flush);
+    int (*deflateEnd)(z_streamp strm);
+    int (*deflateParams)(z_streamp strm, int level, int strategy);
+    int (*deflateReset)(z_streamp strm);
+    int (*deflateSetDictionary)(z_streamp strm, const Bytef *dictionary,
+                                uInt dictLength);
+    int (*inflateInit2_)(z_streamp strm, int windowBits,
+                         const char *version, int stream_size);
+    int (*inflate)(z_streamp strm, int flush);
+    int (*inflateEnd)(z_streamp strm);
+    int (*inflateReset)(z_streamp strm);
+    int (*inflateSetDictionary)(z_streamp strm, const Bytef *dictionary,
+                                uInt dictLength);
+} zlib_backend;
+
+/* The selected backend, never NULL */
+extern const zlib_backend *ZLIB;
+
+#define ZLIB_deflateInit2(strm, level, method, windowBits, memLevel, strategy) \
+        ZLIB->deflateInit2_((strm), (level), (method), (windowBits), \
+                            (memLevel), (strategy), ZLIB_VERSION, \
+                            (int)sizeof(z_stream))
+#define ZLIB_inflateInit2(strm, windowBits) \
+        ZLIB->inflateInit2_((strm), (windowBits), ZLIB_VERSION, \
+                            (int)sizeof(z_stream))
+
+#endif /* !_ZLIB_BACKEND_H_ */
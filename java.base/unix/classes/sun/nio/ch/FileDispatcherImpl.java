@@ -58,6 +58,23 @@ class FileDispatcherImpl extends FileDispatcher {
         return readv0(fd, address, len);
     }
 
+    boolean supportsPositionalVectoredIO() {
+        return true;
+    }
+
+    long preadv(FileDescriptor fd, long address, int len, long position)
+        throws IOException
+    {
+        return preadv0(fd, address, len, position);
+    }
+
+    int preadRanges(FileDescriptor fd, long address, long[] positions,
+                    int[] counts, int len)
+        throws IOException
+    {
+        return preadRanges0(fd, address, positions, counts, len);
+    }
+
     int write(FileDescriptor fd, long address, int len) throws IOException {
         return write0(fd, address, len);
     }
@@ -74,6 +91,12 @@ class FileDispatcherImpl extends FileDispatcher {
         return writev0(fd, address, len);
     }
 
+    long pwritev(FileDescriptor fd, long address, int len, long position)
+        throws IOException
+    {
+        return pwritev0(fd, address, len, position);
+    }
+
     long seek(FileDescriptor fd, long offset) throws IOException {
         return seek0(fd, offset);
     }
@@ -122,6 +145,20 @@ class FileDispatcherImpl extends FileDispatcher {
         return false;
     }
 
+    long copyFileRange(FileDescriptor src, long srcPosition,
+                       FileDescriptor dst, long dstPosition, long count)
+        throws IOException
+    {
+        return copyFileRange0(src, srcPosition, dst, dstPosition, count);
+    }
+
+    long splice(FileDescriptor src, FileDescriptor dst, long position,
+                long count)
+        throws IOException
+    {
+        return splice0(src, dst, position, count);
+    }
+
     int setDirectIO(FileDescriptor fd, String path) {
         int result = -1;
         try {
@@ -144,6 +181,13 @@ class FileDispatcherImpl extends FileDispatcher {
     static native long readv0(FileDescriptor fd, long address, int len)
         throws IOException;
 
+    static native long preadv0(FileDescriptor fd, long address, int len,
+                               long position) throws IOException;
+
+    static native int preadRanges0(FileDescriptor fd, long address,
+                                   long[] positions, int[] counts, int len)
+        throws IOException;
+
     static native int write0(FileDescriptor fd, long address, int len)
         throws IOException;
 
@@ -153,6 +197,9 @@ class FileDispatcherImpl extends FileDispatcher {
     static native long writev0(FileDescriptor fd, long address, int len)
         throws IOException;
 
+    static native long pwritev0(FileDescriptor fd, long address, int len,
+                                long position) throws IOException;
+
     static native int force0(FileDescriptor fd, boolean metaData)
         throws IOException;
 
@@ -180,6 +227,13 @@ class FileDispatcherImpl extends FileDispatcher {
 
     static native int setDirect0(FileDescriptor fd) throws IOException;
 
+    static native long copyFileRange0(FileDescriptor src, long srcPosition,
+                                      FileDescriptor dst, long dstPosition,
+                                      long count) throws IOException;
+
+    static native long splice0(FileDescriptor src, FileDescriptor dst,
+                               long position, long count) throws IOException;
+
     static native void init();
 
 }
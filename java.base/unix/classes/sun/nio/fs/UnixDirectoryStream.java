@@ -58,6 +58,9 @@ class UnixDirectoryStream
     // directory iterator
     private Iterator<Path> iterator;
 
+    // maximum number of entries read from the directory per native call
+    private static final int NAMES_PER_READ = 64;
+
     /**
      * Initializes a new instance
      */
@@ -136,6 +139,11 @@ class UnixDirectoryStream
         // next entry to return
         private Path nextEntry;
 
+        // names read from the directory but not yet returned
+        private final byte[][] names = new byte[NAMES_PER_READ][];
+        private int nameCount;
+        private int nameIndex;
+
         UnixDirectoryIterator() {
             atEof = false;
         }
@@ -156,27 +164,34 @@ class UnixDirectoryStream
             assert Thread.holdsLock(this);
 
             for (;;) {
-                byte[] nameAsBytes = null;
+                // refill from the directory when all names have been consumed
+                if (nameIndex == nameCount) {
+                    nameIndex = 0;
+                    nameCount = 0;
 
-                // prevent close while reading
-                readLock().lock();
-                try {
-                    if (isOpen()) {
-                        nameAsBytes = readdir(dp);
+                    // prevent close while reading
+                    readLock().lock();
+                    try {
+                        if (isOpen()) {
+                            nameCount = readdirBatch(dp, names);
+                        }
+                    } catch (UnixException x) {
+                        IOException ioe = x.asIOException(dir);
+                        throw new DirectoryIteratorException(ioe);
+                    } finally {
+                        readLock().unlock();
                     }
-                } catch (UnixException x) {
-                    IOException ioe = x.asIOException(dir);
-                    throw new DirectoryIteratorException(ioe);
-                } finally {
-                    readLock().unlock();
                 }
 
-                // EOF
-                if (nameAsBytes == null) {
+                // EOF, or closed with names still buffered
+                if (nameCount == 0 || !isOpen()) {
                     atEof = true;
                     return null;
                 }
 
+                byte[] nameAsBytes = names[nameIndex];
+                names[nameIndex++] = null;
+
                 // ignore "." and ".."
                 if (!isSelfOrParent(nameAsBytes)) {
                     Path entry = dir.resolve(nameAsBytes);
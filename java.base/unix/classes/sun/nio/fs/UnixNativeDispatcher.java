@@ -468,6 +468,14 @@ class UnixNativeDispatcher {
      */
     static native byte[] readdir(long dir) throws UnixException;
 
+    /**
+     * Reads up to names.length entries with readdir(DIR *dirp), storing
+     * each dirent->d_name in the given array.
+     *
+     * @return  the number of entries read, 0 at end of directory
+     */
+    static native int readdirBatch(long dir, byte[][] names) throws UnixException;
+
     /**
      * size_t read(int fildes, void* buf, size_t nbyte)
      */
@@ -40,12 +40,17 @@
 #include <stdlib.h>
 #include <sys/types.h>
 #include <ctype.h>
+#include <errno.h>
 #include <sys/wait.h>
 #include <signal.h>
 #include <string.h>
 
 #include <spawn.h>
 
+#if defined(__linux__)
+#include <dlfcn.h>
+#endif
+
 #include "childproc.h"
 
 /*
@@ -180,6 +185,15 @@
  *
  * Based on the above analysis, we are currently defaulting to posix_spawn()
  * on all Unices including Linux.
+ *
+ * On Linux, when the C library provides posix_spawn_file_actions_addchdir_np
+ * and posix_spawn_file_actions_addclosefrom_np (glibc 2.34 and later), the
+ * pre-exec work done by jspawnhelper - redirecting the standard streams,
+ * changing directory and closing all other descriptors - can be expressed as
+ * file actions. The target is then spawned directly, saving the second exec
+ * and the round trip through the childenv pipe. Those versions of glibc
+ * implement posix_spawn with clone(CLONE_VM|CLONE_VFORK) and report a failed
+ * exec back to the caller, so no alive ping is needed either.
  */
 
 static void
@@ -282,12 +296,27 @@ effectivePathv(JNIEnv *env)
     return pathv;
 }
 
+#if defined(__linux__)
+typedef int (*addchdir_func_t)(posix_spawn_file_actions_t *, const char *);
+typedef int (*addclosefrom_func_t)(posix_spawn_file_actions_t *, int);
+
+/* Set by ProcessImpl.init when posix_spawn can be used without the helper */
+static addchdir_func_t addchdir_func;
+static addclosefrom_func_t addclosefrom_func;
+#endif
+
 JNIEXPORT void JNICALL
 Java_java_lang_ProcessImpl_init(JNIEnv *env, jclass clazz)
 {
     parentPathv = effectivePathv(env);
     CHECK_NULL(parentPathv);
     setSIGCHLDHandler(env);
+#if defined(__linux__)
+    addchdir_func = (addchdir_func_t)
+        dlsym(RTLD_DEFAULT, "posix_spawn_file_actions_addchdir_np");
+    addclosefrom_func = (addclosefrom_func_t)
+        dlsym(RTLD_DEFAULT, "posix_spawn_file_actions_addclosefrom_np");
+#endif
 }
 
 
@@ -471,6 +500,64 @@ forkChild(ChildStuff *c) {
     return resultPid;
 }
 
+#if defined(__linux__)
+/*
+ * Spawns the target directly, with file actions doing the work that
+ * childProcess() would otherwise do in jspawnhelper. Returns the error
+ * number from posix_spawn, or ENOSYS if the file actions are not
+ * supported by the C library.
+ */
+static int
+spawnDirect(ChildStuff *c, pid_t *pid) {
+    posix_spawn_file_actions_t actions;
+    int in  = (c->in[0]  != -1) ? c->in[0]  : c->fds[0];
+    int out = (c->out[1] != -1) ? c->out[1] : c->fds[1];
+    int err = (c->err[1] != -1) ? c->err[1] : c->fds[2];
+    int rval;
+
+    if (addchdir_func == NULL || addclosefrom_func == NULL) {
+        return ENOSYS;
+    }
+    if (c->redirectErrorStream) {
+        err = STDOUT_FILENO;
+    }
+    /* An inherited stream stays where it is. Any other source that is
+     * itself a standard descriptor could be overwritten by an earlier
+     * dup2, so leave those unusual cases to jspawnhelper. */
+    if ((in  != STDIN_FILENO  && in  <= STDERR_FILENO) ||
+        (out != STDOUT_FILENO && out <= STDERR_FILENO) ||
+        (err != STDERR_FILENO && err <  STDERR_FILENO && !c->redirectErrorStream)) {
+        return ENOSYS;
+    }
+
+    if ((rval = posix_spawn_file_actions_init(&actions)) != 0) {
+        return rval;
+    }
+    if (in != STDIN_FILENO) {
+        rval = posix_spawn_file_actions_adddup2(&actions, in, STDIN_FILENO);
+    }
+    if (rval == 0 && out != STDOUT_FILENO) {
+        rval = posix_spawn_file_actions_adddup2(&actions, out, STDOUT_FILENO);
+    }
+    if (rval == 0 && err != STDERR_FILENO) {
+        rval = posix_spawn_file_actions_adddup2(&actions, err, STDERR_FILENO);
+    }
+    if (rval == 0 && c->pdir != NULL) {
+        rval = (*addchdir_func)(&actions, c->pdir);
+    }
+    if (rval == 0) {
+        rval = (*addclosefrom_func)(&actions, STDERR_FILENO + 1);
+    }
+    if (rval == 0) {
+        rval = posix_spawnp(pid, c->argv[0], &actions, NULL,
+                            (char * const *) c->argv,
+                            (char * const *) (c->envv != NULL ? c->envv : (const char **) environ));
+    }
+    posix_spawn_file_actions_destroy(&actions);
+    return rval;
+}
+#endif
+
 static pid_t
 spawnChild(JNIEnv *env, jobject process, ChildStuff *c, const char *helperpath) {
     pid_t resultPid;
@@ -480,6 +567,19 @@ spawnChild(JNIEnv *env, jobject process, ChildStuff *c, const char *helperpath)
     char *hlpargs[2];
     SpawnInfo sp;
 
+#if defined(__linux__)
+    /* A script without #! fails with ENOEXEC; jspawnhelper runs it with
+     * /bin/sh so fall back to the helper in that case. */
+    rval = spawnDirect(c, &resultPid);
+    if (rval == 0) {
+        c->sendAlivePing = 0;
+        return resultPid;
+    } else if (rval != ENOSYS && rval != ENOEXEC) {
+        errno = rval;
+        return -1;
+    }
+#endif
+
     /* need to tell helper which fd is for receiving the childstuff
      * and which fd to send response back on
      */
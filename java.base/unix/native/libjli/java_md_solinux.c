@@ -553,7 +553,13 @@ LoadJavaVM(const char *jvmpath, InvocationFunctions *ifn)
 
     JLI_TraceLauncher("JVM path is %s\n", jvmpath);
 
-    libjvm = dlopen(jvmpath, RTLD_NOW + RTLD_GLOBAL);
+    /*
+     * Bind libjvm's symbols lazily, as os::dll_load does for the libraries
+     * loaded by the VM. Only a fraction of the PLT entries are used during
+     * a short run, so resolving all of them up front only adds to startup.
+     * Eager binding can still be requested with LD_BIND_NOW.
+     */
+    libjvm = dlopen(jvmpath, RTLD_LAZY | RTLD_GLOBAL);
     if (libjvm == NULL) {
 #if defined(__solaris__) && defined(__sparc) && !defined(_LP64) /* i.e. 32-bit sparc */
       FILE * fp;
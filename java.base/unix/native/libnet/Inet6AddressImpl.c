@@ -241,9 +241,12 @@ Java_java_net_Inet6AddressImpl_lookupAllHostAddr(JNIEnv *env, jobject this,
     CHECK_NULL_RETURN(hostname, NULL);
 
     // try once, with our static buffer
+    // Only the addresses are needed: don't ask for the canonical name and
+    // restrict the results to one socket type, otherwise every address is
+    // returned once per type and has to be filtered out as a duplicate.
     memset(&hints, 0, sizeof(hints));
-    hints.ai_flags = AI_CANONNAME;
     hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
 
     error = getaddrinfo(hostname, NULL, &hints, &res);
 
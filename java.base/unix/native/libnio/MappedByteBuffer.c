@@ -125,3 +125,34 @@ Java_java_nio_MappedByteBuffer_force0(JNIEnv *env, jobject obj, jobject fdo,
         JNU_ThrowIOExceptionWithLastError(env, "msync failed");
     }
 }
+
+
+JNIEXPORT void JNICALL
+Java_java_nio_MappedByteBuffer_advise0(JNIEnv *env, jobject obj, jlong address,
+                                       jlong len, jint advice)
+{
+    /* indexed by the advice values defined by JavaNioAccess.advise */
+    static const int advices[] = {
+        MADV_NORMAL, MADV_RANDOM, MADV_SEQUENTIAL, MADV_WILLNEED, MADV_DONTNEED
+    };
+    char *a = (char *)jlong_to_ptr(address);
+    int result;
+
+    assert(advice >= 0 && advice < (jint)(sizeof(advices) / sizeof(advices[0])));
+    result = madvise((caddr_t)a, (size_t)len, advices[advice]);
+    if (result == -1) {
+        JNU_ThrowIOExceptionWithLastError(env, "madvise failed");
+    }
+}
+
+
+JNIEXPORT void JNICALL
+Java_java_nio_MappedByteBuffer_forceAsync0(JNIEnv *env, jobject obj, jobject fdo,
+                                           jlong address, jlong len)
+{
+    void* a = (void *)jlong_to_ptr(address);
+    int result = msync(a, (size_t)len, MS_ASYNC);
+    if (result == -1) {
+        JNU_ThrowIOExceptionWithLastError(env, "msync failed");
+    }
+}
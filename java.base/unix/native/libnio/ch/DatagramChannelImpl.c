@@ -39,6 +39,10 @@
 #include <netinet/in.h>
 #endif
 
+#if defined(__linux__)
+#include <sys/uio.h>
+#endif
+
 #include "net_util.h"
 #include "net_util_md.h"
 #include "nio.h"
@@ -46,6 +50,9 @@
 
 #include "sun_nio_ch_DatagramChannelImpl.h"
 
+/* Maximum number of datagrams received or sent in one batch */
+#define MAX_DATAGRAM_BATCH 64
+
 static jfieldID dci_senderID;   /* sender in sun.nio.ch.DatagramChannelImpl */
 static jfieldID dci_senderAddrID; /* sender InetAddress in sun.nio.ch.DatagramChannelImpl */
 static jfieldID dci_senderPortID; /* sender port in sun.nio.ch.DatagramChannelImpl */
@@ -121,6 +128,45 @@ Java_sun_nio_ch_DatagramChannelImpl_disconnect0(JNIEnv *env, jobject this,
         handleSocketError(env, errno);
 }
 
+/*
+ * Returns the InetSocketAddress for the given source address and stores it
+ * in the sender field. If the source address and port match the cached
+ * address and port in DatagramChannelImpl then we don't need to create
+ * InetAddress and InetSocketAddress objects. Returns NULL with an
+ * exception pending if the objects cannot be created.
+ */
+static jobject
+senderAddress(JNIEnv *env, jobject this, SOCKETADDRESS *sa)
+{
+    jobject senderAddr = (*env)->GetObjectField(env, this, dci_senderAddrID);
+    if (senderAddr != NULL) {
+        if (!NET_SockaddrEqualsInetAddress(env, sa, senderAddr)) {
+            senderAddr = NULL;
+        } else {
+            jint port = (*env)->GetIntField(env, this, dci_senderPortID);
+            if (port != NET_GetPortFromSockaddr(sa)) {
+                senderAddr = NULL;
+            }
+        }
+    }
+    if (senderAddr == NULL) {
+        jobject isa = NULL;
+        int port = 0;
+        jobject ia = NET_SockaddrToInetAddress(env, sa, &port);
+        if (ia != NULL) {
+            isa = (*env)->NewObject(env, isa_class, isa_ctorID, ia, port);
+        }
+        CHECK_NULL_RETURN(isa, NULL);
+
+        (*env)->SetObjectField(env, this, dci_senderAddrID, ia);
+        (*env)->SetIntField(env, this, dci_senderPortID,
+                            NET_GetPortFromSockaddr(sa));
+        (*env)->SetObjectField(env, this, dci_senderID, isa);
+        return isa;
+    }
+    return (*env)->GetObjectField(env, this, dci_senderID);
+}
+
 JNIEXPORT jint JNICALL
 Java_sun_nio_ch_DatagramChannelImpl_receive0(JNIEnv *env, jobject this,
                                              jobject fdo, jlong address,
@@ -132,7 +178,6 @@ Java_sun_nio_ch_DatagramChannelImpl_receive0(JNIEnv *env, jobject this,
     socklen_t sa_len = sizeof(SOCKETADDRESS);
     jboolean retry = JNI_FALSE;
     jint n = 0;
-    jobject senderAddr;
 
     if (len > MAX_PACKET_LEN) {
         len = MAX_PACKET_LEN;
@@ -162,35 +207,8 @@ Java_sun_nio_ch_DatagramChannelImpl_receive0(JNIEnv *env, jobject this,
         }
     } while (retry == JNI_TRUE);
 
-    /*
-     * If the source address and port match the cached address
-     * and port in DatagramChannelImpl then we don't need to
-     * create InetAddress and InetSocketAddress objects.
-     */
-    senderAddr = (*env)->GetObjectField(env, this, dci_senderAddrID);
-    if (senderAddr != NULL) {
-        if (!NET_SockaddrEqualsInetAddress(env, &sa, senderAddr)) {
-            senderAddr = NULL;
-        } else {
-            jint port = (*env)->GetIntField(env, this, dci_senderPortID);
-            if (port != NET_GetPortFromSockaddr(&sa)) {
-                senderAddr = NULL;
-            }
-        }
-    }
-    if (senderAddr == NULL) {
-        jobject isa = NULL;
-        int port = 0;
-        jobject ia = NET_SockaddrToInetAddress(env, &sa, &port);
-        if (ia != NULL) {
-            isa = (*env)->NewObject(env, isa_class, isa_ctorID, ia, port);
-        }
-        CHECK_NULL_RETURN(isa, IOS_THROWN);
-
-        (*env)->SetObjectField(env, this, dci_senderAddrID, ia);
-        (*env)->SetIntField(env, this, dci_senderPortID,
-                            NET_GetPortFromSockaddr(&sa));
-        (*env)->SetObjectField(env, this, dci_senderID, isa);
+    if (senderAddress(env, this, &sa) == NULL) {
+        return IOS_THROWN;
     }
     return n;
 }
@@ -231,3 +249,156 @@ Java_sun_nio_ch_DatagramChannelImpl_send0(JNIEnv *env, jobject this,
     }
     return n;
 }
+
+JNIEXPORT jboolean JNICALL
+Java_sun_nio_ch_DatagramChannelImpl_batchSupported0(JNIEnv *env, jclass clazz)
+{
+#if defined(__linux__)
+    return JNI_TRUE;
+#else
+    return JNI_FALSE;
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_DatagramChannelImpl_receiveBatch0(JNIEnv *env, jobject this,
+                                                  jobject fdo,
+                                                  jlongArray addresses,
+                                                  jintArray lengths,
+                                                  jint count,
+                                                  jobjectArray senders)
+{
+#if defined(__linux__)
+    jint fd = fdval(env, fdo);
+    struct mmsghdr msgs[MAX_DATAGRAM_BATCH];
+    struct iovec iovs[MAX_DATAGRAM_BATCH];
+    SOCKETADDRESS sas[MAX_DATAGRAM_BATCH];
+    jlong addrs[MAX_DATAGRAM_BATCH];
+    jint lens[MAX_DATAGRAM_BATCH];
+    int i, n;
+
+    if (count > MAX_DATAGRAM_BATCH) {
+        count = MAX_DATAGRAM_BATCH;
+    }
+    (*env)->GetLongArrayRegion(env, addresses, 0, count, addrs);
+    (*env)->GetIntArrayRegion(env, lengths, 0, count, lens);
+
+    memset(msgs, 0, sizeof(msgs));
+    for (i = 0; i < count; i++) {
+        iovs[i].iov_base = jlong_to_ptr(addrs[i]);
+        iovs[i].iov_len = (lens[i] > MAX_PACKET_LEN) ? MAX_PACKET_LEN : lens[i];
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        if (senders != NULL) {
+            msgs[i].msg_hdr.msg_name = &sas[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(SOCKETADDRESS);
+        }
+    }
+
+    /* block for the first datagram at most, then take what is queued */
+    n = recvmmsg(fd, msgs, (unsigned int)count, MSG_WAITFORONE, NULL);
+    if (n < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return IOS_UNAVAILABLE;
+        }
+        if (errno == EINTR) {
+            return IOS_INTERRUPTED;
+        }
+        if (errno == ECONNREFUSED) {
+            if (senders != NULL) {
+                /* not connected, the caller tries again */
+                return IOS_UNAVAILABLE;
+            }
+            JNU_ThrowByName(env, JNU_JAVANETPKG
+                            "PortUnreachableException", 0);
+            return IOS_THROWN;
+        }
+        return handleSocketError(env, errno);
+    }
+
+    for (i = 0; i < n; i++) {
+        lens[i] = (jint)msgs[i].msg_len;
+        if (senders != NULL) {
+            jobject isa = senderAddress(env, this, &sas[i]);
+            if (isa == NULL) {
+                return IOS_THROWN;
+            }
+            (*env)->SetObjectArrayElement(env, senders, i, isa);
+            (*env)->DeleteLocalRef(env, isa);
+        }
+    }
+    (*env)->SetIntArrayRegion(env, lengths, 0, n, lens);
+    return n;
+#else
+    return IOS_UNSUPPORTED;
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_DatagramChannelImpl_sendBatch0(JNIEnv *env, jobject this,
+                                               jboolean preferIPv6,
+                                               jobject fdo,
+                                               jlongArray addresses,
+                                               jintArray lengths,
+                                               jint count,
+                                               jobject destAddress,
+                                               jint destPort)
+{
+#if defined(__linux__)
+    jint fd = fdval(env, fdo);
+    struct mmsghdr msgs[MAX_DATAGRAM_BATCH];
+    struct iovec iovs[MAX_DATAGRAM_BATCH];
+    jlong addrs[MAX_DATAGRAM_BATCH];
+    jint lens[MAX_DATAGRAM_BATCH];
+    SOCKETADDRESS sa;
+    int sa_len = 0;
+    int i, n;
+
+    if (count > MAX_DATAGRAM_BATCH) {
+        count = MAX_DATAGRAM_BATCH;
+    }
+    (*env)->GetLongArrayRegion(env, addresses, 0, count, addrs);
+    (*env)->GetIntArrayRegion(env, lengths, 0, count, lens);
+
+    if (destAddress != NULL) {
+        if (NET_InetAddressToSockaddr(env, destAddress, destPort, &sa,
+                                      &sa_len, preferIPv6) != 0) {
+            return IOS_THROWN;
+        }
+    }
+
+    memset(msgs, 0, sizeof(msgs));
+    for (i = 0; i < count; i++) {
+        iovs[i].iov_base = jlong_to_ptr(addrs[i]);
+        iovs[i].iov_len = (lens[i] > MAX_PACKET_LEN) ? MAX_PACKET_LEN : lens[i];
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        if (destAddress != NULL) {
+            msgs[i].msg_hdr.msg_name = &sa;
+            msgs[i].msg_hdr.msg_namelen = sa_len;
+        }
+    }
+
+    n = sendmmsg(fd, msgs, (unsigned int)count, 0);
+    if (n < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return IOS_UNAVAILABLE;
+        }
+        if (errno == EINTR) {
+            return IOS_INTERRUPTED;
+        }
+        if (errno == ECONNREFUSED) {
+            if (destAddress != NULL) {
+                /* not connected, the first datagram is dropped as in send */
+                return 1;
+            }
+            JNU_ThrowByName(env, JNU_JAVANETPKG "PortUnreachableException", 0);
+            return IOS_THROWN;
+        }
+        return handleSocketError(env, errno);
+    }
+    return n;
+#else
+    return IOS_UNSUPPORTED;
+#endif
+}
@@ -25,6 +25,7 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <stdlib.h>
 #include <fcntl.h>
 #include <sys/uio.h>
 #include <unistd.h>
@@ -34,6 +35,7 @@
 #if defined(__linux__)
 #include <linux/fs.h>
 #include <sys/ioctl.h>
+#include <sys/syscall.h>
 #endif
 
 #if defined(_ALLBSD_SOURCE)
@@ -75,6 +77,114 @@ Java_sun_nio_ch_FileDispatcherImpl_init(JNIEnv *env, jclass cl)
     close(sp[1]);
 }
 
+/* Largest pipe used to splice from a socket to a file */
+#define MAX_SPLICE_PIPE_SIZE    (1024 * 1024)
+
+JNIEXPORT jlong JNICALL
+Java_sun_nio_ch_FileDispatcherImpl_copyFileRange0(JNIEnv *env, jclass clazz,
+                                                  jobject srcFDO, jlong srcPosition,
+                                                  jobject dstFDO, jlong dstPosition,
+                                                  jlong count)
+{
+#if defined(__linux__) && defined(__NR_copy_file_range)
+    jint srcFD = fdval(env, srcFDO);
+    jint dstFD = fdval(env, dstFDO);
+    loff_t srcOffset = (loff_t)srcPosition;
+    loff_t dstOffset = (loff_t)dstPosition;
+
+    /* called through syscall(), older C libraries have no wrapper */
+    jlong n = syscall(__NR_copy_file_range,
+                      srcFD, (srcPosition < 0) ? NULL : &srcOffset,
+                      dstFD, (dstPosition < 0) ? NULL : &dstOffset,
+                      (size_t)count, 0);
+    if (n < 0) {
+        if (errno == EINTR)
+            return IOS_INTERRUPTED;
+        if (errno == ENOSYS)
+            return IOS_UNSUPPORTED;
+        /* different file systems, append mode, special files, ... */
+        if (errno == EXDEV || errno == EINVAL || errno == EBADF ||
+            errno == EOPNOTSUPP || errno == ETXTBSY)
+            return IOS_UNSUPPORTED_CASE;
+        JNU_ThrowIOExceptionWithLastError(env, "Transfer failed");
+        return IOS_THROWN;
+    }
+    return n;
+#else
+    return IOS_UNSUPPORTED;
+#endif
+}
+
+JNIEXPORT jlong JNICALL
+Java_sun_nio_ch_FileDispatcherImpl_splice0(JNIEnv *env, jclass clazz,
+                                           jobject srcFDO, jobject dstFDO,
+                                           jlong position, jlong count)
+{
+#if defined(__linux__)
+    jint srcFD = fdval(env, srcFDO);
+    jint dstFD = fdval(env, dstFDO);
+    loff_t offset = (loff_t)position;
+    ssize_t n, moved;
+    int pfd[2];
+
+    if (pipe(pfd) < 0) {
+        JNU_ThrowIOExceptionWithLastError(env, "pipe failed");
+        return IOS_THROWN;
+    }
+#ifdef F_SETPIPE_SZ
+    if (count > 65536) {
+        /* a failure leaves the default size */
+        fcntl(pfd[1], F_SETPIPE_SZ,
+              (int)((count < MAX_SPLICE_PIPE_SIZE) ? count : MAX_SPLICE_PIPE_SIZE));
+    }
+#endif
+
+    /*
+     * Never block on the socket, the caller parks until it is readable.
+     * The pipe is empty so the bytes moved into it always fit.
+     */
+    n = splice(srcFD, NULL, pfd[1], NULL, (size_t)count,
+               SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    if (n < 0) {
+        int err = errno;
+        close(pfd[0]);
+        close(pfd[1]);
+        if (err == EAGAIN)
+            return IOS_UNAVAILABLE;
+        if (err == EINTR)
+            return IOS_INTERRUPTED;
+        if (err == ENOSYS)
+            return IOS_UNSUPPORTED;
+        if (err == EINVAL)
+            return IOS_UNSUPPORTED_CASE;
+        errno = err;
+        JNU_ThrowIOExceptionWithLastError(env, "Transfer failed");
+        return IOS_THROWN;
+    }
+
+    moved = 0;
+    while (moved < n) {
+        ssize_t m = splice(pfd[0], NULL, dstFD, &offset, (size_t)(n - moved),
+                           SPLICE_F_MOVE);
+        if (m <= 0) {
+            if (m < 0 && errno == EINTR)
+                continue;
+            /* the bytes read from the socket are lost */
+            JNU_ThrowIOExceptionWithLastError(env, "Transfer failed");
+            close(pfd[0]);
+            close(pfd[1]);
+            return IOS_THROWN;
+        }
+        moved += m;
+    }
+    close(pfd[0]);
+    close(pfd[1]);
+    return (n == 0) ? IOS_EOF : n;
+#else
+    return IOS_UNSUPPORTED;
+#endif
+}
+
 JNIEXPORT jint JNICALL
 Java_sun_nio_ch_FileDispatcherImpl_read0(JNIEnv *env, jclass clazz,
                              jobject fdo, jlong address, jint len)
@@ -133,6 +243,115 @@ Java_sun_nio_ch_FileDispatcherImpl_writev0(JNIEnv *env, jclass clazz,
     return convertLongReturnVal(env, writev(fd, iov, len), JNI_FALSE);
 }
 
+#if !defined(__linux__)
+/* Emulates preadv/pwritev where the C library has no positional variants */
+static ssize_t
+preadv64(int fd, const struct iovec *iov, int iovcnt, off64_t offset)
+{
+    ssize_t total = 0;
+    int i;
+    for (i = 0; i < iovcnt; i++) {
+        ssize_t n = pread64(fd, iov[i].iov_base, iov[i].iov_len, offset + total);
+        if (n < 0)
+            return (total > 0) ? total : n;
+        total += n;
+        if ((size_t)n < iov[i].iov_len)
+            break;
+    }
+    return total;
+}
+
+static ssize_t
+pwritev64(int fd, const struct iovec *iov, int iovcnt, off64_t offset)
+{
+    ssize_t total = 0;
+    int i;
+    for (i = 0; i < iovcnt; i++) {
+        ssize_t n = pwrite64(fd, iov[i].iov_base, iov[i].iov_len, offset + total);
+        if (n < 0)
+            return (total > 0) ? total : n;
+        total += n;
+        if ((size_t)n < iov[i].iov_len)
+            break;
+    }
+    return total;
+}
+#endif
+
+JNIEXPORT jlong JNICALL
+Java_sun_nio_ch_FileDispatcherImpl_preadv0(JNIEnv *env, jclass clazz,
+                                           jobject fdo, jlong address, jint len,
+                                           jlong offset)
+{
+    jint fd = fdval(env, fdo);
+    struct iovec *iov = (struct iovec *)jlong_to_ptr(address);
+    return convertLongReturnVal(env, preadv64(fd, iov, len, offset), JNI_TRUE);
+}
+
+JNIEXPORT jlong JNICALL
+Java_sun_nio_ch_FileDispatcherImpl_pwritev0(JNIEnv *env, jclass clazz,
+                                            jobject fdo, jlong address, jint len,
+                                            jlong offset)
+{
+    jint fd = fdval(env, fdo);
+    struct iovec *iov = (struct iovec *)jlong_to_ptr(address);
+    return convertLongReturnVal(env, pwritev64(fd, iov, len, offset), JNI_FALSE);
+}
+
+/*
+ * Reads each iovec entry from its own file position. The number of bytes
+ * read for each range is stored in counts. Returns the number of ranges
+ * done; a failure after the first range ends the batch early so that the
+ * caller sees the progress and the error is reported by the next call.
+ * The arrays are copied rather than pinned as the reads may block.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_FileDispatcherImpl_preadRanges0(JNIEnv *env, jclass clazz,
+                                                jobject fdo, jlong address,
+                                                jlongArray positions,
+                                                jintArray counts, jint len)
+{
+    jint fd = fdval(env, fdo);
+    struct iovec *iov = (struct iovec *)jlong_to_ptr(address);
+    jlong *pos;
+    jint *cnt;
+    jint i;
+    int error = 0;
+
+    if (len == 0)
+        return 0;
+    pos = (jlong *)malloc(len * (sizeof(jlong) + sizeof(jint)));
+    if (pos == NULL) {
+        JNU_ThrowOutOfMemoryError(env, NULL);
+        return IOS_THROWN;
+    }
+    cnt = (jint *)(pos + len);
+    (*env)->GetLongArrayRegion(env, positions, 0, len, pos);
+    if ((*env)->ExceptionCheck(env)) {
+        free(pos);
+        return IOS_THROWN;
+    }
+    for (i = 0; i < len; i++) {
+        ssize_t n = pread64(fd, iov[i].iov_base, iov[i].iov_len, pos[i]);
+        if (n < 0) {
+            error = errno;
+            break;
+        }
+        cnt[i] = (jint)n;
+    }
+    if (i > 0)
+        (*env)->SetIntArrayRegion(env, counts, 0, i, cnt);
+    free(pos);
+
+    if (i > 0)
+        return (*env)->ExceptionCheck(env) ? IOS_THROWN : i;
+    if (error == EINTR)
+        return IOS_INTERRUPTED;
+    errno = error;
+    JNU_ThrowIOExceptionWithLastError(env, "Read failed");
+    return IOS_THROWN;
+}
+
 static jlong
 handle(JNIEnv *env, jlong rv, char *msg)
 {
@@ -784,6 +784,41 @@ Java_sun_nio_fs_UnixNativeDispatcher_readdir(JNIEnv* env, jclass this, jlong val
     }
 }
 
+JNIEXPORT jint JNICALL
+Java_sun_nio_fs_UnixNativeDispatcher_readdirBatch(JNIEnv* env, jclass this,
+    jlong value, jobjectArray names)
+{
+    DIR* dirp = jlong_to_ptr(value);
+    jsize max = (*env)->GetArrayLength(env, names);
+    jint count = 0;
+
+    while (count < max) {
+        struct dirent* ptr;
+        jsize len;
+        jbyteArray bytes;
+
+        errno = 0;
+        ptr = readdir(dirp);
+        if (ptr == NULL) {
+            // report an error with the next call if entries were read
+            if (errno != 0 && count == 0) {
+                throwUnixException(env, errno);
+            }
+            break;
+        }
+        len = strlen(ptr->d_name);
+        bytes = (*env)->NewByteArray(env, len);
+        if (bytes == NULL) {
+            return -1;
+        }
+        (*env)->SetByteArrayRegion(env, bytes, 0, len, (jbyte*)(ptr->d_name));
+        (*env)->SetObjectArrayElement(env, names, count, bytes);
+        (*env)->DeleteLocalRef(env, bytes);
+        count++;
+    }
+    return count;
+}
+
 JNIEXPORT void JNICALL
 Java_sun_nio_fs_UnixNativeDispatcher_mkdir0(JNIEnv* env, jclass this,
     jlong pathAddress, jint mode)
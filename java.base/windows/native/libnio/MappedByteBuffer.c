@@ -99,3 +99,36 @@ Java_java_nio_MappedByteBuffer_force0(JNIEnv *env, jobject obj, jobject fdo,
         JNU_ThrowIOExceptionWithLastError(env, "Flush failed");
     }
 }
+
+JNIEXPORT void JNICALL
+Java_java_nio_MappedByteBuffer_advise0(JNIEnv *env, jobject obj, jlong address,
+                                       jlong len, jint advice)
+{
+    /* No equivalent of madvise, the advice is ignored */
+}
+
+JNIEXPORT void JNICALL
+Java_java_nio_MappedByteBuffer_forceAsync0(JNIEnv *env, jobject obj, jobject fdo,
+                                           jlong address, jlong len)
+{
+    void *a = (void *) jlong_to_ptr(address);
+    BOOL result;
+    int retry;
+
+    /*
+     * FlushViewOfFile only initiates the writing of dirty pages to disk,
+     * which is what is wanted here. Retry on ERROR_LOCK_VIOLATION as in
+     * force0.
+     */
+    retry = 0;
+    do {
+        result = FlushViewOfFile(a, (DWORD)len);
+        if ((result != 0) || (GetLastError() != ERROR_LOCK_VIOLATION))
+            break;
+        retry++;
+    } while (retry < 3);
+
+    if (result == 0) {
+        JNU_ThrowIOExceptionWithLastError(env, "Flush failed");
+    }
+}
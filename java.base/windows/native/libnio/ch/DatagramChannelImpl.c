@@ -236,3 +236,10 @@ Java_sun_nio_ch_DatagramChannelImpl_send0(JNIEnv *env, jobject this,
     }
     return rv;
 }
+
+JNIEXPORT jboolean JNICALL
+Java_sun_nio_ch_DatagramChannelImpl_batchSupported0(JNIEnv *env, jclass clazz)
+{
+    /* receiveBatch0 and sendBatch0 are not used on Windows */
+    return JNI_FALSE;
+}
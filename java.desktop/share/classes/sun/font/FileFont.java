@@ -213,6 +213,16 @@ public abstract class FileFont extends PhysicalFont {
         }
     }
 
+    void getGlyphImages(long pScalerContext, int[] glyphCodes,
+                        long[] images, int len) {
+        try {
+            getScaler().getGlyphImages(pScalerContext, glyphCodes, images, len);
+        } catch (FontScalerException fe) {
+            scaler = FontScaler.getNullScaler();
+            getGlyphImages(pScalerContext, glyphCodes, images, len);
+        }
+    }
+
     Rectangle2D.Float getGlyphOutlineBounds(long pScalerContext, int glyphCode) {
         try {
             return getScaler().getGlyphOutlineBounds(pScalerContext, glyphCode);
@@ -398,6 +398,12 @@ public class FileFontStrike extends PhysicalStrike {
 
     void getGlyphImagePtrs(int[] glyphCodes, long[] images, int  len) {
 
+        /* Glyphs not yet cached are collected and rendered by the scaler
+         * in one call, rather than with a native call per glyph.
+         */
+        int[] missIndices = null;
+        int misses = 0;
+
         for (int i=0; i<len; i++) {
             int glyphCode = glyphCodes[i];
             if (glyphCode >= INVISIBLE_GLYPHS) {
@@ -409,13 +415,33 @@ public class FileFontStrike extends PhysicalStrike {
                 long glyphPtr = 0L;
                 if (useNatives) {
                     glyphPtr = getGlyphImageFromNative(glyphCode);
-                } if (glyphPtr == 0L) {
-                    glyphPtr = fileFont.getGlyphImage(pScalerContext,
-                                                      glyphCode);
+                    if (glyphPtr != 0L) {
+                        images[i] = setCachedGlyphPtr(glyphCode, glyphPtr);
+                        continue;
+                    }
                 }
-                images[i] = setCachedGlyphPtr(glyphCode, glyphPtr);
+                if (missIndices == null) {
+                    missIndices = new int[len - i];
+                }
+                missIndices[misses++] = i;
             }
         }
+
+        if (misses == 0) {
+            return;
+        }
+        int[] missCodes = new int[misses];
+        long[] missPtrs = new long[misses];
+        for (int m=0; m<misses; m++) {
+            missCodes[m] = glyphCodes[missIndices[m]];
+        }
+        fileFont.getGlyphImages(pScalerContext, missCodes, missPtrs, misses);
+        for (int m=0; m<misses; m++) {
+            /* a glyph repeated in the run is rendered more than once, but
+             * setCachedGlyphPtr keeps the first and frees the rest */
+            images[missIndices[m]] =
+                setCachedGlyphPtr(missCodes[m], missPtrs[m]);
+        }
     }
 
     /* The following method is called from CompositeStrike as a special case.
@@ -156,6 +156,20 @@ public abstract class FontScaler implements DisposerRecord {
     abstract long getGlyphImage(long pScalerContext, int glyphCode)
                 throws FontScalerException;
 
+    /*
+     *  Stores pointers to native GlyphInfo objects for the first len
+     *  glyph codes into images, as if by calling getGlyphImage for each.
+     *  Scalers that can render a run of glyphs more cheaply than one
+     *  at a time override this.
+     */
+    void getGlyphImages(long pScalerContext, int[] glyphCodes,
+                        long[] images, int len)
+                throws FontScalerException {
+        for (int i = 0; i < len; i++) {
+            images[i] = getGlyphImage(pScalerContext, glyphCodes[i]);
+        }
+    }
+
     abstract Rectangle2D.Float getGlyphOutlineBounds(long pContext,
                                                      int glyphCode)
                 throws FontScalerException;
@@ -121,6 +121,18 @@ class FreetypeFontScaler extends FontScaler {
             getGlyphImage(0L, glyphCode);
     }
 
+    @Override
+    synchronized void getGlyphImages(long pScalerContext, int[] glyphCodes,
+                                     long[] images, int len)
+                     throws FontScalerException {
+        if (nativeScaler != 0L) {
+            getGlyphImagesNative(font.get(), pScalerContext, nativeScaler,
+                                 glyphCodes, images, len);
+            return;
+        }
+        super.getGlyphImages(pScalerContext, glyphCodes, images, len);
+    }
+
     synchronized Rectangle2D.Float getGlyphOutlineBounds(
                      long pScalerContext, int glyphCode)
                      throws FontScalerException {
@@ -228,6 +240,9 @@ class FreetypeFontScaler extends FontScaler {
             int glyphCode, Point2D.Float metrics);
     private native long getGlyphImageNative(Font2D font,
             long pScalerContext, long pScaler, int glyphCode);
+    private native void getGlyphImagesNative(Font2D font,
+            long pScalerContext, long pScaler,
+            int[] glyphCodes, long[] images, int len);
     private native Rectangle2D.Float getGlyphOutlineBoundsNative(Font2D font,
             long pScalerContext, long pScaler, int glyphCode);
     private native GeneralPath getGlyphOutlineNative(Font2D font,
@@ -27,6 +27,8 @@ package sun.java2d.cmm.lcms;
 
 import java.awt.color.CMMException;
 import java.awt.color.ICC_Profile;
+import java.util.LinkedHashMap;
+import java.util.Map;
 import sun.java2d.cmm.ColorTransform;
 import sun.java2d.cmm.PCMM;
 import sun.java2d.cmm.Profile;
@@ -111,6 +113,7 @@ public class LCMS implements PCMM {
 
         synchronized (profile) {
             profile.clearTagCache();
+            clearTransformCache();
 
             // Now we are going to update the profile with new tag data
             // In some cases, we may change the pointer to the native
@@ -138,6 +141,128 @@ public class LCMS implements PCMM {
 
     public static synchronized native LCMSProfile getProfileID(ICC_Profile profile);
 
+    /*
+     * Native transforms are expensive to build, and a ColorConvertOp makes
+     * a new LCMSTransform on every filter call, so the most recently used
+     * ones are kept here and shared.  A cached transform stays alive as
+     * long as the cache or any LCMSTransform holds its disposer referent.
+     * lcms2 allows a transform to be used by several threads at once.
+     */
+    private static final int TRANSFORM_CACHE_SIZE = 16;
+
+    private static final class TransformKey {
+        private final LCMSProfile[] profiles;
+        private final int renderType;
+        private final int inFormatter;
+        private final boolean isInIntPacked;
+        private final int outFormatter;
+        private final boolean isOutIntPacked;
+        private final int hash;
+
+        TransformKey(LCMSProfile[] profiles, int renderType,
+                     int inFormatter, boolean isInIntPacked,
+                     int outFormatter, boolean isOutIntPacked)
+        {
+            this.profiles = profiles.clone();
+            this.renderType = renderType;
+            this.inFormatter = inFormatter;
+            this.isInIntPacked = isInIntPacked;
+            this.outFormatter = outFormatter;
+            this.isOutIntPacked = isOutIntPacked;
+            int h = renderType;
+            for (LCMSProfile p : profiles) {
+                h = 31 * h + System.identityHashCode(p);
+            }
+            h = 31 * h + inFormatter;
+            h = 31 * h + outFormatter;
+            this.hash = (h << 2) | (isInIntPacked ? 2 : 0) |
+                        (isOutIntPacked ? 1 : 0);
+        }
+
+        @Override
+        public int hashCode() {
+            return hash;
+        }
+
+        @Override
+        public boolean equals(Object o) {
+            if (!(o instanceof TransformKey)) {
+                return false;
+            }
+            TransformKey k = (TransformKey)o;
+            if (k.profiles.length != profiles.length) {
+                return false;
+            }
+            for (int i = 0; i < profiles.length; i++) {
+                // profiles are compared by identity, like their native data
+                if (k.profiles[i] != profiles[i]) {
+                    return false;
+                }
+            }
+            return k.renderType == renderType &&
+                   k.inFormatter == inFormatter &&
+                   k.isInIntPacked == isInIntPacked &&
+                   k.outFormatter == outFormatter &&
+                   k.isOutIntPacked == isOutIntPacked;
+        }
+    }
+
+    static final class CachedTransform {
+        final long ID;
+        final Object disposerRef;
+
+        CachedTransform(long ID, Object disposerRef) {
+            this.ID = ID;
+            this.disposerRef = disposerRef;
+        }
+    }
+
+    private static final Map<TransformKey, CachedTransform> transformCache =
+        new LinkedHashMap<>(TRANSFORM_CACHE_SIZE, 0.75f, true) {
+            @Override
+            protected boolean removeEldestEntry(
+                Map.Entry<TransformKey, CachedTransform> eldest)
+            {
+                return size() > TRANSFORM_CACHE_SIZE;
+            }
+        };
+
+    private static void clearTransformCache() {
+        synchronized (transformCache) {
+            transformCache.clear();
+        }
+    }
+
+    /* Returns a possibly shared native transform, creating it if needed */
+    static CachedTransform getTransform(
+        LCMSProfile[] profiles, int renderType,
+        int inFormatter, boolean isInIntPacked,
+        int outFormatter, boolean isOutIntPacked)
+    {
+        TransformKey key = new TransformKey(profiles, renderType,
+                                            inFormatter, isInIntPacked,
+                                            outFormatter, isOutIntPacked);
+        CachedTransform t;
+        synchronized (transformCache) {
+            t = transformCache.get(key);
+        }
+        if (t != null) {
+            return t;
+        }
+
+        Object disposerRef = new Object();
+        long ID = createTransform(profiles, renderType,
+                                  inFormatter, isInIntPacked,
+                                  outFormatter, isOutIntPacked,
+                                  disposerRef);
+        t = new CachedTransform(ID, disposerRef);
+        synchronized (transformCache) {
+            CachedTransform raced = transformCache.putIfAbsent(key, t);
+            // a transform created concurrently is simply left to the Disposer
+            return (raced != null) ? raced : t;
+        }
+    }
+
     /* Helper method used from LCMSColorTransfrom */
     static long createTransform(
         LCMSProfile[] profiles, int renderType,
@@ -64,7 +64,7 @@ public class LCMSTransform implements ColorTransform {
     private int numInComponents = -1;
     private int numOutComponents = -1;
 
-    private Object disposerReferent = new Object();
+    private Object disposerReferent;
 
     /* the class initializer */
     static {
@@ -137,20 +137,20 @@ public class LCMSTransform implements ColorTransform {
             outFormatter != out.pixelType || isOutIntPacked != out.isIntPacked)
         {
 
-            if (ID != 0L) {
-                // Disposer will destroy forgotten transform
-                disposerReferent = new Object();
-            }
             inFormatter = in.pixelType;
             isInIntPacked = in.isIntPacked;
 
             outFormatter = out.pixelType;
             isOutIntPacked = out.isIntPacked;
 
-            ID = LCMS.createTransform(lcmsProfiles, renderType,
-                                            inFormatter, isInIntPacked,
-                                            outFormatter, isOutIntPacked,
-                                            disposerReferent);
+            // Holding the referent keeps the shared transform alive; the
+            // Disposer will destroy it once it is forgotten everywhere
+            LCMS.CachedTransform t =
+                LCMS.getTransform(lcmsProfiles, renderType,
+                                  inFormatter, isInIntPacked,
+                                  outFormatter, isOutIntPacked);
+            disposerReferent = t.disposerRef;
+            ID = t.ID;
         }
 
         LCMS.colorConvert(this, in, out);
@@ -93,6 +93,7 @@ typedef struct {
     int lowSegment;             /* lower limit of segments in active range */
     int curSegment;             /* index of next active segment to return */
     int hiSegment;              /* upper limit of segments in active range */
+    jint rowhiy;                /* high Y of the current row of spans */
 
     segmentData **segmentTable; /* pointers to segments being stepped */
 } pathData;
@@ -1250,7 +1251,8 @@ ShapeSINextSpan(void *state, jint spanbox[])
     int lo, cur, new, hi;
     int num = pd->numSegments;
     jint x0, x1, y0, err;
-    jint loy;
+    jint loy, rowhiy;
+    jboolean vertical;
     int ret = JNI_FALSE;
     segmentData **segmentTable;
     segmentData *seg;
@@ -1268,6 +1270,7 @@ ShapeSINextSpan(void *state, jint spanbox[])
     hi = pd->hiSegment;
     num = pd->numSegments;
     loy = pd->loy;
+    rowhiy = pd->rowhiy;
     segmentTable = pd->segmentTable;
 
     while (lo < num) {
@@ -1282,30 +1285,37 @@ ShapeSINextSpan(void *state, jint spanbox[])
                 x0 = pd->lox;
             }
 
-            if (pd->evenodd) {
-                cur += 2;
-                if (cur <= hi) {
-                    x1 = segmentTable[cur - 1]->curx;
-                } else {
-                    x1 = pd->hix;
-                }
-            } else {
-                int wind = seg->windDir;
-                cur++;
-
-                while (JNI_TRUE) {
-                    if (cur >= hi) {
+            /*
+             * Keep extending the span while the next span on this
+             * row starts exactly where the current one ends so that
+             * abutting pieces are delivered as a single span.
+             */
+            do {
+                if (pd->evenodd) {
+                    cur += 2;
+                    if (cur <= hi) {
+                        x1 = segmentTable[cur - 1]->curx;
+                    } else {
                         x1 = pd->hix;
-                        break;
                     }
-                    seg = segmentTable[cur++];
-                    wind += seg->windDir;
-                    if (wind == 0) {
-                        x1 = seg->curx;
-                        break;
+                } else {
+                    int wind = segmentTable[cur++]->windDir;
+
+                    while (JNI_TRUE) {
+                        if (cur >= hi) {
+                            x1 = pd->hix;
+                            break;
+                        }
+                        seg = segmentTable[cur++];
+                        wind += seg->windDir;
+                        if (wind == 0) {
+                            x1 = seg->curx;
+                            break;
+                        }
                     }
                 }
-            }
+            } while (cur < hi && x1 < pd->hix &&
+                     segmentTable[cur]->curx <= x1);
 
             if (x1 > pd->hix) {
                 x1 = pd->hix;
@@ -1316,12 +1326,13 @@ ShapeSINextSpan(void *state, jint spanbox[])
             spanbox[0] = x0;
             spanbox[1] = loy;
             spanbox[2] = x1;
-            spanbox[3] = loy + 1;
+            spanbox[3] = rowhiy;
             ret = JNI_TRUE;
             break;
         }
 
-        if (++loy >= pd->hiy) {
+        loy = rowhiy;
+        if (loy >= pd->hiy) {
             lo = cur = hi = num;
             break;
         }
@@ -1354,8 +1365,12 @@ ShapeSINextSpan(void *state, jint spanbox[])
         }
 
         /* Update and sort the active segments by x0 */
+        vertical = JNI_TRUE;
         for (cur = lo; cur < hi; cur++) {
             seg = segmentTable[cur];
+            if (seg->bumpx != 0 || seg->bumperr != 0) {
+                vertical = JNI_FALSE;
+            }
 
             /* First update the x0, y0 of the segment */
             x0 = seg->curx;
@@ -1390,12 +1405,32 @@ ShapeSINextSpan(void *state, jint spanbox[])
             segmentTable[new] = seg;
         }
         cur = lo;
+
+        /*
+         * If every active edge runs straight down then the spans
+         * on this row repeat unchanged until one of those edges
+         * ends or a new edge starts, so deliver them once for the
+         * whole band of rows rather than once per scanline.
+         */
+        rowhiy = loy + 1;
+        if (vertical && lo < hi) {
+            rowhiy = pd->hiy;
+            if (hi < num && segmentTable[hi]->cury < rowhiy) {
+                rowhiy = segmentTable[hi]->cury;
+            }
+            for (new = lo; new < hi; new++) {
+                if (segmentTable[new]->lasty < rowhiy) {
+                    rowhiy = segmentTable[new]->lasty;
+                }
+            }
+        }
     }
 
     pd->lowSegment = lo;
     pd->hiSegment = hi;
     pd->curSegment = cur;
     pd->loy = loy;
+    pd->rowhiy = rowhiy;
     return ret;
 }
 
@@ -1412,10 +1447,14 @@ ShapeSISkipDownTo(void *private, jint y)
         }
     }
 
-    /* Make sure we are jumping forward */
-    if (pd->loy < y) {
+    /*
+     * Make sure we are jumping forward and past the whole band
+     * of rows covered by the spans currently being returned
+     */
+    if (pd->rowhiy <= y) {
         /* Pretend like we just finished with the span line y-1... */
         pd->loy = y - 1;
+        pd->rowhiy = y;
         pd->curSegment = pd->hiSegment; /* no more segments on that line */
     }
 }
@@ -1448,6 +1487,7 @@ initSegmentTable(pathData *pd)
     pd->lowSegment = pd->curSegment = pd->hiSegment = cur;
 
     /* Prepare for next action to increment loy and prepare new segments */
+    pd->rowhiy = pd->loy;
     pd->loy--;
 
     return JNI_TRUE;
@@ -740,15 +740,9 @@ static void CopyFTSubpixelVToSubpixel(const void* srcImage, int srcRowBytes,
 }
 
 
-/*
- * Class:     sun_font_FreetypeFontScaler
- * Method:    getGlyphImageNative
- * Signature: (Lsun/font/Font2D;JI)J
- */
-JNIEXPORT jlong JNICALL
-Java_sun_font_FreetypeFontScaler_getGlyphImageNative(
-        JNIEnv *env, jobject scaler, jobject font2D,
-        jlong pScalerContext, jlong pScaler, jint glyphCode) {
+/* Renders one glyph; the FreeType context must already be set up */
+static GlyphInfo* renderGlyphImage(FTScalerContext* context,
+                                   FTScalerInfo *scalerInfo, jint glyphCode) {
 
     int error, imageSize;
     UInt16 width, height;
@@ -756,21 +750,6 @@ Java_sun_font_FreetypeFontScaler_getGlyphImageNative(
     int renderFlags = FT_LOAD_DEFAULT, target;
     FT_GlyphSlot ftglyph;
 
-    FTScalerContext* context =
-        (FTScalerContext*) jlong_to_ptr(pScalerContext);
-    FTScalerInfo *scalerInfo =
-             (FTScalerInfo*) jlong_to_ptr(pScaler);
-
-    if (isNullScalerContext(context) || scalerInfo == NULL) {
-        return ptr_to_jlong(getNullGlyphImage());
-    }
-
-    error = setupFTContext(env, font2D, scalerInfo, context);
-    if (error) {
-        invalidateJavaScaler(env, scaler, scalerInfo);
-        return ptr_to_jlong(getNullGlyphImage());
-    }
-
     if (!context->useSbits) {
         renderFlags |= FT_LOAD_NO_BITMAP;
     }
@@ -797,7 +776,7 @@ Java_sun_font_FreetypeFontScaler_getGlyphImageNative(
     if (error) {
         //do not destroy scaler yet.
         //this can be problem of particular context (e.g. with bad transform)
-        return ptr_to_jlong(getNullGlyphImage());
+        return getNullGlyphImage();
     }
 
     ftglyph = scalerInfo->face->glyph;
@@ -815,7 +794,7 @@ Java_sun_font_FreetypeFontScaler_getGlyphImageNative(
     if (ftglyph->format == FT_GLYPH_FORMAT_OUTLINE) {
         error = FT_Render_Glyph(ftglyph, FT_LOAD_TARGET_MODE(target));
         if (error != 0) {
-            return ptr_to_jlong(getNullGlyphImage());
+            return getNullGlyphImage();
         }
     }
 
@@ -825,8 +804,7 @@ Java_sun_font_FreetypeFontScaler_getGlyphImageNative(
     imageSize = width*height;
     glyphInfo = (GlyphInfo*) malloc(sizeof(GlyphInfo) + imageSize);
     if (glyphInfo == NULL) {
-        glyphInfo = getNullGlyphImage();
-        return ptr_to_jlong(glyphInfo);
+        return getNullGlyphImage();
     }
     glyphInfo->cellInfo  = NULL;
     glyphInfo->managed   = UNMANAGED_GLYPH;
@@ -912,7 +890,89 @@ Java_sun_font_FreetypeFontScaler_getGlyphImageNative(
         }
     }
 
-    return ptr_to_jlong(glyphInfo);
+    return glyphInfo;
+}
+
+/*
+ * Class:     sun_font_FreetypeFontScaler
+ * Method:    getGlyphImageNative
+ * Signature: (Lsun/font/Font2D;JI)J
+ */
+JNIEXPORT jlong JNICALL
+Java_sun_font_FreetypeFontScaler_getGlyphImageNative(
+        JNIEnv *env, jobject scaler, jobject font2D,
+        jlong pScalerContext, jlong pScaler, jint glyphCode) {
+
+    int error;
+    FTScalerContext* context =
+        (FTScalerContext*) jlong_to_ptr(pScalerContext);
+    FTScalerInfo *scalerInfo =
+             (FTScalerInfo*) jlong_to_ptr(pScaler);
+
+    if (isNullScalerContext(context) || scalerInfo == NULL) {
+        return ptr_to_jlong(getNullGlyphImage());
+    }
+
+    error = setupFTContext(env, font2D, scalerInfo, context);
+    if (error) {
+        invalidateJavaScaler(env, scaler, scalerInfo);
+        return ptr_to_jlong(getNullGlyphImage());
+    }
+
+    return ptr_to_jlong(renderGlyphImage(context, scalerInfo, glyphCode));
+}
+
+/*
+ * Class:     sun_font_FreetypeFontScaler
+ * Method:    getGlyphImagesNative
+ * Signature: (Lsun/font/Font2D;JJ[I[JI)V
+ *
+ * Renders a run of glyphs with a single context setup. Each entry of
+ * images receives a GlyphInfo pointer, as from getGlyphImageNative.
+ */
+JNIEXPORT void JNICALL
+Java_sun_font_FreetypeFontScaler_getGlyphImagesNative(
+        JNIEnv *env, jobject scaler, jobject font2D,
+        jlong pScalerContext, jlong pScaler,
+        jintArray glyphCodes, jlongArray images, jint len) {
+
+    int error, i;
+    jint *codes;
+    jlong *ptrs;
+    FTScalerContext* context =
+        (FTScalerContext*) jlong_to_ptr(pScalerContext);
+    FTScalerInfo *scalerInfo =
+             (FTScalerInfo*) jlong_to_ptr(pScaler);
+
+    codes = (jint*) malloc(len * (sizeof(jint) + sizeof(jlong)));
+    if (codes == NULL) {
+        JNU_ThrowOutOfMemoryError(env, "glyph image batch");
+        return;
+    }
+    ptrs = (jlong*) (codes + len);
+    (*env)->GetIntArrayRegion(env, glyphCodes, 0, len, codes);
+    if ((*env)->ExceptionCheck(env)) {
+        free(codes);
+        return;
+    }
+
+    if (isNullScalerContext(context) || scalerInfo == NULL) {
+        error = 1;
+    } else {
+        error = setupFTContext(env, font2D, scalerInfo, context);
+        if (error) {
+            invalidateJavaScaler(env, scaler, scalerInfo);
+        }
+    }
+
+    for (i = 0; i < len; i++) {
+        GlyphInfo *glyphInfo = error ? getNullGlyphImage() :
+            renderGlyphImage(context, scalerInfo, codes[i]);
+        ptrs[i] = ptr_to_jlong(glyphInfo);
+    }
+
+    (*env)->SetLongArrayRegion(env, images, 0, len, ptrs);
+    free(codes);
 }
 
 /*
@@ -16,6 +16,12 @@
 #include "jinclude.h"
 #include "jpeglib.h"
 
+/* SSE2 is part of every x86-64 target, so needs no run-time check */
+#if BITS_IN_JSAMPLE == 8 && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define YCC_RGB_SSE2
+#endif
+
 
 /* Private subobject */
 
@@ -109,6 +115,69 @@ build_ycc_rgb_table (j_decompress_ptr cinfo)
 }
 
 
+#ifdef YCC_RGB_SSE2
+
+/*
+ * Convert groups of 8 pixels of one row with SSE2, returning the number of
+ * pixels done.  The results are identical to the table-driven loop below:
+ * each constant that does not fit a signed 16-bit multiplier is split into
+ * a multiple of 2^16, applied as a plain add of x after the shift, and a
+ * 16-bit remainder, applied with pmaddwd.  packuswb saturates exactly as
+ * range_limit does for the values that can occur here.
+ */
+
+LOCAL(JDIMENSION)
+ycc_rgb_convert_sse2 (JSAMPROW inptr0, JSAMPROW inptr1, JSAMPROW inptr2,
+                      JSAMPROW outptr, JDIMENSION num_cols)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i center = _mm_set1_epi16(CENTERJSAMPLE);
+  const __m128i half = _mm_set1_epi32(ONE_HALF);
+  /* 1.40200 = 1 + 26345/2^16 */
+  const __m128i r_mul = _mm_set1_epi32(26345);
+  /* 1.77200 = 2 - 14942/2^16 */
+  const __m128i b_mul = _mm_set1_epi32(-14942 & 0xFFFF);
+  /* -0.34414 * Cb - 0.71414 * Cr = -22554/2^16 * Cb + (18734/2^16 - 1) * Cr */
+  const __m128i g_mul = _mm_set1_epi32((18734 << 16) | (-22554 & 0xFFFF));
+  JSAMPLE r[8], g[8], b[8];
+  JDIMENSION col, i;
+
+  for (col = 0; col + 8 <= num_cols; col += 8) {
+    __m128i y  = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (inptr0 + col)), zero);
+    __m128i cb = _mm_sub_epi16(_mm_unpacklo_epi8(
+                   _mm_loadl_epi64((const __m128i *) (inptr1 + col)), zero), center);
+    __m128i cr = _mm_sub_epi16(_mm_unpacklo_epi8(
+                   _mm_loadl_epi64((const __m128i *) (inptr2 + col)), zero), center);
+    __m128i lo, hi, v;
+
+    lo = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(cr, zero), r_mul), half), SCALEBITS);
+    hi = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(cr, zero), r_mul), half), SCALEBITS);
+    v = _mm_add_epi16(_mm_add_epi16(_mm_packs_epi32(lo, hi), cr), y);
+    _mm_storel_epi64((__m128i *) r, _mm_packus_epi16(v, v));
+
+    lo = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(cb, cr), g_mul), half), SCALEBITS);
+    hi = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(cb, cr), g_mul), half), SCALEBITS);
+    v = _mm_add_epi16(_mm_sub_epi16(_mm_packs_epi32(lo, hi), cr), y);
+    _mm_storel_epi64((__m128i *) g, _mm_packus_epi16(v, v));
+
+    lo = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(cb, zero), b_mul), half), SCALEBITS);
+    hi = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(cb, zero), b_mul), half), SCALEBITS);
+    v = _mm_add_epi16(_mm_add_epi16(_mm_packs_epi32(lo, hi), _mm_add_epi16(cb, cb)), y);
+    _mm_storel_epi64((__m128i *) b, _mm_packus_epi16(v, v));
+
+    for (i = 0; i < 8; i++) {
+      outptr[RGB_RED] = r[i];
+      outptr[RGB_GREEN] = g[i];
+      outptr[RGB_BLUE] = b[i];
+      outptr += RGB_PIXELSIZE;
+    }
+  }
+  return col;
+}
+
+#endif /* YCC_RGB_SSE2 */
+
+
 /*
  * Convert some rows of samples to the output colorspace.
  *
@@ -145,7 +214,13 @@ ycc_rgb_convert (j_decompress_ptr cinfo,
     inptr2 = input_buf[2][input_row];
     input_row++;
     outptr = *output_buf++;
-    for (col = 0; col < num_cols; col++) {
+#ifdef YCC_RGB_SSE2
+    col = ycc_rgb_convert_sse2(inptr0, inptr1, inptr2, outptr, num_cols);
+    outptr += col * RGB_PIXELSIZE;
+#else
+    col = 0;
+#endif
+    for (; col < num_cols; col++) {
       y  = GETJSAMPLE(inptr0[col]);
       cb = GETJSAMPLE(inptr1[col]);
       cr = GETJSAMPLE(inptr2[col]);
@@ -270,7 +345,13 @@ ycck_cmyk_convert (j_decompress_ptr cinfo,
     inptr3 = input_buf[3][input_row];
     input_row++;
     outptr = *output_buf++;
-    for (col = 0; col < num_cols; col++) {
+#ifdef YCC_RGB_SSE2
+    col = ycc_rgb_convert_sse2(inptr0, inptr1, inptr2, outptr, num_cols);
+    outptr += col * RGB_PIXELSIZE;
+#else
+    col = 0;
+#endif
+    for (; col < num_cols; col++) {
       y  = GETJSAMPLE(inptr0[col]);
       cb = GETJSAMPLE(inptr1[col]);
       cr = GETJSAMPLE(inptr2[col]);
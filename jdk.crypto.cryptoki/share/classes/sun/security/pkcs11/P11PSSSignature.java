@@ -257,7 +257,8 @@ final class P11PSSSignature extends SignatureSpi {
                     byte[] digest =
                         (md == null? new byte[0] : md.digest());
                     if (DEBUG) System.out.println(" by C_Sign");
-                    token.p11.C_Sign(session.id(), digest);
+                    token.p11.C_Sign(session.id(), 0, digest, 0,
+                            digest.length);
                 }
             } catch (PKCS11Exception e) {
                 throw new ProviderException("cancel failed", e);
@@ -273,7 +274,8 @@ final class P11PSSSignature extends SignatureSpi {
                     byte[] digest =
                         (md == null? new byte[0] : md.digest());
                     if (DEBUG) System.out.println(" by C_Verify");
-                    token.p11.C_Verify(session.id(), digest, signature);
+                    token.p11.C_Verify(session.id(), 0, digest, 0,
+                            digest.length, signature);
                 }
             } catch (PKCS11Exception e) {
                 // will fail since the signature is incorrect
@@ -609,7 +611,8 @@ final class P11PSSSignature extends SignatureSpi {
                 }
                 byte[] digest = md.digest();
                 if (DEBUG) System.out.println(" by C_Sign");
-                signature = token.p11.C_Sign(session.id(), digest);
+                signature = token.p11.C_Sign(session.id(), 0, digest, 0,
+                        digest.length);
             }
             doCancel = false;
             return signature;
@@ -639,7 +642,8 @@ final class P11PSSSignature extends SignatureSpi {
                 }
                 byte[] digest = md.digest();
                 if (DEBUG) System.out.println(" by C_Verify");
-                token.p11.C_Verify(session.id(), digest, signature);
+                token.p11.C_Verify(session.id(), 0, digest, 0,
+                        digest.length, signature);
             }
             doCancel = false;
             return true;
@@ -282,7 +282,7 @@ final class P11RSACipher extends CipherSpi {
                     break;
                 case MODE_SIGN:
                     byte[] tmpBuffer = new byte[maxInputSize];
-                    p11.C_Sign(sessId, tmpBuffer);
+                    p11.C_Sign(sessId, 0, tmpBuffer, 0, tmpBuffer.length);
                     break;
                 case MODE_VERIFY:
                     p11.C_VerifyRecover(sessId, buffer, 0, inLen, buffer,
@@ -379,9 +379,8 @@ final class P11RSACipher extends CipherSpi {
                         (session.id(), 0, buffer, 0, bufOfs, 0, out, outOfs, outLen);
                 break;
             case MODE_SIGN:
-                byte[] tmpBuffer = new byte[bufOfs];
-                System.arraycopy(buffer, 0, tmpBuffer, 0, bufOfs);
-                tmpBuffer = p11.C_Sign(session.id(), tmpBuffer);
+                byte[] tmpBuffer =
+                        p11.C_Sign(session.id(), 0, buffer, 0, bufOfs);
                 if (tmpBuffer.length > outLen) {
                     throw new BadPaddingException(
                         "Output buffer (" + outLen + ") is too small to " +
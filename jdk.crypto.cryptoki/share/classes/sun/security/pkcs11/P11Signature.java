@@ -303,7 +303,8 @@ final class P11Signature extends SignatureSpi {
                         } else { // T_RAW
                             digest = buffer;
                         }
-                        token.p11.C_Sign(session.id(), digest);
+                        token.p11.C_Sign(session.id(), 0, digest, 0,
+                                digest.length);
                     }
                 } catch (PKCS11Exception e) {
                     throw new ProviderException("cancel failed", e);
@@ -325,7 +326,8 @@ final class P11Signature extends SignatureSpi {
                         } else { // T_RAW
                             digest = buffer;
                         }
-                        token.p11.C_Verify(session.id(), digest, signature);
+                        token.p11.C_Verify(session.id(), 0, digest, 0,
+                                digest.length, signature);
                     }
                 } catch (PKCS11Exception e) {
                     long errorCode = e.getErrorCode();
@@ -634,8 +636,10 @@ final class P11Signature extends SignatureSpi {
                 signature = token.p11.C_SignFinal(session.id(), len);
             } else {
                 byte[] digest;
+                int digestLen;
                 if (type == T_DIGEST) {
                     digest = md.digest();
+                    digestLen = digest.length;
                 } else { // T_RAW
                     if (mechanism == CKM_DSA) {
                         if (bytesProcessed != buffer.length) {
@@ -643,24 +647,28 @@ final class P11Signature extends SignatureSpi {
                             ("Data for RawDSA must be exactly 20 bytes long");
                         }
                         digest = buffer;
+                        digestLen = buffer.length;
                     } else { // CKM_ECDSA
                         if (bytesProcessed > buffer.length) {
                             throw new SignatureException("Data for NONEwithECDSA"
                             + " must be at most " + RAW_ECDSA_MAX + " bytes long");
                         }
-                        digest = new byte[bytesProcessed];
-                        System.arraycopy(buffer, 0, digest, 0, bytesProcessed);
+                        // pass the data in place, no need to trim buffer
+                        digest = buffer;
+                        digestLen = bytesProcessed;
                     }
                 }
                 if (keyAlgorithm.equals("RSA") == false) {
                     // DSA and ECDSA
-                    signature = token.p11.C_Sign(session.id(), digest);
+                    signature = token.p11.C_Sign(session.id(), 0, digest, 0,
+                            digestLen);
                 } else { // RSA
                     byte[] data = encodeSignature(digest);
                     if (mechanism == CKM_RSA_X_509) {
                         data = pkcs1Pad(data);
                     }
-                    signature = token.p11.C_Sign(session.id(), data);
+                    signature = token.p11.C_Sign(session.id(), 0, data, 0,
+                            data.length);
                 }
             }
             doCancel = false;
@@ -702,8 +710,10 @@ final class P11Signature extends SignatureSpi {
                 token.p11.C_VerifyFinal(session.id(), signature);
             } else {
                 byte[] digest;
+                int digestLen;
                 if (type == T_DIGEST) {
                     digest = md.digest();
+                    digestLen = digest.length;
                 } else { // T_RAW
                     if (mechanism == CKM_DSA) {
                         if (bytesProcessed != buffer.length) {
@@ -711,24 +721,28 @@ final class P11Signature extends SignatureSpi {
                             ("Data for RawDSA must be exactly 20 bytes long");
                         }
                         digest = buffer;
+                        digestLen = buffer.length;
                     } else {
                         if (bytesProcessed > buffer.length) {
                             throw new SignatureException("Data for NONEwithECDSA"
                             + " must be at most " + RAW_ECDSA_MAX + " bytes long");
                         }
-                        digest = new byte[bytesProcessed];
-                        System.arraycopy(buffer, 0, digest, 0, bytesProcessed);
+                        // pass the data in place, no need to trim buffer
+                        digest = buffer;
+                        digestLen = bytesProcessed;
                     }
                 }
                 if (keyAlgorithm.equals("RSA") == false) {
                     // DSA and ECDSA
-                    token.p11.C_Verify(session.id(), digest, signature);
+                    token.p11.C_Verify(session.id(), 0, digest, 0,
+                            digestLen, signature);
                 } else { // RSA
                     byte[] data = encodeSignature(digest);
                     if (mechanism == CKM_RSA_X_509) {
                         data = pkcs1Pad(data);
                     }
-                    token.p11.C_Verify(session.id(), data, signature);
+                    token.p11.C_Verify(session.id(), 0, data, 0,
+                            data.length, signature);
                 }
             }
             doCancel = false;
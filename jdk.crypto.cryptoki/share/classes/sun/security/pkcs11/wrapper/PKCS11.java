@@ -1031,17 +1031,20 @@ public class PKCS11 {
      *
      * @param hSession the session's handle
      *         (PKCS#11 param: CK_SESSION_HANDLE hSession)
-     * @param pData the data to sign and the data's length
+     * @param directIn the address of the data to sign
+     * @param in buffer containing the data to sign
+     * @param inOfs buffer offset of the data to sign
+     * @param inLen length of the data to sign
      *         (PKCS#11 param: CK_BYTE_PTR pData, CK_ULONG ulDataLen)
      * @return the signature and the signature's length
      *         (PKCS#11 param: CK_BYTE_PTR pSignature,
      *                         CK_ULONG_PTR pulSignatureLen)
      * @exception PKCS11Exception If function returns other value than CKR_OK.
-     * @preconditions (pData <> null)
+     * @preconditions (directIn <> 0) or (in <> null)
      * @postconditions (result <> null)
      */
-    public native byte[] C_Sign(long hSession, byte[] pData)
-            throws PKCS11Exception;
+    public native byte[] C_Sign(long hSession, long directIn, byte[] in,
+            int inOfs, int inLen) throws PKCS11Exception;
 
 
     /**
@@ -1154,16 +1157,19 @@ public class PKCS11 {
      *
      * @param hSession the session's handle
      *         (PKCS#11 param: CK_SESSION_HANDLE hSession)
-     * @param pData the signed data and the signed data's length
+     * @param directIn the address of the signed data
+     * @param in buffer containing the signed data
+     * @param inOfs buffer offset of the signed data
+     * @param inLen length of the signed data
      *         (PKCS#11 param: CK_BYTE_PTR pData, CK_ULONG ulDataLen)
      * @param pSignature the signature to verify and the signature's length
      *         (PKCS#11 param: CK_BYTE_PTR pSignature, CK_ULONG ulSignatureLen)
      * @exception PKCS11Exception If function returns other value than CKR_OK.
-     * @preconditions (pData <> null) and (pSignature <> null)
+     * @preconditions ((directIn <> 0) or (in <> null)) and (pSignature <> null)
      * @postconditions
      */
-    public native void C_Verify(long hSession, byte[] pData, byte[] pSignature)
-            throws PKCS11Exception;
+    public native void C_Verify(long hSession, long directIn, byte[] in,
+            int inOfs, int inLen, byte[] pSignature) throws PKCS11Exception;
 
 
     /**
@@ -1809,9 +1815,9 @@ static class SynchronizedPKCS11 extends PKCS11 {
         super.C_SignInit(hSession, pMechanism, hKey);
     }
 
-    public synchronized byte[] C_Sign(long hSession, byte[] pData)
-            throws PKCS11Exception {
-        return super.C_Sign(hSession, pData);
+    public synchronized byte[] C_Sign(long hSession, long directIn,
+            byte[] in, int inOfs, int inLen) throws PKCS11Exception {
+        return super.C_Sign(hSession, directIn, in, inOfs, inLen);
     }
 
     public synchronized void C_SignUpdate(long hSession, long directIn,
@@ -1841,9 +1847,10 @@ static class SynchronizedPKCS11 extends PKCS11 {
         super.C_VerifyInit(hSession, pMechanism, hKey);
     }
 
-    public synchronized void C_Verify(long hSession, byte[] pData,
-            byte[] pSignature) throws PKCS11Exception {
-        super.C_Verify(hSession, pData, pSignature);
+    public synchronized void C_Verify(long hSession, long directIn,
+            byte[] in, int inOfs, int inLen, byte[] pSignature)
+            throws PKCS11Exception {
+        super.C_Verify(hSession, directIn, in, inOfs, inLen, pSignature);
     }
 
     public synchronized void C_VerifyUpdate(long hSession, long directIn,
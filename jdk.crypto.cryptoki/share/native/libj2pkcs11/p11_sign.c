@@ -98,11 +98,51 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1SignInit
 }
 #endif
 
+#if defined(P11_ENABLE_C_SIGN) || defined(P11_ENABLE_C_VERIFY)
+/*
+ * Returns a pointer to the jInLen bytes of single-part input. Direct
+ * buffers are passed through as is; array input is copied into the
+ * caller's stack buffer if it fits and into a heap buffer otherwise.
+ * The result must be released with releaseInBuffer. Returns NULL with
+ * a pending exception on failure.
+ */
+static CK_BYTE_PTR getInBuffer(JNIEnv *env, jlong directIn, jbyteArray jIn,
+        jint jInOfs, jint jInLen, CK_BYTE_PTR stackBuf)
+{
+    CK_BYTE_PTR inBufP;
+
+    if (directIn != 0) {
+        return (CK_BYTE_PTR) jlong_to_ptr(directIn);
+    }
+    if (jInLen <= MAX_STACK_BUFFER_LEN) {
+        inBufP = stackBuf;
+    } else {
+        inBufP = (CK_BYTE_PTR) malloc((size_t)jInLen);
+        if (inBufP == NULL) {
+            throwOutOfMemoryError(env, 0);
+            return NULL;
+        }
+    }
+    (*env)->GetByteArrayRegion(env, jIn, jInOfs, jInLen, (jbyte *)inBufP);
+    if ((*env)->ExceptionCheck(env)) {
+        if (inBufP != stackBuf) { free(inBufP); }
+        return NULL;
+    }
+    return inBufP;
+}
+
+static void releaseInBuffer(jlong directIn, CK_BYTE_PTR inBufP,
+        CK_BYTE_PTR stackBuf)
+{
+    if (directIn == 0 && inBufP != stackBuf) { free(inBufP); }
+}
+#endif
+
 #ifdef P11_ENABLE_C_SIGN
 /*
  * Class:     sun_security_pkcs11_wrapper_PKCS11
  * Method:    C_Sign
- * Signature: (J[BI)[B
+ * Signature: (JJ[BII)[B
  * Parametermapping:                    *PKCS11*
  * @param   jlong jSessionHandle        CK_SESSION_HANDLE hSession
  * @param   jbyteArray jData            CK_BYTE_PTR pData
@@ -111,11 +151,12 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1SignInit
  *                                      CK_ULONG_PTR pulSignatureLen
  */
 JNIEXPORT jbyteArray JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Sign
-    (JNIEnv *env, jobject obj, jlong jSessionHandle, jbyteArray jData)
+    (JNIEnv *env, jobject obj, jlong jSessionHandle, jlong directIn,
+     jbyteArray jIn, jint jInOfs, jint jInLen)
 {
     CK_SESSION_HANDLE ckSessionHandle;
-    CK_BYTE_PTR ckpData = NULL_PTR;
-    CK_ULONG ckDataLength;
+    CK_BYTE_PTR inBufP;
+    CK_BYTE INBUF[MAX_STACK_BUFFER_LEN];
     CK_BYTE_PTR bufP;
     CK_ULONG ckSignatureLength;
     CK_BYTE BUF[MAX_STACK_BUFFER_LEN];
@@ -128,19 +169,28 @@ JNIEXPORT jbyteArray JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Sign
     TRACE0("DEBUG: C_Sign\n");
 
     ckSessionHandle = jLongToCKULong(jSessionHandle);
-    jByteArrayToCKByteArray(env, jData, &ckpData, &ckDataLength);
-    if ((*env)->ExceptionCheck(env)) {
+    inBufP = getInBuffer(env, directIn, jIn, jInOfs, jInLen, INBUF);
+    if (inBufP == NULL) {
         return NULL;
     }
 
-    TRACE1("DEBUG C_Sign: data length = %lu\n", ckDataLength);
+    TRACE1("DEBUG C_Sign: data length = %d\n", jInLen);
 
     // unknown signature length
     bufP = BUF;
     ckSignatureLength = MAX_STACK_BUFFER_LEN;
 
-    rv = (*ckpFunctions->C_Sign)(ckSessionHandle, ckpData, ckDataLength,
+    rv = (*ckpFunctions->C_Sign)(ckSessionHandle, inBufP, jInLen,
         bufP, &ckSignatureLength);
+    if (rv == CKR_BUFFER_TOO_SMALL) {
+        bufP = (CK_BYTE_PTR) malloc(ckSignatureLength);
+        if (bufP == NULL) {
+            throwOutOfMemoryError(env, 0);
+            goto cleanup;
+        }
+        rv = (*ckpFunctions->C_Sign)(ckSessionHandle, inBufP, jInLen,
+            bufP, &ckSignatureLength);
+    }
 
     TRACE1("DEBUG C_Sign: ret rv=0x%lX\n", rv);
 
@@ -149,7 +199,8 @@ JNIEXPORT jbyteArray JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Sign
         TRACE1("DEBUG C_Sign: signature length = %lu\n", ckSignatureLength);
     }
 
-    free(ckpData);
+cleanup:
+    releaseInBuffer(directIn, inBufP, INBUF);
     if (bufP != BUF) { free(bufP); }
 
     TRACE0("FINISHED\n");
@@ -424,7 +475,7 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1VerifyInit
 /*
  * Class:     sun_security_pkcs11_wrapper_PKCS11
  * Method:    C_Verify
- * Signature: (J[B[B)V
+ * Signature: (JJ[BII[B)V
  * Parametermapping:                    *PKCS11*
  * @param   jlong jSessionHandle        CK_SESSION_HANDLE hSession
  * @param   jbyteArray jData            CK_BYTE_PTR pData
@@ -433,12 +484,13 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1VerifyInit
  *                                      CK_ULONG_PTR pulSignatureLen
  */
 JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Verify
-    (JNIEnv *env, jobject obj, jlong jSessionHandle, jbyteArray jData, jbyteArray jSignature)
+    (JNIEnv *env, jobject obj, jlong jSessionHandle, jlong directIn,
+     jbyteArray jIn, jint jInOfs, jint jInLen, jbyteArray jSignature)
 {
     CK_SESSION_HANDLE ckSessionHandle;
-    CK_BYTE_PTR ckpData = NULL_PTR;
+    CK_BYTE_PTR inBufP;
+    CK_BYTE INBUF[MAX_STACK_BUFFER_LEN];
     CK_BYTE_PTR ckpSignature = NULL_PTR;
-    CK_ULONG ckDataLength;
     CK_ULONG ckSignatureLength;
     CK_RV rv = 0;
 
@@ -447,8 +499,8 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Verify
 
     ckSessionHandle = jLongToCKULong(jSessionHandle);
 
-    jByteArrayToCKByteArray(env, jData, &ckpData, &ckDataLength);
-    if ((*env)->ExceptionCheck(env)) {
+    inBufP = getInBuffer(env, directIn, jIn, jInOfs, jInLen, INBUF);
+    if (inBufP == NULL) {
         return;
     }
 
@@ -458,10 +510,10 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Verify
     }
 
     /* verify the signature */
-    rv = (*ckpFunctions->C_Verify)(ckSessionHandle, ckpData, ckDataLength, ckpSignature, ckSignatureLength);
+    rv = (*ckpFunctions->C_Verify)(ckSessionHandle, inBufP, jInLen, ckpSignature, ckSignatureLength);
 
 cleanup:
-    free(ckpData);
+    releaseInBuffer(directIn, inBufP, INBUF);
     free(ckpSignature);
 
     ckAssertReturnValueOK(env, rv);
@@ -115,6 +115,17 @@ mp_err ec_GFp_pt_mul_jac(const mp_int *n, const mp_int *px,
                                                  const ECGroup *group);
 #endif
 
+/* Largest field size, in 32-bit words, supported by comb tables. */
+#define ECL_COMB_MAX_WORDS 12
+
+/* Computes R = nG where R is (rx, ry) and G is the base point, using the
+ * fixed-base comb method with a precomputed table of 2^teeth affine
+ * points, each coordinate stored as "words" 32-bit words.  See
+ * ecp_jac.c for the table layout.  Returns output that is field-encoded. */
+mp_err ec_GFp_pt_mul_comb(const mp_int *n, mp_int *rx, mp_int *ry,
+                                                  const ECGroup *group, const unsigned int *table,
+                                                  int teeth, int spacing, int words);
+
 /* Computes R(x, y) = k1 * G + k2 * P(x, y), where G is the generator
  * (base point) of the group of points on the elliptic curve. Allows k1 =
  * NULL or { k2, P } = NULL.  Implemented using mixed Jacobian-affine
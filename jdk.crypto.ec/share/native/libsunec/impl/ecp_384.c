@@ -280,15 +280,229 @@ ec_GFp_nistp384_mul(const mp_int *a, const mp_int *b, mp_int *r,
         return res;
 }
 
+/* Comb table for the fixed-base multiplication of the P-384 generator:
+ * entry b holds the affine point sum(((b >> j) & 1) * 2^(77 * j)) * G,
+ * entry 0 is the point at infinity.  Coordinates are little-endian
+ * 32-bit words, x followed by y. */
+static const unsigned int ec_GFp_nistp384_comb[32 * 2 * 12] = {
+        0x00000000, 0x00000000, 0x00000000, 0x00000000,
+        0x00000000, 0x00000000, 0x00000000, 0x00000000,
+        0x00000000, 0x00000000, 0x00000000, 0x00000000,
+        0x00000000, 0x00000000, 0x00000000, 0x00000000,
+        0x00000000, 0x00000000, 0x00000000, 0x00000000,
+        0x00000000, 0x00000000, 0x00000000, 0x00000000,
+        0x72760ab7, 0x3a545e38, 0xbf55296c, 0x5502f25d,
+        0x82542a38, 0x59f741e0, 0x8ba79b98, 0x6e1d3b62,
+        0xf320ad74, 0x8eb1c71e, 0xbe8b0537, 0xaa87ca22,
+        0x90ea0e5f, 0x7a431d7c, 0x1d7e819d, 0x0a60b1ce,
+        0xb5f0b8c0, 0xe9da3113, 0x289a147c, 0xf8f41dbd,
+        0x9292dc29, 0x5d9e98bf, 0x96262c6f, 0x3617de4a,
+        0x574a2d7a, 0x214a5541, 0x0baff67e, 0x8bb26b1f,
+        0x685cb49e, 0xe8e8a314, 0x05f1dbe9, 0x6ad56435,
+        0x415b4393, 0xb2128765, 0xe52e83a1, 0xfdff5d78,
+        0x978e2b11, 0xe715e976, 0xd4d391b8, 0xdcc72e10,
+        0xdd2d7ec4, 0xef01a9d8, 0x5963c951, 0x00377f99,
+        0xf10b944a, 0x13f5d41f, 0x7857aa4c, 0x4db0bc42,
+        0x8e8cf6bd, 0x4df624db, 0x8547e6b6, 0x8244132b,
+        0xeaac9420, 0xa9d5e399, 0x21ad8066, 0x0a9b91bd,
+        0x3eee915b, 0x492ecebd, 0x0fdd804e, 0x5e54d953,
+        0xcc5a43b2, 0x44288c00, 0x42727fd7, 0xf66d7125,
+        0x89a66c33, 0x6f98b352, 0x95821b09, 0x5009a4b4,
+        0x0e8131d0, 0xb5e534ac, 0x4ba24bc0, 0x4a3d7763,
+        0xe0bde8c2, 0xd490b021, 0xca52b096, 0x6cc28a6c,
+        0xc30bd659, 0xcf1df4fd, 0x50feaf12, 0x0e63f460,
+        0x7f52c6e5, 0xcd958f85, 0x34cb8fa1, 0x2913d4eb,
+        0xb083dcb0, 0xcbf987e9, 0xb1a874d8, 0xb47f863a,
+        0xb3bb7da7, 0x2d48722e, 0x7603fd5f, 0x27855d53,
+        0x7765a132, 0xa5cce5a0, 0x5a14ffb1, 0x047b885f,
+        0x931694d6, 0x3311ec54, 0xd26c55b2, 0x66004ec3,
+        0x1f2ccd66, 0xd50a0ac4, 0x4b047385, 0x274e6260,
+        0xb7fd6664, 0xd96204e4, 0x6aa71294, 0xd23b746b,
+        0x46b64add, 0x9a7231a7, 0xbe780847, 0x47709b8e,
+        0xaa3aec73, 0xc5be101d, 0xb89d3090, 0x2786bd19,
+        0x09a71ba8, 0x5f348f1d, 0x0169076a, 0xe2f2cda7,
+        0x12d256e1, 0x0db699e4, 0xa526f3f5, 0xcc589514,
+        0xb6f8c073, 0xe7ea29a0, 0xadba7324, 0x50359755,
+        0xe672c579, 0x0fd7fc38, 0xf5d93f24, 0xe9fb6a4d,
+        0x910a0fb5, 0x9103b778, 0x1de052be, 0x6e7107bd,
+        0xdbdbae3d, 0x6c24c094, 0x66f0cd5a, 0x6f5424a9,
+        0xd171104b, 0xeab70ffa, 0xe51210f9, 0x52ad7c38,
+        0x1a465ee0, 0x70cb8a4c, 0xf8ee3f37, 0xf04ba246,
+        0xc81ee126, 0xd6beaeb6, 0xdc50393c, 0x5fc113e8,
+        0xd094b6a7, 0xd0472dd3, 0xda1c1669, 0xb769b0be,
+        0x4157bca1, 0x772481fa, 0x96beeec6, 0xde0aed5e,
+        0x284569c0, 0xb9c04f16, 0x8b36d601, 0xa2415911,
+        0xd415e1ca, 0x81d51b7f, 0xebaad0a2, 0x4fe542b9,
+        0xa93c10a7, 0xcb610182, 0x036afb3b, 0xbd5059c9,
+        0xfaac375a, 0xcb538303, 0xac1b02f4, 0xc35a94e6,
+        0x8ae7d58b, 0x8b5d4209, 0x004241bd, 0xa8eb2114,
+        0x262fac2c, 0xaa3c554a, 0x31306b48, 0xc6d2bcdf,
+        0xfab6be4d, 0x0adae8a9, 0x0ea77d12, 0x89b18aed,
+        0xa2675d24, 0x2c4382ff, 0x105529ba, 0xabb60ce6,
+        0xedf8c996, 0x7ffaf718, 0xc58b999a, 0x4ee49986,
+        0xba5328e9, 0x5fdc0c0f, 0x4de7b0b3, 0x22bb9f3b,
+        0x79a8b5ab, 0x59bdb661, 0x5b46960b, 0xa41ceb96,
+        0x673f565b, 0xf95fd896, 0x5546575d, 0x1682f977,
+        0x725e981d, 0x985159d4, 0x82edff44, 0x2cfe484d,
+        0xe5efaad0, 0x785cb625, 0x10e28346, 0xc6e94cf8,
+        0xe79fc953, 0xcfa78fcc, 0x62a76a5b, 0xd8503095,
+        0x4ab1fb6e, 0xdf363e09, 0xa506b01a, 0x907e97ba,
+        0xa15af7c1, 0x9befb795, 0xeac69987, 0xc7fa7869,
+        0x1c404fe9, 0xde4d11b2, 0x2e6d0fb8, 0xb0917d3b,
+        0xaee80fb9, 0xb37cc365, 0xf87f9262, 0x306c8470,
+        0x43fc91f8, 0x87519b7f, 0x0a61cdf5, 0x9d434dbe,
+        0xb33139e7, 0x49bf609f, 0xac820a90, 0x60fd2ceb,
+        0x164a20f6, 0xa1344ad0, 0xced42ab2, 0xc8a16564,
+        0x87f81db5, 0xc778ef62, 0xda05de0c, 0x81c02c3e,
+        0xc17d28b9, 0x924d0e64, 0x90e31340, 0x8bf310b1,
+        0xa9ce292c, 0x9ddad413, 0xc42f9a8e, 0x46a2a12d,
+        0x69cb4b1d, 0x0c345297, 0x4c3ef2d3, 0x1ce0028a,
+        0x4484249f, 0x7b2ea237, 0xde8d2145, 0xcdc53530,
+        0x225a3dd1, 0x8b6136dd, 0x53740ec9, 0xb18e9e73,
+        0x5f27c64a, 0x644e97b7, 0xa9cea0c5, 0xa7208e9d,
+        0xa48b98ec, 0x6bb544bd, 0x57c5f037, 0x1deba7f3,
+        0x1f068fb5, 0xbcc87131, 0x11cf7c4b, 0xae719373,
+        0x2cb2ec36, 0x74a95c5b, 0x335d77b6, 0x65be9e50,
+        0xb2319168, 0xf9a6e7f2, 0x51d144a0, 0xedd5f953,
+        0xad2ad161, 0x7171c038, 0xf7215966, 0x5c01a2be,
+        0xb978fa06, 0xf696c756, 0x6579d248, 0x714398bb,
+        0xab1fb325, 0x4ade5706, 0xff0c1846, 0x818b42b4,
+        0xd6ee937e, 0x7f0c9f34, 0x90cd7784, 0x54ac28c5,
+        0xe17f0476, 0x8701f645, 0xa4b5d7b8, 0x6545aa51,
+        0x775226d6, 0x880f880f, 0x9cb06473, 0xdf312f51,
+        0x4644dbc4, 0xaae46b81, 0x7654c263, 0x40371dc1,
+        0xbeb9f7af, 0xc747f85f, 0xcc281c52, 0xf4b35b77,
+        0x8c15e275, 0x28ec4ac0, 0xfbf5433b, 0x51537ca3,
+        0xfd212d3f, 0x28cf7bc3, 0xe1b6365e, 0xd2d86e75,
+        0x120328ce, 0x047bbcf0, 0xf07414d3, 0x33e139ef,
+        0xcb38e86d, 0xe2a2f4fc, 0x5382ed59, 0xcb5357ba,
+        0x1b5076c2, 0x6be08d5d, 0x4d83e11c, 0xc62df637,
+        0x60969a97, 0xd6958c1e, 0x54dbfc48, 0xa49b602c,
+        0x51914bca, 0xfb97d2ee, 0xaa211719, 0xb4bc64c9,
+        0x00644d20, 0x0adcd952, 0xa75f0046, 0xb8e8ca59,
+        0x17a818f2, 0x9f5e1fe2, 0xb5cf54d1, 0x7e1d2f2e,
+        0x31e76220, 0x3992d2a1, 0xff7003c6, 0x7ad2a60b,
+        0x8f1546be, 0xdb6a4d39, 0xe8a1a2a3, 0xb13228b1,
+        0x993d3a02, 0x1470159c, 0x9e9bf4d9, 0x5b4e8b1d,
+        0x0cd001d1, 0x6fcb85e9, 0x3df1dfe2, 0xe0781a9d,
+        0xc8a2265b, 0xf650285a, 0x37a9b579, 0x8727088a,
+        0x22c74609, 0xbb844df2, 0xd5476d33, 0xc3742094,
+        0x1e060165, 0x79fe2465, 0xb6b90f17, 0x5130bde7,
+        0x853cb459, 0xce254cfd, 0xba440754, 0xa8782b8e,
+        0xdaf8aa6c, 0x7d81f68f, 0x44b8bf68, 0xaa0e19aa,
+        0x2664a487, 0x6e3ee96f, 0x4e9fea80, 0x8f1b7d25,
+        0x131c050d, 0x7a282a2a, 0xca81498e, 0xd986b357,
+        0x154ec895, 0xc4750753, 0xcb3c35a3, 0x65db0b8a,
+        0xce9499eb, 0x4ac90b15, 0x91aee266, 0xbf5777fa,
+        0x4615ce5f, 0xd87272f9, 0xff3c56ce, 0xb92110a3,
+        0xcca3b289, 0xb327638e, 0x3d0a9f44, 0x396b35a9,
+        0x8ad619ef, 0x0dad5514, 0x3f9aa00a, 0x44242d55,
+        0xb843cde9, 0xd7e221ed, 0x071dde46, 0xa3c20977,
+        0xa5b4cd7a, 0x16dd93b9, 0x021460ca, 0xccd5df68,
+        0x6a570f04, 0x1d21128b, 0x394fe427, 0xe917b31c,
+        0x6ba2d13c, 0xc0fe28de, 0x7f08eba2, 0x2d31795f,
+        0x88492cb7, 0xdabb8957, 0xc82a64c1, 0x5b6478b4,
+        0xcd430e4c, 0x5d14f518, 0x217d14f8, 0x552992d1,
+        0x95033367, 0xb38d3c11, 0xae07e0e5, 0xacbb2ddc,
+        0x7b50f818, 0x7093124c, 0x7e9cc15b, 0x0ae3337f,
+        0x428e5500, 0x505f49ba, 0x20e83e0d, 0x4feb246b,
+        0x7c632779, 0x8d18ab7d, 0xd299bc0d, 0xfb435379,
+        0x89e66c63, 0xdea8f23f, 0xd93c74a3, 0xdd790987,
+        0x4b79adf6, 0xa9ac8f10, 0x677f9849, 0xff4caa4a,
+        0x80c84b38, 0x4e1bb75c, 0x105393d3, 0x52d2575d,
+        0x4569d2d3, 0x4f465f5f, 0x41e36869, 0xabad1376,
+        0xeb3f72ed, 0xb8566746, 0x08e114ae, 0x53316ed1,
+        0x91aea8c6, 0x45e5b481, 0x2857a9d5, 0x73c30bf5,
+        0xfd1f7c82, 0x26db96af, 0xdf1822b5, 0x8c9010d0,
+        0x20428d3d, 0x246624ab, 0x6a02c7cd, 0xa3a48c9f,
+        0x34cd1bdd, 0x1298b738, 0x1b71b3bd, 0x664833bc,
+        0x070a6e08, 0xd9365cd7, 0xd610b66b, 0xa44ad979,
+        0xa6690fc0, 0xcc174eb1, 0xc9196d36, 0x5883b4be,
+        0x4ff222d2, 0x6507bbc3, 0x8506370b, 0xf90dad22,
+        0x235c94e5, 0xd5b17cec, 0x4f1d0704, 0x15c31cd6,
+        0x83692e96, 0xa45e13e0, 0x23632198, 0x30ca9241,
+        0x68c5d526, 0xfb14b0b9, 0x53ff8f7f, 0x1cb6aade,
+        0x9277f031, 0x64b1d3aa, 0xb57a14dd, 0x92504aad,
+        0x6f824a23, 0xa651a249, 0xbc1b0886, 0xaba60a2b,
+        0x67e331a8, 0xc632ef51, 0xd3432743, 0x386cab94,
+        0x24dbdacc, 0x644657cd, 0xea9d8eeb, 0x79baefe3,
+        0x7c0022a9, 0xce100b59, 0xb5552550, 0xc72c67d5,
+        0xc625d47f, 0xcc7c468d, 0x43b94872, 0x54376ae2,
+        0xfd91b733, 0x86116d31, 0xc07ab981, 0xc33e942e,
+        0xc1a90c5b, 0x7e0181b9, 0xef64936e, 0x4b2e6511,
+        0xaa71be85, 0x9187e8d4, 0xb683d1db, 0x9f03a529,
+        0xe63b581e, 0xe9825aac, 0x4b8a03ba, 0x05e6b0a8,
+        0xf3938636, 0x61907c78, 0x7ccadf9d, 0x2dda27d3,
+        0x9787c6ae, 0x1e7b1e07, 0xa645ca8f, 0x6e6a6097,
+        0x3b950770, 0xa152690c, 0x80453061, 0xcc813d19,
+        0xdc9bb565, 0x5026d3e0, 0xa41dac8d, 0x3a345564,
+        0xcf05440b, 0x092b8073, 0xe7e95f9a, 0xde1f971d,
+        0xbcb04838, 0x177d47c6, 0x37393d29, 0xb2a0c449,
+        0xe77340cd, 0x00224c3d, 0x6a4e526e, 0x31e37b98,
+        0xbc55a51b, 0xee98b785, 0x091bc664, 0x4ed22126,
+        0x98c7090f, 0x59c178ba, 0xa14ce4d5, 0x597fc7f4,
+        0xa623862f, 0x0de0aed2, 0x49106b56, 0x9195acaf,
+        0x939a89d1, 0x8703e4af, 0x2af3bfb2, 0xda07a303,
+        0xeb51ab60, 0x72817277, 0xfa0cb48f, 0x5aeedcb5,
+        0x6a386da2, 0x43e24139, 0xa6284e47, 0x09157d8f,
+        0xdcb7b7f6, 0x10d3abff, 0xc4a4ef51, 0x4fec85d9,
+        0xe11640b5, 0x6befaf87, 0x0afba91c, 0xb05ff572,
+        0xfedf311d, 0x00f305d9, 0x6082a9f9, 0x2322592a,
+        0xdfc76f75, 0xf1841c28, 0x10af674e, 0xf0714d17,
+        0xaf895173, 0xcd871803, 0x94f5571c, 0x110ab6a9,
+        0x22d4d124, 0x5aa3b421, 0xa2fe7a5f, 0xcb6eb594,
+        0xb6b4ac39, 0xbbe918ba, 0x3a31c961, 0x19e5161e,
+        0x3fffc9cd, 0xc2a7a2cb, 0xc67bbaa3, 0x1a0825b1,
+        0xa02d4bb0, 0x283c9073, 0xe05da927, 0x1c06eebc,
+        0xa7ce557b, 0xee920d22, 0xf79aec92, 0xf137a49c,
+        0xf7e0c93d, 0xac949aa9, 0xd2e5d915, 0x1d7481e4,
+        0x5cbe77d3, 0xaa5a8228, 0x128145fd, 0x02459758,
+        0x1bdb11f5, 0xf2096e10, 0xa5dc4090, 0x2b4ecb07,
+        0x4c110c19, 0xd335126c, 0x27efac4c, 0xd1b5960e,
+        0x77e930e1, 0x3d4100e8, 0xadc4c838, 0x0899baad,
+        0xf6b3097e, 0x5b64899f, 0x2790439d, 0x7c060a89,
+        0x513497c6, 0x40ab25d0, 0x202d8833, 0xdfa74fe2,
+        0x2466f95b, 0x689ccec5, 0xe0b8e88e, 0xe757107a,
+        0x56a78f16, 0x38d0d513, 0x5da9f7c2, 0x47c8301c,
+        0x31956f2b, 0xe8c55cc6, 0x0c8d4931, 0x6da590d6,
+        0x374e2772, 0xffeff253, 0x2afedda2, 0xc0132d35,
+        0x6c782f3c, 0xc6211452, 0xc98a97e8, 0x7d7f61cd,
+        0x74db0e01, 0xf0602625, 0x5d0d215d, 0x36c1ac6a,
+        0x59a579de, 0x88cbe3cf, 0xc2c17408, 0x8ddeec0b,
+        0x034d07d8, 0x6d87fced, 0x656a1f61, 0x9066afe4,
+        0xfbc82854, 0x758ae55f, 0x0f73dfe9, 0x0bc110fa,
+        0x679a2aba, 0x96edf50f, 0x7fa01880, 0x31b92b91,
+        0x72495766, 0xfda047eb, 0xcb1299c9, 0xe8c663c5,
+        0x91dbe668, 0x15798146, 0x9da9121c, 0x25e209c5,
+        0xf69b64da, 0x9ad033a2, 0xd82adb97, 0x6366e8f3,
+        0xe9103189, 0x96052f28, 0x6e6ce744, 0x6c279054,
+        0xfe5d6697, 0xda53b069, 0xda09fb6a, 0x553200b9
+};
+
+/* Computes R = nG for the P-384 generator G using the precomputed comb
+ * table above. */
+static mp_err
+ec_GFp_nistp384_base_point_mul(const mp_int *n, mp_int *rx, mp_int *ry,
+                                                          const ECGroup *group)
+{
+        return ec_GFp_pt_mul_comb(n, rx, ry, group, ec_GFp_nistp384_comb,
+                                                          5, 77, 12);
+}
+
 /* Wire in fast field arithmetic and precomputation of base point for
  * named curves. */
 mp_err
 ec_group_set_gfp384(ECGroup *group, ECCurveName name)
 {
         if (name == ECCurve_NIST_P384) {
-                group->meth->field_mod = &ec_GFp_nistp384_mod;
-                group->meth->field_mul = &ec_GFp_nistp384_mul;
-                group->meth->field_sqr = &ec_GFp_nistp384_sqr;
+                /* Montgomery arithmetic outperforms the reduction
+                 * in this file for P-384, so keep it if the group uses it. */
+                if (group->meth->field_enc == NULL) {
+                        group->meth->field_mod = &ec_GFp_nistp384_mod;
+                        group->meth->field_mul = &ec_GFp_nistp384_mul;
+                        group->meth->field_sqr = &ec_GFp_nistp384_sqr;
+                }
+                group->base_point_mul = &ec_GFp_nistp384_base_point_mul;
         }
         return MP_OKAY;
 }
@@ -43,6 +43,7 @@
 
 #include "ecp.h"
 #include "mplogic.h"
+#include "mpi-priv.h"
 #ifndef _KERNEL
 #include <stdlib.h>
 #endif
@@ -406,6 +407,180 @@ ec_GFp_pt_mul_jac(const mp_int *n, const mp_int *px, const mp_int *py,
 }
 #endif
 
+/* Loads entry idx of a comb table into the affine point (qx, qy).  Every
+ * entry is read and the wanted one is selected with a mask, so that the
+ * memory access pattern does not depend on idx. */
+static mp_err
+ec_GFp_comb_select(const unsigned int *table, int entries, int words,
+                                   int idx, mp_int *qx, mp_int *qy)
+{
+        mp_err res = MP_OKAY;
+        unsigned int buf[2 * ECL_COMB_MAX_WORDS];
+        unsigned int mask;
+        mp_size ndigits = (words * 32 + MP_DIGIT_BIT - 1) / MP_DIGIT_BIT;
+        int i, j;
+
+        for (j = 0; j < 2 * words; j++) {
+                buf[j] = 0;
+        }
+        for (i = 0; i < entries; i++) {
+                /* mask is all ones when i == idx, zero otherwise */
+                mask = (unsigned int) (i ^ idx);
+                mask = ((mask | (0U - mask)) >> 31) - 1U;
+                for (j = 0; j < 2 * words; j++) {
+                        buf[j] |= table[i * 2 * words + j] & mask;
+                }
+        }
+
+        MP_CHECKOK(s_mp_pad(qx, ndigits));
+        MP_CHECKOK(s_mp_pad(qy, ndigits));
+        for (j = 0; j < (int) ndigits; j++) {
+                MP_DIGIT(qx, j) = 0;
+                MP_DIGIT(qy, j) = 0;
+        }
+        for (j = 0; j < words; j++) {
+                MP_DIGIT(qx, (j * 32) / MP_DIGIT_BIT) |=
+                        (mp_digit) buf[j] << ((j * 32) % MP_DIGIT_BIT);
+                MP_DIGIT(qy, (j * 32) / MP_DIGIT_BIT) |=
+                        (mp_digit) buf[words + j] << ((j * 32) % MP_DIGIT_BIT);
+        }
+        MP_USED(qx) = ndigits;
+        MP_USED(qy) = ndigits;
+        MP_SIGN(qx) = MP_ZPOS;
+        MP_SIGN(qy) = MP_ZPOS;
+        s_mp_clamp(qx);
+        s_mp_clamp(qy);
+
+  CLEANUP:
+        return res;
+}
+
+/* Sets r to s if mask is all ones and leaves it unchanged if mask is
+ * zero.  Both are padded to ndigits digits and every digit is written,
+ * so that the work done does not depend on mask. */
+static mp_err
+ec_GFp_cmov(mp_int *r, mp_int *s, mp_digit mask, mp_size ndigits)
+{
+        mp_err res = MP_OKAY;
+        mp_size j;
+
+        MP_CHECKOK(s_mp_pad(r, ndigits));
+        MP_CHECKOK(s_mp_pad(s, ndigits));
+        for (j = 0; j < ndigits; j++) {
+                MP_DIGIT(r, j) = (MP_DIGIT(r, j) & ~mask) | (MP_DIGIT(s, j) & mask);
+        }
+        MP_USED(r) = ndigits;
+        s_mp_clamp(r);
+
+  CLEANUP:
+        return res;
+}
+
+/* Computes R = nG where R is (rx, ry) and G is the base point, using the
+ * fixed-base comb method (Lim-Lee) with a precomputed table of
+ * 2^teeth affine points: entry b is sum(((b >> j) & 1) * 2^(spacing * j))
+ * * G and entry 0 is the point at infinity (0, 0).  Coordinates are
+ * stored as "words" little-endian 32-bit words, x followed by y.  This
+ * replaces the ~bits doublings of a generic method by spacing doublings
+ * and spacing mixed additions.
+ *
+ * The additions and doublings shortcut the point at infinity, so R
+ * starts at G rather than at infinity, which adds 2^spacing * G (table
+ * entry 2) to the result that is subtracted at the end.  A zero comb
+ * column adds entry 1 instead and discards the sum with a mask.  Every
+ * scalar of at most teeth * spacing bits thus performs the same sequence
+ * of point operations.  Output is field-encoded. */
+mp_err
+ec_GFp_pt_mul_comb(const mp_int *n, mp_int *rx, mp_int *ry,
+                                   const ECGroup *group, const unsigned int *table,
+                                   int teeth, int spacing, int words)
+{
+        mp_err res = MP_OKAY;
+        mp_int qx, qy, rz, sx, sy, sz;
+        mp_size bit, d, ndigits;
+        mp_digit mask;
+        int i, j, idx, nonzero;
+
+        MP_DIGITS(&qx) = 0;
+        MP_DIGITS(&qy) = 0;
+        MP_DIGITS(&rz) = 0;
+        MP_DIGITS(&sx) = 0;
+        MP_DIGITS(&sy) = 0;
+        MP_DIGITS(&sz) = 0;
+
+        ARGCHK(group != NULL, MP_BADARG);
+        ARGCHK((n != NULL) && (table != NULL), MP_BADARG);
+        ARGCHK((teeth >= 2) && (spacing > 0), MP_BADARG);
+        ARGCHK((words > 0) && (words <= ECL_COMB_MAX_WORDS), MP_BADARG);
+        ARGCHK(mpl_significant_bits(n) <= teeth * spacing, MP_BADARG);
+
+        MP_CHECKOK(mp_init(&qx, FLAG(n)));
+        MP_CHECKOK(mp_init(&qy, FLAG(n)));
+        MP_CHECKOK(mp_init(&rz, FLAG(n)));
+        MP_CHECKOK(mp_init(&sx, FLAG(n)));
+        MP_CHECKOK(mp_init(&sy, FLAG(n)));
+        MP_CHECKOK(mp_init(&sz, FLAG(n)));
+        ndigits = MP_USED(&group->meth->irr);
+
+        /* R = G */
+        MP_CHECKOK(ec_GFp_comb_select(table, 1 << teeth, words, 1, &qx, &qy));
+        if (group->meth->field_enc) {
+                MP_CHECKOK(group->meth->field_enc(&qx, &qx, group->meth));
+                MP_CHECKOK(group->meth->field_enc(&qy, &qy, group->meth));
+        }
+        MP_CHECKOK(ec_GFp_pt_aff2jac(&qx, &qy, rx, ry, &rz, group));
+
+        for (i = spacing - 1; i >= 0; i--) {
+                idx = 0;
+                for (j = teeth - 1; j >= 0; j--) {
+                        bit = spacing * j + i;
+                        d = bit / MP_DIGIT_BIT;
+                        idx <<= 1;
+                        if (d < MP_USED(n)) {
+                                idx |= (int) ((MP_DIGIT(n, d) >> (bit % MP_DIGIT_BIT)) & 1);
+                        }
+                }
+                /* nonzero is 1 if idx != 0, 0 otherwise */
+                nonzero = (int) (((unsigned int) idx | (0U - (unsigned int) idx)) >> 31);
+                mask = (mp_digit) 0 - (mp_digit) nonzero;
+                MP_CHECKOK(ec_GFp_comb_select(table, 1 << teeth, words,
+                                                                          idx | (nonzero ^ 1), &qx, &qy));
+                if (group->meth->field_enc) {
+                        MP_CHECKOK(group->meth->field_enc(&qx, &qx, group->meth));
+                        MP_CHECKOK(group->meth->field_enc(&qy, &qy, group->meth));
+                }
+                /* R = 2R, S = R + T[idx], R = S unless idx is 0 */
+                MP_CHECKOK(ec_GFp_pt_dbl_jac(rx, ry, &rz, rx, ry, &rz, group));
+                MP_CHECKOK(ec_GFp_pt_add_jac_aff(rx, ry, &rz, &qx, &qy,
+                                                                                 &sx, &sy, &sz, group));
+                MP_CHECKOK(ec_GFp_cmov(rx, &sx, mask, ndigits));
+                MP_CHECKOK(ec_GFp_cmov(ry, &sy, mask, ndigits));
+                MP_CHECKOK(ec_GFp_cmov(&rz, &sz, mask, ndigits));
+        }
+
+        /* R = R - 2^spacing * G */
+        MP_CHECKOK(ec_GFp_comb_select(table, 1 << teeth, words, 2, &qx, &qy));
+        if (group->meth->field_enc) {
+                MP_CHECKOK(group->meth->field_enc(&qx, &qx, group->meth));
+                MP_CHECKOK(group->meth->field_enc(&qy, &qy, group->meth));
+        }
+        MP_CHECKOK(group->meth->field_neg(&qy, &qy, group->meth));
+        MP_CHECKOK(ec_GFp_pt_add_jac_aff(rx, ry, &rz, &qx, &qy, rx, ry, &rz,
+                                                                         group));
+
+        /* convert result to affine coordinates */
+        MP_CHECKOK(ec_GFp_pt_jac2aff(rx, ry, &rz, rx, ry, group));
+
+  CLEANUP:
+        mp_clear(&qx);
+        mp_clear(&qy);
+        mp_clear(&rz);
+        mp_clear(&sx);
+        mp_clear(&sy);
+        mp_clear(&sz);
+        return res;
+}
+
 /* Elliptic curve scalar-point multiplication. Computes R(x, y) = k1 * G +
  * k2 * P(x, y), where G is the generator (base point) of the group of
  * points on the elliptic curve. Allows k1 = NULL or { k2, P } = NULL.
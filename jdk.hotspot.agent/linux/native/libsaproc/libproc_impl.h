@@ -56,6 +56,7 @@ typedef struct map_info {
    off_t            offset;   // file offset of this mapping
    uintptr_t        vaddr;    // starting virtual address
    size_t           memsz;    // size of the mapping
+   char*            contents; // mmap'd file contents, MAP_FAILED if unmappable
    struct map_info* next;
 } map_info;
 
@@ -30,6 +30,8 @@
 #include <stddef.h>
 #include <elf.h>
 #include <link.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "libproc_impl.h"
 #include "proc_service.h"
 #include "salibelf.h"
@@ -73,11 +75,24 @@ static void close_files(struct ps_prochandle* ph) {
   }
 }
 
+// file offset of a mapping, rounded down to a page boundary for mmap
+static off_t map_file_start(map_info* map) {
+  return map->offset & ~((off_t)sysconf(_SC_PAGE_SIZE) - 1);
+}
+
+static void unmap_contents(map_info* map) {
+  if (map->contents != NULL && map->contents != MAP_FAILED) {
+    size_t delta = map->offset - map_file_start(map);
+    munmap(map->contents - delta, map->memsz + delta);
+  }
+}
+
 // clean all map_info stuff
 static void destroy_map_info(struct ps_prochandle* ph) {
   map_info* map = ph->core->maps;
   while (map) {
     map_info* next = map->next;
+    unmap_contents(map);
     free(map);
     map = next;
   }
@@ -90,6 +105,7 @@ static void destroy_map_info(struct ps_prochandle* ph) {
   map = ph->core->class_share_maps;
   while (map) {
     map_info* next = map->next;
+    unmap_contents(map);
     free(map);
     map = next;
   }
@@ -427,6 +443,30 @@ static bool sort_map_array(struct ps_prochandle* ph) {
 #define MIN(x, y) (((x) < (y))? (x): (y))
 #endif
 
+// Return the file contents of the given mapping mmap'd into our address
+// space, or NULL if they cannot be mapped. Heap dumps of large cores read
+// most of the core, and a memcpy from the page cache is much cheaper than
+// a pread system call per object.
+static char* map_contents(map_info* mp) {
+  if (mp->contents == NULL) {
+    off_t start = map_file_start(mp);
+    size_t delta = mp->offset - start;
+    struct stat st;
+    void* base = MAP_FAILED;
+    // Touching pages beyond the end of a truncated core would raise SIGBUS.
+    if (fstat(mp->fd, &st) == 0 && mp->offset + (off_t)mp->memsz <= st.st_size) {
+      base = mmap(NULL, mp->memsz + delta, PROT_READ, MAP_PRIVATE, mp->fd, start);
+    }
+    if (base == MAP_FAILED) {
+      print_debug("can't mmap map_info at 0x%lx, using pread\n", mp->vaddr);
+      mp->contents = MAP_FAILED;
+    } else {
+      mp->contents = (char*)base + delta;
+    }
+  }
+  return (mp->contents == MAP_FAILED) ? NULL : mp->contents;
+}
+
 static bool core_read_data(struct ps_prochandle* ph, uintptr_t addr, char *buf, size_t size) {
    ssize_t resid = size;
    int page_size=sysconf(_SC_PAGE_SIZE);
@@ -436,6 +476,7 @@ static bool core_read_data(struct ps_prochandle* ph, uintptr_t addr, char *buf,
       ssize_t len, rem;
       off_t off;
       int fd;
+      char* contents;
 
       if (mp == NULL) {
          break;  /* No mapping for this address */
@@ -446,7 +487,9 @@ static bool core_read_data(struct ps_prochandle* ph, uintptr_t addr, char *buf,
       len = MIN(resid, mp->memsz - mapoff);
       off = mp->offset + mapoff;
 
-      if ((len = pread(fd, buf, len, off)) <= 0) {
+      if ((contents = map_contents(mp)) != NULL) {
+         memcpy(buf, contents + mapoff, len);
+      } else if ((len = pread(fd, buf, len, off)) <= 0) {
          break;
       }
 
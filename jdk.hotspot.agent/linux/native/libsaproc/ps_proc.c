@@ -71,6 +71,18 @@ static bool process_read_data(struct ps_prochandle* ph, uintptr_t addr, char *bu
   size_t i, words;
   uintptr_t end_addr = addr + size;
   uintptr_t aligned_addr = align(addr, sizeof(long));
+  struct iovec local_iov, remote_iov;
+
+  // process_vm_readv copies the whole range with one system call instead
+  // of one ptrace call per word. Fall back to ptrace if it is unavailable
+  // or the range is only partially readable.
+  local_iov.iov_base = buf;
+  local_iov.iov_len = size;
+  remote_iov.iov_base = (void*)addr;
+  remote_iov.iov_len = size;
+  if (process_vm_readv(ph->pid, &local_iov, 1, &remote_iov, 1, 0) == (ssize_t)size) {
+    return true;
+  }
 
   if (aligned_addr != addr) {
     char *ptr = (char *)&rslt;
@@ -106,8 +106,9 @@ public class ClassLoaderData extends VMObject {
 
   /** Iterate over all klasses in the dictionary, including initiating loader. */
   public void allEntriesDo(ClassLoaderDataGraph.ClassAndLoaderVisitor v) {
-      for (Klass l = getKlasses(); l != null; l = l.getNextLinkKlass()) {
-          dictionary().allEntriesDo(v, getClassLoader());
+      Dictionary dictionary = dictionary();
+      if (dictionary != null) {
+          dictionary.allEntriesDo(v, getClassLoader());
       }
   }
 }
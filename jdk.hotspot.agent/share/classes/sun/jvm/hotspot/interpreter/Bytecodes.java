@@ -264,25 +264,27 @@ public class Bytecodes {
   public static final int _fast_iaccess_0       = 221;
   public static final int _fast_aaccess_0       = 222;
   public static final int _fast_faccess_0       = 223;
-  public static final int _fast_iload           = 224;
-  public static final int _fast_iload2          = 225;
-  public static final int _fast_icaload         = 226;
-  public static final int _fast_invokevfinal    = 227;
-  public static final int _fast_linearswitch    = 228;
-  public static final int _fast_binaryswitch    = 229;
-  public static final int _fast_aldc            = 230;
-  public static final int _fast_aldc_w          = 231;
-  public static final int _return_register_finalizer = 232;
-  public static final int _invokehandle         = 233;
+  public static final int _fast_aload_0_aload_1 = 224;
+  public static final int _fast_aload_0_iload_1 = 225;
+  public static final int _fast_iload           = 226;
+  public static final int _fast_iload2          = 227;
+  public static final int _fast_icaload         = 228;
+  public static final int _fast_invokevfinal    = 229;
+  public static final int _fast_linearswitch    = 230;
+  public static final int _fast_binaryswitch    = 231;
+  public static final int _fast_aldc            = 232;
+  public static final int _fast_aldc_w          = 233;
+  public static final int _return_register_finalizer = 234;
+  public static final int _invokehandle         = 235;
 
   // Bytecodes rewritten at CDS dump time
-  public static final int _nofast_getfield      = 234;
-  public static final int _nofast_putfield      = 235;
-  public static final int _nofast_aload_0       = 236;
-  public static final int _nofast_iload         = 237;
-  public static final int _shouldnotreachhere   = 238; // For debugging
+  public static final int _nofast_getfield      = 236;
+  public static final int _nofast_putfield      = 237;
+  public static final int _nofast_aload_0       = 238;
+  public static final int _nofast_iload         = 239;
+  public static final int _shouldnotreachhere   = 240; // For debugging
 
-  public static final int number_of_codes       = 239;
+  public static final int number_of_codes       = 241;
 
   // Flag bits derived from format strings, can_trap, can_rewrite, etc.:
   // semantic flags:
@@ -795,6 +797,8 @@ public class Bytecodes {
     def(_fast_iaccess_0      , "fast_iaccess_0"      , "b_JJ" , null    , BasicType.getTInt()    ,  1, true , _aload_0        );
     def(_fast_aaccess_0      , "fast_aaccess_0"      , "b_JJ" , null    , BasicType.getTObject() ,  1, true , _aload_0        );
     def(_fast_faccess_0      , "fast_faccess_0"      , "b_JJ" , null    , BasicType.getTObject() ,  1, true , _aload_0        );
+    def(_fast_aload_0_aload_1, "fast_aload_0_aload_1", "b_"   , null    , BasicType.getTObject() ,  2, false, _aload_0        );
+    def(_fast_aload_0_iload_1, "fast_aload_0_iload_1", "b_"   , null    , BasicType.getTInt()    ,  2, false, _aload_0        );
 
     def(_fast_iload          , "fast_iload"          , "bi"   , null    , BasicType.getTInt()    ,  1, false, _iload          );
     def(_fast_iload2         , "fast_iload2"         , "bi_i" , null    , BasicType.getTInt()    ,  2, false, _iload          );
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2003, 2017, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2003, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -32,7 +32,10 @@ import sun.jvm.hotspot.types.*;
 import sun.jvm.hotspot.runtime.*;
 import sun.jvm.hotspot.utilities.*;
 
-public class Dictionary extends sun.jvm.hotspot.utilities.Hashtable {
+/** A class loader data dictionary. In the VM this is a
+    ConcurrentHashTable of DictionaryEntry pointers, which may be in the
+    middle of a resize. */
+public class Dictionary extends VMObject {
   static {
     VM.registerVMInitializedObserver(new Observer() {
         public void update(Observable o, Object data) {
@@ -42,54 +45,92 @@ public class Dictionary extends sun.jvm.hotspot.utilities.Hashtable {
   }
 
   private static synchronized void initialize(TypeDataBase db) {
-    // just checking that the type exists
     Type type = db.lookupType("Dictionary");
+    tableField = type.getAddressField("_table");
+
+    Type tableType = db.lookupType("DictionaryTable");
+    activeTableField = tableType.getAddressField("_table");
+    newTableField = tableType.getAddressField("_new_table");
+
+    Type internalTableType = db.lookupType("DictionaryTable::InternalTable");
+    bucketsField = internalTableType.getAddressField("_buckets");
+    sizeField = internalTableType.getCIntegerField("_size");
+
+    Type bucketType = db.lookupType("DictionaryTable::Bucket");
+    firstField = bucketType.getAddressField("_first");
+    bucketSize = bucketType.getSize();
+
+    Type nodeType = db.lookupType("DictionaryTable::Node");
+    nextField = nodeType.getAddressField("_next");
+    valueField = nodeType.getAddressField("_value");
+
+    stateRedirectBit = db.lookupIntConstant("DictionaryTable::Bucket::STATE_REDIRECT_BIT").longValue();
+    stateMask = db.lookupIntConstant("DictionaryTable::Bucket::STATE_MASK").longValue();
   }
 
+  private static AddressField tableField;
+  private static AddressField activeTableField;
+  private static AddressField newTableField;
+  private static AddressField bucketsField;
+  private static CIntegerField sizeField;
+  private static AddressField firstField;
+  private static long bucketSize;
+  private static AddressField nextField;
+  private static AddressField valueField;
+  private static long stateRedirectBit;
+  private static long stateMask;
+
   public Dictionary(Address addr) {
     super(addr);
   }
 
-  // this is overriden here so that Hashtable.bucket will return
-  // object of DictionaryEntry.class
-  protected Class getHashtableEntryClass() {
-    return DictionaryEntry.class;
-  }
-
   /** All classes, and their initiating class loader, passed in. */
   public void allEntriesDo(ClassLoaderDataGraph.ClassAndLoaderVisitor v, Oop loader) {
-    int tblSize = tableSize();
-    for (int index = 0; index < tblSize; index++) {
-      for (DictionaryEntry probe = (DictionaryEntry) bucket(index); probe != null;
-                                              probe = (DictionaryEntry) probe.next()) {
-        Klass k = probe.klass();
-        v.visit(k, loader);
+    Address table = tableField.getValue(addr);
+    Address activeTable = activeTableField.getValue(table);
+    long size = sizeField.getValue(activeTable);
+    boolean redirected = false;
+    for (long index = 0; index < size; index++) {
+      Address first = firstField.getValue(bucket(activeTable, index));
+      if (first != null && first.andWithMask(stateRedirectBit) != null) {
+        // The entries of this bucket have been moved to the new table.
+        redirected = true;
+        continue;
+      }
+      for (Address node = clearState(first); node != null; node = nextField.getValue(node)) {
+        v.visit(entry(node).klass(), loader);
+      }
+    }
+    if (!redirected) {
+      return;
+    }
+    // A resize is in progress. While a bucket is split during growth its
+    // entries may be reachable from both new buckets, so only visit an
+    // entry from the bucket it hashes to.
+    Address newTable = newTableField.getValue(table);
+    long newSize = sizeField.getValue(newTable);
+    for (long index = 0; index < newSize; index++) {
+      Address first = firstField.getValue(bucket(newTable, index));
+      for (Address node = clearState(first); node != null; node = nextField.getValue(node)) {
+        Klass k = entry(node).klass();
+        if ((k.getName().identityHash() & (newSize - 1)) == index) {
+          v.visit(k, loader);
+        }
       }
     }
   }
 
   // - Internals only below this point
 
-  private DictionaryEntry getEntry(int index, long hash, Symbol className) {
-    for (DictionaryEntry entry = (DictionaryEntry) bucket(index); entry != null;
-                                    entry = (DictionaryEntry) entry.next()) {
-      if (entry.hash() == hash && entry.equals(className)) {
-        return entry;
-      }
-    }
-    return null;
+  private Address bucket(Address internalTable, long index) {
+    return bucketsField.getValue(internalTable).addOffsetTo(index * bucketSize);
   }
 
-  public boolean contains(Klass c) {
-    long hash = computeHash(c.getName());
-    int index = hashToIndex(hash);
+  private Address clearState(Address first) {
+    return first == null ? null : first.andWithMask(~stateMask);
+  }
 
-    for (DictionaryEntry entry = (DictionaryEntry) bucket(index); entry != null;
-                                    entry = (DictionaryEntry) entry.next()) {
-      if (entry.literalValue().equals(c.getAddress())) {
-        return true;
-      }
-    }
-    return false;
+  private DictionaryEntry entry(Address node) {
+    return (DictionaryEntry) VMObjectFactory.newObject(DictionaryEntry.class, valueField.getValue(node));
   }
 }
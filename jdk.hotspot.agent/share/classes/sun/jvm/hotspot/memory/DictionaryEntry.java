@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2003, 2017, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2003, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -25,14 +25,12 @@
 package sun.jvm.hotspot.memory;
 
 import java.util.*;
-import sun.jvm.hotspot.classfile.ClassLoaderData;
 import sun.jvm.hotspot.debugger.*;
 import sun.jvm.hotspot.oops.*;
 import sun.jvm.hotspot.types.*;
 import sun.jvm.hotspot.runtime.*;
-import sun.jvm.hotspot.utilities.*;
 
-public class DictionaryEntry extends sun.jvm.hotspot.utilities.HashtableEntry {
+public class DictionaryEntry extends VMObject {
   static {
     VM.registerVMInitializedObserver(new Observer() {
         public void update(Observable o, Object data) {
@@ -43,25 +41,16 @@ public class DictionaryEntry extends sun.jvm.hotspot.utilities.HashtableEntry {
 
   private static synchronized void initialize(TypeDataBase db) {
     Type type = db.lookupType("DictionaryEntry");
+    instanceKlassField = new MetadataField(type.getAddressField("_instance_klass"), 0);
   }
 
-  public Klass klass() {
-    return (Klass)Metadata.instantiateWrapperFor(literalValue());
-  }
+  private static MetadataField instanceKlassField;
 
   public DictionaryEntry(Address addr) {
     super(addr);
   }
 
-  public boolean equals(Symbol className) {
-    InstanceKlass ik = (InstanceKlass) klass();
-    return ik.getName().equals(className);
-  }
-
-  /* covariant return type :-(
-  public DictionaryEntry next() {
-    return (DictionaryEntry) super.next();
+  public Klass klass() {
+    return (Klass) instanceKlassField.getValue(this);
   }
-  For now, let the caller cast it ..
-  */
 }
@@ -389,14 +389,9 @@ eventFilterRestricted_passesFilter(JNIEnv *env,
     method = evinfo->method;
 
     /*
-     * Suppress most events if they happen in debug threads
+     * Events in debug threads are suppressed by the caller,
+     * eventHandler's event_callback, before any filter is tried.
      */
-    if ((evinfo->ei != EI_CLASS_PREPARE) &&
-        (evinfo->ei != EI_GC_FINISH) &&
-        (evinfo->ei != EI_CLASS_LOAD) &&
-        threadControl_isDebugThread(thread)) {
-        return JNI_FALSE;
-    }
 
     for (i = 0; i < FILTER_COUNT(node); ++i, ++filter) {
         switch (filter->modifier) {
@@ -696,6 +691,55 @@ eventFilterRestricted_isBreakpointInClass(JNIEnv *env, jclass clazz,
     return JNI_TRUE; /* should never come here */
 }
 
+/**
+ * Determine if evaluating this handler's filters needs the name of
+ * the event's class.
+ */
+jboolean
+eventFilterRestricted_usesClassname(HandlerNode *node)
+{
+    Filter *filter = FILTERS_ARRAY(node);
+    int i;
+
+    for (i = 0; i < FILTER_COUNT(node); ++i, ++filter) {
+        switch (filter->modifier) {
+            case JDWP_REQUEST_MODIFIER(ClassMatch):
+            case JDWP_REQUEST_MODIFIER(ClassExclude):
+                return JNI_TRUE;
+        }
+    }
+    return JNI_FALSE;
+}
+
+/**
+ * Determine if this handler can only pass events at a single
+ * location, and if so return the location.  That is the case when it
+ * has a LocationOnly filter and none of the filters checked before it
+ * has side effects (Count and Step filters do), so that skipping the
+ * handler for events at other locations is not observable.
+ */
+jboolean
+eventFilterRestricted_getIndexLocation(HandlerNode *node,
+                                       jmethodID *method,
+                                       jlocation *location)
+{
+    Filter *filter = FILTERS_ARRAY(node);
+    int i;
+
+    for (i = 0; i < FILTER_COUNT(node); ++i, ++filter) {
+        switch (filter->modifier) {
+            case JDWP_REQUEST_MODIFIER(LocationOnly):
+                *method = filter->u.LocationOnly.method;
+                *location = filter->u.LocationOnly.location;
+                return JNI_TRUE;
+            case JDWP_REQUEST_MODIFIER(Count):
+            case JDWP_REQUEST_MODIFIER(Step):
+                return JNI_FALSE;
+        }
+    }
+    return JNI_FALSE;
+}
+
 /***** filter set-up *****/
 
 jvmtiError
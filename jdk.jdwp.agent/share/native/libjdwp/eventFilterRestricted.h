@@ -49,5 +49,9 @@ jboolean eventFilterRestricted_passesUnloadFilter(JNIEnv *env,
 jboolean eventFilterRestricted_isBreakpointInClass(JNIEnv *env,
                                                    jclass clazz,
                                                    HandlerNode *node);
+jboolean eventFilterRestricted_usesClassname(HandlerNode *node);
+jboolean eventFilterRestricted_getIndexLocation(HandlerNode *node,
+                                                jmethodID *method,
+                                                jlocation *location);
 
 #endif
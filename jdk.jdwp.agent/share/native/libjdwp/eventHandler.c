@@ -152,6 +152,7 @@ static jrawMonitorID handlerLock;
 
 typedef struct HandlerChain_ {
     HandlerNode *first;
+    jint classnameUsers;    /* handlers with class pattern filters */
     /* add lock here */
 } HandlerChain;
 
@@ -162,6 +163,22 @@ typedef struct HandlerChain_ {
 
 static HandlerChain __handlers[EI_max-EI_min+1];
 
+/*
+ * Breakpoint handlers restricted to a single location are also
+ * kept in a hash table keyed by that location, so that a breakpoint
+ * event visits only the handlers at its own location instead of every
+ * breakpoint request.  The other breakpoint handlers are kept on the
+ * unindexed list.  Like the chain, both lists are ordered most recently
+ * installed first, and merging them by sequence number runs the
+ * handlers in the same order as a walk of the whole chain.
+ * Protected by handlerLock.
+ */
+#define LOCATION_INDEX_SIZE 1024
+
+static HandlerNode *locationIndex[LOCATION_INDEX_SIZE];
+static HandlerNode *unindexedBreakpoints;
+static jlong handlerSequence;
+
 /* Given a HandlerNode, these access our private data.
  */
 #define PRIVATE_DATA(node) \
@@ -171,6 +188,13 @@ static HandlerChain __handlers[EI_max-EI_min+1];
 #define PREV(node) (PRIVATE_DATA(node)->private_prev)
 #define CHAIN(node) (PRIVATE_DATA(node)->private_chain)
 #define HANDLER_FUNCTION(node) (PRIVATE_DATA(node)->private_handlerFunction)
+#define INDEX_NEXT(node) (PRIVATE_DATA(node)->private_indexNext)
+#define INDEX_PREV(node) (PRIVATE_DATA(node)->private_indexPrev)
+#define INDEX_HEAD(node) (PRIVATE_DATA(node)->private_indexHead)
+#define INDEX_METHOD(node) (PRIVATE_DATA(node)->private_indexMethod)
+#define INDEX_LOCATION(node) (PRIVATE_DATA(node)->private_indexLocation)
+#define SEQUENCE(node) (PRIVATE_DATA(node)->private_sequence)
+#define USES_CLASSNAME(node) (PRIVATE_DATA(node)->private_usesClassname)
 
 static jclass getObjectClass(jobject object);
 static jvmtiError freeHandler(HandlerNode *node);
@@ -186,6 +210,63 @@ getHandlerChain(EventIndex i)
     return &(__handlers[i-EI_min]);
 }
 
+static HandlerNode **
+locationBucket(jmethodID method, jlocation location)
+{
+    jlong hash = (jlong)(intptr_t)method ^ (location * 31);
+    hash ^= hash >> 16;
+    return &locationIndex[hash & (LOCATION_INDEX_SIZE - 1)];
+}
+
+/**
+ * Add a breakpoint handler to the location index, or to the
+ * unindexed list if it can fire at more than one location.
+ */
+static void
+indexInsert(HandlerNode *node)
+{
+    HandlerNode **head;
+    HandlerNode *oldHead;
+
+    if (eventFilterRestricted_getIndexLocation(node, &INDEX_METHOD(node),
+                                               &INDEX_LOCATION(node))) {
+        head = locationBucket(INDEX_METHOD(node), INDEX_LOCATION(node));
+    } else {
+        head = &unindexedBreakpoints;
+    }
+    oldHead = *head;
+    INDEX_NEXT(node) = oldHead;
+    INDEX_PREV(node) = NULL;
+    INDEX_HEAD(node) = head;
+    if (oldHead != NULL) {
+        INDEX_PREV(oldHead) = node;
+    }
+    *head = node;
+}
+
+/**
+ * Remove a handler from the location index.  Safe for non-indexed nodes.
+ */
+static void
+indexRemove(HandlerNode *node)
+{
+    HandlerNode **head = INDEX_HEAD(node);
+
+    if (head == NULL) {
+        return;
+    }
+    if (*head == node) {
+        *head = INDEX_NEXT(node);
+    }
+    if (INDEX_NEXT(node) != NULL) {
+        INDEX_PREV(INDEX_NEXT(node)) = INDEX_PREV(node);
+    }
+    if (INDEX_PREV(node) != NULL) {
+        INDEX_NEXT(INDEX_PREV(node)) = INDEX_NEXT(node);
+    }
+    INDEX_HEAD(node) = NULL;
+}
+
 static void
 insert(HandlerChain *chain, HandlerNode *node)
 {
@@ -197,6 +278,15 @@ insert(HandlerChain *chain, HandlerNode *node)
         PREV(oldHead) = node;
     }
     chain->first = node;
+
+    SEQUENCE(node) = ++handlerSequence;
+    USES_CLASSNAME(node) = eventFilterRestricted_usesClassname(node);
+    if (USES_CLASSNAME(node)) {
+        chain->classnameUsers++;
+    }
+    if (node->ei == EI_BREAKPOINT) {
+        indexInsert(node);
+    }
 }
 
 static HandlerNode *
@@ -238,6 +328,10 @@ deinsert(HandlerNode *node)
     if (PREV(node) != NULL) {
         NEXT(PREV(node)) = NEXT(node);
     }
+    if (USES_CLASSNAME(node)) {
+        chain->classnameUsers--;
+    }
+    indexRemove(node);
     CHAIN(node) = NULL;
 }
 
@@ -533,6 +627,69 @@ synthesizeUnloadEvent(void *signatureVoid, void *envVoid)
 /* Garbage Collection Happened */
 static unsigned int garbageCollected = 0;
 
+/* Pass an event to one handler if it gets through the handler's
+ * filters, and free the handler if a count filter has expired.
+ * Assumes handlerLock held.
+ */
+static void
+dispatchEvent(JNIEnv *env, char *classname, EventInfo *evinfo,
+              HandlerNode *node, struct bag *eventBag)
+{
+    jboolean shouldDelete;
+
+    if (eventFilterRestricted_passesFilter(env, classname,
+                                           evinfo, node,
+                                           &shouldDelete)) {
+        HandlerFunction func;
+
+        func = HANDLER_FUNCTION(node);
+        if ( func == NULL ) {
+            EXIT_ERROR(AGENT_ERROR_INTERNAL,"handler function NULL");
+        }
+        (*func)(env, evinfo, node, eventBag);
+    }
+    if (shouldDelete) {
+        /* We can safely free the node now that we are done
+         * using it.
+         */
+        (void)freeHandler(node);
+    }
+}
+
+/* Pass a breakpoint event to the handlers at its location and the
+ * unindexed breakpoint handlers, in chain order.
+ * Assumes handlerLock held.
+ */
+static void
+dispatchBreakpoint(JNIEnv *env, char *classname, EventInfo *evinfo,
+                   struct bag *eventBag)
+{
+    HandlerNode *indexed = *locationBucket(evinfo->method, evinfo->location);
+    HandlerNode *unindexed = unindexedBreakpoints;
+
+    while (indexed != NULL || unindexed != NULL) {
+        HandlerNode *node;
+
+        /* skip handlers for other locations in the same bucket */
+        if (indexed != NULL &&
+            (INDEX_METHOD(indexed) != evinfo->method ||
+             INDEX_LOCATION(indexed) != evinfo->location)) {
+            indexed = INDEX_NEXT(indexed);
+            continue;
+        }
+        /* advance before dispatching so handlers can remove themselves */
+        if (unindexed == NULL ||
+            (indexed != NULL && SEQUENCE(indexed) > SEQUENCE(unindexed))) {
+            node = indexed;
+            indexed = INDEX_NEXT(indexed);
+        } else {
+            node = unindexed;
+            unindexed = INDEX_NEXT(unindexed);
+        }
+        dispatchEvent(env, classname, evinfo, node, eventBag);
+    }
+}
+
 /* The JVMTI generic event callback. Each event is passed to a sequence of
  * handlers in a chain until the chain ends or one handler
  * consumes the event.
@@ -634,39 +791,46 @@ event_callback(JNIEnv *env, EventInfo *evinfo)
 
     debugMonitorEnter(handlerLock);
     {
-        HandlerNode *node;
-        char        *classname;
+        HandlerChain *chain;
+        HandlerNode  *node;
+        char         *classname;
 
         /* We must keep track of all classes prepared to know what's unloaded */
         if (evinfo->ei == EI_CLASS_PREPARE) {
             classTrack_addPreparedClass(env, evinfo->clazz);
         }
 
-        node = getHandlerChain(evinfo->ei)->first;
-        classname = getClassname(evinfo->clazz);
+        chain = getHandlerChain(evinfo->ei);
+        node = chain->first;
+        classname = NULL;
+
+        /*
+         * Suppress most events if they happen in debug threads.
+         * No handler's filters would pass them.
+         */
+        if (node != NULL &&
+            (evinfo->ei != EI_CLASS_PREPARE) &&
+            (evinfo->ei != EI_GC_FINISH) &&
+            (evinfo->ei != EI_CLASS_LOAD) &&
+            threadControl_isDebugThread(thread)) {
+            node = NULL;
+        }
+
+        /* Only class pattern filters look at the class name */
+        if (node != NULL && chain->classnameUsers > 0) {
+            classname = getClassname(evinfo->clazz);
+        }
+
+        if (node != NULL && evinfo->ei == EI_BREAKPOINT) {
+            dispatchBreakpoint(env, classname, evinfo, eventBag);
+            node = NULL;
+        }
 
         while (node != NULL) {
             /* save next so handlers can remove themselves */
             HandlerNode *next = NEXT(node);
-            jboolean shouldDelete;
-
-            if (eventFilterRestricted_passesFilter(env, classname,
-                                                   evinfo, node,
-                                                   &shouldDelete)) {
-                HandlerFunction func;
 
-                func = HANDLER_FUNCTION(node);
-                if ( func == NULL ) {
-                    EXIT_ERROR(AGENT_ERROR_INTERNAL,"handler function NULL");
-                }
-                (*func)(env, evinfo, node, eventBag);
-            }
-            if (shouldDelete) {
-                /* We can safely free the node now that we are done
-                 * using it.
-                 */
-                (void)freeHandler(node);
-            }
+            dispatchEvent(env, classname, evinfo, node, eventBag);
             node = next;
         }
         jvmtiDeallocate(classname);
@@ -1447,6 +1611,7 @@ eventHandler_initialize(jbyte sessionID)
 
     for (i = EI_min; i <= EI_max; ++i) {
         getHandlerChain(i)->first = NULL;
+        getHandlerChain(i)->classnameUsers = 0;
     }
 
     /*
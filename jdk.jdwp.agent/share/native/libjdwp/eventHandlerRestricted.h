@@ -53,6 +53,14 @@ typedef struct EventHandlerPrivate_Data_ {
     struct HandlerNode_      *private_prev;
     struct HandlerChain_     *private_chain;
     HandlerFunction private_handlerFunction;
+    /* breakpoint location index, see eventHandler.c */
+    struct HandlerNode_      *private_indexNext;
+    struct HandlerNode_      *private_indexPrev;
+    struct HandlerNode_     **private_indexHead;
+    jmethodID                 private_indexMethod;
+    jlocation                 private_indexLocation;
+    jlong                     private_sequence;
+    jboolean                  private_usesClassname;
 } EventHandlerPrivate_Data;
 
 /* this structure should only be used outside of eventHandler
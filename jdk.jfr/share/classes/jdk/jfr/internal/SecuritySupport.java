@@ -294,6 +294,10 @@ public final class SecuritySupport {
         return doPrivilegedWithReturn(() -> Boolean.getBoolean(propertyName), new PropertyPermission(propertyName, "read"));
     }
 
+    static int getIntegerProperty(String propertyName, int defaultValue) {
+        return doPrivilegedWithReturn(() -> Integer.getInteger(propertyName, defaultValue), new PropertyPermission(propertyName, "read"));
+    }
+
     private static SafePath getPathInProperty(String prop, String subPath) {
         return doPrivilegedWithReturn(() -> {
             String path = System.getProperty(prop);
@@ -47,15 +47,23 @@ public final class StringPool {
     private static boolean getCurrentEpoch() {
         return unsafe.getByte(epochAddress) == 1;
     }
+    /*
+     * Strings keep their id for as long as they stay in the pool, across chunks.
+     * A string is written to the constant pool of a chunk the first time it is
+     * used in that chunk, so a string that was pooled before a rotation is pooled
+     * again right away instead of going through the pre-cache and a new id.
+     */
     private static class SimpleStringIdPool {
         /* string id index */
         private final AtomicLong sidIdx = new AtomicLong();
-        /* epoch of cached strings */
-        private boolean poolEpoch;
+        /* epoch of the chunk the pool writes to */
+        private volatile boolean poolEpoch;
+        /* incremented for every chunk the pool writes to */
+        private volatile long generation;
         /* the cache */
-        private final ConcurrentHashMap<String, Long> cache;
-        /* max size */
-        private final int MAX_SIZE = 32*1024;
+        private final ConcurrentHashMap<String, PooledString> cache;
+        /* max number of strings, jfr.stringpool.maxsize */
+        private final int MAX_SIZE = SecuritySupport.getIntegerProperty("jfr.stringpool.maxsize", 32*1024);
         /* max size bytes*/
         private final long MAX_SIZE_UTF16 = 16*1024*1024;
         /* max size bytes*/
@@ -68,51 +76,83 @@ public final class StringPool {
         /* loop mask */
         private static final int preCacheMask = 0x03;
 
+        private static final class PooledString {
+            final long sid;
+            /* generation of the last chunk the string was written to */
+            volatile long generation = -1;
+            PooledString(long sid) {
+                this.sid = sid;
+            }
+        }
+
         SimpleStringIdPool() {
-            cache = new ConcurrentHashMap<>(MAX_SIZE, 0.75f);
+            cache = new ConcurrentHashMap<>(Math.max(MAX_SIZE, 16), 0.75f);
         }
         void reset() {
-            reset(getCurrentEpoch());
-        }
-        private void reset(boolean epoch) {
             this.cache.clear();
-            this.poolEpoch = epoch;
+            this.poolEpoch = getCurrentEpoch();
             this.currentSizeUTF16 = 0;
         }
         private long addString(String s) {
             boolean currentEpoch = getCurrentEpoch();
-            if (poolEpoch == currentEpoch) {
-                /* pool is for current chunk */
-                Long lsid = this.cache.get(s);
-                if (lsid != null) {
-                    return lsid.longValue();
-                }
-            } else {
+            if (poolEpoch != currentEpoch) {
                 /* pool is for an old chunk */
-                reset(currentEpoch);
+                synchronized(SimpleStringIdPool.class) {
+                    if (poolEpoch != currentEpoch) {
+                        poolEpoch = currentEpoch;
+                        generation++;
+                    }
+                }
             }
-            if (!preCache(s)) {
+            PooledString ps = this.cache.get(s);
+            if (ps != null) {
+                return writeString(ps, s);
+            }
+            if (MAX_SIZE <= 0 || !preCache(s)) {
                 /* we should not pool this string */
                 return -1;
             }
             if (cache.size() > MAX_SIZE || currentSizeUTF16 > MAX_SIZE_UTF16) {
-                /* pool was full */
-                reset(currentEpoch);
+                /* pool was full, start over */
+                synchronized(SimpleStringIdPool.class) {
+                    cache.clear();
+                    currentSizeUTF16 = 0;
+                }
             }
             return storeString(s);
         }
 
         private long storeString(String s) {
-            long sid = this.sidIdx.getAndIncrement();
+            PooledString ps = new PooledString(this.sidIdx.getAndIncrement());
             /* we can race but it is ok */
-            this.cache.put(s, sid);
-            boolean currentEpoch;
+            PooledString previous = this.cache.putIfAbsent(s, ps);
+            if (previous != null) {
+                ps = previous;
+            } else {
+                synchronized(SimpleStringIdPool.class) {
+                    currentSizeUTF16 += s.length();
+                }
+            }
+            return writeString(ps, s);
+        }
+
+        private long writeString(PooledString ps, String s) {
+            if (ps.generation == generation) {
+                return ps.sid;
+            }
             synchronized(SimpleStringIdPool.class) {
-                currentEpoch = JVM.addStringConstant(poolEpoch, sid, s);
-                currentSizeUTF16 += s.length();
+                if (ps.generation == generation) {
+                    /* already in the chunk that this pool represents */
+                    return ps.sid;
+                }
+                boolean currentEpoch = JVM.addStringConstant(poolEpoch, ps.sid, s);
+                /* did we write in chunk that this pool represent */
+                if (currentEpoch != poolEpoch) {
+                    return -1;
+                }
+                ps.generation = generation;
+                return ps.sid;
             }
-            /* did we write in chunk that this pool represent */
-            return currentEpoch == poolEpoch ? sid : -1;
         }
         private boolean preCache(String s) {
             if (preCache[0].equals(s)) {
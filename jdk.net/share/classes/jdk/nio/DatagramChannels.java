@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package jdk.nio;
+
+import java.io.IOException;
+import java.net.SocketAddress;
+import java.nio.ByteBuffer;
+import java.nio.channels.DatagramChannel;
+import java.util.Objects;
+
+import sun.nio.ch.DatagramBatch;
+
+/**
+ * Defines static methods to receive and send batches of datagrams through a
+ * {@link DatagramChannel}.
+ *
+ * <p> Unless otherwise specified, passing a {@code null} argument to any of the
+ * methods defined here will cause a {@code NullPointerException} to be thrown.
+ *
+ * @implNote On Linux the batch is received with a single {@code recvmmsg}
+ * or sent with a single {@code sendmmsg} system call. On other platforms,
+ * and for {@code DatagramChannel} implementations other than the JDK
+ * built-in one, at most one datagram is received or sent per call.
+ *
+ * @since 14
+ */
+
+public final class DatagramChannels {
+    private DatagramChannels() { }
+
+    /**
+     * Returns the maximum number of datagrams that are received or sent by
+     * one invocation of the methods defined here.
+     *
+     * @return The maximum batch size
+     */
+    public static int maxBatchSize() {
+        return DatagramBatch.maxBatchSize();
+    }
+
+    /**
+     * Receives a batch of datagrams.
+     *
+     * <p> Each datagram is transferred into the next buffer of {@code dsts},
+     * starting at the buffer's position, as if by {@link
+     * DatagramChannel#receive(ByteBuffer) receive}. A datagram longer than
+     * the remaining space of its buffer is silently truncated. The source
+     * address of the datagram transferred into {@code dsts[i]} is stored in
+     * {@code senders[i]}.
+     *
+     * <p> In blocking mode this method waits until at least one datagram is
+     * available and then returns the datagrams that are immediately
+     * available, up to the number of buffers. In non-blocking mode it
+     * returns zero if no datagram is immediately available. </p>
+     *
+     * @param  dc
+     *         The datagram channel
+     * @param  dsts
+     *         The buffers into which datagrams are to be transferred
+     * @param  senders
+     *         The array in which the source addresses are stored
+     *
+     * @return The number of datagrams received, possibly zero
+     *
+     * @throws IllegalArgumentException
+     *         If one of the buffers is read-only
+     * @throws IOException
+     *         If an I/O error occurs, including the exceptions specified
+     *         by {@link DatagramChannel#receive(ByteBuffer) receive}
+     */
+    public static int receive(DatagramChannel dc,
+                              ByteBuffer[] dsts,
+                              SocketAddress[] senders)
+        throws IOException
+    {
+        Objects.requireNonNull(dc);
+        for (ByteBuffer dst : dsts)
+            Objects.requireNonNull(dst);
+        Objects.requireNonNull(senders);
+        return DatagramBatch.receive(dc, dsts, senders);
+    }
+
+    /**
+     * Sends a batch of datagrams to the same target.
+     *
+     * <p> Each buffer of {@code srcs} holds one datagram, from its position
+     * to its limit, and is sent as if by {@link
+     * DatagramChannel#send(ByteBuffer, SocketAddress) send}. The position of
+     * each buffer whose datagram was sent is set to its limit.
+     *
+     * @param  dc
+     *         The datagram channel
+     * @param  srcs
+     *         The buffers from which datagrams are to be sent
+     * @param  target
+     *         The address to which the datagrams are to be sent
+     *
+     * @return The number of datagrams sent, possibly zero if the channel is
+     *         in non-blocking mode
+     *
+     * @throws IOException
+     *         If an I/O error occurs, including the exceptions specified
+     *         by {@link DatagramChannel#send(ByteBuffer, SocketAddress) send}
+     */
+    public static int send(DatagramChannel dc,
+                           ByteBuffer[] srcs,
+                           SocketAddress target)
+        throws IOException
+    {
+        Objects.requireNonNull(dc);
+        for (ByteBuffer src : srcs)
+            Objects.requireNonNull(src);
+        Objects.requireNonNull(target);
+        return DatagramBatch.send(dc, srcs, target);
+    }
+}
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package jdk.nio;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
+import java.util.Objects;
+
+import sun.nio.ch.FileChannelImpl;
+
+/**
+ * Defines static methods to perform positional scattering and gathering I/O
+ * on a {@link FileChannel}.
+ *
+ * <p> Unlike the scattering and gathering operations defined by
+ * {@code FileChannel}, the methods defined here read or write at a given
+ * file position and do not change the channel's file position. They can
+ * therefore be used concurrently by several threads on the same channel.
+ *
+ * <p> Unless otherwise specified, passing a {@code null} argument to any of the
+ * methods defined here will cause a {@code NullPointerException} to be thrown.
+ *
+ * @since 14
+ */
+
+public final class FileChannels {
+    private FileChannels() { }
+
+    /**
+     * Reads a sequence of bytes from a file channel into the given buffers,
+     * starting at the given file position.
+     *
+     * <p> This method behaves as {@link FileChannel#read(ByteBuffer[])},
+     * except that bytes are read starting at the given file position
+     * rather than at the channel's current position. If the given position
+     * is greater than or equal to the file's current size then no bytes are
+     * read.
+     *
+     * @implNote On Linux the bytes are read with a single {@code preadv}
+     * system call for up to {@code IOV_MAX} buffers. Channels that are not
+     * provided by the default file system provider are read one buffer at
+     * a time.
+     *
+     * @param  ch
+     *         The file channel
+     * @param  dsts
+     *         The buffers into which bytes are to be transferred
+     * @param  position
+     *         The file position at which the transfer is to begin; must be
+     *         non-negative
+     *
+     * @return  The number of bytes read, possibly zero, or {@code -1} if the
+     *          given position is greater than or equal to the file's current
+     *          size
+     *
+     * @throws IllegalArgumentException
+     *         If the position is negative
+     * @throws java.nio.channels.NonReadableChannelException
+     *         If the channel was not opened for reading
+     * @throws IOException
+     *         If some other I/O error occurs
+     */
+    public static long read(FileChannel ch, ByteBuffer[] dsts, long position)
+        throws IOException
+    {
+        Objects.requireNonNull(ch);
+        Objects.requireNonNull(dsts);
+        if (ch instanceof FileChannelImpl)
+            return ((FileChannelImpl)ch).read(dsts, 0, dsts.length, position);
+        if (position < 0)
+            throw new IllegalArgumentException("Negative position");
+        long total = 0;
+        for (ByteBuffer dst : dsts) {
+            int rem = dst.remaining();
+            int n = ch.read(dst, position + total);
+            if (n < 0)
+                return (total > 0) ? total : -1;
+            total += n;
+            if (n < rem)
+                break;
+        }
+        return total;
+    }
+
+    /**
+     * Writes a sequence of bytes to a file channel from the given buffers,
+     * starting at the given file position.
+     *
+     * <p> This method behaves as {@link FileChannel#write(ByteBuffer[])},
+     * except that bytes are written starting at the given file position
+     * rather than at the channel's current position. If the given position
+     * is greater than the file's current size then the file will be grown
+     * to accommodate the new bytes.
+     *
+     * @implNote On Linux the bytes are written with a single {@code pwritev}
+     * system call for up to {@code IOV_MAX} buffers.
+     *
+     * @param  ch
+     *         The file channel
+     * @param  srcs
+     *         The buffers from which bytes are to be transferred
+     * @param  position
+     *         The file position at which the transfer is to begin; must be
+     *         non-negative
+     *
+     * @return  The number of bytes written, possibly zero
+     *
+     * @throws IllegalArgumentException
+     *         If the position is negative
+     * @throws java.nio.channels.NonWritableChannelException
+     *         If the channel was not opened for writing
+     * @throws IOException
+     *         If some other I/O error occurs
+     */
+    public static long write(FileChannel ch, ByteBuffer[] srcs, long position)
+        throws IOException
+    {
+        Objects.requireNonNull(ch);
+        Objects.requireNonNull(srcs);
+        if (ch instanceof FileChannelImpl)
+            return ((FileChannelImpl)ch).write(srcs, 0, srcs.length, position);
+        if (position < 0)
+            throw new IllegalArgumentException("Negative position");
+        long total = 0;
+        for (ByteBuffer src : srcs) {
+            int rem = src.remaining();
+            int n = ch.write(src, position + total);
+            total += n;
+            if (n < rem)
+                break;
+        }
+        return total;
+    }
+
+    /**
+     * Reads several independent ranges of a file channel, each into its own
+     * buffer.
+     *
+     * <p> For each index {@code i}, bytes are read into {@code dsts[i]}
+     * starting at file position {@code positions[i]}, as if by
+     * {@link FileChannel#read(ByteBuffer, long) ch.read(dsts[i], positions[i])},
+     * until the buffer is full or the end of the file is reached. Each
+     * buffer's position is advanced by the number of bytes read into it.
+     *
+     * @implNote On Linux and other Unix systems the ranges are read in
+     * batches of up to {@code IOV_MAX}, each batch with a single transition
+     * into native code.
+     *
+     * @param  ch
+     *         The file channel
+     * @param  dsts
+     *         The buffers into which bytes are to be transferred
+     * @param  positions
+     *         The file position of each range; must be non-negative and have
+     *         the same length as {@code dsts}
+     *
+     * @return  The total number of bytes read
+     *
+     * @throws IllegalArgumentException
+     *         If a position is negative or the arrays differ in length
+     * @throws java.nio.channels.NonReadableChannelException
+     *         If the channel was not opened for reading
+     * @throws IOException
+     *         If some other I/O error occurs
+     */
+    public static long readRanges(FileChannel ch, ByteBuffer[] dsts,
+                                  long[] positions)
+        throws IOException
+    {
+        Objects.requireNonNull(ch);
+        Objects.requireNonNull(dsts);
+        Objects.requireNonNull(positions);
+        if (ch instanceof FileChannelImpl)
+            return ((FileChannelImpl)ch).readRanges(dsts, positions);
+        if (dsts.length != positions.length)
+            throw new IllegalArgumentException("Mismatched array lengths");
+        long total = 0;
+        for (int i = 0; i < dsts.length; i++) {
+            int n = ch.read(dsts[i], positions[i]);
+            if (n > 0)
+                total += n;
+        }
+        return total;
+    }
+}
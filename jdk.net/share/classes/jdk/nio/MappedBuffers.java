@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package jdk.nio;
+
+import java.io.IOException;
+import java.nio.MappedByteBuffer;
+import java.util.Objects;
+
+import jdk.internal.access.JavaNioAccess;
+import jdk.internal.access.SharedSecrets;
+
+/**
+ * Defines static methods to control the paging of {@link MappedByteBuffer}
+ * regions mapped from a file.
+ *
+ * <p> The methods defined here operate on a region of the buffer's content
+ * identified by an index and a length, which must satisfy the same
+ * preconditions as {@link MappedByteBuffer#force(int, int)}. They have no
+ * effect on a buffer that is not mapped to a file.
+ *
+ * <p> Unless otherwise specified, passing a {@code null} argument to any of the
+ * methods defined here will cause a {@code NullPointerException} to be thrown.
+ *
+ * @since 14
+ */
+
+public final class MappedBuffers {
+    private MappedBuffers() { }
+
+    private static final JavaNioAccess NIO_ACCESS = SharedSecrets.getJavaNioAccess();
+
+    /**
+     * Advice about the expected use of a region of a mapped buffer.
+     *
+     * @since 14
+     */
+    public enum Advice {
+        /**
+         * No special treatment, the default.
+         */
+        NORMAL,
+        /**
+         * The region is expected to be accessed in random order, so read
+         * ahead is of little use.
+         */
+        RANDOM,
+        /**
+         * The region is expected to be accessed sequentially, so pages can
+         * be read ahead aggressively and freed soon after they are accessed.
+         */
+        SEQUENTIAL,
+        /**
+         * The region is expected to be accessed in the near future, so its
+         * pages may be read ahead now.
+         */
+        WILL_NEED,
+        /**
+         * The region is not expected to be accessed in the near future, so
+         * its pages may be released.
+         *
+         * @implNote On Linux, the content of a region of a buffer mapped
+         * with {@link java.nio.channels.FileChannel.MapMode#PRIVATE
+         * MapMode.PRIVATE} is reloaded from the file on the next access,
+         * discarding changes made through the buffer.
+         */
+        DONT_NEED
+    }
+
+    /**
+     * Advises the operating system about the expected use of a region of a
+     * mapped buffer.
+     *
+     * @implNote On Linux and other Unix systems the advice is given with
+     * {@code madvise}. On Windows the advice is ignored.
+     *
+     * @param  mbb
+     *         The mapped buffer
+     * @param  index
+     *         The index of the first byte of the region
+     * @param  length
+     *         The length of the region in bytes
+     * @param  advice
+     *         The advice
+     *
+     * @throws IndexOutOfBoundsException
+     *         If the preconditions on the index and length do not hold
+     * @throws IOException
+     *         If the operating system rejects the advice
+     */
+    public static void advise(MappedByteBuffer mbb, int index, int length,
+                              Advice advice)
+        throws IOException
+    {
+        Objects.requireNonNull(mbb);
+        Objects.requireNonNull(advice);
+        NIO_ACCESS.advise(mbb, index, length, advice.ordinal());
+    }
+
+    /**
+     * Initiates writing back a region of a mapped buffer to the storage
+     * device containing the mapped file, without waiting for the write to
+     * complete.
+     *
+     * <p> Unlike {@link MappedByteBuffer#force(int, int)}, this method does
+     * not guarantee that the changes have been written when it returns. It
+     * can be used to start writing back a region early, so that a later
+     * {@code force} has less to wait for.
+     *
+     * @implNote On Linux and other Unix systems this method uses {@code msync}
+     * with {@code MS_ASYNC}. On Windows it uses {@code FlushViewOfFile}
+     * without {@code FlushFileBuffers}.
+     *
+     * @param  mbb
+     *         The mapped buffer
+     * @param  index
+     *         The index of the first byte of the region
+     * @param  length
+     *         The length of the region in bytes
+     *
+     * @throws IndexOutOfBoundsException
+     *         If the preconditions on the index and length do not hold
+     * @throws IOException
+     *         If an I/O error occurs
+     */
+    public static void forceAsync(MappedByteBuffer mbb, int index, int length)
+        throws IOException
+    {
+        Objects.requireNonNull(mbb);
+        NIO_ACCESS.forceAsync(mbb, index, length);
+    }
+}
@@ -623,6 +623,7 @@ void unpacker::read_file_header() {
     // In the Unix-style program, we simply simulate a copy command.
     // Copy until EOF; assume the JAR file is the last segment.
     fprintf(errstrm, "Copy-mode.\n");
+    jarout->flushJarEntries();
     for (;;) {
       jarout->write_data(rp, (int)input_remaining());
       if (foreign_buf)
@@ -48,7 +48,7 @@
 
 #ifdef NO_ZLIB
 
-inline bool jar::deflate_bytes(bytes& head, bytes& tail) {
+inline bool jar::deflate_bytes(bytes& head, bytes& tail, fillbytes& deflated) {
   return false;
 }
 inline uint jar::get_crc32(uint c, uchar *ptr, uint len) { return 0; }
@@ -62,6 +62,14 @@ inline uint jar::get_crc32(uint c, uchar *ptr, uint len) { return crc32(c, ptr,
 
 #endif // End of ZLIB
 
+// The standalone unpacker overlaps compression of jar entries with
+// decoding of the following ones by handing them to worker threads.
+#if !defined(NO_ZLIB) && !defined(UNPACK_JNI) && !defined(_MSC_VER)
+#define JAR_PARALLEL_DEFLATE
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
 #ifdef _BIG_ENDIAN
 #define SWAP_BYTES(a) \
     ((((a) << 8) & 0xff00) | 0x00ff) & (((a) >> 8) | 0xff00)
@@ -355,7 +363,15 @@ void jar::addJarEntry(const char* fname,
                       bool deflate_hint, int modtime,
                       bytes& head, bytes& tail) {
   int len = (int)(head.len + tail.len);
-  int clen = 0;
+
+  bool deflate = (deflate_hint && len > 0);
+
+  // Entries must reach the file in order, so once the workers are
+  // running every entry goes through the queue.
+  if (deflater != null || (deflate && start_deflater())) {
+    queue_jar_entry(fname, deflate, modtime, head, tail);
+    return;
+  }
 
   uint crc = get_crc32(0,Z_NULL,0);
   if (head.len != 0)
@@ -363,21 +379,27 @@ void jar::addJarEntry(const char* fname,
   if (tail.len != 0)
     crc = get_crc32(crc, (uchar *)tail.ptr, (uint)tail.len);
 
-  bool deflate = (deflate_hint && len > 0);
-
   if (deflate) {
-    if (deflate_bytes(head, tail) == false) {
+    if (deflate_bytes(head, tail, deflated) == false) {
       PRINTCR((2, "Reverting to store fn=%s\t%d -> %d\n",
               fname, len, deflated.size()));
       deflate = false;
     }
   }
-  clen = (int)((deflate) ? deflated.size() : len);
+  write_jar_entry(fname, deflate, modtime, crc, head, tail, deflated.b);
+}
+
+// Write the headers and data of an entry whose crc, and compressed
+// contents cdata if deflated, are already known.
+void jar::write_jar_entry(const char* fname, bool deflate, int modtime,
+                          uint crc, bytes& head, bytes& tail, bytes& cdata) {
+  int len = (int)(head.len + tail.len);
+  int clen = (int)((deflate) ? cdata.len : len);
   add_to_jar_directory(fname, !deflate, modtime, len, clen, crc);
   write_jar_header(    fname, !deflate, modtime, len, clen, crc);
 
   if (deflate) {
-    write_data(deflated.b);
+    write_data(cdata);
     // Write deflated information in extra header
     write_jar_extra(len, clen, crc);
   } else {
@@ -386,8 +408,252 @@ void jar::addJarEntry(const char* fname,
   }
 }
 
+#ifdef JAR_PARALLEL_DEFLATE
+
+// Upper bounds on the worker threads, and on the entries and bytes
+// held in the queue before the decoder waits for the writer.
+#define DEFLATER_MAX_THREADS  8
+#define DEFLATER_MAX_PENDING  (4 * DEFLATER_MAX_THREADS)
+#define DEFLATER_MAX_BYTES    ((size_t)64 << 20)
+
+// An entry waiting to be compressed and written.  The file name and
+// contents are private copies, since the unpacker reuses its buffers
+// as soon as addJarEntry returns.
+struct jar_entry_job {
+  jar_entry_job* next;
+  bytes     name;
+  bytes     data;
+  fillbytes cdata;    // compressed contents
+  int       modtime;
+  bool      deflate;  // cleared if compression failed
+  bool      reverted; // deflate was cleared
+  bool      done;
+  uint      crc;
+};
+
+struct jar_deflater {
+  jar*            owner;
+  pthread_mutex_t lock;
+  pthread_cond_t  work_ready;  // a job was queued, or stopping
+  pthread_cond_t  work_done;   // a job was finished
+  pthread_t       threads[DEFLATER_MAX_THREADS];
+  int             nthreads;
+  jar_entry_job*  head;        // oldest entry, written next
+  jar_entry_job*  tail;        // newest entry
+  jar_entry_job*  todo;        // oldest entry not yet claimed by a worker
+  int             pending;
+  size_t          pending_bytes;
+  bool            stopping;
+};
+
+static void free_jar_entry_job(jar_entry_job* job) {
+  job->name.free();
+  job->data.free();
+  job->cdata.free();
+  ::free(job);
+}
+
+static void* jar_deflater_loop(void* arg) {
+  jar_deflater* d = (jar_deflater*) arg;
+  for (;;) {
+    pthread_mutex_lock(&d->lock);
+    while (d->todo == null && !d->stopping)
+      pthread_cond_wait(&d->work_ready, &d->lock);
+    jar_entry_job* job = d->todo;
+    if (job == null) {
+      pthread_mutex_unlock(&d->lock);
+      return null;
+    }
+    d->todo = job->next;
+    pthread_mutex_unlock(&d->lock);
+
+    bytes empty;
+    empty.set(null, 0);
+    job->crc = jar::get_crc32(0, Z_NULL, 0);
+    if (job->data.len != 0)
+      job->crc = jar::get_crc32(job->crc, (uchar *)job->data.ptr,
+                                (uint)job->data.len);
+    if (job->deflate) {
+      job->cdata.init();
+      if (d->owner->deflate_bytes(job->data, empty, job->cdata) == false) {
+        job->deflate = false;
+        job->reverted = true;
+      }
+    }
+
+    pthread_mutex_lock(&d->lock);
+    job->done = true;
+    pthread_cond_broadcast(&d->work_done);
+    pthread_mutex_unlock(&d->lock);
+  }
+}
+
+// Start the worker threads on first use.  Returns false if entries
+// should be compressed on the calling thread.
+bool jar::start_deflater() {
+  if (deflater != null)
+    return true;
+  long ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+  // Leave one processor to the decoder.
+  int nthreads = (int)((ncpus > DEFLATER_MAX_THREADS) ? DEFLATER_MAX_THREADS
+                                                      : ncpus - 1);
+  if (nthreads < 1)
+    return false;
+
+  jar_deflater* d = (jar_deflater*) calloc(1, sizeof(jar_deflater));
+  if (d == null)
+    return false;
+  d->owner = this;
+  pthread_mutex_init(&d->lock, null);
+  pthread_cond_init(&d->work_ready, null);
+  pthread_cond_init(&d->work_done, null);
+  for (int i = 0; i < nthreads; i++) {
+    if (pthread_create(&d->threads[d->nthreads], null,
+                       jar_deflater_loop, d) == 0)
+      d->nthreads++;
+  }
+  if (d->nthreads == 0) {
+    pthread_cond_destroy(&d->work_done);
+    pthread_cond_destroy(&d->work_ready);
+    pthread_mutex_destroy(&d->lock);
+    ::free(d);
+    return false;
+  }
+  PRINTCR((2, "jar::start_deflater: %d threads\n", d->nthreads));
+  deflater = d;
+  return true;
+}
+
+// Stop the worker threads, dropping any entries not yet written.
+void jar::stop_deflater() {
+  jar_deflater* d = deflater;
+  if (d == null)
+    return;
+  pthread_mutex_lock(&d->lock);
+  d->stopping = true;
+  d->todo = null;
+  pthread_cond_broadcast(&d->work_ready);
+  pthread_mutex_unlock(&d->lock);
+  for (int i = 0; i < d->nthreads; i++)
+    pthread_join(d->threads[i], null);
+  while (d->head != null) {
+    jar_entry_job* job = d->head;
+    d->head = job->next;
+    free_jar_entry_job(job);
+  }
+  pthread_cond_destroy(&d->work_done);
+  pthread_cond_destroy(&d->work_ready);
+  pthread_mutex_destroy(&d->lock);
+  ::free(d);
+  deflater = null;
+}
+
+void jar::queue_jar_entry(const char* fname, bool deflate, int modtime,
+                          bytes& head, bytes& tail) {
+  jar_deflater* d = deflater;
+  jar_entry_job* job = (jar_entry_job*) calloc(1, sizeof(jar_entry_job));
+  if (job == null) {
+    abort(ERROR_ENOMEM);
+    return;
+  }
+  job->name.saveFrom(fname);
+  job->data.malloc(head.len + tail.len);
+  if (aborting()) {
+    free_jar_entry_job(job);
+    return;
+  }
+  job->data.copyFrom(head);
+  job->data.copyFrom(tail, head.len);
+  job->modtime = modtime;
+  job->deflate = deflate;
+
+  pthread_mutex_lock(&d->lock);
+  if (d->tail != null)
+    d->tail->next = job;
+  else
+    d->head = job;
+  d->tail = job;
+  if (d->todo == null)
+    d->todo = job;
+  d->pending++;
+  d->pending_bytes += job->data.len;
+  pthread_cond_signal(&d->work_ready);
+  pthread_mutex_unlock(&d->lock);
+
+  write_queued_entries(false);
+}
+
+// Write finished entries from the front of the queue.  Waits for
+// the whole queue if wait_all, otherwise only while the queue is over
+// its limits.
+void jar::write_queued_entries(bool wait_all) {
+  jar_deflater* d = deflater;
+  pthread_mutex_lock(&d->lock);
+  for (;;) {
+    jar_entry_job* job = d->head;
+    if (job == null)
+      break;
+    if (!job->done) {
+      if (!wait_all &&
+          d->pending < DEFLATER_MAX_PENDING &&
+          d->pending_bytes < DEFLATER_MAX_BYTES)
+        break;
+      pthread_cond_wait(&d->work_done, &d->lock);
+      continue;
+    }
+    d->head = job->next;
+    if (d->head == null)
+      d->tail = null;
+    d->pending--;
+    d->pending_bytes -= job->data.len;
+    pthread_mutex_unlock(&d->lock);
+
+    bytes empty;
+    empty.set(null, 0);
+    if (job->reverted) {
+      PRINTCR((2, "Reverting to store fn=%s\t%d -> %d\n",
+               job->name.strval(), (int)job->data.len,
+               (int)job->cdata.size()));
+    }
+    write_jar_entry(job->name.strval(), job->deflate, job->modtime,
+                    job->crc, job->data, empty, job->cdata.b);
+    free_jar_entry_job(job);
+
+    pthread_mutex_lock(&d->lock);
+  }
+  pthread_mutex_unlock(&d->lock);
+}
+
+// Write out every queued entry.
+void jar::flushJarEntries() {
+  if (deflater != null)
+    write_queued_entries(true);
+}
+
+#else // !JAR_PARALLEL_DEFLATE
+
+bool jar::start_deflater() {
+  return false;
+}
+
+void jar::stop_deflater() {
+}
+
+void jar::queue_jar_entry(const char* fname, bool deflate, int modtime,
+                          bytes& head, bytes& tail) {
+}
+
+void jar::write_queued_entries(bool wait_all) {
+}
+
+void jar::flushJarEntries() {
+}
+
+#endif // JAR_PARALLEL_DEFLATE
+
 // Add a ZIP entry for a directory name no data
 void jar::addDirectoryToJarFile(const char* dir_name) {
+  flushJarEntries();
   bool store = true;
   add_to_jar_directory((const char*)dir_name, store, default_modtime, 0, 0, 0);
   write_jar_header(    (const char*)dir_name, store, default_modtime, 0, 0, 0);
@@ -396,6 +662,7 @@ void jar::addDirectoryToJarFile(const char* dir_name) {
 // Write out the central directory and close the jar file.
 void jar::closeJarFile(bool central) {
   if (jarfp) {
+    flushJarEntries();
     fflush(jarfp);
     if (central) write_central_directory();
     fflush(jarfp);
@@ -455,7 +722,7 @@ uLong jar::get_dostime(int modtime) {
    length, the caller should verify if true and clen less than the
    input data
 */
-bool jar::deflate_bytes(bytes& head, bytes& tail) {
+bool jar::deflate_bytes(bytes& head, bytes& tail, fillbytes& deflated) {
   int len = (int)(head.len + tail.len);
 
   z_stream zs;
@@ -28,6 +28,7 @@
 #define uchar  unsigned char
 
 struct unpacker;
+struct jar_deflater;
 
 struct jar {
   // JAR file writer
@@ -46,6 +47,10 @@ struct jar {
   uint        output_file_offset;
   fillbytes   deflated;  // temporary buffer
 
+  // Worker threads compressing queued entries, or null if entries
+  // are compressed on the calling thread.
+  jar_deflater* deflater;
+
   // pointer to outer unpacker, for error checks etc.
   unpacker* u;
 
@@ -55,11 +60,13 @@ struct jar {
                    bool deflate_hint, int modtime,
                    bytes& head, bytes& tail);
   void addDirectoryToJarFile(const char* dir_name);
+  void flushJarEntries();
   void closeJarFile(bool central);
 
   void init(unpacker* u_);
 
   void free() {
+    stop_deflater();
     central_directory.free();
     deflated.free();
   }
@@ -78,11 +85,18 @@ struct jar {
                         int len, int clen, unsigned int crc);
   void write_jar_extra(int len, int clen, unsigned int crc);
   void write_central_directory();
+  void write_jar_entry(const char* fname, bool deflate, int modtime,
+                       uint crc, bytes& head, bytes& tail, bytes& cdata);
+  bool start_deflater();
+  void stop_deflater();
+  void queue_jar_entry(const char* fname, bool deflate, int modtime,
+                       bytes& head, bytes& tail);
+  void write_queued_entries(bool wait_all);
   uLong dostime(int y, int n, int d, int h, int m, int s);
   uLong get_dostime(int modtime);
 
   // The definitions of these depend on the NO_ZLIB option:
-  bool deflate_bytes(bytes& head, bytes& tail);
+  bool deflate_bytes(bytes& head, bytes& tail, fillbytes& deflated);
   static uint get_crc32(uint c, unsigned char *ptr, uint len);
 
   // error handling